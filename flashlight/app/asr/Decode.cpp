@@ -262,7 +262,8 @@ int main(int argc, char** argv) {
       }
       convLmModel->eval();
 
-      auto getConvLmScoreFunc = buildGetConvLmScoreFunction(convLmModel);
+      auto getConvLmScoreFunc =
+          buildGetConvLmScoreFunction(convLmModel, FLAGS_lm_cache_bytes);
       lm = std::make_shared<fl::lib::text::ConvLM>(
           getConvLmScoreFunc,
           FLAGS_lm_vocab,
@@ -505,7 +506,8 @@ int main(int argc, char** argv) {
         Serializer::load(FLAGS_lm, convlmVersion, convLmModel);
         convLmModel->eval();
 
-        auto getConvLmScoreFunc = buildGetConvLmScoreFunction(convLmModel);
+        auto getConvLmScoreFunc =
+            buildGetConvLmScoreFunction(convLmModel, FLAGS_lm_cache_bytes);
         localLm = std::make_shared<fl::lib::text::ConvLM>(
             getConvLmScoreFunc,
             FLAGS_lm_vocab,
@@ -5,6 +5,7 @@
  * LICENSE file in the root directory of this source tree.
  */
 
+#include <atomic>
 #include <cstdlib>
 #include <fstream>
 #include <iomanip>
@@ -240,6 +241,12 @@ int main(int argc, char** argv) {
     }
   }
 
+  // Shared work queue: threads claim shards of samples on demand rather than
+  // working a static slice, so one thread stuck on long utterances doesn't
+  // leave the others idle once their slices drain
+  std::atomic<int64_t> nextSampleId(0);
+  std::atomic<int64_t> numProcessed(0);
+
   std::mutex hypMutex, refMutex;
   auto writeHyp = [&hypMutex, &hypStream](const std::string& hypStr) {
     std::lock_guard<std::mutex> lock(hypMutex);
@@ -267,6 +274,8 @@ int main(int argc, char** argv) {
               &sliceNumTokens,
               &sliceNumSamples,
               &sliceTime,
+              &nextSampleId,
+              &numProcessed,
               &isSeq2seqCrit](int tid) {
     // Initialize AM
     fl::setDevice(tid);
@@ -281,107 +290,119 @@ int main(int argc, char** argv) {
       localCriterion->eval();
     }
 
-    std::vector<int64_t> selectedIds;
-    for (int64_t i = tid; i < nSamples; i += FLAGS_nthread_decoder_am_forward) {
-      selectedIds.emplace_back(i);
-    }
-    std::shared_ptr<fl::Dataset> localDs =
-        std::make_shared<fl::ResampleDataset>(ds, selectedIds);
-    localDs = std::make_shared<fl::PrefetchDataset>(
-        localDs, FLAGS_nthread, FLAGS_nthread);
+    // Shard granularity trades scheduling flexibility against per-shard
+    // prefetch setup; big enough to keep the prefetch pipeline busy
+    constexpr int64_t kShardSize = 32;
 
     TestMeters meters;
     meters.timer.resume();
-    int cnt = 0;
-    for (auto& sample : *localDs) {
-      fl::Variable rawEmission;
-      if (usePlugin) {
-        rawEmission = localNetwork
-                          ->forward(
-                              {fl::input(sample[kInputIdx]),
-                               fl::noGrad(sample[kDurationIdx])})
-                          .front();
-      } else {
-        rawEmission = fl::pkg::runtime::forwardSequentialModuleWithPadMask(
-            fl::input(sample[kInputIdx]), localNetwork, sample[kDurationIdx]);
+    while (true) {
+      const int64_t shardBegin = nextSampleId.fetch_add(kShardSize);
+      if (shardBegin >= nSamples) {
+        break;
       }
-      auto emission = rawEmission.tensor().toHostVector<float>();
-      auto tokenTarget = sample[kTargetIdx].toHostVector<int>();
-      auto wordTarget = sample[kWordIdx].toHostVector<int>();
-      auto sampleId = readSampleIds(sample[kSampleIdx]).front();
-
-      auto letterTarget = tknTarget2Ltr(
-          tokenTarget,
-          tokenDict,
-          FLAGS_criterion,
-          FLAGS_surround,
-          isSeq2seqCrit,
-          FLAGS_replabel,
-          FLAGS_usewordpiece,
-          FLAGS_wordseparator);
-      std::vector<std::string> wordTargetStr;
-      if (FLAGS_uselexicon) {
-        wordTargetStr = wrdIdx2Wrd(wordTarget, wordDict);
-      } else {
-        wordTargetStr = tkn2Wrd(letterTarget, FLAGS_wordseparator);
+      const int64_t shardEnd =
+          std::min<int64_t>(shardBegin + kShardSize, nSamples);
+      std::vector<int64_t> selectedIds;
+      for (int64_t i = shardBegin; i < shardEnd; ++i) {
+        selectedIds.emplace_back(i);
       }
-
-      // Tokens
-      auto tokenPrediction =
-          localCriterion->viterbiPath(rawEmission.tensor()).toHostVector<int>();
-      auto letterPrediction = tknPrediction2Ltr(
-          tokenPrediction,
-          tokenDict,
-          FLAGS_criterion,
-          FLAGS_surround,
-          isSeq2seqCrit,
-          FLAGS_replabel,
-          FLAGS_usewordpiece,
-          FLAGS_wordseparator);
-
-      meters.tknDstSlice.add(letterPrediction, letterTarget);
-
-      // Words
-      std::vector<std::string> wrdPredictionStr =
-          tkn2Wrd(letterPrediction, FLAGS_wordseparator);
-      meters.wrdDstSlice.add(wrdPredictionStr, wordTargetStr);
-
-      if (!FLAGS_sclite.empty()) {
-        writeRef(join(" ", wordTargetStr) + " (" + sampleId + ")\n");
-        writeHyp(join(" ", wrdPredictionStr) + " (" + sampleId + ")\n");
-      }
-
-      if (FLAGS_show) {
-        meters.tknDst.reset();
-        meters.wrdDst.reset();
-        meters.tknDst.add(letterPrediction, letterTarget);
-        meters.wrdDst.add(wrdPredictionStr, wordTargetStr);
-
-        std::cout << "|T|: " << join(" ", letterTarget) << std::endl;
-        std::cout << "|P|: " << join(" ", letterPrediction) << std::endl;
-        std::cout << "[sample: " << sampleId
-                  << ", WER: " << meters.wrdDst.errorRate()[0]
-                  << "\%, TER: " << meters.tknDst.errorRate()[0]
-                  << "\%, total WER: " << meters.wrdDstSlice.errorRate()[0]
-                  << "\%, total TER: " << meters.tknDstSlice.errorRate()[0]
-                  << "\%, progress (thread " << tid << "): "
-                  << static_cast<float>(++cnt) / selectedIds.size() * 100
-                  << "\%]" << std::endl;
-      }
-
-      /* Save emission and targets */
-      int nTokens = rawEmission.dim(0);
-      int nFrames = rawEmission.dim(1);
-      EmissionUnit emissionUnit(emission, sampleId, nFrames, nTokens);
-
-      // Update counters
-      sliceNumWords[tid] += wordTarget.size();
-      sliceNumTokens[tid] += letterTarget.size();
-      sliceNumSamples[tid]++;
-
-      if (!emissionDir.empty()) {
-        fs::path savePath = fs::path(emissionDir) / (sampleId + ".bin");
-        Serializer::save(savePath, FL_APP_ASR_VERSION, emissionUnit);
+      std::shared_ptr<fl::Dataset> localDs =
+          std::make_shared<fl::ResampleDataset>(ds, selectedIds);
+      localDs = std::make_shared<fl::PrefetchDataset>(
+          localDs, FLAGS_nthread, FLAGS_nthread);
+
+      for (auto& sample : *localDs) {
+        fl::Variable rawEmission;
+        if (usePlugin) {
+          rawEmission = localNetwork
+                            ->forward(
+                                {fl::input(sample[kInputIdx]),
+                                 fl::noGrad(sample[kDurationIdx])})
+                            .front();
+        } else {
+          rawEmission = fl::pkg::runtime::forwardSequentialModuleWithPadMask(
+              fl::input(sample[kInputIdx]), localNetwork, sample[kDurationIdx]);
+        }
+        auto emission = rawEmission.tensor().toHostVector<float>();
+        auto tokenTarget = sample[kTargetIdx].toHostVector<int>();
+        auto wordTarget = sample[kWordIdx].toHostVector<int>();
+        auto sampleId = readSampleIds(sample[kSampleIdx]).front();
+
+        auto letterTarget = tknTarget2Ltr(
+            tokenTarget,
+            tokenDict,
+            FLAGS_criterion,
+            FLAGS_surround,
+            isSeq2seqCrit,
+            FLAGS_replabel,
+            FLAGS_usewordpiece,
+            FLAGS_wordseparator);
+        std::vector<std::string> wordTargetStr;
+        if (FLAGS_uselexicon) {
+          wordTargetStr = wrdIdx2Wrd(wordTarget, wordDict);
+        } else {
+          wordTargetStr = tkn2Wrd(letterTarget, FLAGS_wordseparator);
+        }
+
+        // Tokens
+        auto tokenPrediction =
+            localCriterion->viterbiPath(rawEmission.tensor()).toHostVector<int>();
+        auto letterPrediction = tknPrediction2Ltr(
+            tokenPrediction,
+            tokenDict,
+            FLAGS_criterion,
+            FLAGS_surround,
+            isSeq2seqCrit,
+            FLAGS_replabel,
+            FLAGS_usewordpiece,
+            FLAGS_wordseparator);
+
+        meters.tknDstSlice.add(letterPrediction, letterTarget);
+
+        // Words
+        std::vector<std::string> wrdPredictionStr =
+            tkn2Wrd(letterPrediction, FLAGS_wordseparator);
+        meters.wrdDstSlice.add(wrdPredictionStr, wordTargetStr);
+
+        if (!FLAGS_sclite.empty()) {
+          writeRef(join(" ", wordTargetStr) + " (" + sampleId + ")\n");
+          writeHyp(join(" ", wrdPredictionStr) + " (" + sampleId + ")\n");
+        }
+
+        if (FLAGS_show) {
+          meters.tknDst.reset();
+          meters.wrdDst.reset();
+          meters.tknDst.add(letterPrediction, letterTarget);
+          meters.wrdDst.add(wrdPredictionStr, wordTargetStr);
+
+          std::cout << "|T|: " << join(" ", letterTarget) << std::endl;
+          std::cout << "|P|: " << join(" ", letterPrediction) << std::endl;
+          std::cout << "[sample: " << sampleId
+                    << ", WER: " << meters.wrdDst.errorRate()[0]
+                    << "\%, TER: " << meters.tknDst.errorRate()[0]
+                    << "\%, total WER: " << meters.wrdDstSlice.errorRate()[0]
+                    << "\%, total TER: " << meters.tknDstSlice.errorRate()[0]
+                    << "\%, progress: "
+                    << static_cast<float>(numProcessed.fetch_add(1) + 1) /
+                        nSamples * 100
+                    << "\%]" << std::endl;
+        }
+
+        /* Save emission and targets */
+        int nTokens = rawEmission.dim(0);
+        int nFrames = rawEmission.dim(1);
+        EmissionUnit emissionUnit(emission, sampleId, nFrames, nTokens);
+
+        // Update counters
+        sliceNumWords[tid] += wordTarget.size();
+        sliceNumTokens[tid] += letterTarget.size();
+        sliceNumSamples[tid]++;
+
+        if (!emissionDir.empty()) {
+          fs::path savePath = fs::path(emissionDir) / (sampleId + ".bin");
+          Serializer::save(savePath, FL_APP_ASR_VERSION, emissionUnit);
+        }
       }
     }
 
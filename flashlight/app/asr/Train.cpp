@@ -330,6 +330,23 @@ int main(int argc, char** argv) {
   int wordpadVal = kTargetPadValue;
   auto padVal = std::make_tuple(0, targetpadVal, wordpadVal);
 
+  // Cache key component covering every flag the input featurization depends
+  // on; changing any of these invalidates existing cache entries.
+  const std::string featureCacheConfig = FLAGS_features_type + "_" +
+      std::to_string(FLAGS_samplerate) + "_" +
+      std::to_string(FLAGS_framesizems) + "_" +
+      std::to_string(FLAGS_framestridems) + "_" +
+      std::to_string(FLAGS_filterbanks) + "_" +
+      std::to_string(FLAGS_lowfreqfilterbank) + "_" +
+      std::to_string(FLAGS_highfreqfilterbank) + "_" +
+      std::to_string(FLAGS_mfcccoeffs) + "_" + std::to_string(FLAGS_devwin) +
+      "_" + std::to_string(FLAGS_channels) + "_" +
+      std::to_string(FLAGS_localnrmlleftctx) + "_" +
+      std::to_string(FLAGS_localnrmlrightctx);
+  // Augmented features differ every epoch and cannot be cached.
+  const std::string trainFeatureCacheDir =
+      sfxConf.empty() ? FLAGS_feature_cache_dir : "";
+
   auto _trainSplits = fl::lib::split(",", FLAGS_train, true);
   std::vector<fs::path> trainSplits;
   std::transform(
@@ -349,7 +366,9 @@ int main(int argc, char** argv) {
       worldSize,
       false, // allowEmpty
       FLAGS_batching_strategy,
-      FLAGS_batching_max_duration);
+      FLAGS_batching_max_duration,
+      trainFeatureCacheDir,
+      featureCacheConfig);
 
   std::map<std::string, std::shared_ptr<fl::Dataset>> validds;
   int64_t validBatchSize =
@@ -367,8 +386,11 @@ int main(int argc, char** argv) {
         padVal,
         worldRank,
         worldSize,
-        true // allowEmpty
-    );
+        true, // allowEmpty
+        kBatchStrategyNone,
+        0, // maxDurationPerBatch
+        FLAGS_feature_cache_dir,
+        featureCacheConfig);
   }
 
   /* =========== Create Network & Optimizers / Reload Snapshot ============ */
@@ -561,12 +583,14 @@ int main(int argc, char** argv) {
 
   /* ===================== Logging ===================== */
   std::ofstream logFile;
+  std::unique_ptr<AsyncLogWriter> logWriter;
   if (isMaster) {
     fs::create_directory(runPath);
     logFile.open(getRunFile("log", runIdx, runPath));
     if (!logFile) {
       LOG(FATAL) << "failed to open log file for writing";
     }
+    logWriter = std::make_unique<AsyncLogWriter>(logFile);
     // write config
     std::ofstream configFile(getRunFile("config", runIdx, runPath));
     cereal::JSONOutputArchive ar(configFile);
@@ -631,7 +655,7 @@ int main(int argc, char** argv) {
 
   /* ===================== Hooks ===================== */
   auto logStatus =
-      [&logFile, &validTagSets, &plGenerator, isMaster, dynamicScaler](
+      [&logWriter, &validTagSets, &plGenerator, isMaster, dynamicScaler](
           TrainMeters& mtrs,
           std::unordered_map<std::string, double>& validWerWithDecoder,
           int64_t epoch,
@@ -654,7 +678,7 @@ int main(int argc, char** argv) {
               lrcrit,
               scaleFactor);
           FL_LOG_MASTER(INFO) << logMsg;
-          appendToLog(logFile, logMsg);
+          logWriter->append(logMsg);
         }
       };
 
@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "flashlight/app/benchmark/LoaderBenchmarker.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <ostream>
+#include <stdexcept>
+
+namespace fl {
+namespace app {
+namespace benchmark {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double elapsedMs(const Clock::time_point& start) {
+  return std::chrono::duration<double, std::milli>(Clock::now() - start)
+      .count();
+}
+
+// wraps one stage so every fetch appends its latency to the stage's record;
+// getRange is left to the default implementation so per-sample timing is
+// preserved for range fetches
+class TimedDataset : public Dataset {
+ public:
+  TimedDataset(
+      std::shared_ptr<const Dataset> base,
+      std::shared_ptr<std::mutex> mutex,
+      std::shared_ptr<std::vector<double>> latenciesMs)
+      : base_(std::move(base)),
+        mutex_(std::move(mutex)),
+        latenciesMs_(std::move(latenciesMs)) {}
+
+  int64_t size() const override {
+    return base_->size();
+  }
+
+  std::vector<Tensor> get(const int64_t idx) const override {
+    const auto start = Clock::now();
+    auto sample = base_->get(idx);
+    const double latency = elapsedMs(start);
+    {
+      std::lock_guard<std::mutex> lock(*mutex_);
+      latenciesMs_->push_back(latency);
+    }
+    return sample;
+  }
+
+ private:
+  std::shared_ptr<const Dataset> base_;
+  std::shared_ptr<std::mutex> mutex_;
+  std::shared_ptr<std::vector<double>> latenciesMs_;
+};
+
+double percentile(const std::vector<double>& sorted, double q) {
+  if (sorted.empty()) {
+    return 0;
+  }
+  const auto rank = static_cast<size_t>(
+      std::ceil(q * static_cast<double>(sorted.size())));
+  return sorted[std::min(std::max<size_t>(rank, 1), sorted.size()) - 1];
+}
+
+} // namespace
+
+LoaderBenchmarker::StageRecord LoaderBenchmarker::addStage(
+    const std::string& name) {
+  StageRecord record;
+  record.name = name;
+  record.mutex = std::make_shared<std::mutex>();
+  record.latenciesMs = std::make_shared<std::vector<double>>();
+  stages_.push_back(record);
+  return record;
+}
+
+std::shared_ptr<Dataset> LoaderBenchmarker::instrument(
+    std::shared_ptr<const Dataset> dataset,
+    const std::string& name) {
+  if (!dataset) {
+    throw std::invalid_argument(
+        "LoaderBenchmarker::instrument - null dataset");
+  }
+  auto record = addStage(name);
+  return std::make_shared<TimedDataset>(
+      std::move(dataset), record.mutex, record.latenciesMs);
+}
+
+void LoaderBenchmarker::run(
+    std::shared_ptr<const Dataset> dataset,
+    int64_t epochs /* = 1 */) {
+  if (!dataset) {
+    throw std::invalid_argument("LoaderBenchmarker::run - null dataset");
+  }
+  auto record = addStage("total");
+  for (int64_t epoch = 0; epoch < epochs; epoch++) {
+    for (int64_t idx = 0; idx < dataset->size(); idx++) {
+      const auto start = Clock::now();
+      auto sample = dataset->get(idx);
+      for (auto& field : sample) {
+        fl::eval(field);
+      }
+      const double latency = elapsedMs(start);
+      std::lock_guard<std::mutex> lock(*record.mutex);
+      record.latenciesMs->push_back(latency);
+    }
+  }
+}
+
+std::vector<StageStats> LoaderBenchmarker::stats() const {
+  std::vector<StageStats> allStats;
+  for (const auto& record : stages_) {
+    std::vector<double> latencies;
+    {
+      std::lock_guard<std::mutex> lock(*record.mutex);
+      latencies = *record.latenciesMs;
+    }
+    std::sort(latencies.begin(), latencies.end());
+    StageStats stats;
+    stats.name = record.name;
+    stats.count = latencies.size();
+    for (const double latency : latencies) {
+      stats.meanMs += latency;
+    }
+    if (!latencies.empty()) {
+      stats.meanMs /= latencies.size();
+    }
+    stats.p50Ms = percentile(latencies, 0.50);
+    stats.p90Ms = percentile(latencies, 0.90);
+    stats.p99Ms = percentile(latencies, 0.99);
+    allStats.push_back(std::move(stats));
+  }
+  return allStats;
+}
+
+void LoaderBenchmarker::printStats(std::ostream& os) const {
+  os << std::fixed << std::setprecision(3);
+  os << std::setw(12) << "stage" << std::setw(10) << "count" << std::setw(12)
+     << "mean(ms)" << std::setw(12) << "p50(ms)" << std::setw(12) << "p90(ms)"
+     << std::setw(12) << "p99(ms)" << "\n";
+  for (const auto& stats : this->stats()) {
+    os << std::setw(12) << stats.name << std::setw(10) << stats.count
+       << std::setw(12) << stats.meanMs << std::setw(12) << stats.p50Ms
+       << std::setw(12) << stats.p90Ms << std::setw(12) << stats.p99Ms
+       << "\n";
+  }
+}
+
+} // namespace benchmark
+} // namespace app
+} // namespace fl
@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <iosfwd>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "flashlight/fl/flashlight.h"
+
+namespace fl {
+namespace app {
+namespace benchmark {
+
+/**
+ * Latency percentiles for one instrumented stage of a dataset chain. Times
+ * are inclusive of upstream stages - a stage's own cost is the gap between
+ * its percentiles and those of the stage it wraps.
+ */
+struct StageStats {
+  std::string name;
+  int64_t count{0};
+  double meanMs{0};
+  double p50Ms{0};
+  double p90Ms{0};
+  double p99Ms{0};
+};
+
+/**
+ * Measures the input side of training, which `ModelBenchmarker` leaves out:
+ * wrap each stage of a `Dataset` chain (load, augment, featurize, batch,
+ * prefetch) with `instrument`, then `run` drives the final dataset at full
+ * speed and reports per-stage latency percentiles, making the stage that
+ * starves the compute visible before committing cluster time.
+ *
+ * \code
+ * LoaderBenchmarker benchmarker;
+ * auto ds = benchmarker.instrument(listDataset, "load");
+ * ds = benchmarker.instrument(
+ *     std::make_shared<TransformDataset>(ds, transforms), "augment");
+ * ds = benchmarker.instrument(
+ *     std::make_shared<BatchDataset>(ds, batchSize), "batch");
+ * benchmarker.run(ds);
+ * benchmarker.printStats(std::cout);
+ * \endcode
+ *
+ * Instrumented stages are safe to drive from a `PrefetchDataset`'s worker
+ * threads.
+ */
+class LoaderBenchmarker {
+ public:
+  /**
+   * Wraps a stage of the chain so each `get` records its latency under
+   * `name`. The returned dataset is a drop-in replacement for `dataset`.
+   */
+  std::shared_ptr<Dataset> instrument(
+      std::shared_ptr<const Dataset> dataset,
+      const std::string& name);
+
+  /**
+   * Fetches every sample of `dataset` for `epochs` passes, recording
+   * end-to-end fetch latency under the stage name "total". Fetched tensors
+   * are evaluated so lazy backends do not defer the work out of the
+   * measurement.
+   */
+  void run(std::shared_ptr<const Dataset> dataset, int64_t epochs = 1);
+
+  /**
+   * Per-stage statistics in instrumentation order, with "total" last if
+   * `run` was called.
+   */
+  std::vector<StageStats> stats() const;
+
+  void printStats(std::ostream& os) const;
+
+ private:
+  struct StageRecord {
+    std::string name;
+    std::shared_ptr<std::mutex> mutex;
+    std::shared_ptr<std::vector<double>> latenciesMs;
+  };
+
+  StageRecord addStage(const std::string& name);
+
+  std::vector<StageRecord> stages_;
+};
+
+} // namespace benchmark
+} // namespace app
+} // namespace fl
@@ -7,6 +7,8 @@
 
 #include "flashlight/app/benchmark/ModelBenchmarker.h"
 
+#include <stdexcept>
+
 #include "flashlight/pkg/runtime/common/DistributedUtils.h"
 #include "flashlight/fl/flashlight.h"
 
@@ -14,6 +16,52 @@ namespace fl {
 namespace app {
 namespace benchmark {
 
+namespace {
+
+// FLOP estimates from parameter and activation shapes for the modules where
+// the count is well-defined; everything else reports 0 and is judged by its
+// memory traffic alone
+double estimateGflop(
+    const fl::Module& module,
+    const std::vector<fl::Variable>& outputs) {
+  const auto params = module.params();
+  if (params.empty() || outputs.empty()) {
+    return 0;
+  }
+  double flop = 0;
+  if (dynamic_cast<const fl::Linear*>(&module)) {
+    // weight -- [nOut, nIn]; 2 * nIn multiply-adds per output element
+    flop = 2.0 * params[0].dim(1) * outputs.front().elements();
+  } else if (dynamic_cast<const fl::Conv2D*>(&module)) {
+    // weight -- [wx, wy, cInPerGroup, cOut]
+    const auto& w = params[0];
+    flop = 2.0 * w.dim(0) * w.dim(1) * w.dim(2) *
+        outputs.front().elements();
+  } else {
+    return 0;
+  }
+  return flop / 1e9;
+}
+
+double traffickedGbyte(
+    const fl::Module& module,
+    const std::vector<fl::Variable>& inputs,
+    const std::vector<fl::Variable>& outputs) {
+  double bytes = 0;
+  for (const auto& param : module.params()) {
+    bytes += param.bytes();
+  }
+  for (const auto& input : inputs) {
+    bytes += input.bytes();
+  }
+  for (const auto& output : outputs) {
+    bytes += output.bytes();
+  }
+  return bytes / 1e9;
+}
+
+} // namespace
+
 constexpr size_t kWarmupUpdates = 50;
 constexpr size_t kRunUpdates = 100;
 
@@ -80,6 +128,46 @@ void ModelBenchmarker::runBenchmark(const std::vector<fl::Variable>& input) {
   syncMeters();
 }
 
+std::vector<ModuleProfile> ModelBenchmarker::profileModules(
+    const std::vector<fl::Variable>& input,
+    int iterations /* = 10 */) {
+  auto sequential = std::dynamic_pointer_cast<fl::Sequential>(model_);
+  if (!sequential) {
+    throw std::invalid_argument(
+        "ModelBenchmarker::profileModules - per-module profiling requires "
+        "a Sequential model so activations can be threaded module to module");
+  }
+  const auto children = sequential->modules();
+  std::vector<fl::TimeMeter> meters(
+      children.size(), fl::TimeMeter(/* unit = */ true));
+  std::vector<ModuleProfile> profiles(children.size());
+
+  // one untimed pass to settle allocator and algorithm caches
+  sequential->forward(input);
+  fl::sync();
+
+  for (int iter = 0; iter < iterations; iter++) {
+    auto activations = input;
+    for (size_t i = 0; i < children.size(); i++) {
+      meters[i].resume();
+      auto outputs = children[i]->forward(activations);
+      fl::sync();
+      meters[i].stopAndIncUnit();
+      if (iter == 0) {
+        profiles[i].name = children[i]->prettyString();
+        profiles[i].gflop = estimateGflop(*children[i], outputs);
+        profiles[i].gbyte =
+            traffickedGbyte(*children[i], activations, outputs);
+      }
+      activations = std::move(outputs);
+    }
+  }
+  for (size_t i = 0; i < children.size(); i++) {
+    profiles[i].timeMs = meters[i].value() * 1000;
+  }
+  return profiles;
+}
+
 double ModelBenchmarker::getBatchTime() const {
   return batchTimerMeter_.value();
 }
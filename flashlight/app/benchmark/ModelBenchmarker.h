@@ -17,6 +17,24 @@ namespace benchmark {
 
 using Criterion = std::function<fl::Variable(const std::vector<fl::Variable>&)>;
 
+/**
+ * Per-module cost breakdown from `ModelBenchmarker::profileModules`. FLOPs
+ * are estimated from parameter and activation shapes for compute-dense
+ * modules (`Linear`, `Conv2D`); bytes count parameters plus input and output
+ * activations. Their ratio (arithmetic intensity) places a module on the
+ * device roofline: below the machine balance point a layer is memory-bound,
+ * above it compute-bound.
+ */
+struct ModuleProfile {
+  std::string name;
+  /// Mean forward time per iteration, in ms
+  double timeMs{0};
+  /// Estimated FLOPs per forward, in GFLOP (0 when no estimate is known)
+  double gflop{0};
+  /// Parameter + activation traffic per forward, in GB
+  double gbyte{0};
+};
+
 class ModelBenchmarker {
  public:
   ModelBenchmarker(
@@ -26,6 +44,16 @@ class ModelBenchmarker {
 
   void runBenchmark(const std::vector<fl::Variable>& input);
 
+  /**
+   * Times each child module's forward separately and estimates its FLOPs and
+   * memory traffic. The model must be a `fl::Sequential` (or chain its
+   * children the same way) so activations can be threaded module to module;
+   * throws `std::invalid_argument` otherwise.
+   */
+  std::vector<ModuleProfile> profileModules(
+      const std::vector<fl::Variable>& input,
+      int iterations = 10);
+
   // Return time splits in seconds
   double getBatchTime() const;
   double getForwardTime() const;
@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "flashlight/app/benchmark/OpBenchmarker.h"
+
+#include <chrono>
+#include <fstream>
+#include <ostream>
+#include <stdexcept>
+#include <unordered_map>
+
+#include "flashlight/fl/runtime/DeviceManager.h"
+#include "flashlight/fl/tensor/DefaultTensorType.h"
+
+namespace fl {
+namespace app {
+namespace benchmark {
+
+namespace {
+
+// pulls the value following `"key":` out of a single-line JSON object - the
+// format is the one writeJson emits, not general JSON
+std::string extractField(const std::string& line, const std::string& key) {
+  const auto quoted = "\"" + key + "\":";
+  auto pos = line.find(quoted);
+  if (pos == std::string::npos) {
+    return "";
+  }
+  pos += quoted.size();
+  while (pos < line.size() && line[pos] == ' ') {
+    pos++;
+  }
+  bool isString = pos < line.size() && line[pos] == '"';
+  if (isString) {
+    pos++;
+  }
+  auto end = pos;
+  while (end < line.size() &&
+         (isString ? line[end] != '"'
+                   : line[end] != ',' && line[end] != '}')) {
+    end++;
+  }
+  return line.substr(pos, end - pos);
+}
+
+} // namespace
+
+OpBenchmarker::OpBenchmarker(
+    int iterations /* = 50 */,
+    int warmupIterations /* = 5 */)
+    : iterations_(iterations), warmupIterations_(warmupIterations) {
+  if (iterations_ < 1 || warmupIterations_ < 0) {
+    throw std::invalid_argument("OpBenchmarker: invalid iteration counts");
+  }
+}
+
+const OpBenchmarkResult& OpBenchmarker::run(
+    const std::string& name,
+    const std::function<void()>& fn) {
+  OpBenchmarkResult result;
+  result.name = name;
+  result.iterations = iterations_;
+
+  // first execution after setup: allocator and JIT caches are cold
+  fl::sync();
+  fl::TimeMeter coldMeter;
+  coldMeter.resume();
+  fn();
+  fl::sync();
+  coldMeter.stop();
+  result.coldTimeMs = coldMeter.value() * 1000;
+
+  for (int i = 0; i < warmupIterations_; i++) {
+    fn();
+  }
+  fl::sync();
+
+  fl::TimeMeter warmMeter(/* unit = */ true);
+  warmMeter.resume();
+  for (int i = 0; i < iterations_; i++) {
+    fn();
+  }
+  fl::sync();
+  warmMeter.stopAndIncUnit(iterations_);
+  result.warmTimeMs = warmMeter.value() * 1000;
+
+  results_.push_back(std::move(result));
+  return results_.back();
+}
+
+const std::vector<OpBenchmarkResult>& OpBenchmarker::results() const {
+  return results_;
+}
+
+void OpBenchmarker::writeJson(std::ostream& os) const {
+  const auto timestamp =
+      std::chrono::duration_cast<std::chrono::seconds>(
+          std::chrono::system_clock::now().time_since_epoch())
+          .count();
+  os << "{\n";
+  os << "\"metadata\": {"
+     << "\"backend\": \""
+     << fl::tensorBackendTypeToString(fl::defaultTensorBackend().backendType())
+     << "\", "
+     << "\"deviceCount\": "
+     << fl::DeviceManager::getInstance().getDeviceCount(fl::kDefaultDeviceType)
+     << ", "
+     << "\"timestamp\": " << timestamp << "},\n";
+  os << "\"results\": [\n";
+  for (size_t i = 0; i < results_.size(); i++) {
+    const auto& result = results_[i];
+    os << "{\"name\": \"" << result.name << "\", "
+       << "\"coldTimeMs\": " << result.coldTimeMs << ", "
+       << "\"warmTimeMs\": " << result.warmTimeMs << ", "
+       << "\"iterations\": " << result.iterations << "}"
+       << (i + 1 < results_.size() ? "," : "") << "\n";
+  }
+  os << "]\n}\n";
+}
+
+std::vector<OpBenchmarkResult> readBenchmarkJson(const std::string& path) {
+  std::ifstream file(path);
+  if (!file) {
+    throw std::runtime_error(
+        "readBenchmarkJson: cannot open '" + path + "'");
+  }
+  std::vector<OpBenchmarkResult> results;
+  std::string line;
+  while (std::getline(file, line)) {
+    const auto name = extractField(line, "name");
+    if (name.empty()) {
+      continue;
+    }
+    OpBenchmarkResult result;
+    result.name = name;
+    result.coldTimeMs = std::stod(extractField(line, "coldTimeMs"));
+    result.warmTimeMs = std::stod(extractField(line, "warmTimeMs"));
+    result.iterations = std::stoi(extractField(line, "iterations"));
+    results.push_back(std::move(result));
+  }
+  return results;
+}
+
+std::vector<std::string> findRegressions(
+    const std::vector<OpBenchmarkResult>& baseline,
+    const std::vector<OpBenchmarkResult>& current,
+    double threshold) {
+  std::unordered_map<std::string, double> baselineTimes;
+  for (const auto& result : baseline) {
+    baselineTimes[result.name] = result.warmTimeMs;
+  }
+  std::vector<std::string> regressions;
+  for (const auto& result : current) {
+    auto it = baselineTimes.find(result.name);
+    if (it != baselineTimes.end() &&
+        result.warmTimeMs > it->second * (1.0 + threshold)) {
+      regressions.push_back(result.name);
+    }
+  }
+  return regressions;
+}
+
+} // namespace benchmark
+} // namespace app
+} // namespace fl
@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <functional>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+#include "flashlight/fl/flashlight.h"
+
+namespace fl {
+namespace app {
+namespace benchmark {
+
+/**
+ * Timings for a single op configuration. `coldTimeMs` is the first execution
+ * after setup, when allocations miss the caching allocator and JIT state is
+ * empty; `warmTimeMs` is the steady-state mean over the timed iterations.
+ */
+struct OpBenchmarkResult {
+  std::string name;
+  double coldTimeMs{0};
+  double warmTimeMs{0};
+  int iterations{0};
+};
+
+/**
+ * Times individual tensor ops, complementing `ModelBenchmarker`, which only
+ * covers whole train steps. Ops are registered as closures over pre-built
+ * inputs; the harness runs a cold iteration, a warmup, and a synchronized
+ * timed loop, and serializes all results as JSON alongside backend and device
+ * metadata so runs on different machines remain distinguishable.
+ */
+class OpBenchmarker {
+ public:
+  explicit OpBenchmarker(int iterations = 50, int warmupIterations = 5);
+
+  /**
+   * Runs and records one op configuration. The closure must force evaluation
+   * of its result (e.g. via `fl::eval`) so the timed region covers the work.
+   *
+   * @param name a stable identifier, e.g. "matmul_f32_1024x1024x1024"
+   * @param fn the op to time
+   */
+  const OpBenchmarkResult& run(
+      const std::string& name,
+      const std::function<void()>& fn);
+
+  const std::vector<OpBenchmarkResult>& results() const;
+
+  /**
+   * Writes all recorded results as JSON, one result object per line, with a
+   * metadata header holding the tensor backend, device count, and timestamp.
+   */
+  void writeJson(std::ostream& os) const;
+
+ private:
+  int iterations_;
+  int warmupIterations_;
+  std::vector<OpBenchmarkResult> results_;
+};
+
+/**
+ * Reads results written by `OpBenchmarker::writeJson`.
+ */
+std::vector<OpBenchmarkResult> readBenchmarkJson(const std::string& path);
+
+/**
+ * Compares a run against a baseline and returns the names of ops whose warm
+ * time regressed by more than `threshold` (relative, e.g. 0.05 for 5%). Ops
+ * present in only one of the runs are skipped.
+ */
+std::vector<std::string> findRegressions(
+    const std::vector<OpBenchmarkResult>& baseline,
+    const std::vector<OpBenchmarkResult>& current,
+    double threshold);
+
+} // namespace benchmark
+} // namespace app
+} // namespace fl
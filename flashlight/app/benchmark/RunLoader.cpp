@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <iostream>
+
+#include <gflags/gflags.h>
+
+#include "flashlight/app/benchmark/LoaderBenchmarker.h"
+
+DEFINE_int64(loader_samples, 512, "Number of samples in the synthetic dataset");
+DEFINE_int64(loader_sample_size, 224, "Square sample edge length");
+DEFINE_int64(loader_batchsize, 32, "Batch size");
+DEFINE_int64(
+    loader_prefetch_threads,
+    0,
+    "If positive, drive the chain through a PrefetchDataset with this many "
+    "worker threads");
+DEFINE_int64(loader_prefetch_size, 8, "Prefetch queue depth");
+DEFINE_int64(loader_epochs, 2, "Passes over the dataset");
+
+using fl::app::benchmark::LoaderBenchmarker;
+
+int main(int argc, char** argv) {
+  fl::init();
+  gflags::ParseCommandLineFlags(&argc, &argv, false);
+
+  // A synthetic stand-in for a decoded-image source: swap in any Dataset
+  // (e.g. a list file dataset with its load function) to profile a real
+  // chain; the instrumentation below is stage-agnostic.
+  const auto size = FLAGS_loader_sample_size;
+  auto source = std::make_shared<fl::TensorDataset>(std::vector<fl::Tensor>{
+      fl::rand({size, size, 3, FLAGS_loader_samples})});
+
+  LoaderBenchmarker benchmarker;
+  auto ds = benchmarker.instrument(source, "decode");
+  ds = benchmarker.instrument(
+      std::make_shared<fl::TransformDataset>(
+          ds,
+          std::vector<fl::Dataset::TransformFunction>{[](const fl::Tensor& t) {
+            // flip + jitter stand-in for augmentation cost
+            return fl::flip(t, 0) * 0.9 + 0.1;
+          }}),
+      "augment");
+  ds = benchmarker.instrument(
+      std::make_shared<fl::TransformDataset>(
+          ds,
+          std::vector<fl::Dataset::TransformFunction>{[](const fl::Tensor& t) {
+            return (t - fl::mean(t, {0, 1}, /* keepDims = */ true)) / 255.f;
+          }}),
+      "featurize");
+  ds = benchmarker.instrument(
+      std::make_shared<fl::BatchDataset>(ds, FLAGS_loader_batchsize), "batch");
+  if (FLAGS_loader_prefetch_threads > 0) {
+    ds = benchmarker.instrument(
+        std::make_shared<fl::PrefetchDataset>(
+            ds, FLAGS_loader_prefetch_threads, FLAGS_loader_prefetch_size),
+        "prefetch");
+  }
+
+  benchmarker.run(ds, FLAGS_loader_epochs);
+  benchmarker.printStats(std::cout);
+  return 0;
+}
@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <fstream>
+#include <iostream>
+
+#include <gflags/gflags.h>
+
+#include "flashlight/app/benchmark/OpBenchmarker.h"
+#include "flashlight/fl/tensor/Index.h"
+
+DEFINE_int64(benchmark_iters, 50, "Timed iterations per op configuration");
+DEFINE_int64(benchmark_warmup_iters, 5, "Warmup iterations per configuration");
+DEFINE_string(json_path, "", "If set, write results as JSON to this path");
+DEFINE_string(
+    compare_baseline,
+    "",
+    "If set, compare this run against a baseline JSON written by a previous "
+    "run and exit nonzero when any op regresses past the threshold");
+DEFINE_double(
+    regression_threshold,
+    0.05,
+    "Relative warm-time slowdown flagged as a regression when comparing");
+
+namespace {
+
+using fl::app::benchmark::OpBenchmarker;
+
+void sweepMatmul(OpBenchmarker& benchmarker) {
+  for (int size : {128, 512, 1024, 2048}) {
+    for (auto type : {fl::dtype::f32, fl::dtype::f16}) {
+      if (type == fl::dtype::f16 && !fl::f16Supported()) {
+        continue;
+      }
+      auto lhs = fl::rand({size, size}, type);
+      auto rhs = fl::rand({size, size}, type);
+      benchmarker.run(
+          "matmul_" + fl::dtypeToString(type) + "_" + std::to_string(size),
+          [lhs, rhs]() {
+            auto out = fl::matmul(lhs, rhs);
+            fl::eval(out);
+          });
+    }
+  }
+}
+
+void sweepReductions(OpBenchmarker& benchmarker) {
+  for (int size : {1 << 16, 1 << 20, 1 << 24}) {
+    auto input = fl::rand({size});
+    benchmarker.run("sum_all_" + std::to_string(size), [input]() {
+      auto out = fl::sum(input, {0});
+      fl::eval(out);
+    });
+  }
+  for (int rows : {512, 4096, 32768}) {
+    auto input = fl::rand({rows, 256});
+    benchmarker.run("amax_axis0_" + std::to_string(rows) + "x256", [input]() {
+      auto out = fl::amax(input, {0});
+      fl::eval(out);
+    });
+    benchmarker.run("mean_axis1_" + std::to_string(rows) + "x256", [input]() {
+      auto out = fl::mean(input, {1});
+      fl::eval(out);
+    });
+  }
+}
+
+void sweepElementwise(OpBenchmarker& benchmarker) {
+  for (int size : {1 << 18, 1 << 22}) {
+    auto a = fl::rand({size});
+    auto b = fl::rand({size});
+    benchmarker.run("add_" + std::to_string(size), [a, b]() {
+      auto out = a + b;
+      fl::eval(out);
+    });
+    benchmarker.run("exp_" + std::to_string(size), [a]() {
+      auto out = fl::exp(a);
+      fl::eval(out);
+    });
+  }
+}
+
+void sweepIndexing(OpBenchmarker& benchmarker) {
+  for (int rows : {1024, 8192}) {
+    auto input = fl::rand({rows, 1024});
+    auto indices =
+        (fl::rand({rows / 2}) * (rows - 1)).astype(fl::dtype::s32);
+    benchmarker.run("slice_rows_" + std::to_string(rows), [input, rows]() {
+      auto out = input(fl::range(0, rows / 2));
+      fl::eval(out);
+    });
+    benchmarker.run(
+        "gather_rows_" + std::to_string(rows),
+        [input, indices]() {
+          auto out = input(indices);
+          fl::eval(out);
+        });
+    benchmarker.run("transpose_" + std::to_string(rows), [input]() {
+      auto out = fl::transpose(input);
+      fl::eval(out);
+    });
+  }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  fl::init();
+  gflags::ParseCommandLineFlags(&argc, &argv, false);
+
+  OpBenchmarker benchmarker(
+      FLAGS_benchmark_iters, FLAGS_benchmark_warmup_iters);
+  sweepMatmul(benchmarker);
+  sweepReductions(benchmarker);
+  sweepElementwise(benchmarker);
+  sweepIndexing(benchmarker);
+
+  for (const auto& result : benchmarker.results()) {
+    std::cout << result.name << ": warm " << result.warmTimeMs << " ms, cold "
+              << result.coldTimeMs << " ms" << std::endl;
+  }
+
+  if (!FLAGS_json_path.empty()) {
+    std::ofstream file(FLAGS_json_path);
+    benchmarker.writeJson(file);
+  }
+
+  if (!FLAGS_compare_baseline.empty()) {
+    auto baseline =
+        fl::app::benchmark::readBenchmarkJson(FLAGS_compare_baseline);
+    auto regressions = fl::app::benchmark::findRegressions(
+        baseline, benchmarker.results(), FLAGS_regression_threshold);
+    for (const auto& name : regressions) {
+      std::cout << "REGRESSION: " << name << std::endl;
+    }
+    return regressions.empty() ? 0 : 1;
+  }
+  return 0;
+}
@@ -7,7 +7,9 @@
 
 #include "flashlight/app/benchmark/Utils.h"
 
+#include <algorithm>
 #include <iomanip>
+#include <iostream>
 
 #include "flashlight/fl/flashlight.h"
 #include "flashlight/lib/text/String.h"
@@ -54,6 +56,46 @@ void printInfo(
   }
 }
 
+void printRoofline(
+    const std::vector<ModuleProfile>& profiles,
+    double peakGflops /* = 0 */,
+    double peakGbps /* = 0 */) {
+  if (fl::getWorldRank() != 0) {
+    return;
+  }
+  const bool havePeaks = peakGflops > 0 && peakGbps > 0;
+  std::cout << std::fixed << std::setprecision(2);
+  std::cout << std::setw(40) << "module" << std::setw(12) << "time(ms)"
+            << std::setw(12) << "GFLOP/s" << std::setw(14) << "FLOP/byte";
+  if (havePeaks) {
+    std::cout << std::setw(10) << "% peak" << std::setw(10) << "bound";
+  }
+  std::cout << std::endl;
+
+  for (const auto& profile : profiles) {
+    const double seconds = profile.timeMs / 1000;
+    const double achievedGflops =
+        seconds > 0 ? profile.gflop / seconds : 0;
+    const double intensity =
+        profile.gbyte > 0 ? profile.gflop / profile.gbyte : 0;
+    auto name = profile.name.substr(0, 39);
+    std::cout << std::setw(40) << name << std::setw(12) << profile.timeMs
+              << std::setw(12) << achievedGflops << std::setw(14) << intensity;
+    if (havePeaks) {
+      // the roofline: attainable rate is the compute peak, capped by what
+      // the memory system can feed at this module's intensity
+      const double attainable =
+          std::min(peakGflops, intensity * peakGbps);
+      const double percent =
+          attainable > 0 ? 100 * achievedGflops / attainable : 0;
+      const bool memoryBound = intensity < peakGflops / peakGbps;
+      std::cout << std::setw(10) << percent << std::setw(10)
+                << (memoryBound ? "memory" : "compute");
+    }
+    std::cout << std::endl;
+  }
+}
+
 } // namespace benchmark
 } // namespace app
 } // namespace fl
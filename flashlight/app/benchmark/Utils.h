@@ -31,6 +31,19 @@ void printInfo(
     int numUnits,
     bool verbose = false);
 
+/**
+ * Log a roofline table for a per-module profile from
+ * `ModelBenchmarker::profileModules`: achieved GFLOP/s, arithmetic intensity,
+ * and - when the device peaks are supplied - each module's percentage of its
+ * roofline-attainable rate and whether the memory or the compute ceiling
+ * binds it. Pass `peakGflops`/`peakGbps` from the device datasheet; 0 skips
+ * the peak-relative columns.
+ */
+void printRoofline(
+    const std::vector<ModuleProfile>& profiles,
+    double peakGflops = 0,
+    double peakGbps = 0);
+
 } // namespace benchmark
 } // namespace app
 } // namespace fl
@@ -103,9 +103,10 @@ int main(int argc, char** argv) {
       fl::BatchDatasetPolicy::INCLUDE_LAST);
   FL_LOG_MASTER(INFO) << "[testDataset size] " << testDataset.size();
 
-  // The main evaluation loop
-  TopKMeter top5Acc(5);
-  TopKMeter top1Acc(1);
+  // The main evaluation loop. Accuracy counts accumulate on device and are
+  // only read back when the meters sync after the loop
+  TopKMeter top5Acc(5, /* accumOnDevice = */ true);
+  TopKMeter top1Acc(1, /* accumOnDevice = */ true);
 
   model->eval();
   for (auto& example : testDataset) {
@@ -116,8 +117,7 @@ int main(int argc, char** argv) {
     top5Acc.add(output.tensor(), target.tensor());
     top1Acc.add(output.tensor(), target.tensor());
   }
-  fl::pkg::runtime::syncMeter(top5Acc);
-  fl::pkg::runtime::syncMeter(top1Acc);
+  fl::pkg::runtime::syncMeters(top5Acc, top1Acc);
 
   FL_LOG_MASTER(INFO) << "Top 5 acc: " << top5Acc.value();
   FL_LOG_MASTER(INFO) << "Top 1 acc: " << top1Acc.value();
@@ -95,9 +95,11 @@ fl::Variable criterion(const fl::Variable& in, const fl::Variable& target) {
 std::tuple<double, double, double> evalLoop(
     std::shared_ptr<Sequential> model,
     Dataset& dataset) {
-  AverageValueMeter lossMeter;
-  TopKMeter top5Acc(5);
-  TopKMeter top1Acc(1);
+  // Meters accumulate on device and are only read back when they sync after
+  // the loop
+  AverageValueMeter lossMeter(/* accumOnDevice = */ true);
+  TopKMeter top5Acc(5, /* accumOnDevice = */ true);
+  TopKMeter top1Acc(1, /* accumOnDevice = */ true);
 
   // Place the model in eval mode.
   model->eval();
@@ -109,14 +111,12 @@ std::tuple<double, double, double> evalLoop(
 
     // Compute and record the loss.
     auto loss = criterion(output, target);
-    lossMeter.add(loss.tensor().scalar<float>());
+    lossMeter.add(loss.tensor());
     top5Acc.add(output.tensor(), target.tensor());
     top1Acc.add(output.tensor(), target.tensor());
   }
   model->train();
-  fl::pkg::runtime::syncMeter(lossMeter);
-  fl::pkg::runtime::syncMeter(top5Acc);
-  fl::pkg::runtime::syncMeter(top1Acc);
+  fl::pkg::runtime::syncMeters(lossMeter, top5Acc, top1Acc);
 
   double loss = lossMeter.value()[0];
   return std::make_tuple(loss, top5Acc.value(), top1Acc.value());
@@ -108,6 +108,12 @@ DEFINE_bool(
     data_use_dynamic_batching,
     false,
     "if or not use dynamic batching in case of '--data_sample_break_mode=eos'.");
+DEFINE_string(
+    data_token_cache_dir,
+    "",
+    "Directory for the on-disk token-index cache, so repeated runs on the \
+    same corpus and dictionary skip tokenization. Empty disables caching. \
+    Can be shared across ranks and experiments.");
 
 /* DICTIONARY OPTIONS */
 DEFINE_string(
@@ -564,7 +570,9 @@ void Trainer::createTrainDatasets() {
       FLAGS_data_tokens_per_sample,
       FLAGS_data_batch_size,
       FLAGS_data_sample_break_mode,
-      true);
+      true,
+      fl::pkg::text::kMaxTokenInBuffer,
+      FLAGS_data_token_cache_dir);
   FL_LOG_MASTER(INFO) << "train dataset: " << trainDataset_->size()
                       << " samples";
 }
@@ -583,7 +591,9 @@ void Trainer::createValidDatasets() {
       FLAGS_data_tokens_per_sample,
       FLAGS_data_batch_size,
       "eos",
-      FLAGS_data_use_dynamic_batching);
+      FLAGS_data_use_dynamic_batching,
+      fl::pkg::text::kMaxTokenInBuffer,
+      FLAGS_data_token_cache_dir);
   FL_LOG_MASTER(INFO) << "valid dataset: " << validDataset_->size()
                       << " samples";
 }
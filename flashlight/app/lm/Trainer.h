@@ -60,6 +60,7 @@ DECLARE_int64(data_batch_size);
 DECLARE_int64(data_tokens_per_sample);
 DECLARE_string(data_sample_break_mode);
 DECLARE_bool(data_use_dynamic_batching);
+DECLARE_string(data_token_cache_dir);
 
 /* DICTIONARY OPTIONS */
 DECLARE_string(dictionary);
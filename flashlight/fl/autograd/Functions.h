@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <vector>
@@ -118,6 +119,24 @@ std::shared_ptr<AutogradPayload> createAutogradPayload(H head, T... tail) {
  */
 FL_API Variable operator+(const Variable& lhs, const Variable& rhs);
 
+/**
+ * Element-wise addition of two Variables, reusing the left-hand side's
+ * tensor for the result instead of allocating a fresh one.
+ * \f[ out = var_1 + var_2 \f]
+ * Safe for autograd since addition gradients do not depend on the operand
+ * values. `lhs`'s tensor is overwritten: `lhs` (and any Variable sharing its
+ * tensor) must not be read again after the call; use the returned Variable.
+ */
+FL_API Variable addInPlace(Variable& lhs, const Variable& rhs);
+
+/**
+ * Fused multiply-add of three Variables, computed without materializing the
+ * intermediate product.
+ * \f[ out = var_1 + var_2 \times var_3 \f]
+ */
+FL_API Variable
+addMul(const Variable& lhs, const Variable& rhsA, const Variable& rhsB);
+
 /**
  * Adds a scalar to each element in the Variable.
  * \f[ out_i = value + var_i \f]
@@ -346,6 +365,24 @@ clamp(const Variable& input, const double min, const double max);
  */
 FL_API Variable sigmoid(const Variable& input);
 
+/**
+ * Computes the product of the sigmoid of one Variable with another in a
+ * single graph node, as in GLU-style gating.
+ * \f[ out = \frac{1}{1 + \exp(-var_1)} \times var_2 \f]
+ * Equivalent to `sigmoid(gate) * input` but builds one node instead of two
+ * and retains only the sigmoid output for the backward pass.
+ */
+FL_API Variable sigmoidMul(const Variable& gate, const Variable& input);
+
+/**
+ * Computes the product of the hyperbolic tangent of one Variable with
+ * another in a single graph node, as in GLU-style gating.
+ * \f[ out = \tanh(var_1) \times var_2 \f]
+ * Equivalent to `tanh(gate) * input` but builds one node instead of two and
+ * retains only the tanh output for the backward pass.
+ */
+FL_API Variable tanhMul(const Variable& gate, const Variable& input);
+
 /**
  * Computes swish of each element in a Variable
  * from [Ramachandran et al (2013)](
@@ -572,6 +609,29 @@ FL_API Variable matmulTN(const Variable& lhs, const Variable& rhs);
  */
 FL_API Variable matmulNT(const Variable& lhs, const Variable& rhs);
 
+/**
+ * Evaluates an Einstein summation over the given Variables, e.g.
+ * `einsum("ij,jk->ik", {x, y})` is `matmul(x, y)`. Subscripts name one
+ * dimension per letter, dimension 0 first; a letter shared between operands
+ * and absent from the output is summed over, a shared letter present in the
+ * output batches, and the output subscripts give the dimension order of the
+ * result. If `->` is omitted, the output holds the letters appearing exactly
+ * once, in alphabetical order.
+ *
+ * With more than two operands the pairwise contraction order is chosen by a
+ * dynamic program minimizing the estimated multiply-add count given the
+ * operand shapes. Each pairwise contraction runs as a single batched matmul;
+ * an operand whose layout is already grouped with the contracted dimensions
+ * leading has its transpose folded into the GEMM rather than materialized.
+ * Repeated subscripts within one operand (diagonals) are not supported.
+ *
+ * @param equation the subscripts, e.g. "abe,cbe->acb"
+ * @param operands one Variable per comma-separated input subscript
+ * @return a Variable with one dimension per output subscript
+ */
+FL_API Variable
+einsum(const std::string& equation, const std::vector<Variable>& operands);
+
 /**
  * Returns the absolute values of each element in a Variable.
  * \f[ out_i = |var_i| \f]
@@ -619,6 +679,28 @@ FL_API Variable linear(const Variable& input, const Variable& weight);
 FL_API Variable
 linear(const Variable& input, const Variable& weight, const Variable& bias);
 
+/**
+ * Applies a linear transformation with a fused output epilogue:
+ * \f[
+ *    y = f(Ax + b)
+ * \f]
+ * where \f$f\f$ is selected by `epilogue`. The bias broadcast-add and
+ * activation are evaluated in the same elementwise pass over the matmul
+ * output - and backpropagated through a single gradient closure - instead of
+ * lowering to separate add and activation autograd ops.
+ *
+ * @param input a Variable with shape [\f$N\f$, \f$M\f$, \f$B_1\f$, \f$B_2\f$]
+ * @param weight a Variable with shape [\f$K\f$, \f$N\f$]
+ * @param bias a Variable with shape [\f$K\f$]
+ * @param epilogue the `Epilogue` to apply to the output
+ * @return a Variable with shape [\f$K\f$, \f$M\f$, \f$B_1\f$, \f$B_2\f$]
+ */
+FL_API Variable linear(
+    const Variable& input,
+    const Variable& weight,
+    const Variable& bias,
+    const Epilogue epilogue);
+
 /**
  * Applies a 2D convolution over an input signal given filter weights. In the
  * simplest case, the output with shape [\f$X_{out}\f$, \f$Y_{out}\f$,
@@ -710,6 +792,30 @@ FL_API Variable conv2d(
     int groups = 1,
     std::shared_ptr<detail::ConvBenchmarks> benchmarks = nullptr);
 
+/**
+ * Applies a 2D convolution with a fused output epilogue. The bias is applied
+ * by the backend convolution and the activation selected by `epilogue` is
+ * evaluated in a single elementwise pass over the convolution output, with
+ * the whole op backpropagated through one gradient closure.
+ *
+ * See `conv2d` above for the shape and stride/padding/dilation semantics.
+ *
+ * @param epilogue the `Epilogue` to apply to the output
+ */
+FL_API Variable conv2d(
+    const Variable& input,
+    const Variable& weights,
+    const Variable& bias,
+    int sx,
+    int sy,
+    int px,
+    int py,
+    int dx,
+    int dy,
+    int groups,
+    const Epilogue epilogue,
+    std::shared_ptr<detail::ConvBenchmarks> benchmarks = nullptr);
+
 /**
  * Applies a 2D pooling over an input signal composed of several input planes.
  * @param input a Variable with shape [\f$X_{in}\f$, \f$Y_{in}\f$, \f$C\f$,
@@ -745,6 +851,30 @@ FL_API Variable pool2d(
  */
 FL_API Variable softmax(const Variable& input, const int dim);
 
+/**
+ * Computes a masked softmax with temperature, fused into a single op.
+ * Equivalent to `softmax(input / temperature + mask, dim)`, but the mask
+ * addition, scaling, max-subtraction, exponentiation, and normalization all
+ * run inside one autograd node with a matching fused backward, instead of
+ * materializing the masked score tensor as a separate graph node. Attention
+ * code applying an additive mask before `softmax` should prefer this
+ * overload - for [\f$T \times T \times H \times B\f$] score tensors it
+ * halves the number of full passes over the scores.
+ *
+ * @param input a `Variable` of raw scores
+ * @param dim the dimension along which to normalize
+ * @param mask an additive log-space mask (e.g. large negative values at
+ * masked positions), tiled to the input shape as needed; an empty tensor
+ * disables masking. The mask contributes no gradient.
+ * @param temperature a positive scalar the scores are divided by before
+ * normalization; 1 leaves them unchanged
+ */
+FL_API Variable softmax(
+    const Variable& input,
+    const int dim,
+    const Tensor& mask,
+    const double temperature = 1.0);
+
 /**
  * Applies a log(softmax(x)) function on Variable `input` along dimension `dim`
  * \f[
@@ -804,6 +934,45 @@ FL_API Variable categoricalCrossEntropy(
     ReduceMode reduction = ReduceMode::MEAN,
     int ignoreIndex = -1);
 
+/**
+ * Computes the softmax cross entropy loss with optional label smoothing,
+ * fused into a single op. The input contains raw (unnormalized) scores for
+ * each class; chaining `logSoftmax` into `categoricalCrossEntropy` computes
+ * the same loss but materializes the [\f$C\f$, \f$B_1\f$, \f$B_2\f$,
+ * \f$B_3\f$] log-probability tensor and retains it for backward, which
+ * dominates memory and bandwidth when \f$C\f$ is a large vocabulary. This op
+ * keeps only the per-position log-normalizers and the target indices; the
+ * gradient \f$\text{softmax}(x) - q\f$, with \f$q\f$ the smoothed target
+ * distribution, is formed directly in the backward pass.
+ *
+ * With label smoothing \f$\epsilon\f$, the target distribution places
+ * \f$1 - \epsilon + \epsilon / C\f$ on the true class and \f$\epsilon / C\f$
+ * elsewhere.
+ *
+ * @param input a `Variable` of class scores with shape [\f$C\f$, \f$B_1\f$,
+ * \f$B_2\f$, \f$B_3\f$] where \f$C\f$ is the number of classes.
+ * @param targets an integer `Variable` with shape [\f$B_1\f$, \f$B_2\f$,
+ * \f$B_3\f$]. The values must be in \f$[0, C - 1]\f$
+ * @param labelSmoothing the smoothing weight \f$\epsilon \in [0, 1)\f$;
+ * 0 recovers plain softmax cross entropy
+ * @param reduction reduction mode, which supports:
+ * - NONE
+ * - MEAN
+ * - SUM
+ * @param ignoreIndex a target value that is ignored and does not contribute
+ * to the loss or the input gradient. If `reduce` is MEAN, the loss is
+ * averaged over non-ignored targets. Only indicies in \f$[0, C - 1]\f$ are
+ * considered to be valid.
+ * @return a `Variable` of loss value with shape scalar by default. If `reduce`
+ * is NONE, then [\f$B_1\f$, \f$B_2\f$, \f$B_3\f$].
+ */
+FL_API Variable softmaxCrossEntropy(
+    const Variable& input,
+    const Variable& targets,
+    double labelSmoothing = 0.0,
+    ReduceMode reduction = ReduceMode::MEAN,
+    int ignoreIndex = -1);
+
 /**
  * Computes the weighted cross entropy loss. The input is expected to
  * contain log-probabilities for each class. The targets should be the
@@ -892,6 +1061,38 @@ FL_API std::tuple<Variable, Variable, Variable> rnn(
     bool bidirectional,
     float dropout);
 
+/**
+ * Variable-sequence-length version of `rnn`. Takes a padded batch along with
+ * one length per batch element; batch elements may be in any order. Sequences
+ * are internally sorted by decreasing length and handed to the backend's
+ * packed-sequence kernel so no computation is spent on padding, then restored
+ * to the caller's batch order on output.
+ *
+ * @param input Variable of input with shape [input size, batch size, max
+ * sequence length]
+ * @param seqLengths the valid length of each batch element along the sequence
+ * dim; must have one entry per batch element, each in [1, max sequence length]
+ *
+ * All other parameters and return values are as in `rnn`, with two
+ * differences: `y` positions past a sequence's length are zero, and the
+ * returned hidden/cell states hold each sequence's state at its own final
+ * step.
+ *
+ * Throws if the backend has no packed-sequence support (currently only the
+ * CUDA/cuDNN backend provides it).
+ */
+FL_API std::tuple<Variable, Variable, Variable> rnn(
+    const Variable& input,
+    const Variable& hiddenState,
+    const Variable& cellState,
+    const Variable& weights,
+    const std::vector<int>& seqLengths,
+    int hiddenSize,
+    int numLayers,
+    RnnMode mode,
+    bool bidirectional,
+    float dropout);
+
 /**
  * Looks up embeddings in a fixed dictionary and size.
  * @param input a Variable of a list of indices with shape [\f$B_1\f$,
@@ -904,6 +1105,33 @@ FL_API std::tuple<Variable, Variable, Variable> rnn(
  */
 FL_API Variable embedding(const Variable& input, const Variable& embeddings);
 
+/**
+ * Looks up embeddings in a fixed dictionary and size, optionally producing a
+ * sparse gradient for the embedding matrix.
+ *
+ * With `sparseGrad` true, the backward pass accumulates the gradient only for
+ * the embedding vectors actually looked up, stored on `embeddings` as a
+ * `SparseGrad` of (unique indices, values) rather than a dense gradient the
+ * size of the full table. Sparse-aware optimizers (`AdagradOptimizer`,
+ * `AdamOptimizer`) then update only the touched vectors and their state rows;
+ * any other gradient consumer transparently receives the equivalent dense
+ * gradient (see `Variable::grad`). Note that distributed gradient
+ * synchronization densifies, so sparse gradients mostly pay off in
+ * single-process training with large dictionaries.
+ *
+ * @param input a Variable of a list of indices with shape [\f$B_1\f$,
+ * \f$B_2\f$, \f$B_3\f$]
+ * @param embeddings a Variable of an embedding matrix with shape [\f$D\f$,
+ * \f$N\f$], where \f$N\f$ is the number of items and \f$D\f$ is the embedding
+ * size.
+ * @param sparseGrad whether to accumulate the embedding gradient in sparse
+ * form
+ * @return a Variable of embeddings with shape [\f$D\f$, \f$B_1\f$, \f$B_2\f$,
+ * \f$B_3\f$]
+ */
+FL_API Variable
+embedding(const Variable& input, const Variable& embeddings, bool sparseGrad);
+
 /**
  * Applies Batch Normalization over a 4D input (a mini-batch of 2D inputs with
  * additional channel dimension) as described in the paper
@@ -943,6 +1171,99 @@ FL_API Variable batchnorm(
     double momentum,
     double epsilon);
 
+/**
+ * Applies Layer Normalization over an input as described in the paper
+ * [Layer Normalization](https://arxiv.org/abs/1607.06450), normalizing over
+ * all axes not in `axes` and applying an optional learnable affine transform
+ * in the same autograd op.
+ *
+ * The statistics are computed by the backend's fused normalization kernel and
+ * the affine transform is applied as a single elementwise pass over the
+ * normalized activations, rather than lowering to a chain of
+ * mean/var/normalize/scale tensor ops each with their own gradient closure.
+ *
+ * @param input a Variable to normalize
+ * @param weight a Variable for \f$\gamma\f$, shaped to broadcast against
+ * `input` (singleton on the axes in `axes`), or an empty Variable to skip the
+ * affine transform
+ * @param bias a Variable for \f$\beta\f$ with the same shape requirements as
+ * `weight`
+ * @param axes the batchnorm-style feature axes - statistics are computed over
+ * all axes not listed here
+ * @param epsilon value of \f$\epsilon\f$ added to the variance
+ *
+ * @return a Variable with the same shape as `input`
+ */
+FL_API Variable layerNorm(
+    const Variable& input,
+    const Variable& weight,
+    const Variable& bias,
+    const std::vector<int>& axes,
+    double epsilon);
+
+/**
+ * Layer normalization with a fused output epilogue. The epilogue activation
+ * is folded into the same elementwise pass as the affine transform instead of
+ * issued as a separate autograd op; its derivative is chained analytically in
+ * the backward pass. `Epilogue::NONE` and `Epilogue::BIAS` are equivalent
+ * here - whether the affine transform is applied is controlled by passing or
+ * omitting `weight`/`bias`.
+ *
+ * @param epilogue the epilogue applied to the normalized (and, if given,
+ * affine-transformed) output
+ *
+ * All other parameters and the return value are as in `layerNorm` above.
+ */
+FL_API Variable layerNorm(
+    const Variable& input,
+    const Variable& weight,
+    const Variable& bias,
+    const std::vector<int>& axes,
+    double epsilon,
+    const Epilogue epilogue);
+
+/**
+ * Residual add followed by layer normalization, fused into a single op.
+ * Equivalent to `layerNorm(residual + input, weight, bias, axes, epsilon)`,
+ * but the sum never becomes its own autograd node: it is formed in the same
+ * pass that feeds the normalization statistics and is consumed directly by
+ * the fused backward, instead of costing a full extra read and write of the
+ * activations per sublayer. `input` is cast to `residual`'s type before the
+ * add. Residual sublayers (`norm(x + sublayer(x))`) should prefer this over
+ * composing `+` and `layerNorm`.
+ *
+ * @param residual the residual branch \f$x\f$
+ * @param input the sublayer branch, with the same shape as `residual`
+ *
+ * All other parameters and the return value are as in `layerNorm` above.
+ */
+FL_API Variable addNorm(
+    const Variable& residual,
+    const Variable& input,
+    const Variable& weight,
+    const Variable& bias,
+    const std::vector<int>& axes,
+    double epsilon);
+
+/**
+ * `addNorm` with dropout on the sublayer branch. Equivalent to
+ * `layerNorm(residual + dropout(input, p), weight, bias, axes, epsilon)`,
+ * with the mask applied in the same pass as the add and the normalization
+ * statistics. A `p` of 0 reduces to `addNorm`.
+ *
+ * @param p the probability of dropout, applied to `input` only
+ *
+ * All other parameters and the return value are as in `addNorm` above.
+ */
+FL_API Variable addDropoutNorm(
+    const Variable& residual,
+    const Variable& input,
+    double p,
+    const Variable& weight,
+    const Variable& bias,
+    const std::vector<int>& axes,
+    double epsilon);
+
 /**
  * Applies asymmetric padding on a Variable `input`.
  * @param input input Variable
@@ -964,6 +1285,26 @@ FL_API Variable padding(
  */
 FL_API Variable dropout(const Variable& input, double p);
 
+/**
+ * Applies dropout on a Variable `input` with a mask drawn from the stateless
+ * counter-based generator (see `fl::philoxRand`).
+ *
+ * Unlike the overload above, the mask tensor is not retained for the backward
+ * pass: only the `(seed, counter)` pair is stored in the gradient function
+ * and the mask is regenerated when the gradient is computed. This trades a
+ * cheap extra generation in backward for the full mask memory, which adds up
+ * when dropout follows every sublayer of a deep network.
+ *
+ * @param input input Variable
+ * @param p the probability of dropout
+ * @param seed the generator key, typically fixed for a run
+ * @param counter the position in the seed's stream; advance it per call so
+ * successive masks are independent
+ * @return a droped out Variable
+ */
+FL_API Variable
+dropout(const Variable& input, double p, uint64_t seed, uint64_t counter);
+
 /**
  * Applies the [rectified linear
  * unit](https://en.wikipedia.org/wiki/Rectifier_(neural_networks)) function
@@ -985,6 +1326,36 @@ FL_API Variable gelu(const Variable& input);
  */
 FL_API Variable relativePositionalEmbeddingRotate(const Variable& input);
 
+/**
+ * Memory-efficient scaled dot-product attention computed in query blocks.
+ *
+ * Computes `matmul(softmax(scale * matmulNT(query, key) + mask, 1), value)`
+ * without ever materializing the full [querySteps x keySteps] score matrix:
+ * queries are processed `queryChunkSize` rows at a time, so peak score
+ * memory is [queryChunkSize x keySteps] per block, and each block's scores
+ * and softmax are freed as soon as the block's output is produced. The
+ * backward pass recomputes each block's softmax from the retained
+ * query/key/value tensors and backpropagates block by block.
+ *
+ * @param query query Variable of size querySteps x headDim x (nHeads * B)
+ * @param key key Variable of size keySteps x headDim x (nHeads * B)
+ * @param value value Variable of size keySteps x headDim x (nHeads * B)
+ * @param scale multiplier applied to the attention scores, typically
+ * 1 / sqrt(headDim)
+ * @param mask additive mask applied to the scores before the softmax; empty
+ * for no mask, else its leading dimension must be 1 (broadcast over query
+ * steps) or equal to querySteps, with remaining dimensions tiling to the
+ * score shape
+ * @param queryChunkSize number of query steps processed per block
+ */
+FL_API Variable scaledDotProductAttention(
+    const Variable& query,
+    const Variable& key,
+    const Variable& value,
+    const double scale,
+    const Variable& mask,
+    const int queryChunkSize);
+
 /**
  * Multihead Attention function
  * For details, see [Vaswani et al (2017)](https://arxiv.org/abs/1706.03762).
@@ -993,14 +1364,21 @@ FL_API Variable relativePositionalEmbeddingRotate(const Variable& input);
  * @param value value Variable of size Time x nHeads * headDim x B
  * @param posEmb if non empty then compute relative
  * positional embedding in additon to standard computations
- * @param mask mask or not future in the computations T x T
- * if non-empty then don't use future (for example for autoregressive language
- * models or for decoder part in the encoder-decoder transformer models)
+ * @param mask additive mask on the attention scores, T x T, or T x T x B for
+ * a mask that differs per batch element (e.g. a document-attention mask over
+ * packed sequences); if non-empty then don't use future (for example for
+ * autoregressive language models or for decoder part in the encoder-decoder
+ * transformer models)
  * @param padMask mask which is 1 for positions where pad token is,
  * don't attend to the pad-positions, of size T x B
  * @param nHeads number of heads
  * @param pDropout dropout probability
  * @param offset size of the current output from the decoder used now as input
+ * @param queryChunkSize if positive, compute the attention in query blocks
+ * of this size via `scaledDotProductAttention`, never materializing the full
+ * [T x T] score matrix; only applies when posEmb is empty, dropout is
+ * disabled and at most one of mask/padMask is given, else falls back to the
+ * dense computation
  */
 FL_API Variable multiheadAttention(
     const Variable& query,
@@ -1011,7 +1389,8 @@ FL_API Variable multiheadAttention(
     const Variable& padMask,
     const int32_t nHeads,
     const double pDropout,
-    const int32_t offset = 0);
+    const int32_t offset = 0,
+    const int32_t queryChunkSize = 0);
 
 /** @} */
 
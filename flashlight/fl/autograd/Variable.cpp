@@ -9,20 +9,171 @@
 
 #include <algorithm>
 #include <cassert>
+#include <exception>
 #include <functional>
+#include <future>
 #include <memory>
+#include <mutex>
 #include <stdexcept>
+#include <unordered_map>
 #include <unordered_set>
 #include <utility>
+#include <vector>
 
 #include "flashlight/fl/autograd/Functions.h"
+#include "flashlight/fl/common/Trace.h"
 #include "flashlight/fl/common/Utils.h"
+#include "flashlight/fl/common/threadpool/ThreadPool.h"
+#include "flashlight/fl/runtime/Stream.h"
 #include "flashlight/fl/tensor/Compute.h"
 #include "flashlight/fl/tensor/Index.h"
 #include "flashlight/fl/tensor/Shape.h"
 
 namespace fl {
 
+namespace {
+
+// Per-thread autograd mode; all graph-building Variable construction funnels
+// through the inputs/gradFunc constructor below, which consults this flag
+thread_local bool gradModeEnabled = true;
+
+// Number of threads dispatching gradFuncs in Variable::backward; serial
+// backward when <= 1. See setBackwardParallelism.
+unsigned backwardNumThreads = 1;
+
+// Set on thread pool workers so that a nested backward (e.g. the inner
+// backward of a checkpointed segment) stays serial rather than re-entering
+// the shared pool and deadlocking
+thread_local bool inParallelBackward = false;
+
+// Serializes gradient accumulation into inputs shared between gradFuncs
+// running concurrently during a parallel backward
+std::mutex gradAccumulationMutex;
+
+// Cap on recycled graph metadata nodes held per thread and node type; nodes
+// beyond the cap go back to the heap
+constexpr size_t kMaxPooledGraphNodes = 1 << 15;
+
+// Pooled allocator for autograd graph metadata (SharedData/SharedGrad).
+// Nodes live for exactly one step -- freed as backward() clears inputs -- so
+// rather than returning them to the heap they are recycled through a
+// per-thread free list and handed back on the next forward. Used with
+// allocate_shared, so the control block and payload share the single pooled
+// allocation. The list is thread-local since data loaders and a parallel
+// backward allocate and free concurrently; a node freed on a different thread
+// than it was allocated on simply lands on the freeing thread's list.
+template <typename T>
+class GraphNodeAllocator {
+ public:
+  using value_type = T;
+
+  GraphNodeAllocator() = default;
+  template <typename U>
+  GraphNodeAllocator(const GraphNodeAllocator<U>&) noexcept {}
+
+  T* allocate(size_t n) {
+    auto& nodes = freeList().nodes;
+    if (n == 1 && !nodes.empty()) {
+      T* node = static_cast<T*>(nodes.back());
+      nodes.pop_back();
+      return node;
+    }
+    return static_cast<T*>(::operator new(n * sizeof(T)));
+  }
+
+  void deallocate(T* p, size_t n) {
+    auto& nodes = freeList().nodes;
+    if (n == 1 && nodes.size() < kMaxPooledGraphNodes) {
+      nodes.push_back(p);
+      return;
+    }
+    ::operator delete(p);
+  }
+
+  template <typename U>
+  bool operator==(const GraphNodeAllocator<U>&) const noexcept {
+    return true;
+  }
+  template <typename U>
+  bool operator!=(const GraphNodeAllocator<U>&) const noexcept {
+    return false;
+  }
+
+ private:
+  struct FreeList {
+    std::vector<void*> nodes;
+    ~FreeList() {
+      for (void* node : nodes) {
+        ::operator delete(node);
+      }
+    }
+  };
+
+  // One list per instantiation: allocate_shared rebinds the allocator to the
+  // fused control-block-plus-payload type, so every node in a list has the
+  // same size and any of them can satisfy any allocation
+  static FreeList& freeList() {
+    static thread_local FreeList list;
+    return list;
+  }
+};
+
+ThreadPool& backwardThreadPool(unsigned numThreads) {
+  static std::unique_ptr<ThreadPool> pool;
+  static unsigned poolSize = 0;
+  if (!pool || poolSize != numThreads) {
+    pool = std::make_unique<ThreadPool>(numThreads);
+    poolSize = numThreads;
+  }
+  return *pool;
+}
+
+} // namespace
+
+void setBackwardParallelism(unsigned numThreads) {
+  backwardNumThreads = std::max(1u, numThreads);
+}
+
+unsigned backwardParallelism() {
+  return backwardNumThreads;
+}
+
+namespace detail {
+
+bool gradMode() {
+  return gradModeEnabled;
+}
+
+void setGradMode(bool enable) {
+  gradModeEnabled = enable;
+}
+
+GradModeGuard::GradModeGuard(bool enable) : prevMode_(gradModeEnabled) {
+  gradModeEnabled = enable;
+}
+
+GradModeGuard::~GradModeGuard() {
+  gradModeEnabled = prevMode_;
+}
+
+} // namespace detail
+
+NoGradGuard::NoGradGuard() : prevMode_(gradModeEnabled) {
+  gradModeEnabled = false;
+}
+
+NoGradGuard::~NoGradGuard() {
+  gradModeEnabled = prevMode_;
+}
+
+std::shared_ptr<Variable::SharedData> Variable::makeSharedData() {
+  return std::allocate_shared<SharedData>(GraphNodeAllocator<SharedData>());
+}
+
+std::shared_ptr<Variable::SharedGrad> Variable::makeSharedGrad() {
+  return std::allocate_shared<SharedGrad>(GraphNodeAllocator<SharedGrad>());
+}
+
 Variable::Variable(Tensor data, bool calcGrad) {
   sharedData_->data = std::move(data);
   sharedGrad_->calcGrad = calcGrad;
@@ -33,7 +184,10 @@ Variable::Variable(
     std::vector<Variable> inputs,
     GradFunc gradFunc) {
   sharedData_->data = std::move(data);
-  if (std::any_of(inputs.begin(), inputs.end(), [](const Variable& input) {
+  // With grad mode disabled (see NoGradGuard), build no graph: inputs are
+  // released when the enclosing op returns and gradFunc is never stored
+  if (gradModeEnabled &&
+      std::any_of(inputs.begin(), inputs.end(), [](const Variable& input) {
         return input.isCalcGrad();
       })) {
     sharedGrad_->calcGrad = true;
@@ -94,7 +248,7 @@ Variable Variable::astype(fl::dtype newType) const {
                      const Variable& gradOutput) {
     auto& input = inputs[0];
     // Cast the grad output to match the type of the input's grad
-    input.addGrad(Variable(gradOutput.tensor().astype(input.type()), false));
+    input.addGrad(gradOutput.astype(input.type()));
   };
   return Variable(output, {this->withoutData()}, gradFunc);
 }
@@ -104,6 +258,13 @@ Variable& Variable::grad() const {
     throw std::logic_error("gradient calculation disabled for this Variable");
   }
 
+  if (!sharedGrad_->grad && sharedGrad_->sparseGrad) {
+    std::lock_guard<std::mutex> lock(gradAccumulationMutex);
+    if (sharedGrad_->sparseGrad) {
+      materializeSparseGrad();
+    }
+  }
+
   if (!sharedGrad_->grad) {
     throw std::logic_error("gradient not calculated yet for this Variable");
   }
@@ -111,6 +272,29 @@ Variable& Variable::grad() const {
   return *sharedGrad_->grad;
 }
 
+const SparseGrad& Variable::sparseGrad() const {
+  if (!sharedGrad_->calcGrad) {
+    throw std::logic_error("gradient calculation disabled for this Variable");
+  }
+
+  if (!sharedGrad_->sparseGrad) {
+    throw std::logic_error("sparse gradient not available for this Variable");
+  }
+
+  return *sharedGrad_->sparseGrad;
+}
+
+void Variable::materializeSparseGrad() const {
+  const auto& sparse = *sharedGrad_->sparseGrad;
+  Tensor dense = fl::full(shape(), 0, type());
+  std::vector<Index> sel(ndim(), fl::span);
+  sel.back() = sparse.indices;
+  // the indices are unique, so a single scatter covers every touched slice
+  dense(sel) = sparse.values;
+  sharedGrad_->grad = std::make_unique<Variable>(std::move(dense), false);
+  sharedGrad_->sparseGrad.reset();
+}
+
 std::vector<Variable>& Variable::getInputs() const {
   return sharedGrad_->inputs;
 }
@@ -123,7 +307,14 @@ bool Variable::isGradAvailable() const {
   if (!sharedGrad_->calcGrad) {
     return false;
   }
-  return sharedGrad_->grad != nullptr;
+  return sharedGrad_->grad != nullptr || sharedGrad_->sparseGrad != nullptr;
+}
+
+bool Variable::isSparseGradAvailable() const {
+  if (!sharedGrad_->calcGrad) {
+    return false;
+  }
+  return sharedGrad_->sparseGrad != nullptr;
 }
 
 Shape Variable::shape() const {
@@ -171,6 +362,7 @@ void Variable::eval() const {
 
 void Variable::zeroGrad() {
   sharedGrad_->grad.reset();
+  sharedGrad_->sparseGrad.reset();
 }
 
 void Variable::setCalcGrad(bool calcGrad) {
@@ -179,11 +371,16 @@ void Variable::setCalcGrad(bool calcGrad) {
     sharedGrad_->gradFunc = nullptr;
     sharedGrad_->inputs.clear();
     sharedGrad_->grad.reset();
+    sharedGrad_->sparseGrad.reset();
   }
 }
 
 void Variable::addGrad(const Variable& childGrad) {
   if (sharedGrad_->calcGrad) {
+    // gradFuncs of data-independent nodes may run concurrently during a
+    // parallel backward (see setBackwardParallelism) and accumulate into a
+    // shared input
+    std::lock_guard<std::mutex> lock(gradAccumulationMutex);
     // Ensure the type of the child grad is the same as the type of this
     // Variable (and transitively, that it's the same type as an existing grad)
     if (childGrad.type() != this->type()) {
@@ -202,7 +399,20 @@ void Variable::addGrad(const Variable& childGrad) {
          << childGrad.shape() << std::endl;
       throw std::invalid_argument(ss.str());
     }
+    if (sharedGrad_->sparseGrad) {
+      // a dense gradient is joining a sparse one - fall back to dense
+      // accumulation
+      materializeSparseGrad();
+    }
     if (sharedGrad_->grad) {
+      if (gradModeEnabled &&
+          (sharedGrad_->grad->isCalcGrad() || childGrad.isCalcGrad())) {
+        // Differentiable backward (see backward's createGraph): accumulate
+        // through a Variable op so the gradient graph records the sum
+        sharedGrad_->grad =
+            std::make_unique<Variable>(*sharedGrad_->grad + childGrad);
+        return;
+      }
       // Prevent increment of array refcount to avoid a copy
       // if getting a device pointer. See
       // https://git.io/fp9oM for more
@@ -217,6 +427,48 @@ void Variable::addGrad(const Variable& childGrad) {
   }
 }
 
+void Variable::addSparseGrad(const Tensor& indices, const Variable& values) {
+  if (!sharedGrad_->calcGrad) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(gradAccumulationMutex);
+  if (values.type() != this->type()) {
+    std::stringstream ss;
+    ss << "Variable::addSparseGrad: attempted to add sparse gradient values "
+          "of type "
+       << values.type() << " to a Variable of type " << this->type();
+    throw std::invalid_argument(ss.str());
+  }
+  if (indices.ndim() != 1) {
+    throw std::invalid_argument(
+        "Variable::addSparseGrad: indices must be a 1-dim tensor");
+  }
+  Shape expectedShape = this->shape();
+  expectedShape[this->ndim() - 1] = indices.elements();
+  if (values.shape() != expectedShape) {
+    std::stringstream ss;
+    ss << "Variable::addSparseGrad: given sparse gradient values have shape "
+       << values.shape() << " but this Variable of shape " << this->shape()
+       << " with " << indices.elements() << " indices requires shape "
+       << expectedShape;
+    throw std::invalid_argument(ss.str());
+  }
+  if (!sharedGrad_->grad && !sharedGrad_->sparseGrad) {
+    sharedGrad_->sparseGrad = std::make_unique<SparseGrad>(
+        SparseGrad{indices, values.tensor()});
+    return;
+  }
+  // A gradient has already been accumulated - materialize everything dense
+  // and scatter-add the incoming values into it
+  if (sharedGrad_->sparseGrad) {
+    materializeSparseGrad();
+  }
+  Tensor& dense = sharedGrad_->grad->tensor();
+  std::vector<Index> sel(this->ndim(), fl::span);
+  sel.back() = indices;
+  dense(sel) = dense(sel) + values.tensor();
+}
+
 void Variable::registerGradHook(const GradHook& hook) {
   sharedGrad_->onGradAvailable = hook;
 }
@@ -227,8 +479,10 @@ void Variable::clearGradHook() {
 
 void Variable::applyGradHook() {
   if (sharedGrad_->onGradAvailable) {
-    assert(sharedGrad_->grad);
-    sharedGrad_->onGradAvailable(*sharedGrad_->grad);
+    assert(sharedGrad_->grad || sharedGrad_->sparseGrad);
+    // hooks (e.g. distributed gradient synchronization) consume dense
+    // gradients
+    sharedGrad_->onGradAvailable(grad());
   }
 }
 
@@ -241,13 +495,32 @@ void Variable::calcGradInputs(bool retainGraph) {
     sharedGrad_->gradFunc(sharedGrad_->inputs, *sharedGrad_->grad);
   }
   if (!retainGraph) {
+    // Release the gradFunc along with the inputs so the node acts as a leaf
+    // if it is ever traversed again, rather than calling the gradFunc with
+    // an empty input vector
     sharedGrad_->inputs.clear();
+    sharedGrad_->gradFunc = nullptr;
   }
 }
 
-void Variable::backward(const Variable& grad, bool retainGraph) {
+void Variable::backward(
+    const Variable& grad,
+    bool retainGraph,
+    bool createGraph) {
+  FL_TRACE_SCOPE("Variable::backward");
+  // A differentiable backward leaves gradients referencing forward nodes, so
+  // the forward graph must survive for higher-order backward calls
+  retainGraph = retainGraph || createGraph;
   addGrad(grad);
   auto dag = build();
+  if (backwardNumThreads > 1 && !inParallelBackward) {
+    backwardInParallel(dag, retainGraph, createGraph);
+    return;
+  }
+  // Gradient functions run without building a graph unless the caller asks
+  // for a differentiable backward; either way, any throwaway graphs that ops
+  // inside gradFuncs would otherwise record are suppressed
+  detail::GradModeGuard gradMode(createGraph);
   for (auto iter = dag.rbegin(); iter != dag.rend(); iter++) {
     iter->calcGradInputs(retainGraph);
     iter->applyGradHook();
@@ -257,9 +530,100 @@ void Variable::backward(const Variable& grad, bool retainGraph) {
   }
 }
 
-void Variable::backward(bool retainGraph) {
+void Variable::backwardInParallel(
+    DAG& dag,
+    bool retainGraph,
+    bool createGraph) {
+  // Partition the tape by data dependence: assign each node the length of
+  // the longest path from the output Variable. Every consumer of a node is
+  // strictly shallower than it, so nodes that share a depth have no
+  // producer/consumer relation and their gradFuncs can run concurrently.
+  // The dag is topologically sorted, so iterating in reverse visits every
+  // consumer before its producers and depths are final when read.
+  std::unordered_map<SharedGrad*, size_t> depths;
+  depths.reserve(dag.size());
+  size_t maxDepth = 0;
+  for (auto iter = dag.rbegin(); iter != dag.rend(); iter++) {
+    const size_t depth = depths[iter->sharedGrad_.get()];
+    maxDepth = std::max(maxDepth, depth);
+    for (const auto& input : iter->getInputs()) {
+      auto& inputDepth = depths[input.sharedGrad_.get()];
+      inputDepth = std::max(inputDepth, depth + 1);
+    }
+  }
+  std::vector<std::vector<Variable*>> levels(maxDepth + 1);
+  for (auto iter = dag.rbegin(); iter != dag.rend(); iter++) {
+    levels[depths.at(iter->sharedGrad_.get())].push_back(&(*iter));
+  }
+
+  auto& threadPool = backwardThreadPool(backwardNumThreads);
+  detail::GradModeGuard gradMode(createGraph);
+  for (auto& level : levels) {
+    if (level.size() == 1) {
+      level.front()->calcGradInputs(/* retainGraph = */ true);
+    } else {
+      std::vector<std::future<void>> futures;
+      futures.reserve(level.size());
+      for (Variable* node : level) {
+        futures.push_back(threadPool.enqueue([node, createGraph]() {
+          inParallelBackward = true;
+          // Grad mode is thread-local; mirror the dispatching thread's mode
+          detail::GradModeGuard gradMode(createGraph);
+          node->calcGradInputs(/* retainGraph = */ true);
+        }));
+      }
+      // Workers hold pointers into the caller-owned dag, so they must never
+      // outlive this call: wait on every future, then surface the first
+      // error once the level has drained
+      std::exception_ptr firstError;
+      for (auto& future : futures) {
+        try {
+          future.get();
+        } catch (...) {
+          if (!firstError) {
+            firstError = std::current_exception();
+          }
+        }
+      }
+      if (firstError) {
+        std::rethrow_exception(firstError);
+      }
+      // Join point: gradients produced in this level may be consumed from a
+      // different backend stream by a later level. Order the streams that
+      // produced gradients relative to one another; with a single compute
+      // stream per device this is a no-op.
+      std::unordered_set<const Stream*> streams;
+      for (Variable* node : level) {
+        for (const auto& input : node->getInputs()) {
+          if (input.isGradAvailable()) {
+            streams.insert(&input.grad().tensor().stream());
+          }
+        }
+      }
+      for (const Stream* stream : streams) {
+        for (const Stream* waitOn : streams) {
+          if (stream != waitOn) {
+            stream->relativeSync(*waitOn);
+          }
+        }
+      }
+    }
+    for (Variable* node : level) {
+      if (!retainGraph) {
+        node->sharedGrad_->inputs.clear();
+        node->sharedGrad_->gradFunc = nullptr;
+      }
+      node->applyGradHook();
+      if (!retainGraph) {
+        *node = Variable();
+      }
+    }
+  }
+}
+
+void Variable::backward(bool retainGraph, bool createGraph) {
   auto ones = Variable(fl::full(shape(), 1, this->type()), false);
-  backward(ones, retainGraph);
+  backward(ones, retainGraph, createGraph);
 }
 
 Variable Variable::withoutData() const {
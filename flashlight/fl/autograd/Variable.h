@@ -18,6 +18,27 @@
 
 namespace fl {
 
+/**
+ * A sparse gradient with respect to a Variable, stored as the pair
+ * (indices, values): `indices` is a 1-dim tensor of *unique* positions along
+ * the trailing dimension of the Variable, and `values` holds the gradient of
+ * the corresponding slices -- it has the Variable's shape with the trailing
+ * dimension replaced by the number of indices. Slices not listed in `indices`
+ * have zero gradient.
+ *
+ * Produced by ops which touch only a few slices of a large parameter (see
+ * `fl::embedding`); sparse-aware optimizers can consume it directly via
+ * `Variable::sparseGrad` to update only the touched slices, and any other
+ * consumer transparently receives the equivalent dense gradient from
+ * `Variable::grad`.
+ */
+struct FL_API SparseGrad {
+  /// Unique positions along the trailing dimension of the Variable
+  Tensor indices;
+  /// Gradient of the indexed slices; trailing dim is `indices.elements()`
+  Tensor values;
+};
+
 /**
  *  Variable wraps an Arrayfire array and facilitates easy backpropagation
  *
@@ -131,20 +152,35 @@ class FL_API Variable {
   Variable astype(fl::dtype type) const;
 
   /**
-   * @return a reference to the underlying gradient Variable.
+   * @return a reference to the underlying gradient Variable. If only a
+   * sparse gradient has been accumulated (see `addSparseGrad`), it is
+   * materialized into the equivalent dense gradient first.
    */
   Variable& grad() const;
 
+  /**
+   * @return a reference to the sparse gradient. Throws if no sparse gradient
+   * is available - check `isSparseGradAvailable` first.
+   */
+  const SparseGrad& sparseGrad() const;
+
   /**
    * Returns whether the gradient calculation for the Variable is enabled
    */
   bool isCalcGrad() const;
 
   /**
-   * Returns whether the gradient has been calculated for the Variable
+   * Returns whether the gradient has been calculated for the Variable,
+   * in either dense or sparse form
    */
   bool isGradAvailable() const;
 
+  /**
+   * Returns whether the gradient is held in sparse form (see
+   * `addSparseGrad`). False once the gradient has been materialized dense.
+   */
+  bool isSparseGradAvailable() const;
+
   /**
    * Returns the dimension of the array wrapped by the Variable
    */
@@ -243,6 +279,17 @@ class FL_API Variable {
    */
   void addGrad(const Variable& childGrad);
 
+  /**
+   * Add a sparse gradient touching only the slices of this Variable listed
+   * in `indices` (see `SparseGrad` for the representation). `indices` must
+   * be unique. If a gradient has already been accumulated - dense or sparse -
+   * both are materialized dense and accumulated via `addGrad`; the sparse
+   * form survives only when it is the sole gradient, which is the common case
+   * for a parameter read once per iteration. No-op if `this->isCalcGrad()`
+   * is false.
+   */
+  void addSparseGrad(const Tensor& indices, const Variable& values);
+
   /**
    * Registers a lambda function `hook` to be applied on the gradient w.r.t
    * Variable after it is computed during backward pass
@@ -258,11 +305,31 @@ class FL_API Variable {
    * Run backward pass on the Variable.  Gradient of all the inputs
    * in the computation graph leading up to the Variable on which the function
    * is computed.
+   *
+   * Gradient functions run with graph construction disabled unless
+   * `createGraph` is true, in which case gradients are themselves recorded as
+   * Variable graphs and `backward` can be called on a gradient to compute
+   * higher-order derivatives (e.g. for gradient-penalty regularizers)
+   * without re-running the forward pass; the forward graph is retained
+   * automatically in this mode, as gradients reference it. Higher-order
+   * gradients are supported for ops whose gradients are expressed via
+   * Variable ops (elementwise arithmetic, exp/log/pow/trig, reductions and
+   * tiling, and the matmul family); ops whose gradients are computed at the
+   * tensor level contribute first-order gradients only. Note that with
+   * `createGraph` the stored gradients reference the Variables they were
+   * differentiated from, which can form reference cycles that keep buffers
+   * alive; clear gradients with `zeroGrad` when done with them.
+   *
    * @param[in] grad gradient w.r.t to the Variable
    * @param[in] retainGraph If False, clears the input Variables stored
    * by the Variable
+   * @param[in] createGraph If True, builds a graph for the gradient
+   * computation itself so that higher-order gradients can be computed
    */
-  void backward(const Variable& grad, bool retainGraph = false);
+  void backward(
+      const Variable& grad,
+      bool retainGraph = false,
+      bool createGraph = false);
 
   /**
    * Run backward pass on the Variable. Gradient of all the inputs
@@ -271,8 +338,10 @@ class FL_API Variable {
    * to 1.0
    * @param[in] retainGraph If False, clears the input Variables stored
    * by the Variable
+   * @param[in] createGraph If True, builds a graph for the gradient
+   * computation itself so that higher-order gradients can be computed
    */
-  void backward(bool retainGraph = false);
+  void backward(bool retainGraph = false, bool createGraph = false);
 
   /**
    * Returns a copy of this variable after removing its underlying array.
@@ -289,6 +358,13 @@ class FL_API Variable {
    */
   std::vector<Variable>& getInputs() const;
 
+  /**
+   * Runs the backward pass over a topologically-sorted tape with gradient
+   * functions of data-independent nodes dispatched onto a thread pool.
+   * See `setBackwardParallelism`.
+   */
+  void backwardInParallel(DAG& dag, bool retainGraph, bool createGraph);
+
   /**
    * Builds the computation graph which comprises of all the input Variables for
    * which the gradient of `var` can be propagated using chain rule
@@ -307,6 +383,12 @@ class FL_API Variable {
    */
   void applyGradHook();
 
+  /**
+   * Converts a stored sparse gradient into the equivalent dense gradient.
+   * Caller must hold the gradient accumulation mutex.
+   */
+  void materializeSparseGrad() const;
+
   struct SharedData {
     /// Array wrapped by this Variable
     Tensor data;
@@ -321,6 +403,9 @@ class FL_API Variable {
     std::vector<Variable> inputs;
     /// Gradient with respect to this Variable
     std::unique_ptr<Variable> grad{nullptr};
+    /// Sparse gradient with respect to this Variable; mutually exclusive
+    /// with `grad` (materializing converts the former into the latter)
+    std::unique_ptr<SparseGrad> sparseGrad{nullptr};
     /// Function for calculating the gradient of the input Variables
     GradFunc gradFunc{nullptr};
     /// Function applied to gradient after it's computed during bwd pass
@@ -330,8 +415,17 @@ class FL_API Variable {
     FL_SAVE_LOAD(calcGrad);
   };
 
-  std::shared_ptr<SharedData> sharedData_ = std::make_shared<SharedData>();
-  std::shared_ptr<SharedGrad> sharedGrad_ = std::make_shared<SharedGrad>();
+  /**
+   * Allocate graph metadata nodes from a per-thread recycling pool (see
+   * Variable.cpp). A training step creates tens of thousands of these and
+   * releases them all when `backward` tears the graph down, making them the
+   * dominant malloc site in training.
+   */
+  static std::shared_ptr<SharedData> makeSharedData();
+  static std::shared_ptr<SharedGrad> makeSharedGrad();
+
+  std::shared_ptr<SharedData> sharedData_ = makeSharedData();
+  std::shared_ptr<SharedGrad> sharedGrad_ = makeSharedGrad();
 
   // NB: array only; we don't try to serialize the autograd graph
   // Saving the sharedData ptr helps to avoid saving variables which share the
@@ -339,4 +433,97 @@ class FL_API Variable {
   FL_SAVE_LOAD(sharedData_, sharedGrad_)
 };
 
+/**
+ * RAII guard disabling autograd graph construction on the current thread.
+ *
+ * While a `NoGradGuard` is alive, Variables produced by autograd functions
+ * record no inputs and no gradient function: input Variables are released as
+ * soon as the op returns rather than retained for the backward pass, and the
+ * gradient lambda (with its captures) is never stored. Use for forward-only
+ * inference, where this eliminates graph bookkeeping on the hot path and
+ * frees activations eagerly:
+ *
+ * \code
+ * fl::NoGradGuard noGrad;
+ * auto output = model->forward(input); // no graph is built
+ * \endcode
+ *
+ * Guards nest; the previous mode is restored on destruction. The guard is
+ * thread-local and does not affect concurrently-running training threads.
+ * Variables computed under the guard report `isCalcGrad() == false` and
+ * cannot be backpropagated through, as no graph exists.
+ */
+class FL_API NoGradGuard {
+ public:
+  NoGradGuard();
+  ~NoGradGuard();
+
+  NoGradGuard(const NoGradGuard&) = delete;
+  NoGradGuard& operator=(const NoGradGuard&) = delete;
+
+ private:
+  bool prevMode_;
+};
+
+/**
+ * Sets the number of threads used to dispatch gradient functions during
+ * `Variable::backward`.
+ *
+ * With `numThreads > 1`, the backward tape is partitioned by data dependence:
+ * each node is assigned the length of the longest path from the output
+ * Variable, so every consumer of a node is strictly shallower than it, and
+ * nodes sharing a depth have no producer/consumer relation between them.
+ * Gradient functions within a depth level are dispatched onto a thread pool
+ * and joined before the next level runs; at each join, backend streams that
+ * produced gradients in the level are ordered relative to one another with
+ * `Stream::relativeSync` so later levels may consume them from any stream.
+ * Independent branches of the graph (e.g. parallel encoder towers or
+ * per-head attention paths) thus overlap their backward kernel launches
+ * instead of being launched serially.
+ *
+ * Gradient accumulation into inputs shared between concurrent gradient
+ * functions is serialized internally, so the result matches the serial
+ * schedule up to floating-point reduction order.
+ *
+ * @param[in] numThreads number of dispatch threads; 0 or 1 selects the
+ * default serial backward
+ */
+FL_API void setBackwardParallelism(unsigned numThreads);
+
+/**
+ * Returns the number of threads used to dispatch gradient functions during
+ * `Variable::backward`; see `setBackwardParallelism`.
+ */
+FL_API unsigned backwardParallelism();
+
+namespace detail {
+
+/// Returns whether autograd graph construction is enabled on this thread.
+FL_API bool gradMode();
+
+/// Sets whether autograd graph construction is enabled on this thread;
+/// prefer `NoGradGuard` for scoped use.
+FL_API void setGradMode(bool enable);
+
+/**
+ * RAII guard setting autograd graph construction on the current thread to
+ * the given mode and restoring the previous mode on destruction. Used where
+ * graph construction must be forced back on inside a backward pass --
+ * gradient functions run with it disabled by default -- e.g. when
+ * recomputing a checkpointed segment.
+ */
+class FL_API GradModeGuard {
+ public:
+  explicit GradModeGuard(bool enable);
+  ~GradModeGuard();
+
+  GradModeGuard(const GradModeGuard&) = delete;
+  GradModeGuard& operator=(const GradModeGuard&) = delete;
+
+ private:
+  bool prevMode_;
+};
+
+} // namespace detail
+
 } // namespace fl
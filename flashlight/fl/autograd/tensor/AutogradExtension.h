@@ -7,6 +7,8 @@
 
 #pragma once
 
+#include <stdexcept>
+
 #include "flashlight/fl/autograd/tensor/AutogradOps.h"
 #include "flashlight/fl/common/Defines.h"
 #include "flashlight/fl/tensor/TensorExtension.h"
@@ -105,6 +107,31 @@ class AutogradExtension : public TensorExtension<AutogradExtension> {
       const float dropout,
       std::shared_ptr<detail::AutogradPayload> payload) = 0;
 
+  /**
+   * Variable-sequence-length RNN. `input` is padded [inputSize, batchSize,
+   * maxSeqLength] with sequences ordered by decreasing length; `seqLengths`
+   * holds one length per batch element in the same order. Backends with
+   * packed-sequence kernels skip computation on padding; output positions
+   * past a sequence's length are zero. Backends without support reject the
+   * call.
+   */
+  virtual std::tuple<Tensor, Tensor, Tensor> rnn(
+      const Tensor& /* input */,
+      const Tensor& /* hiddenState */,
+      const Tensor& /* cellState */,
+      const Tensor& /* weights */,
+      const std::vector<int>& /* seqLengths */,
+      const int /* hiddenSize */,
+      const int /* numLayers */,
+      const RnnMode /* mode */,
+      const bool /* bidirectional */,
+      const float /* dropout */,
+      std::shared_ptr<detail::AutogradPayload> /* payload */) {
+    throw std::runtime_error(
+        "AutogradExtension::rnn - "
+        "variable sequence lengths not supported by this backend");
+  }
+
   /**************************** Backward ****************************/
   // ]----- conv2d
   virtual Tensor conv2dBackwardData(
@@ -177,6 +204,29 @@ class AutogradExtension : public TensorExtension<AutogradExtension> {
       const bool bidirectional,
       const float dropProb,
       std::shared_ptr<detail::AutogradPayload> payload) = 0;
+
+  /**
+   * Backward pass for the variable-sequence-length `rnn` overload. Inputs
+   * and gradients use the same sorted padded layout as the forward pass.
+   */
+  virtual std::tuple<Tensor, Tensor, Tensor, Tensor> rnnBackward(
+      const Tensor& /* input */,
+      const Tensor& /* hiddenState */,
+      const Tensor& /* cellState */,
+      const Tensor& /* weights */,
+      const std::vector<int>& /* seqLengths */,
+      const std::shared_ptr<detail::RNNGradData> /* gradData */,
+      const Tensor& /* output */,
+      const int /* numLayers */,
+      const int /* hiddenSize */,
+      const RnnMode /* mode */,
+      const bool /* bidirectional */,
+      const float /* dropProb */,
+      std::shared_ptr<detail::AutogradPayload> /* payload */) {
+    throw std::runtime_error(
+        "AutogradExtension::rnnBackward - "
+        "variable sequence lengths not supported by this backend");
+  }
 };
 
 } // namespace fl
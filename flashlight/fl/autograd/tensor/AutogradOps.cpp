@@ -141,6 +141,31 @@ std::tuple<Tensor, Tensor, Tensor> rnn(
       /* payload = */ nullptr);
 }
 
+std::tuple<Tensor, Tensor, Tensor> rnn(
+    const Tensor& input,
+    const Tensor& hiddenState,
+    const Tensor& cellState,
+    const Tensor& weights,
+    const std::vector<int>& seqLengths,
+    const int hiddenSize,
+    const int numLayers,
+    const RnnMode mode,
+    const bool bidirectional,
+    const float dropout) {
+  return detail::rnn(
+      input,
+      hiddenState,
+      cellState,
+      weights,
+      seqLengths,
+      hiddenSize,
+      numLayers,
+      mode,
+      bidirectional,
+      dropout,
+      /* payload = */ nullptr);
+}
+
 namespace detail {
 
 Tensor conv2d(
@@ -225,6 +250,32 @@ std::tuple<Tensor, Tensor, Tensor> rnn(
       payload);
 }
 
+std::tuple<Tensor, Tensor, Tensor> rnn(
+    const Tensor& input,
+    const Tensor& hiddenState,
+    const Tensor& cellState,
+    const Tensor& weights,
+    const std::vector<int>& seqLengths,
+    const int hiddenSize,
+    const int numLayers,
+    const RnnMode mode,
+    const bool bidirectional,
+    const float dropout,
+    std::shared_ptr<detail::AutogradPayload> payload) {
+  return input.backend().getExtension<AutogradExtension>().rnn(
+      input,
+      hiddenState,
+      cellState,
+      weights,
+      seqLengths,
+      hiddenSize,
+      numLayers,
+      mode,
+      bidirectional,
+      dropout,
+      payload);
+}
+
 Tensor conv2dBackwardData(
     const Tensor& gradOutput,
     const Tensor& input,
@@ -360,6 +411,36 @@ std::tuple<Tensor, Tensor, Tensor, Tensor> rnnBackward(
       payload);
 }
 
+std::tuple<Tensor, Tensor, Tensor, Tensor> rnnBackward(
+    const Tensor& input,
+    const Tensor& hiddenState,
+    const Tensor& cellState,
+    const Tensor& weights,
+    const std::vector<int>& seqLengths,
+    const std::shared_ptr<detail::RNNGradData> gradData,
+    const Tensor& output,
+    const int numLayers,
+    const int hiddenSize,
+    const RnnMode mode,
+    const bool bidirectional,
+    const float dropProb,
+    std::shared_ptr<detail::AutogradPayload> payload) {
+  return input.backend().getExtension<AutogradExtension>().rnnBackward(
+      input,
+      hiddenState,
+      cellState,
+      weights,
+      seqLengths,
+      gradData,
+      output,
+      numLayers,
+      hiddenSize,
+      mode,
+      bidirectional,
+      dropProb,
+      payload);
+}
+
 } // namespace detail
 
 } // namespace fl
@@ -9,6 +9,7 @@
 
 #include <memory>
 #include <tuple>
+#include <vector>
 
 #include "flashlight/fl/common/Defines.h"
 #include "flashlight/fl/tensor/TensorBase.h"
@@ -240,6 +241,26 @@ FL_API std::tuple<Tensor, Tensor, Tensor> rnn(
     const bool bidirectional,
     const float dropout);
 
+/**
+ * Applies an RNN unit to a batch of variable-length sequences. `input` is
+ * padded [input size, batch size, max sequence length] with sequences ordered
+ * by decreasing length and `seqLengths` holds one length per batch element in
+ * the same order. Backends with packed-sequence kernels skip computation on
+ * padding; output positions past a sequence's length are zero and the
+ * returned hidden/cell states are taken at each sequence's own final step.
+ */
+FL_API std::tuple<Tensor, Tensor, Tensor> rnn(
+    const Tensor& input,
+    const Tensor& hiddenState,
+    const Tensor& cellState,
+    const Tensor& weights,
+    const std::vector<int>& seqLengths,
+    const int hiddenSize,
+    const int numLayers,
+    const RnnMode mode,
+    const bool bidirectional,
+    const float dropout);
+
 namespace detail {
 
 FL_API Tensor conv2d(
@@ -292,6 +313,19 @@ FL_API std::tuple<Tensor, Tensor, Tensor> rnn(
     const float dropout,
     std::shared_ptr<detail::AutogradPayload> payload);
 
+FL_API std::tuple<Tensor, Tensor, Tensor> rnn(
+    const Tensor& input,
+    const Tensor& hiddenState,
+    const Tensor& cellState,
+    const Tensor& weights,
+    const std::vector<int>& seqLengths,
+    const int hiddenSize,
+    const int numLayers,
+    const RnnMode mode,
+    const bool bidirectional,
+    const float dropout,
+    std::shared_ptr<detail::AutogradPayload> payload);
+
 // Returns the gradient with respect to the input
 FL_API Tensor conv2dBackwardData(
     const Tensor& gradOutput,
@@ -376,6 +410,21 @@ FL_API std::tuple<Tensor, Tensor, Tensor, Tensor> rnnBackward(
     const float dropProb,
     std::shared_ptr<detail::AutogradPayload> payload);
 
+FL_API std::tuple<Tensor, Tensor, Tensor, Tensor> rnnBackward(
+    const Tensor& input,
+    const Tensor& hiddenState,
+    const Tensor& cellState,
+    const Tensor& weights,
+    const std::vector<int>& seqLengths,
+    const std::shared_ptr<detail::RNNGradData> gradData,
+    const Tensor& output,
+    const int numLayers,
+    const int hiddenSize,
+    const RnnMode mode,
+    const bool bidirectional,
+    const float dropProb,
+    std::shared_ptr<detail::AutogradPayload> payload);
+
 } // namespace detail
 
 } // namespace fl
@@ -8,6 +8,7 @@
 #include "flashlight/fl/autograd/tensor/backend/cudnn/CudnnAutogradExtension.h"
 
 #include <array>
+#include <sstream>
 #include <stdexcept>
 #include <unordered_map>
 #include <unordered_set>
@@ -15,6 +16,7 @@
 #include <cudnn.h>
 
 #include "flashlight/fl/autograd/tensor/backend/cudnn/CudnnUtils.h"
+#include "flashlight/fl/common/Defines.h"
 #include "flashlight/fl/common/DevicePtr.h"
 #include "flashlight/fl/common/DynamicBenchmark.h"
 #include "flashlight/fl/tensor/Compute.h"
@@ -52,17 +54,130 @@ constexpr cudnnConvolutionBwdDataAlgo_t kBwdDataDefaultAlgo =
 constexpr cudnnConvolutionBwdFilterAlgo_t kBwdFilterDefaultAlgo =
     CUDNN_CONVOLUTION_BWD_FILTER_ALGO_0;
 
+/*
+ * Algorithm selection for a given convolution configuration is deterministic,
+ * but the cudnnGetConvolution*Algorithm_v7 heuristic queries it goes through
+ * are not free and showed up as per-layer overhead on deep models where many
+ * layers share a configuration. Cache the chosen algorithm (and its workspace
+ * size) per process, keyed by the contents of the cudnn descriptors so every
+ * dimension cudnn sees - shapes, strides, dtype, conv geometry, group count,
+ * math type - participates in the key. Workspace tensors themselves already
+ * come from the backend's caching memory manager, so reusing the cached size
+ * makes their allocation a cache hit as well.
+ */
+void appendTensorDescriptor(
+    std::ostream& os,
+    const cudnnTensorDescriptor_t& desc) {
+  int nbDims = 0;
+  cudnnDataType_t dataType;
+  std::array<int, CUDNN_DIM_MAX> dims;
+  std::array<int, CUDNN_DIM_MAX> strides;
+  CUDNN_CHECK_ERR(cudnnGetTensorNdDescriptor(
+      desc, CUDNN_DIM_MAX, &dataType, &nbDims, dims.data(), strides.data()));
+  os << 't' << static_cast<int>(dataType);
+  for (int i = 0; i < nbDims; ++i) {
+    os << ',' << dims[i] << ',' << strides[i];
+  }
+  os << ';';
+}
+
+void appendFilterDescriptor(
+    std::ostream& os,
+    const cudnnFilterDescriptor_t& desc) {
+  int nbDims = 0;
+  cudnnDataType_t dataType;
+  cudnnTensorFormat_t format;
+  std::array<int, CUDNN_DIM_MAX> dims;
+  CUDNN_CHECK_ERR(cudnnGetFilterNdDescriptor(
+      desc, CUDNN_DIM_MAX, &dataType, &format, &nbDims, dims.data()));
+  os << 'f' << static_cast<int>(dataType) << ','
+     << static_cast<int>(format);
+  for (int i = 0; i < nbDims; ++i) {
+    os << ',' << dims[i];
+  }
+  os << ';';
+}
+
+void appendConvDescriptor(
+    std::ostream& os,
+    const cudnnConvolutionDescriptor_t& desc) {
+  // ConvDescriptor only ever builds 2d convolutions
+  constexpr int kNumSpatialDims = 2;
+  int arrayLength = 0;
+  std::array<int, kNumSpatialDims> pads;
+  std::array<int, kNumSpatialDims> strides;
+  std::array<int, kNumSpatialDims> dilations;
+  cudnnConvolutionMode_t mode;
+  cudnnDataType_t computeType;
+  CUDNN_CHECK_ERR(cudnnGetConvolutionNdDescriptor(
+      desc,
+      kNumSpatialDims,
+      &arrayLength,
+      pads.data(),
+      strides.data(),
+      dilations.data(),
+      &mode,
+      &computeType));
+  int groups = 0;
+  CUDNN_CHECK_ERR(cudnnGetConvolutionGroupCount(desc, &groups));
+  cudnnMathType_t mathType;
+  CUDNN_CHECK_ERR(cudnnGetConvolutionMathType(desc, &mathType));
+  os << 'c' << static_cast<int>(mode) << ','
+     << static_cast<int>(computeType) << ',' << groups << ','
+     << static_cast<int>(mathType);
+  for (int i = 0; i < arrayLength; ++i) {
+    os << ',' << pads[i] << ',' << strides[i] << ',' << dilations[i];
+  }
+  os << ';';
+}
+
+// `tag` distinguishes forward, backward-data, and backward-filter problems
+// that would otherwise share descriptors
+std::string convAlgoCacheKey(
+    const char tag,
+    const cudnnTensorDescriptor_t& xDesc,
+    const cudnnFilterDescriptor_t& wDesc,
+    const cudnnConvolutionDescriptor_t& convDesc,
+    const cudnnTensorDescriptor_t& yDesc) {
+  std::stringstream ss;
+  ss << tag << ';';
+  appendTensorDescriptor(ss, xDesc);
+  appendFilterDescriptor(ss, wDesc);
+  appendConvDescriptor(ss, convDesc);
+  appendTensorDescriptor(ss, yDesc);
+  // deterministic mode constrains the candidate set, so cache its picks
+  // separately -- the mode can be toggled within a process
+  if (DeterministicMode::get().enabled()) {
+    ss << "det;";
+  }
+  return ss.str();
+}
+
+template <typename T>
+std::unordered_map<std::string, T>& convAlgoCache() {
+  static std::unordered_map<std::string, T> cache;
+  return cache;
+}
+
 // Get the algorithm which gives best performance.
 // Since cuDNN doesn't support memory limits, we manually choose an algorithm
-// which requires less than a specific workspace size.
+// which requires less than a specific workspace size. Under deterministic
+// mode, only algorithms cudnn reports as bitwise-deterministic are
+// considered; since the perf results are heuristically ranked this still
+// picks the fastest such algorithm rather than falling back to a fixed
+// conservative choice.
 template <typename T, typename ALGO_TYPE>
 T getBestAlgorithm(
     const std::vector<T>& algoPerfs,
     const std::unordered_set<ALGO_TYPE>& preferredAlgos,
     const fl::dtype arithmeticPrecision) {
+  const bool deterministic = fl::DeterministicMode::get().enabled();
   T reserved;
   bool algoFound = false;
   for (const auto& algoPerf : algoPerfs) {
+    if (deterministic && algoPerf.determinism != CUDNN_DETERMINISTIC) {
+      continue;
+    }
     if (algoPerf.status == CUDNN_STATUS_SUCCESS &&
         algoPerf.memory < kWorkspaceSizeLimitBytes) {
       if (!(arithmeticPrecision == fl::dtype::f16) ||
@@ -87,6 +202,13 @@ cudnnConvolutionFwdAlgoPerf_t getFwdAlgo(
     const cudnnConvolutionDescriptor_t& convDesc,
     const cudnnTensorDescriptor_t& yDesc,
     const fl::dtype arithmeticPrecision) {
+  auto& cache = convAlgoCache<cudnnConvolutionFwdAlgoPerf_t>();
+  auto key = convAlgoCacheKey('F', xDesc, wDesc, convDesc, yDesc);
+  auto cached = cache.find(key);
+  if (cached != cache.end()) {
+    return cached->second;
+  }
+
   int numFwdAlgoRequested, numFwdAlgoReturned;
 
   CUDNN_CHECK_ERR(cudnnGetConvolutionForwardAlgorithmMaxCount(
@@ -103,8 +225,10 @@ cudnnConvolutionFwdAlgoPerf_t getFwdAlgo(
       &numFwdAlgoReturned,
       fwdAlgoPerfs.data()));
 
-  return getBestAlgorithm(
-      fwdAlgoPerfs, kFwdPreferredAlgos, arithmeticPrecision);
+  auto bestAlgo =
+      getBestAlgorithm(fwdAlgoPerfs, kFwdPreferredAlgos, arithmeticPrecision);
+  cache.emplace(std::move(key), bestAlgo);
+  return bestAlgo;
 }
 
 cudnnConvolutionBwdDataAlgoPerf_t getBwdDataAlgo(
@@ -114,6 +238,13 @@ cudnnConvolutionBwdDataAlgoPerf_t getBwdDataAlgo(
     const cudnnTensorDescriptor_t& yDesc,
     bool /* isStrided */,
     const fl::dtype arithmeticPrecision) {
+  auto& cache = convAlgoCache<cudnnConvolutionBwdDataAlgoPerf_t>();
+  auto key = convAlgoCacheKey('D', xDesc, wDesc, convDesc, yDesc);
+  auto cached = cache.find(key);
+  if (cached != cache.end()) {
+    return cached->second;
+  }
+
   int numBwdDataAlgoRequested, numBwdDataAlgoReturned;
 
   CUDNN_CHECK_ERR(cudnnGetConvolutionBackwardDataAlgorithmMaxCount(
@@ -139,9 +270,12 @@ cudnnConvolutionBwdDataAlgoPerf_t getBwdDataAlgo(
   // Seems to produce erroneous results on Tesla P100 GPUs.
   // 2: blacklist FFT algorithms for strided dgrad -
   // https://github.com/pytorch/pytorch/issues/16610
+  // the ALGO_0 substitute accumulates with atomics, so keep the picked
+  // algorithm when determinism is required
   bool isAlgoBlacklisted = false;
 #ifndef FL_CUDNN_ALLOW_ALGO_1
   if (arithmeticPrecision != fl::dtype::f16 &&
+      !fl::DeterministicMode::get().enabled() &&
       bestAlgo.algo == CUDNN_CONVOLUTION_BWD_DATA_ALGO_1) {
     isAlgoBlacklisted = true;
   }
@@ -156,10 +290,12 @@ cudnnConvolutionBwdDataAlgoPerf_t getBwdDataAlgo(
   if (isAlgoBlacklisted) {
     for (const auto& algoPerf : bwdDataAlgoPerfs) {
       if (algoPerf.algo == kBwdDataDefaultAlgo) {
-        return algoPerf;
+        bestAlgo = algoPerf;
+        break;
       }
     }
   }
+  cache.emplace(std::move(key), bestAlgo);
   return bestAlgo;
 }
 
@@ -169,6 +305,13 @@ cudnnConvolutionBwdFilterAlgoPerf_t getBwdFilterAlgo(
     const cudnnConvolutionDescriptor_t& convDesc,
     const cudnnTensorDescriptor_t& yDesc,
     const fl::dtype arithmeticPrecision) {
+  auto& cache = convAlgoCache<cudnnConvolutionBwdFilterAlgoPerf_t>();
+  auto key = convAlgoCacheKey('W', xDesc, wDesc, convDesc, yDesc);
+  auto cached = cache.find(key);
+  if (cached != cache.end()) {
+    return cached->second;
+  }
+
   int numBwdFilterAlgoRequested, numBwdFilterAlgoReturned;
 
   CUDNN_CHECK_ERR(cudnnGetConvolutionBackwardFilterAlgorithmMaxCount(
@@ -191,9 +334,12 @@ cudnnConvolutionBwdFilterAlgoPerf_t getBwdFilterAlgo(
   // We use a few hacks here to resolve some cuDNN bugs
   // 1: blacklist BWD_FILTER_ALGO_1
   // We do the blacklist here just to be safe as we did in BWD_DATA_ALGO_1
+  // as above, ALGO_0 is not deterministic, so the blacklist does not apply
+  // in deterministic mode
   bool isAlgoBlacklisted = false;
 #ifndef FL_CUDNN_ALLOW_ALGO_1
   if (arithmeticPrecision != fl::dtype::f16 &&
+      !fl::DeterministicMode::get().enabled() &&
       bestAlgo.algo == CUDNN_CONVOLUTION_BWD_FILTER_ALGO_1) {
     isAlgoBlacklisted = true;
   }
@@ -201,10 +347,12 @@ cudnnConvolutionBwdFilterAlgoPerf_t getBwdFilterAlgo(
   if (isAlgoBlacklisted) {
     for (const auto& algoPerf : bwdFilterAlgoPerfs) {
       if (algoPerf.algo == kBwdFilterDefaultAlgo) {
-        return algoPerf;
+        bestAlgo = algoPerf;
+        break;
       }
     }
   }
+  cache.emplace(std::move(key), bestAlgo);
   return bestAlgo;
 }
 
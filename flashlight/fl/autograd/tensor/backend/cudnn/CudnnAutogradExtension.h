@@ -76,6 +76,19 @@ class CudnnAutogradExtension : public AutogradExtension {
       const float dropout,
       std::shared_ptr<detail::AutogradPayload> payload) override;
 
+  std::tuple<Tensor, Tensor, Tensor> rnn(
+      const Tensor& input,
+      const Tensor& hiddenState,
+      const Tensor& cellState,
+      const Tensor& weights,
+      const std::vector<int>& seqLengths,
+      const int hiddenSize,
+      const int numLayers,
+      const RnnMode mode,
+      const bool bidirectional,
+      const float dropout,
+      std::shared_ptr<detail::AutogradPayload> payload) override;
+
   /**************************** Backward ****************************/
   // ]----- Convolution
   Tensor conv2dBackwardData(
@@ -148,6 +161,21 @@ class CudnnAutogradExtension : public AutogradExtension {
       const bool bidirectional,
       const float dropProb,
       std::shared_ptr<detail::AutogradPayload> payload) override;
+
+  std::tuple<Tensor, Tensor, Tensor, Tensor> rnnBackward(
+      const Tensor& input,
+      const Tensor& hiddenState,
+      const Tensor& cellState,
+      const Tensor& weights,
+      const std::vector<int>& seqLengths,
+      const std::shared_ptr<detail::RNNGradData> gradData,
+      const Tensor& output,
+      const int numLayers,
+      const int hiddenSize,
+      const RnnMode mode,
+      const bool bidirectional,
+      const float dropProb,
+      std::shared_ptr<detail::AutogradPayload> payload) override;
 };
 
 } // namespace fl
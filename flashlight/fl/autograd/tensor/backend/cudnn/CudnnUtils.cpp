@@ -50,7 +50,11 @@ const double kDoubleZero = 0.0;
 const double kDoubleOne = 1.0;
 
 // TODO: move this to CudnnAutogradExtension if we make it a singleton
-std::unordered_map<int, DeviceHandle> handles;
+// Thread-local so each thread runs cuDNN on its own handle and stream:
+// cudnnHandle_t isn't safe to share across threads, and per-thread handles
+// let concurrent inference threads execute without serializing on one
+// global handle.
+thread_local std::unordered_map<int, DeviceHandle> handles;
 
 const DeviceHandle& getActiveDeviceHandle() {
   auto& manager = fl::DeviceManager::getInstance();
@@ -205,6 +209,20 @@ TensorDescriptorArray::TensorDescriptorArray(
   descriptors = desc_raw_vec.data();
 }
 
+TensorDescriptorArray::TensorDescriptorArray(
+    const fl::dtype type,
+    const Shape& dims,
+    const std::vector<int>& batchSizes) {
+  desc_vec.reserve(batchSizes.size());
+  for (int batchSize : batchSizes) {
+    Shape stepDims = dims;
+    stepDims[stepDims.ndim() - 1] = batchSize;
+    desc_vec.emplace_back(type, stepDims);
+    desc_raw_vec.push_back(desc_vec.back().descriptor);
+  }
+  descriptors = desc_raw_vec.data();
+}
+
 TensorDescriptorArray::~TensorDescriptorArray() = default;
 
 PoolingDescriptor::PoolingDescriptor(
@@ -29,6 +29,13 @@ class TensorDescriptorArray {
  public:
   TensorDescriptorArray(int size, const fl::dtype type, const Shape& dims);
 
+  // Per-entry descriptors whose trailing (batch) dim varies - one entry per
+  // timestep of a packed variable-length sequence batch
+  TensorDescriptorArray(
+      const fl::dtype type,
+      const Shape& dims,
+      const std::vector<int>& batchSizes);
+
   cudnnTensorDescriptor_t* descriptors;
   ~TensorDescriptorArray();
 
@@ -12,6 +12,7 @@
 #include "flashlight/fl/autograd/tensor/backend/cudnn/CudnnUtils.h"
 #include "flashlight/fl/common/DevicePtr.h"
 #include "flashlight/fl/tensor/Compute.h"
+#include "flashlight/fl/tensor/Index.h"
 
 namespace fl {
 namespace {
@@ -55,6 +56,82 @@ struct CudnnRnnAutogradPayload : public detail::AutogradPayloadData {
   Tensor reserveSpace;
 };
 
+// Validates per-sequence lengths against the padded input and returns the
+// per-timestep batch sizes of the packed layout:
+// batchSizes[t] = number of sequences longer than t
+std::vector<int> packedBatchSizes(
+    const std::vector<int>& seqLengths,
+    const int batchSize,
+    const int seqLength) {
+  if (static_cast<int>(seqLengths.size()) != batchSize) {
+    throw std::invalid_argument(
+        "cudnn RNN: seqLengths must have one entry per batch element");
+  }
+  if (seqLengths.front() != seqLength) {
+    throw std::invalid_argument(
+        "cudnn RNN: longest sequence must span the input's full time dim");
+  }
+  for (size_t i = 0; i < seqLengths.size(); ++i) {
+    if (seqLengths[i] < 1 || (i > 0 && seqLengths[i] > seqLengths[i - 1])) {
+      throw std::invalid_argument(
+          "cudnn RNN: seqLengths must be positive and sorted in decreasing "
+          "order");
+    }
+  }
+  std::vector<int> batchSizes(seqLength);
+  int b = batchSize;
+  for (int t = 0; t < seqLength; ++t) {
+    while (b > 0 && seqLengths[b - 1] <= t) {
+      --b;
+    }
+    batchSizes[t] = b;
+  }
+  return batchSizes;
+}
+
+// [feat, batchSize, seqLength] padded --> [feat, sum(batchSizes)] packed,
+// with timestep t's batchSizes[t] columns stored contiguously
+Tensor packSequences(const Tensor& padded, const std::vector<int>& batchSizes) {
+  std::vector<Tensor> steps;
+  steps.reserve(batchSizes.size());
+  for (size_t t = 0; t < batchSizes.size(); ++t) {
+    steps.push_back(padded(
+        fl::span,
+        fl::range(0, batchSizes[t]),
+        fl::range(static_cast<int>(t), static_cast<int>(t) + 1)));
+  }
+  Dim totalSteps = 0;
+  for (int batchSize : batchSizes) {
+    totalSteps += batchSize;
+  }
+  return fl::reshape(fl::concatenate(steps, 1), {padded.dim(0), totalSteps});
+}
+
+// [feat, sum(batchSizes)] packed --> [feat, batchSize, seqLength] padded;
+// positions past each sequence's length are zero
+Tensor unpackSequences(
+    const Tensor& packed,
+    const std::vector<int>& batchSizes,
+    const int batchSize) {
+  Dim feat = packed.dim(0);
+  auto padded = fl::full(
+      {feat, batchSize, static_cast<Dim>(batchSizes.size())},
+      0.,
+      packed.type());
+  Dim offset = 0;
+  for (size_t t = 0; t < batchSizes.size(); ++t) {
+    padded(
+        fl::span,
+        fl::range(0, batchSizes[t]),
+        fl::range(static_cast<int>(t), static_cast<int>(t) + 1)) =
+        fl::reshape(
+            packed(fl::span, fl::range(offset, offset + batchSizes[t])),
+            {feat, batchSizes[t], 1});
+    offset += batchSizes[t];
+  }
+  return padded;
+}
+
 } // namespace
 
 std::tuple<Tensor, Tensor, Tensor> CudnnAutogradExtension::rnn(
@@ -204,6 +281,161 @@ std::tuple<Tensor, Tensor, Tensor> CudnnAutogradExtension::rnn(
   return std::make_tuple(y, hy, cy);
 }
 
+std::tuple<Tensor, Tensor, Tensor> CudnnAutogradExtension::rnn(
+    const Tensor& input,
+    const Tensor& hiddenStateIn,
+    const Tensor& cellStateIn,
+    const Tensor& weights,
+    const std::vector<int>& seqLengths,
+    const int hiddenSize,
+    const int numLayers,
+    const RnnMode mode,
+    const bool bidirectional,
+    const float dropProb,
+    std::shared_ptr<detail::AutogradPayload> autogradPayload) {
+  FL_TENSOR_DTYPES_MATCH_CHECK(input, hiddenStateIn, cellStateIn, weights);
+
+  if (input.ndim() != 3) {
+    throw std::invalid_argument(
+        "cudnn RNN: packed-sequence input must be "
+        "[inputSize, batchSize, seqLength]");
+  }
+
+  bool train = (autogradPayload != nullptr);
+  auto payload = std::make_shared<CudnnRnnAutogradPayload>();
+  if (train) {
+    autogradPayload->data = payload;
+  }
+
+  Tensor hiddenState = hiddenStateIn.asContiguousTensor();
+  Tensor cellState = cellStateIn.asContiguousTensor();
+
+  int inputSize = input.dim(0);
+  int batchSize = input.dim(1);
+  int seqLength = input.dim(2);
+  auto batchSizes = packedBatchSizes(seqLengths, batchSize, seqLength);
+  // cuDNN's variable-length API expects step-major packed data - skip the
+  // padding entirely rather than computing over it
+  Tensor x = packSequences(input, batchSizes);
+
+  DropoutDescriptor dropout(dropProb);
+  RNNDescriptor rnnDesc(
+      input.type(), hiddenSize, numLayers, mode, bidirectional, dropout);
+  setCudnnRnnMathType(input, rnnDesc);
+
+  int totalLayers = numLayers * (bidirectional ? 2 : 1);
+  int outSize = hiddenSize * (bidirectional ? 2 : 1);
+
+  TensorDescriptorArray xDescs(x.type(), {1, 1, inputSize, 0}, batchSizes);
+
+  if (!hiddenState.isEmpty()) {
+    auto hxDims = hiddenState.shape();
+    int hxHiddenSize = hxDims[0];
+    int hxBatchSize = hiddenState.ndim() < 2 ? 1 : hxDims[1];
+    int hxTotalLayers = hiddenState.ndim() < 3 ? 1 : hxDims[2];
+
+    if (!(hxHiddenSize == hiddenSize && hxBatchSize == batchSize &&
+          hxTotalLayers == totalLayers)) {
+      throw std::invalid_argument("invalid hidden state dims for RNN");
+    }
+  }
+
+  if (!cellState.isEmpty() &&
+      !(mode == RnnMode::LSTM && cellState.dim(0) == hiddenSize &&
+        cellState.dim(1) == batchSize && cellState.dim(2) == totalLayers)) {
+    throw std::invalid_argument("invalid cell state dims for RNN");
+  }
+
+  Shape hDims = {1, hiddenSize, batchSize, totalLayers};
+  TensorDescriptor hxDesc(x.type(), hDims);
+  TensorDescriptor cxDesc(x.type(), hDims);
+
+  auto handle = getCudnnHandle();
+  const auto& cudnnStream = getCudnnStream();
+
+  size_t paramSize;
+  CUDNN_CHECK_ERR(cudnnGetRNNParamsSize(
+      handle,
+      rnnDesc.descriptor,
+      xDescs.descriptors[0],
+      &paramSize,
+      cudnnMapToType(weights.type())));
+  if (paramSize != weights.bytes()) {
+    throw std::invalid_argument(
+        "invalid # of parameters or wrong input shape for RNN");
+  }
+  FilterDescriptor wDesc(weights);
+
+  Tensor y({outSize, x.dim(1)}, input.type());
+  TensorDescriptorArray yDescs(y.type(), {1, 1, outSize, 0}, batchSizes);
+
+  Tensor hy({hiddenSize, batchSize, totalLayers}, x.type());
+  TensorDescriptor hyDesc(x.type(), hDims);
+
+  Tensor cy;
+  if (mode == RnnMode::LSTM) {
+    cy = Tensor(hy.shape(), x.type());
+  }
+
+  TensorDescriptor cyDesc(x.type(), hDims);
+
+  size_t workspaceSize =
+    getWorkspaceSize(handle, rnnDesc, seqLength, xDescs);
+  size_t reserveSize =
+    getReserveSize(handle, rnnDesc, seqLength, xDescs);
+
+  Tensor workspace({static_cast<long long>(workspaceSize)}, fl::dtype::b8);
+  // Space must be reused between forward and backward for cuDNN
+  payload->reserveSpace =
+      Tensor({static_cast<long long>(reserveSize)}, fl::dtype::b8);
+
+  {
+    auto contiguousWeights = weights.asContiguousTensor();
+    DevicePtr xRaw(x);
+    DevicePtr hxRaw(hiddenState);
+    DevicePtr cxRaw(cellState);
+    DevicePtr wRaw(contiguousWeights);
+    DevicePtr yRaw(y);
+    DevicePtr hyRaw(hy);
+    DevicePtr cyRaw(cy);
+    DevicePtr workspaceRaw(workspace);
+    DevicePtr reserveSpaceRaw(payload->reserveSpace);
+    // ensure cudnn compute stream waits on input/output tensor streams
+    relativeSync(cudnnStream, {
+      x, hiddenState, cellState, contiguousWeights, y, hy, cy,
+      workspace, payload->reserveSpace,
+    });
+
+    CUDNN_CHECK_ERR(cudnnRNNForwardTraining(
+        handle,
+        rnnDesc.descriptor,
+        seqLength,
+        xDescs.descriptors,
+        xRaw.get(),
+        hxDesc.descriptor,
+        hxRaw.get(),
+        cxDesc.descriptor,
+        cxRaw.get(),
+        wDesc.descriptor,
+        wRaw.get(),
+        yDescs.descriptors,
+        yRaw.get(),
+        hyDesc.descriptor,
+        hyRaw.get(),
+        cyDesc.descriptor,
+        cyRaw.get(),
+        workspaceRaw.get(),
+        workspaceSize,
+        reserveSpaceRaw.get(),
+        reserveSize));
+  }
+
+  // ensure output tensor streams wait on cudnn compute stream
+  relativeSync({y, hy, cy}, cudnnStream);
+  // hand back padded output; positions past each sequence's length are zero
+  return std::make_tuple(unpackSequences(y, batchSizes, batchSize), hy, cy);
+}
+
 std::tuple<Tensor, Tensor, Tensor, Tensor> CudnnAutogradExtension::rnnBackward(
     const Tensor& input,
     const Tensor& hiddenState,
@@ -372,4 +604,167 @@ std::tuple<Tensor, Tensor, Tensor, Tensor> CudnnAutogradExtension::rnnBackward(
   return std::make_tuple(dx, dhx, dcx, dw);
 }
 
+std::tuple<Tensor, Tensor, Tensor, Tensor> CudnnAutogradExtension::rnnBackward(
+    const Tensor& input,
+    const Tensor& hiddenState,
+    const Tensor& cellState,
+    const Tensor& weights,
+    const std::vector<int>& seqLengths,
+    const std::shared_ptr<detail::RNNGradData> gradData,
+    const Tensor& output,
+    const int numLayers,
+    const int hiddenSize,
+    const RnnMode mode,
+    const bool bidirectional,
+    const float dropProb,
+    std::shared_ptr<detail::AutogradPayload> autogradPayload) {
+  if (!autogradPayload) {
+    throw std::invalid_argument(
+        "CudnnAutogradExtension::rnnBackward given null detail::AutogradPayload");
+  }
+  auto payload =
+      std::static_pointer_cast<CudnnRnnAutogradPayload>(autogradPayload->data);
+
+  auto handle = getCudnnHandle();
+  const auto& cudnnStream = getCudnnStream();
+
+  int inputSize = input.dim(0);
+  int batchSize = input.ndim() < 2 ? 1 : input.dim(1);
+  int seqLength = input.ndim() < 3 ? 1 : input.dim(2);
+  int totalLayers = numLayers * (bidirectional ? 2 : 1);
+  int outSize = hiddenSize * (bidirectional ? 2 : 1);
+
+  auto batchSizes = packedBatchSizes(seqLengths, batchSize, seqLength);
+  // repack input/output/incoming gradient exactly as the forward pass saw
+  // them - padded positions are zero, so repacking is deterministic
+  auto x = packSequences(input, batchSizes);
+  auto y = packSequences(output, batchSizes);
+
+  DropoutDescriptor dropout(dropProb);
+  RNNDescriptor rnnDesc(
+      input.type(), hiddenSize, numLayers, mode, bidirectional, dropout);
+  setCudnnRnnMathType(input, rnnDesc);
+
+  TensorDescriptorArray yDescs(y.type(), {1, 1, outSize, 0}, batchSizes);
+  TensorDescriptorArray dyDescs(y.type(), {1, 1, outSize, 0}, batchSizes);
+
+  Shape hDims = {1, hiddenSize, batchSize, totalLayers};
+  TensorDescriptor dhyDesc(x.type(), hDims);
+  TensorDescriptor dcyDesc(x.type(), hDims);
+  TensorDescriptor hxDesc(x.type(), hDims);
+  TensorDescriptor cxDesc(x.type(), hDims);
+
+  Tensor dhx(hiddenState.shape(), hiddenState.type());
+  Tensor dcx(cellState.shape(), cellState.type());
+  TensorDescriptor dhxDesc(x.type(), hDims);
+  TensorDescriptor dcxDesc(x.type(), hDims);
+
+  FilterDescriptor wDesc(weights);
+
+  Tensor dx({inputSize, x.dim(1)}, input.type());
+  TensorDescriptorArray dxDescs(dx.type(), {1, 1, inputSize, 0}, batchSizes);
+
+  size_t workspaceSize =
+    getWorkspaceSize(handle, rnnDesc, seqLength, dxDescs);
+  Tensor workspace({static_cast<long long>(workspaceSize)}, fl::dtype::b8);
+
+  Tensor dy = gradData->dy.isEmpty()
+      ? fl::full(y.shape(), 0.0, y.type())
+      : packSequences(gradData->dy, batchSizes);
+  auto& dhy = gradData->dhy;
+  auto& dcy = gradData->dcy;
+
+  DevicePtr yRaw(y);
+  DevicePtr workspaceRaw(workspace);
+  DevicePtr reserveSpaceRaw(payload->reserveSpace);
+  // ensure cudnn compute stream waits on input/output tensor streams
+  relativeSync(cudnnStream, {y, workspace, payload->reserveSpace});
+
+  {
+    DevicePtr dyRaw(dy); // Has to be set to 0 if empty
+    DevicePtr dhyRaw(dhy);
+    DevicePtr dcyRaw(dcy);
+
+    DevicePtr wRaw(weights);
+
+    DevicePtr hxRaw(hiddenState);
+    DevicePtr cxRaw(cellState);
+
+    DevicePtr dxRaw(dx);
+    DevicePtr dhxRaw(dhx);
+    DevicePtr dcxRaw(dcx);
+    // ensure cudnn compute stream waits on input/output tensor streams
+    relativeSync(
+        cudnnStream,
+        {dy, dhy, dcy, weights, hiddenState, cellState, dx, dhx, dcx});
+
+    /* We need to update reserveSpace even if we just want the
+     * weight gradients. */
+    CUDNN_CHECK_ERR(cudnnRNNBackwardData(
+        handle,
+        rnnDesc.descriptor,
+        seqLength,
+        yDescs.descriptors,
+        yRaw.get(),
+        dyDescs.descriptors,
+        dyRaw.get(),
+        dhyDesc.descriptor,
+        dhyRaw.get(),
+        dcyDesc.descriptor,
+        dcyRaw.get(),
+        wDesc.descriptor,
+        wRaw.get(),
+        hxDesc.descriptor,
+        hxRaw.get(),
+        cxDesc.descriptor,
+        cxRaw.get(),
+        dxDescs.descriptors,
+        dxRaw.get(),
+        dhxDesc.descriptor,
+        dhxRaw.get(),
+        dcxDesc.descriptor,
+        dcxRaw.get(),
+        workspaceRaw.get(),
+        workspaceSize,
+        reserveSpaceRaw.get(),
+        payload->reserveSpace.bytes()));
+  }
+
+  setCudnnRnnMathType(input, rnnDesc);
+  TensorDescriptorArray xDescs(x.type(), {1, 1, inputSize, 0}, batchSizes);
+  Tensor dw = fl::full(weights.shape(), 0, weights.type());
+
+  FilterDescriptor dwDesc(dw);
+
+  {
+    DevicePtr xRaw(x);
+    DevicePtr dwRaw(dw);
+    DevicePtr hxRaw(hiddenState);
+    // ensure cudnn compute stream waits on input/output tensor streams
+    relativeSync(cudnnStream, {x, dw, hiddenState});
+
+    CUDNN_CHECK_ERR(cudnnRNNBackwardWeights(
+        handle,
+        rnnDesc.descriptor,
+        seqLength,
+        xDescs.descriptors,
+        xRaw.get(),
+        hxDesc.descriptor,
+        hxRaw.get(),
+        yDescs.descriptors,
+        yRaw.get(),
+        workspaceRaw.get(),
+        workspaceSize,
+        dwDesc.descriptor,
+        dwRaw.get(),
+        reserveSpaceRaw.get(),
+        payload->reserveSpace.bytes()));
+  }
+
+  // ensure output tensor streams wait on cudnn compute stream
+  relativeSync({dx, dhx, dcx, dw}, cudnnStream);
+  return std::make_tuple(
+      unpackSequences(dx, batchSizes, batchSize), dhx, dcx, dw);
+}
+
 } // namespace fl
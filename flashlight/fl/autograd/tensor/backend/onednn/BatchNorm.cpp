@@ -102,9 +102,6 @@ Tensor OneDnnAutogradExtension::batchnorm(
     const double momentum,
     const double epsilon,
     std::shared_ptr<detail::AutogradPayload> autogradPayload) {
-  if (momentum != 0.) {
-    throw std::runtime_error("OneDNN batchnorm op doesn't support momentum.");
-  }
   if (input.type() == fl::dtype::f16) {
     throw std::runtime_error("OneDNN batchnorm op - f16 inputs not supported.");
   }
@@ -151,15 +148,26 @@ Tensor OneDnnAutogradExtension::batchnorm(
   payload->biasDims = detail::convertToDnnlDims({nfeatures});
   auto inputOutputDims = getInputOutputDims(minAxis, maxAxis, input, nfeatures);
 
+  // In training mode the primitive computes batch statistics; keep them
+  // separate from the running statistics, which are folded in below via a
+  // fused moving-average update. In inference mode the running statistics are
+  // inputs to the primitive.
+  if (train) {
+    saveMean = Tensor({nfeatures}, input.type());
+    saveVar = Tensor({nfeatures}, input.type());
+  }
+  const Tensor& statsMean = train ? saveMean : runningMean;
+  const Tensor& statsVar = train ? saveVar : runningVar;
+
   // Memory for forward
   const detail::DnnlMemoryWrapper inputMemory(
       input, inputOutputDims, formatNCHW);
   const detail::DnnlMemoryWrapper outputMemory(
       output, inputOutputDims, formatNCHW);
   const detail::DnnlMemoryWrapper meanMemory(
-      runningMean, {runningMean.dim(0)}, formatX);
+      statsMean, {statsMean.dim(0)}, formatX);
   const detail::DnnlMemoryWrapper varMemory(
-      runningVar, {runningVar.dim(0)}, formatX);
+      statsVar, {statsVar.dim(0)}, formatX);
   // combined scale and shift (weight and bias)
   const detail::DnnlMemoryWrapper weightsMemory(
       payload->weights, payload->weightsDims, formatX);
@@ -195,10 +203,65 @@ Tensor OneDnnAutogradExtension::batchnorm(
       {DNNL_ARG_SCALE, weightsMemory.getMemory()},
       {DNNL_ARG_SHIFT, biasMemory.getMemory()}};
 
-  // Execute
   std::vector<dnnl::primitive> network;
   std::vector<std::unordered_map<int, dnnl::memory>> fwdArgs = {bnFwdArgs};
   network.push_back(bn);
+
+  // Fuse the running-statistics update into the same network submission:
+  // running = (1 - momentum) * running + momentum * batch, entirely
+  // device-side, with no extra host-visible copies or syncs. The wrappers
+  // live in function scope so the running tensors stay locked until the
+  // network executes (in inference mode `meanMemory`/`varMemory` already
+  // wrap them).
+  detail::DnnlMemoryWrapper runMeanMemory, runVarMemory;
+  if (train && momentum != 0.) {
+    runMeanMemory = detail::DnnlMemoryWrapper(
+        runningMean, {runningMean.dim(0)}, formatX);
+    runVarMemory =
+        detail::DnnlMemoryWrapper(runningVar, {runningVar.dim(0)}, formatX);
+    const auto avgFactor = static_cast<float>(momentum);
+    auto appendMovingAverage = [&](const dnnl::memory& batchStat,
+                                   const dnnl::memory& runningStat) {
+      const auto statDesc = runningStat.get_desc();
+      auto scaledStat = dnnl::memory(statDesc, dnnlEngine);
+      // scaled = momentum * batch
+      auto scalePrimDesc = dnnl::eltwise_forward::primitive_desc(
+          dnnlEngine,
+          dnnl::prop_kind::forward_inference,
+          dnnl::algorithm::eltwise_linear,
+          batchStat.get_desc(),
+          statDesc,
+          avgFactor,
+          0.f);
+      network.push_back(dnnl::eltwise_forward(scalePrimDesc));
+      fwdArgs.push_back(
+          {{DNNL_ARG_SRC, batchStat}, {DNNL_ARG_DST, scaledStat}});
+      // running *= 1 - momentum (in-place)
+      auto decayPrimDesc = dnnl::eltwise_forward::primitive_desc(
+          dnnlEngine,
+          dnnl::prop_kind::forward_inference,
+          dnnl::algorithm::eltwise_linear,
+          statDesc,
+          statDesc,
+          1.f - avgFactor,
+          0.f);
+      network.push_back(dnnl::eltwise_forward(decayPrimDesc));
+      fwdArgs.push_back(
+          {{DNNL_ARG_SRC, runningStat}, {DNNL_ARG_DST, runningStat}});
+      // running += scaled (in-place)
+      auto addPrimDesc = dnnl::binary::primitive_desc(
+          dnnlEngine, dnnl::algorithm::binary_add, statDesc, statDesc, statDesc);
+      network.push_back(dnnl::binary(addPrimDesc));
+      fwdArgs.push_back(
+          {{DNNL_ARG_SRC_0, runningStat},
+           {DNNL_ARG_SRC_1, scaledStat},
+           {DNNL_ARG_DST, runningStat}});
+    };
+    appendMovingAverage(meanMemory.getMemory(), runMeanMemory.getMemory());
+    appendMovingAverage(varMemory.getMemory(), runVarMemory.getMemory());
+  }
+
+  // Execute
   detail::executeNetwork(network, fwdArgs);
 
   return output;
@@ -0,0 +1,279 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "flashlight/fl/common/AsyncFileReader.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <exception>
+#include <future>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+
+#ifdef _WIN32
+#include <fstream>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#ifdef FL_USE_IO_URING
+#include <liburing.h>
+#endif
+
+#include "flashlight/fl/common/threadpool/ThreadPool.h"
+
+namespace fl {
+
+namespace {
+
+// worker threads used by the portable fallback; enough to keep several
+// requests in flight without oversubscribing dataset-loading hosts
+constexpr int kFallbackThreads = 8;
+
+[[noreturn]] void throwReadError(
+    const fs::path& path,
+    const std::string& what) {
+  throw std::runtime_error(
+      "AsyncFileReader - " + what + " reading " + path.string());
+}
+
+} // namespace
+
+struct AsyncFileReader::Impl {
+  fs::path path;
+  int queueDepth;
+#ifndef _WIN32
+  int fd{-1};
+#endif
+#ifdef FL_USE_IO_URING
+  // the submission and completion queues are not thread-safe
+  mutable io_uring ring;
+  mutable std::mutex ringMutex;
+#else
+  // fallback reads are positional, so workers share the descriptor without
+  // serializing on a seek position
+  mutable std::unique_ptr<ThreadPool> pool;
+#endif
+};
+
+AsyncFileReader::AsyncFileReader(const fs::path& path, int queueDepth /* = 32 */)
+    : impl_(std::make_unique<Impl>()) {
+  if (queueDepth < 1) {
+    throw std::invalid_argument(
+        "AsyncFileReader - queueDepth must be positive");
+  }
+  impl_->path = path;
+  impl_->queueDepth = queueDepth;
+#ifndef _WIN32
+  impl_->fd = ::open(path.c_str(), O_RDONLY);
+  if (impl_->fd < 0) {
+    throw std::runtime_error(
+        "AsyncFileReader - could not open file " + path.string());
+  }
+#endif
+#ifdef FL_USE_IO_URING
+  if (io_uring_queue_init(queueDepth, &impl_->ring, 0) != 0) {
+    ::close(impl_->fd);
+    throw std::runtime_error(
+        "AsyncFileReader - could not create an io_uring queue for " +
+        path.string());
+  }
+#else
+  impl_->pool =
+      std::make_unique<ThreadPool>(std::min(queueDepth, kFallbackThreads));
+#endif
+}
+
+AsyncFileReader::~AsyncFileReader() {
+#ifdef FL_USE_IO_URING
+  io_uring_queue_exit(&impl_->ring);
+#endif
+#ifndef _WIN32
+  if (impl_->fd >= 0) {
+    ::close(impl_->fd);
+  }
+#endif
+}
+
+void AsyncFileReader::read(const std::vector<FileReadRequest>& requests) const {
+  for (const auto& req : requests) {
+    if (req.offset < 0 || req.size < 0 ||
+        (req.size > 0 && req.buffer == nullptr)) {
+      throw std::invalid_argument("AsyncFileReader - invalid read request");
+    }
+  }
+#ifdef FL_USE_IO_URING
+  // outstanding state per request; short reads resubmit the remainder
+  struct Pending {
+    char* buffer;
+    int64_t offset;
+    int64_t remaining;
+  };
+  std::vector<Pending> pending;
+  pending.reserve(requests.size());
+  for (const auto& req : requests) {
+    if (req.size > 0) {
+      pending.push_back({req.buffer, req.offset, req.size});
+    }
+  }
+
+  std::lock_guard<std::mutex> lock(impl_->ringMutex);
+  std::vector<Pending*> queue;
+  queue.reserve(pending.size());
+  for (auto& p : pending) {
+    queue.push_back(&p);
+  }
+  std::size_t next = 0;
+  std::size_t prepped = 0; // SQEs prepared but not yet consumed by a submit
+  std::size_t inKernel = 0; // SQEs submitted whose CQEs have not been reaped
+  std::size_t completed = 0;
+  // completions referencing caller buffers must never outlive this call, so
+  // reap every submitted entry before surfacing an error. Only entries the
+  // kernel actually consumed produce completions: prepped-but-unsubmitted
+  // ones never will, and waiting on them would block forever
+  auto failDraining = [&](const std::string& what) {
+    io_uring_cqe* cqe = nullptr;
+    while (inKernel > 0 && io_uring_wait_cqe(&impl_->ring, &cqe) == 0) {
+      io_uring_cqe_seen(&impl_->ring, cqe);
+      --inKernel;
+    }
+    throwReadError(impl_->path, what);
+  };
+  while (completed < pending.size()) {
+    // keep the submission queue filled up to the ring depth
+    while (next < queue.size() &&
+           prepped + inKernel < static_cast<std::size_t>(impl_->queueDepth)) {
+      io_uring_sqe* sqe = io_uring_get_sqe(&impl_->ring);
+      if (sqe == nullptr) {
+        break;
+      }
+      Pending* p = queue[next];
+      // cap each submission; the short-read path picks up any remainder
+      const unsigned len =
+          static_cast<unsigned>(std::min<int64_t>(p->remaining, 1 << 30));
+      io_uring_prep_read(sqe, impl_->fd, p->buffer, len, p->offset);
+      io_uring_sqe_set_data(sqe, p);
+      ++next;
+      ++prepped;
+    }
+    // a partial submit leaves the remaining SQEs queued for the next round
+    const int submitted = io_uring_submit(&impl_->ring);
+    if (submitted < 0) {
+      failDraining("io_uring submission failed");
+    }
+    prepped -= static_cast<std::size_t>(submitted);
+    inKernel += static_cast<std::size_t>(submitted);
+    if (inKernel == 0) {
+      // nothing in the kernel and nothing accepted: waiting would hang
+      failDraining("io_uring submission stalled");
+    }
+    io_uring_cqe* cqe = nullptr;
+    if (io_uring_wait_cqe(&impl_->ring, &cqe) != 0) {
+      failDraining("io_uring completion failed");
+    }
+    auto* p = static_cast<Pending*>(io_uring_cqe_get_data(cqe));
+    const int res = cqe->res;
+    io_uring_cqe_seen(&impl_->ring, cqe);
+    --inKernel;
+    if (res < 0) {
+      failDraining(std::strerror(-res));
+    }
+    if (res == 0) {
+      failDraining("unexpected end of file");
+    }
+    p->buffer += res;
+    p->offset += res;
+    p->remaining -= res;
+    if (p->remaining == 0) {
+      ++completed;
+    } else {
+      queue.push_back(p);
+    }
+  }
+#else
+  std::vector<std::future<void>> futures;
+  futures.reserve(requests.size());
+  for (const auto& req : requests) {
+    if (req.size == 0) {
+      continue;
+    }
+    futures.push_back(impl_->pool->enqueue([this, req]() {
+      char* buffer = req.buffer;
+      int64_t offset = req.offset;
+      int64_t remaining = req.size;
+#ifdef _WIN32
+      std::ifstream fs(impl_->path, std::ios_base::in | std::ios_base::binary);
+      if (!fs.is_open()) {
+        throwReadError(impl_->path, "could not open file");
+      }
+      fs.exceptions(
+          std::ifstream::eofbit | std::ifstream::failbit |
+          std::ifstream::badbit);
+      fs.seekg(offset, std::ios_base::beg);
+      fs.read(buffer, remaining);
+#else
+      while (remaining > 0) {
+        const ssize_t n = ::pread(impl_->fd, buffer, remaining, offset);
+        if (n < 0) {
+          if (errno == EINTR) {
+            continue;
+          }
+          throwReadError(impl_->path, std::strerror(errno));
+        }
+        if (n == 0) {
+          throwReadError(impl_->path, "unexpected end of file");
+        }
+        buffer += n;
+        offset += n;
+        remaining -= n;
+      }
+#endif
+    }));
+  }
+  // pool tasks write into caller-owned buffers, so they must never outlive
+  // this call: wait on every future, then surface the first error
+  std::exception_ptr firstError;
+  for (auto& future : futures) {
+    try {
+      future.get();
+    } catch (...) {
+      if (!firstError) {
+        firstError = std::current_exception();
+      }
+    }
+  }
+  if (firstError) {
+    std::rethrow_exception(firstError);
+  }
+#endif
+}
+
+void AsyncFileReader::readahead(int64_t offset, int64_t size) const {
+#ifdef _WIN32
+  (void)offset;
+  (void)size;
+#else
+  if (offset < 0 || size <= 0) {
+    return;
+  }
+  // advisory only - failure just means the pages arrive on demand
+  ::posix_fadvise(impl_->fd, offset, size, POSIX_FADV_WILLNEED);
+#endif
+}
+
+bool AsyncFileReader::usingIoUring() {
+#ifdef FL_USE_IO_URING
+  return true;
+#else
+  return false;
+#endif
+}
+
+} // namespace fl
@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "flashlight/fl/common/Defines.h"
+#include "flashlight/fl/common/Filesystem.h"
+
+namespace fl {
+
+/**
+ * One contiguous read of an `AsyncFileReader` scatter batch.
+ */
+struct FL_API FileReadRequest {
+  /// Byte offset in the file.
+  int64_t offset;
+  /// Number of bytes to read.
+  int64_t size;
+  /// Destination buffer of at least `size` bytes, owned by the caller.
+  char* buffer;
+};
+
+/**
+ * Asynchronous read access to a single file.
+ *
+ * Synchronous stream reads issue one request at a time and leave most of the
+ * device queue depth of modern storage unused. A scatter batch passed to
+ * read() is instead submitted as a whole - through io_uring when Flashlight
+ * is built with `FL_USE_IO_URING`, and through positional reads on a small
+ * thread pool otherwise - so independent requests queue on the device
+ * concurrently. readahead() additionally hints the kernel to start faulting
+ * a byte range into the page cache before it is read.
+ *
+ * Reads and hints are thread-safe; the file is opened read-only.
+ */
+class FL_API AsyncFileReader {
+ public:
+  /**
+   * Opens a file for asynchronous reading.
+   * @param[in] path The file to read.
+   * @param[in] queueDepth The maximum number of requests submitted to the
+   * device at once; batches larger than this are submitted in waves.
+   */
+  explicit AsyncFileReader(const fs::path& path, int queueDepth = 32);
+  ~AsyncFileReader();
+
+  AsyncFileReader(const AsyncFileReader&) = delete;
+  AsyncFileReader& operator=(const AsyncFileReader&) = delete;
+
+  /**
+   * Reads every request in the batch, blocking until all have completed.
+   * Requests may touch arbitrary, possibly overlapping ranges of the file.
+   * Throws `std::runtime_error` on an I/O error or a read past the end of
+   * the file.
+   */
+  void read(const std::vector<FileReadRequest>& requests) const;
+
+  /**
+   * Hints that the given byte range will be read soon, so the kernel can
+   * begin populating the page cache while the caller does other work. A
+   * no-op on platforms without readahead advice.
+   */
+  void readahead(int64_t offset, int64_t size) const;
+
+  /**
+   * Whether reads are served through io_uring rather than the thread-pool
+   * fallback.
+   */
+  static bool usingIoUring();
+
+ private:
+  struct Impl;
+  std::unique_ptr<Impl> impl_;
+};
+
+} // namespace fl
@@ -36,6 +36,37 @@ OptimLevel OptimMode::toOptimLevel(const std::string& in) {
   return l->second;
 }
 
+OptimLevelGuard::OptimLevelGuard(OptimLevel level)
+    : prevLevel_(OptimMode::get().getOptimLevel()) {
+  OptimMode::get().setOptimLevel(level);
+}
+
+OptimLevelGuard::~OptimLevelGuard() {
+  OptimMode::get().setOptimLevel(prevLevel_);
+}
+
+DeterministicMode& DeterministicMode::get() {
+  static DeterministicMode deterministicMode;
+  return deterministicMode;
+}
+
+bool DeterministicMode::enabled() const {
+  return enabled_;
+}
+
+void DeterministicMode::setEnabled(bool enabled) {
+  enabled_ = enabled;
+}
+
+DeterministicModeGuard::DeterministicModeGuard(bool enabled /* = true */)
+    : prevEnabled_(DeterministicMode::get().enabled()) {
+  DeterministicMode::get().setEnabled(enabled);
+}
+
+DeterministicModeGuard::~DeterministicModeGuard() {
+  DeterministicMode::get().setEnabled(prevEnabled_);
+}
+
 const std::unordered_map<std::string, OptimLevel>
     OptimMode::kStringToOptimLevel = {
         {"DEFAULT", OptimLevel::DEFAULT},
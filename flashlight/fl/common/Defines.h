@@ -78,6 +78,23 @@ enum class PaddingMode {
   SAME = -1,
 };
 
+/**
+ * Output epilogue fused into `linear`, `conv2d`, and `layerNorm` rather than
+ * issued as separate broadcast-add and activation kernels.
+ */
+enum class Epilogue {
+  /// No epilogue - any bias argument is ignored
+  NONE = 0,
+  /// Add the bias to the output
+  BIAS = 1,
+  /// Add the bias, then apply a ReLU
+  BIAS_RELU = 2,
+  /// Add the bias, then apply a GELU (tanh approximation)
+  BIAS_GELU = 3,
+  /// Add the bias, then apply a swish, x * sigmoid(x)
+  BIAS_SWISH = 4,
+};
+
 enum class DistributedBackend {
   /// https://github.com/facebookincubator/gloo
   GLOO = 0,
@@ -89,11 +106,14 @@ enum class DistributedBackend {
 enum class DistributedInit {
   MPI = 0,
   FILE_SYSTEM = 1,
+  TCP = 2,
 };
 
 namespace DistributedConstants {
 constexpr const char* kMaxDevicePerNode = "MAX_DEVICE_PER_NODE";
 constexpr const char* kFilePath = "FILE_PATH";
+constexpr const char* kTcpAddr = "TCP_ADDR";
+constexpr const char* kTcpPort = "TCP_PORT";
 constexpr const std::size_t kCoalesceCacheSize = ((size_t)(20) << 20); // 20 MB
 } // namespace DistributedConstants
 
@@ -163,6 +183,88 @@ class FL_API OptimMode {
   OptimLevel optimLevel_{OptimLevel::DEFAULT};
 };
 
+/**
+ * RAII guard setting the optimization level (`OptimLevel`) for a scope.
+ *
+ * Wrapping a model's forward and loss computation in a guard gives automatic
+ * mixed precision without inserting `PrecisionCast` modules by hand: autograd
+ * operators pick up the active level via `FL_ADJUST_INPUT_TYPE` and apply the
+ * per-operator policy in `detail::kOptimLevelTypeExclusionMappings` - under
+ * `O1`, matrix multiplies and convolutions run in f16 while reductions,
+ * softmax, and normalization accumulate in f32.
+ *
+ * \code
+ * fl::OptimLevelGuard amp(fl::OptimLevel::O1);
+ * auto loss = criterion->forward(model->forward(input), target);
+ * \endcode
+ *
+ * The previous level is restored on destruction; the backward pass replays
+ * the precision recorded while building the graph, so only the forward and
+ * loss computation need to run under the guard. Pair with
+ * `pkg::runtime::DynamicScaler` to guard against gradient underflow in f16.
+ */
+class FL_API OptimLevelGuard {
+ public:
+  explicit OptimLevelGuard(OptimLevel level);
+  ~OptimLevelGuard();
+
+  OptimLevelGuard(const OptimLevelGuard&) = delete;
+  OptimLevelGuard& operator=(const OptimLevelGuard&) = delete;
+
+ private:
+  OptimLevel prevLevel_;
+};
+
+/**
+ * Singleton storing whether flashlight runs in deterministic mode.
+ *
+ * When enabled, components whose fast path is nondeterministic switch to a
+ * bitwise-reproducible alternative of comparable speed rather than to a
+ * conservative slow path: `CoalescingReducer` synchronizes gradients in
+ * insertion order on the compute stream instead of asynchronously, and the
+ * cudnn autograd extension restricts convolution algorithm selection to the
+ * fastest algorithm cudnn reports as deterministic. Pair with `fl::setSeed`
+ * to make whole training steps reproducible run to run.
+ */
+class FL_API DeterministicMode {
+ public:
+  /**
+   * @return the DeterministicMode singleton
+   */
+  static DeterministicMode& get();
+
+  /**
+   * Whether deterministic mode is active. Not thread safe.
+   */
+  bool enabled() const;
+
+  /**
+   * Enables or disables deterministic mode. Not thread safe.
+   *
+   * @param[in] enabled whether deterministic execution is required
+   */
+  void setEnabled(bool enabled);
+
+ private:
+  bool enabled_{false};
+};
+
+/**
+ * RAII guard enabling deterministic mode (`DeterministicMode`) for a scope.
+ * The previous setting is restored on destruction.
+ */
+class FL_API DeterministicModeGuard {
+ public:
+  explicit DeterministicModeGuard(bool enabled = true);
+  ~DeterministicModeGuard();
+
+  DeterministicModeGuard(const DeterministicModeGuard&) = delete;
+  DeterministicModeGuard& operator=(const DeterministicModeGuard&) = delete;
+
+ private:
+  bool prevEnabled_;
+};
+
 /** @} */
 
 } // namespace fl
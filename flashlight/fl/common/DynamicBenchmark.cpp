@@ -6,6 +6,11 @@
  */
 
 #include "flashlight/fl/common/DynamicBenchmark.h"
+
+#include <fstream>
+#include <mutex>
+#include <unordered_map>
+
 #include "flashlight/fl/tensor/Compute.h"
 
 namespace fl {
@@ -13,6 +18,26 @@ namespace fl {
 // Default value for benchmark mode
 bool DynamicBenchmark::benchmarkMode_ = false;
 
+namespace {
+
+// On-disk cache of completed benchmark decisions. Entries map a
+// caller-provided key (op signature + shapes + device) to the index of the
+// winning option. The file holds one `key\tindex` entry per line and is
+// append-only, so concurrent processes sharing a cache path at worst append
+// duplicate entries; on load, later entries win.
+struct BenchmarkCache {
+  std::mutex mutex;
+  fs::path path;
+  std::unordered_map<std::string, size_t> entries;
+};
+
+BenchmarkCache& benchmarkCache() {
+  static BenchmarkCache instance;
+  return instance;
+}
+
+} // namespace
+
 void DynamicBenchmark::audit(
     const std::function<void()>& function,
     bool incrementCount) {
@@ -37,6 +62,57 @@ void DynamicBenchmark::stop(bool incrementCount) {
   fl::sync();
   auto elapsedTime = fl::Timer::stop(currentTimer_);
   options_->accumulateTimeToCurrentOption(elapsedTime, incrementCount);
+
+  // Persist the decision once this accumulation completes the timings
+  if (!cacheKey_.empty() && options_->timingsComplete()) {
+    const size_t optionIdx = options_->currentOptionIndex();
+    auto& cache = benchmarkCache();
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    if (cache.path.empty() || cache.entries.count(cacheKey_)) {
+      return;
+    }
+    cache.entries[cacheKey_] = optionIdx;
+    std::ofstream ofs(cache.path, std::ios::app);
+    if (ofs.is_open()) {
+      ofs << cacheKey_ << '\t' << optionIdx << '\n';
+    }
+  }
+}
+
+void DynamicBenchmark::setCacheKey(const std::string& key) {
+  cacheKey_ = key;
+  auto& cache = benchmarkCache();
+  std::lock_guard<std::mutex> lock(cache.mutex);
+  if (cache.path.empty()) {
+    return;
+  }
+  auto entry = cache.entries.find(key);
+  if (entry != cache.entries.end()) {
+    options_->setTimedOptionIndex(entry->second);
+  }
+}
+
+void DynamicBenchmark::setBenchmarkCachePath(const fs::path& path) {
+  auto& cache = benchmarkCache();
+  std::lock_guard<std::mutex> lock(cache.mutex);
+  cache.path = path;
+  cache.entries.clear();
+  if (path.empty()) {
+    return;
+  }
+  std::ifstream ifs(path);
+  std::string line;
+  while (std::getline(ifs, line)) {
+    const size_t sep = line.rfind('\t');
+    if (sep == std::string::npos || sep + 1 >= line.size()) {
+      continue; // skip malformed entries rather than failing startup
+    }
+    try {
+      cache.entries[line.substr(0, sep)] = std::stoul(line.substr(sep + 1));
+    } catch (const std::exception&) {
+      continue;
+    }
+  }
 }
 
 void DynamicBenchmark::setBenchmarkMode(bool mode) {
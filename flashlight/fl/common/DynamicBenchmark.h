@@ -10,12 +10,14 @@
 #include <functional>
 #include <memory>
 #include <stdexcept>
+#include <string>
 #include <unordered_map>
 #include <unordered_set>
 #include <utility>
 #include <vector>
 
 #include "flashlight/fl/common/Defines.h"
+#include "flashlight/fl/common/Filesystem.h"
 #include "flashlight/fl/common/Timer.h"
 
 namespace fl {
@@ -42,6 +44,18 @@ struct FL_API DynamicBenchmarkOptionsBase {
         "- unimplemented");
   }
 
+  virtual size_t currentOptionIndex() {
+    throw std::logic_error(
+        "DynamicBenchmarkOptionsBase::currentOptionIndex "
+        "- unimplemented");
+  }
+
+  virtual void setTimedOptionIndex(size_t) {
+    throw std::logic_error(
+        "DynamicBenchmarkOptionsBase::setTimedOptionIndex "
+        "- unimplemented");
+  }
+
  protected:
   // Not intended for construction
   DynamicBenchmarkOptionsBase() = default;
@@ -163,6 +177,33 @@ struct DynamicBenchmarkOptions : DynamicBenchmarkOptionsBase {
     }
   }
 
+  /**
+   * @return the index of the current option. Only meaningful as a benchmark
+   * decision once timings are complete.
+   */
+  size_t currentOptionIndex() override {
+    updateState();
+    return currentOptionIdx_;
+  }
+
+  /**
+   * Fixes the current option to the given index and marks timings as
+   * complete, as if benchmarking had run and selected that option. Used to
+   * restore a previously-timed decision (e.g. from the on-disk benchmark
+   * cache) without re-timing the option space.
+   *
+   * @param[in] optionIdx the index of the option to fix on
+   */
+  void setTimedOptionIndex(size_t optionIdx) override {
+    if (optionIdx >= options_.size()) {
+      throw std::invalid_argument(
+          "DynamicBenchmarkOptions::setTimedOptionIndex: "
+          "option index is out of range");
+    }
+    currentOptionIdx_ = optionIdx;
+    timingsComplete_ = true;
+  }
+
   /**
    * Resets options state to the default. Clears timings and counts.
    */
@@ -238,15 +279,42 @@ class FL_API DynamicBenchmark {
    */
   static bool getBenchmarkMode();
 
+  /**
+   * Associates this benchmark with a key in the on-disk benchmark cache. The
+   * key should uniquely describe the timed op - e.g. op signature, operand
+   * shapes and device. If the cache already holds a decision for the key, the
+   * options are immediately fixed on that decision and no timing runs; else,
+   * the decision is written to the cache once timings complete.
+   *
+   * No-op if no cache path is set via `setBenchmarkCachePath`.
+   *
+   * @param[in] key a string uniquely identifying the benchmarked op
+   */
+  void setCacheKey(const std::string& key);
+
+  /**
+   * Sets the path of the on-disk cache of benchmark decisions. Existing
+   * entries at the path are loaded and consulted by benchmarks with a cache
+   * key set; new decisions are appended as their timings complete, so
+   * subsequent processes skip benchmarking ops already timed. Passing an
+   * empty path disables the cache and discards loaded entries.
+   *
+   * @param[in] path the cache file path, or an empty path to disable
+   */
+  static void setBenchmarkCachePath(const fs::path& path);
+
  private:
   // Starts the benchmark timer
   void start();
-  // Stops the benchmark timer, accumulates times to the current option
+  // Stops the benchmark timer, accumulates times to the current option;
+  // writes the decision to the benchmark cache once timings complete
   void stop(bool incrementCount);
 
   std::shared_ptr<DynamicBenchmarkOptionsBase> options_;
   // Timer for current benchmark iteration
   fl::Timer currentTimer_;
+  // Key in the on-disk benchmark cache, if any
+  std::string cacheKey_;
 
   // Global fl benchmark mode - if off, no benchmarks will run, and audited
   // functions will be run directly without timings
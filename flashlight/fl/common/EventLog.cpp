@@ -0,0 +1,188 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ *
+ */
+
+#include "flashlight/fl/common/EventLog.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <fstream>
+#include <functional>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace fl {
+
+int EventLog::maxLevel_ = 0;
+
+namespace {
+
+// records buffered per thread before a hand-off to the flusher
+constexpr size_t kRingCapacity = 4096;
+
+// The background flusher shared by all threads. Producers only touch its
+// mutex on a full-buffer hand-off (once per kRingCapacity records); the
+// actual file I/O happens outside the lock on the flusher thread.
+class Flusher {
+ public:
+  static Flusher& getInstance() {
+    static Flusher instance;
+    return instance;
+  }
+
+  void open(const std::string& path) {
+    close();
+    std::unique_lock<std::mutex> lock(mutex_);
+    sink_.open(path, std::ios::binary | std::ios::trunc);
+    if (!sink_.is_open()) {
+      throw std::runtime_error(
+          "EventLog::openSink - failed to open sink file: " + path);
+    }
+    stop_ = false;
+    thread_ = std::thread([this]() { writeLoop(); });
+    active_ = true;
+  }
+
+  void close() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (!active_) {
+      return;
+    }
+    active_ = false;
+    stop_ = true;
+    cond_.notify_one();
+    lock.unlock();
+    thread_.join();
+    lock.lock();
+    // drain whatever arrived before producers observed the shutdown
+    for (const auto& batch : pending_) {
+      write(batch);
+    }
+    pending_.clear();
+    sink_.close();
+  }
+
+  bool active() const {
+    return active_.load(std::memory_order_relaxed);
+  }
+
+  void submit(std::vector<EventRecord>&& records) {
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      if (!active_) {
+        return;
+      }
+      pending_.push_back(std::move(records));
+    }
+    cond_.notify_one();
+  }
+
+ private:
+  void writeLoop() {
+    for (;;) {
+      std::vector<std::vector<EventRecord>> batches;
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cond_.wait(lock, [this] { return stop_ || !pending_.empty(); });
+        if (stop_ && pending_.empty()) {
+          return;
+        }
+        std::swap(batches, pending_);
+      }
+      for (const auto& batch : batches) {
+        write(batch);
+      }
+    }
+  }
+
+  void write(const std::vector<EventRecord>& records) {
+    sink_.write(
+        reinterpret_cast<const char*>(records.data()),
+        records.size() * sizeof(EventRecord));
+  }
+
+  std::mutex mutex_;
+  std::condition_variable cond_;
+  std::ofstream sink_;
+  std::vector<std::vector<EventRecord>> pending_;
+  std::thread thread_;
+  std::atomic<bool> active_{false};
+  bool stop_{false};
+};
+
+// The calling thread's buffer; hands itself off when full and on thread exit.
+struct ThreadBuffer {
+  ThreadBuffer() {
+    records.reserve(kRingCapacity);
+  }
+
+  ~ThreadBuffer() {
+    handOff();
+  }
+
+  void add(const EventRecord& record) {
+    records.push_back(record);
+    if (records.size() >= kRingCapacity) {
+      handOff();
+    }
+  }
+
+  void handOff() {
+    if (records.empty()) {
+      return;
+    }
+    if (Flusher::getInstance().active()) {
+      Flusher::getInstance().submit(std::move(records));
+      records = {};
+      records.reserve(kRingCapacity);
+    } else {
+      records.clear();
+    }
+  }
+
+  std::vector<EventRecord> records;
+};
+
+thread_local ThreadBuffer threadBuffer;
+
+} // namespace
+
+void EventLog::openSink(const std::string& path) {
+  Flusher::getInstance().open(path);
+}
+
+void EventLog::closeSink() {
+  threadBuffer.handOff();
+  Flusher::getInstance().close();
+}
+
+void EventLog::flush() {
+  threadBuffer.handOff();
+}
+
+void EventLog::setMaxLevel(int maxLevel) {
+  maxLevel_ = maxLevel;
+}
+
+void EventLog::record(uint16_t id, int level, double value) {
+  static thread_local const uint32_t tid = static_cast<uint32_t>(
+      std::hash<std::thread::id>()(std::this_thread::get_id()));
+  EventRecord record;
+  record.timeUs = std::chrono::duration_cast<std::chrono::microseconds>(
+                      std::chrono::system_clock::now().time_since_epoch())
+                      .count();
+  record.threadId = tid;
+  record.id = id;
+  record.level = static_cast<uint16_t>(level);
+  record.value = value;
+  threadBuffer.add(record);
+}
+
+} // namespace fl
@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ *
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "flashlight/fl/common/Defines.h"
+
+/**
+ * \defgroup eventlog Structured Event Logging
+ *
+ * A low-overhead structured counterpart to `FL_LOG`/`FL_VLOG` for hot-path
+ * instrumentation (per-step tensor stats, allocator and reducer activity).
+ * Instead of formatting strings, `FL_EVENT` appends a fixed-size binary
+ * record to a per-thread ring buffer; full buffers are handed to a
+ * background thread that writes them to the configured sink file, so the
+ * instrumented path pays a few stores and no locks, allocation or I/O.
+ *
+ * Use examples:
+ * \code
+ *   FL_EVENT(1, kAllocEventId, bytes);
+ *   // record roughly one in 100 occurrences
+ *   FL_EVENT_SAMPLED(2, kReducerFlushId, bucketBytes, 100);
+ * \endcode
+ *
+ * Records are dropped unless a sink has been opened with
+ * `EventLog::openSink` and the event level passes the runtime threshold
+ * (`EventLog::setMaxLevel`, mirroring `VerboseLogging` levels). Events with
+ * a compile-time level above `FL_EVENT_MAX_COMPILED_LEVEL` are elided
+ * entirely at compile time.
+ */
+namespace fl {
+
+/**
+ * A fixed-size binary event record; the sink file is a flat array of these.
+ *
+ * \ingroup eventlog
+ */
+struct EventRecord {
+  /// Microseconds since the UNIX epoch.
+  int64_t timeUs;
+  /// Hashed id of the recording thread.
+  uint32_t threadId;
+  /// Caller-defined event id (e.g. one id per instrumented site).
+  uint16_t id;
+  /// Verbosity level the event was recorded at.
+  uint16_t level;
+  /// Caller-defined payload, e.g. a byte count, duration or tensor stat.
+  double value;
+};
+
+static_assert(sizeof(EventRecord) == 24, "EventRecord must be fixed-size");
+
+/**
+ * Collects `EventRecord`s into per-thread ring buffers and flushes them to a
+ * sink file on a background thread. See \ref eventlog.
+ *
+ * \ingroup eventlog
+ */
+class FL_API EventLog {
+ public:
+  /**
+   * Open (truncate) the sink file and start the background flusher. Events
+   * recorded while no sink is open are dropped.
+   */
+  static void openSink(const std::string& path);
+
+  /**
+   * Flush all outstanding records and stop the background flusher. Safe to
+   * call when no sink is open.
+   */
+  static void closeSink();
+
+  /// Force-hand the calling thread's buffered records to the flusher.
+  static void flush();
+
+  /// Overrides the runtime event level threshold (default 0: record none).
+  static void setMaxLevel(int maxLevel);
+
+  static bool ifLog(int level) {
+    return maxLevel_ >= level;
+  }
+
+  /**
+   * Append one record to the calling thread's buffer. Prefer the `FL_EVENT`
+   * macros, which apply level filtering and compile-time elision.
+   */
+  static void record(uint16_t id, int level, double value);
+
+ private:
+  static int maxLevel_;
+};
+
+} // namespace fl
+
+/**
+ * Events above this level are compiled out entirely; override per-TU (or
+ * globally) before including this header to elide instrumentation.
+ *
+ * \ingroup eventlog
+ */
+#ifndef FL_EVENT_MAX_COMPILED_LEVEL
+#define FL_EVENT_MAX_COMPILED_LEVEL 10
+#endif
+
+/**
+ * Record a structured event with the given verbosity level, caller-defined
+ * id and double payload. Compiled out when `level` exceeds
+ * `FL_EVENT_MAX_COMPILED_LEVEL`; otherwise a runtime threshold check and,
+ * when enabled, a few stores into a per-thread buffer.
+ *
+ * \ingroup eventlog
+ */
+#define FL_EVENT(level, id, value)                            \
+  do {                                                        \
+    if ((level) <= FL_EVENT_MAX_COMPILED_LEVEL &&             \
+        fl::EventLog::ifLog(level)) {                         \
+      fl::EventLog::record((id), (level), (value));           \
+    }                                                         \
+  } while (0)
+
+/**
+ * Like `FL_EVENT`, but records only every `everyN`-th occurrence per thread,
+ * for sites too hot to record unconditionally.
+ *
+ * \ingroup eventlog
+ */
+#define FL_EVENT_SAMPLED(level, id, value, everyN)            \
+  do {                                                        \
+    if ((level) <= FL_EVENT_MAX_COMPILED_LEVEL &&             \
+        fl::EventLog::ifLog(level)) {                         \
+      static thread_local uint64_t flEventSampleCount_ = 0;   \
+      if (flEventSampleCount_++ % (everyN) == 0) {            \
+        fl::EventLog::record((id), (level), (value));         \
+      }                                                       \
+    }                                                         \
+  } while (0)
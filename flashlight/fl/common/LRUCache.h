@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+namespace fl {
+
+/**
+ * A thread-safe least-recently-used cache with size-in-bytes accounting.
+ *
+ * Entries are spread over independently locked shards by key hash, so
+ * lookups for different keys mostly don't contend; each shard tracks its own
+ * recency order and evicts from its cold end once its share of `maxBytes` is
+ * exceeded. Values are handed out as `std::shared_ptr`, so a value a caller
+ * holds stays alive even if the cache evicts it concurrently.
+ *
+ * `put` weights an entry by its `bytes` argument; with the default weight
+ * of 1 the capacity is a plain entry count. An entry larger than a whole
+ * shard is still admitted (the shard then holds only it) -- the cache bounds
+ * memory, it never refuses the value the caller is about to use.
+ *
+ * Caches with few, hot entries and single-threaded callers should pass
+ * `shardCount` 1 to get exact global LRU order instead of per-shard order.
+ */
+template <typename K, typename V, typename Hash = std::hash<K>>
+class LRUCache {
+ public:
+  static constexpr size_t kDefaultShardCount = 8;
+
+  explicit LRUCache(size_t maxBytes, size_t shardCount = kDefaultShardCount) {
+    if (shardCount == 0) {
+      throw std::invalid_argument("LRUCache: shardCount must be positive");
+    }
+    const size_t perShard = std::max<size_t>(maxBytes / shardCount, 1);
+    for (size_t i = 0; i < shardCount; ++i) {
+      shards_.push_back(std::make_unique<Shard>(perShard));
+    }
+  }
+
+  /**
+   * Returns the cached value, marking it most recently used, or nullptr.
+   */
+  std::shared_ptr<V> get(const K& key) {
+    auto& shard = shardFor(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto iter = shard.map.find(key);
+    if (iter == shard.map.end()) {
+      return nullptr;
+    }
+    shard.recency.splice(
+        shard.recency.begin(), shard.recency, iter->second.position);
+    return iter->second.value;
+  }
+
+  /**
+   * Inserts (or replaces) the value under `key` with the given byte weight,
+   * evicting cold entries from the key's shard as needed, and returns it.
+   */
+  std::shared_ptr<V> put(const K& key, std::shared_ptr<V> value, size_t bytes = 1) {
+    auto& shard = shardFor(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto iter = shard.map.find(key);
+    if (iter != shard.map.end()) {
+      shard.bytes -= iter->second.bytes;
+      shard.recency.erase(iter->second.position);
+      shard.map.erase(iter);
+    }
+    while (!shard.recency.empty() && shard.bytes + bytes > shard.maxBytes) {
+      auto coldIter = shard.map.find(shard.recency.back());
+      shard.bytes -= coldIter->second.bytes;
+      shard.map.erase(coldIter);
+      shard.recency.pop_back();
+    }
+    shard.recency.push_front(key);
+    shard.map.emplace(key, Entry{shard.recency.begin(), value, bytes});
+    shard.bytes += bytes;
+    return value;
+  }
+
+  /**
+   * Returns the cached value, invoking `create` (which must return an
+   * `std::shared_ptr<V>`) to build and insert it on a miss. The factory runs
+   * without the shard lock held, so concurrent misses on the same key may
+   * both create; the later insertion wins.
+   */
+  template <typename Factory>
+  std::shared_ptr<V> getOrPut(const K& key, Factory&& create, size_t bytes = 1) {
+    if (auto value = get(key)) {
+      return value;
+    }
+    return put(key, create(), bytes);
+  }
+
+  /**
+   * The number of cached entries.
+   */
+  size_t size() const {
+    size_t total = 0;
+    for (const auto& shard : shards_) {
+      std::lock_guard<std::mutex> lock(shard->mutex);
+      total += shard->map.size();
+    }
+    return total;
+  }
+
+  /**
+   * The summed byte weight of the cached entries.
+   */
+  size_t sizeInBytes() const {
+    size_t total = 0;
+    for (const auto& shard : shards_) {
+      std::lock_guard<std::mutex> lock(shard->mutex);
+      total += shard->bytes;
+    }
+    return total;
+  }
+
+  /**
+   * Removes all cached entries.
+   */
+  void clear() {
+    for (const auto& shard : shards_) {
+      std::lock_guard<std::mutex> lock(shard->mutex);
+      shard->map.clear();
+      shard->recency.clear();
+      shard->bytes = 0;
+    }
+  }
+
+ private:
+  struct Entry {
+    typename std::list<K>::iterator position;
+    std::shared_ptr<V> value;
+    size_t bytes;
+  };
+
+  struct Shard {
+    explicit Shard(size_t max) : maxBytes(max) {}
+
+    mutable std::mutex mutex;
+    std::list<K> recency; // most recently used first
+    std::unordered_map<K, Entry, Hash> map;
+    size_t bytes{0};
+    size_t maxBytes;
+  };
+
+  Shard& shardFor(const K& key) {
+    return *shards_[Hash()(key) % shards_.size()];
+  }
+
+  std::vector<std::unique_ptr<Shard>> shards_;
+};
+
+} // namespace fl
@@ -10,10 +10,15 @@
  * Implementation details, only to be included from Serialization.h
  */
 
+#include <algorithm>
+#include <cstring>
 #include <fstream>
+#include <limits>
 #include <stdexcept>
+#include <streambuf>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 #include "flashlight/fl/common/Filesystem.h"
 #include "flashlight/fl/tensor/TensorBase.h"
@@ -140,6 +145,94 @@ void save(std::ostream& ostr, const Args&... args) {
   ar(args...);
 }
 
+namespace detail {
+
+/**
+ * A `streambuf` writing into a caller-owned growable arena, so cereal's many
+ * small archive writes become memcpys into preallocated memory instead of
+ * locale-checked `ofstream` writes.
+ */
+class ArenaStreamBuf : public std::streambuf {
+ public:
+  explicit ArenaStreamBuf(std::vector<char>& arena) : arena_(arena) {
+    if (arena_.empty()) {
+      arena_.resize(1 << 20);
+    }
+    setp(arena_.data(), arena_.data() + arena_.size());
+  }
+
+  size_t size() const {
+    return pptr() - pbase();
+  }
+
+ protected:
+  int_type overflow(int_type ch) override {
+    grow(arena_.size() * 2);
+    if (ch != traits_type::eof()) {
+      *pptr() = traits_type::to_char_type(ch);
+      advance(1);
+    }
+    return ch;
+  }
+
+  std::streamsize xsputn(const char* s, std::streamsize n) override {
+    if (size() + n > arena_.size()) {
+      size_t cap = arena_.size();
+      while (cap < size() + n) {
+        cap *= 2;
+      }
+      grow(cap);
+    }
+    std::memcpy(pptr(), s, n);
+    advance(n);
+    return n;
+  }
+
+ private:
+  // pbump takes an int; step through it for >2 GB offsets (large checkpoints)
+  void advance(size_t n) {
+    while (n > 0) {
+      const auto step = static_cast<int>(std::min<size_t>(
+          n, static_cast<size_t>(std::numeric_limits<int>::max())));
+      pbump(step);
+      n -= step;
+    }
+  }
+
+  void grow(size_t newSize) {
+    const size_t used = size();
+    arena_.resize(newSize);
+    setp(arena_.data(), arena_.data() + arena_.size());
+    advance(used);
+  }
+
+  std::vector<char>& arena_;
+};
+
+} // namespace detail
+
+template <typename... Args>
+void saveFast(const fs::path& filepath, const Args&... args) {
+  // reused across calls so steady-state checkpoints don't reallocate
+  static thread_local std::vector<char> arena;
+  detail::ArenaStreamBuf buf(arena);
+  std::ostream ostr(&buf);
+  {
+    cereal::BinaryOutputArchive ar(ostr);
+    ar(args...);
+  }
+  std::ofstream ofs(filepath, std::ios::binary);
+  if (!ofs.is_open()) {
+    throw std::runtime_error(
+        "saveFast - failed to open file for writing: " + filepath.string());
+  }
+  ofs.write(arena.data(), buf.size());
+  if (!ofs) {
+    throw std::runtime_error(
+        "saveFast - failed to write file: " + filepath.string());
+  }
+}
+
 template <typename... Args>
 void load(const fs::path& filepath, Args&... args) {
   std::ifstream ifs(filepath, std::ios::binary);
@@ -65,6 +65,20 @@ void save(const fs::path& filepath, const Args&... args);
 template <typename... Args>
 void save(std::ostream& ostr, const Args&... args);
 
+/**
+ * Save (serialize) the specified args to a binary file (via Cereal), staging
+ * the archive in a reused per-thread memory arena and writing the file with a
+ * single large write. Produces a file identical to `fl::save` (and readable
+ * by `fl::load`), but avoids the per-field stream overhead and reallocation
+ * of archiving straight into an `ofstream`, which dominates checkpoint time
+ * for large models. The arena persists between calls, so steady-state
+ * checkpointing does not allocate.
+ * @param filepath the file path to save to
+ * @param args the objects to save (e.g. shared_ptr to Module)
+ */
+template <typename... Args>
+void saveFast(const fs::path& filepath, const Args&... args);
+
 /**
  * Load (deserialize) the specified args from a binary file (via Cereal).
  * @param filepath the file path to load from
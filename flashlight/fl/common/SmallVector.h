@@ -0,0 +1,304 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace fl {
+namespace detail {
+
+/**
+ * A vector with inline storage for up to `InlineCapacity` elements, spilling
+ * to the heap only beyond that. Intended for small, hot, frequently-copied
+ * sequences - tensor dimensions, axis lists - where `std::vector`'s
+ * unconditional heap allocation dominates the cost of the surrounding
+ * operation.
+ *
+ * Provides the subset of the `std::vector` interface those call sites use,
+ * plus an implicit conversion to `std::vector<T>` so existing consumers of
+ * vector-returning accessors keep working (at the cost of an allocation at
+ * such call sites).
+ */
+template <typename T, std::size_t InlineCapacity>
+class SmallVector {
+ public:
+  using value_type = T;
+  using size_type = std::size_t;
+  using reference = T&;
+  using const_reference = const T&;
+  using iterator = T*;
+  using const_iterator = const T*;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+  SmallVector() = default;
+
+  explicit SmallVector(size_type count, const T& value = T()) {
+    reserve(count);
+    for (size_type i = 0; i < count; ++i) {
+      push_back(value);
+    }
+  }
+
+  template <
+      typename InputIt,
+      typename = typename std::enable_if<
+          !std::is_integral<InputIt>::value>::type>
+  SmallVector(InputIt first, InputIt last) {
+    for (; first != last; ++first) {
+      push_back(*first);
+    }
+  }
+
+  /* implicit */ SmallVector(std::initializer_list<T> init)
+      : SmallVector(init.begin(), init.end()) {}
+
+  /* implicit */ SmallVector(const std::vector<T>& vec)
+      : SmallVector(vec.begin(), vec.end()) {}
+
+  SmallVector(const SmallVector& other)
+      : SmallVector(other.begin(), other.end()) {}
+
+  SmallVector(SmallVector&& other) noexcept {
+    moveFrom(std::move(other));
+  }
+
+  SmallVector& operator=(const SmallVector& other) {
+    if (this != &other) {
+      clear();
+      reserve(other.size());
+      for (const auto& element : other) {
+        push_back(element);
+      }
+    }
+    return *this;
+  }
+
+  SmallVector& operator=(SmallVector&& other) noexcept {
+    if (this != &other) {
+      deallocate();
+      moveFrom(std::move(other));
+    }
+    return *this;
+  }
+
+  ~SmallVector() {
+    deallocate();
+  }
+
+  /* implicit */ operator std::vector<T>() const {
+    return std::vector<T>(begin(), end());
+  }
+
+  iterator begin() {
+    return data_;
+  }
+  const_iterator begin() const {
+    return data_;
+  }
+  const_iterator cbegin() const {
+    return data_;
+  }
+  iterator end() {
+    return data_ + size_;
+  }
+  const_iterator end() const {
+    return data_ + size_;
+  }
+  const_iterator cend() const {
+    return data_ + size_;
+  }
+  reverse_iterator rbegin() {
+    return reverse_iterator(end());
+  }
+  const_reverse_iterator rbegin() const {
+    return const_reverse_iterator(end());
+  }
+  reverse_iterator rend() {
+    return reverse_iterator(begin());
+  }
+  const_reverse_iterator rend() const {
+    return const_reverse_iterator(begin());
+  }
+
+  size_type size() const {
+    return size_;
+  }
+  size_type capacity() const {
+    return capacity_;
+  }
+  bool empty() const {
+    return size_ == 0;
+  }
+
+  T* data() {
+    return data_;
+  }
+  const T* data() const {
+    return data_;
+  }
+
+  reference operator[](size_type i) {
+    return data_[i];
+  }
+  const_reference operator[](size_type i) const {
+    return data_[i];
+  }
+  reference front() {
+    return data_[0];
+  }
+  const_reference front() const {
+    return data_[0];
+  }
+  reference back() {
+    return data_[size_ - 1];
+  }
+  const_reference back() const {
+    return data_[size_ - 1];
+  }
+
+  void push_back(const T& value) {
+    if (size_ == capacity_) {
+      grow(capacity_ * 2);
+    }
+    ::new (static_cast<void*>(data_ + size_)) T(value);
+    ++size_;
+  }
+
+  void push_back(T&& value) {
+    if (size_ == capacity_) {
+      grow(capacity_ * 2);
+    }
+    ::new (static_cast<void*>(data_ + size_)) T(std::move(value));
+    ++size_;
+  }
+
+  template <typename... Args>
+  reference emplace_back(Args&&... args) {
+    if (size_ == capacity_) {
+      grow(capacity_ * 2);
+    }
+    ::new (static_cast<void*>(data_ + size_)) T(std::forward<Args>(args)...);
+    return data_[size_++];
+  }
+
+  void pop_back() {
+    --size_;
+    data_[size_].~T();
+  }
+
+  void clear() {
+    for (size_type i = 0; i < size_; ++i) {
+      data_[i].~T();
+    }
+    size_ = 0;
+  }
+
+  void reserve(size_type newCapacity) {
+    if (newCapacity > capacity_) {
+      grow(newCapacity);
+    }
+  }
+
+  void resize(size_type newSize, const T& value = T()) {
+    while (size_ > newSize) {
+      pop_back();
+    }
+    reserve(newSize);
+    while (size_ < newSize) {
+      push_back(value);
+    }
+  }
+
+  bool operator==(const SmallVector& other) const {
+    if (size_ != other.size_) {
+      return false;
+    }
+    for (size_type i = 0; i < size_; ++i) {
+      if (!(data_[i] == other.data_[i])) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  bool operator!=(const SmallVector& other) const {
+    return !(*this == other);
+  }
+
+ private:
+  T* inlineData() {
+    return reinterpret_cast<T*>(inlineStorage_);
+  }
+
+  bool onHeap() const {
+    return capacity_ > InlineCapacity;
+  }
+
+  void grow(size_type newCapacity) {
+    if (newCapacity < size_ + 1) {
+      newCapacity = size_ + 1;
+    }
+    T* newData = static_cast<T*>(::operator new(newCapacity * sizeof(T)));
+    for (size_type i = 0; i < size_; ++i) {
+      ::new (static_cast<void*>(newData + i)) T(std::move(data_[i]));
+      data_[i].~T();
+    }
+    if (onHeap()) {
+      ::operator delete(data_);
+    }
+    data_ = newData;
+    capacity_ = newCapacity;
+  }
+
+  // Destroy all elements and release any heap storage, leaving the vector
+  // pointing at (empty) inline storage
+  void deallocate() {
+    clear();
+    if (onHeap()) {
+      ::operator delete(data_);
+      data_ = inlineData();
+      capacity_ = InlineCapacity;
+    }
+  }
+
+  // Assumes this vector holds no elements and no heap storage
+  void moveFrom(SmallVector&& other) {
+    if (other.onHeap()) {
+      data_ = other.data_;
+      capacity_ = other.capacity_;
+      size_ = other.size_;
+      other.data_ = other.inlineData();
+      other.capacity_ = InlineCapacity;
+      other.size_ = 0;
+    } else {
+      data_ = inlineData();
+      capacity_ = InlineCapacity;
+      size_ = 0;
+      for (size_type i = 0; i < other.size_; ++i) {
+        ::new (static_cast<void*>(data_ + i)) T(std::move(other.data_[i]));
+      }
+      size_ = other.size_;
+      other.clear();
+    }
+  }
+
+  alignas(T) unsigned char inlineStorage_[InlineCapacity * sizeof(T)];
+  T* data_{inlineData()};
+  size_type size_{0};
+  size_type capacity_{InlineCapacity};
+};
+
+} // namespace detail
+} // namespace fl
@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ *
+ */
+
+#include "flashlight/fl/common/Trace.h"
+
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace fl {
+
+std::atomic<bool> Tracer::enabled_{false};
+
+namespace {
+
+// One span buffer per thread. Appends take the buffer's own mutex, which is
+// uncontended except while an export copies it out; the registry keeps
+// buffers of finished threads alive so their spans survive until clear().
+struct ThreadTraceBuffer {
+  std::mutex mutex;
+  std::vector<TraceEvent> events;
+  uint32_t threadId;
+};
+
+struct TraceRegistry {
+  std::mutex mutex;
+  std::vector<std::shared_ptr<ThreadTraceBuffer>> buffers;
+};
+
+TraceRegistry& registry() {
+  static TraceRegistry instance;
+  return instance;
+}
+
+ThreadTraceBuffer& threadBuffer() {
+  static thread_local std::shared_ptr<ThreadTraceBuffer> buffer = [] {
+    auto b = std::make_shared<ThreadTraceBuffer>();
+    b->threadId = static_cast<uint32_t>(
+        std::hash<std::thread::id>()(std::this_thread::get_id()));
+    std::lock_guard<std::mutex> lock(registry().mutex);
+    registry().buffers.push_back(b);
+    return b;
+  }();
+  return *buffer;
+}
+
+void appendEscaped(std::string& out, const std::string& s) {
+  for (const char c : s) {
+    if (c == '"' || c == '\\') {
+      out += '\\';
+      out += c;
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      out += ' ';
+    } else {
+      out += c;
+    }
+  }
+}
+
+} // namespace
+
+void Tracer::enable() {
+  enabled_.store(true, std::memory_order_relaxed);
+}
+
+void Tracer::disable() {
+  enabled_.store(false, std::memory_order_relaxed);
+}
+
+void Tracer::clear() {
+  std::lock_guard<std::mutex> lock(registry().mutex);
+  for (auto& buffer : registry().buffers) {
+    std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+    buffer->events.clear();
+  }
+}
+
+int64_t Tracer::timeUs() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+void Tracer::recordSpan(std::string name, int64_t beginUs, int64_t endUs) {
+  auto& buffer = threadBuffer();
+  std::lock_guard<std::mutex> lock(buffer.mutex);
+  buffer.events.push_back(
+      {std::move(name), beginUs, endUs - beginUs, buffer.threadId});
+}
+
+void Tracer::writeChromeTrace(const fs::path& path) {
+  std::vector<TraceEvent> events;
+  {
+    std::lock_guard<std::mutex> lock(registry().mutex);
+    for (auto& buffer : registry().buffers) {
+      std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+      events.insert(
+          events.end(), buffer->events.begin(), buffer->events.end());
+    }
+  }
+
+  std::string json = "{\"traceEvents\":[";
+  bool first = true;
+  for (const auto& event : events) {
+    if (!first) {
+      json += ',';
+    }
+    first = false;
+    json += "{\"name\":\"";
+    appendEscaped(json, event.name);
+    json += "\",\"ph\":\"X\",\"pid\":0,\"tid\":";
+    json += std::to_string(event.threadId);
+    json += ",\"ts\":";
+    json += std::to_string(event.beginUs);
+    json += ",\"dur\":";
+    json += std::to_string(event.durationUs);
+    json += '}';
+  }
+  json += "]}";
+
+  std::ofstream ofs(path);
+  if (!ofs.is_open()) {
+    throw std::runtime_error(
+        "Tracer::writeChromeTrace - failed to open file for writing: " +
+        path.string());
+  }
+  ofs << json;
+}
+
+namespace detail {
+
+TraceScope::TraceScope(std::string name)
+    : active_(Tracer::enabled() && !name.empty()),
+      name_(std::move(name)),
+      beginUs_(active_ ? Tracer::timeUs() : 0) {}
+
+TraceScope::~TraceScope() {
+  if (active_) {
+    Tracer::recordSpan(std::move(name_), beginUs_, Tracer::timeUs());
+  }
+}
+
+} // namespace detail
+} // namespace fl
@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ *
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+#include "flashlight/fl/common/Defines.h"
+#include "flashlight/fl/common/Filesystem.h"
+
+/**
+ * \defgroup tracing Tracing Library
+ *
+ * In-process tracing of timed spans, exportable to the chrome://tracing (and
+ * Perfetto) JSON format for step-time breakdowns without an external
+ * profiler. Spans are recorded with the RAII `FL_TRACE_SCOPE` macro into
+ * per-thread buffers -- recording costs a clock read and an uncontended
+ * lock, and is a single atomic load when tracing is disabled. Unlike
+ * `FL_SCOPED_PROFILE`/`FL_PROFILE_TRACE` in tensor/Profile.h, which toggle
+ * the vendor profiler, these spans are collected by Flashlight itself.
+ *
+ * Use examples:
+ * \code
+ *   fl::Tracer::enable();
+ *   // ... run some steps; instrumented scopes record spans ...
+ *   fl::Tracer::disable();
+ *   fl::Tracer::writeChromeTrace("trace.json"); // open in chrome://tracing
+ * \endcode
+ */
+namespace fl {
+
+/**
+ * A recorded span; spans are gathered across all threads on export.
+ *
+ * \ingroup tracing
+ */
+struct TraceEvent {
+  std::string name;
+  /// Microseconds relative to the tracing clock epoch.
+  int64_t beginUs;
+  int64_t durationUs;
+  /// Id of the recording thread.
+  uint32_t threadId;
+};
+
+/**
+ * Controls span recording and exports collected spans. See \ref tracing.
+ *
+ * \ingroup tracing
+ */
+class FL_API Tracer {
+ public:
+  /// Start recording spans from `FL_TRACE_SCOPE` scopes.
+  static void enable();
+
+  /// Stop recording. Collected spans are kept until `clear()`.
+  static void disable();
+
+  static bool enabled() {
+    return enabled_.load(std::memory_order_relaxed);
+  }
+
+  /// Discard all collected spans.
+  static void clear();
+
+  /**
+   * Write all collected spans to a chrome://tracing JSON file. May be called
+   * while tracing is enabled; spans recorded concurrently may or may not be
+   * included.
+   */
+  static void writeChromeTrace(const fs::path& path);
+
+  /// Record a completed span; prefer the `FL_TRACE_SCOPE` macro.
+  static void recordSpan(std::string name, int64_t beginUs, int64_t endUs);
+
+  /// Microseconds on the tracing clock; spans use this time base.
+  static int64_t timeUs();
+
+ private:
+  static std::atomic<bool> enabled_;
+};
+
+namespace detail {
+
+/**
+ * RAII span: records from construction to destruction when tracing is
+ * enabled at construction time.
+ *
+ * \ingroup tracing
+ */
+class FL_API TraceScope {
+ public:
+  explicit TraceScope(std::string name);
+  ~TraceScope();
+
+  TraceScope(const TraceScope&) = delete;
+  TraceScope& operator=(const TraceScope&) = delete;
+
+ private:
+  bool active_;
+  std::string name_;
+  int64_t beginUs_;
+};
+
+} // namespace detail
+} // namespace fl
+
+// Used to generate a unique name for the expansion
+#define _FL_TRACE_CAT_IMPL(a, b) a##b
+#define _FL_TRACE_CAT(a, b) _FL_TRACE_CAT_IMPL(a, b)
+
+/**
+ * Record a span covering the enclosing scope. `name` is only evaluated when
+ * tracing is enabled, so building names dynamically (e.g. from
+ * `prettyString()`) costs nothing in the common disabled case.
+ *
+ * \ingroup tracing
+ */
+#define FL_TRACE_SCOPE(name)                              \
+  fl::detail::TraceScope _FL_TRACE_CAT(flTraceScope, __LINE__)( \
+      fl::Tracer::enabled() ? std::string(name) : std::string())
@@ -26,6 +26,8 @@ const std::unordered_map<OptimLevel, std::unordered_set<std::string>>
         {OptimLevel::O1,
          // Perform all operations in fp16 except for:
          {"batchnorm",
+          "layerNorm",
+          "addNorm",
           "reciprocal",
           "erf",
           "exp",
@@ -43,7 +45,7 @@ const std::unordered_map<OptimLevel, std::unordered_set<std::string>>
           "gelu"}},
         {OptimLevel::O2,
          // Perform all operations in fp16 except for:
-         {"batchnorm"}},
+         {"batchnorm", "layerNorm", "addNorm"}},
         {OptimLevel::O3, {}} // Perform all operations in f16
 };
 
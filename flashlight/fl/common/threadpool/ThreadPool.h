@@ -9,12 +9,13 @@
 
 #pragma once
 
+#include <atomic>
 #include <condition_variable>
+#include <deque>
 #include <functional>
 #include <future>
 #include <memory>
 #include <mutex>
-#include <queue>
 #include <stdexcept>
 #include <thread>
 #include <vector>
@@ -22,8 +23,15 @@
 namespace fl {
 
 /**
-* A simple C++11 Thread Pool implementation.
-* Source - https://github.com/progschj/ThreadPool
+* A C++11 thread pool with per-thread work-stealing deques and a two-level
+* task priority. Interface derived from
+* https://github.com/progschj/ThreadPool
+*
+* Normal (bulk) tasks are distributed round-robin over per-worker deques;
+* each worker takes from the front of its own deque and, when empty, steals
+* from the back of another worker's, so enqueue and dequeue rarely contend
+* on the same lock. High-priority (latency-critical) tasks go to a shared
+* queue that every worker drains before touching any bulk work.
 *
 * Basic usage:
   \code
@@ -33,12 +41,24 @@ namespace fl {
     // enqueue and store future
     auto result = pool.enqueue([](int answer) { return answer; }, 42);
 
+    // jump ahead of enqueued bulk work
+    pool.enqueue(ThreadPool::Priority::kHigh, [] { decodeImminentBatch(); });
+
     // get result from future
     std::cout << result.get() << std::endl;
   \endcode
 */
 class ThreadPool {
  public:
+  /**
+   * Task priority. `kHigh` tasks (e.g. decode work for the imminent batch)
+   * are run before any `kNormal` (bulk/speculative) tasks already enqueued.
+   */
+  enum class Priority {
+    kHigh = 0,
+    kNormal = 1,
+  };
+
   /**
    * the constructor just launches given amount of workers
    * \param [in] threads number of threads
@@ -50,32 +70,60 @@ class ThreadPool {
       const std::function<void(size_t)>& initFn = nullptr);
 
   /**
-   * add new work item to the pool
+   * add new work item to the pool with normal (bulk) priority
    * \param [in] f function to be executed in threadpool
    * \param [in] args varadic arguments for the function
    */
   template <class F, class... Args>
   auto enqueue(F&& f, Args&&... args)
       -> std::future<typename std::invoke_result<F, Args...>::type>;
+
+  /**
+   * add new work item to the pool with the given priority
+   * \param [in] priority scheduling priority of the task
+   * \param [in] f function to be executed in threadpool
+   * \param [in] args varadic arguments for the function
+   */
+  template <class F, class... Args>
+  auto enqueue(Priority priority, F&& f, Args&&... args)
+      -> std::future<typename std::invoke_result<F, Args...>::type>;
+
   ///  destructor joins all threads.
   ~ThreadPool();
 
  private:
+  // a per-worker deque; the owner pops from the front, thieves steal from
+  // the back
+  struct WorkerQueue {
+    std::deque<std::function<void()>> tasks;
+    std::mutex mutex;
+  };
+
+  void pushTask(Priority priority, std::function<void()> task);
+  bool popTask(size_t id, std::function<void()>& task);
+
   // need to keep track of threads so we can join them
   std::vector<std::thread> workers;
-  // the task queue
-  std::queue<std::function<void()>> tasks;
+  std::vector<std::unique_ptr<WorkerQueue>> queues;
+  // latency-critical tasks, drained before any per-worker work
+  std::deque<std::function<void()>> highTasks;
+  std::mutex high_mutex;
 
-  // synchronization
-  std::mutex queue_mutex;
+  // synchronization for idle workers; tasks outstanding across all queues
+  std::mutex sleep_mutex;
   std::condition_variable condition;
-  bool stop;
+  std::atomic<size_t> pending{0};
+  std::atomic<size_t> nextQueue{0};
+  std::atomic<bool> stop{false};
 }; // namespace flclassThreadPool
 
 inline ThreadPool::ThreadPool(
     size_t threads,
-    const std::function<void(size_t)>& initFn /* = nullptr */)
-    : stop(false) {
+    const std::function<void(size_t)>& initFn /* = nullptr */) {
+  queues.reserve(threads);
+  for (size_t id = 0; id < threads; ++id) {
+    queues.emplace_back(std::make_unique<WorkerQueue>());
+  }
   for (size_t id = 0; id < threads; ++id)
     workers.emplace_back([this, initFn, id] {
       if (initFn) {
@@ -84,46 +132,101 @@ inline ThreadPool::ThreadPool(
       for (;;) {
         std::function<void()> task;
 
-        {
-          std::unique_lock<std::mutex> lock(this->queue_mutex);
-          this->condition.wait(
-              lock, [this] { return this->stop || !this->tasks.empty(); });
-          if (this->stop && this->tasks.empty())
-            return;
-          task = std::move(this->tasks.front());
-          this->tasks.pop();
+        if (popTask(id, task)) {
+          // pending counts queued-but-unclaimed tasks, so decrement on claim
+          pending--;
+          task();
+          continue;
         }
 
-        task();
+        std::unique_lock<std::mutex> lock(this->sleep_mutex);
+        this->condition.wait(
+            lock, [this] { return this->stop || this->pending > 0; });
+        if (this->stop && this->pending == 0)
+          return;
       }
     });
 }
 
+inline void ThreadPool::pushTask(
+    Priority priority,
+    std::function<void()> task) {
+  // don't allow enqueueing after stopping the pool
+  if (stop)
+    throw std::runtime_error("enqueue on stopped ThreadPool");
+
+  if (priority == Priority::kHigh) {
+    std::unique_lock<std::mutex> lock(high_mutex);
+    highTasks.emplace_back(std::move(task));
+  } else {
+    // round-robin bulk tasks over the per-worker deques
+    auto& queue = *queues[nextQueue++ % queues.size()];
+    std::unique_lock<std::mutex> lock(queue.mutex);
+    queue.tasks.emplace_back(std::move(task));
+  }
+  pending++;
+  // taking the sleep lock orders this notify with the idle workers'
+  // predicate checks so the wakeup cannot be missed
+  { std::unique_lock<std::mutex> lock(sleep_mutex); }
+  condition.notify_one();
+}
+
+inline bool ThreadPool::popTask(size_t id, std::function<void()>& task) {
+  // latency-critical work first
+  {
+    std::unique_lock<std::mutex> lock(high_mutex);
+    if (!highTasks.empty()) {
+      task = std::move(highTasks.front());
+      highTasks.pop_front();
+      return true;
+    }
+  }
+  // own deque next
+  {
+    auto& queue = *queues[id];
+    std::unique_lock<std::mutex> lock(queue.mutex);
+    if (!queue.tasks.empty()) {
+      task = std::move(queue.tasks.front());
+      queue.tasks.pop_front();
+      return true;
+    }
+  }
+  // finally steal from the back of another worker's deque
+  for (size_t i = 1; i < queues.size(); ++i) {
+    auto& victim = *queues[(id + i) % queues.size()];
+    std::unique_lock<std::mutex> lock(victim.mutex);
+    if (!victim.tasks.empty()) {
+      task = std::move(victim.tasks.back());
+      victim.tasks.pop_back();
+      return true;
+    }
+  }
+  return false;
+}
+
 template <class F, class... Args>
 auto ThreadPool::enqueue(F&& f, Args&&... args)
     -> std::future<typename std::invoke_result<F, Args...>::type> {
+  return enqueue(
+      Priority::kNormal, std::forward<F>(f), std::forward<Args>(args)...);
+}
+
+template <class F, class... Args>
+auto ThreadPool::enqueue(Priority priority, F&& f, Args&&... args)
+    -> std::future<typename std::invoke_result<F, Args...>::type> {
   using return_type = typename std::invoke_result<F, Args...>::type;
 
   auto task = std::make_shared<std::packaged_task<return_type()>>(
       std::bind(std::forward<F>(f), std::forward<Args>(args)...));
 
   std::future<return_type> res = task->get_future();
-  {
-    std::unique_lock<std::mutex> lock(queue_mutex);
-
-    // don't allow enqueueing after stopping the pool
-    if (stop)
-      throw std::runtime_error("enqueue on stopped ThreadPool");
-
-    tasks.emplace([task]() { (*task)(); });
-  }
-  condition.notify_one();
+  pushTask(priority, [task]() { (*task)(); });
   return res;
 }
 
 inline ThreadPool::~ThreadPool() {
   {
-    std::unique_lock<std::mutex> lock(queue_mutex);
+    std::unique_lock<std::mutex> lock(sleep_mutex);
     stop = true;
   }
   condition.notify_all();
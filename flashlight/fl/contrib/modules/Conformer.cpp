@@ -7,11 +7,13 @@
 
 #include "flashlight/fl/contrib/modules/Conformer.h"
 
+#include <algorithm>
 #include <cmath>
 
 #include "flashlight/fl/autograd/Functions.h"
 #include "flashlight/fl/nn/Init.h"
 #include "flashlight/fl/nn/Utils.h"
+#include "flashlight/fl/tensor/Index.h"
 #include "flashlight/fl/tensor/Random.h"
 #include "flashlight/fl/tensor/TensorBase.h"
 
@@ -70,7 +72,10 @@ Conformer::Conformer(
           std::vector<int>({0}),
           1e-5,
           true,
-          modelDim)),
+          modelDim,
+          // the conv block always follows this norm with a swish - fuse it
+          // into the normalization epilogue
+          Epilogue::BIAS_SWISH)),
       norm3_(std::make_shared<LayerNorm>(
           std::vector<int>({0}),
           1e-5,
@@ -219,12 +224,136 @@ Variable Conformer::conv(const Variable& _input) {
   result = (*convDepthWise_)(result);
   result = reorder(result, {2, 0, 3, 1});
   // C x T x B x 1
-  result = fl::swish(((*normConv2_)(result)).astype(input.type()), 1.);
+  // normConv2_ applies the swish as a fused epilogue
+  result = ((*normConv2_)(result)).astype(input.type());
   // apply second pointwise conv
   result = dropout((*conv2_)(result), pDropout);
   return moddims(result, _input.shape());
 }
 
+Variable Conformer::mhsaChunk(
+    const Variable& input,
+    ConformerStreamingState& state) {
+  int n = input.dim(1), bsz = input.dim(2);
+
+  auto normedInput = (*normMhsa_)(input);
+  auto q = transpose((*wq_)(normedInput), {1, 0, 2});
+  auto kNew = transpose((*wk_)(normedInput), {1, 0, 2}).tensor();
+  auto vNew = transpose((*wv_)(normedInput), {1, 0, 2}).tensor();
+
+  Tensor keys = state.attnKeys.isEmpty()
+      ? kNew
+      : fl::concatenate(0, state.attnKeys, kNew);
+  Tensor values = state.attnValues.isEmpty()
+      ? vNew
+      : fl::concatenate(0, state.attnValues, vNew);
+  // number of carried context frames the chunk's queries attend over
+  const int offset = keys.dim(0) - n;
+
+  Variable posEmb;
+  if (posEmbContextSize_ > 0) {
+    posEmb = tile(params_[0].astype(input.type()), {1, 1, nHeads_ * bsz});
+  }
+  auto result = multiheadAttention(
+      q,
+      Variable(keys, false),
+      Variable(values, false),
+      posEmb,
+      Variable(),
+      Variable(),
+      nHeads_,
+      /* pDropout = */ 0.,
+      offset);
+  result = (*wf_)(transpose(result, {1, 0, 2}));
+
+  // retain at most the allowed left context for the next chunk
+  int maxContext = state.attnContextSize > 0
+      ? state.attnContextSize
+      : static_cast<int>(keys.dim(0));
+  if (posEmbContextSize_ > 0) {
+    maxContext = std::min(maxContext, posEmbContextSize_ - 1);
+  }
+  const int keep = std::min<int>(keys.dim(0), maxContext);
+  if (keep > 0) {
+    state.attnKeys = keys(fl::range(keys.dim(0) - keep, keys.dim(0)));
+    state.attnValues = values(fl::range(values.dim(0) - keep, values.dim(0)));
+  } else {
+    state.attnKeys = Tensor();
+    state.attnValues = Tensor();
+  }
+  return result;
+}
+
+Variable Conformer::convChunk(
+    const Variable& _input,
+    ConformerStreamingState& state) {
+  Shape s = _input.shape();
+  Variable input = moddims(_input, {s[0], s[1], s[2], 1});
+
+  // the pointwise conv and the GLU are frame-local; only the depthwise conv
+  // needs carried context
+  auto glu = gatedlinearunit(
+      (*conv1_)(((*normConv1_)(input)).astype(input.type())), 0);
+  // C x T x B x 1
+  Tensor withContext = state.convContext.isEmpty()
+      ? glu.tensor()
+      : fl::concatenate(1, state.convContext, glu.tensor());
+  const int contextLen = withContext.dim(1) - s[1];
+
+  // carry the depthwise conv's left context into the next chunk
+  const int pad = (convKernelSize_ - 1) / 2;
+  const int keep = std::min<int>(withContext.dim(1), pad);
+  state.convContext = keep > 0
+      ? withContext(
+            fl::span, fl::range(withContext.dim(1) - keep, withContext.dim(1)))
+      : Tensor();
+
+  auto result = reorder(Variable(withContext, false), {1, 3, 0, 2});
+  // T' x 1 x C x B
+  result = (*convDepthWise_)(result);
+  // drop the carried context positions from the output
+  result = result(fl::range(contextLen, contextLen + s[1]));
+  result = reorder(result, {2, 0, 3, 1});
+  // C x T x B x 1
+  // normConv2_ applies the swish as a fused epilogue
+  result = ((*normConv2_)(result)).astype(input.type());
+  // apply second pointwise conv
+  result = (*conv2_)(result);
+  return moddims(result, _input.shape());
+}
+
+Variable Conformer::forwardChunk(
+    const Variable& input,
+    ConformerStreamingState& state) {
+  if (input.ndim() != 3) {
+    throw std::invalid_argument(
+        "Conformer::forwardChunk - input should be of 3 dimensions "
+        "expects an input of size C x T x B - see documentation.");
+  }
+  if (state.attnContextSize < 0) {
+    throw std::invalid_argument(
+        "Conformer::forwardChunk - attnContextSize must be non-negative");
+  }
+  if (posEmbContextSize_ > 0 && input.dim(1) > posEmbContextSize_) {
+    throw std::invalid_argument(
+        "Conformer::forwardChunk - chunk length exceeds the relative "
+        "positional embedding context (posEmbContextSize)");
+  }
+
+  auto x = input;
+  // apply first feed-forward module
+  auto ffn1 = (*w12_)(fl::swish((*w11_)(((*norm1_)(x)).astype(x.type())), 1.));
+  x = x + 0.5 * ffn1;
+  // apply multihead attention module over the carried context and the chunk
+  x = x + mhsaChunk(x, state);
+  // apply conv module with the carried depthwise-conv left context
+  x = x + convChunk(x, state);
+  // apply second feed-forward module
+  auto ffn2 = (*w22_)(fl::swish((*w21_)(((*norm2_)(x)).astype(x.type())), 1.));
+  // residual add fused into the final normalization
+  return norm3_->forwardAdd(x, 0.5 * ffn2).astype(x.type());
+}
+
 std::vector<Variable> Conformer::forward(const std::vector<Variable>& input) {
   if (input.size() != 2) {
     throw std::invalid_argument(
@@ -256,12 +385,10 @@ std::vector<Variable> Conformer::forward(const std::vector<Variable>& input) {
   // apply conv module
   x = x + f * conv(x);
   // apply second feed-forward module
-  auto ffn2 = dropout(
-      (*w22_)(dropout(
-          fl::swish((*w21_)(((*norm2_)(x)).astype(x.type())), 1.), pDropout)),
-      pDropout);
-  x = x + f * 0.5 * ffn2;
-  x = ((*norm3_)(x)).astype(x.type());
+  auto ffn2 = (*w22_)(dropout(
+      fl::swish((*w21_)(((*norm2_)(x)).astype(x.type())), 1.), pDropout));
+  // the output dropout, residual add and final norm run as one fused op
+  x = norm3_->forwardAdd(x, f * 0.5 * ffn2, pDropout).astype(x.type());
   return {x};
 }
 
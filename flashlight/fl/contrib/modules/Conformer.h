@@ -15,6 +15,24 @@
 
 namespace fl {
 
+/**
+ * Per-block carried context for chunked streaming inference with
+ * `Conformer::forwardChunk`. `attnKeys` and `attnValues` hold the
+ * self-attention key/value projections of the carried left context,
+ * transposed to T x (headDim * nHeads) x B; `convContext` holds the last
+ * (convKernelSize - 1) / 2 frames of the depthwise convolution's input
+ * (C x P x B). `attnContextSize` bounds the attention left context in
+ * frames; 0 keeps every frame seen so far. With relative positional
+ * embeddings the bound is additionally clamped to posEmbContextSize - 1,
+ * the largest history the embedding matrix can represent.
+ */
+struct FL_API ConformerStreamingState {
+  Tensor attnKeys;
+  Tensor attnValues;
+  Tensor convContext;
+  int attnContextSize{0};
+};
+
 /**
  * A module which implements a Conformer block (we use LayerNorm everywhere).
  *
@@ -51,6 +69,24 @@ class FL_API Conformer : public Container {
   Conformer& operator=(Conformer&& other) = default;
 
   std::vector<Variable> forward(const std::vector<Variable>& input) override;
+
+  /**
+   * Computes one streaming chunk at O(chunk) cost. `input` holds only the
+   * new frames (C x T x B, unpadded); the attention attends over the carried
+   * left context plus the chunk, with the key/value projections of previous
+   * chunks read from `state` instead of being recomputed, and the depthwise
+   * convolution sees the carried (convKernelSize - 1) / 2 frames of real
+   * left context. The chunk's output is exact with respect to a full
+   * forward over [context, chunk] except for the trailing
+   * (convKernelSize - 1) / 2 frames, which see zeros in place of future
+   * frames -- the usual zero-lookahead streaming behavior, identical to an
+   * utterance ending at the chunk boundary. The carried tensors hold no
+   * gradient and layer drop is inactive -- this is an inference-only path.
+   * With relative positional embeddings the chunk length must not exceed
+   * posEmbContextSize.
+   */
+  Variable forwardChunk(const Variable& input, ConformerStreamingState& state);
+
   std::unique_ptr<Module> clone() const override;
   std::string prettyString() const override;
 
@@ -72,6 +108,10 @@ class FL_API Conformer : public Container {
   static Variable conformerInitLinear(int32_t inDim, int32_t outDim);
   Variable mhsa(const Variable& input, const Variable& inputPadMask);
   Variable conv(const Variable& input);
+  // streaming counterparts of mhsa/conv, reading and updating the carried
+  // context
+  Variable mhsaChunk(const Variable& input, ConformerStreamingState& state);
+  Variable convChunk(const Variable& input, ConformerStreamingState& state);
 
   Conformer() = default;
 
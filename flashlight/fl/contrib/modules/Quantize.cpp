@@ -0,0 +1,196 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "flashlight/fl/contrib/modules/Quantize.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <tuple>
+
+#include "flashlight/fl/autograd/Functions.h"
+#include "flashlight/fl/nn/Utils.h"
+
+namespace fl {
+
+namespace {
+
+// tile repetitions expanding per-channel scales to the weight's shape
+Shape scaleTileDims(const Shape& weightShape, int channelAxis) {
+  std::vector<Dim> reps(weightShape.ndim());
+  for (int axis = 0; axis < weightShape.ndim(); ++axis) {
+    reps[axis] = axis == channelAxis ? 1 : weightShape.dim(axis);
+  }
+  return Shape(reps);
+}
+
+} // namespace
+
+std::pair<Tensor, Tensor> quantizePerChannelInt8(
+    const Tensor& weight,
+    int channelAxis) {
+  if (channelAxis < 0 || channelAxis >= weight.ndim()) {
+    throw std::invalid_argument(
+        "quantizePerChannelInt8 - channelAxis out of range");
+  }
+  std::vector<int> reduceAxes;
+  for (int axis = 0; axis < weight.ndim(); ++axis) {
+    if (axis != channelAxis) {
+      reduceAxes.push_back(axis);
+    }
+  }
+  auto absMax =
+      fl::amax(fl::abs(weight), reduceAxes, /* keepDims = */ true);
+  auto scales =
+      fl::maximum(absMax.astype(fl::dtype::f32), 1e-10) / 127.;
+  auto scaled = weight.astype(fl::dtype::f32) /
+      fl::tile(scales, scaleTileDims(weight.shape(), channelAxis));
+  auto quantized = fl::clip(fl::rint(scaled), -127., 127.) + 128.;
+  return {quantized.astype(fl::dtype::u8), scales};
+}
+
+Tensor dequantizePerChannelInt8(
+    const Tensor& quantized,
+    const Tensor& scales,
+    int channelAxis) {
+  return (quantized.astype(fl::dtype::f32) - 128.) *
+      fl::tile(scales, scaleTileDims(quantized.shape(), channelAxis));
+}
+
+Tensor detail::fakeQuantizeInt8(const Tensor& tensor, float absMax) {
+  const double scale = static_cast<double>(absMax) / 127.;
+  return (fl::clip(fl::rint(tensor / scale), -127., 127.) * scale)
+      .astype(tensor.type());
+}
+
+Variable ActivationObserver::forward(const Variable& input) {
+  absMax_ = std::max(
+      absMax_, fl::amax(fl::abs(input.tensor())).asScalar<double>());
+  return input;
+}
+
+double ActivationObserver::absMax() const {
+  return absMax_;
+}
+
+void ActivationObserver::reset() {
+  absMax_ = 0.;
+}
+
+std::unique_ptr<Module> ActivationObserver::clone() const {
+  return std::make_unique<ActivationObserver>(*this);
+}
+
+std::string ActivationObserver::prettyString() const {
+  std::ostringstream ss;
+  ss << "ActivationObserver ( absMax : " << absMax_ << " )";
+  return ss.str();
+}
+
+QuantizedLinear::QuantizedLinear(
+    const Linear& linear,
+    float inputAbsMax /* = 0.f */)
+    : Linear(linear), inputAbsMax_(inputAbsMax) {
+  if (params_.empty() || params_[0].isEmpty()) {
+    throw std::invalid_argument(
+        "QuantizedLinear - the given Linear has no weight");
+  }
+  std::tie(quantizedWeight_, weightScales_) =
+      quantizePerChannelInt8(params_[0].tensor(), /* channelAxis = */ 0);
+  // drop the f32 weight payload; forward rebuilds it from the int8 store
+  params_[0] = Variable();
+}
+
+Variable QuantizedLinear::forward(const Variable& input) {
+  auto weight = Variable(
+      dequantizePerChannelInt8(
+          quantizedWeight_, weightScales_, /* channelAxis = */ 0)
+          .astype(input.type()),
+      false);
+  Variable in = input;
+  if (inputAbsMax_ > 0.f) {
+    in = Variable(detail::fakeQuantizeInt8(input.tensor(), inputAbsMax_), false);
+  }
+  if (params_.size() > 1 && !params_[1].isEmpty()) {
+    return linear(in, weight, params_[1].astype(input.type()));
+  }
+  return linear(in, weight);
+}
+
+std::unique_ptr<Module> QuantizedLinear::clone() const {
+  return std::make_unique<QuantizedLinear>(*this);
+}
+
+std::string QuantizedLinear::prettyString() const {
+  return "Quantized(int8) " + Linear::prettyString();
+}
+
+QuantizedConv2D::QuantizedConv2D(
+    const Conv2D& conv,
+    float inputAbsMax /* = 0.f */)
+    : Conv2D(conv), inputAbsMax_(inputAbsMax) {
+  if (params_.empty() || params_[0].isEmpty()) {
+    throw std::invalid_argument(
+        "QuantizedConv2D - the given Conv2D has no weight");
+  }
+  // filters are [wx, wy, nIn / groups, nOut]; quantize per output channel
+  std::tie(quantizedWeight_, weightScales_) =
+      quantizePerChannelInt8(params_[0].tensor(), /* channelAxis = */ 3);
+  params_[0] = Variable();
+}
+
+Variable QuantizedConv2D::forward(const Variable& input) {
+  auto px = derivePadding(input.dim(0), xFilter_, xStride_, xPad_, xDilation_);
+  auto py = derivePadding(input.dim(1), yFilter_, yStride_, yPad_, yDilation_);
+  if (!(px >= 0 && py >= 0)) {
+    throw std::invalid_argument("invalid padding for QuantizedConv2D");
+  }
+
+  auto weight = Variable(
+      dequantizePerChannelInt8(
+          quantizedWeight_, weightScales_, /* channelAxis = */ 3)
+          .astype(input.type()),
+      false);
+  Variable in = input;
+  if (inputAbsMax_ > 0.f) {
+    in = Variable(detail::fakeQuantizeInt8(input.tensor(), inputAbsMax_), false);
+  }
+  if (bias_) {
+    return conv2d(
+        in,
+        weight,
+        params_[1].astype(input.type()),
+        xStride_,
+        yStride_,
+        px,
+        py,
+        xDilation_,
+        yDilation_,
+        groups_,
+        benchmarks_);
+  }
+  return conv2d(
+      in,
+      weight,
+      xStride_,
+      yStride_,
+      px,
+      py,
+      xDilation_,
+      yDilation_,
+      groups_,
+      benchmarks_);
+}
+
+std::unique_ptr<Module> QuantizedConv2D::clone() const {
+  return std::make_unique<QuantizedConv2D>(*this);
+}
+
+std::string QuantizedConv2D::prettyString() const {
+  return "Quantized(int8) " + Conv2D::prettyString();
+}
+
+} // namespace fl
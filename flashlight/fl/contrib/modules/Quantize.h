@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <utility>
+
+#include "flashlight/fl/nn/modules/Conv2D.h"
+#include "flashlight/fl/nn/modules/Linear.h"
+#include "flashlight/fl/nn/modules/Module.h"
+
+namespace fl {
+
+/**
+ * Quantize a weight tensor to int8 with symmetric per-channel scales.
+ * Each channel (slice along `channelAxis`) is mapped to [-127, 127] by its
+ * own scale `absMax / 127`.
+ *
+ * @param[in] weight the weight tensor to quantize
+ * @param[in] channelAxis the axis holding output channels
+ * @return the quantized values, stored as u8 with a fixed zero point of 128
+ * (4x smaller than f32), and the per-channel f32 scales shaped for tiling
+ * (singleton on every axis but `channelAxis`).
+ */
+FL_API std::pair<Tensor, Tensor> quantizePerChannelInt8(
+    const Tensor& weight,
+    int channelAxis);
+
+/**
+ * Reconstruct an f32 weight tensor from `quantizePerChannelInt8` output.
+ */
+FL_API Tensor dequantizePerChannelInt8(
+    const Tensor& quantized,
+    const Tensor& scales,
+    int channelAxis);
+
+/**
+ * An identity module that records the largest absolute activation value that
+ * flows through it — the calibration "hook" for post-training quantization.
+ * Insert observers into a copy of the model (e.g. between the layers of a
+ * `Sequential`), run representative batches, and pass `absMax()` to the
+ * quantized modules so activations can be quantized with a matching range.
+ */
+class FL_API ActivationObserver : public UnaryModule {
+  double absMax_{0.};
+
+  FL_SAVE_LOAD_WITH_BASE(UnaryModule, absMax_)
+
+ public:
+  ActivationObserver() = default;
+
+  Variable forward(const Variable& input) override;
+
+  /**
+   * The largest absolute value observed since construction or `reset`.
+   */
+  double absMax() const;
+
+  void reset();
+
+  std::unique_ptr<Module> clone() const override;
+
+  std::string prettyString() const override;
+};
+
+/**
+ * A `Linear` whose weight is stored int8-quantized with per-output-channel
+ * scales (see `quantizePerChannelInt8`), built post-training from an f32
+ * `Linear`. The weight is dequantized on the fly, so compute runs at f32 and
+ * outputs are f32; given a calibrated `inputAbsMax` the input is additionally
+ * round-tripped through the int8 grid, making the output match what a full
+ * int8 kernel would produce. Inference only — the forward pass does not
+ * build a gradient graph for the weight.
+ */
+class FL_API QuantizedLinear : public Linear {
+  Tensor quantizedWeight_; // u8, zero point 128
+  Tensor weightScales_; // f32, per output channel
+  float inputAbsMax_{0.f};
+
+  // for serialization; the base state is overwritten on load
+  QuantizedLinear() : Linear(1, 1, /* bias = */ false) {}
+
+  FL_SAVE_LOAD_WITH_BASE(
+      Linear,
+      quantizedWeight_,
+      weightScales_,
+      inputAbsMax_)
+
+ public:
+  /**
+   * @param[in] linear the trained f32 module to quantize
+   * @param[in] inputAbsMax calibrated activation range for the input (e.g.
+   * from an `ActivationObserver`); 0 leaves activations unquantized
+   */
+  explicit QuantizedLinear(const Linear& linear, float inputAbsMax = 0.f);
+
+  Variable forward(const Variable& input) override;
+
+  std::unique_ptr<Module> clone() const override;
+
+  std::string prettyString() const override;
+};
+
+/**
+ * A `Conv2D` whose filters are stored int8-quantized with per-output-channel
+ * scales, built post-training from an f32 `Conv2D`; see `QuantizedLinear`
+ * for the quantization scheme and calibration. Inference only.
+ */
+class FL_API QuantizedConv2D : public Conv2D {
+  Tensor quantizedWeight_; // u8, zero point 128
+  Tensor weightScales_; // f32, per output channel
+  float inputAbsMax_{0.f};
+
+  QuantizedConv2D() = default; // for serialization
+
+  FL_SAVE_LOAD_WITH_BASE(
+      Conv2D,
+      quantizedWeight_,
+      weightScales_,
+      inputAbsMax_)
+
+ public:
+  /**
+   * @param[in] conv the trained f32 module to quantize
+   * @param[in] inputAbsMax calibrated activation range for the input; 0
+   * leaves activations unquantized
+   */
+  explicit QuantizedConv2D(const Conv2D& conv, float inputAbsMax = 0.f);
+
+  Variable forward(const Variable& input) override;
+
+  std::unique_ptr<Module> clone() const override;
+
+  std::string prettyString() const override;
+};
+
+namespace detail {
+
+/**
+ * Round-trip a tensor through the symmetric int8 grid for the given range.
+ */
+Tensor fakeQuantizeInt8(const Tensor& tensor, float absMax);
+
+} // namespace detail
+
+} // namespace fl
+
+CEREAL_REGISTER_TYPE(fl::ActivationObserver)
+CEREAL_REGISTER_TYPE(fl::QuantizedLinear)
+CEREAL_REGISTER_TYPE(fl::QuantizedConv2D)
@@ -16,6 +16,15 @@ std::unordered_set<int> Residual::getProjectionsIndices() const {
   return projectionsIndices_;
 }
 
+std::unordered_map<int, std::unordered_map<int, int>> Residual::getShortcuts()
+    const {
+  return shortcut_;
+}
+
+std::unordered_map<int, float> Residual::getScales() const {
+  return scales_;
+}
+
 void Residual::addScale(int beforeLayer, float scale) {
   int nLayers = modules_.size() - projectionsIndices_.size();
   if (beforeLayer < 1 || beforeLayer > nLayers + 1) {
@@ -70,6 +70,20 @@ class FL_API Residual : public Container {
 
   std::unordered_set<int> getProjectionsIndices() const;
 
+  /**
+   * Returns the skip connections as a map from destination layer index to
+   * {source layer index -> projection module index}, where a projection
+   * module index of -1 denotes an identity connection. Together with
+   * `getProjectionsIndices`, this exposes the branch structure of the block
+   * to external schedulers.
+   */
+  std::unordered_map<int, std::unordered_map<int, int>> getShortcuts() const;
+
+  /**
+   * Returns the scale factors applied before layers, keyed by layer index.
+   */
+  std::unordered_map<int, float> getScales() const;
+
   /**
    * Adds a scaling factor to all residual connections connecting to a layer
    * given by some index index. Given some scale \f$ \alpha \f$, the input to
@@ -15,6 +15,7 @@
 #include "flashlight/fl/autograd/Functions.h"
 #include "flashlight/fl/nn/Init.h"
 #include "flashlight/fl/nn/Utils.h"
+#include "flashlight/fl/tensor/Index.h"
 
 namespace fl {
 
@@ -66,19 +67,29 @@ std::vector<Variable> SinusoidalPositionEmbedding::forward(
   // point precision).
   const int nPositions = input[0].dim(1);
   const auto numType = input[0].type();
-  // Generate the tensor of positions for each token vector [embedding size, num
-  // positions].
-  //  positions = [[ 0,  0, ..],
-  //               [ 1,  1, ..],
-  //               [.., .., ..]]
-  Tensor positions = fl::iota({1, nPositions}, {layerDim_}, numType);
-  // Generate the embedding transformation with the precomputed scale and shift
-  // factors.
-  positions = fl::sin(
-      positions * fl::tile(scale_.astype(numType), {1, nPositions}) +
-      fl::tile(cosShifts_.astype(numType), {1, nPositions}));
+  // The embeddings depend only on position, so they are computed once into a
+  // device-resident table (grown geometrically when longer sequences show up)
+  // and sliced on later calls instead of recomputed per layer invocation.
+  if (embeddings_.isEmpty() || embeddings_.dim(1) < nPositions ||
+      embeddings_.type() != numType) {
+    const int nCached = embeddings_.isEmpty() || embeddings_.type() != numType
+        ? nPositions
+        : std::max<int>(nPositions, 2 * embeddings_.dim(1));
+    // Generate the tensor of positions for each token vector [embedding size,
+    // num positions].
+    //  positions = [[ 0,  0, ..],
+    //               [ 1,  1, ..],
+    //               [.., .., ..]]
+    Tensor positions = fl::iota({1, nCached}, {layerDim_}, numType);
+    // Generate the embedding transformation with the precomputed scale and
+    // shift factors.
+    embeddings_ = fl::sin(
+        positions * fl::tile(scale_.astype(numType), {1, nCached}) +
+        fl::tile(cosShifts_.astype(numType), {1, nCached}));
+  }
   // Convert the positional embedding into a variable (for gradient tracking).
-  Variable embeddingsPos = Variable(positions, false);
+  Variable embeddingsPos =
+      Variable(embeddings_(fl::span, fl::range(0, nPositions)), false);
   // Return the inputs with the positional embeddings tiled over the batch
   // dimension.
   return {input[0] * inputScale_ + tileAs(embeddingsPos, input[0])};
@@ -65,6 +65,9 @@ class FL_API SinusoidalPositionEmbedding : public Module {
   double inputScale_;
   Tensor scale_;
   Tensor cosShifts_;
+  // lazily-built table of embeddings for the positions seen so far; derived
+  // from `scale_`/`cosShifts_`, so neither copied nor serialized
+  Tensor embeddings_;
 
   SinusoidalPositionEmbedding();
 };
@@ -0,0 +1,206 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "flashlight/fl/contrib/modules/Sparse.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include "flashlight/fl/autograd/Functions.h"
+#include "flashlight/fl/tensor/Index.h"
+
+namespace fl {
+
+Tensor pruneMaskNM(const Tensor& weight, int n, int m) {
+  if (weight.ndim() != 2) {
+    throw std::invalid_argument("pruneMaskNM - weight must be 2D");
+  }
+  if (n <= 0 || m <= 0 || n > m) {
+    throw std::invalid_argument("pruneMaskNM - need 0 < n <= m");
+  }
+  if (weight.dim(1) % m != 0) {
+    throw std::invalid_argument(
+        "pruneMaskNM - the input dimension is not divisible by m");
+  }
+  // view as [output_size, m, input_size / m] so each group of m consecutive
+  // input weights sits along axis 1, then threshold at the n-th magnitude
+  auto absWeight = fl::reshape(
+      fl::abs(weight.astype(fl::dtype::f32)),
+      {weight.dim(0), m, weight.dim(1) / m});
+  auto sorted = fl::sort(absWeight, 1, SortMode::Descending);
+  auto cutoff = sorted(fl::span, fl::range(n - 1, n), fl::span);
+  auto mask = absWeight >= fl::tile(cutoff, {1, m, 1});
+  return fl::reshape(mask, weight.shape());
+}
+
+Tensor pruneMaskBlock(
+    const Tensor& weight,
+    int blockRows,
+    int blockCols,
+    float sparsity) {
+  if (weight.ndim() != 2) {
+    throw std::invalid_argument("pruneMaskBlock - weight must be 2D");
+  }
+  if (blockRows <= 0 || blockCols <= 0 || weight.dim(0) % blockRows != 0 ||
+      weight.dim(1) % blockCols != 0) {
+    throw std::invalid_argument(
+        "pruneMaskBlock - block dims must divide the weight dims");
+  }
+  if (sparsity < 0.f || sparsity > 1.f) {
+    throw std::invalid_argument("pruneMaskBlock - sparsity must be in [0, 1]");
+  }
+  const Dim numBlockRows = weight.dim(0) / blockRows;
+  const Dim numBlockCols = weight.dim(1) / blockCols;
+  // view as [blockRows, numBlockRows, blockCols, numBlockCols] so each block
+  // is a slice over axes {0, 2}; score blocks by L1 norm
+  auto blocks = fl::reshape(
+      fl::abs(weight.astype(fl::dtype::f32)),
+      {blockRows, numBlockRows, blockCols, numBlockCols});
+  auto scores = fl::sum(blocks, {0, 2}, /* keepDims = */ true);
+
+  const int numBlocks = static_cast<int>(numBlockRows * numBlockCols);
+  int numPrune = static_cast<int>(std::lround(sparsity * numBlocks));
+  numPrune = std::max(0, std::min(numPrune, numBlocks));
+  Tensor keep;
+  if (numPrune == 0) {
+    keep = fl::full(scores.shape(), 1).astype(fl::dtype::b8);
+  } else {
+    auto sortedScores =
+        fl::sort(scores.flatten(), 0, SortMode::Ascending);
+    auto cutoff = sortedScores(numPrune - 1).asScalar<float>();
+    keep = scores > cutoff;
+  }
+  auto mask = fl::tile(keep, {blockRows, 1, blockCols, 1});
+  return fl::reshape(mask, weight.shape());
+}
+
+SparseLinear::SparseLinear(
+    const Linear& linear,
+    const Tensor& mask,
+    int blockRows /* = 1 */,
+    int blockCols /* = 1 */)
+    : Linear(linear), blockRows_(blockRows), blockCols_(blockCols) {
+  if (params_.empty() || params_[0].isEmpty()) {
+    throw std::invalid_argument(
+        "SparseLinear - the given Linear has no weight");
+  }
+  const auto& weight = params_[0].tensor();
+  weightRows_ = weight.dim(0);
+  weightCols_ = weight.dim(1);
+  if (mask.shape() != weight.shape()) {
+    throw std::invalid_argument(
+        "SparseLinear - mask shape does not match the weight shape");
+  }
+  if (blockRows <= 0 || blockCols <= 0 || weightRows_ % blockRows != 0 ||
+      weightCols_ % blockCols != 0) {
+    throw std::invalid_argument(
+        "SparseLinear - block dims must divide the weight dims");
+  }
+  const Dim numBlockRows = weightRows_ / blockRows;
+  const Dim numBlockCols = weightCols_ / blockCols;
+
+  auto pruned = weight.astype(fl::dtype::f32) * mask.astype(fl::dtype::f32);
+  // per-block survivor counts; a block is dropped only when fully masked
+  auto counts = fl::sum(
+                    fl::reshape(
+                        mask.astype(fl::dtype::s32),
+                        {blockRows, numBlockRows, blockCols, numBlockCols}),
+                    {0, 2})
+                    .astype(fl::dtype::s32)
+                    .toHostVector<int>();
+  auto weightHost = pruned.toHostVector<float>(); // column major
+
+  std::vector<float> values;
+  for (Dim c = 0; c < numBlockCols; ++c) {
+    for (Dim r = 0; r < numBlockRows; ++r) {
+      if (counts[r + c * numBlockRows] == 0) {
+        continue;
+      }
+      blockRowIdx_.push_back(static_cast<int>(r));
+      blockColIdx_.push_back(static_cast<int>(c));
+      for (Dim cc = 0; cc < blockCols; ++cc) {
+        for (Dim rr = 0; rr < blockRows; ++rr) {
+          values.push_back(weightHost
+              [(r * blockRows + rr) + (c * blockCols + cc) * weightRows_]);
+        }
+      }
+    }
+  }
+  if (!values.empty()) {
+    blockValues_ = Tensor::fromBuffer(
+        {blockRows,
+         blockCols,
+         static_cast<Dim>(blockRowIdx_.size())},
+        values.data(),
+        Location::Host);
+  }
+  // drop the dense f32 weight payload; forward rebuilds it from the blocks
+  params_[0] = Variable();
+}
+
+SparseLinear::SparseLinear(
+    const Linear& linear,
+    float sparsity,
+    int blockRows,
+    int blockCols)
+    : SparseLinear(
+          linear,
+          pruneMaskBlock(
+              linear.param(0).tensor(),
+              blockRows,
+              blockCols,
+              sparsity),
+          blockRows,
+          blockCols) {}
+
+int SparseLinear::numNonzeroBlocks() const {
+  return static_cast<int>(blockRowIdx_.size());
+}
+
+int SparseLinear::numBlocks() const {
+  return static_cast<int>(
+      (weightRows_ / blockRows_) * (weightCols_ / blockCols_));
+}
+
+Variable SparseLinear::forward(const Variable& input) {
+  if (denseWeight_.isEmpty()) {
+    denseWeight_ =
+        fl::full({weightRows_, weightCols_}, 0.f, fl::dtype::f32);
+    for (size_t k = 0; k < blockRowIdx_.size(); ++k) {
+      denseWeight_(
+          fl::range(
+              blockRowIdx_[k] * blockRows_,
+              (blockRowIdx_[k] + 1) * blockRows_),
+          fl::range(
+              blockColIdx_[k] * blockCols_,
+              (blockColIdx_[k] + 1) * blockCols_)) =
+          fl::reshape(
+              blockValues_(fl::span, fl::span, fl::range(k, k + 1)),
+              {blockRows_, blockCols_});
+    }
+  }
+  auto weight = Variable(denseWeight_.astype(input.type()), false);
+  if (params_.size() > 1 && !params_[1].isEmpty()) {
+    return linear(input, weight, params_[1].astype(input.type()));
+  }
+  return linear(input, weight);
+}
+
+std::unique_ptr<Module> SparseLinear::clone() const {
+  return std::make_unique<SparseLinear>(*this);
+}
+
+std::string SparseLinear::prettyString() const {
+  std::ostringstream ss;
+  ss << "Sparse (" << blockRows_ << "x" << blockCols_ << " blocks, "
+     << numNonzeroBlocks() << "/" << numBlocks() << " kept) "
+     << Linear::prettyString();
+  return ss.str();
+}
+
+} // namespace fl
@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "flashlight/fl/nn/modules/Linear.h"
+#include "flashlight/fl/nn/modules/Module.h"
+
+namespace fl {
+
+/**
+ * Compute an N:M structured pruning mask for a 2D weight tensor of shape
+ * [`output_size`, `input_size`]: in every group of `m` consecutive weights
+ * along the input axis, the `n` largest-magnitude entries are kept. Ties at
+ * the cutoff magnitude are kept, so a group may retain more than `n` entries.
+ *
+ * Apply the mask by elementwise multiplication; reapply it after each
+ * optimizer step to keep the pattern during prune-finetuning.
+ *
+ * @param[in] weight the 2D weight tensor to rank
+ * @param[in] n the number of survivors per group
+ * @param[in] m the group size; must divide `input_size`
+ * @return a b8 mask with the shape of `weight` (1 = keep)
+ */
+FL_API Tensor pruneMaskNM(const Tensor& weight, int n, int m);
+
+/**
+ * Compute a block-structured pruning mask for a 2D weight tensor of shape
+ * [`output_size`, `input_size`]: the tensor is partitioned into
+ * `blockRows` x `blockCols` blocks, blocks are ranked by their L1 norm, and
+ * the smallest fraction `sparsity` of blocks is zeroed (ties at the cutoff
+ * are pruned, so the realized sparsity is at least the requested one).
+ *
+ * @param[in] weight the 2D weight tensor to rank
+ * @param[in] blockRows block height; must divide `output_size`
+ * @param[in] blockCols block width; must divide `input_size`
+ * @param[in] sparsity the fraction of blocks to prune, in [0, 1]
+ * @return a b8 mask with the shape of `weight` (1 = keep)
+ */
+FL_API Tensor pruneMaskBlock(
+    const Tensor& weight,
+    int blockRows,
+    int blockCols,
+    float sparsity);
+
+/**
+ * A `Linear` whose weight is stored block-compressed: only the blocks that
+ * survive pruning are kept (values plus block coordinates), shrinking storage
+ * and serialized size in proportion to the block sparsity. Built
+ * post-training from an f32 `Linear` and a pruning mask (see `pruneMaskNM`
+ * and `pruneMaskBlock`); only blocks that the mask zeroes entirely are
+ * dropped, so block-structured masks compress best.
+ *
+ * The matmul itself still runs dense: the weight is reassembled once, lazily,
+ * on first forward, since the tensor backends expose no sparse primitives
+ * the compressed blocks could be fed to directly. Inference only — the
+ * forward pass does not build a gradient graph for the weight.
+ */
+class FL_API SparseLinear : public Linear {
+  std::vector<int> blockRowIdx_, blockColIdx_; // coordinates of kept blocks
+  Tensor blockValues_; // f32, [blockRows, blockCols, numNonzeroBlocks]
+  int blockRows_{1}, blockCols_{1};
+  Dim weightRows_{0}, weightCols_{0};
+  Tensor denseWeight_; // rebuilt lazily; not serialized
+
+  // for serialization; the base state is overwritten on load
+  SparseLinear() : Linear(1, 1, /* bias = */ false) {}
+
+  FL_SAVE_LOAD_WITH_BASE(
+      Linear,
+      blockRowIdx_,
+      blockColIdx_,
+      blockValues_,
+      blockRows_,
+      blockCols_,
+      weightRows_,
+      weightCols_)
+
+ public:
+  /**
+   * @param[in] linear the trained f32 module to prune
+   * @param[in] mask a b8/float keep-mask with the weight's shape
+   * @param[in] blockRows storage block height; must divide `output_size`
+   * @param[in] blockCols storage block width; must divide `input_size`
+   */
+  SparseLinear(
+      const Linear& linear,
+      const Tensor& mask,
+      int blockRows = 1,
+      int blockCols = 1);
+
+  /**
+   * Prunes with `pruneMaskBlock` at the given sparsity, then compresses.
+   */
+  SparseLinear(
+      const Linear& linear,
+      float sparsity,
+      int blockRows,
+      int blockCols);
+
+  /**
+   * The number of stored (surviving) blocks.
+   */
+  int numNonzeroBlocks() const;
+
+  /**
+   * The total number of blocks in the dense weight.
+   */
+  int numBlocks() const;
+
+  Variable forward(const Variable& input) override;
+
+  std::unique_ptr<Module> clone() const override;
+
+  std::string prettyString() const override;
+};
+
+} // namespace fl
+
+CEREAL_REGISTER_TYPE(fl::SparseLinear)
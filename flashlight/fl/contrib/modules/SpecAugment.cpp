@@ -10,7 +10,7 @@
 
 #include "flashlight/fl/contrib/modules/SpecAugment.h"
 
-#include "flashlight/fl/tensor/Index.h"
+#include "flashlight/fl/tensor/Random.h"
 
 namespace fl {
 
@@ -53,37 +53,62 @@ Variable SpecAugment::forward(const Variable& input) {
 
   auto& opArr = output.tensor();
 
-  double replaceVal = (maskStrategy_ == MaskingStrategy::GLOBAL_MEAN)
-      ? fl::mean(input.tensor()).asScalar<double>()
-      : 0.0;
-
+  auto numTimeSteps = input.dim(0); // number of time steps
   auto numFreqChans = input.dim(1); // number of frequency channels
   if (numFreqChans < freqMaskF_) {
     throw std::runtime_error("Invalid input frequency channels");
   }
-  for (int i = 0; i < numFreqMask_; ++i) {
-    auto f = generateRandomInt(0, freqMaskF_);
-    auto f0 = generateRandomInt(0, numFreqChans - f);
-    opArr(fl::span, fl::range(f0, f0 + f + 1)) = replaceVal;
+
+  // Mask boundaries are drawn with the device RNG and combined into a single
+  // masking op over the whole batch, so the augmentation appends to the
+  // computation graph without any host round trip.
+  Tensor mask; // 1 where the input is masked out
+  if (numFreqMask_ > 0) {
+    auto f = fl::floor(fl::rand({numFreqMask_}) * freqMaskF_);
+    auto f0 = fl::floor(fl::rand({numFreqMask_}) * (numFreqChans - f));
+    auto chanIdx = fl::tile(fl::iota({numFreqChans, 1}), {1, numFreqMask_});
+    f = fl::tile(fl::reshape(f, {1, numFreqMask_}), {numFreqChans, 1});
+    f0 = fl::tile(fl::reshape(f0, {1, numFreqMask_}), {numFreqChans, 1});
+    // channel c is masked iff f0 <= c <= f0 + f for some mask
+    auto freqMask = fl::any(chanIdx >= f0 && chanIdx <= f0 + f, {1});
+    mask =
+        fl::tile(fl::reshape(freqMask, {1, numFreqChans}), {numTimeSteps, 1});
   }
 
-  auto numTimeSteps = input.dim(0); // number of time steps
   // an upper bound on the time mask
   int T = std::min(timeMaskT_, static_cast<int>(numTimeSteps * timeMaskP_));
-  if (T > 0) {
-    for (int i = 0; i < numTimeMask_; ++i) {
-      auto t = generateRandomInt(0, T);
-      auto t0 = generateRandomInt(0, numTimeSteps - t);
-      opArr(fl::range(t0, t0 + t + 1)) = replaceVal;
-    }
+  if (numTimeMask_ > 0 && T > 0) {
+    auto t = fl::floor(fl::rand({numTimeMask_}) * T);
+    auto t0 = fl::floor(fl::rand({numTimeMask_}) * (numTimeSteps - t));
+    auto timeIdx = fl::tile(fl::iota({numTimeSteps, 1}), {1, numTimeMask_});
+    t = fl::tile(fl::reshape(t, {1, numTimeMask_}), {numTimeSteps, 1});
+    t0 = fl::tile(fl::reshape(t0, {1, numTimeMask_}), {numTimeSteps, 1});
+    auto timeMask = fl::any(timeIdx >= t0 && timeIdx <= t0 + t, {1});
+    auto timeMask2d =
+        fl::tile(fl::reshape(timeMask, {numTimeSteps, 1}), {1, numFreqChans});
+    mask = mask.isEmpty() ? timeMask2d : mask || timeMask2d;
+  }
+  if (mask.isEmpty()) {
+    return output;
   }
 
-  return output;
-}
+  // tile the T x F mask over any trailing channel/batch dims
+  Shape tileDims(std::vector<Dim>(opArr.ndim(), 1));
+  for (int d = 2; d < opArr.ndim(); ++d) {
+    tileDims[d] = opArr.dim(d);
+  }
+  mask = fl::tile(mask, tileDims);
 
-int SpecAugment::generateRandomInt(int low, int high) {
-  std::uniform_int_distribution<int> uniformDist(low, high - 1);
-  return uniformDist(eng_);
+  if (maskStrategy_ == MaskingStrategy::GLOBAL_MEAN) {
+    auto replaceArr = fl::tile(
+        fl::reshape(fl::mean(opArr), Shape(std::vector<Dim>(opArr.ndim(), 1))),
+        opArr.shape());
+    opArr = fl::where(mask, replaceArr, opArr);
+  } else {
+    opArr = fl::where(mask, 0.0, opArr);
+  }
+
+  return output;
 }
 
 std::unique_ptr<Module> SpecAugment::clone() const {
@@ -7,8 +7,6 @@
 
 #pragma once
 
-#include <random>
-
 #include "flashlight/fl/nn/nn.h"
 
 namespace fl {
@@ -75,11 +73,8 @@ class FL_API SpecAugment : public UnaryModule {
   float timeMaskP_;
   int numTimeMask_;
 
-  std::mt19937 eng_{0};
   MaskingStrategy maskStrategy_;
 
-  int generateRandomInt(int low, int high);
-
   SpecAugment() = default;
 };
 
@@ -5,6 +5,7 @@
  * LICENSE file in the root directory of this source tree.
  */
 
+#include <algorithm>
 #include <cmath>
 #include <stdexcept>
 
@@ -12,6 +13,7 @@
 #include "flashlight/fl/contrib/modules/Transformer.h"
 #include "flashlight/fl/nn/Init.h"
 #include "flashlight/fl/nn/Utils.h"
+#include "flashlight/fl/tensor/Index.h"
 #include "flashlight/fl/tensor/Random.h"
 
 namespace {
@@ -19,6 +21,10 @@ fl::Variable transformerInitLinear(int32_t inDim, int32_t outDim) {
   float std = std::sqrt(1.0 / float(inDim));
   return fl::uniform(outDim, inDim, -std, std, fl::dtype::f32, true);
 }
+
+// Initial key/value cache capacity (in steps) for `Transformer::decodeStep`
+// when relative positional embeddings don't bound the decode length
+constexpr int kInitialKVCacheCapacity = 128;
 } // namespace
 
 namespace fl {
@@ -32,13 +38,15 @@ Transformer::Transformer(
     float pDropout,
     float pLayerdrop,
     bool useMask,
-    bool preLN)
+    bool preLN,
+    bool useRope /* = false */)
     : nHeads_(nHeads),
       bptt_(bptt),
       pDropout_(pDropout),
       pLayerdrop_(pLayerdrop),
       useMask_(useMask),
       preLN_(preLN),
+      useRope_(useRope),
       w1_(std::make_shared<Linear>(transformerInitLinear(modelDim, mlpDim))),
       w2_(std::make_shared<Linear>(transformerInitLinear(mlpDim, modelDim))),
       wq_(std::make_shared<Linear>(
@@ -51,6 +59,15 @@ Transformer::Transformer(
           transformerInitLinear(headDim * nHeads, modelDim))),
       norm1_(std::make_shared<LayerNorm>(std::vector<int>({0, 3}))),
       norm2_(std::make_shared<LayerNorm>(std::vector<int>({0, 3}))) {
+  if (useRope && bptt > 0) {
+    throw std::invalid_argument(
+        "Transformer - rotary and learnt relative positional embeddings "
+        "are mutually exclusive; use bptt = 0 with useRope");
+  }
+  if (useRope && headDim % 2 != 0) {
+    throw std::invalid_argument(
+        "Transformer - rotary positional embeddings require an even headDim");
+  }
   if (bptt > 0) {
     params_.push_back(
         uniform(2 * bptt - 1, headDim, -0.1, 0.1, fl::dtype::f32, true));
@@ -79,6 +96,8 @@ void Transformer::copy(const Transformer& other) {
   pLayerdrop_ = other.pLayerdrop_;
   useMask_ = other.useMask_;
   preLN_ = other.preLN_;
+  useRope_ = other.useRope_;
+  attnQueryChunkSize_ = other.attnQueryChunkSize_;
   w1_ = std::make_shared<Linear>(*other.w1_);
   w2_ = std::make_shared<Linear>(*other.w2_);
   wq_ = std::make_shared<Linear>(*other.wq_);
@@ -118,6 +137,69 @@ Variable Transformer::getMask(int32_t n, bool cache) {
   return Variable(fl::log(mask), false);
 }
 
+Variable Transformer::getDocumentMask(const Tensor& documentIds) {
+  if (documentIds.ndim() != 2) {
+    throw std::invalid_argument(
+        "Transformer::getDocumentMask - document ids should be of "
+        "2 dimensions, T x B");
+  }
+  const auto n = documentIds.dim(0);
+  const auto bsz = documentIds.dim(1);
+  // allow attention only between positions of the same document
+  auto queryIds =
+      fl::tile(fl::reshape(documentIds, {n, 1, bsz}), {1, n, 1});
+  auto keyIds = fl::tile(fl::reshape(documentIds, {1, n, bsz}), {n, 1, 1});
+  return Variable(
+      fl::log((queryIds == keyIds).astype(fl::dtype::f32)), false);
+}
+
+Variable Transformer::applyRope(const Variable& input, int offset) {
+  // input is T x (headDim * nHeads) x B
+  const int nChannels = input.dim(1), bsz = input.dim(2);
+  const int nPositions = input.dim(0);
+  const int headDim = nChannels / nHeads_;
+  const int half = headDim / 2;
+
+  // Build (or geometrically grow) the cos/sin tables, laid out as
+  // position x headDim with the frequency of pair i repeated at rows i and
+  // i + half (the split-half rotation convention).
+  if (ropeCos_.isEmpty() || ropeCos_.dim(0) < offset + nPositions ||
+      ropeCos_.type() != input.type()) {
+    const int nCached =
+        ropeCos_.isEmpty() || ropeCos_.type() != input.type()
+        ? offset + nPositions
+        : std::max<int>(offset + nPositions, 2 * ropeCos_.dim(0));
+    Tensor invFreq = fl::exp(
+        fl::iota({1, half}, {1, 1}, input.type()) *
+        (-2.0 * std::log(10000) / headDim));
+    Tensor angles = fl::tile(fl::iota({nCached, 1}, {1, 1}, input.type()),
+                             {1, half}) *
+        fl::tile(invFreq, {nCached, 1});
+    angles = fl::concatenate(1, angles, angles);
+    ropeCos_ = fl::cos(angles);
+    ropeSin_ = fl::sin(angles);
+  }
+
+  auto slice = [&](const Tensor& table) {
+    return Variable(
+        fl::tile(
+            fl::reshape(
+                table(fl::range(offset, offset + nPositions)),
+                {nPositions, headDim, 1, 1}),
+            {1, 1, nHeads_, bsz}),
+        false);
+  };
+
+  // rotate per head: (x1, x2) -> (x1 cos - x2 sin, x2 cos + x1 sin)
+  auto x = moddims(input, {nPositions, headDim, nHeads_, bsz});
+  auto x1 = x(fl::span, fl::range(0, half));
+  auto x2 = x(fl::span, fl::range(half, headDim));
+  auto rotated = concatenate({negate(x2), x1}, 1);
+  return moddims(
+      x * slice(ropeCos_) + rotated * slice(ropeSin_),
+      {nPositions, nChannels, bsz});
+}
+
 Variable Transformer::selfAttention(const std::vector<Variable>& input) {
   // previous step[optionally], input, padMask
   const auto& encoderInput = input.at(input.size() - 2);
@@ -142,9 +224,21 @@ Variable Transformer::selfAttention(const std::vector<Variable>& input) {
 
   int offset = (input.size() == 2) ? 0 : n;
 
+  if (useRope_) {
+    // keys start at position 0 (they cover the previous state, if any);
+    // queries start at the first new position
+    q = applyRope(q, offset);
+    k = applyRope(k, 0);
+  }
+
   // time x batch
   fl::Variable padMask;
-  if (!input.back().isEmpty()) {
+  if (!input.back().isEmpty() && input.back().ndim() == 3) {
+    // prebuilt per-batch additive mask (e.g. `getDocumentMask` for packed
+    // sequences), combined with the causal mask
+    const auto& scoreMask = input.back();
+    mask = mask.isEmpty() ? scoreMask : tileAs(mask, scoreMask) + scoreMask;
+  } else if (!input.back().isEmpty()) {
     auto padMaskArr = input.back().tensor();
     Shape newMaskShape = {encoderInput.dim(1), encoderInput.dim(2)};
     // TODO{fl::Tensor}{resize} - emulate the ArrayFire resize operation for
@@ -158,7 +252,16 @@ Variable Transformer::selfAttention(const std::vector<Variable>& input) {
     padMask = fl::Variable(fl::log(padMaskArr), false);
   }
   auto result = multiheadAttention(
-      q, k, v, posEmb, mask, padMask, nHeads_, pDrop, offset);
+      q,
+      k,
+      v,
+      posEmb,
+      mask,
+      padMask,
+      nHeads_,
+      pDrop,
+      offset,
+      attnQueryChunkSize_);
   result = (*wf_)(transpose(result, {1, 0, 2}));
 
   return result;
@@ -186,7 +289,8 @@ std::vector<Variable> Transformer::forward(const std::vector<Variable>& input) {
           "Transformer::forward - invalid size for pad mask - "
           "must have at least two dimensions");
 
-    } else if (x.dim(2) != input.back().dim(1)) {
+    } else if (
+        x.dim(2) != input.back().dim(input.back().ndim() == 3 ? 2 : 1)) {
       throw std::invalid_argument(
           "Transformer::forward - invalid inputs for transformer:"
           " input and mask batch sizes are different");
@@ -201,8 +305,91 @@ std::vector<Variable> Transformer::forward(const std::vector<Variable>& input) {
     auto h = (f * (*norm1_)(selfAttention(input))).astype(x.type()) + x;
     return {f * (*norm2_)(mlp(h)).astype(h.type()) + h};
   } else {
-    auto h = (*norm1_)((f * selfAttention(input)).astype(x.type()) + x);
-    return {(*norm2_)((f * mlp(h)).astype(h.type()) + h)};
+    // residual add fused into the normalization - see LayerNorm::forwardAdd
+    auto h = norm1_->forwardAdd(x, f * selfAttention(input));
+    return {norm2_->forwardAdd(h, f * mlp(h))};
+  }
+}
+
+Variable Transformer::decodeStep(
+    const Variable& input,
+    TransformerKVCache& cache) {
+  if (input.ndim() != 3) {
+    throw std::invalid_argument(
+        "Transformer::decodeStep - input should be of 3 dimensions "
+        "expects an input of size C x T x B - see documentation.");
+  }
+  int n = input.dim(1), bsz = input.dim(2);
+
+  auto q = transpose((*wq_)(input), {1, 0, 2});
+  auto kNew = transpose((*wk_)(input), {1, 0, 2}).tensor();
+  auto vNew = transpose((*wv_)(input), {1, 0, 2}).tensor();
+
+  if (cache.keys.isEmpty()) {
+    int capacity = std::max(n, bptt_ > 0 ? bptt_ : kInitialKVCacheCapacity);
+    cache.keys = fl::full({capacity, kNew.dim(1), bsz}, 0., kNew.type());
+    cache.values = fl::full({capacity, vNew.dim(1), bsz}, 0., vNew.type());
+    cache.length = 0;
+  } else if (cache.length + n > cache.keys.dim(0)) {
+    int capacity =
+        std::max<int>(cache.length + n, 2 * cache.keys.dim(0));
+    auto grow = [capacity, &cache](Tensor& t) {
+      auto grown = fl::full({capacity, t.dim(1), t.dim(2)}, 0., t.type());
+      grown(fl::range(0, cache.length)) = t(fl::range(0, cache.length));
+      t = grown;
+    };
+    grow(cache.keys);
+    grow(cache.values);
+  }
+  int offset = cache.length;
+  if (useRope_) {
+    // rotations encode absolute positions, so the cached keys are already
+    // rotated and only the new steps need the rotation applied
+    q = applyRope(q, offset);
+    kNew = applyRope(Variable(kNew, false), offset).tensor();
+  }
+  cache.keys(fl::range(offset, offset + n)) = kNew;
+  cache.values(fl::range(offset, offset + n)) = vNew;
+  cache.length += n;
+
+  auto k = Variable(cache.keys(fl::range(0, cache.length)), false);
+  auto v = Variable(cache.values(fl::range(0, cache.length)), false);
+
+  Variable mask;
+  if (n > 1) {
+    // a multi-step append must stay causal among the new steps; the cached
+    // prefix is visible to all of them
+    auto scoreMask = fl::tril(fl::full({n, n}, 1.0));
+    if (offset > 0) {
+      scoreMask = fl::concatenate(1, fl::full({n, offset}, 1.0), scoreMask);
+    }
+    mask = Variable(fl::log(scoreMask), false);
+  }
+
+  Variable posEmb;
+  if (bptt_ > 0) {
+    posEmb = tile(params_[0].astype(input.type()), {1, 1, nHeads_ * bsz});
+  }
+  auto result = multiheadAttention(
+      q,
+      k,
+      v,
+      posEmb,
+      mask,
+      Variable(),
+      nHeads_,
+      /* pDropout = */ 0.,
+      offset,
+      attnQueryChunkSize_);
+  result = (*wf_)(transpose(result, {1, 0, 2}));
+
+  const auto& x = input;
+  if (preLN_) {
+    auto h = (*norm1_)(result).astype(x.type()) + x;
+    return (*norm2_)(mlp(h)).astype(h.type()) + h;
+  } else {
+    auto h = norm1_->forwardAdd(x, result);
+    return norm2_->forwardAdd(h, mlp(h));
   }
 }
 
@@ -214,6 +401,15 @@ void Transformer::setLayerDropout(float value) {
   pLayerdrop_ = value;
 }
 
+void Transformer::setAttentionQueryChunkSize(int32_t chunkSize) {
+  if (chunkSize < 0) {
+    throw std::invalid_argument(
+        "Transformer::setAttentionQueryChunkSize - "
+        "chunk size must be non-negative");
+  }
+  attnQueryChunkSize_ = chunkSize;
+}
+
 std::unique_ptr<Module> Transformer::clone() const {
   return std::make_unique<Transformer>(*this);
 }
@@ -225,7 +421,8 @@ std::string Transformer::prettyString() const {
      << "(pLayerdrop: " << pLayerdrop_ << "), "
      << "(bptt: " << bptt_ << "), "
      << "(useMask: " << useMask_ << "), "
-     << "(preLayerNorm: " << preLN_ << ")";
+     << "(preLayerNorm: " << preLN_ << "), "
+     << "(useRope: " << useRope_ << ")";
   return ss.str();
 }
 
@@ -14,6 +14,20 @@
 
 namespace fl {
 
+/**
+ * Per-layer key/value cache for incremental decoding with
+ * `Transformer::decodeStep`. `keys` and `values` hold the self-attention
+ * key/value projections of all previously decoded steps, transposed to
+ * T x (headDim * nHeads) x B; `length` is the number of valid steps. The
+ * storage is preallocated and new steps are appended in place, growing
+ * geometrically if the initial capacity is exceeded.
+ */
+struct FL_API TransformerKVCache {
+  Tensor keys;
+  Tensor values;
+  int length{0};
+};
+
 /**
  * A module which implements a Transformer.
  *
@@ -32,6 +46,9 @@ namespace fl {
  * phase)
  * - padMask is expected to have "1" on the normal positions and "0" on the
  * padded positions
+ * - alternatively, a 3-dim T x T x B tensor in the padMask slot is taken as a
+ * prebuilt per-batch additive mask on the attention scores (see
+ * `getDocumentMask`), added on top of the causal mask
  *
  * @param modelDim input embedding dimension
  * @param headDim dimension of each head
@@ -45,6 +62,13 @@ namespace fl {
  * if true then don't use future (for example for autoregressive language models
  * or for decoder part in the encoder-decoder transformer models)
  * @param preLN apply layer normalization before or after residual connection
+ * @param useRope apply rotary positional embeddings ([Su et al
+ * (2021)](https://arxiv.org/abs/2104.09864)) to the queries and keys inside
+ * the self-attention. Positions are encoded by rotating each head's
+ * query/key pairs, so no embedding is added to the input and no extra
+ * parameters are introduced; the cos/sin tables are built once on device
+ * and sliced per call. Mutually exclusive with the learnt relative
+ * positional embeddings — requires bptt = 0. `headDim` must be even.
  */
 class FL_API Transformer : public Container {
  public:
@@ -57,15 +81,54 @@ class FL_API Transformer : public Container {
       float pDropout,
       float pLayerdrop,
       bool useMask = false,
-      bool preLN = false);
+      bool preLN = false,
+      bool useRope = false);
   Transformer(const Transformer& other);
   Transformer& operator=(const Transformer& other);
   Transformer(Transformer&& other) = default;
   Transformer& operator=(Transformer&& other) = default;
 
   std::vector<Variable> forward(const std::vector<Variable>& input) override;
+
+  /**
+   * Builds the additive attention mask for sequences packed from several
+   * documents: position pairs belonging to different documents get -inf, so
+   * tokens never attend across a document boundary. `documentIds` is T x B,
+   * holding for every position the index of the document it came from (e.g.
+   * the second tensor of `TextDataset`'s "pack" mode; padding should use an
+   * id of its own). Pass the result in the mask slot of `forward` — it is
+   * combined with the causal mask.
+   */
+  static Variable getDocumentMask(const Tensor& documentIds);
+
   void setDropout(float value);
   void setLayerDropout(float value);
+
+  /**
+   * Sets the query block size used by the self-attention; if positive, the
+   * attention is computed via `scaledDotProductAttention` in blocks of this
+   * many query steps, bounding score memory by blockSize x T instead of
+   * T x T. Only takes effect when relative positional embeddings (bptt) are
+   * disabled and dropout is inactive (e.g. in eval mode); 0 (the default)
+   * always uses the dense computation. This is a runtime tuning knob and is
+   * not serialized.
+   */
+  void setAttentionQueryChunkSize(int32_t chunkSize);
+
+  /**
+   * Computes one incremental decoding step. `input` holds only the new
+   * steps (C x n x B); the key/value projections of the `cache.length`
+   * previously decoded steps are read from `cache` instead of being
+   * recomputed, and the projections of the new steps are appended to it in
+   * place, making the per-step cost linear in the prefix length. The
+   * queries attend to the entire cache; feeding one step at a time is
+   * causal by construction, and appending several steps at once (e.g.
+   * verifying a drafted block in speculative decoding) applies a causal
+   * mask among the new steps. The cached tensors carry no gradient and
+   * layer drop is inactive — this is an inference-only path.
+   */
+  Variable decodeStep(const Variable& input, TransformerKVCache& cache);
+
   std::unique_ptr<Module> clone() const override;
   std::string prettyString() const override;
 
@@ -76,14 +139,23 @@ class FL_API Transformer : public Container {
   double pLayerdrop_;
   bool useMask_;
   bool preLN_;
+  bool useRope_{false};
+  int32_t attnQueryChunkSize_{0};
   std::shared_ptr<Linear> w1_, w2_, wq_, wk_, wv_, wf_;
   std::shared_ptr<LayerNorm> norm1_, norm2_;
+  // lazily-built device-resident rotary cos/sin tables, grown geometrically
+  // with the longest position seen; derived state, neither copied nor
+  // serialized
+  Tensor ropeCos_, ropeSin_;
 
   void copy(const Transformer& other);
   void createLayers();
   Variable mlp(const Variable& input);
   Variable getMask(int32_t n, bool cache = false);
   Variable selfAttention(const std::vector<Variable>& input);
+  // Rotates the (T x headDim*nHeads x B) queries or keys by their absolute
+  // positions [offset, offset + T)
+  Variable applyRope(const Variable& input, int offset);
 
   FL_SAVE_LOAD_WITH_BASE(
       Container,
@@ -100,7 +172,8 @@ class FL_API Transformer : public Container {
       pLayerdrop_,
       bptt_,
       useMask_,
-      preLN_)
+      preLN_,
+      fl::versioned(useRope_, 1))
 
   Transformer();
 };
@@ -108,3 +181,4 @@ class FL_API Transformer : public Container {
 } // namespace fl
 
 CEREAL_REGISTER_TYPE(fl::Transformer);
+CEREAL_CLASS_VERSION(fl::Transformer, 1);
@@ -11,9 +11,11 @@
 #include "flashlight/fl/contrib/modules/AsymmetricConv1D.h"
 #include "flashlight/fl/contrib/modules/Conformer.h" 
 #include "flashlight/fl/contrib/modules/PositionEmbedding.h"
+#include "flashlight/fl/contrib/modules/Quantize.h"
 #include "flashlight/fl/contrib/modules/RawWavSpecAugment.h"
 #include "flashlight/fl/contrib/modules/Residual.h"
 #include "flashlight/fl/contrib/modules/SinusoidalPositionEmbedding.h"
+#include "flashlight/fl/contrib/modules/Sparse.h"
 #include "flashlight/fl/contrib/modules/SpecAugment.h"
 #include "flashlight/fl/contrib/modules/TDSBlock.h"
 #include "flashlight/fl/contrib/modules/Transformer.h"
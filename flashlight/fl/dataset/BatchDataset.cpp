@@ -9,15 +9,19 @@
 
 #include <array>
 #include <cmath>
+#include <future>
 #include <numeric>
 #include <stdexcept>
 
+#include "flashlight/fl/tensor/Compute.h"
+
 namespace fl {
 BatchDataset::BatchDataset(
     std::shared_ptr<const Dataset> dataset,
     int64_t batchsize,
     BatchDatasetPolicy policy /* = BatchDatasetPolicy::INCLUDE_LAST */,
-    const std::vector<BatchFunction>& batchfns /* = {} */)
+    const std::vector<BatchFunction>& batchfns /* = {} */,
+    int64_t numCollateThreads /* = 0 */)
     : dataset_(dataset),
       batchSize_(batchsize),
       batchPolicy_(policy),
@@ -28,6 +32,7 @@ BatchDataset::BatchDataset(
   if (batchSize_ <= 0) {
     throw std::invalid_argument("invalid batch size");
   }
+  initCollatePool(numCollateThreads);
   preBatchSize_ = dataset_->size();
   switch (batchPolicy_) {
     case BatchDatasetPolicy::INCLUDE_LAST:
@@ -51,7 +56,8 @@ BatchDataset::BatchDataset(
 BatchDataset::BatchDataset(
     std::shared_ptr<const Dataset> dataset,
     const std::vector<int64_t>& batchSizes,
-    const std::vector<BatchFunction>& batchfns /* = {} */)
+    const std::vector<BatchFunction>& batchfns /* = {} */,
+    int64_t numCollateThreads /* = 0 */)
     : dataset_(dataset), cumSumBatchSize_(batchSizes), batchFns_(batchfns) {
   if (!dataset_) {
     throw std::invalid_argument("dataset to be batched is null");
@@ -59,6 +65,7 @@ BatchDataset::BatchDataset(
   if (cumSumBatchSize_.empty()) {
     throw std::invalid_argument("batch size vector should not be empty");
   }
+  initCollatePool(numCollateThreads);
   std::partial_sum(
       cumSumBatchSize_.begin(),
       cumSumBatchSize_.end(),
@@ -79,7 +86,46 @@ std::vector<Tensor> BatchDataset::get(const int64_t idx) const {
     start = idx == 0 ? 0 : cumSumBatchSize_[idx - 1];
     end = std::min(cumSumBatchSize_[idx], preBatchSize_);
   }
-  return makeBatchFromRange(dataset_, batchFns_, start, end);
+  if (!collatePool_) {
+    return makeBatchFromRange(dataset_, batchFns_, start, end);
+  }
+
+  // Fetch the samples, then collate each field on the pool: the per-field
+  // pad-and-pack in makeBatch is independent across fields.
+  std::vector<std::vector<Tensor>> buffer;
+  for (auto& fds : dataset_->getRange(start, end)) {
+    if (buffer.size() < fds.size()) {
+      buffer.resize(fds.size());
+    }
+    for (int64_t i = 0; i < fds.size(); ++i) {
+      buffer[i].emplace_back(std::move(fds[i]));
+    }
+  }
+  std::vector<std::future<Tensor>> futures;
+  futures.reserve(buffer.size());
+  for (int64_t i = 0; i < buffer.size(); ++i) {
+    futures.emplace_back(collatePool_->enqueue([this, &buffer, i]() {
+      return makeBatch(
+          buffer[i], (i < batchFns_.size()) ? batchFns_[i] : nullptr);
+    }));
+  }
+  std::vector<Tensor> result(buffer.size());
+  for (int64_t i = 0; i < buffer.size(); ++i) {
+    result[i] = futures[i].get();
+  }
+  return result;
+}
+
+void BatchDataset::initCollatePool(int64_t numCollateThreads) {
+  if (numCollateThreads < 0) {
+    throw std::invalid_argument("invalid numCollateThreads");
+  }
+  if (numCollateThreads > 0) {
+    auto deviceId = fl::getDevice();
+    collatePool_ = std::make_unique<ThreadPool>(
+        numCollateThreads,
+        [deviceId](int /* threadId */) { fl::setDevice(deviceId); });
+  }
 }
 
 int64_t BatchDataset::size() const {
@@ -7,6 +7,9 @@
 
 #pragma once
 
+#include <memory>
+
+#include "flashlight/fl/common/threadpool/ThreadPool.h"
 #include "flashlight/fl/dataset/Dataset.h"
 #include "flashlight/fl/dataset/Utils.h"
 
@@ -62,30 +65,41 @@ class FL_API BatchDataset : public Dataset {
    * @param[in] batchsize The desired batch size.
    * @param[in] policy How to handle the last batch if sizes are indivisible.
    * @param[in] batchfns Custom batch function to use for difference indices.
+   * @param[in] numCollateThreads If positive, collate the per-field batch
+   * tensors in parallel on a thread pool of that size. 0 (default) collates
+   * serially on the calling thread.
    */
   BatchDataset(
       std::shared_ptr<const Dataset> dataset,
       int64_t batchsize,
       BatchDatasetPolicy policy = BatchDatasetPolicy::INCLUDE_LAST,
-      const std::vector<BatchFunction>& batchfns = {});
+      const std::vector<BatchFunction>& batchfns = {},
+      int64_t numCollateThreads = 0);
 
   /**
    * Creates a `BatchDataset`.
    * @param[in] dataset The underlying dataset.
    * @param[in] batchSizes desired batch sizes (dynamic).
    * @param[in] batchfns Custom batch function to use for difference indices.
+   * @param[in] numCollateThreads If positive, collate the per-field batch
+   * tensors in parallel on a thread pool of that size. 0 (default) collates
+   * serially on the calling thread.
    */
   BatchDataset(
       std::shared_ptr<const Dataset> dataset,
       const std::vector<int64_t>& batchSizes,
-      const std::vector<BatchFunction>& batchfns = {});
+      const std::vector<BatchFunction>& batchfns = {},
+      int64_t numCollateThreads = 0);
 
   int64_t size() const override;
 
   std::vector<Tensor> get(const int64_t idx) const override;
 
  private:
+  void initCollatePool(int64_t numCollateThreads);
+
   std::shared_ptr<const Dataset> dataset_;
+  std::unique_ptr<ThreadPool> collatePool_;
   int64_t batchSize_;
   BatchDatasetPolicy batchPolicy_;
   std::vector<int64_t> cumSumBatchSize_;
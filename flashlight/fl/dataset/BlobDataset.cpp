@@ -5,9 +5,12 @@
  * LICENSE file in the root directory of this source tree.
  */
 
+#include <algorithm>
 #include <array>
+#include <cstring>
 #include <stdexcept>
 #include <thread>
+#include <utility>
 
 #include "flashlight/fl/dataset/BlobDataset.h"
 #include "flashlight/fl/tensor/Types.h"
@@ -15,24 +18,274 @@
 namespace fl {
 
 const int64_t magicNumber = 0x31626f6c423a6c66;
+// Blobs with per-entry compression fields in the index ("fl:Blob2")
+const int64_t magicNumberV2 = 0x32626f6c423a6c66;
+
+namespace {
+
+bool isIntegralType(fl::dtype type) {
+  switch (type) {
+    case fl::dtype::f16:
+    case fl::dtype::f32:
+    case fl::dtype::f64:
+      return false;
+    default:
+      return true;
+  }
+}
+
+// Byte-level run-length coding as (count, value) pairs with 255-byte runs;
+// effective on sparse or constant payloads, trivially rejected by the size
+// comparison in compressEntry otherwise
+std::vector<uint8_t> rleEncode(const std::vector<uint8_t>& raw) {
+  std::vector<uint8_t> out;
+  out.reserve(raw.size() / 2);
+  size_t i = 0;
+  while (i < raw.size()) {
+    const uint8_t value = raw[i];
+    size_t run = 1;
+    while (run < 255 && i + run < raw.size() && raw[i + run] == value) {
+      run++;
+    }
+    out.push_back(static_cast<uint8_t>(run));
+    out.push_back(value);
+    i += run;
+  }
+  return out;
+}
+
+void rleDecode(
+    const uint8_t* src,
+    int64_t srcSize,
+    uint8_t* dst,
+    int64_t dstSize) {
+  int64_t out = 0;
+  for (int64_t i = 0; i + 1 < srcSize; i += 2) {
+    const int64_t run = src[i];
+    if (out + run > dstSize) {
+      throw std::runtime_error(
+          "BlobDataset - corrupted run-length compressed entry");
+    }
+    std::memset(dst + out, src[i + 1], run);
+    out += run;
+  }
+  if (out != dstSize) {
+    throw std::runtime_error(
+        "BlobDataset - corrupted run-length compressed entry");
+  }
+}
+
+// Bitpacked layout: <int64: minimum value (bit pattern)> <int64: bit width>
+// followed by the (value - minimum) deltas at `width` bits each, packed
+// little-endian. A width of 0 encodes a constant tensor as the header alone.
+constexpr int64_t kBitpackHeaderBytes = 2 * sizeof(int64_t);
+
+template <typename T>
+std::vector<uint8_t> bitpackEncodeT(const uint8_t* raw, int64_t n) {
+  const T* vals = reinterpret_cast<const T*>(raw);
+  T minValue = vals[0];
+  T maxValue = vals[0];
+  for (int64_t i = 1; i < n; ++i) {
+    minValue = std::min(minValue, vals[i]);
+    maxValue = std::max(maxValue, vals[i]);
+  }
+  // the unsigned difference is range-correct for signed types too
+  uint64_t range =
+      static_cast<uint64_t>(maxValue) - static_cast<uint64_t>(minValue);
+  int64_t width = 0;
+  while (range != 0) {
+    range >>= 1;
+    ++width;
+  }
+  if (width >= static_cast<int64_t>(sizeof(T) * 8)) {
+    return {}; // full-width values cannot shrink
+  }
+  std::vector<uint8_t> out(kBitpackHeaderBytes + (n * width + 7) / 8, 0);
+  const int64_t minBits = static_cast<int64_t>(minValue);
+  std::memcpy(out.data(), &minBits, sizeof(int64_t));
+  std::memcpy(out.data() + sizeof(int64_t), &width, sizeof(int64_t));
+  int64_t bit = 0;
+  for (int64_t i = 0; i < n; ++i) {
+    const uint64_t delta =
+        static_cast<uint64_t>(vals[i]) - static_cast<uint64_t>(minValue);
+    for (int64_t b = 0; b < width; ++b, ++bit) {
+      if ((delta >> b) & 1) {
+        out[kBitpackHeaderBytes + (bit >> 3)] |= (1u << (bit & 7));
+      }
+    }
+  }
+  return out;
+}
+
+template <typename T>
+void bitpackDecodeT(const uint8_t* src, int64_t srcSize, uint8_t* dst,
+                    int64_t n) {
+  if (srcSize < kBitpackHeaderBytes) {
+    throw std::runtime_error(
+        "BlobDataset - corrupted bitpacked compressed entry");
+  }
+  int64_t minBits;
+  int64_t width;
+  std::memcpy(&minBits, src, sizeof(int64_t));
+  std::memcpy(&width, src + sizeof(int64_t), sizeof(int64_t));
+  if (width < 0 || width >= static_cast<int64_t>(sizeof(T) * 8) ||
+      srcSize < kBitpackHeaderBytes + (n * width + 7) / 8) {
+    throw std::runtime_error(
+        "BlobDataset - corrupted bitpacked compressed entry");
+  }
+  T* vals = reinterpret_cast<T*>(dst);
+  int64_t bit = 0;
+  for (int64_t i = 0; i < n; ++i) {
+    uint64_t delta = 0;
+    for (int64_t b = 0; b < width; ++b, ++bit) {
+      if ((src[kBitpackHeaderBytes + (bit >> 3)] >> (bit & 7)) & 1) {
+        delta |= (uint64_t(1) << b);
+      }
+    }
+    vals[i] = static_cast<T>(static_cast<uint64_t>(minBits) + delta);
+  }
+}
+
+template <typename F>
+auto dispatchIntegralType(fl::dtype type, F&& f) {
+  switch (type) {
+    case fl::dtype::b8:
+    case fl::dtype::u8:
+      return f(uint8_t());
+    case fl::dtype::s16:
+      return f(int16_t());
+    case fl::dtype::u16:
+      return f(uint16_t());
+    case fl::dtype::s32:
+      return f(int32_t());
+    case fl::dtype::u32:
+      return f(uint32_t());
+    case fl::dtype::s64:
+      return f(int64_t());
+    case fl::dtype::u64:
+      return f(uint64_t());
+    default:
+      throw std::invalid_argument(
+          "BlobDataset - bitpacking requires an integer tensor type");
+  }
+}
+
+std::vector<uint8_t> bitpackEncode(
+    const std::vector<uint8_t>& raw,
+    fl::dtype type) {
+  const int64_t n = raw.size() / fl::getTypeSize(type);
+  return dispatchIntegralType(type, [&](auto witness) {
+    return bitpackEncodeT<decltype(witness)>(raw.data(), n);
+  });
+}
+
+// Encodes `raw` per the requested codec, keeping whichever applicable
+// encoding is smallest - raw included - and returns the codec stored
+BlobCompression compressEntry(
+    std::vector<uint8_t>&& raw,
+    fl::dtype type,
+    BlobCompression requested,
+    std::vector<uint8_t>& stored) {
+  BlobCompression codec = BlobCompression::None;
+  std::vector<uint8_t> best;
+  if (!raw.empty() &&
+      (requested == BlobCompression::Bitpack ||
+       requested == BlobCompression::Auto) &&
+      isIntegralType(type)) {
+    auto packed = bitpackEncode(raw, type);
+    if (!packed.empty() && packed.size() < raw.size()) {
+      best = std::move(packed);
+      codec = BlobCompression::Bitpack;
+    }
+  }
+  if (!raw.empty() &&
+      (requested == BlobCompression::RunLength ||
+       requested == BlobCompression::Auto)) {
+    auto rle = rleEncode(raw);
+    if (rle.size() < raw.size() &&
+        (codec == BlobCompression::None || rle.size() < best.size())) {
+      best = std::move(rle);
+      codec = BlobCompression::RunLength;
+    }
+  }
+  stored = (codec == BlobCompression::None) ? std::move(raw) : std::move(best);
+  return codec;
+}
+
+std::vector<uint8_t> decompressEntry(
+    const uint8_t* src,
+    int64_t srcSize,
+    const BlobDatasetEntry& e,
+    int64_t rawSize) {
+  std::vector<uint8_t> raw(rawSize);
+  switch (e.codec) {
+    case BlobCompression::RunLength:
+      rleDecode(src, srcSize, raw.data(), rawSize);
+      break;
+    case BlobCompression::Bitpack:
+      dispatchIntegralType(e.type, [&](auto witness) {
+        bitpackDecodeT<decltype(witness)>(
+            src, srcSize, raw.data(), e.dims.elements());
+      });
+      break;
+    default:
+      throw std::runtime_error(
+          "BlobDataset - unknown compression codec in blob index");
+  }
+  return raw;
+}
+
+} // namespace
 
 BlobDatasetEntryBuffer::BlobDatasetEntryBuffer() = default;
 
+int BlobDatasetEntryBuffer::nFieldPerEntry() const {
+  // {type, numDims, dim0..dim3, offset} plus, in the extended format,
+  // {codec, storedBytes}
+  return extended_ ? 9 : 7;
+}
+
+void BlobDatasetEntryBuffer::setExtended(bool extended) {
+  if (extended == extended_) {
+    return;
+  }
+  const int64_t n = size();
+  std::vector<BlobDatasetEntry> entries;
+  entries.reserve(n);
+  for (int64_t i = 0; i < n; ++i) {
+    entries.push_back(get(i));
+    if (!extended && entries.back().codec != BlobCompression::None) {
+      throw std::runtime_error(
+          "BlobDatasetEntryBuffer - compressed entries require the "
+          "extended index format");
+    }
+  }
+  data_.clear();
+  extended_ = extended;
+  for (const auto& e : entries) {
+    add(e);
+  }
+}
+
+bool BlobDatasetEntryBuffer::extended() const {
+  return extended_;
+}
+
 void BlobDatasetEntryBuffer::clear() {
   data_.clear();
 }
 
 int64_t BlobDatasetEntryBuffer::size() const {
-  return data_.size() / nFieldPerEntry_;
+  return data_.size() / nFieldPerEntry();
 }
 
 void BlobDatasetEntryBuffer::resize(int64_t size) {
-  data_.resize(size * nFieldPerEntry_);
+  data_.resize(size * nFieldPerEntry());
 }
 
 BlobDatasetEntry BlobDatasetEntryBuffer::get(const int64_t idx) const {
   BlobDatasetEntry e;
-  auto dataIdx = idx * nFieldPerEntry_;
+  auto dataIdx = idx * nFieldPerEntry();
   e.type = static_cast<fl::dtype>(data_[dataIdx++]);
   unsigned numDims = data_[dataIdx++];
   e.dims = Shape(std::vector<Dim>(numDims));
@@ -40,6 +293,10 @@ BlobDatasetEntry BlobDatasetEntryBuffer::get(const int64_t idx) const {
     e.dims[i] = data_[dataIdx + i];
   }
   e.offset = data_[dataIdx + maxNDims_];
+  if (extended_) {
+    e.codec = static_cast<BlobCompression>(data_[dataIdx + maxNDims_ + 1]);
+    e.storedBytes = data_[dataIdx + maxNDims_ + 2];
+  }
   return e;
 }
 
@@ -54,6 +311,14 @@ void BlobDatasetEntryBuffer::add(const BlobDatasetEntry& e) {
     data_.push_back(1); // placeholder dim
   }
   data_.push_back(e.offset);
+  if (extended_) {
+    data_.push_back(static_cast<int64_t>(e.codec));
+    data_.push_back(e.storedBytes);
+  } else if (e.codec != BlobCompression::None) {
+    throw std::runtime_error(
+        "BlobDatasetEntryBuffer - compressed entries require the "
+        "extended index format");
+  }
 }
 
 char* BlobDatasetEntryBuffer::data() {
@@ -89,30 +354,44 @@ std::vector<std::vector<uint8_t>> BlobDataset::rawGet(const int64_t idx) const {
 };
 
 void BlobDataset::add(const std::vector<Tensor>& sample) {
+  // Encode outside the lock: the entry offsets depend on the stored sizes
+  std::vector<std::vector<uint8_t>> stored(sample.size());
+  std::vector<BlobCompression> codecs(sample.size(), BlobCompression::None);
+  for (int64_t i = 0; i < sample.size(); i++) {
+    const auto& tensor = sample[i];
+    if (tensor.ndim() > maxNDims_) {
+      throw std::invalid_argument(
+          "BlobDataset::add - no support for serialization of "
+          "tensors with > 4 dimensions");
+    }
+    std::vector<uint8_t> raw(tensor.bytes());
+    if (!raw.empty()) {
+      tensor.host(raw.data());
+    }
+    codecs[i] =
+        compressEntry(std::move(raw), tensor.type(), compression_, stored[i]);
+  }
   int64_t entryOffset;
   {
     std::lock_guard<std::mutex> lock(mutex_);
     entryOffset = entries_.size();
     offsets_.push_back(entries_.size());
     sizes_.push_back(sample.size());
-    for (const auto& tensor : sample) {
-      if (tensor.ndim() > maxNDims_) {
-        throw std::invalid_argument(
-            "BlobDataset::add - no support for serialization of "
-            "tensors with > 4 dimensions");
-      }
+    for (int64_t i = 0; i < sample.size(); i++) {
       BlobDatasetEntry e;
-      e.type = tensor.type();
-      e.dims = tensor.shape();
+      e.type = sample[i].type();
+      e.dims = sample[i].shape();
       e.offset = indexOffset_;
-      indexOffset_ += tensor.bytes();
+      e.codec = codecs[i];
+      e.storedBytes = stored[i].size();
+      indexOffset_ += stored[i].size();
       entries_.add(e);
     }
+    reserveData(indexOffset_);
   }
   for (int64_t i = 0; i < sample.size(); i++) {
-    auto& array = sample[i];
     const auto& e = entries_.get(entryOffset + i);
-    writeArray(e, array);
+    writeData(e.offset, (const char*)stored[i].data(), stored[i].size());
   }
 }
 
@@ -121,6 +400,10 @@ void BlobDataset::add(const BlobDataset& blob, int64_t chunkSize) {
   if (chunkSize <= 0) {
     throw std::runtime_error("chunkSize must be positive");
   }
+  if (blob.entries_.extended()) {
+    // the source may hold compressed entries; carry their codec fields over
+    entries_.setExtended(true);
+  }
   sizes_.insert(sizes_.end(), blob.sizes_.begin(), blob.sizes_.end());
   std::vector<int64_t> offsets = blob.offsets_;
   for (auto& offset : offsets) {
@@ -156,19 +439,53 @@ std::vector<uint8_t> BlobDataset::readRawArray(
     const BlobDatasetEntry& e) const {
   std::vector<uint8_t> buffer;
   if (e.dims.elements() > 0) {
-    buffer.resize(fl::getTypeSize(e.type) * e.dims.elements());
-    readData(
-        e.offset,
-        (char*)buffer.data(),
-        fl::getTypeSize(e.type) * e.dims.elements());
+    const int64_t rawSize = fl::getTypeSize(e.type) * e.dims.elements();
+    if (e.codec == BlobCompression::None) {
+      buffer.resize(rawSize);
+      readData(e.offset, (char*)buffer.data(), rawSize);
+    } else {
+      // decompression runs in the calling (e.g. prefetch) thread
+      std::vector<uint8_t> storedBuffer(e.storedBytes);
+      readData(e.offset, (char*)storedBuffer.data(), e.storedBytes);
+      buffer =
+          decompressEntry(storedBuffer.data(), e.storedBytes, e, rawSize);
+    }
   }
   return buffer;
 }
 
 Tensor BlobDataset::readArray(const BlobDatasetEntry& e, int i) const {
   if (e.dims.elements() > 0) {
-    auto buffer = readRawArray(e);
     auto keyval = hostTransforms_.find(i);
+    auto size = fl::getTypeSize(e.type) * e.dims.elements();
+    // Zero-copy path: build the tensor straight over the blob bytes when the
+    // implementation exposes them in memory.
+    if (e.codec == BlobCompression::None) {
+      if (const char* mapped = mappedData(e.offset, size)) {
+        if (keyval == hostTransforms_.end()) {
+          return Tensor::fromBuffer(
+              e.dims, e.type, (const uint8_t*)mapped, MemoryLocation::Host);
+        } else {
+          // Host transforms mutate the buffer in place; give them a private
+          // copy rather than the (read-only) mapped pages.
+          std::vector<uint8_t> buffer(mapped, mapped + size);
+          return keyval->second(buffer.data(), e.dims, e.type);
+        }
+      }
+    } else if (
+        const char* mapped = mappedData(e.offset, e.storedBytes)) {
+      // compressed entries decode straight from the mapped bytes, skipping
+      // the readData staging copy
+      auto buffer = decompressEntry(
+          (const uint8_t*)mapped, e.storedBytes, e, size);
+      if (keyval == hostTransforms_.end()) {
+        return Tensor::fromBuffer(
+            e.dims, e.type, buffer.data(), MemoryLocation::Host);
+      } else {
+        return keyval->second(buffer.data(), e.dims, e.type);
+      }
+    }
+    auto buffer = readRawArray(e);
     if (keyval == hostTransforms_.end()) {
       return Tensor::fromBuffer(
           e.dims, e.type, buffer.data(), MemoryLocation::Host);
@@ -180,17 +497,13 @@ Tensor BlobDataset::readArray(const BlobDatasetEntry& e, int i) const {
   }
 }
 
-void BlobDataset::writeArray(const BlobDatasetEntry& e, const Tensor& array) {
-  std::vector<uint8_t> buffer(array.bytes());
-  array.host(buffer.data());
-  writeData(e.offset, (char*)buffer.data(), buffer.size());
-}
-
 void BlobDataset::writeIndex() {
   std::lock_guard<std::mutex> lock(mutex_);
 
   int64_t offset = 0;
-  offset += writeData(offset, (char*)&magicNumber, sizeof(int64_t));
+  // the extended (per-entry codec) index format carries its own magic number
+  const int64_t magic = entries_.extended() ? magicNumberV2 : magicNumber;
+  offset += writeData(offset, (char*)&magic, sizeof(int64_t));
   writeData(offset, (char*)&indexOffset_, sizeof(int64_t));
 
   offset = indexOffset_;
@@ -217,9 +530,10 @@ void BlobDataset::readIndex() {
 
   int64_t magicNumberCheck = 0;
   int64_t offset = readData(0, (char*)&magicNumberCheck, sizeof(int64_t));
-  if (magicNumber != magicNumberCheck) {
+  if (magicNumber != magicNumberCheck && magicNumberV2 != magicNumberCheck) {
     throw std::runtime_error("BlobDataset::readIndex - not a fl::BlobDataset");
   }
+  entries_.setExtended(magicNumberCheck == magicNumberV2);
   readData(offset, (char*)&indexOffset_, sizeof(int64_t));
   offset = indexOffset_;
 
@@ -236,10 +550,28 @@ void BlobDataset::readIndex() {
   readData(offset, entries_.data(), entries_.bytes());
 }
 
+void BlobDataset::reserveData(int64_t /* size */) {}
+
+const char* BlobDataset::mappedData(
+    int64_t /* offset */,
+    int64_t /* size */) const {
+  return nullptr;
+}
+
 void BlobDataset::flush() {
   flushData();
 }
 
+void BlobDataset::setCompression(BlobCompression codec) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (codec != BlobCompression::None) {
+    // compressed entries need the extended index fields; entries added
+    // before enabling compression are repacked (still stored raw)
+    entries_.setExtended(true);
+  }
+  compression_ = codec;
+}
+
 void BlobDataset::setHostTransform(
     int field,
     std::function<Tensor(void*, fl::Shape, fl::dtype)> func) {
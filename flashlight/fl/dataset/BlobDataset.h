@@ -53,18 +53,45 @@ namespace fl {
   <int64*k*entries: table of int64s {type, numDims, dim0, .. dim3, offset}>
   \endcode
   *
+ * Blobs written with compression enabled (see setCompression()) use the
+ * magic number 0x32626f6c423a6c66 and extend each index entry with two
+ * fields, {codec, stored size in bytes}, so the codec is negotiated per
+ * entry from the index. Readers accept both formats; uncompressed blobs
+ * keep the original format.
  */
 
+/**
+ * Per-entry compression codec for blob payloads. The writer stores the
+ * codec that actually paid off for each entry (falling back to `None` when
+ * the encoded form is no smaller than the raw bytes), so readers dispatch
+ * purely on the index.
+ */
+enum class BlobCompression : int64_t {
+  None = 0,
+  /// Byte-level run-length coding; effective on sparse or constant data
+  RunLength = 1,
+  /// Offset + fixed-width bitpacking of integer tensors with small ranges
+  Bitpack = 2,
+  /// Per entry, pick the smallest of the applicable codecs above
+  Auto = 3,
+};
+
 struct FL_API BlobDatasetEntry {
   fl::dtype type;
   fl::Shape dims;
   int64_t offset;
+  BlobCompression codec{BlobCompression::None};
+  /// Bytes occupied in the blob; only meaningful when `codec` is not `None`
+  /// (raw entries occupy their tensor size)
+  int64_t storedBytes{0};
 };
 
 class FL_API BlobDatasetEntryBuffer {
  private:
   std::vector<int64_t> data_;
-  const int nFieldPerEntry_ = 7;
+  bool extended_{false};
+
+  int nFieldPerEntry() const;
 
  public:
   static const int maxNDims_ = 4; // max dims supported based on index entries
@@ -77,6 +104,14 @@ class FL_API BlobDatasetEntryBuffer {
   void add(const BlobDatasetEntry& entry);
   char* data();
   int64_t bytes() const;
+
+  /**
+   * Whether entries carry the per-entry codec and stored-size fields (blob
+   * format v2). Switching an existing buffer repacks its entries; dropping
+   * back to the compact format requires all entries to be uncompressed.
+   */
+  void setExtended(bool extended);
+  bool extended() const;
 };
 
 class FL_API BlobDataset : public Dataset {
@@ -87,15 +122,38 @@ class FL_API BlobDataset : public Dataset {
   std::vector<int64_t> offsets_;
   int64_t indexOffset_;
   std::unordered_map<int, DataTransformFunction> hostTransforms_;
+  BlobCompression compression_{BlobCompression::None};
   mutable std::mutex mutex_;
 
   std::vector<uint8_t> readRawArray(const BlobDatasetEntry& e) const;
   Tensor readArray(const BlobDatasetEntry& e, int i) const;
-  void writeArray(const BlobDatasetEntry& e, const Tensor& array);
 
  protected:
   void readIndex();
 
+  /**
+   * Return a pointer to the raw blob bytes at the given offset, if the
+   * implementation keeps the blob addressable in memory (e.g. memory-mapped).
+   * When non-null, get() builds tensors directly over the returned bytes
+   * without staging them through an intermediate buffer. The pointer must
+   * stay valid for the lifetime of the dataset.
+   * @param[in] offset Offset in the blob in bytes.
+   * @param[in] size Number of addressable bytes required at offset.
+   * @return A pointer to the blob bytes, or nullptr if unsupported.
+   */
+  virtual const char* mappedData(int64_t offset, int64_t size) const;
+
+  /**
+   * Hint that the blob is about to grow to the given size. Called by add()
+   * while index space is reserved, before the corresponding writeData()
+   * calls are issued (possibly from other threads). Implementations backed
+   * by in-memory storage can grow their buffer here so concurrent
+   * writeData() calls to the reserved (disjoint) regions need not
+   * serialize. The default does nothing.
+   * @param[in] size Total blob size in bytes after the reserved writes.
+   */
+  virtual void reserveData(int64_t size);
+
   /**
    * Write raw data in the blob.
    * Implementation must be thread-safe.
@@ -188,6 +246,22 @@ class FL_API BlobDataset : public Dataset {
       int field,
       std::function<Tensor(void*, Shape, fl::dtype)> func);
 
+  /**
+   * Enable transparent compression for subsequently added arrays. Each
+   * entry is encoded at add() time and the codec that actually shrank it is
+   * recorded in the index (entries that don't compress are stored raw), so
+   * reads - including from prefetch threads - decompress transparently.
+   * Highly compressible payloads such as small-range token tensors or
+   * sparse labels trade disk bandwidth for a light decode pass.
+   *
+   * Enabling any codec switches the blob to the extended index format,
+   * which pre-compression readers do not understand; `BlobCompression::None`
+   * (the default) keeps the original format.
+   * @param[in] codec The codec (or `BlobCompression::Auto` to pick per
+   * entry).
+   */
+  void setCompression(BlobCompression codec);
+
   /**
    * Return entries in the blob for a given sample index.
    * @param[in] idx A sample index.
@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "flashlight/fl/dataset/BucketBatchDataset.h"
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <string>
+
+namespace fl {
+
+BucketBatchDataset::BucketBatchDataset(
+    std::shared_ptr<const Dataset> dataset,
+    const LengthFunction& lengthfn,
+    int64_t maxTokens,
+    int seed /* = 0 */,
+    const std::vector<BatchFunction>& batchfns /* = {} */)
+    : dataset_(dataset), batchFns_(batchfns), seed_(seed) {
+  if (!dataset_) {
+    throw std::invalid_argument("dataset to be batched is null");
+  }
+  if (!lengthfn) {
+    throw std::invalid_argument("LengthFunction is null");
+  }
+  if (maxTokens <= 0) {
+    throw std::invalid_argument("invalid maxTokens");
+  }
+
+  std::vector<int64_t> lengths(dataset_->size());
+  std::vector<int64_t> indices(dataset_->size());
+  std::iota(indices.begin(), indices.end(), 0);
+  for (int64_t i = 0; i < dataset_->size(); ++i) {
+    lengths[i] = lengthfn(i);
+    if (lengths[i] > maxTokens) {
+      throw std::invalid_argument(
+          "BucketBatchDataset - sample " + std::to_string(i) + " has length " +
+          std::to_string(lengths[i]) + " exceeding maxTokens " +
+          std::to_string(maxTokens) + "; filter data or raise the budget");
+    }
+  }
+  std::stable_sort(
+      indices.begin(), indices.end(), [&lengths](int64_t a, int64_t b) {
+        return lengths[a] < lengths[b];
+      });
+
+  // Greedily pack length-sorted indices: a batch closes when adding the next
+  // sample would push batchSize * maxLengthInBatch past the budget. Sorted
+  // order means the incoming sample is always the longest in the batch.
+  std::vector<int64_t> batch;
+  for (auto idx : indices) {
+    if (!batch.empty() &&
+        static_cast<int64_t>(batch.size() + 1) * lengths[idx] > maxTokens) {
+      batches_.push_back(std::move(batch));
+      batch.clear();
+    }
+    batch.push_back(idx);
+  }
+  if (!batch.empty()) {
+    batches_.push_back(std::move(batch));
+  }
+
+  batchOrder_.resize(batches_.size());
+  std::iota(batchOrder_.begin(), batchOrder_.end(), 0);
+}
+
+std::vector<Tensor> BucketBatchDataset::get(const int64_t idx) const {
+  checkIndexBounds(idx);
+  const auto& batch = batches_[batchOrder_[idx]];
+  std::vector<std::vector<Tensor>> buffer;
+  for (auto sampleIdx : batch) {
+    auto fds = dataset_->get(sampleIdx);
+    if (buffer.size() < fds.size()) {
+      buffer.resize(fds.size());
+    }
+    for (int64_t i = 0; i < fds.size(); ++i) {
+      buffer[i].emplace_back(fds[i]);
+    }
+  }
+  std::vector<Tensor> result(buffer.size());
+  for (int64_t i = 0; i < buffer.size(); ++i) {
+    result[i] =
+        makeBatch(buffer[i], (i < batchFns_.size()) ? batchFns_[i] : nullptr);
+  }
+  return result;
+}
+
+void BucketBatchDataset::resample() {
+  ++epoch_;
+  std::mt19937_64 rng(seed_ + epoch_);
+  std::shuffle(batchOrder_.begin(), batchOrder_.end(), rng);
+}
+
+int64_t BucketBatchDataset::size() const {
+  return batches_.size();
+}
+
+} // namespace fl
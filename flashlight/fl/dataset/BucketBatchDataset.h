@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <functional>
+
+#include "flashlight/fl/dataset/Dataset.h"
+#include "flashlight/fl/dataset/Utils.h"
+
+namespace fl {
+
+/**
+ * A view into a dataset where samples of similar length are grouped into
+ * variable-size batches under a token budget.
+ *
+ * Sample indices are sorted by a user-provided length functor, then packed
+ * greedily so that `batchSize * maxLengthInBatch <= maxTokens` -- the
+ * padded token count of each batch stays under the budget, instead of
+ * padding every batch to the globally longest sample. Batch order can be
+ * reshuffled per epoch with resample(); samples within a batch keep their
+ * length-sorted grouping.
+ *
+ * With heterogeneous sample shapes, a padding BatchFunction must be
+ * provided per field, as the default batching requires equal dimensions.
+ *
+ * Example:
+  \code{.cpp}
+  // Batch a dataset of variable-length sequences under 1000 padded tokens
+  auto lengthfn = [ds](int64_t idx) { return ds->get(idx)[0].dim(0); };
+  BucketBatchDataset bucketds(ds, lengthfn, 1000);
+  \endcode
+ */
+class FL_API BucketBatchDataset : public Dataset {
+ public:
+  /**
+   * Returns the length (in tokens) of the sample at the given index.
+   */
+  using LengthFunction = std::function<int64_t(int64_t)>;
+
+  /**
+   * Creates a `BucketBatchDataset`.
+   * @param[in] dataset The underlying dataset.
+   * @param[in] lengthfn Functor returning each sample's length in tokens.
+   * @param[in] maxTokens Budget on `batchSize * maxLengthInBatch` per batch.
+   * @param[in] seed Seed for the epoch-wise batch order shuffle.
+   * @param[in] batchfns Custom batch function to use for difference indices.
+   */
+  BucketBatchDataset(
+      std::shared_ptr<const Dataset> dataset,
+      const LengthFunction& lengthfn,
+      int64_t maxTokens,
+      int seed = 0,
+      const std::vector<BatchFunction>& batchfns = {});
+
+  int64_t size() const override;
+
+  std::vector<Tensor> get(const int64_t idx) const override;
+
+  /**
+   * Reshuffles the order in which batches are visited.
+   */
+  void resample();
+
+ private:
+  std::shared_ptr<const Dataset> dataset_;
+  std::vector<BatchFunction> batchFns_;
+  std::vector<std::vector<int64_t>> batches_;
+  std::vector<int64_t> batchOrder_;
+  int64_t seed_;
+  int64_t epoch_{0};
+};
+
+} // namespace fl
@@ -25,14 +25,25 @@ ConcatDataset::ConcatDataset(
 }
 
 std::vector<Tensor> ConcatDataset::get(const int64_t idx) const {
+  auto resolved = resolveIndex(idx);
+  return datasets_[resolved.first]->get(resolved.second);
+}
+
+const std::vector<std::shared_ptr<const Dataset>>&
+ConcatDataset::underlyingDatasets() const {
+  return datasets_;
+}
+
+std::pair<int64_t, int64_t> ConcatDataset::resolveIndex(
+    const int64_t idx) const {
   checkIndexBounds(idx);
 
-  // get sample from correct dataset
+  // find the dataset holding the sample
   int64_t datasetidx =
       std::upper_bound(
           cumulativedatasetsizes_.begin(), cumulativedatasetsizes_.end(), idx) -
       cumulativedatasetsizes_.begin() - 1;
-  return datasets_[datasetidx]->get(idx - cumulativedatasetsizes_[datasetidx]);
+  return {datasetidx, idx - cumulativedatasetsizes_[datasetidx]};
 }
 
 int64_t ConcatDataset::size() const {
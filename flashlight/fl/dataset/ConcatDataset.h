@@ -9,6 +9,7 @@
 
 #include "flashlight/fl/dataset/Dataset.h"
 
+#include <utility>
 #include <vector>
 
 namespace fl {
@@ -47,6 +48,17 @@ class FL_API ConcatDataset : public Dataset {
 
   std::vector<Tensor> get(const int64_t idx) const override;
 
+  /**
+   * Returns the underlying datasets, in concatenation order.
+   */
+  const std::vector<std::shared_ptr<const Dataset>>& underlyingDatasets() const;
+
+  /**
+   * Resolves `idx` to the ordinal of the underlying dataset holding the
+   * sample and the index within that dataset.
+   */
+  std::pair<int64_t, int64_t> resolveIndex(const int64_t idx) const;
+
  private:
   std::vector<std::shared_ptr<const Dataset>> datasets_;
   std::vector<int64_t> cumulativedatasetsizes_;
@@ -67,6 +67,29 @@ class FL_API Dataset {
    */
   virtual std::vector<Tensor> get(const int64_t idx) const = 0;
 
+  /**
+   * Fetches the samples in `[begin, end)` through a single virtual call.
+   * The default implementation loops over get(); datasets backed by
+   * contiguous storage can override it to assemble the whole range at once,
+   * and wrappers can override it to forward the range to the underlying
+   * dataset instead of paying per-sample dispatch.
+   * @param[in] begin Index of the first sample. Must satisfy
+   * `0 <= begin <= end`.
+   * @param[in] end One past the index of the last sample. Must be in
+   * [begin, size()].
+   * @return One entry per sample, each holding the sample fields.
+   */
+  virtual std::vector<std::vector<Tensor>> getRange(int64_t begin, int64_t end)
+      const {
+    checkRangeBounds(begin, end);
+    std::vector<std::vector<Tensor>> samples;
+    samples.reserve(end - begin);
+    for (int64_t idx = begin; idx < end; ++idx) {
+      samples.push_back(get(idx));
+    }
+    return samples;
+  }
+
   virtual ~Dataset() = default;
 
   // Setup iterators
@@ -86,6 +109,12 @@ class FL_API Dataset {
       throw std::out_of_range("Dataset idx out of range");
     }
   }
+
+  void checkRangeBounds(int64_t begin, int64_t end) const {
+    if (!(begin >= 0 && begin <= end && end <= size())) {
+      throw std::out_of_range("Dataset range out of range");
+    }
+  }
 };
 
 } // namespace fl
@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <future>
+#include <memory>
+
+#include "flashlight/fl/common/threadpool/ThreadPool.h"
+#include "flashlight/fl/dataset/Dataset.h"
+
+namespace fl {
+
+/**
+ * A view into a dataset which double-buffers samples on the active device:
+ * while the training loop computes on the current batch, a background thread
+ * fetches the next batch, stages any host-resident tensors through
+ * `PinnedMemoryPool` and forces their device materialization with `fl::eval`,
+ * so `get` hands back tensors whose upload has already been enqueued. This is
+ * the device-side counterpart of `PrefetchDataset` (which overlaps the host
+ * work of producing samples) and composes with it; place it outermost, after
+ * batching, so whole batches are uploaded at once.
+ *
+ * Like `PrefetchDataset`, it expects sequential access — a non-sequential
+ * index falls back to a synchronous fetch.
+ *
+ * Example:
+  \code{.cpp}
+  // batches come out of the usual host-side pipeline
+  auto batched = std::make_shared<BatchDataset>(prefetchDs, batchSize);
+  for (auto& batch : DevicePrefetchDataset(batched)) {
+      // batch tensors are device-resident; train on them
+  }
+  \endcode
+ */
+class FL_API DevicePrefetchDataset : public Dataset {
+ public:
+  /**
+   * Creates a `DevicePrefetchDataset`.
+   * @param[in] dataset The underlying dataset.
+   */
+  explicit DevicePrefetchDataset(std::shared_ptr<const Dataset> dataset);
+
+  int64_t size() const override;
+
+  std::vector<Tensor> get(const int64_t idx) const override;
+
+ private:
+  // fetches a sample and enqueues its device upload on the worker thread
+  std::vector<Tensor> fetchToDevice(int64_t idx) const;
+
+  std::shared_ptr<const Dataset> dataset_;
+  std::unique_ptr<ThreadPool> workerThread_;
+  // the single in-flight sample (double buffering)
+  mutable std::future<std::vector<Tensor>> nextSample_;
+  mutable int64_t nextIdx_{-1};
+};
+
+} // namespace fl
@@ -5,16 +5,25 @@
  * LICENSE file in the root directory of this source tree.
  */
 
+#include <cstring>
 #include <stdexcept>
 
 #include "flashlight/fl/dataset/FileBlobDataset.h"
 
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 namespace fl {
 
 FileBlobDataset::FileBlobDataset(
     const fs::path& name,
     bool rw,
-    bool truncate)
+    bool truncate,
+    bool memoryMap)
     : name_(name) {
   mode_ = (rw ? std::ios_base::in | std::ios_base::out : std::ios_base::in);
   {
@@ -23,6 +32,43 @@ FileBlobDataset::FileBlobDataset(
       throw std::runtime_error("could not open file " + name.string());
     }
   }
+  if (memoryMap) {
+    if (rw) {
+      throw std::invalid_argument(
+          "FileBlobDataset - memory-mapped mode requires read-only mode");
+    }
+#ifdef _WIN32
+    throw std::runtime_error(
+        "FileBlobDataset - memory-mapped mode is not supported on Windows");
+#else
+    int fd = ::open(name_.c_str(), O_RDONLY);
+    if (fd < 0) {
+      throw std::runtime_error("could not open file " + name.string());
+    }
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+      ::close(fd);
+      throw std::runtime_error("could not stat file " + name.string());
+    }
+    if (st.st_size > 0) {
+      void* ptr = ::mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+      if (ptr == MAP_FAILED) {
+        ::close(fd);
+        throw std::runtime_error("could not mmap file " + name.string());
+      }
+      mapping_ = ptr;
+      mappingSize_ = st.st_size;
+    }
+    // the mapping keeps its own reference to the file
+    ::close(fd);
+#endif
+  }
+  if (!rw) {
+    // read-only blobs go through the asynchronous reader, which keeps the
+    // storage queue busy and can honor readahead hints, rather than through
+    // one synchronous stream read at a time
+    reader_ = std::make_unique<AsyncFileReader>(name_);
+  }
   readIndex();
 }
 
@@ -79,6 +125,14 @@ int64_t FileBlobDataset::writeData(
 
 int64_t FileBlobDataset::readData(int64_t offset, char* data, int64_t size)
     const {
+  if (const char* mapped = mappedData(offset, size)) {
+    std::memcpy(data, mapped, size);
+    return size;
+  }
+  if (reader_) {
+    reader_->read({{offset, size, data}});
+    return size;
+  }
   auto fs = getStream();
   fs->seekg(offset, std::ios_base::beg);
   fs->read(data, size);
@@ -90,6 +144,13 @@ void FileBlobDataset::flushData() {
   fs->flush();
 }
 
+const char* FileBlobDataset::mappedData(int64_t offset, int64_t size) const {
+  if (mapping_ == nullptr || offset < 0 || offset + size > mappingSize_) {
+    return nullptr;
+  }
+  return static_cast<const char*>(mapping_) + offset;
+}
+
 bool FileBlobDataset::isEmptyData() const {
   auto fs = getStream();
   fs->seekg(0, std::ios_base::end);
@@ -97,6 +158,11 @@ bool FileBlobDataset::isEmptyData() const {
 }
 
 FileBlobDataset::~FileBlobDataset() {
+#ifndef _WIN32
+  if (mapping_ != nullptr) {
+    ::munmap(mapping_, mappingSize_);
+  }
+#endif
   std::lock_guard<std::mutex> lock(afhmutex_);
   for (auto& weakFileHandles : allFileHandles_) {
     auto fileHandles = weakFileHandles.lock();
@@ -7,10 +7,12 @@
 
 #pragma once
 
+#include "flashlight/fl/common/AsyncFileReader.h"
 #include "flashlight/fl/common/Filesystem.h"
 #include "flashlight/fl/dataset/BlobDataset.h"
 
 #include <fstream>
+#include <memory>
 #include <mutex>
 
 namespace fl {
@@ -21,6 +23,10 @@ namespace fl {
  * As the arrays are stored on disk, sequential access will be the most
  * efficient.
  *
+ * In read-only mode, the blob can be memory-mapped: get() then builds
+ * tensors directly over the mapped pages without copying through userspace
+ * buffers, so the OS page cache acts as the dataset cache across epochs.
+ *
  */
 class FL_API FileBlobDataset : public BlobDataset {
  public:
@@ -32,11 +38,14 @@ class FL_API FileBlobDataset : public BlobDataset {
    * previous stored samples will be read.
    * @param[in] truncate In read-write mode, truncate the files if it
    * already exists.
+   * @param[in] memoryMap If true, memory-map the blob for zero-copy reads.
+   * Only supported in read-only mode, on POSIX systems.
    */
   explicit FileBlobDataset(
       const fs::path& name,
       bool rw = false,
-      bool truncate = false);
+      bool truncate = false,
+      bool memoryMap = false);
 
   virtual ~FileBlobDataset() override;
 
@@ -46,10 +55,15 @@ class FL_API FileBlobDataset : public BlobDataset {
   int64_t readData(int64_t offset, char* data, int64_t size) const override;
   void flushData() override;
   bool isEmptyData() const override;
+  const char* mappedData(int64_t offset, int64_t size) const override;
 
  private:
   fs::path name_;
   std::ios_base::openmode mode_;
+  void* mapping_{nullptr};
+  int64_t mappingSize_{0};
+  // serves read-only blobs; see readData()
+  std::unique_ptr<AsyncFileReader> reader_;
   std::shared_ptr<std::fstream> getStream() const;
 
   mutable std::vector<std::weak_ptr<
@@ -19,7 +19,16 @@ int64_t MemoryBlobDataset::writeData(
     int64_t offset,
     const char* data,
     int64_t size) const {
-  std::lock_guard<std::mutex> lock(writeMutex_);
+  {
+    // Fast path: regions reserved through reserveData() are disjoint, so
+    // concurrent writers only need to exclude buffer growth.
+    std::shared_lock<std::shared_mutex> lock(writeMutex_);
+    if (offset + size <= static_cast<int64_t>(data_.size())) {
+      std::memcpy(data_.data() + offset, data, size);
+      return size;
+    }
+  }
+  std::unique_lock<std::shared_mutex> lock(writeMutex_);
   if (offset + size > data_.size()) {
     data_.resize(offset + size);
   }
@@ -39,7 +48,14 @@ int64_t MemoryBlobDataset::readData(int64_t offset, char* data, int64_t size)
 }
 
 void MemoryBlobDataset::flushData() {
-  std::lock_guard<std::mutex> lock(writeMutex_);
+  std::unique_lock<std::shared_mutex> lock(writeMutex_);
+}
+
+void MemoryBlobDataset::reserveData(int64_t size) {
+  std::unique_lock<std::shared_mutex> lock(writeMutex_);
+  if (size > static_cast<int64_t>(data_.size())) {
+    data_.resize(size);
+  }
 }
 
 bool MemoryBlobDataset::isEmptyData() const {
@@ -10,7 +10,7 @@
 #include "flashlight/fl/dataset/BlobDataset.h"
 
 #include <fstream>
-#include <mutex>
+#include <shared_mutex>
 
 namespace fl {
 
@@ -20,6 +20,10 @@ namespace fl {
  * As the arrays are stored on disk, sequential access will be the most
  * efficient.
  *
+ * Writes from add() proceed concurrently: the buffer is grown up front via
+ * reserveData() while index space is reserved, so writers copy into their
+ * disjoint regions under a shared lock; only buffer growth is exclusive.
+ *
  */
 class FL_API MemoryBlobDataset : public BlobDataset {
  public:
@@ -36,9 +40,10 @@ class FL_API MemoryBlobDataset : public BlobDataset {
   int64_t readData(int64_t offset, char* data, int64_t size) const override;
   void flushData() override;
   bool isEmptyData() const override;
+  void reserveData(int64_t size) override;
 
  private:
-  mutable std::mutex writeMutex_;
+  mutable std::shared_mutex writeMutex_;
   mutable std::vector<char> data_;
 };
 
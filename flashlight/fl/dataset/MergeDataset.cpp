@@ -35,6 +35,29 @@ std::vector<Tensor> MergeDataset::get(const int64_t idx) const {
   return result;
 }
 
+std::vector<std::vector<Tensor>> MergeDataset::getRange(
+    int64_t begin,
+    int64_t end) const {
+  checkRangeBounds(begin, end);
+  // fetch each underlying dataset's overlap of the range once
+  std::vector<std::vector<Tensor>> samples(end - begin);
+  for (const auto& dataset : datasets_) {
+    auto available = std::min(end, dataset->size());
+    if (begin >= available) {
+      continue;
+    }
+    auto part = dataset->getRange(begin, available);
+    for (int64_t idx = 0; idx < part.size(); ++idx) {
+      auto& fields = part[idx];
+      samples[idx].insert(
+          samples[idx].end(),
+          std::make_move_iterator(fields.begin()),
+          std::make_move_iterator(fields.end()));
+    }
+  }
+  return samples;
+}
+
 int64_t MergeDataset::size() const {
   return size_;
 }
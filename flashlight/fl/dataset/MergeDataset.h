@@ -53,6 +53,9 @@ class FL_API MergeDataset : public Dataset {
 
   std::vector<Tensor> get(const int64_t idx) const override;
 
+  std::vector<std::vector<Tensor>> getRange(int64_t begin, int64_t end)
+      const override;
+
  private:
   std::vector<std::shared_ptr<const Dataset>> datasets_;
   int64_t size_;
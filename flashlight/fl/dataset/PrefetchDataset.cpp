@@ -5,23 +5,41 @@
  * LICENSE file in the root directory of this source tree.
  */
 
+#include <algorithm>
+#include <chrono>
 #include <memory>
 #include <stdexcept>
 
+#include "flashlight/fl/common/EventLog.h"
 #include "flashlight/fl/common/Serialization.h"
+#include "flashlight/fl/common/Trace.h"
 #include "flashlight/fl/dataset/PrefetchDataset.h"
 #include "flashlight/fl/tensor/Compute.h"
 
+namespace {
+
+// gets between tuning decisions
+constexpr int64_t kTuneWindow = 64;
+// structured event ids (see EventLog.h)
+constexpr uint16_t kPrefetchDepthEventId = 801;
+constexpr uint16_t kPrefetchBlockedEventId = 802;
+
+} // namespace
+
 namespace fl {
 
 PrefetchDataset::PrefetchDataset(
     std::shared_ptr<const Dataset> dataset,
     int64_t numThreads,
-    int64_t prefetchSize)
+    int64_t prefetchSize,
+    int64_t readyWatermark,
+    bool autoTune)
     : dataset_(dataset),
       numThreads_(numThreads),
       prefetchSize_(prefetchSize),
-      curIdx_(-1) {
+      curIdx_(-1),
+      readyWatermark_(readyWatermark),
+      autoTune_(autoTune) {
   if (!dataset_) {
     throw std::invalid_argument("dataset to be prefetched is null");
   }
@@ -29,21 +47,37 @@ PrefetchDataset::PrefetchDataset(
       !(numThreads_ == 0 && prefetchSize_ == 0)) {
     throw std::invalid_argument("invalid numThreads or prefetchSize");
   }
+  if (readyWatermark_ < 0 || (readyWatermark_ > 0 && numThreads_ == 0)) {
+    throw std::invalid_argument("invalid readyWatermark");
+  }
+  if (autoTune_ && (readyWatermark_ > 0 || numThreads_ == 0)) {
+    throw std::invalid_argument(
+        "auto-tuning requires the threaded in-order queue mode");
+  }
+  maxPrefetchSize_ = 4 * prefetchSize_;
   if (numThreads_ > 0) {
     auto deviceId = fl::getDevice();
     threadPool_ = std::make_unique<ThreadPool>(
         numThreads_,
         [deviceId](int /* threadId */) { fl::setDevice(deviceId); });
   }
+  if (readyWatermark_ > 0) {
+    slots_.resize(prefetchSize_);
+  }
 }
 
 std::vector<Tensor> PrefetchDataset::get(int64_t idx) const {
+  FL_TRACE_SCOPE("PrefetchDataset::get");
   checkIndexBounds(idx);
 
   if (numThreads_ == 0) {
     return dataset_->get(idx);
   }
 
+  if (readyWatermark_ > 0) {
+    return getOutOfOrder(idx);
+  }
+
   // remove from cache (if necessary)
   while (!prefetchCache_.empty() && idx != curIdx_) {
     prefetchCache_.pop();
@@ -60,6 +94,16 @@ std::vector<Tensor> PrefetchDataset::get(int64_t idx) const {
         [this, fetchIdx]() { return this->dataset_->get(fetchIdx); }));
   }
 
+  if (autoTune_) {
+    // the consumer "blocked" if its sample was not finished when asked for
+    blockedGets_ +=
+        prefetchCache_.front().wait_for(std::chrono::seconds(0)) !=
+        std::future_status::ready;
+    if (++windowGets_ >= kTuneWindow) {
+      retune();
+    }
+  }
+
   auto curSample = prefetchCache_.front().get();
 
   prefetchCache_.pop();
@@ -67,6 +111,101 @@ std::vector<Tensor> PrefetchDataset::get(int64_t idx) const {
   return curSample;
 }
 
+void PrefetchDataset::retune() const {
+  // grow aggressively while the consumer still waits; once a full window
+  // passes without waiting, give a step of depth back to cap the host
+  // memory held by prefetched samples
+  if (blockedGets_ * 10 > windowGets_) {
+    prefetchSize_ = std::min(2 * prefetchSize_, maxPrefetchSize_);
+  } else if (blockedGets_ == 0) {
+    prefetchSize_ = std::max(prefetchSize_ - 1, minPrefetchSize_);
+  }
+  FL_EVENT(2, kPrefetchDepthEventId, prefetchSize_);
+  FL_EVENT(2, kPrefetchBlockedEventId, blockedGets_);
+  windowGets_ = 0;
+  blockedGets_ = 0;
+}
+
+int64_t PrefetchDataset::prefetchSize() const {
+  return prefetchSize_;
+}
+
+std::vector<Tensor> PrefetchDataset::getOutOfOrder(int64_t idx) const {
+  std::unique_lock<std::mutex> lock(slotMutex_);
+
+  // Non-sequential access: drain outstanding work and reset the ring.
+  if (idx != curIdx_) {
+    flushing_ = true;
+    slotFreed_.notify_all();
+    slotReady_.wait(lock, [this]() { return inFlight_ == 0; });
+    for (auto& slot : slots_) {
+      slot.sample.clear();
+      slot.idx = -1;
+      slot.ready = false;
+    }
+    readyCount_ = 0;
+    flushing_ = false;
+    curIdx_ = idx;
+    nextFetchIdx_ = idx;
+  }
+
+  // Top up the prefetch window. Consecutive indices and the window bound
+  // guarantee each in-flight or resident sample maps to a distinct slot.
+  while (inFlight_ + readyCount_ < prefetchSize_ && nextFetchIdx_ < size()) {
+    auto fetchIdx = nextFetchIdx_++;
+    ++inFlight_;
+    threadPool_->enqueue([this, fetchIdx]() {
+      std::unique_lock<std::mutex> workerLock(slotMutex_);
+      // Backpressure: hold off while enough completed samples are already
+      // resident -- except for the sample the consumer is waiting on.
+      slotFreed_.wait(workerLock, [this, fetchIdx]() {
+        return readyCount_ < readyWatermark_ || fetchIdx == curIdx_ ||
+            flushing_;
+      });
+      if (flushing_) {
+        --inFlight_;
+        slotReady_.notify_all();
+        return;
+      }
+      workerLock.unlock();
+      auto sample = dataset_->get(fetchIdx);
+      workerLock.lock();
+      if (!flushing_) {
+        auto& slot = slots_[fetchIdx % slots_.size()];
+        slot.sample = std::move(sample);
+        slot.idx = fetchIdx;
+        slot.ready = true;
+        ++readyCount_;
+      }
+      --inFlight_;
+      slotReady_.notify_all();
+    });
+  }
+
+  auto& slot = slots_[idx % slots_.size()];
+  slotReady_.wait(lock, [&slot, idx]() { return slot.ready && slot.idx == idx; });
+  auto curSample = std::move(slot.sample);
+  slot.sample.clear();
+  slot.idx = -1;
+  slot.ready = false;
+  --readyCount_;
+  curIdx_ = idx + 1;
+  slotFreed_.notify_all();
+  return curSample;
+}
+
+PrefetchDataset::~PrefetchDataset() {
+  if (threadPool_ && !slots_.empty()) {
+    {
+      std::lock_guard<std::mutex> lock(slotMutex_);
+      flushing_ = true;
+    }
+    // release backpressured workers so the pool can join
+    slotFreed_.notify_all();
+    threadPool_.reset();
+  }
+}
+
 int64_t PrefetchDataset::size() const {
   return dataset_->size();
 }
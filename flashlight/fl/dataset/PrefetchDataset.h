@@ -7,8 +7,11 @@
 
 #pragma once
 
+#include <condition_variable>
 #include <future>
+#include <mutex>
 #include <queue>
+#include <vector>
 
 #include "flashlight/fl/common/threadpool/ThreadPool.h"
 #include "flashlight/fl/dataset/Dataset.h"
@@ -34,6 +37,21 @@ namespace fl {
       // do something
   }
   \endcode
+ *
+ * With a positive `readyWatermark`, completed samples are deposited
+ * out-of-order in a bounded ring of slots instead of a future queue, and
+ * workers hold off fetching further samples while `readyWatermark` completed
+ * samples are already resident. This bounds the host memory pinned by
+ * prefetched-but-unconsumed samples when some samples (e.g. heavily
+ * augmented ones) take much longer to produce than others.
+ *
+ * With `autoTune`, the prefetch depth adapts at runtime instead of staying
+ * at the constructed value: the dataset tracks how often the consumer
+ * blocked on a sample that was not ready, and every tuning window doubles
+ * the depth while the consumer still waits (up to four times the
+ * constructed depth) or steps it back down once a full window went by
+ * without waiting. The observed depth and per-window block counts are
+ * recorded through the structured event log (see EventLog.h).
  */
 class FL_API PrefetchDataset : public Dataset {
  public:
@@ -42,25 +60,70 @@ class FL_API PrefetchDataset : public Dataset {
    * @param[in] dataset The underlying dataset.
    * @param[in] numThreads Number of threads used by the threadpool
    * @param[in] prefetchSize Number of samples to be prefetched
+   * @param[in] readyWatermark If positive, enables the out-of-order ring
+   * mode: at most `readyWatermark` completed samples are kept resident
+   * before workers pause fetching (backpressure). 0 (default) keeps the
+   * in-order future queue.
+   * @param[in] autoTune Adapt the prefetch depth at runtime from consumer
+   * wait telemetry. Only supported in the in-order queue mode (the ring's
+   * slot count is fixed at construction).
    */
   explicit PrefetchDataset(
       std::shared_ptr<const Dataset> dataset,
       int64_t numThreads,
-      int64_t prefetchSize);
+      int64_t prefetchSize,
+      int64_t readyWatermark = 0,
+      bool autoTune = false);
 
   int64_t size() const override;
 
   std::vector<Tensor> get(const int64_t idx) const override;
 
+  /**
+   * The current prefetch depth; differs from the constructed depth only when
+   * auto-tuning is enabled.
+   */
+  int64_t prefetchSize() const;
+
+  ~PrefetchDataset() override;
+
  protected:
   std::shared_ptr<const Dataset> dataset_;
-  int64_t numThreads_, prefetchSize_;
+  int64_t numThreads_;
+  // adapted at runtime when autoTune_ is set
+  mutable int64_t prefetchSize_;
 
  private:
+  std::vector<Tensor> getOutOfOrder(int64_t idx) const;
+  void retune() const;
+
   std::unique_ptr<ThreadPool> threadPool_;
   // state variables
   mutable std::queue<std::future<std::vector<Tensor>>> prefetchCache_;
   mutable int64_t curIdx_;
+
+  // out-of-order ring mode (readyWatermark_ > 0)
+  struct PrefetchSlot {
+    std::vector<Tensor> sample;
+    int64_t idx{-1};
+    bool ready{false};
+  };
+  int64_t readyWatermark_;
+  mutable std::vector<PrefetchSlot> slots_;
+  mutable std::mutex slotMutex_;
+  mutable std::condition_variable slotReady_; // signals the consumer
+  mutable std::condition_variable slotFreed_; // releases worker backpressure
+  mutable int64_t readyCount_{0}; // completed, unconsumed samples
+  mutable int64_t inFlight_{0}; // enqueued, uncompleted samples
+  mutable int64_t nextFetchIdx_{0};
+  mutable bool flushing_{false};
+
+  // auto-tuning state (autoTune_ set)
+  bool autoTune_;
+  int64_t minPrefetchSize_{1};
+  int64_t maxPrefetchSize_{1};
+  mutable int64_t windowGets_{0}; // gets observed in the current window
+  mutable int64_t blockedGets_{0}; // of those, how many had to wait
 };
 
 } // namespace fl
@@ -0,0 +1,299 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <cstring>
+#include <stdexcept>
+
+#include "flashlight/fl/dataset/ProcessPrefetchDataset.h"
+#include "flashlight/fl/tensor/Types.h"
+
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+namespace fl {
+
+namespace {
+
+// Worker status bytes sent over the response pipe.
+constexpr char kStatusOk = 0;
+constexpr char kStatusArenaOverflow = 1;
+constexpr char kStatusError = 2;
+
+constexpr int64_t kAlignment = 8;
+
+int64_t alignUp(int64_t offset) {
+  return (offset + kAlignment - 1) / kAlignment * kAlignment;
+}
+
+#ifndef _WIN32
+bool readFull(int fd, void* data, size_t size) {
+  auto* bytes = static_cast<char*>(data);
+  while (size > 0) {
+    auto n = ::read(fd, bytes, size);
+    if (n < 0 && errno == EINTR) {
+      continue;
+    }
+    if (n <= 0) {
+      return false;
+    }
+    bytes += n;
+    size -= n;
+  }
+  return true;
+}
+
+bool writeFull(int fd, const void* data, size_t size) {
+  const auto* bytes = static_cast<const char*>(data);
+  while (size > 0) {
+    auto n = ::write(fd, bytes, size);
+    if (n < 0 && errno == EINTR) {
+      continue;
+    }
+    if (n <= 0) {
+      return false;
+    }
+    bytes += n;
+    size -= n;
+  }
+  return true;
+}
+#endif
+
+} // namespace
+
+ProcessPrefetchDataset::ProcessPrefetchDataset(
+    std::shared_ptr<const Dataset> dataset,
+    int64_t numWorkers,
+    int64_t arenaBytes /* = (64 << 20) */)
+    : dataset_(dataset), numWorkers_(numWorkers), arenaBytes_(arenaBytes) {
+  if (!dataset_) {
+    throw std::invalid_argument("dataset to be prefetched is null");
+  }
+  if (numWorkers_ < 0 || arenaBytes_ <= 0) {
+    throw std::invalid_argument("invalid numWorkers or arenaBytes");
+  }
+#ifdef _WIN32
+  if (numWorkers_ > 0) {
+    throw std::runtime_error(
+        "ProcessPrefetchDataset is not supported on Windows");
+  }
+#else
+  for (int64_t i = 0; i < numWorkers_; i++) {
+    Worker worker;
+    int requestPipe[2];
+    int responsePipe[2];
+    if (::pipe(requestPipe) != 0 || ::pipe(responsePipe) != 0) {
+      throw std::runtime_error(
+          "ProcessPrefetchDataset - could not create worker pipes");
+    }
+    worker.arena = ::mmap(
+        nullptr,
+        arenaBytes_,
+        PROT_READ | PROT_WRITE,
+        MAP_SHARED | MAP_ANONYMOUS,
+        -1,
+        0);
+    if (worker.arena == MAP_FAILED) {
+      throw std::runtime_error(
+          "ProcessPrefetchDataset - could not map worker arena");
+    }
+    auto pid = ::fork();
+    if (pid < 0) {
+      throw std::runtime_error(
+          "ProcessPrefetchDataset - could not fork worker");
+    }
+    if (pid == 0) {
+      // worker process
+      ::close(requestPipe[1]);
+      ::close(responsePipe[0]);
+      worker.requestFd = requestPipe[0];
+      worker.responseFd = responsePipe[1];
+      workerLoop(worker);
+      ::_exit(0);
+    }
+    ::close(requestPipe[0]);
+    ::close(responsePipe[1]);
+    worker.pid = pid;
+    worker.requestFd = requestPipe[1];
+    worker.responseFd = responsePipe[0];
+    workers_.push_back(worker);
+    freeWorkers_.push_back(i);
+  }
+#endif
+}
+
+void ProcessPrefetchDataset::workerLoop(const Worker& worker) const {
+#ifndef _WIN32
+  int64_t idx;
+  while (readFull(worker.requestFd, &idx, sizeof(idx)) && idx >= 0) {
+    char status = kStatusOk;
+    try {
+      auto sample = dataset_->get(idx);
+      // Arena layout: <numTensors> then per tensor <type> <ndim> <dims...>
+      // followed by the 8-byte-aligned raw host bytes.
+      auto* base = static_cast<char*>(worker.arena);
+      int64_t offset = 0;
+      auto put = [&base, &offset](int64_t value) {
+        std::memcpy(base + offset, &value, sizeof(int64_t));
+        offset += sizeof(int64_t);
+      };
+      // precompute the footprint to detect overflow before writing
+      int64_t needed = sizeof(int64_t);
+      for (const auto& tensor : sample) {
+        needed += (2 + tensor.ndim()) * sizeof(int64_t);
+        needed = alignUp(needed) + alignUp(tensor.bytes());
+      }
+      if (needed > arenaBytes_) {
+        status = kStatusArenaOverflow;
+      } else {
+        put(sample.size());
+        for (const auto& tensor : sample) {
+          put(static_cast<int64_t>(tensor.type()));
+          put(tensor.ndim());
+          for (int i = 0; i < tensor.ndim(); ++i) {
+            put(tensor.dim(i));
+          }
+          offset = alignUp(offset);
+          if (tensor.bytes() > 0) {
+            tensor.host(base + offset);
+          }
+          offset = alignUp(offset + tensor.bytes());
+        }
+      }
+    } catch (...) {
+      status = kStatusError;
+    }
+    if (!writeFull(worker.responseFd, &status, sizeof(status))) {
+      break;
+    }
+  }
+#endif
+}
+
+void ProcessPrefetchDataset::dispatch(int workerId, int64_t idx) const {
+#ifndef _WIN32
+  if (!writeFull(workers_[workerId].requestFd, &idx, sizeof(idx))) {
+    throw std::runtime_error(
+        "ProcessPrefetchDataset - lost connection to worker");
+  }
+#endif
+}
+
+std::vector<Tensor> ProcessPrefetchDataset::collect(int workerId) const {
+  std::vector<Tensor> sample;
+#ifndef _WIN32
+  const auto& worker = workers_[workerId];
+  char status;
+  if (!readFull(worker.responseFd, &status, sizeof(status))) {
+    throw std::runtime_error(
+        "ProcessPrefetchDataset - lost connection to worker");
+  }
+  if (status == kStatusArenaOverflow) {
+    throw std::runtime_error(
+        "ProcessPrefetchDataset - sample does not fit in the worker arena; "
+        "increase arenaBytes");
+  }
+  if (status != kStatusOk) {
+    throw std::runtime_error(
+        "ProcessPrefetchDataset - worker failed to fetch sample");
+  }
+  const auto* base = static_cast<const char*>(worker.arena);
+  int64_t offset = 0;
+  auto take = [&base, &offset]() {
+    int64_t value;
+    std::memcpy(&value, base + offset, sizeof(int64_t));
+    offset += sizeof(int64_t);
+    return value;
+  };
+  auto numTensors = take();
+  for (int64_t i = 0; i < numTensors; ++i) {
+    auto type = static_cast<fl::dtype>(take());
+    auto ndim = take();
+    std::vector<Dim> dims(ndim);
+    for (int64_t d = 0; d < ndim; ++d) {
+      dims[d] = take();
+    }
+    offset = alignUp(offset);
+    Shape shape(dims);
+    auto bytes = fl::getTypeSize(type) * shape.elements();
+    if (shape.elements() > 0) {
+      sample.push_back(Tensor::fromBuffer(
+          shape,
+          type,
+          reinterpret_cast<const uint8_t*>(base + offset),
+          MemoryLocation::Host));
+    } else {
+      sample.push_back(Tensor());
+    }
+    offset = alignUp(offset + bytes);
+  }
+#endif
+  return sample;
+}
+
+std::vector<Tensor> ProcessPrefetchDataset::get(const int64_t idx) const {
+  checkIndexBounds(idx);
+
+  if (numWorkers_ == 0) {
+    return dataset_->get(idx);
+  }
+
+  // discard in-flight results that do not line up with the requested index
+  while (!inFlight_.empty() && idx != curIdx_) {
+    auto front = inFlight_.front();
+    inFlight_.pop();
+    collect(front.first);
+    freeWorkers_.push_back(front.first);
+    ++curIdx_;
+  }
+
+  // keep every worker busy with the indices following `idx`
+  while (!freeWorkers_.empty()) {
+    auto fetchIdx = idx + static_cast<int64_t>(inFlight_.size());
+    if (fetchIdx >= size()) {
+      break;
+    }
+    auto workerId = freeWorkers_.back();
+    freeWorkers_.pop_back();
+    dispatch(workerId, fetchIdx);
+    inFlight_.emplace(workerId, fetchIdx);
+  }
+
+  auto front = inFlight_.front();
+  inFlight_.pop();
+  auto curSample = collect(front.first);
+  freeWorkers_.push_back(front.first);
+  curIdx_ = idx + 1;
+  return curSample;
+}
+
+int64_t ProcessPrefetchDataset::size() const {
+  return dataset_->size();
+}
+
+ProcessPrefetchDataset::~ProcessPrefetchDataset() {
+#ifndef _WIN32
+  for (auto& worker : workers_) {
+    int64_t stop = -1;
+    writeFull(worker.requestFd, &stop, sizeof(stop));
+    ::close(worker.requestFd);
+    ::close(worker.responseFd);
+    if (worker.pid > 0) {
+      int wstatus;
+      ::waitpid(worker.pid, &wstatus, 0);
+    }
+    if (worker.arena != nullptr) {
+      ::munmap(worker.arena, arenaBytes_);
+    }
+  }
+#endif
+}
+
+} // namespace fl
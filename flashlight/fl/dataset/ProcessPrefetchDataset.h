@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <queue>
+#include <utility>
+#include <vector>
+
+#include "flashlight/fl/dataset/Dataset.h"
+
+namespace fl {
+
+/**
+ * A view into a dataset where samples are fetched by persistent worker
+ * processes and returned through per-worker shared-memory arenas.
+ *
+ * Unlike PrefetchDataset, whose threads share the parent's address space
+ * and can contend on library-internal locks (image decoders, audio
+ * augmentation, allocators), each worker here is a forked process with its
+ * own copy of those libraries, so decode-heavy pipelines scale with cores.
+ * Workers write sample bytes straight into an anonymous shared mapping;
+ * only the sample index and a status byte cross the worker pipes.
+ *
+ * The underlying dataset must be fork-safe: workers run its get() in a
+ * child process, so it must not rely on device contexts or threads created
+ * in the parent (CPU-side decode/augmentation pipelines qualify). Sequential
+ * access is assumed, as with PrefetchDataset.
+ *
+ * Not supported on Windows.
+ */
+class FL_API ProcessPrefetchDataset : public Dataset {
+ public:
+  /**
+   * Creates a `ProcessPrefetchDataset`.
+   * @param[in] dataset The underlying dataset.
+   * @param[in] numWorkers Number of persistent worker processes. 0 disables
+   * prefetching and fetches on the calling process.
+   * @param[in] arenaBytes Size of each worker's shared-memory arena; must be
+   * large enough to hold any single sample.
+   */
+  explicit ProcessPrefetchDataset(
+      std::shared_ptr<const Dataset> dataset,
+      int64_t numWorkers,
+      int64_t arenaBytes = (64 << 20));
+
+  int64_t size() const override;
+
+  std::vector<Tensor> get(const int64_t idx) const override;
+
+  ~ProcessPrefetchDataset() override;
+
+ protected:
+  std::shared_ptr<const Dataset> dataset_;
+  int64_t numWorkers_;
+  int64_t arenaBytes_;
+
+ private:
+  struct Worker {
+    int pid{-1};
+    int requestFd{-1}; // parent writes sample indices
+    int responseFd{-1}; // worker writes a status byte per sample
+    void* arena{nullptr};
+  };
+
+  void workerLoop(const Worker& worker) const;
+  void dispatch(int workerId, int64_t idx) const;
+  std::vector<Tensor> collect(int workerId) const;
+
+  std::vector<Worker> workers_;
+  // state variables
+  mutable std::queue<std::pair<int, int64_t>> inFlight_; // {workerId, idx}
+  mutable std::vector<int> freeWorkers_;
+  mutable int64_t curIdx_{-1};
+};
+
+} // namespace fl
@@ -19,17 +19,6 @@ std::vector<int64_t> makeIdentityPermutation(int64_t size) {
   return perm;
 }
 
-std::vector<int64_t> makePermutationFromFn(
-    int64_t size,
-    const fl::Dataset::PermutationFunction& fn) {
-  if (!fn) {
-    throw std::invalid_argument("PermutationFunction is null");
-  }
-  auto perm = makeIdentityPermutation(size);
-  std::transform(perm.begin(), perm.end(), perm.begin(), fn);
-  return perm;
-}
-
 } // namespace
 
 namespace fl {
@@ -51,21 +40,57 @@ ResampleDataset::ResampleDataset(
     std::shared_ptr<const Dataset> dataset,
     const PermutationFunction& fn,
     int n)
-    : ResampleDataset(
-          dataset,
-          makePermutationFromFn(n == -1 ? dataset->size() : n, fn)) {}
+    : dataset_(dataset),
+      resampleFn_(fn),
+      resampleFnSize_(n == -1 ? dataset->size() : n) {
+  if (!dataset_) {
+    throw std::invalid_argument("dataset to be resampled is null");
+  }
+  if (!resampleFn_) {
+    throw std::invalid_argument("PermutationFunction is null");
+  }
+}
 
 void ResampleDataset::resample(std::vector<int64_t> resamplevec) {
   resampleVec_ = std::move(resamplevec);
+  resampleFn_ = nullptr;
 }
 
 std::vector<Tensor> ResampleDataset::get(const int64_t idx) const {
   checkIndexBounds(idx);
-  return dataset_->get(resampleVec_[idx]);
+  return dataset_->get(resampleFn_ ? resampleFn_(idx) : resampleVec_[idx]);
+}
+
+std::vector<std::vector<Tensor>> ResampleDataset::getRange(
+    int64_t begin,
+    int64_t end) const {
+  checkRangeBounds(begin, end);
+  // remapped indices are not contiguous; fetch them directly from the
+  // underlying dataset without re-dispatching through our own get()
+  std::vector<std::vector<Tensor>> samples;
+  samples.reserve(end - begin);
+  for (int64_t idx = begin; idx < end; ++idx) {
+    samples.push_back(
+        dataset_->get(resampleFn_ ? resampleFn_(idx) : resampleVec_[idx]));
+  }
+  return samples;
+}
+
+std::shared_ptr<const Dataset> ResampleDataset::underlyingDataset() const {
+  return dataset_;
+}
+
+bool ResampleDataset::hasMaterializedMapping() const {
+  return !resampleFn_;
+}
+
+int64_t ResampleDataset::resampledIndex(const int64_t idx) const {
+  checkIndexBounds(idx);
+  return resampleFn_ ? resampleFn_(idx) : resampleVec_[idx];
 }
 
 int64_t ResampleDataset::size() const {
-  return resampleVec_.size();
+  return resampleFn_ ? resampleFnSize_ : resampleVec_.size();
 }
 
 } // namespace fl
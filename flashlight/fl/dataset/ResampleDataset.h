@@ -53,7 +53,8 @@ class FL_API ResampleDataset : public Dataset {
   /**
    * Constructs a ResampleDataset with mapping specified by a function:
    * `ResampleDataset(ds, fn)->get(i) == ds->get(fn(i))`
-   * The function should be deterministic.
+   * The mapping is evaluated lazily on each access -- no index vector is
+   * materialized -- so the function should be deterministic and cheap.
    * @param[in] dataset The underlying dataset.
    * @param[in] resamplefn The function specifying the mapping.
    * @param[in] n The size of the new dataset (if -1, uses previous size)
@@ -67,14 +68,38 @@ class FL_API ResampleDataset : public Dataset {
 
   std::vector<Tensor> get(const int64_t idx) const override;
 
+  std::vector<std::vector<Tensor>> getRange(int64_t begin, int64_t end)
+      const override;
+
   /**
    * Changes the mapping used to resample the dataset.
    * @param[in] resamplevec The vector specifying the new mapping.
    */
   void resample(std::vector<int64_t> resamplevec);
 
+  /**
+   * Returns the dataset this view remaps into.
+   */
+  std::shared_ptr<const Dataset> underlyingDataset() const;
+
+  /**
+   * Returns true if the mapping is a materialized index vector. Function-based
+   * mappings are evaluated lazily and may change between accesses (e.g.
+   * ShuffleDataset reshuffles on `resample`), so they cannot be read back as a
+   * fixed vector.
+   */
+  bool hasMaterializedMapping() const;
+
+  /**
+   * Returns the index in the underlying dataset that `idx` maps to.
+   */
+  int64_t resampledIndex(const int64_t idx) const;
+
  protected:
   std::shared_ptr<const Dataset> dataset_;
   std::vector<int64_t> resampleVec_;
+  // lazy function-based mapping; when set, resampleVec_ is unused
+  PermutationFunction resampleFn_;
+  int64_t resampleFnSize_{0};
 };
 } // namespace fl
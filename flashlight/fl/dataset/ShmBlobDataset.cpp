@@ -0,0 +1,187 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+#include "flashlight/fl/dataset/ShmBlobDataset.h"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace fl {
+
+ShmBlobDataset::ShmBlobDataset(const std::string& name, bool rw, bool truncate)
+    : name_(name), rw_(rw) {
+#ifdef _WIN32
+  throw std::runtime_error("ShmBlobDataset is not supported on Windows");
+#else
+  int oflags = (rw_ ? O_RDWR | O_CREAT : O_RDONLY);
+  if (rw_ && truncate) {
+    oflags |= O_TRUNC;
+  }
+  fd_ = ::shm_open(name_.c_str(), oflags, S_IRUSR | S_IWUSR);
+  if (fd_ < 0) {
+    throw std::runtime_error(
+        "could not open shared memory segment " + name_);
+  }
+  struct stat st;
+  if (::fstat(fd_, &st) != 0) {
+    ::close(fd_);
+    throw std::runtime_error(
+        "could not stat shared memory segment " + name_);
+  }
+  if (st.st_size > 0) {
+    void* ptr = ::mmap(
+        nullptr,
+        st.st_size,
+        (rw_ ? PROT_READ | PROT_WRITE : PROT_READ),
+        MAP_SHARED,
+        fd_,
+        0);
+    if (ptr == MAP_FAILED) {
+      ::close(fd_);
+      throw std::runtime_error(
+          "could not mmap shared memory segment " + name_);
+    }
+    mapping_ = ptr;
+    mappingSize_ = st.st_size;
+  }
+  dataSize_ = st.st_size;
+#endif
+  readIndex();
+}
+
+void ShmBlobDataset::remap(int64_t size) const {
+#ifndef _WIN32
+  if (::ftruncate(fd_, size) != 0) {
+    throw std::runtime_error(
+        "could not resize shared memory segment " + name_);
+  }
+  if (mapping_ != nullptr) {
+    ::munmap(mapping_, mappingSize_);
+    mapping_ = nullptr;
+    mappingSize_ = 0;
+  }
+  if (size > 0) {
+    void* ptr =
+        ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+    if (ptr == MAP_FAILED) {
+      throw std::runtime_error(
+          "could not mmap shared memory segment " + name_);
+    }
+    mapping_ = ptr;
+    mappingSize_ = size;
+  }
+#endif
+}
+
+int64_t ShmBlobDataset::writeData(
+    int64_t offset,
+    const char* data,
+    int64_t size) const {
+  {
+    // Fast path: regions reserved through reserveData() are disjoint, so
+    // concurrent writers only need to exclude segment growth (which moves
+    // the mapping).
+    std::shared_lock<std::shared_mutex> lock(writeMutex_);
+    if (offset + size <= mappingSize_) {
+      std::memcpy(static_cast<char*>(mapping_) + offset, data, size);
+      int64_t end = dataSize_.load();
+      while (end < offset + size &&
+             !dataSize_.compare_exchange_weak(end, offset + size)) {
+      }
+      return size;
+    }
+  }
+  std::unique_lock<std::shared_mutex> lock(writeMutex_);
+  if (offset + size > mappingSize_) {
+    // Amortize growth so writes without a reserveData() hint do not remap
+    // the segment on every call.
+    remap(std::max(offset + size, mappingSize_ * 2));
+  }
+  std::memcpy(static_cast<char*>(mapping_) + offset, data, size);
+  int64_t end = dataSize_.load();
+  while (end < offset + size &&
+         !dataSize_.compare_exchange_weak(end, offset + size)) {
+  }
+  return size;
+}
+
+int64_t ShmBlobDataset::readData(int64_t offset, char* data, int64_t size)
+    const {
+  std::shared_lock<std::shared_mutex> lock(writeMutex_);
+  // what is available
+  int64_t maxSize = std::max(static_cast<int64_t>(0), dataSize_ - offset);
+  // min(what is available, wanted)
+  maxSize = std::min(maxSize, size);
+  if (maxSize > 0) {
+    std::memcpy(data, static_cast<const char*>(mapping_) + offset, maxSize);
+  }
+  return maxSize;
+}
+
+void ShmBlobDataset::flushData() {
+  if (!rw_) {
+    return;
+  }
+  // A shared mapping is immediately coherent across processes; trim the
+  // amortized growth back to the logical size so attaching readers see
+  // exactly the written bytes.
+  std::unique_lock<std::shared_mutex> lock(writeMutex_);
+  if (mappingSize_ != dataSize_) {
+    remap(dataSize_);
+  }
+}
+
+void ShmBlobDataset::reserveData(int64_t size) {
+  std::unique_lock<std::shared_mutex> lock(writeMutex_);
+  if (size > mappingSize_) {
+    remap(size);
+  }
+}
+
+const char* ShmBlobDataset::mappedData(int64_t offset, int64_t size) const {
+  // In read-write mode the mapping moves when the segment grows, so
+  // zero-copy pointers are only handed out for read-only attachments.
+  if (rw_ || mapping_ == nullptr || offset < 0 || offset + size > dataSize_) {
+    return nullptr;
+  }
+  return static_cast<const char*>(mapping_) + offset;
+}
+
+bool ShmBlobDataset::isEmptyData() const {
+  return (dataSize_ == 0);
+}
+
+void ShmBlobDataset::unlink(const std::string& name) {
+#ifndef _WIN32
+  if (::shm_unlink(name.c_str()) != 0 && errno != ENOENT) {
+    throw std::runtime_error(
+        "could not unlink shared memory segment " + name);
+  }
+#endif
+}
+
+ShmBlobDataset::~ShmBlobDataset() {
+#ifndef _WIN32
+  if (mapping_ != nullptr) {
+    ::munmap(mapping_, mappingSize_);
+  }
+  if (fd_ >= 0) {
+    ::close(fd_);
+  }
+#endif
+}
+
+} // namespace fl
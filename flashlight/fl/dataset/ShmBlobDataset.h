@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include "flashlight/fl/dataset/BlobDataset.h"
+
+#include <atomic>
+#include <shared_mutex>
+#include <string>
+
+namespace fl {
+
+/**
+ * A BlobDataset in a named POSIX shared-memory segment.
+ *
+ * Data-parallel training typically runs one process per device on a host;
+ * a MemoryBlobDataset held by each process multiplies the dataset RAM
+ * footprint by the number of local processes. With this dataset, a single
+ * process on the host (e.g. local rank 0) creates the segment in
+ * read-write mode, fills it with add() and publishes it with writeIndex();
+ * the remaining processes attach the same segment name read-only and share
+ * the one copy. Read-only attachments are zero-copy: get() builds tensors
+ * directly over the shared pages.
+ *
+ * The segment persists on the host after all processes detach; call
+ * unlink() once the dataset is no longer needed.
+ *
+ * Only supported on POSIX systems.
+ *
+ */
+class FL_API ShmBlobDataset : public BlobDataset {
+ public:
+  /**
+   * Creates or attaches a `ShmBlobDataset`, specifying a shared-memory
+   * segment name.
+   * @param[in] name A POSIX shared-memory segment name (e.g.
+   * "/fl-train-set").
+   * @param[in] rw If true, creates the segment if needed and opens it in
+   * read-write mode. This must be specified to use the add() and
+   * writeIndex() methods. Except if truncate is true, previous stored
+   * samples will be read.
+   * @param[in] truncate In read-write mode, discard the segment contents if
+   * it already exists.
+   */
+  explicit ShmBlobDataset(
+      const std::string& name,
+      bool rw = false,
+      bool truncate = false);
+
+  virtual ~ShmBlobDataset() override;
+
+  /**
+   * Removes the named segment from the host. Processes still attached keep
+   * a usable mapping until they destroy their dataset.
+   * @param[in] name A POSIX shared-memory segment name.
+   */
+  static void unlink(const std::string& name);
+
+ protected:
+  int64_t writeData(int64_t offset, const char* data, int64_t size)
+      const override;
+  int64_t readData(int64_t offset, char* data, int64_t size) const override;
+  void flushData() override;
+  bool isEmptyData() const override;
+  void reserveData(int64_t size) override;
+  const char* mappedData(int64_t offset, int64_t size) const override;
+
+ private:
+  // Grows (or trims) the segment and remaps it; callers must hold
+  // writeMutex_ exclusively.
+  void remap(int64_t size) const;
+
+  std::string name_;
+  bool rw_;
+  int fd_{-1};
+  mutable void* mapping_{nullptr};
+  mutable int64_t mappingSize_{0};
+  // Logical blob size; the segment itself can be larger while growth is
+  // amortized.
+  mutable std::atomic<int64_t> dataSize_{0};
+  mutable std::shared_mutex writeMutex_;
+};
+
+} // namespace fl
@@ -7,33 +7,86 @@
 
 #include "flashlight/fl/dataset/ShuffleDataset.h"
 
-#include <algorithm>
-#include <numeric>
+#include <random>
 
 namespace fl {
 
 ShuffleDataset::ShuffleDataset(
     std::shared_ptr<const Dataset> dataset,
     int seed /* = 0 */)
-    : ResampleDataset(dataset), rng_(seed) {
-  resample();
+    // the mapping is evaluated lazily; capturing `this` is safe because
+    // copy and move are deleted, so the fn can never outlive this object
+    : ResampleDataset(dataset, [this](int64_t idx) {
+        return permuteIndex(idx);
+      }) {
+  state_.seed = seed;
+  rebuildKeys();
 }
 
-void ShuffleDataset::resample() {
-  std::iota(resampleVec_.begin(), resampleVec_.end(), 0);
-  auto n = resampleVec_.size();
-  // custom implementation of shuffle -
-  // en.cppreference.com/w/cpp/algorithm/random_shuffle#Possible_implementation
-  using distr_t = std::uniform_int_distribution<unsigned int>;
-  distr_t D;
-  for (int i = n - 1; i > 0; --i) {
-    std::swap(
-        resampleVec_[i], resampleVec_[D(rng_, distr_t::param_type(0, i))]);
+int64_t ShuffleDataset::permuteIndex(int64_t idx) const {
+  const auto n = static_cast<uint64_t>(dataset_->size());
+  if (n <= 1) {
+    return idx;
+  }
+  const uint64_t halfMask = (uint64_t(1) << halfBits_) - 1;
+  auto x = static_cast<uint64_t>(idx);
+  // Feistel rounds over the smallest even-bit domain covering [0, n);
+  // cycle-walk until the image lands back inside [0, n). The expected
+  // number of walks is < 4 since the domain is < 4n.
+  do {
+    uint64_t left = x >> halfBits_;
+    uint64_t right = x & halfMask;
+    for (auto key : roundKeys_) {
+      // splitmix64-style round function
+      uint64_t f = right * 0x9e3779b97f4a7c15ULL + key;
+      f ^= f >> 30;
+      f *= 0xbf58476d1ce4e5b9ULL;
+      f ^= f >> 27;
+      f *= 0x94d049bb133111ebULL;
+      f ^= f >> 31;
+      uint64_t next = (left ^ f) & halfMask;
+      left = right;
+      right = next;
+    }
+    x = (left << halfBits_) | right;
+  } while (x >= n);
+  return static_cast<int64_t>(x);
+}
+
+void ShuffleDataset::rebuildKeys() {
+  // Keys depend only on (seed, epoch), so a saved State reproduces the
+  // permutation exactly.
+  std::mt19937_64 rng(state_.seed);
+  rng.discard(roundKeys_.size() * state_.epoch);
+  for (auto& key : roundKeys_) {
+    key = rng();
+  }
+  const auto n = static_cast<uint64_t>(dataset_->size());
+  int bits = 1;
+  while ((uint64_t(1) << bits) < n) {
+    ++bits;
   }
+  halfBits_ = (bits + 1) / 2;
+}
+
+void ShuffleDataset::resample() {
+  ++state_.epoch;
+  rebuildKeys();
 }
 
 void ShuffleDataset::setSeed(int seed) {
-  rng_.seed(seed);
+  state_.seed = seed;
+  state_.epoch = 0;
+  rebuildKeys();
+}
+
+ShuffleDataset::State ShuffleDataset::getState() const {
+  return state_;
+}
+
+void ShuffleDataset::setState(const State& state) {
+  state_ = state;
+  rebuildKeys();
 }
 
 } // namespace fl
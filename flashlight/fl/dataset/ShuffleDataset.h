@@ -7,8 +7,10 @@
 
 #pragma once
 
-#include <random>
+#include <array>
+#include <cstdint>
 
+#include "flashlight/fl/common/Serialization.h"
 #include "flashlight/fl/dataset/ResampleDataset.h"
 
 namespace fl {
@@ -16,6 +18,13 @@ namespace fl {
 /**
  * A view into a dataset, with indices permuted randomly.
  *
+ * The permutation is a constant-space pseudorandom bijection over [0, n)
+ * (a Feistel network with cycle-walking), evaluated lazily per access: no
+ * permutation vector is materialized, so resample() is O(1) in time and
+ * memory regardless of the dataset size. The permutation is fully
+ * determined by a small serializable State (seed and epoch), so it can be
+ * checkpointed and restored exactly.
+ *
  * Example:
   \code{.cpp}
   // Make a dataset with 100 samples
@@ -35,6 +44,18 @@ namespace fl {
  */
 class FL_API ShuffleDataset : public ResampleDataset {
  public:
+  /**
+   * The state fully determining the current permutation. Serializable with
+   * fl::save()/fl::load() for mid-training checkpoints.
+   */
+  struct State {
+    int64_t seed{0};
+    int64_t epoch{0};
+
+   private:
+    FL_SAVE_LOAD(seed, epoch)
+  };
+
   /**
    * Creates a `ShuffleDataset`.
    * @param[in] dataset The underlying dataset.
@@ -42,19 +63,46 @@ class FL_API ShuffleDataset : public ResampleDataset {
    */
   explicit ShuffleDataset(std::shared_ptr<const Dataset> dataset, int seed = 0);
 
+  // The resample fn held by the base captures `this`, so a copy or move
+  // would keep evaluating the source object's permutation.
+  ShuffleDataset(const ShuffleDataset&) = delete;
+  ShuffleDataset(ShuffleDataset&&) = delete;
+  ShuffleDataset& operator=(const ShuffleDataset&) = delete;
+  ShuffleDataset& operator=(ShuffleDataset&&) = delete;
+
   /**
-   * Generates a new random permutation for the dataset.
+   * Advances to the next epoch's permutation.
    */
   void resample();
 
   /**
-   * Sets the PRNG seed.
+   * Sets the PRNG seed and resets to that seed's first permutation.
    * @param[in] seed The desired seed.
    */
   void setSeed(int seed);
 
+  /**
+   * Returns the state determining the current permutation.
+   */
+  State getState() const;
+
+  /**
+   * Restores a previously saved permutation state.
+   * @param[in] state The state to restore.
+   */
+  void setState(const State& state);
+
  protected:
-  std::mt19937_64 rng_;
+  int64_t permuteIndex(int64_t idx) const;
+
+ private:
+  void rebuildKeys();
+
+  State state_;
+  std::array<uint64_t, 4> roundKeys_{};
+  int halfBits_{1};
 };
 
 } // namespace fl
+
+CEREAL_CLASS_VERSION(fl::ShuffleDataset::State, 0)
@@ -48,6 +48,32 @@ std::vector<Tensor> TensorDataset::get(const int64_t idx) const {
   return result;
 }
 
+std::vector<std::vector<Tensor>> TensorDataset::getRange(
+    int64_t begin,
+    int64_t end) const {
+  checkRangeBounds(begin, end);
+  std::vector<std::vector<Tensor>> samples(
+      end - begin, std::vector<Tensor>(dataTensors_.size()));
+  for (int64_t i = 0; i < dataTensors_.size(); ++i) {
+    auto& tensor = dataTensors_[i];
+    auto lastdim = tensor.ndim() - 1;
+    auto available = std::min(end, static_cast<int64_t>(tensor.dim(lastdim)));
+    if (begin >= available) {
+      continue;
+    }
+    // one backend slice for the whole range, then per-sample views of it
+    std::vector<fl::Index> sel(tensor.ndim(), fl::span);
+    sel[lastdim] = fl::range(begin, available);
+    auto slice = tensor(sel);
+    for (int64_t idx = begin; idx < available; ++idx) {
+      std::vector<fl::Index> sampleSel(slice.ndim(), fl::span);
+      sampleSel[lastdim] = idx - begin;
+      samples[idx - begin][i] = slice(sampleSel);
+    }
+  }
+  return samples;
+}
+
 int64_t TensorDataset::size() const {
   return size_;
 }
@@ -41,6 +41,9 @@ class FL_API TensorDataset : public Dataset {
 
   std::vector<Tensor> get(const int64_t idx) const override;
 
+  std::vector<std::vector<Tensor>> getRange(int64_t begin, int64_t end)
+      const override;
+
  private:
   std::vector<Tensor> dataTensors_;
   int64_t size_{0};
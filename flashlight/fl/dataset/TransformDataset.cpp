@@ -5,6 +5,7 @@
  * LICENSE file in the root directory of this source tree.
  */
 
+#include <memory>
 #include <stdexcept>
 
 #include "flashlight/fl/dataset/TransformDataset.h"
@@ -14,26 +15,77 @@ namespace fl {
 TransformDataset::TransformDataset(
     std::shared_ptr<const Dataset> dataset,
     const std::vector<TransformFunction>& transformfns)
+    : TransformDataset(dataset, transformfns, /* cacheBytes = */ 0) {}
+
+TransformDataset::TransformDataset(
+    std::shared_ptr<const Dataset> dataset,
+    const std::vector<TransformFunction>& transformfns,
+    const size_t cacheBytes)
     : dataset_(dataset), transformFns_(transformfns) {
   if (!dataset_) {
     throw std::invalid_argument("dataset to be transformed is null");
   }
+  if (cacheBytes > 0) {
+    cache_ = std::make_unique<LRUCache<int64_t, const std::vector<Tensor>>>(
+        cacheBytes);
+  }
+}
+
+void TransformDataset::applyTransforms(std::vector<Tensor>& sample) const {
+  for (int64_t i = 0; i < sample.size(); ++i) {
+    if (i >= transformFns_.size() || !transformFns_[i]) {
+      continue;
+    }
+    sample[i] = transformFns_[i](sample[i]);
+  }
 }
 
 std::vector<Tensor> TransformDataset::get(const int64_t idx) const {
   checkIndexBounds(idx);
 
+  if (cache_) {
+    if (auto cached = cache_->get(idx)) {
+      return *cached;
+    }
+  }
+
   auto result = dataset_->get(idx);
+  applyTransforms(result);
 
-  for (int64_t i = 0; i < result.size(); ++i) {
-    if (i >= transformFns_.size() || !transformFns_[i]) {
-      continue;
+  if (cache_) {
+    size_t sampleBytes = 0;
+    for (const auto& tensor : result) {
+      sampleBytes += tensor.bytes();
     }
-    result[i] = transformFns_[i](result[i]);
+    cache_->put(
+        idx,
+        std::make_shared<const std::vector<Tensor>>(result),
+        sampleBytes);
   }
   return result;
 }
 
+std::vector<std::vector<Tensor>> TransformDataset::getRange(
+    int64_t begin,
+    int64_t end) const {
+  checkRangeBounds(begin, end);
+  if (cache_) {
+    // go through get() so each sample hits (and fills) the cache
+    std::vector<std::vector<Tensor>> samples;
+    samples.reserve(end - begin);
+    for (int64_t idx = begin; idx < end; ++idx) {
+      samples.push_back(get(idx));
+    }
+    return samples;
+  }
+  // forward the range so the underlying dataset is dispatched once
+  auto samples = dataset_->getRange(begin, end);
+  for (auto& sample : samples) {
+    applyTransforms(sample);
+  }
+  return samples;
+}
+
 int64_t TransformDataset::size() const {
   return dataset_->size();
 }
@@ -7,6 +7,9 @@
 
 #pragma once
 
+#include <memory>
+
+#include "flashlight/fl/common/LRUCache.h"
 #include "flashlight/fl/dataset/Dataset.h"
 
 namespace fl {
@@ -45,12 +48,37 @@ class FL_API TransformDataset : public Dataset {
       std::shared_ptr<const Dataset> dataset,
       const std::vector<TransformFunction>& transformfns);
 
+  /**
+   * Creates a `TransformDataset` that memoizes transformed samples.
+   *
+   * Samples are kept in a byte-budgeted LRU cache keyed by index, so
+   * iterating the same dataset repeatedly (e.g. an eval set featurized once
+   * per epoch) serves from memory instead of recomputing the transforms.
+   * Only use this when the transforms are deterministic and the underlying
+   * dataset is static -- cached samples are never invalidated.
+   *
+   * @param[in] dataset The underlying dataset.
+   * @param[in] transformfns The mappings used to transform the values.
+   * @param[in] cacheBytes Cache budget in bytes; 0 disables memoization.
+   */
+  TransformDataset(
+      std::shared_ptr<const Dataset> dataset,
+      const std::vector<TransformFunction>& transformfns,
+      const size_t cacheBytes);
+
   int64_t size() const override;
 
   std::vector<Tensor> get(const int64_t idx) const override;
 
+  std::vector<std::vector<Tensor>> getRange(int64_t begin, int64_t end)
+      const override;
+
  private:
+  void applyTransforms(std::vector<Tensor>& sample) const;
+
   std::shared_ptr<const Dataset> dataset_;
   const std::vector<TransformFunction> transformFns_;
+  // non-null iff memoization is enabled
+  std::unique_ptr<LRUCache<int64_t, const std::vector<Tensor>>> cache_;
 };
 } // namespace fl
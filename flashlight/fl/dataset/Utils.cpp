@@ -9,11 +9,130 @@
 
 #include <algorithm>
 #include <stdexcept>
+#include <unordered_map>
+#include <utility>
 
+#include "flashlight/fl/dataset/ConcatDataset.h"
+#include "flashlight/fl/dataset/ResampleDataset.h"
+#include "flashlight/fl/dataset/ShuffleDataset.h"
 #include "flashlight/fl/tensor/Index.h"
 
 namespace fl {
 
+namespace {
+
+// A flattened wrapper chain: the dataset owning each sample and the index
+// within it were resolved ahead of time, so get() is a single dispatch.
+class FlattenedDataset : public Dataset {
+ public:
+  FlattenedDataset(
+      std::vector<std::shared_ptr<const Dataset>> owners,
+      std::vector<std::pair<const Dataset*, int64_t>> samples)
+      : owners_(std::move(owners)), samples_(std::move(samples)) {}
+
+  int64_t size() const override {
+    return samples_.size();
+  }
+
+  std::vector<Tensor> get(const int64_t idx) const override {
+    checkIndexBounds(idx);
+    return samples_[idx].first->get(samples_[idx].second);
+  }
+
+ private:
+  // keeps the resolved datasets alive; samples_ points into them
+  std::vector<std::shared_ptr<const Dataset>> owners_;
+  std::vector<std::pair<const Dataset*, int64_t>> samples_;
+};
+
+// Follows (dataset, idx) through collapsible wrappers down to the deepest
+// dataset owning the sample. Lazily-mapped wrappers are boundaries:
+// ShuffleDataset's permutation changes on resample(), and function-based
+// mappings in general cannot be assumed stable.
+std::pair<std::shared_ptr<const Dataset>, int64_t> resolveThroughWrappers(
+    std::shared_ptr<const Dataset> dataset,
+    int64_t idx) {
+  while (true) {
+    if (std::dynamic_pointer_cast<const ShuffleDataset>(dataset)) {
+      break;
+    }
+    if (auto resampleds =
+            std::dynamic_pointer_cast<const ResampleDataset>(dataset)) {
+      if (!resampleds->hasMaterializedMapping()) {
+        break;
+      }
+      idx = resampleds->resampledIndex(idx);
+      dataset = resampleds->underlyingDataset();
+      continue;
+    }
+    if (auto concatds =
+            std::dynamic_pointer_cast<const ConcatDataset>(dataset)) {
+      auto resolved = concatds->resolveIndex(idx);
+      dataset = concatds->underlyingDatasets()[resolved.first];
+      idx = resolved.second;
+      continue;
+    }
+    break;
+  }
+  return {std::move(dataset), idx};
+}
+
+} // namespace
+
+int64_t roundRobinPartitionSize(
+    int64_t numSamples,
+    int64_t partitionId,
+    int64_t numPartitions,
+    int64_t batchSz /* = 1 */,
+    bool allowEmpty /* = false */) {
+  if (partitionId < 0 || partitionId >= numPartitions) {
+    throw std::invalid_argument(
+        "invalid partitionId, numPartitions for roundRobinPartitionSize");
+  }
+  int64_t nSamplesPerGlobalBatch = numPartitions * batchSz;
+  int64_t nFullGlobalBatches = numSamples / nSamplesPerGlobalBatch;
+  int64_t remainder = numSamples % nSamplesPerGlobalBatch;
+  bool includeLast =
+      remainder >= numPartitions || (allowEmpty && remainder > 0);
+  int64_t size = nFullGlobalBatches * batchSz;
+  if (includeLast) {
+    size += remainder / numPartitions;
+    if (partitionId < remainder % numPartitions) {
+      ++size;
+    }
+  }
+  return size;
+}
+
+int64_t roundRobinPartitionIndex(
+    int64_t numSamples,
+    int64_t idx,
+    int64_t partitionId,
+    int64_t numPartitions,
+    int64_t batchSz /* = 1 */,
+    bool allowEmpty /* = false */) {
+  if (idx < 0 ||
+      idx >=
+          roundRobinPartitionSize(
+              numSamples, partitionId, numPartitions, batchSz, allowEmpty)) {
+    throw std::out_of_range("invalid idx for roundRobinPartitionIndex");
+  }
+  int64_t nSamplesPerGlobalBatch = numPartitions * batchSz;
+  int64_t nFullGlobalBatches = numSamples / nSamplesPerGlobalBatch;
+  if (idx < nFullGlobalBatches * batchSz) {
+    // full global batches: each partition owns a contiguous batchSz block
+    return (idx / batchSz) * nSamplesPerGlobalBatch + batchSz * partitionId +
+        idx % batchSz;
+  }
+  // final, partial global batch: the remainder is spread evenly with the
+  // first (remainder % numPartitions) partitions taking one extra sample
+  int64_t offset = nFullGlobalBatches * nSamplesPerGlobalBatch;
+  int64_t remainder = numSamples - offset;
+  offset += (remainder / numPartitions) * partitionId +
+      std::min(partitionId, remainder % numPartitions);
+  return offset + (idx - nFullGlobalBatches * batchSz);
+}
+
 std::vector<int64_t> partitionByRoundRobin(
     int64_t numSamples,
     int64_t partitionId,
@@ -129,13 +248,12 @@ std::vector<Tensor> makeBatchFromRange(
     int64_t start,
     int64_t end) {
   std::vector<std::vector<Tensor>> buffer;
-  for (int64_t batchidx = start; batchidx < end; ++batchidx) {
-    auto fds = dataset->get(batchidx);
+  for (auto& fds : dataset->getRange(start, end)) {
     if (buffer.size() < fds.size()) {
       buffer.resize(fds.size());
     }
     for (int64_t i = 0; i < fds.size(); ++i) {
-      buffer[i].emplace_back(fds[i]);
+      buffer[i].emplace_back(std::move(fds[i]));
     }
   }
   std::vector<Tensor> result(buffer.size());
@@ -186,4 +304,38 @@ Tensor makeBatch(
   }
   return batcharr;
 }
+
+std::shared_ptr<const Dataset> flattenDataset(
+    std::shared_ptr<const Dataset> dataset) {
+  if (!dataset) {
+    throw std::invalid_argument("dataset to be flattened is null");
+  }
+  const int64_t size = dataset->size();
+  std::vector<std::shared_ptr<const Dataset>> owners;
+  std::unordered_map<const Dataset*, size_t> ownerIds;
+  std::vector<std::pair<const Dataset*, int64_t>> samples(size);
+  for (int64_t idx = 0; idx < size; ++idx) {
+    auto resolved = resolveThroughWrappers(dataset, idx);
+    if (ownerIds.emplace(resolved.first.get(), owners.size()).second) {
+      owners.push_back(resolved.first);
+    }
+    samples[idx] = {resolved.first.get(), resolved.second};
+  }
+  if (owners.size() == 1 && owners.front() == dataset) {
+    // the root is not a collapsible wrapper; nothing to do
+    return dataset;
+  }
+  if (owners.size() == 1) {
+    // the whole chain bottoms out in one dataset: a single materialized
+    // remapping replaces it
+    std::vector<int64_t> indices(size);
+    for (int64_t idx = 0; idx < size; ++idx) {
+      indices[idx] = samples[idx].second;
+    }
+    return std::make_shared<ResampleDataset>(
+        owners.front(), std::move(indices));
+  }
+  return std::make_shared<FlattenedDataset>(
+      std::move(owners), std::move(samples));
+}
 } // namespace fl
@@ -33,6 +33,36 @@ FL_API std::vector<int64_t> partitionByRoundRobin(
     int64_t batchSz = 1,
     bool allowEmpty = false);
 
+/**
+ * Number of samples `partitionByRoundRobin` assigns to a partition, computed
+ * arithmetically without materializing the ids. Takes the same arguments.
+ */
+FL_API int64_t roundRobinPartitionSize(
+    int64_t numSamples,
+    int64_t partitionId,
+    int64_t numPartitions,
+    int64_t batchSz = 1,
+    bool allowEmpty = false);
+
+/**
+ * The id of the `idx`-th sample of a partition - identical to
+ * `partitionByRoundRobin(...)[idx]` but O(1) in time and memory, so a sharded
+ * view over a huge dataset needs no per-epoch permutation arrays.
+ * @param numSamples total number of samples
+ * @param idx position within the partition,
+ *            [0, roundRobinPartitionSize(...))
+ * @param partitionId rank of the current partition [0, numPartitions)
+ * @param numPartitions total partitions
+ * @param batchSz batchsize to be used
+ */
+FL_API int64_t roundRobinPartitionIndex(
+    int64_t numSamples,
+    int64_t idx,
+    int64_t partitionId,
+    int64_t numPartitions,
+    int64_t batchSz = 1,
+    bool allowEmpty = false);
+
 /**
  * Partitions the samples in a round-robin manner and return ids of the samples
  * with dynamic batching: max number of tokens in the batch (including padded
@@ -73,6 +103,24 @@ FL_API std::vector<Tensor> makeBatchFromRange(
     int64_t start,
     int64_t end);
 
+/**
+ * Collapses a chain of index-remapping wrappers into a single view with the
+ * composed mapping materialized once. Vector-backed `ResampleDataset`s and
+ * intervening `ConcatDataset`s are resolved ahead of time so that each `get`
+ * dispatches straight to the dataset owning the sample - a stack of N
+ * wrappers otherwise pays N virtual `get`s and N index lookups per sample.
+ * Wrappers with lazy mappings (function-based resampling, `ShuffleDataset`)
+ * and everything below them are left intact, since freezing their mapping
+ * would silently stop it from changing. The flattened view snapshots the
+ * mappings at call time; later `resample` calls on the wrapped datasets do
+ * not propagate to it.
+ * @param dataset the root of the wrapper chain
+ * @return the flattened view, or `dataset` itself if there is nothing to
+ * collapse
+ */
+FL_API std::shared_ptr<const Dataset> flattenDataset(
+    std::shared_ptr<const Dataset> dataset);
+
 /** @} */
 
 } // namespace fl
@@ -9,15 +9,19 @@
 
 #include "flashlight/fl/dataset/BatchDataset.h"
 #include "flashlight/fl/dataset/BlobDataset.h"
+#include "flashlight/fl/dataset/BucketBatchDataset.h"
 #include "flashlight/fl/dataset/ConcatDataset.h"
 #include "flashlight/fl/dataset/Dataset.h"
 #include "flashlight/fl/dataset/DatasetIterator.h"
+#include "flashlight/fl/dataset/DevicePrefetchDataset.h"
 #include "flashlight/fl/dataset/FileBlobDataset.h"
 #include "flashlight/fl/dataset/MemoryBlobDataset.h"
 #include "flashlight/fl/dataset/MergeDataset.h"
 #include "flashlight/fl/dataset/PrefetchDataset.h"
+#include "flashlight/fl/dataset/ProcessPrefetchDataset.h"
 #include "flashlight/fl/dataset/ResampleDataset.h"
 #include "flashlight/fl/dataset/SpanDataset.h"
+#include "flashlight/fl/dataset/ShmBlobDataset.h"
 #include "flashlight/fl/dataset/ShuffleDataset.h"
 #include "flashlight/fl/dataset/TensorDataset.h"
 #include "flashlight/fl/dataset/TransformDataset.h"
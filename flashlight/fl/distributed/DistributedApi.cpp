@@ -46,6 +46,23 @@ FL_API void allReduceMultiple(
   }
 }
 
+FL_API void allReduceMultipleHierarchical(
+    std::vector<Variable> vars,
+    double scale /* = 1.0 */,
+    bool async /* = false */) {
+  // return a vector of pointers to avoid copying
+  std::vector<Tensor*> arrs;
+  for (auto& var : vars) {
+    arrs.push_back(&var.tensor());
+  }
+  if (getWorldSize() > 1) {
+    allReduceMultipleHierarchical(arrs, async);
+  }
+  for (auto& var : vars) {
+    var.tensor() *= scale;
+  }
+}
+
 FL_API void barrier() {
   auto tensor = Tensor::fromVector<int>({0});
   allReduce(tensor, false);
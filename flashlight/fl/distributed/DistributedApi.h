@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <future>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -36,6 +37,32 @@ FL_API void distributedInit(
     int worldSize,
     const std::unordered_map<std::string, std::string>& params = {});
 
+/**
+ * Re-rendezvous after a membership change without restarting the process.
+ * Surviving ranks (and any replacement ranks) call this with the new world
+ * geometry assigned by the launcher; the old communicators are drained and
+ * destroyed, a fresh rendezvous runs through the same store used by
+ * ``distributedInit``, and new communicators are built in place. All
+ * in-memory state - parameters, optimizer state, data pipelines - is
+ * untouched, so training resumes where it left off instead of repaying
+ * full startup and warmup when a preemptible node disappears.
+ *
+ * Detection of the membership change and assignment of the new ranks is the
+ * launcher's job; every participating rank must call this with a consistent
+ * `worldSize`. Only store-based rendezvous (``DistributedInit::FILE_SYSTEM``
+ * or ``DistributedInit::TCP``) supports re-rendezvous; MPI worlds are fixed
+ * at launch.
+ *
+ * @param worldRank this process's rank in the new communication group
+ * @param worldSize total number of processes in the new group
+ * @param params overrides merged over the parameters passed to
+ * ``distributedInit`` (e.g. a new rendezvous file or server address)
+ */
+FL_API void distributedReinit(
+    int worldRank,
+    int worldSize,
+    const std::unordered_map<std::string, std::string>& params = {});
+
 /**
  * Returns whether the distributed environment has been initialized
  */
@@ -82,6 +109,21 @@ FL_API void allReduce(Variable& var, double scale = 1.0, bool async = false);
  */
 FL_API void allReduce(Tensor& arr, bool async = false);
 
+/**
+ * Synchronizes a single Flashlight array with allreduce and returns a future
+ * that becomes ready once the reduction has completed and the array holds the
+ * reduced value. Unlike ``allReduce`` with `async = true`, completion is
+ * per-operation: waiting on the returned future replaces ``syncDistributed``
+ * for this reduction only, so e.g. cross-rank metric aggregation can overlap
+ * with compute and be fenced individually rather than fencing the whole step.
+ * On backends without asynchronous support the reduction runs inline and the
+ * returned future is already ready.
+ *
+ * @param arr an array which will be synchronized
+ * @return a future that is ready once `arr` holds the reduced value
+ */
+FL_API std::future<void> allReduceAsync(Tensor& arr);
+
 /**
  * Synchronizes a the arrays wrapped by a vector of Variables with allreduce.
  *
@@ -118,6 +160,117 @@ FL_API void allReduceMultiple(
     bool async = false,
     bool contiguous = false);
 
+/**
+ * Reduces (sums) each array onto a per-array root rank. Only the root's copy
+ * of each array is guaranteed to hold the reduced value afterwards; other
+ * ranks' copies are unspecified. Together with ``broadcastMultiple`` this is
+ * the building block for sharded-optimizer updates, where each rank owns and
+ * updates a subset of the parameters.
+ *
+ * @param[in] arrs a vector of pointers to arrays which will be reduced
+ * @param[in] roots the rank receiving the reduction of each array; must have
+ * the same length as `arrs`
+ * @param[in] async perform the operation asynchronously in a separate compute
+ * stream to the Flashlight compute stream. NB: if used, ``syncDistributed``
+ * *must* be called in order to ensure the reduction is complete before the
+ * values are used.
+ */
+FL_API void reduceMultiple(
+    std::vector<Tensor*> arrs,
+    const std::vector<int>& roots,
+    bool async = false);
+
+/**
+ * Broadcasts each array from a per-array root rank to all other ranks.
+ *
+ * @param[in] arrs a vector of pointers to arrays which will be broadcast
+ * @param[in] roots the rank whose copy of each array is sent; must have the
+ * same length as `arrs`
+ * @param[in] async perform the operation asynchronously in a separate compute
+ * stream to the Flashlight compute stream. NB: if used, ``syncDistributed``
+ * *must* be called in order to ensure the broadcast is complete before the
+ * values are used.
+ */
+FL_API void broadcastMultiple(
+    std::vector<Tensor*> arrs,
+    const std::vector<int>& roots,
+    bool async = false);
+
+/**
+ * Personalized all-to-all exchange with per-rank element counts. Rank i sends
+ * `sendCounts[j]` elements of `arr` to rank j and receives `recvCounts[j]`
+ * elements from rank j, with `arr` laid out as the send blocks concatenated
+ * in rank order; rank i's `recvCounts[j]` must equal rank j's
+ * `sendCounts[i]`. This is the exchange underlying token routing in
+ * mixture-of-experts layers, where each rank ships a different subset of
+ * tokens to every expert-owning rank.
+ *
+ * On the NCCL backend the whole exchange is issued as one grouped set of
+ * point-to-point transfers, i.e. a single fused launch rather than per-pair
+ * collectives. With `numChunks` greater than 1, every pairwise block is
+ * split into that many rounds issued as separate groups, so an async caller
+ * can overlap the later rounds' communication with compute consuming earlier
+ * data once ``syncDistributed`` has been reached.
+ *
+ * @param[in] arr the send buffer: the blocks destined for each rank,
+ * concatenated in rank order (`sum(sendCounts)` elements)
+ * @param[in] sendCounts the number of elements sent to each rank; must have
+ * one entry per rank in the world
+ * @param[in] recvCounts the number of elements received from each rank; must
+ * have one entry per rank in the world
+ * @param[in] async perform the exchange asynchronously in a separate compute
+ * stream to the Flashlight compute stream. NB: if used, ``syncDistributed``
+ * *must* be called before the received values are read.
+ * @param[in] numChunks the number of pipelined exchange rounds; 1 performs
+ * the exchange in a single group
+ * @return the receive buffer: the blocks received from each rank,
+ * concatenated in rank order (`sum(recvCounts)` elements)
+ */
+FL_API Tensor allToAllv(
+    const Tensor& arr,
+    const std::vector<int64_t>& sendCounts,
+    const std::vector<int64_t>& recvCounts,
+    bool async = false,
+    int numChunks = 1);
+
+/**
+ * Synchronizes a the arrays wrapped by a vector of Variables with a
+ * hierarchical allreduce: an intra-node reduce-scatter, an inter-node
+ * allreduce of the resulting shards, and an intra-node allgather, so that
+ * each node sends every byte over the (slower) inter-node links only once
+ * while the intra-node phases use the faster local interconnect. The set of
+ * Variables is always coalesced into a contiguous buffer first. Backends
+ * without topology support (CPU, or single-node worlds) fall back to a flat
+ * contiguous allreduce.
+ *
+ * @param[in] vars `Variable`s whose arrays will be synchronized
+ * @param[in] scale scale the Variable after allreduce by this factor
+ * @param[in] async perform the allReduce operation asynchronously in a
+ * separate compute stream to the Flashlight compute stream. NB: if used,
+ * ``syncDistributed`` *must* be called in order to ensure asynchrnous
+ * reduction and worker streams wait until the reduction is complete and uses
+ * updated values.
+ */
+FL_API void allReduceMultipleHierarchical(
+    std::vector<Variable> vars,
+    double scale = 1.0,
+    bool async = false);
+
+/**
+ * Synchronizes a vector of pointers to arrays with a hierarchical allreduce.
+ * See the `Variable` overload for the reduction structure.
+ *
+ * @param[in] arrs a vector of pointers to arrays which will be synchronized
+ * @param[in] async perform the allReduce operation asynchronously in a
+ * separate compute stream to the Flashlight compute stream. NB: if used,
+ * ``syncDistributed`` *must* be called in order to ensure asynchrnous
+ * reduction and worker streams wait until the reduction is complete and uses
+ * updated values.
+ */
+FL_API void allReduceMultipleHierarchical(
+    std::vector<Tensor*> arrs,
+    bool async = false);
+
 /**
  * Synchronizes operations in the Flashlight compute stream with operations in
  * the distributed compute stream, if applicable. That is, all operations in the
@@ -0,0 +1,294 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "flashlight/fl/distributed/TcpStore.h"
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <unordered_map>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace {
+
+// Request wire format: op (1 byte) | key length (u32) | key | value length
+// (u32) | value. Every request is answered with: value length (u32) | value
+// (zero-length for acknowledgements). All messages are a few bytes plus the
+// payload, so full blocking reads/writes per message are fine here.
+constexpr char kOpSet = 'S';
+constexpr char kOpGet = 'G';
+constexpr char kOpClear = 'C';
+
+void readFull(int fd, void* buf, size_t n) {
+  char* p = static_cast<char*>(buf);
+  while (n > 0) {
+    const ssize_t r = ::read(fd, p, n);
+    if (r <= 0) {
+      throw std::runtime_error("TcpStore: connection read failed");
+    }
+    p += r;
+    n -= r;
+  }
+}
+
+void writeFull(int fd, const void* buf, size_t n) {
+  const char* p = static_cast<const char*>(buf);
+  while (n > 0) {
+    const ssize_t w = ::write(fd, p, n);
+    if (w <= 0) {
+      throw std::runtime_error("TcpStore: connection write failed");
+    }
+    p += w;
+    n -= w;
+  }
+}
+
+void writeReply(int fd, const std::vector<char>& data) {
+  const uint32_t len = data.size();
+  writeFull(fd, &len, sizeof(len));
+  if (len > 0) {
+    writeFull(fd, data.data(), len);
+  }
+}
+
+std::string readString(int fd) {
+  uint32_t len;
+  readFull(fd, &len, sizeof(len));
+  std::string s(len, '\0');
+  if (len > 0) {
+    readFull(fd, &s[0], len);
+  }
+  return s;
+}
+
+std::vector<char> readData(int fd) {
+  uint32_t len;
+  readFull(fd, &len, sizeof(len));
+  std::vector<char> data(len);
+  if (len > 0) {
+    readFull(fd, data.data(), len);
+  }
+  return data;
+}
+
+} // namespace
+
+namespace fl::detail {
+
+constexpr std::chrono::milliseconds TcpStore::kDefaultTimeout;
+
+TcpStore::TcpStore(const std::string& addr, int port, bool isServer)
+    : addr_(addr), port_(port), isServer_(isServer) {
+  if (isServer_) {
+    startServer();
+  }
+  connectToServer();
+}
+
+TcpStore::~TcpStore() {
+  if (clientFd_ >= 0) {
+    ::close(clientFd_);
+  }
+  if (isServer_) {
+    // wake the event loop so it can shut down
+    const char stop = 0;
+    (void)::write(wakeFds_[1], &stop, 1);
+    if (serverThread_.joinable()) {
+      serverThread_.join();
+    }
+    ::close(listenFd_);
+    ::close(wakeFds_[0]);
+    ::close(wakeFds_[1]);
+  }
+}
+
+void TcpStore::startServer() {
+  listenFd_ = ::socket(AF_INET, SOCK_STREAM, 0);
+  if (listenFd_ < 0) {
+    throw std::runtime_error("TcpStore: socket creation failed");
+  }
+  const int one = 1;
+  ::setsockopt(listenFd_, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+  sockaddr_in serverAddr;
+  std::memset(&serverAddr, 0, sizeof(serverAddr));
+  serverAddr.sin_family = AF_INET;
+  serverAddr.sin_addr.s_addr = htonl(INADDR_ANY);
+  serverAddr.sin_port = htons(port_);
+  if (::bind(
+          listenFd_,
+          reinterpret_cast<sockaddr*>(&serverAddr),
+          sizeof(serverAddr)) != 0) {
+    throw std::runtime_error(
+        "TcpStore: bind failed on port " + std::to_string(port_));
+  }
+  if (::listen(listenFd_, SOMAXCONN) != 0) {
+    throw std::runtime_error("TcpStore: listen failed");
+  }
+  if (::pipe(wakeFds_) != 0) {
+    throw std::runtime_error("TcpStore: pipe creation failed");
+  }
+  serverThread_ = std::thread([this]() { serverLoop(); });
+}
+
+void TcpStore::serverLoop() {
+  std::unordered_map<std::string, std::vector<char>> store;
+  // get requests parked until their key is set
+  std::unordered_map<std::string, std::vector<int>> pendingGets;
+  std::vector<pollfd> fds = {
+      {wakeFds_[0], POLLIN, 0}, {listenFd_, POLLIN, 0}};
+
+  while (true) {
+    if (::poll(fds.data(), fds.size(), -1) < 0) {
+      continue;
+    }
+    if (fds[0].revents & POLLIN) {
+      return; // shutdown
+    }
+    if (fds[1].revents & POLLIN) {
+      const int conn = ::accept(listenFd_, nullptr, nullptr);
+      if (conn >= 0) {
+        const int one = 1;
+        ::setsockopt(conn, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+        fds.push_back({conn, POLLIN, 0});
+      }
+    }
+    for (size_t i = 2; i < fds.size(); i++) {
+      if (!(fds[i].revents & (POLLIN | POLLHUP | POLLERR))) {
+        continue;
+      }
+      const int fd = fds[i].fd;
+      char op;
+      if (::read(fd, &op, 1) != 1) {
+        // peer disconnected
+        ::close(fd);
+        fds.erase(fds.begin() + i--);
+        continue;
+      }
+      try {
+        const auto key = readString(fd);
+        auto data = readData(fd);
+        switch (op) {
+          case kOpSet: {
+            store[key] = std::move(data);
+            writeReply(fd, {});
+            // answer any gets parked on this key
+            auto pending = pendingGets.find(key);
+            if (pending != pendingGets.end()) {
+              for (const int waiter : pending->second) {
+                writeReply(waiter, store[key]);
+              }
+              pendingGets.erase(pending);
+            }
+            break;
+          }
+          case kOpGet: {
+            auto entry = store.find(key);
+            if (entry != store.end()) {
+              writeReply(fd, entry->second);
+            } else {
+              pendingGets[key].push_back(fd);
+            }
+            break;
+          }
+          case kOpClear:
+            store.erase(key);
+            writeReply(fd, {});
+            break;
+          default:
+            throw std::runtime_error("TcpStore: unknown request op");
+        }
+      } catch (const std::exception&) {
+        // malformed request or peer vanished mid-message
+        ::close(fd);
+        fds.erase(fds.begin() + i--);
+      }
+    }
+  }
+}
+
+void TcpStore::connectToServer() {
+  const auto start = std::chrono::steady_clock::now();
+  while (true) {
+    clientFd_ = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (clientFd_ < 0) {
+      throw std::runtime_error("TcpStore: socket creation failed");
+    }
+    sockaddr_in serverAddr;
+    std::memset(&serverAddr, 0, sizeof(serverAddr));
+    serverAddr.sin_family = AF_INET;
+    serverAddr.sin_port = htons(port_);
+    if (::inet_pton(AF_INET, addr_.c_str(), &serverAddr.sin_addr) != 1) {
+      throw std::runtime_error("TcpStore: invalid server address: " + addr_);
+    }
+    if (::connect(
+            clientFd_,
+            reinterpret_cast<sockaddr*>(&serverAddr),
+            sizeof(serverAddr)) == 0) {
+      break;
+    }
+    ::close(clientFd_);
+    clientFd_ = -1;
+    // the server rank may not be up yet
+    const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start);
+    if (elapsed > kDefaultTimeout) {
+      throw std::runtime_error("TcpStore: connect timed out to " + addr_);
+    }
+    /* sleep override */
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  const int one = 1;
+  ::setsockopt(clientFd_, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+  // bound how long a get may stay parked on the server
+  timeval timeout;
+  timeout.tv_sec =
+      std::chrono::duration_cast<std::chrono::seconds>(kDefaultTimeout)
+          .count();
+  timeout.tv_usec = 0;
+  ::setsockopt(clientFd_, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+}
+
+std::vector<char> TcpStore::request(
+    char op,
+    const std::string& key,
+    const std::vector<char>& data) {
+  writeFull(clientFd_, &op, 1);
+  const uint32_t keyLen = key.size();
+  writeFull(clientFd_, &keyLen, sizeof(keyLen));
+  writeFull(clientFd_, key.data(), keyLen);
+  const uint32_t dataLen = data.size();
+  writeFull(clientFd_, &dataLen, sizeof(dataLen));
+  if (dataLen > 0) {
+    writeFull(clientFd_, data.data(), dataLen);
+  }
+  return readData(clientFd_);
+}
+
+std::vector<char> TcpStore::get(const std::string& key) {
+  auto result = request(kOpGet, key, {});
+  if (result.empty()) {
+    throw std::runtime_error("TcpStore get: value is empty for key: " + key);
+  }
+  return result;
+}
+
+void TcpStore::set(const std::string& key, const std::vector<char>& data) {
+  request(kOpSet, key, data);
+}
+
+void TcpStore::clear(const std::string& key) {
+  request(kOpClear, key, {});
+}
+
+} // namespace fl::detail
@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "flashlight/fl/common/Defines.h"
+
+namespace fl {
+
+namespace detail {
+
+/**
+ * A TCP-based rendezvous key-value store with the same `set`/`get`/`clear`
+ * interface as `FileStore`, for bootstrapping without a shared filesystem.
+ * The server rank runs a single listener with an event loop on a background
+ * thread; `get` calls from other ranks are parked server-side and answered
+ * as soon as the key is set, so rendezvous completes without polling.
+ */
+class FL_API TcpStore {
+ public:
+  static constexpr std::chrono::milliseconds kDefaultTimeout =
+      std::chrono::seconds(60 * 2);
+
+  /**
+   * @param addr Address of the server rank, reachable from all ranks.
+   * @param port Port the server listens on.
+   * @param isServer Whether this process hosts the store (exactly one rank,
+   * conventionally rank 0, must pass true).
+   */
+  TcpStore(const std::string& addr, int port, bool isServer);
+  ~TcpStore();
+
+  TcpStore(const TcpStore&) = delete;
+  TcpStore& operator=(const TcpStore&) = delete;
+
+  std::vector<char> get(const std::string& key);
+  void set(const std::string& key, const std::vector<char>& data);
+  void clear(const std::string& key);
+
+ private:
+  std::string addr_;
+  int port_;
+  bool isServer_;
+  // client connection to the server (the server rank connects to itself over
+  // loopback so every rank goes through the same request path)
+  int clientFd_{-1};
+  int listenFd_{-1};
+  // pipe used to wake the server loop on shutdown
+  int wakeFds_[2]{-1, -1};
+  std::thread serverThread_;
+
+  void startServer();
+  void serverLoop();
+  void connectToServer();
+  std::vector<char> request(char op, const std::string& key,
+      const std::vector<char>& data);
+};
+} // namespace detail
+
+} // namespace fl
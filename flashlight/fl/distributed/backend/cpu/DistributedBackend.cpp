@@ -14,6 +14,7 @@
 #include <stdexcept>
 
 #include <gloo/allreduce_halving_doubling.h>
+#include <gloo/broadcast_one_to_all.h>
 #include <gloo/config.h>
 #include <gloo/mpi/context.h>
 #include <gloo/transport/tcp/device.h>
@@ -36,8 +37,9 @@ std::shared_ptr<gloo::mpi::Context> glooContext_;
 // If you do, you might eventually experience hangs and timeouts as temporaries
 // are being allocated to previous memory addresses.
 const int kGlooCacheSize_ = 10;
-using CacheType = fl::detail::LRUCache<std::string, gloo::Algorithm>;
-CacheType glooCache_(kGlooCacheSize_);
+using CacheType = fl::LRUCache<std::string, gloo::Algorithm>;
+// a single shard keeps the handful of hot algorithms in exact LRU order
+CacheType glooCache_(kGlooCacheSize_, /* shardCount = */ 1);
 fl::Tensor cacheTensor_;
 } // namespace
 
@@ -57,7 +59,7 @@ inline void allreduceGloo(T* ptr, size_t s) {
     using Allreduce = gloo::AllreduceHalvingDoubling<T>;
     algorithm = glooCache_.put(
         key,
-        std::make_unique<Allreduce>(
+        std::make_shared<Allreduce>(
             globalContext(),
             std::vector<T*>({ptr}),
             s,
@@ -65,6 +67,20 @@ inline void allreduceGloo(T* ptr, size_t s) {
   }
   algorithm->run();
 }
+
+template <typename T>
+inline void broadcastGloo(T* ptr, size_t s, int root) {
+  auto key = detail::makeHashKey(ptr, s, root, "broadcastCpu");
+  auto algorithm = glooCache_.get(key);
+  if (algorithm == nullptr) {
+    using Broadcast = gloo::BroadcastOneToAll<T>;
+    algorithm = glooCache_.put(
+        key,
+        std::make_shared<Broadcast>(
+            globalContext(), std::vector<T*>({ptr}), s, root));
+  }
+  algorithm->run();
+}
 } // namespace detail
 
 void distributedInit(
@@ -101,6 +117,18 @@ void distributedInit(
   }
 }
 
+void distributedReinit(
+    int /* worldRank */,
+    int /* worldSize */,
+    const std::unordered_map<std::string, std::string>& /* params = {} */) {
+  if (!isDistributedInit()) {
+    throw std::runtime_error("distributed environment not initialized");
+  }
+  // The Gloo context is built from the MPI world, which is fixed at launch
+  throw std::runtime_error(
+      "distributedReinit is not supported for the Gloo backend");
+}
+
 void allReduce(fl::Tensor& tensor, bool async /* = false */) {
   if (!isDistributedInit()) {
     throw std::runtime_error("distributed environment not initialized");
@@ -140,6 +168,15 @@ void allReduce(fl::Tensor& tensor, bool async /* = false */) {
   memcpy(tensorPtr.get(), cacheTensorPtr.get(), tensorSize);
 }
 
+std::future<void> allReduceAsync(fl::Tensor& tensor) {
+  // Gloo reductions are synchronous; run inline and hand back a future that
+  // is already ready so callers can use one code path across backends
+  allReduce(tensor, /* async = */ false);
+  std::promise<void> promise;
+  promise.set_value();
+  return promise.get_future();
+}
+
 // Not yet supported
 void allReduceMultiple(
     std::vector<fl::Tensor*> tensors,
@@ -155,6 +192,118 @@ void allReduceMultiple(
   }
 }
 
+void reduceMultiple(
+    std::vector<fl::Tensor*> tensors,
+    const std::vector<int>& roots,
+    bool async /* = false */) {
+  if (tensors.size() != roots.size()) {
+    throw std::invalid_argument(
+        "reduceMultiple - arrs and roots must have the same length");
+  }
+  // Gloo has no single-root reduce convenience algorithm; an allreduce
+  // leaves the root (and every other rank) with the reduced value, which
+  // satisfies the reduceMultiple contract
+  for (auto& tensor : tensors) {
+    allReduce(*tensor, async);
+  }
+}
+
+void broadcastMultiple(
+    std::vector<fl::Tensor*> tensors,
+    const std::vector<int>& roots,
+    bool async /* = false */) {
+  if (!isDistributedInit()) {
+    throw std::runtime_error("distributed environment not initialized");
+  }
+  if (tensors.size() != roots.size()) {
+    throw std::invalid_argument(
+        "broadcastMultiple - arrs and roots must have the same length");
+  }
+  if (async) {
+    throw std::runtime_error(
+        "Asynchronous broadcast not yet supported for Gloo backend");
+  }
+  for (size_t i = 0; i < tensors.size(); ++i) {
+    fl::Tensor& tensor = *tensors[i];
+    size_t tensorSize = tensor.elements() * fl::getTypeSize(tensor.type());
+    if (tensorSize > cacheTensor_.elements()) {
+      cacheTensor_ =
+          fl::Tensor({static_cast<long long>(tensorSize)}, fl::dtype::b8);
+    }
+    DevicePtr tensorPtr(tensor);
+    DevicePtr cacheTensorPtr(cacheTensor_);
+    memcpy(cacheTensorPtr.get(), tensorPtr.get(), tensorSize);
+    switch (tensor.type()) {
+      case fl::dtype::f32:
+        detail::broadcastGloo(
+            static_cast<float*>(cacheTensorPtr.get()),
+            tensor.elements(),
+            roots[i]);
+        break;
+      case fl::dtype::f64:
+        detail::broadcastGloo(
+            static_cast<double*>(cacheTensorPtr.get()),
+            tensor.elements(),
+            roots[i]);
+        break;
+      case fl::dtype::s32:
+        detail::broadcastGloo(
+            static_cast<int*>(cacheTensorPtr.get()),
+            tensor.elements(),
+            roots[i]);
+        break;
+      case fl::dtype::s64:
+        detail::broadcastGloo(
+            static_cast<int64_t*>(cacheTensorPtr.get()),
+            tensor.elements(),
+            roots[i]);
+        break;
+      default:
+        throw std::runtime_error(
+            "unsupported data type for broadcast with gloo");
+    }
+    memcpy(tensorPtr.get(), cacheTensorPtr.get(), tensorSize);
+  }
+}
+
+Tensor allToAllv(
+    const Tensor& arr,
+    const std::vector<int64_t>& sendCounts,
+    const std::vector<int64_t>& recvCounts,
+    bool /* async = false */,
+    int numChunks /* = 1 */) {
+  if (!isDistributedInit()) {
+    throw std::runtime_error("distributed environment not initialized");
+  }
+  const size_t worldSize = getWorldSize();
+  if (sendCounts.size() != worldSize || recvCounts.size() != worldSize) {
+    throw std::invalid_argument(
+        "allToAllv - sendCounts and recvCounts must have one entry per rank");
+  }
+  if (numChunks < 1) {
+    throw std::invalid_argument("allToAllv - numChunks must be positive");
+  }
+  if (worldSize == 1) {
+    // a single rank only exchanges with itself
+    if (arr.elements() != sendCounts[0] || sendCounts[0] != recvCounts[0]) {
+      throw std::invalid_argument(
+          "allToAllv - send buffer size does not match the sum of sendCounts");
+    }
+    return arr.copy();
+  }
+  // The cached-algorithm Gloo surface used here has no alltoallv
+  throw std::runtime_error(
+      "allToAllv is not yet supported for the Gloo backend");
+}
+
+void allReduceMultipleHierarchical(
+    std::vector<fl::Tensor*> tensors,
+    bool async /* = false */) {
+  // Gloo has no notion of node-local topology, so hierarchical reduction
+  // degenerates to a flat (non-contiguous) allreduce
+  allReduceMultiple(std::move(tensors), async, /* contiguous = */ false);
+}
+
 void syncDistributed() {
   // NOOP since async distributed operations aren't yet supported with the Gloo
   // backend
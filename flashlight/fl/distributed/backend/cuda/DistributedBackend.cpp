@@ -9,6 +9,7 @@
 #include <cstring>
 #include <memory>
 #include <mutex>
+#include <numeric>
 #include <stdexcept>
 
 #include <mpi.h>
@@ -18,12 +19,18 @@
 #include "flashlight/fl/common/DevicePtr.h"
 #include "flashlight/fl/distributed/DistributedApi.h"
 #include "flashlight/fl/distributed/FileStore.h"
+#include "flashlight/fl/distributed/TcpStore.h"
 #include "flashlight/fl/runtime/CUDAStream.h"
 #include "flashlight/fl/runtime/CUDAUtils.h"
 #include "flashlight/fl/runtime/DeviceManager.h"
 #include "flashlight/fl/tensor/Compute.h"
 #include "flashlight/fl/tensor/Types.h"
 
+#if FL_USE_ARRAYFIRE
+#include "flashlight/fl/tensor/backend/af/mem/CachingMemoryManager.h"
+#include "flashlight/fl/tensor/backend/af/mem/MemoryManagerInstaller.h"
+#endif
+
 #define NCCLCHECK(expr) ::fl::detail::ncclCheck((expr))
 #define MPICHECK(expr) ::fl::detail::mpiCheck((expr))
 
@@ -49,18 +56,42 @@ class NcclContext {
       int worldRank,
       int worldSize,
       const std::unordered_map<std::string, std::string>& params);
+  void initWithTcp(
+      int worldRank,
+      int worldSize,
+      const std::unordered_map<std::string, std::string>& params);
+  // Tear down the communicators and re-rendezvous through the store with a
+  // new world geometry; requires a store-based init method
+  void reinit(
+      int worldRank,
+      int worldSize,
+      const std::unordered_map<std::string, std::string>& params);
   ncclComm_t& getComm();
   int getWorldSize() const;
   int getWorldRank() const;
+  int getDevicesPerNode() const;
   const CUDAStream& getReductionStream() const;
   const CUDAStream& getWorkerStream() const;
   void* getCoalesceBuffer();
+  // Lazily split the world communicator into an intra-node and an inter-node
+  // communicator for hierarchical reductions
+  void initHierarchicalComms();
+  ncclComm_t& getIntraNodeComm();
+  ncclComm_t& getInterNodeComm();
 
  private:
   // create CUDA resources
   void createCudaResources();
+  // store key for the current rendezvous generation
+  std::string ncclStoreKey() const;
   ncclComm_t comm_;
   int worldSize_, worldRank_;
+  int devicesPerNode_{1};
+  // Sub-communicators for hierarchical reductions; valid only once
+  // initHierarchicalComms() has run
+  ncclComm_t intraNodeComm_;
+  ncclComm_t interNodeComm_;
+  bool hierarchicalCommsInit_{false};
   // CUDA stream in which NCCL calls run if in async mode
   std::shared_ptr<CUDAStream> reductionStream_;
   // CUDA stream in which cudaMemcpyAsync calls run if in contiguous mode
@@ -68,6 +99,12 @@ class NcclContext {
   // Buffer for storing copied gradients contiguously; exists on device memory
   void* coalesceBuffer_{nullptr};
   std::once_flag allocBuffer_;
+  // Rendezvous generation - incremented by reinit() so a re-rendezvous never
+  // reads a stale unique id left in the store by a previous membership
+  int generation_{0};
+  // Parameters from the last store-based init, reused (with caller overrides)
+  // when re-rendezvousing
+  std::unordered_map<std::string, std::string> initParams_;
 };
 
 bool isNonNegativeInteger(const std::string& s) {
@@ -94,6 +131,24 @@ ncclDataType_t getNcclTypeForArray(const Tensor& arr) {
   }
 }
 
+// Marks `ptr`'s block as in use on `stream` with the caching allocator, so
+// that freeing the buffer before `stream` has consumed it does not hand the
+// block back to the pool for immediate reuse (see
+// CachingMemoryManager::recordStreamUse). No-op when a different memory
+// manager is installed.
+void recordStreamUse(const void* ptr, const CUDAStream& stream) {
+#if FL_USE_ARRAYFIRE
+  auto* manager = dynamic_cast<CachingMemoryManager*>(
+      MemoryManagerInstaller::currentlyInstalledMemoryManager());
+  if (manager != nullptr) {
+    manager->recordStreamUse(ptr, stream);
+  }
+#else
+  (void)ptr;
+  (void)stream;
+#endif
+}
+
 } // namespace
 
 void ncclCheck(ncclResult_t r);
@@ -124,6 +179,23 @@ void allReduce(Tensor& arr, bool async /* = false */) {
       /* contiguous = */ false);
 }
 
+std::future<void> allReduceAsync(Tensor& arr) {
+  allReduce(arr, /* async = */ true);
+  // Completion token: a host function enqueued on the reduction stream fires
+  // once the reduction (and everything before it in the stream) has executed
+  auto promise = std::make_unique<std::promise<void>>();
+  auto future = promise->get_future();
+  FL_CUDA_CHECK(cudaLaunchHostFunc(
+      detail::NcclContext::getInstance().getReductionStream().handle(),
+      [](void* p) {
+        std::unique_ptr<std::promise<void>>(
+            static_cast<std::promise<void>*>(p))
+            ->set_value();
+      },
+      promise.release()));
+  return future;
+}
+
 void allReduceMultiple(
     std::vector<Tensor*> arrs,
     bool async /* = false */,
@@ -181,6 +253,12 @@ void allReduceMultiple(
   // Block the copy worker stream on Flashlight's active CUDA stream
   relativeSync(workerStream, constTensors);
 
+  // The worker stream reads each tensor buffer here and writes it back after
+  // the reduction; gate each block's return to the allocator pool on that use
+  for (auto& entry : tensorPtrs) {
+    detail::recordStreamUse(entry.first.get(), workerStream);
+  }
+
   // In the worker stream, coalesce gradients into one large buffer so we
   // only need to call allReduce
   void* coalesceBuffer = ncclContext.getCoalesceBuffer();
@@ -226,6 +304,314 @@ void allReduceMultiple(
   }
 }
 
+void reduceMultiple(
+    std::vector<Tensor*> arrs,
+    const std::vector<int>& roots,
+    bool async /* = false */) {
+  if (!isDistributedInit()) {
+    throw std::runtime_error("distributed environment not initialized");
+  }
+  if (arrs.size() != roots.size()) {
+    throw std::invalid_argument(
+        "reduceMultiple - arrs and roots must have the same length");
+  }
+  if (arrs.empty()) {
+    return;
+  }
+  auto& ncclContext = detail::NcclContext::getInstance();
+  // Use nccl groups to do everything in a single kernel launch
+  NCCLCHECK(ncclGroupStart());
+  for (size_t i = 0; i < arrs.size(); ++i) {
+    Tensor& arr = *arrs[i];
+    ncclDataType_t type = detail::getNcclTypeForArray(arr);
+    DevicePtr ptr(arr);
+    const CUDAStream* bufferStream = &arr.stream().impl<CUDAStream>();
+    const CUDAStream* syncStream =
+        async ? &ncclContext.getReductionStream() : bufferStream;
+    if (async) {
+      syncStream->relativeSync(*bufferStream);
+      detail::recordStreamUse(ptr.get(), *syncStream);
+    }
+    NCCLCHECK(ncclReduce(
+        ptr.get(),
+        ptr.get(),
+        arr.elements(),
+        type,
+        ncclSum,
+        roots[i],
+        ncclContext.getComm(),
+        syncStream->handle()));
+  }
+  NCCLCHECK(ncclGroupEnd());
+}
+
+void broadcastMultiple(
+    std::vector<Tensor*> arrs,
+    const std::vector<int>& roots,
+    bool async /* = false */) {
+  if (!isDistributedInit()) {
+    throw std::runtime_error("distributed environment not initialized");
+  }
+  if (arrs.size() != roots.size()) {
+    throw std::invalid_argument(
+        "broadcastMultiple - arrs and roots must have the same length");
+  }
+  if (arrs.empty()) {
+    return;
+  }
+  auto& ncclContext = detail::NcclContext::getInstance();
+  // Use nccl groups to do everything in a single kernel launch
+  NCCLCHECK(ncclGroupStart());
+  for (size_t i = 0; i < arrs.size(); ++i) {
+    Tensor& arr = *arrs[i];
+    ncclDataType_t type = detail::getNcclTypeForArray(arr);
+    DevicePtr ptr(arr);
+    const CUDAStream* bufferStream = &arr.stream().impl<CUDAStream>();
+    const CUDAStream* syncStream =
+        async ? &ncclContext.getReductionStream() : bufferStream;
+    if (async) {
+      syncStream->relativeSync(*bufferStream);
+      detail::recordStreamUse(ptr.get(), *syncStream);
+    }
+    NCCLCHECK(ncclBroadcast(
+        ptr.get(),
+        ptr.get(),
+        arr.elements(),
+        type,
+        roots[i],
+        ncclContext.getComm(),
+        syncStream->handle()));
+  }
+  NCCLCHECK(ncclGroupEnd());
+}
+
+Tensor allToAllv(
+    const Tensor& arr,
+    const std::vector<int64_t>& sendCounts,
+    const std::vector<int64_t>& recvCounts,
+    bool async /* = false */,
+    int numChunks /* = 1 */) {
+  if (!isDistributedInit()) {
+    throw std::runtime_error("distributed environment not initialized");
+  }
+  auto& ncclContext = detail::NcclContext::getInstance();
+  const size_t worldSize = ncclContext.getWorldSize();
+  if (sendCounts.size() != worldSize || recvCounts.size() != worldSize) {
+    throw std::invalid_argument(
+        "allToAllv - sendCounts and recvCounts must have one entry per rank");
+  }
+  if (numChunks < 1) {
+    throw std::invalid_argument("allToAllv - numChunks must be positive");
+  }
+  const int64_t sendTotal =
+      std::accumulate(sendCounts.begin(), sendCounts.end(), int64_t(0));
+  const int64_t recvTotal =
+      std::accumulate(recvCounts.begin(), recvCounts.end(), int64_t(0));
+  if (arr.elements() != sendTotal) {
+    throw std::invalid_argument(
+        "allToAllv - send buffer size does not match the sum of sendCounts");
+  }
+#if defined(NCCL_VERSION_CODE) && NCCL_VERSION_CODE >= NCCL_VERSION(2, 7, 0)
+  ncclDataType_t type = detail::getNcclTypeForArray(arr);
+  const size_t typeSize = fl::getTypeSize(arr.type());
+
+  Tensor result = Tensor({recvTotal}, arr.type());
+  DevicePtr sendPtr(arr);
+  DevicePtr recvPtr(result);
+
+  const CUDAStream* bufferStream = &arr.stream().impl<CUDAStream>();
+  const CUDAStream* syncStream =
+      async ? &ncclContext.getReductionStream() : bufferStream;
+  if (async) {
+    syncStream->relativeSync(*bufferStream);
+    detail::recordStreamUse(sendPtr.get(), *syncStream);
+    detail::recordStreamUse(recvPtr.get(), *syncStream);
+  }
+
+  // base offsets of each rank's block in the send and receive buffers
+  std::vector<int64_t> sendOffsets(worldSize), recvOffsets(worldSize);
+  int64_t sendAcc = 0, recvAcc = 0;
+  for (size_t r = 0; r < worldSize; ++r) {
+    sendOffsets[r] = sendAcc;
+    sendAcc += sendCounts[r];
+    recvOffsets[r] = recvAcc;
+    recvAcc += recvCounts[r];
+  }
+
+  auto* sendBase = static_cast<char*>(sendPtr.get());
+  auto* recvBase = static_cast<char*>(recvPtr.get());
+  // Every pairwise transfer within a round is issued inside one nccl group,
+  // fusing the personalized exchange into a single launch. Each round moves
+  // a 1/numChunks slice of every block as its own group, so pipelined
+  // callers can overlap later rounds with compute on earlier data
+  for (int chunk = 0; chunk < numChunks; ++chunk) {
+    NCCLCHECK(ncclGroupStart());
+    for (size_t peer = 0; peer < worldSize; ++peer) {
+      const int64_t sendBegin = sendCounts[peer] * chunk / numChunks;
+      const int64_t sendEnd = sendCounts[peer] * (chunk + 1) / numChunks;
+      if (sendEnd > sendBegin) {
+        NCCLCHECK(ncclSend(
+            sendBase + (sendOffsets[peer] + sendBegin) * typeSize,
+            sendEnd - sendBegin,
+            type,
+            peer,
+            ncclContext.getComm(),
+            syncStream->handle()));
+      }
+      const int64_t recvBegin = recvCounts[peer] * chunk / numChunks;
+      const int64_t recvEnd = recvCounts[peer] * (chunk + 1) / numChunks;
+      if (recvEnd > recvBegin) {
+        NCCLCHECK(ncclRecv(
+            recvBase + (recvOffsets[peer] + recvBegin) * typeSize,
+            recvEnd - recvBegin,
+            type,
+            peer,
+            ncclContext.getComm(),
+            syncStream->handle()));
+      }
+    }
+    NCCLCHECK(ncclGroupEnd());
+  }
+  return result;
+#else
+  throw std::runtime_error(
+      "allToAllv requires NCCL >= 2.7 for point-to-point send/recv");
+#endif
+}
+
+void allReduceMultipleHierarchical(
+    std::vector<Tensor*> arrs,
+    bool async /* = false */) {
+  if (arrs.empty()) {
+    return;
+  }
+
+  auto& ncclContext = detail::NcclContext::getInstance();
+  const int worldSize = ncclContext.getWorldSize();
+  const int devicesPerNode = ncclContext.getDevicesPerNode();
+  // Single-node worlds have no inter-node links to economize - use the flat
+  // contiguous path
+  if (worldSize <= devicesPerNode || devicesPerNode == 1) {
+    allReduceMultiple(std::move(arrs), async, /* contiguous = */ true);
+    return;
+  }
+  ncclContext.initHierarchicalComms();
+
+  // As with the contiguous path, the coalesced reduction requires all arrays
+  // in the set to be of the same type
+  ncclDataType_t ncclType = detail::getNcclTypeForArray(*arrs[0]);
+  for (auto& arr : arrs) {
+    if (detail::getNcclTypeForArray(*arr) != ncclType) {
+      throw std::runtime_error(
+          "Cannot perform hierarchical allReduce on a set of tensors "
+          "of different types");
+    }
+  }
+  size_t typeSize = fl::getTypeSize(arrs[0]->type());
+
+  std::vector<std::pair<DevicePtr, size_t>> tensorPtrs;
+  tensorPtrs.reserve(arrs.size());
+  size_t totalEls{0};
+  for (auto& arr : arrs) {
+    totalEls += arr->elements();
+    tensorPtrs.emplace_back(DevicePtr(*arr), arr->bytes());
+  }
+
+  // The intra-node reduce-scatter needs an element count divisible by the
+  // number of local ranks; pad the coalesce buffer up to the next multiple.
+  // The padded tail is never copied back
+  const size_t localSize = devicesPerNode;
+  const size_t paddedEls =
+      (totalEls + localSize - 1) / localSize * localSize;
+  if (paddedEls * typeSize > DistributedConstants::kCoalesceCacheSize) {
+    throw std::runtime_error(
+        "Total coalesce buffer size is larger than existing buffer size");
+  }
+
+  const auto& workerStream = ncclContext.getWorkerStream();
+  const auto constTensors = std::vector<const Tensor*>(arrs.begin(), arrs.end());
+  // Block the copy worker stream on Flashlight's active CUDA stream
+  relativeSync(workerStream, constTensors);
+
+  // The worker stream reads each tensor buffer here and writes it back after
+  // the reduction; gate each block's return to the allocator pool on that use
+  for (auto& entry : tensorPtrs) {
+    detail::recordStreamUse(entry.first.get(), workerStream);
+  }
+
+  // Coalesce gradients into one large buffer in the worker stream
+  void* coalesceBuffer = ncclContext.getCoalesceBuffer();
+  auto* cur = reinterpret_cast<char*>(coalesceBuffer);
+  for (auto& entry : tensorPtrs) {
+    FL_CUDA_CHECK(cudaMemcpyAsync(
+        cur,
+        entry.first.get(),
+        entry.second,
+        cudaMemcpyDeviceToDevice,
+        workerStream.handle()));
+    cur += entry.second;
+  }
+
+  const CUDAStream* syncStream =
+      async ? &ncclContext.getReductionStream() : &workerStream;
+  // block future reduction stream ops on the copy-worker stream
+  if (async) {
+    syncStream->relativeSync(workerStream);
+  }
+
+  // Reduce-scatter over the fast intra-node interconnect, allreduce each
+  // rank's shard across nodes, then allgather the reduced shards back within
+  // the node. Every byte crosses the inter-node links exactly once
+  const int localRank = ncclContext.getWorldRank() % devicesPerNode;
+  const size_t shardEls = paddedEls / localSize;
+  auto* base = reinterpret_cast<char*>(coalesceBuffer);
+  void* shard = base + localRank * shardEls * typeSize;
+  NCCLCHECK(ncclReduceScatter(
+      base,
+      shard,
+      shardEls,
+      ncclType,
+      ncclSum,
+      ncclContext.getIntraNodeComm(),
+      syncStream->handle()));
+  NCCLCHECK(ncclAllReduce(
+      shard,
+      shard,
+      shardEls,
+      ncclType,
+      ncclSum,
+      ncclContext.getInterNodeComm(),
+      syncStream->handle()));
+  NCCLCHECK(ncclAllGather(
+      shard,
+      base,
+      shardEls,
+      ncclType,
+      ncclContext.getIntraNodeComm(),
+      syncStream->handle()));
+
+  // Block the worker stream's copy operations on reduction operations that
+  // are currently enqueued in the reduction stream
+  if (async) {
+    workerStream.relativeSync(ncclContext.getReductionStream());
+  } else {
+    relativeSync(workerStream, constTensors);
+  }
+
+  // Enqueue operations in the stream to copy back to each respective array
+  // from the coalesce buffer
+  cur = reinterpret_cast<char*>(coalesceBuffer);
+  for (auto& entry : tensorPtrs) {
+    FL_CUDA_CHECK(cudaMemcpyAsync(
+        entry.first.get(),
+        cur,
+        entry.second,
+        cudaMemcpyDeviceToDevice,
+        workerStream.handle()));
+    cur += entry.second;
+  }
+}
+
 /**
  * Block future operations in all other CUDA streams on this device on
  * operations currently running in the NCCL [and worker] CUDA stream.
@@ -275,6 +661,10 @@ void distributedInit(
         worldRank, worldSize, params);
     detail::DistributedInfo::getInstance().initMethod_ =
         DistributedInit::FILE_SYSTEM;
+  } else if (initMethod == DistributedInit::TCP) {
+    detail::NcclContext::getInstance().initWithTcp(
+        worldRank, worldSize, params);
+    detail::DistributedInfo::getInstance().initMethod_ = DistributedInit::TCP;
   } else {
     throw std::runtime_error(
         "unsupported distributed init method for NCCL backend");
@@ -287,6 +677,20 @@ void distributedInit(
   }
 }
 
+void distributedReinit(
+    int worldRank,
+    int worldSize,
+    const std::unordered_map<std::string, std::string>& params /* = {} */) {
+  if (!isDistributedInit()) {
+    throw std::runtime_error("distributed environment not initialized");
+  }
+  detail::NcclContext::getInstance().reinit(worldRank, worldSize, params);
+  if (getWorldRank() == 0) {
+    std::cout << "Re-initialized NCCL with world size " << worldSize
+              << " successfully!\n";
+  }
+}
+
 namespace detail {
 
 void ncclCheck(ncclResult_t r) {
@@ -342,6 +746,13 @@ void allReduceCuda(
   // don't synchronize streams if not async and not contiguous - the AF CUDA
   // stream does everything
 
+  if (async && !contiguous) {
+    // the tensor buffer is consumed on the dedicated reduction stream; gate
+    // its return to the allocator pool on that use. In contiguous mode `ptr`
+    // is the coalesce buffer, which the allocator does not manage
+    recordStreamUse(ptr, *syncStream);
+  }
+
   NCCLCHECK(ncclAllReduce(
       ptr,
       ptr,
@@ -365,6 +776,41 @@ int NcclContext::getWorldRank() const {
   return worldRank_;
 }
 
+int NcclContext::getDevicesPerNode() const {
+  return devicesPerNode_;
+}
+
+void NcclContext::initHierarchicalComms() {
+  if (hierarchicalCommsInit_) {
+    return;
+  }
+  if (worldSize_ % devicesPerNode_ != 0) {
+    throw std::runtime_error(
+        "hierarchical allReduce requires the world size to be divisible by "
+        "MaxDevicePerNode");
+  }
+#if defined(NCCL_VERSION_CODE) && NCCL_VERSION_CODE >= NCCL_VERSION(2, 18, 0)
+  const int node = worldRank_ / devicesPerNode_;
+  const int localRank = worldRank_ % devicesPerNode_;
+  // ranks on the same node share an intra-node communicator; ranks with the
+  // same local index share an inter-node communicator
+  NCCLCHECK(ncclCommSplit(comm_, node, localRank, &intraNodeComm_, nullptr));
+  NCCLCHECK(ncclCommSplit(comm_, localRank, node, &interNodeComm_, nullptr));
+  hierarchicalCommsInit_ = true;
+#else
+  throw std::runtime_error(
+      "hierarchical allReduce requires NCCL >= 2.18 for ncclCommSplit");
+#endif
+}
+
+ncclComm_t& NcclContext::getIntraNodeComm() {
+  return intraNodeComm_;
+}
+
+ncclComm_t& NcclContext::getInterNodeComm() {
+  return interNodeComm_;
+}
+
 const CUDAStream& NcclContext::getReductionStream() const {
   return *reductionStream_;
 }
@@ -386,7 +832,19 @@ void* NcclContext::getCoalesceBuffer() {
   return ncclCtx;
 }
 
+std::string NcclContext::ncclStoreKey() const {
+  // the first rendezvous keeps the unsuffixed key for compatibility with
+  // launchers that pre-populate the store
+  return generation_ == 0
+      ? std::string(kNcclKey)
+      : std::string(kNcclKey) + "." + std::to_string(generation_);
+}
+
 void NcclContext::createCudaResources() {
+  // streams and buffers survive re-rendezvous - only build them once
+  if (reductionStream_ != nullptr) {
+    return;
+  }
   // initialize
   // - dedicated NCCL CUDA stream to support async allReduce
   // - a third dedicated stream to asynchronously copy gradients
@@ -423,10 +881,12 @@ void NcclContext::initWithMPI(
         "invalid MaxDevicePerNode for NCCL initWithMPI");
   }
 
+  devicesPerNode_ = std::stoi(maxDevicePerNode->second);
+
   ncclUniqueId id;
 
   // TODO: Determining device is ugly. Find a better way.
-  fl::setDevice(worldRank_ % std::stoi(maxDevicePerNode->second));
+  fl::setDevice(worldRank_ % devicesPerNode_);
 
   // get NCCL unique ID at rank 0 and broadcast it to all others
   if (worldRank_ == 0) {
@@ -458,22 +918,25 @@ void NcclContext::initWithFileSystem(
   worldRank_ = worldRank;
   worldSize_ = worldSize;
 
+  devicesPerNode_ = std::stoi(maxDevicePerNode->second);
+
   ncclUniqueId id;
 
-  fl::setDevice(worldRank_ % std::stoi(maxDevicePerNode->second));
+  fl::setDevice(worldRank_ % devicesPerNode_);
 
   // get NCCL unique ID at rank 0 and broadcast it to all others
   if (worldRank_ == 0) {
     ncclGetUniqueId(&id);
   }
 
+  const auto key = ncclStoreKey();
   auto fs = FileStore(filePath->second);
   if (worldRank_ == 0) {
     std::vector<char> data(sizeof(id));
     std::memcpy(data.data(), &id, sizeof(id));
-    fs.set(kNcclKey, data);
+    fs.set(key, data);
   } else {
-    auto data = fs.get(kNcclKey);
+    auto data = fs.get(key);
     std::memcpy(&id, data.data(), sizeof(id));
   }
   // No need for barrier here as ncclCommInitRank inherently synchronizes
@@ -483,17 +946,117 @@ void NcclContext::initWithFileSystem(
 
   // Remove the temporary file created for initialization
   if (worldRank_ == 0) {
-    fs.clear(kNcclKey);
+    fs.clear(key);
+  }
+
+  initParams_ = params;
+  createCudaResources();
+}
+
+void NcclContext::initWithTcp(
+    int worldRank,
+    int worldSize,
+    const std::unordered_map<std::string, std::string>& params) {
+  auto tcpAddr = params.find(DistributedConstants::kTcpAddr);
+  auto tcpPort = params.find(DistributedConstants::kTcpPort);
+  auto maxDevicePerNode = params.find(DistributedConstants::kMaxDevicePerNode);
+
+  if (tcpAddr == params.end() || tcpAddr->second.empty()) {
+    throw std::invalid_argument("invalid TcpAddr for NCCL initWithTcp");
+  }
+  if (tcpPort == params.end() || !isNonNegativeInteger(tcpPort->second)) {
+    throw std::invalid_argument("invalid TcpPort for NCCL initWithTcp");
+  }
+  if (maxDevicePerNode == params.end()) {
+    throw std::invalid_argument("invalid MaxDevicePerNode for NCCL initWithTcp");
+  }
+
+  worldRank_ = worldRank;
+  worldSize_ = worldSize;
+
+  devicesPerNode_ = std::stoi(maxDevicePerNode->second);
+
+  ncclUniqueId id;
+
+  fl::setDevice(worldRank_ % devicesPerNode_);
+
+  // get NCCL unique ID at rank 0 and share it through the TCP store, which
+  // needs no shared filesystem and answers waiting ranks without polling
+  if (worldRank_ == 0) {
+    ncclGetUniqueId(&id);
+  }
+
+  const auto key = ncclStoreKey();
+  auto store = TcpStore(
+      tcpAddr->second, std::stoi(tcpPort->second), /* isServer = */
+      worldRank_ == 0);
+  if (worldRank_ == 0) {
+    std::vector<char> data(sizeof(id));
+    std::memcpy(data.data(), &id, sizeof(id));
+    store.set(key, data);
+  } else {
+    auto data = store.get(key);
+    std::memcpy(&id, data.data(), sizeof(id));
   }
+  // No need for barrier here as ncclCommInitRank inherently synchronizes
 
+  // initializing NCCL
+  NCCLCHECK(ncclCommInitRank(&comm_, worldSize_, id, worldRank_));
+
+  initParams_ = params;
   createCudaResources();
 }
 
+void NcclContext::reinit(
+    int worldRank,
+    int worldSize,
+    const std::unordered_map<std::string, std::string>& params) {
+  const auto initMethod = DistributedInfo::getInstance().initMethod_;
+  if (initMethod != DistributedInit::FILE_SYSTEM &&
+      initMethod != DistributedInit::TCP) {
+    throw std::runtime_error(
+        "distributedReinit requires a store-based init method "
+        "(FILE_SYSTEM or TCP) - an MPI world cannot be renumbered in-process");
+  }
+
+  // Drain outstanding reductions and copies before tearing down the old
+  // communicators
+  reductionStream_->sync();
+  workerStream_->sync();
+
+#ifdef NO_NCCL_COMM_DESTROY_HANDLE
+// DEBUG : ncclCommDestroy disabled as it leads to segfault.
+#else
+  if (hierarchicalCommsInit_) {
+    NCCLCHECK(ncclCommDestroy(intraNodeComm_));
+    NCCLCHECK(ncclCommDestroy(interNodeComm_));
+  }
+  NCCLCHECK(ncclCommDestroy(comm_));
+#endif
+  hierarchicalCommsInit_ = false;
+  ++generation_;
+
+  // caller-supplied parameters override the ones used at startup
+  auto mergedParams = initParams_;
+  for (const auto& kv : params) {
+    mergedParams[kv.first] = kv.second;
+  }
+  if (initMethod == DistributedInit::FILE_SYSTEM) {
+    initWithFileSystem(worldRank, worldSize, mergedParams);
+  } else {
+    initWithTcp(worldRank, worldSize, mergedParams);
+  }
+}
+
 NcclContext::~NcclContext() {
 #ifdef NO_NCCL_COMM_DESTROY_HANDLE
 // DEBUG : ncclCommDestroy disabled as it leads to segfault.
 #else
   // finalizing NCCL
+  if (hierarchicalCommsInit_) {
+    NCCLCHECK(ncclCommDestroy(intraNodeComm_));
+    NCCLCHECK(ncclCommDestroy(interNodeComm_));
+  }
   NCCLCHECK(ncclCommDestroy(comm_));
 #endif
 
@@ -31,6 +31,15 @@ void distributedInit(
   detail::DistributedInfo::getInstance().isInitialized_ = true;
 }
 
+// Not yet supported
+void distributedReinit(
+    int /* worldRank */,
+    int /* worldSize */,
+    const std::unordered_map<std::string, std::string>& /* params = {} */) {
+  throw std::runtime_error(
+      "distributedReinit not supported for distributed stub backend");
+}
+
 void allReduce(Tensor& arr, bool async /* = false */) {
   if (!isDistributedInit()) {
     throw std::runtime_error("distributed environment not initialized");
@@ -38,6 +47,12 @@ void allReduce(Tensor& arr, bool async /* = false */) {
   throw std::runtime_error("allReduce not supported for stub backend");
 }
 
+// Not yet supported
+std::future<void> allReduceAsync(Tensor& arr) {
+  throw std::runtime_error(
+      "allReduceAsync not supported for distributed stub backend");
+}
+
 // Not yet supported
 void allReduceMultiple(
     std::vector<Tensor*> arrs,
@@ -47,6 +62,44 @@ void allReduceMultiple(
       "allReduceMultiple not supported for distributed stub backend");
 }
 
+// Not yet supported
+void reduceMultiple(
+    std::vector<Tensor*> arrs,
+    const std::vector<int>& roots,
+    bool async /* = false */) {
+  throw std::runtime_error(
+      "reduceMultiple not supported for distributed stub backend");
+}
+
+// Not yet supported
+void broadcastMultiple(
+    std::vector<Tensor*> arrs,
+    const std::vector<int>& roots,
+    bool async /* = false */) {
+  throw std::runtime_error(
+      "broadcastMultiple not supported for distributed stub backend");
+}
+
+// Not yet supported
+void allReduceMultipleHierarchical(
+    std::vector<Tensor*> arrs,
+    bool async /* = false */) {
+  throw std::runtime_error(
+      "allReduceMultipleHierarchical not supported for distributed stub "
+      "backend");
+}
+
+// Not yet supported
+Tensor allToAllv(
+    const Tensor& arr,
+    const std::vector<int64_t>& sendCounts,
+    const std::vector<int64_t>& recvCounts,
+    bool async /* = false */,
+    int numChunks /* = 1 */) {
+  throw std::runtime_error(
+      "allToAllv not supported for distributed stub backend");
+}
+
 void syncDistributed() {
   throw std::runtime_error(
       "Asynchronous allReduce not supported for distributed stub backend");
@@ -11,10 +11,15 @@
 
 namespace fl {
 
-CoalescingReducer::CoalescingReducer(double scale, bool async, bool contiguous)
+CoalescingReducer::CoalescingReducer(
+    double scale,
+    bool async,
+    bool contiguous,
+    bool hierarchical /* = false */)
     : scale_(scale),
       async_(async),
       contiguous_(contiguous),
+      hierarchical_(hierarchical),
       cacheThresholdBytes_(DistributedConstants::kCoalesceCacheSize) {}
 
 CoalescingReducer::~CoalescingReducer() {
@@ -22,6 +27,12 @@ CoalescingReducer::~CoalescingReducer() {
 }
 
 void CoalescingReducer::add(Variable& var) {
+  // under deterministic mode, reduce in insertion order on the compute
+  // stream -- coalescing still amortizes the per-reduction launch cost, so
+  // giving up the stream overlap costs far less than reducing gradient by
+  // gradient
+  const bool async = async_ && !DeterministicMode::get().enabled();
+
   // if this tensor would push the cache oversize, flush
   if (currCacheSize_ + var.bytes() > cacheThresholdBytes_) {
     flush();
@@ -30,13 +41,17 @@ void CoalescingReducer::add(Variable& var) {
   // check if the tensor is larger than the cache. If so, reduce immediately
   // and don't copy-coalesce
   if (var.bytes() > cacheThresholdBytes_) {
-    allReduce(var, scale_, async_);
+    allReduce(var, scale_, async);
+    if (flushCallback_) {
+      synchronize();
+      flushCallback_({var});
+    }
   } else {
     // if async, evaluating the JIT on the value upfront is more efficient than
     // evaluating the JIT for each Variable in the cache after we flush it,
     // since it more effectively facilitates overlapping compuation between the
     // AF and distributed compute streams.
-    if (async_) {
+    if (async) {
       var.eval();
     }
     // otherwise, add to cache
@@ -51,13 +66,32 @@ void CoalescingReducer::finalize() {
 }
 
 void CoalescingReducer::flush() {
-  allReduceMultiple(cache_, scale_, async_, contiguous_);
+  const bool async = async_ && !DeterministicMode::get().enabled();
+  if (cache_.empty()) {
+    return;
+  }
+  if (hierarchical_) {
+    allReduceMultipleHierarchical(cache_, scale_, async);
+  } else {
+    allReduceMultiple(cache_, scale_, async, contiguous_);
+  }
+  if (flushCallback_) {
+    // order work the callback enqueues after this bucket's reduction; later
+    // buckets keep reducing in the distributed compute stream
+    synchronize();
+    flushCallback_(cache_);
+  }
   currCacheSize_ = 0;
   cache_.clear();
 }
 
+void CoalescingReducer::setFlushCallback(
+    std::function<void(const std::vector<Variable>&)> callback) {
+  flushCallback_ = std::move(callback);
+}
+
 void CoalescingReducer::synchronize() {
-  if (async_ || contiguous_) {
+  if (async_ || contiguous_ || hierarchical_) {
     syncDistributed();
   }
 }
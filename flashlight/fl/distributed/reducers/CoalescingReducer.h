@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <functional>
 #include <vector>
 
 #include "flashlight/fl/common/Defines.h"
@@ -24,6 +25,10 @@ class Variable;
  * Since the Reducer executes ``allReduceMultiple`` operations asynchronously,
  * to guarantee that synchronized values are available after reduction,
  * ``finalize`` must be called before using a given value.
+ *
+ * When `DeterministicMode` is enabled, reductions run synchronously on the
+ * compute stream in insertion order regardless of the ``async`` setting, so
+ * the summation order is reproducible across runs.
  */
 class FL_API CoalescingReducer : public Reducer {
   /// A scale by which to scale reduced gradients
@@ -34,6 +39,10 @@ class FL_API CoalescingReducer : public Reducer {
   /// Determines if the coalesced batch of gradients is put into
   /// contiguous memory before being synchronized
   bool contiguous_{true};
+  /// Determines if flushes reduce hierarchically: an intra-node
+  /// reduce-scatter, an inter-node allreduce of shards, and an intra-node
+  /// allgather, so each byte crosses the slower inter-node links only once
+  bool hierarchical_{false};
   /// The threshold at which the cache will be flushed and its contents
   /// synchronized, in bytes
   const std::size_t cacheThresholdBytes_;
@@ -41,6 +50,8 @@ class FL_API CoalescingReducer : public Reducer {
   std::vector<Variable> cache_;
   /// The current cache size, in bytes
   std::size_t currCacheSize_{0};
+  /// Invoked with each flushed bucket's Variables; see setFlushCallback
+  std::function<void(const std::vector<Variable>&)> flushCallback_;
 
  public:
   /**
@@ -52,8 +63,17 @@ class FL_API CoalescingReducer : public Reducer {
    * runs asynchronously to the AF stream.
    * @param[in] contiguous forces synchronization of the set of Variables
    * to occur in a contiguous buffer, which may improve performance.
+   * @param[in] hierarchical synchronize flushed caches with
+   * ``allReduceMultipleHierarchical`` rather than a flat allreduce, which may
+   * improve performance on multi-node topologies whose intra-node
+   * interconnect is faster than the inter-node links. Implies contiguous
+   * synchronization.
    */
-  CoalescingReducer(double scale, bool async, bool contiguous);
+  CoalescingReducer(
+      double scale,
+      bool async,
+      bool contiguous,
+      bool hierarchical = false);
 
   /**
    * Destroy the Reducer. Calls `finalize()` before returning.
@@ -76,6 +96,19 @@ class FL_API CoalescingReducer : public Reducer {
    */
   void finalize() override;
 
+  /**
+   * Register a callback invoked with each flushed bucket's ``Variable``s
+   * after that bucket's reduction has been enqueued. The compute stream is
+   * first synchronized with the reductions enqueued so far, so work the
+   * callback launches -- e.g. the optimizer update for just this bucket's
+   * parameters via ``FirstOrderOptimizer::stepParams`` -- is ordered after
+   * the bucket's reduction while later buckets' communication proceeds
+   * concurrently in the distributed compute stream. Pass `nullptr` to
+   * remove the callback.
+   */
+  void setFlushCallback(
+      std::function<void(const std::vector<Variable>&)> callback);
+
  private:
   /**
    * Synchronize the existing set of Variables with ``allReduceMultiple`` and
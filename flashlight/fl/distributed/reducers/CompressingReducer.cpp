@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "flashlight/fl/distributed/reducers/CompressingReducer.h"
+
+#include <stdexcept>
+
+#include "flashlight/fl/autograd/Variable.h"
+#include "flashlight/fl/distributed/DistributedApi.h"
+#include "flashlight/fl/tensor/Compute.h"
+
+namespace fl {
+
+CompressingReducer::CompressingReducer(
+    double scale,
+    bool async,
+    fl::dtype commType /* = fl::dtype::f16 */)
+    : scale_(scale), async_(async), commType_(commType) {
+  // the tensor framework has no bfloat16 type; half precision is the only
+  // narrower floating point type available for the wire format
+  if (commType_ != fl::dtype::f16) {
+    throw std::invalid_argument(
+        "CompressingReducer - unsupported communication type; "
+        "only f16 is supported");
+  }
+}
+
+CompressingReducer::~CompressingReducer() {
+  finalize();
+}
+
+void CompressingReducer::add(Variable& var) {
+  Tensor& grad = var.tensor();
+  const auto idx = step_++;
+  // gradients already in the wire format (or single-process runs) need no
+  // compression or residual; the Variable overload applies the scale the
+  // same way CoalescingReducer does, with finalize() ordering consumption
+  if (grad.type() == commType_ || getWorldSize() <= 1) {
+    allReduce(var, scale_, async_);
+    return;
+  }
+
+  if (idx >= residuals_.size()) {
+    residuals_.resize(idx + 1);
+  }
+  Tensor& residual = residuals_[idx];
+
+  // fold the precision lost in the previous step back into this gradient
+  // before compressing (error feedback)
+  Tensor compensated = residual.isEmpty() ? grad : grad + residual;
+  Tensor compressed = compensated.astype(commType_);
+  residual = compensated - compressed.astype(grad.type());
+  fl::eval(residual);
+
+  allReduce(compressed, async_);
+  if (async_) {
+    // the reduced values must not be consumed on the Flashlight compute
+    // stream before syncDistributed() has run (see DistributedApi.h), so
+    // defer decompression to finalize()
+    pending_.emplace_back(var, compressed);
+  } else {
+    grad = compressed.astype(grad.type()) * scale_;
+    fl::eval(grad);
+  }
+}
+
+void CompressingReducer::finalize() {
+  if (async_) {
+    syncDistributed();
+  }
+  // the reduced values are now visible to the Flashlight compute stream;
+  // materialize the deferred decompressions
+  for (auto& entry : pending_) {
+    Tensor& grad = entry.first.tensor();
+    grad = entry.second.astype(grad.type()) * scale_;
+    fl::eval(grad);
+  }
+  pending_.clear();
+  step_ = 0;
+}
+
+} // namespace fl
@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <utility>
+#include <vector>
+
+#include "flashlight/fl/common/Defines.h"
+#include "flashlight/fl/distributed/reducers/Reducer.h"
+#include "flashlight/fl/tensor/TensorBase.h"
+
+namespace fl {
+
+class Variable;
+
+/**
+ * A Reducer which casts gradients to a lower-precision type before calling
+ * ``allReduce``, halving the bytes sent over the interconnect, and keeps a
+ * per-gradient error-feedback residual: the part of each gradient lost to the
+ * downcast is carried over and added back before the next step's compression,
+ * so the quantization error does not accumulate and convergence tracks
+ * full-precision synchronization.
+ *
+ * Residuals are matched to gradients by the order in which they are added, so
+ * gradients must be added in the same order every step (as produced by a
+ * deterministic backward pass); ``finalize`` marks the end of a step and
+ * resets the position.
+ */
+class FL_API CompressingReducer : public Reducer {
+  /// A scale by which to scale reduced gradients
+  double scale_;
+  /// Whether or not the distributed synchronization operates in a separate
+  /// compute stream asynchronously to the ArrayFire stream
+  bool async_{true};
+  /// The type gradients are cast to for synchronization
+  fl::dtype commType_;
+  /// Error-feedback residuals, one per gradient, in add order
+  std::vector<Tensor> residuals_;
+  /// Position within residuals_ for the current step
+  std::size_t step_{0};
+  /// Variables whose reduced compressed gradients have not yet been
+  /// decompressed, paired with those compressed gradients. In async mode the
+  /// reduced values may not be consumed on the Flashlight compute stream
+  /// until ``syncDistributed`` has run, so decompression is deferred to
+  /// ``finalize``.
+  std::vector<std::pair<Variable, Tensor>> pending_;
+
+ public:
+  /**
+   * Creates a new compressing reducer.
+   *
+   * @param[in] scale the factor by which to scale gradients after
+   * synchronization
+   * @param[in] async determines whether or not the distributed compute stream
+   * runs asynchronously to the AF stream.
+   * @param[in] commType the type gradients are compressed to before
+   * synchronization; must be a floating point type narrower than the
+   * gradients.
+   */
+  CompressingReducer(
+      double scale,
+      bool async,
+      fl::dtype commType = fl::dtype::f16);
+
+  /**
+   * Destroy the Reducer. Calls `finalize()` before returning.
+   */
+  ~CompressingReducer() override;
+
+  /**
+   * Add the carried residual to the ``Variable``'s gradient, compress, call
+   * ``allReduce`` on the compressed gradient, and store the new residual. In
+   * async mode the decompressed gradient is only materialized by
+   * ``finalize``; the ``Variable``'s gradient must not be used before then.
+   */
+  void add(Variable& var) override;
+
+  /**
+   * Synchronize with the distributed compute stream, decompress and scale
+   * gradients that were reduced asynchronously, and reset the residual
+   * position for the next step.
+   */
+  void finalize() override;
+};
+
+} // namespace fl
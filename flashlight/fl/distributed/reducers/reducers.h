@@ -8,5 +8,6 @@
 #pragma once
 
 #include "flashlight/fl/distributed/reducers/CoalescingReducer.h"
+#include "flashlight/fl/distributed/reducers/CompressingReducer.h"
 #include "flashlight/fl/distributed/reducers/InlineReducer.h"
 #include "flashlight/fl/distributed/reducers/Reducer.h"
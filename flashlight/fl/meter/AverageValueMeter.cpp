@@ -7,22 +7,55 @@
 
 #include "flashlight/fl/meter/AverageValueMeter.h"
 
+#include <utility>
+
 #include "flashlight/fl/tensor/TensorBase.h"
 
 namespace fl {
 
-AverageValueMeter::AverageValueMeter() {
+namespace {
+
+// Kahan-compensated add: folds `delta` into `sum`, carrying the rounding
+// error in `comp` so long streams of small corrections are not lost
+void compensatedAdd(double& sum, double& comp, const double delta) {
+  const double y = delta - comp;
+  const double t = sum + y;
+  comp = (t - sum) - y;
+  sum = t;
+}
+
+// Scalar reductions accumulate in the value dtype on device; promote
+// half-precision results to f32 before they join the running sums so
+// low-precision streams neither drift nor saturate. Only the one-element
+// reduction result is converted - never the activations themselves.
+Tensor promoteHalf(Tensor&& reduced) {
+  if (reduced.type() == fl::dtype::f16) {
+    return reduced.astype(fl::dtype::f32);
+  }
+  return std::move(reduced);
+}
+
+} // namespace
+
+AverageValueMeter::AverageValueMeter(const bool accumOnDevice /* = false */)
+    : accumOnDevice_(accumOnDevice) {
   reset();
 }
 
 void AverageValueMeter::reset() {
   curMean_ = 0;
   curMeanSquaredSum_ = 0;
+  curMeanComp_ = 0;
+  curMeanSquaredSumComp_ = 0;
   curWeightSum_ = 0;
   curWeightSquaredSum_ = 0;
+  deviceSum_ = Tensor();
+  deviceSquaredSum_ = Tensor();
+  deviceWeight_ = 0;
 }
 
 void AverageValueMeter::add(const double val, const double w /* = 1.0 */) {
+  flushDeviceSums();
   curWeightSum_ += w;
   curWeightSquaredSum_ += w * w;
 
@@ -30,12 +63,26 @@ void AverageValueMeter::add(const double val, const double w /* = 1.0 */) {
     return;
   }
 
-  curMean_ = curMean_ + w * (val - curMean_) / curWeightSum_;
-  curMeanSquaredSum_ =
-      curMeanSquaredSum_ + w * (val * val - curMeanSquaredSum_) / curWeightSum_;
+  compensatedAdd(curMean_, curMeanComp_, w * (val - curMean_) / curWeightSum_);
+  compensatedAdd(
+      curMeanSquaredSum_,
+      curMeanSquaredSumComp_,
+      w * (val * val - curMeanSquaredSum_) / curWeightSum_);
 }
 
 void AverageValueMeter::add(const Tensor& vals) {
+  if (accumOnDevice_) {
+    // Keep running sums on device - no host synchronization per batch
+    if (deviceSum_.isEmpty()) {
+      deviceSum_ = promoteHalf(fl::sum(vals));
+      deviceSquaredSum_ = promoteHalf(fl::sum(vals * vals));
+    } else {
+      deviceSum_ = deviceSum_ + promoteHalf(fl::sum(vals));
+      deviceSquaredSum_ = deviceSquaredSum_ + promoteHalf(fl::sum(vals * vals));
+    }
+    deviceWeight_ += vals.elements();
+    return;
+  }
   double w = vals.elements();
   curWeightSum_ += w;
   curWeightSquaredSum_ += w;
@@ -44,14 +91,41 @@ void AverageValueMeter::add(const Tensor& vals) {
     return;
   }
 
-  curMean_ = curMean_ +
-      (fl::sum(vals).asScalar<double>() - w * curMean_) / curWeightSum_;
-  curMeanSquaredSum_ = curMeanSquaredSum_ +
+  compensatedAdd(
+      curMean_,
+      curMeanComp_,
+      (fl::sum(vals).asScalar<double>() - w * curMean_) / curWeightSum_);
+  compensatedAdd(
+      curMeanSquaredSum_,
+      curMeanSquaredSumComp_,
       (fl::sum(vals * vals).asScalar<double>() - w * curMeanSquaredSum_) /
-          curWeightSum_;
+          curWeightSum_);
+}
+
+void AverageValueMeter::flushDeviceSums() const {
+  if (deviceWeight_ == 0) {
+    return;
+  }
+  // Same update as add(const Tensor&), with the reductions read back once
+  const double w = deviceWeight_;
+  curWeightSum_ += w;
+  curWeightSquaredSum_ += w;
+  compensatedAdd(
+      curMean_,
+      curMeanComp_,
+      (deviceSum_.asScalar<double>() - w * curMean_) / curWeightSum_);
+  compensatedAdd(
+      curMeanSquaredSum_,
+      curMeanSquaredSumComp_,
+      (deviceSquaredSum_.asScalar<double>() - w * curMeanSquaredSum_) /
+          curWeightSum_);
+  deviceSum_ = Tensor();
+  deviceSquaredSum_ = Tensor();
+  deviceWeight_ = 0;
 }
 
 std::vector<double> AverageValueMeter::value() const {
+  flushDeviceSums();
   double mean = curMean_;
   double var = (curMeanSquaredSum_ - curMean_ * curMean_) /
       (1 - curWeightSquaredSum_ / (curWeightSum_ * curWeightSum_));
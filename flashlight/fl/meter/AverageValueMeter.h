@@ -10,11 +10,10 @@
 #include <vector>
 
 #include "flashlight/fl/common/Defines.h"
+#include "flashlight/fl/tensor/TensorBase.h"
 
 namespace fl {
 
-class Tensor;
-
 /**
  * An implementation of average value meter, which measures the mean and
  * variance of a sequence of values.
@@ -42,8 +41,13 @@ class Tensor;
  */
 class FL_API AverageValueMeter {
  public:
-  /** Constructor of `AverageValueMeter`. */
-  AverageValueMeter();
+  /** Constructor of `AverageValueMeter`.
+   * @param accumOnDevice if true, tensor adds accumulate running sums in
+   * device tensors and only copy to the host when a value is read, so
+   * per-batch `add(const Tensor&)` calls do not synchronize with the device.
+   * Read values (e.g. once per epoch) rather than per batch in this mode.
+   */
+  explicit AverageValueMeter(const bool accumOnDevice = false);
 
   /** Updates counters with the given value `val` with weight `w`. */
   void add(const double val, const double w = 1.0);
@@ -64,9 +68,24 @@ class FL_API AverageValueMeter {
   void reset();
 
  private:
-  double curMean_;
-  double curMeanSquaredSum_;
-  double curWeightSum_;
-  double curWeightSquaredSum_;
+  // Folds device-side running sums into the host counters; no-op unless
+  // accumulating on device
+  void flushDeviceSums() const;
+
+  bool accumOnDevice_{false};
+  mutable double curMean_;
+  mutable double curMeanSquaredSum_;
+  // Kahan compensation terms for the two running moments - each update folds
+  // a small correction into a large running value, which is exactly where
+  // uncompensated summation drifts over long streams
+  mutable double curMeanComp_;
+  mutable double curMeanSquaredSumComp_;
+  mutable double curWeightSum_;
+  mutable double curWeightSquaredSum_;
+  // Running sum and sum of squares when accumulating on device
+  mutable Tensor deviceSum_;
+  mutable Tensor deviceSquaredSum_;
+  // Number of elements behind the device-side sums; known host-side
+  mutable double deviceWeight_{0};
 };
 } // namespace fl
@@ -8,10 +8,16 @@
 #pragma once
 
 #include <algorithm>
+#include <cstdint>
+#include <future>
+#include <iterator>
 #include <numeric>
+#include <stdexcept>
+#include <thread>
 #include <vector>
 
 #include "flashlight/fl/common/Defines.h"
+#include "flashlight/fl/common/threadpool/ThreadPool.h"
 
 namespace fl {
 
@@ -109,14 +115,81 @@ class FL_API EditDistanceMeter {
     add(output.data(), target.data(), output.size(), target.size());
   }
 
+  /** Computes edit distances for a batch of output/target pairs, distributing
+   * pairs over a thread pool, and updates the counters once all pairs are
+   * complete. Counter totals are identical to adding each pair serially.
+   *
+   * @param[in] outputs predictions, one entry per utterance
+   * @param[in] targets references, one entry per utterance
+   * @param[in] numThreads number of worker threads; 0 (the default) uses the
+   * hardware concurrency
+   */
+  template <typename T>
+  void addBatch(
+      const std::vector<std::vector<T>>& outputs,
+      const std::vector<std::vector<T>>& targets,
+      size_t numThreads = 0) {
+    if (outputs.size() != targets.size()) {
+      throw std::invalid_argument(
+          "EditDistanceMeter::addBatch - outputs and targets "
+          "must contain the same number of entries");
+    }
+    if (numThreads == 0) {
+      numThreads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    ThreadPool threadPool(numThreads);
+    std::vector<std::future<ErrorState>> errorStates;
+    errorStates.reserve(outputs.size());
+    for (size_t i = 0; i < outputs.size(); ++i) {
+      errorStates.push_back(threadPool.enqueue([this, &outputs, &targets, i]() {
+        return levensteinDistance(
+            outputs[i].data(),
+            targets[i].data(),
+            outputs[i].size(),
+            targets[i].size());
+      }));
+    }
+    for (size_t i = 0; i < errorStates.size(); ++i) {
+      add(errorStates[i].get(), targets[i].size());
+    }
+  }
+
+  /** Restricts the distance computation to a diagonal band of the dynamic
+   * programming matrix (Ukkonen's band), reducing the per-pair cost from
+   * O(olen * tlen) to O(band * tlen). The band is widened to at least the
+   * length difference of each pair so the computation always completes;
+   * results are exact whenever the true edit distance does not exceed the
+   * band, and an upper bound otherwise. For WER computation over reasonable
+   * transcripts a band of 10-20 loses no accuracy.
+   *
+   * @param[in] band the band half-width; 0 (the default) disables banding
+   */
+  void setBandLimit(int64_t band) {
+    if (band < 0) {
+      throw std::invalid_argument(
+          "EditDistanceMeter::setBandLimit - band must be non-negative");
+    }
+    bandLimit_ = band;
+  }
+
+  /** Returns the band half-width set via `setBandLimit`; 0 when disabled. */
+  int64_t bandLimit() const {
+    return bandLimit_;
+  }
+
   /** Sets all the counters to 0. */
   void reset();
 
  private:
+  // Sentinel error count marking cells outside the band; large enough that an
+  // out-of-band cell never wins the minimum, small enough not to overflow
+  static constexpr int64_t kOutOfBand = 1LL << 30;
+
   int64_t n_;
   int64_t ndel_;
   int64_t nins_;
   int64_t nsub_;
+  int64_t bandLimit_{0};
 
   int64_t sumErr() const {
     return ndel_ + nins_ + nsub_;
@@ -128,35 +201,54 @@ class FL_API EditDistanceMeter {
       const T& in2begin,
       size_t len1,
       size_t len2) const {
+    // Only diagonals within the band are evaluated; the band is widened to at
+    // least the length difference so the (len1, len2) corner stays reachable
+    int64_t band = 0;
+    if (bandLimit_ > 0) {
+      band = std::max(
+          bandLimit_,
+          std::abs(
+              static_cast<int64_t>(len1) - static_cast<int64_t>(len2)));
+    }
+
     std::vector<ErrorState> column(len1 + 1);
     for (int i = 0; i <= len1; ++i) {
       column[i].nins = i;
     }
 
     auto curin2 = in2begin;
-    for (int x = 1; x <= len2; x++) {
-      ErrorState lastdiagonal = column[0];
-      column[0].ndel = x;
+    for (int64_t x = 1; x <= static_cast<int64_t>(len2); x++) {
+      const int64_t yStart = band ? std::max<int64_t>(1, x - band) : 1;
+      const int64_t yEnd =
+          band ? std::min<int64_t>(len1, x + band) : static_cast<int64_t>(len1);
+      ErrorState lastdiagonal;
+      if (yStart > 1) {
+        // Entering mid-column: the cell left of the band start is a valid
+        // diagonal predecessor, but not an insertion source for this row
+        lastdiagonal = column[yStart - 1];
+        column[yStart - 1].ndel = kOutOfBand;
+      } else {
+        lastdiagonal = column[0];
+        column[0].ndel = x;
+      }
       auto curin1 = in1begin;
-      for (int y = 1; y <= len1; y++) {
+      std::advance(curin1, yStart - 1);
+      for (int64_t y = yStart; y <= yEnd; y++) {
         auto olddiagonal = column[y];
-        auto possibilities = {
-            column[y].sum() + 1,
-            column[y - 1].sum() + 1,
-            lastdiagonal.sum() + ((*curin1 == *curin2) ? 0 : 1)};
-        auto min_it =
-            std::min_element(possibilities.begin(), possibilities.end());
-        if (std::distance(possibilities.begin(), min_it) ==
-            0) { // deletion error
+        const bool match = (*curin1 == *curin2);
+        // Above the band, column[y] holds a stale value from an earlier row
+        const int64_t delSum =
+            (band && y == x + band) ? kOutOfBand : column[y].sum() + 1;
+        const int64_t insSum = column[y - 1].sum() + 1;
+        const int64_t subSum = lastdiagonal.sum() + (match ? 0 : 1);
+        if (delSum <= insSum && delSum <= subSum) { // deletion error
           ++column[y].ndel;
-        } else if (
-            std::distance(possibilities.begin(), min_it) == 1) { // insertion
-          // error
+        } else if (insSum <= subSum) { // insertion error
           column[y] = column[y - 1];
           ++column[y].nins;
         } else {
           column[y] = lastdiagonal;
-          if (*curin1 != *curin2) { // substitution error
+          if (!match) { // substitution error
             ++column[y].nsub;
           }
         }
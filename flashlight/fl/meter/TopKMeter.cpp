@@ -12,7 +12,8 @@
 
 namespace fl {
 
-TopKMeter::TopKMeter(const int k) : k_(k), correct_(0), n_(0){};
+TopKMeter::TopKMeter(const int k, const bool accumOnDevice /* = false */)
+    : k_(k), accumOnDevice_(accumOnDevice), correct_(0), n_(0){};
 
 void TopKMeter::add(const Tensor& output, const Tensor& target) {
   if (output.dim(1) != target.dim(0)) {
@@ -28,27 +29,47 @@ void TopKMeter::add(const Tensor& output, const Tensor& target) {
   match = maxIds == fl::reshape(target, {1, target.dim(0), 1, 1});
   const Tensor correct = fl::any(match, {0});
 
-  correct_ += fl::countNonzero(correct).asScalar<int32_t>();
+  if (accumOnDevice_) {
+    // Keep the running count on device - no host synchronization per batch
+    if (deviceCorrect_.isEmpty()) {
+      deviceCorrect_ = fl::countNonzero(correct);
+    } else {
+      deviceCorrect_ = deviceCorrect_ + fl::countNonzero(correct);
+    }
+  } else {
+    correct_ += fl::countNonzero(correct).asScalar<int32_t>();
+  }
   const int batchsize = target.dim(0);
   n_ += batchsize;
 }
 
+void TopKMeter::flushDeviceCount() const {
+  if (!deviceCorrect_.isEmpty()) {
+    correct_ += deviceCorrect_.asScalar<int32_t>();
+    deviceCorrect_ = Tensor();
+  }
+}
+
 void TopKMeter::reset() {
   correct_ = 0;
   n_ = 0;
+  deviceCorrect_ = Tensor();
 }
 
 double TopKMeter::value() const {
+  flushDeviceCount();
   return (static_cast<double>(correct_) / n_) * 100.0f;
 }
 
 std::pair<int32_t, int32_t> TopKMeter::getStats() {
+  flushDeviceCount();
   return std::make_pair(correct_, n_);
 }
 
 void TopKMeter::set(int32_t correct, int32_t n) {
   n_ = n;
   correct_ = correct;
+  deviceCorrect_ = Tensor();
 }
 
 } // namespace fl
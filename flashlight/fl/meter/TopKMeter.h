@@ -10,11 +10,10 @@
 #include <utility>
 
 #include "flashlight/fl/common/Defines.h"
+#include "flashlight/fl/tensor/TensorBase.h"
 
 namespace fl {
 
-class Tensor;
-
 /**
  * TopKMeter computes the accuracy of the model outputs predicting the target
  * label in the top k predictions.
@@ -34,11 +33,15 @@ class FL_API TopKMeter {
  public:
   /** Constructor of `TopKMeter`.
    * @param k number of top predictions in order to be considered correct
+   * @param accumOnDevice if true, the correct-prediction count is accumulated
+   * in a device tensor and only copied to the host when a value is read, so
+   * per-batch `add` calls do not synchronize with the device. Read values
+   * (e.g. once per epoch) rather than per batch in this mode.
    * Will have two counters:
    * - `correct`: total number of correct predictions
    * - `n`: total number of of predictions
    */
-  explicit TopKMeter(const int k);
+  explicit TopKMeter(const int k, const bool accumOnDevice = false);
 
   void add(const Tensor& output, const Tensor& target);
 
@@ -52,9 +55,16 @@ class FL_API TopKMeter {
   double value() const;
 
  private:
+  // Folds the device-side count into `correct_`; no-op unless accumulating
+  // on device
+  void flushDeviceCount() const;
+
   int k_;
-  int32_t correct_;
+  bool accumOnDevice_;
+  mutable int32_t correct_;
   int32_t n_;
+  // Running correct-prediction count when accumulating on device
+  mutable Tensor deviceCorrect_;
 };
 
 } // namespace fl
@@ -0,0 +1,248 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "flashlight/fl/nn/DataParallel.h"
+
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+
+#include "flashlight/fl/tensor/Compute.h"
+#include "flashlight/fl/tensor/Index.h"
+
+#if FL_BACKEND_CUDA
+#include "flashlight/fl/runtime/CUDAUtils.h"
+#endif
+
+namespace fl {
+
+namespace detail {
+
+void setActiveDevice(DeviceType deviceType, int deviceId) {
+  DeviceManager::getInstance().getDevice(deviceType, deviceId).setActive();
+}
+
+Tensor copyToActiveDevice(
+    const Tensor& tensor,
+    DeviceType deviceType,
+    int srcDeviceId) {
+#if FL_BACKEND_CUDA
+  if (deviceType == DeviceType::CUDA) {
+    fl::sync(srcDeviceId); // ensure pending writes to the source are done
+    Tensor result(tensor.shape(), tensor.type());
+    void* dstPtr = result.device<void>();
+    const void* srcPtr = tensor.device<void>();
+    // with unified addressing this is a direct peer copy when peer access is
+    // enabled, and transparently staged otherwise
+    FL_CUDA_CHECK(
+        cudaMemcpy(dstPtr, srcPtr, tensor.bytes(), cudaMemcpyDefault));
+    tensor.unlock();
+    result.unlock();
+    return result;
+  }
+#endif
+  (void)srcDeviceId;
+  std::vector<uint8_t> buffer(tensor.bytes());
+  tensor.host(buffer.data());
+  return Tensor::fromBuffer(
+      tensor.shape(), tensor.type(), buffer.data(), Location::Host);
+}
+
+} // namespace detail
+
+DataParallel::DataParallel(
+    std::shared_ptr<Module> module,
+    std::vector<int> deviceIds /* = {} */,
+    DeviceType deviceType /* = kDefaultDeviceType */)
+    : deviceType_(deviceType), deviceIds_(std::move(deviceIds)) {
+  if (!module) {
+    throw std::invalid_argument("[DataParallel] null module");
+  }
+  auto& manager = DeviceManager::getInstance();
+  if (deviceIds_.empty()) {
+    for (const auto* device : manager.getDevicesOfType(deviceType_)) {
+      deviceIds_.push_back(device->nativeId());
+    }
+    std::sort(deviceIds_.begin(), deviceIds_.end());
+  }
+  if (deviceIds_.empty()) {
+    throw std::invalid_argument("[DataParallel] no devices to replicate onto");
+  }
+  // validate ids eagerly -- getDevice throws for unknown ones
+  for (const int id : deviceIds_) {
+    manager.getDevice(deviceType_, id);
+  }
+
+#if FL_BACKEND_CUDA
+  if (deviceType_ == DeviceType::CUDA) {
+    // best effort -- without peer access, copies stage through host memory
+    for (unsigned idx = 0; idx < deviceIds_.size(); idx++) {
+      setActiveDevice(idx);
+      for (const int peer : deviceIds_) {
+        if (peer == deviceIds_[idx]) {
+          continue;
+        }
+        const auto err = cudaDeviceEnablePeerAccess(peer, 0);
+        if (err != cudaSuccess && err != cudaErrorPeerAccessAlreadyEnabled) {
+          cudaGetLastError(); // clear the sticky error state
+        }
+      }
+    }
+  }
+#endif
+
+  const auto params = module->params();
+  replicas_.push_back(std::move(module));
+  for (unsigned idx = 1; idx < deviceIds_.size(); idx++) {
+    setActiveDevice(idx);
+    std::shared_ptr<Module> replica = replicas_.front()->clone();
+    for (unsigned i = 0; i < params.size(); i++) {
+      replica->setParams(
+          Variable(
+              copyToActiveDevice(params[i].tensor(), deviceIds_.front()),
+              params[i].isCalcGrad()),
+          i);
+    }
+    replicas_.push_back(std::move(replica));
+  }
+  setActiveDevice(0);
+}
+
+void DataParallel::setActiveDevice(unsigned replicaIdx) const {
+  detail::setActiveDevice(deviceType_, deviceIds_[replicaIdx]);
+}
+
+Tensor DataParallel::copyToActiveDevice(const Tensor& tensor, int srcDeviceId)
+    const {
+  return detail::copyToActiveDevice(tensor, deviceType_, srcDeviceId);
+}
+
+unsigned DataParallel::replicaCount() const {
+  return static_cast<unsigned>(replicas_.size());
+}
+
+const std::vector<int>& DataParallel::deviceIds() const {
+  return deviceIds_;
+}
+
+std::shared_ptr<Module> DataParallel::replica(unsigned replicaIdx) const {
+  return replicas_.at(replicaIdx);
+}
+
+std::vector<Tensor> DataParallel::scatter(const Tensor& batch) const {
+  if (batch.ndim() == 0) {
+    throw std::invalid_argument("[DataParallel::scatter] cannot split scalar");
+  }
+  const auto batchAxis = batch.ndim() - 1;
+  const Dim batchSize = batch.dim(batchAxis);
+  const Dim numReplicas = replicas_.size();
+  if (batchSize < numReplicas) {
+    std::ostringstream oss;
+    oss << "[DataParallel::scatter] batch dimension (" << batchSize
+        << ") is smaller than the number of replicas (" << numReplicas << ")";
+    throw std::invalid_argument(oss.str());
+  }
+  const Dim shardSize = batchSize / numReplicas;
+  const Dim remainder = batchSize % numReplicas;
+
+  std::vector<Tensor> shards;
+  Dim start = 0;
+  for (unsigned idx = 0; idx < replicas_.size(); idx++) {
+    const Dim end = start + shardSize + (idx < remainder ? 1 : 0);
+    std::vector<Index> indices(batch.ndim(), fl::span);
+    indices[batchAxis] = fl::range(start, end);
+    const Tensor shard = batch(indices);
+    if (idx == 0) {
+      shards.push_back(shard);
+    } else {
+      setActiveDevice(idx);
+      shards.push_back(copyToActiveDevice(shard, deviceIds_.front()));
+    }
+    start = end;
+  }
+  setActiveDevice(0);
+  return shards;
+}
+
+Tensor DataParallel::gather(const std::vector<Tensor>& shards) const {
+  if (shards.size() != replicas_.size()) {
+    std::ostringstream oss;
+    oss << "[DataParallel::gather] expected one shard per replica ("
+        << replicas_.size() << "), got: " << shards.size();
+    throw std::invalid_argument(oss.str());
+  }
+  setActiveDevice(0);
+  std::vector<Tensor> onPrimaryDevice{shards.front()};
+  for (unsigned idx = 1; idx < shards.size(); idx++) {
+    onPrimaryDevice.push_back(
+        copyToActiveDevice(shards[idx], deviceIds_[idx]));
+  }
+  return fl::concatenate(onPrimaryDevice, shards.front().ndim() - 1);
+}
+
+void DataParallel::forEach(
+    const std::function<void(unsigned, Module&)>& fn) {
+  for (unsigned idx = 0; idx < replicas_.size(); idx++) {
+    setActiveDevice(idx);
+    fn(idx, *replicas_[idx]);
+  }
+  setActiveDevice(0);
+}
+
+void DataParallel::reduceGradients() {
+  setActiveDevice(0);
+  auto primaryParams = replicas_.front()->params();
+  for (unsigned i = 0; i < primaryParams.size(); i++) {
+    if (!primaryParams[i].isGradAvailable()) {
+      continue;
+    }
+    auto grad = primaryParams[i].grad();
+    Tensor sum = grad.tensor();
+    for (unsigned idx = 1; idx < replicas_.size(); idx++) {
+      const auto replicaParam = replicas_[idx]->params()[i];
+      if (!replicaParam.isGradAvailable()) {
+        std::ostringstream oss;
+        oss << "[DataParallel::reduceGradients] replica " << idx
+            << " has no gradient for parameter " << i;
+        throw std::runtime_error(oss.str());
+      }
+      sum = sum +
+          copyToActiveDevice(replicaParam.grad().tensor(), deviceIds_[idx]);
+    }
+    grad.tensor() = sum / static_cast<double>(replicas_.size());
+  }
+}
+
+void DataParallel::broadcastParameters() {
+  const auto primaryParams = replicas_.front()->params();
+  for (unsigned idx = 1; idx < replicas_.size(); idx++) {
+    setActiveDevice(idx);
+    for (unsigned i = 0; i < primaryParams.size(); i++) {
+      replicas_[idx]->setParams(
+          Variable(
+              copyToActiveDevice(
+                  primaryParams[i].tensor(), deviceIds_.front()),
+              primaryParams[i].isCalcGrad()),
+          i);
+    }
+  }
+  setActiveDevice(0);
+}
+
+void DataParallel::train() {
+  for (auto& replica : replicas_) {
+    replica->train();
+  }
+}
+
+void DataParallel::eval() {
+  for (auto& replica : replicas_) {
+    replica->eval();
+  }
+}
+
+} // namespace fl
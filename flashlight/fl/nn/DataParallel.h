@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "flashlight/fl/common/Defines.h"
+#include "flashlight/fl/nn/modules/Module.h"
+#include "flashlight/fl/runtime/DeviceManager.h"
+
+namespace fl {
+
+namespace detail {
+
+/**
+ * Set the device with the given native id as the active device.
+ */
+FL_API void setActiveDevice(DeviceType deviceType, int deviceId);
+
+/**
+ * Copy a tensor living on the device with the given native id to the active
+ * device; direct peer copy on CUDA, host staging otherwise.
+ */
+FL_API Tensor copyToActiveDevice(
+    const Tensor& tensor,
+    DeviceType deviceType,
+    int srcDeviceId);
+
+} // namespace detail
+
+/**
+ * An in-process data-parallel execution engine: replicates a module onto
+ * several devices of one process, so multi-device training does not require
+ * one process (with its own device context and dataset cache) per device.
+ *
+ * The given module acts as the primary replica and must live on the first
+ * device; the remaining replicas are clones whose parameters are copied onto
+ * their devices. Tensors move between devices with direct peer copies on CUDA
+ * (host staging elsewhere), so no distributed backend (e.g., NCCL) is
+ * involved. A typical training step:
+ *
+ * \code
+ * DataParallel dp(model, deviceIds);
+ * auto shards = dp.scatter(batch);
+ * dp.forEach([&](unsigned replica, Module& module) {
+ *   criterion(module.forward({Variable(shards[replica], false)})).backward();
+ * });
+ * dp.reduceGradients(); // average into the primary replica
+ * optimizer.step(); // an optimizer over the primary replica's parameters
+ * dp.broadcastParameters();
+ * \endcode
+ */
+class FL_API DataParallel {
+  DeviceType deviceType_;
+  std::vector<int> deviceIds_;
+  // one replica per device id; front() is the primary replica (given module)
+  std::vector<std::shared_ptr<Module>> replicas_;
+
+  // set the device hosting the given replica as the active device
+  void setActiveDevice(unsigned replicaIdx) const;
+
+  // copy a tensor (living on the device with the given native id) to the
+  // active device; peer copy on CUDA, host staging otherwise
+  Tensor copyToActiveDevice(const Tensor& tensor, int srcDeviceId) const;
+
+ public:
+  /**
+   * Replicates the given module onto the given devices.
+   *
+   * @param[in] module the module to replicate; it becomes the primary replica
+   * and its parameters must live on the first device
+   * @param[in] deviceIds native ids of the devices to run replicas on; when
+   * empty, all devices of `deviceType` are used
+   * @param[in] deviceType the type of the devices to run replicas on
+   */
+  explicit DataParallel(
+      std::shared_ptr<Module> module,
+      std::vector<int> deviceIds = {},
+      DeviceType deviceType = kDefaultDeviceType);
+
+  /**
+   * Get the number of replicas (one per device).
+   */
+  unsigned replicaCount() const;
+
+  /**
+   * Get the native device ids the replicas run on.
+   */
+  const std::vector<int>& deviceIds() const;
+
+  /**
+   * Get a replica. Index 0 is the primary replica, i.e., the given module.
+   */
+  std::shared_ptr<Module> replica(unsigned replicaIdx) const;
+
+  /**
+   * Split a batch living on the primary device into one shard per replica
+   * along its last (batch) axis and copy each shard to its replica's device.
+   * The leading shards get one extra element when the batch dimension does not
+   * divide evenly.
+   *
+   * @param[in] batch the batch to split; its last axis must have at least as
+   * many elements as there are replicas
+   * @return one shard per replica, living on that replica's device.
+   */
+  std::vector<Tensor> scatter(const Tensor& batch) const;
+
+  /**
+   * Copy per-replica output shards to the primary device and concatenate them
+   * along their last (batch) axis.
+   *
+   * @param[in] shards one tensor per replica, living on that replica's device
+   * @return the concatenated tensor, living on the primary device.
+   */
+  Tensor gather(const std::vector<Tensor>& shards) const;
+
+  /**
+   * Run the given function once per replica, with that replica's device set
+   * active (and the primary device restored afterwards).
+   *
+   * @param[in] fn invoked with the replica index and the replica
+   */
+  void forEach(const std::function<void(unsigned, Module&)>& fn);
+
+  /**
+   * Average parameter gradients across replicas into the primary replica.
+   * Parameters without a gradient on the primary replica are skipped.
+   */
+  void reduceGradients();
+
+  /**
+   * Copy the primary replica's parameters to all other replicas, e.g., after
+   * an optimizer step over the primary replica.
+   */
+  void broadcastParameters();
+
+  /**
+   * Put all replicas in train mode.
+   */
+  void train();
+
+  /**
+   * Put all replicas in eval mode.
+   */
+  void eval();
+};
+
+} // namespace fl
@@ -9,6 +9,7 @@
 
 #include "flashlight/fl/distributed/DistributedApi.h"
 
+#include <algorithm>
 #include <stdexcept>
 
 namespace fl {
@@ -21,6 +22,95 @@ void distributeModuleGrads(
   }
 }
 
+void distributeModuleGradsBucketed(
+    std::shared_ptr<const Module> module,
+    std::size_t bucketSizeBytes,
+    double scale /* = 1.0 */,
+    bool async /* = true */) {
+  if (!module) {
+    throw std::invalid_argument(
+        "null module passed to distributeModuleGradsBucketed");
+  }
+  if (bucketSizeBytes == 0) {
+    throw std::invalid_argument(
+        "distributeModuleGradsBucketed - bucket size must be positive");
+  }
+
+  struct Bucket {
+    std::vector<Variable> params;
+    std::size_t bytes{0};
+    std::size_t arrived{0};
+  };
+
+  // backward produces gradients in roughly the reverse of params() order, so
+  // packing reversed params keeps each bucket's gradients arriving together
+  auto params = module->params();
+  std::reverse(params.begin(), params.end());
+
+  auto buckets = std::make_shared<std::vector<Bucket>>();
+  for (auto& param : params) {
+    if (buckets->empty() ||
+        buckets->back().bytes + param.bytes() > bucketSizeBytes ||
+        buckets->back().params.back().type() != param.type()) {
+      buckets->emplace_back();
+    }
+    buckets->back().params.push_back(param);
+    buckets->back().bytes += param.bytes();
+  }
+
+  for (std::size_t b = 0; b < buckets->size(); ++b) {
+    // the coalesce buffer bounds how much can be reduced contiguously
+    const bool contiguous =
+        (*buckets)[b].bytes <= DistributedConstants::kCoalesceCacheSize;
+    for (auto& param : (*buckets)[b].params) {
+      param.registerGradHook(
+          [buckets, b, scale, async, contiguous](Variable& /* grad */) {
+            auto& bucket = (*buckets)[b];
+            if (++bucket.arrived < bucket.params.size()) {
+              return;
+            }
+            bucket.arrived = 0;
+            std::vector<Variable> grads;
+            grads.reserve(bucket.params.size());
+            for (auto& p : bucket.params) {
+              grads.push_back(p.grad());
+            }
+            allReduceMultiple(grads, scale, async, contiguous);
+          });
+    }
+  }
+}
+
+void distributeOptimizerStepBucketed(
+    std::shared_ptr<FirstOrderOptimizer> optimizer,
+    std::shared_ptr<CoalescingReducer> reducer,
+    const std::vector<Variable>& parameters) {
+  if (!optimizer || !reducer) {
+    throw std::invalid_argument(
+        "null optimizer or reducer passed to distributeOptimizerStepBucketed");
+  }
+  auto params = std::make_shared<std::vector<Variable>>(parameters);
+  reducer->setFlushCallback(
+      [optimizer, params](const std::vector<Variable>& bucket) {
+        // map each reduced gradient back to its parameter; gradient
+        // Variables are shallow copies, so tensor identity pins down the
+        // parameter it belongs to
+        std::vector<size_t> indices;
+        indices.reserve(bucket.size());
+        for (const auto& grad : bucket) {
+          for (size_t i = 0; i < params->size(); ++i) {
+            const auto& param = (*params)[i];
+            if (param.isGradAvailable() &&
+                &param.grad().tensor() == &grad.tensor()) {
+              indices.push_back(i);
+              break;
+            }
+          }
+        }
+        optimizer->stepParams(indices);
+      });
+}
+
 void allReduceParameters(std::shared_ptr<const Module> module) {
   if (!module) {
     throw std::invalid_argument("null module passed to allReduceParameters");
@@ -12,6 +12,7 @@
 #include "flashlight/fl/common/Defines.h"
 #include "flashlight/fl/distributed/distributed.h"
 #include "flashlight/fl/nn/modules/Module.h"
+#include "flashlight/fl/optim/Optimizers.h"
 
 namespace fl {
 
@@ -33,6 +34,52 @@ FL_API void distributeModuleGrads(
     std::shared_ptr<Reducer> reducer =
         std::make_shared<InlineReducer>(1.0 / getWorldSize()));
 
+/**
+ * Registers a module for bucketed allreduce synchronization overlapping with
+ * the backward pass. Parameters are packed into fixed buckets of at most
+ * ``bucketSizeBytes`` in reverse order of ``Module::params()`` -- the order
+ * in which backward produces gradients -- and each bucket is synchronized
+ * with a single ``allReduceMultiple`` the moment its last gradient lands, so
+ * early buckets' communication overlaps with the remaining backward
+ * computation instead of waiting on a shared cache threshold. Buckets are
+ * split on parameter type changes so each can be reduced contiguously.
+ *
+ * @param[in] module a module whose parameter gradients will be synchronized
+ * @param[in] bucketSizeBytes the maximum size of each bucket, in bytes; a
+ * parameter larger than this gets a bucket of its own
+ * @param[in] scale scale gradients after allreduce by this factor
+ * @param[in] async perform the allreduce asynchronously in the distributed
+ * compute stream. NB: if used, ``syncDistributed`` *must* be called after
+ * backward and before using the gradients.
+ */
+FL_API void distributeModuleGradsBucketed(
+    std::shared_ptr<const Module> module,
+    std::size_t bucketSizeBytes,
+    double scale = 1.0,
+    bool async = true);
+
+/**
+ * Overlaps the optimizer step with gradient synchronization: registers a
+ * flush callback on the reducer that runs the optimizer update for just the
+ * parameters of each bucket as soon as that bucket's reduction is ordered,
+ * so the remaining buckets' communication overlaps the earlier buckets'
+ * updates instead of every update waiting on ``Reducer::finalize``. After
+ * backward and ``reducer->finalize()`` every parameter update has been
+ * issued -- do not also call ``FirstOrderOptimizer::step`` -- and
+ * ``FirstOrderOptimizer::zeroGrad`` is still called each iteration as usual.
+ * Incompatible with gradient accumulation and sharded optimizer state; see
+ * ``FirstOrderOptimizer::stepParams``.
+ *
+ * @param[in] optimizer the optimizer updating `parameters`
+ * @param[in] reducer the reducer synchronizing the parameters' gradients
+ * @param[in] parameters the same parameter Variables held by the optimizer,
+ * e.g. from ``Module::params()``
+ */
+FL_API void distributeOptimizerStepBucketed(
+    std::shared_ptr<FirstOrderOptimizer> optimizer,
+    std::shared_ptr<CoalescingReducer> reducer,
+    const std::vector<Variable>& parameters);
+
 /**
  * Traverses the network and averages its parameters with allreduce.
  *
@@ -0,0 +1,34 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "flashlight/fl/nn/ForwardContext.h"
+
+namespace fl {
+
+std::vector<Variable>& ForwardContext::inputs() {
+  return current_;
+}
+
+const std::vector<Variable>& ForwardContext::outputs() const {
+  return current_;
+}
+
+std::vector<Variable>& ForwardContext::scratch() {
+  return scratch_;
+}
+
+void ForwardContext::advance() {
+  std::swap(current_, scratch_);
+  scratch_.clear(); // keeps capacity
+}
+
+void ForwardContext::reset() {
+  current_.clear();
+  scratch_.clear();
+}
+
+} // namespace fl
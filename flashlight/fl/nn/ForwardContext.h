@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "flashlight/fl/autograd/Variable.h"
+#include "flashlight/fl/common/Defines.h"
+
+namespace fl {
+
+/**
+ * A caller-owned arena for the inter-layer `Variable` vectors of a forward
+ * pass. `Module::forward(const std::vector<Variable>&)` allocates a fresh
+ * output vector at every layer boundary; threading a `ForwardContext` through
+ * `Module::forward(ForwardContext&)` instead ping-pongs between two buffers
+ * whose capacity persists across layers — and, when the context is reused,
+ * across steps — so the forward glue allocates nothing at steady state.
+ *
+ * Usage:
+ *
+ * \code
+ * ForwardContext ctx; // hoisted out of the training loop
+ * for (auto& batch : dataset) {
+ *   ctx.reset();
+ *   ctx.inputs().emplace_back(batch, false);
+ *   model.forward(ctx);
+ *   auto& output = ctx.outputs().front();
+ *   // ...
+ * }
+ * \endcode
+ */
+class FL_API ForwardContext {
+  std::vector<Variable> current_;
+  std::vector<Variable> scratch_;
+
+ public:
+  ForwardContext() = default;
+
+  /**
+   * The buffer the next `Module::forward(ForwardContext&)` call reads its
+   * inputs from. Fill it in place before forwarding.
+   */
+  std::vector<Variable>& inputs();
+
+  /**
+   * The buffer the last `Module::forward(ForwardContext&)` call wrote its
+   * outputs to (the same buffer as `inputs()` — a forward call consumes the
+   * buffer contents and replaces them with its outputs).
+   */
+  const std::vector<Variable>& outputs() const;
+
+  /**
+   * The buffer a module's `forward(ForwardContext&)` implementation writes
+   * its outputs into; call `advance()` afterwards to publish them as the
+   * context's current contents. For use by `Module` implementations.
+   */
+  std::vector<Variable>& scratch();
+
+  /**
+   * Swap `scratch()` into place as the current contents and clear the old
+   * contents (retaining their capacity for the next layer).
+   */
+  void advance();
+
+  /**
+   * Clear both buffers, retaining their capacity for the next step.
+   */
+  void reset();
+};
+
+} // namespace fl
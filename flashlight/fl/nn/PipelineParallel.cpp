@@ -0,0 +1,228 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "flashlight/fl/nn/PipelineParallel.h"
+
+#include <algorithm>
+#include <numeric>
+#include <sstream>
+#include <stdexcept>
+
+#include "flashlight/fl/nn/DataParallel.h"
+#include "flashlight/fl/tensor/Index.h"
+
+namespace fl {
+
+PipelineParallel::PipelineParallel(
+    std::shared_ptr<Sequential> module,
+    std::vector<int> deviceIds /* = {} */,
+    unsigned numMicrobatches /* = 4 */,
+    DeviceType deviceType /* = kDefaultDeviceType */)
+    : deviceType_(deviceType),
+      deviceIds_(std::move(deviceIds)),
+      module_(std::move(module)),
+      numMicrobatches_(numMicrobatches) {
+  if (!module_) {
+    throw std::invalid_argument("[PipelineParallel] null module");
+  }
+  if (numMicrobatches_ == 0) {
+    throw std::invalid_argument(
+        "[PipelineParallel] need at least one microbatch");
+  }
+  auto& manager = DeviceManager::getInstance();
+  if (deviceIds_.empty()) {
+    for (const auto* device : manager.getDevicesOfType(deviceType_)) {
+      deviceIds_.push_back(device->nativeId());
+    }
+    std::sort(deviceIds_.begin(), deviceIds_.end());
+  }
+  if (deviceIds_.empty()) {
+    throw std::invalid_argument("[PipelineParallel] no devices to run on");
+  }
+  // validate ids eagerly -- getDevice throws for unknown ones
+  for (const int id : deviceIds_) {
+    manager.getDevice(deviceType_, id);
+  }
+
+  const auto& children = module_->modules();
+  const auto numStages = static_cast<unsigned>(deviceIds_.size());
+  const auto numChildren = static_cast<unsigned>(children.size());
+  if (numChildren < numStages) {
+    std::ostringstream oss;
+    oss << "[PipelineParallel] cannot split " << numChildren
+        << " modules into " << numStages << " stages";
+    throw std::invalid_argument(oss.str());
+  }
+
+  // partition into contiguous stages, balanced by parameter count; the +1
+  // keeps parameterless modules (activations etc.) from collapsing a stage
+  std::vector<double> weights;
+  for (const auto& child : children) {
+    double weight = 1;
+    for (const auto& param : child->params()) {
+      weight += static_cast<double>(param.elements());
+    }
+    weights.push_back(weight);
+  }
+  const double total = std::accumulate(weights.begin(), weights.end(), 0.0);
+  unsigned begin = 0;
+  double cum = 0;
+  for (unsigned s = 0; s < numStages; s++) {
+    const double target = total * (s + 1) / numStages;
+    const unsigned maxEnd = numChildren - (numStages - 1 - s);
+    unsigned end = begin;
+    while (end < maxEnd && (end == begin || cum < target)) {
+      cum += weights[end++];
+    }
+    stages_.emplace_back(begin, end);
+    begin = end;
+  }
+
+  // move each later stage's parameters onto its device
+  for (unsigned s = 1; s < numStages; s++) {
+    detail::setActiveDevice(deviceType_, deviceIds_[s]);
+    for (unsigned i = stages_[s].first; i < stages_[s].second; i++) {
+      auto& child = *children[i];
+      const auto params = child.params();
+      for (unsigned p = 0; p < params.size(); p++) {
+        child.setParams(
+            Variable(
+                detail::copyToActiveDevice(
+                    params[p].tensor(), deviceType_, deviceIds_.front()),
+                params[p].isCalcGrad()),
+            p);
+      }
+    }
+  }
+  detail::setActiveDevice(deviceType_, deviceIds_.front());
+}
+
+unsigned PipelineParallel::stageCount() const {
+  return static_cast<unsigned>(stages_.size());
+}
+
+const std::vector<int>& PipelineParallel::deviceIds() const {
+  return deviceIds_;
+}
+
+std::pair<unsigned, unsigned> PipelineParallel::stageModules(
+    unsigned stageIdx) const {
+  return stages_.at(stageIdx);
+}
+
+Variable PipelineParallel::transfer(
+    const Variable& input,
+    unsigned srcStage,
+    unsigned dstStage) const {
+  detail::setActiveDevice(deviceType_, deviceIds_[dstStage]);
+  auto moved = detail::copyToActiveDevice(
+      input.tensor(), deviceType_, deviceIds_[srcStage]);
+  const auto deviceType = deviceType_;
+  const int srcId = deviceIds_[srcStage];
+  const int dstId = deviceIds_[dstStage];
+  auto gradFunc = [deviceType, srcId, dstId](
+                      std::vector<Variable>& inputs,
+                      const Variable& gradOutput) {
+    // the graph upstream of this node lives on the source device; make it
+    // active so the remaining backward ops of this microbatch run there
+    detail::setActiveDevice(deviceType, srcId);
+    inputs[0].addGrad(Variable(
+        detail::copyToActiveDevice(gradOutput.tensor(), deviceType, dstId),
+        false));
+  };
+  return Variable(moved, {input}, gradFunc);
+}
+
+void PipelineParallel::runStage(unsigned stageIdx, Variable& microbatch)
+    const {
+  if (stageIdx > 0) {
+    microbatch = transfer(microbatch, stageIdx - 1, stageIdx);
+  } else {
+    detail::setActiveDevice(deviceType_, deviceIds_.front());
+  }
+  for (unsigned i = stages_[stageIdx].first; i < stages_[stageIdx].second;
+       i++) {
+    microbatch = module_->module(i)->forward({microbatch}).front();
+  }
+}
+
+std::vector<Variable> PipelineParallel::forward(const Variable& input) {
+  if (input.isEmpty()) {
+    throw std::invalid_argument(
+        "[PipelineParallel::forward] cannot run an empty input");
+  }
+  const auto batchAxis = input.ndim() - 1;
+  const Dim batchSize = input.dim(batchAxis);
+  const Dim numMicrobatches = numMicrobatches_;
+  if (batchSize < numMicrobatches) {
+    std::ostringstream oss;
+    oss << "[PipelineParallel::forward] batch dimension (" << batchSize
+        << ") is smaller than the number of microbatches (" << numMicrobatches
+        << ")";
+    throw std::invalid_argument(oss.str());
+  }
+  const Dim shardSize = batchSize / numMicrobatches;
+  const Dim remainder = batchSize % numMicrobatches;
+
+  detail::setActiveDevice(deviceType_, deviceIds_.front());
+  std::vector<Variable> microbatches;
+  Dim start = 0;
+  for (Dim m = 0; m < numMicrobatches; m++) {
+    const Dim end = start + shardSize + (m < remainder ? 1 : 0);
+    std::vector<Index> indices(input.ndim(), fl::span);
+    indices[batchAxis] = fl::range(start, end);
+    microbatches.push_back(input(indices));
+    start = end;
+  }
+
+  // GPipe fill-drain: at clock cycle c, stage s handles microbatch c - s.
+  // Later stages are enqueued first within a cycle, so devices with
+  // asynchronous execution work on distinct microbatches concurrently.
+  const auto numStages = static_cast<Dim>(stages_.size());
+  for (Dim cycle = 0; cycle < numMicrobatches + numStages - 1; cycle++) {
+    for (Dim s = std::min(cycle, numStages - 1);
+         s >= 0 && cycle - s < numMicrobatches;
+         s--) {
+      runStage(static_cast<unsigned>(s), microbatches[cycle - s]);
+    }
+  }
+  // leave the last stage's device active -- the outputs live there
+  detail::setActiveDevice(deviceType_, deviceIds_.back());
+  return microbatches;
+}
+
+void PipelineParallel::backward(std::vector<Variable>& losses) {
+  // drain in reverse order, one microbatch subgraph at a time; the stashed
+  // transfer nodes switch the active device at each stage boundary
+  for (auto it = losses.rbegin(); it != losses.rend(); ++it) {
+    detail::setActiveDevice(deviceType_, deviceIds_.back());
+    it->backward();
+  }
+  detail::setActiveDevice(deviceType_, deviceIds_.front());
+}
+
+Tensor PipelineParallel::gather(const std::vector<Variable>& outputs) const {
+  if (outputs.empty()) {
+    throw std::invalid_argument("[PipelineParallel::gather] no outputs");
+  }
+  detail::setActiveDevice(deviceType_, deviceIds_.back());
+  std::vector<Tensor> tensors;
+  for (const auto& output : outputs) {
+    tensors.push_back(output.tensor());
+  }
+  return fl::concatenate(tensors, outputs.front().ndim() - 1);
+}
+
+void PipelineParallel::train() {
+  module_->train();
+}
+
+void PipelineParallel::eval() {
+  module_->eval();
+}
+
+} // namespace fl
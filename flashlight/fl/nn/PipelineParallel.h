@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "flashlight/fl/common/Defines.h"
+#include "flashlight/fl/nn/modules/Container.h"
+#include "flashlight/fl/runtime/DeviceManager.h"
+
+namespace fl {
+
+/**
+ * An in-process pipeline-parallel execution engine for models larger than one
+ * device: partitions a `Sequential`'s modules into contiguous stages, one per
+ * device, balanced by parameter count, and moves each stage's parameters onto
+ * its device. A forward splits the batch into microbatches and runs them with
+ * a GPipe-style fill-drain schedule -- kernel launches for stage `s` of one
+ * microbatch are enqueued before stage `s - 1` of the next, so devices with
+ * asynchronous execution overlap. Activations are stashed by the autograd
+ * graph, and the device-to-device transfers at stage boundaries are
+ * differentiable, so `backward` replays the pipeline in drain order.
+ *
+ * Gradients from all microbatches accumulate into the stage parameters, so
+ * per-microbatch losses should be scaled such that their sum equals the
+ * intended full-batch loss. A typical training step:
+ *
+ * \code
+ * PipelineParallel pipeline(model, deviceIds, microbatches);
+ * auto outputs = pipeline.forward(Variable(batch, false));
+ * std::vector<Variable> losses;
+ * for (auto& output : outputs) {
+ *   losses.push_back(criterion(output));
+ * }
+ * pipeline.backward(losses);
+ * optimizer.step(); // an optimizer over model->params()
+ * \endcode
+ */
+class FL_API PipelineParallel {
+  DeviceType deviceType_;
+  std::vector<int> deviceIds_;
+  std::shared_ptr<Sequential> module_;
+  // [begin, end) child-module range of each stage; one stage per device id
+  std::vector<std::pair<unsigned, unsigned>> stages_;
+  unsigned numMicrobatches_;
+
+  // move an activation from the source stage's device onto the destination
+  // stage's device (left active), with a gradient path copying back
+  Variable transfer(const Variable& input, unsigned srcStage, unsigned dstStage)
+      const;
+
+  // run one stage's modules on a microbatch, transferring it in if needed
+  void runStage(unsigned stageIdx, Variable& microbatch) const;
+
+ public:
+  /**
+   * Partitions the given module across the given devices.
+   *
+   * @param[in] module the module to partition; its parameters must live on
+   * the first device and remain owned by the module (stage parameters on
+   * later devices replace the originals via `setParams`)
+   * @param[in] deviceIds native ids of the devices to run stages on; when
+   * empty, all devices of `deviceType` are used
+   * @param[in] numMicrobatches how many microbatches a batch is split into;
+   * more microbatches shrink the pipeline bubble but each must still fill
+   * the devices
+   * @param[in] deviceType the type of the devices to run stages on
+   */
+  explicit PipelineParallel(
+      std::shared_ptr<Sequential> module,
+      std::vector<int> deviceIds = {},
+      unsigned numMicrobatches = 4,
+      DeviceType deviceType = kDefaultDeviceType);
+
+  /**
+   * Get the number of pipeline stages (one per device).
+   */
+  unsigned stageCount() const;
+
+  /**
+   * Get the native device ids the stages run on.
+   */
+  const std::vector<int>& deviceIds() const;
+
+  /**
+   * Get the [begin, end) range of child modules assigned to a stage.
+   */
+  std::pair<unsigned, unsigned> stageModules(unsigned stageIdx) const;
+
+  /**
+   * Run a batch through the pipeline. The batch, living on the first device,
+   * is split into microbatches along its last (batch) axis -- the leading
+   * microbatches get one extra element when it does not divide evenly.
+   * Returns one output per microbatch, living on the last stage's device,
+   * which is left active so a criterion can be applied directly.
+   */
+  std::vector<Variable> forward(const Variable& input);
+
+  /**
+   * Run backward for the given per-microbatch losses in drain order. Each
+   * microbatch's subgraph switches devices at the stashed stage boundaries;
+   * gradients accumulate into the stage parameters. The first device is left
+   * active afterwards.
+   */
+  void backward(std::vector<Variable>& losses);
+
+  /**
+   * Concatenate per-microbatch outputs (living on the last stage's device)
+   * along their last (batch) axis.
+   */
+  Tensor gather(const std::vector<Variable>& outputs) const;
+
+  /**
+   * Put the partitioned module in train mode.
+   */
+  void train();
+
+  /**
+   * Put the partitioned module in eval mode.
+   */
+  void eval();
+};
+
+} // namespace fl
@@ -19,6 +19,10 @@ Variable Sigmoid::forward(const Variable& input) {
   return sigmoid(input);
 }
 
+Tensor Sigmoid::forwardTensor(const Tensor& input) {
+  return fl::sigmoid(input);
+}
+
 std::unique_ptr<Module> Sigmoid::clone() const {
   return std::make_unique<Sigmoid>(*this);
 }
@@ -33,6 +37,10 @@ Variable Log::forward(const Variable& input) {
   return log(input);
 }
 
+Tensor Log::forwardTensor(const Tensor& input) {
+  return fl::log(input);
+}
+
 std::unique_ptr<Module> Log::clone() const {
   return std::make_unique<Log>(*this);
 }
@@ -47,6 +55,10 @@ Variable Tanh::forward(const Variable& input) {
   return tanh(input);
 }
 
+Tensor Tanh::forwardTensor(const Tensor& input) {
+  return fl::tanh(input);
+}
+
 std::unique_ptr<Module> Tanh::clone() const {
   return std::make_unique<Tanh>(*this);
 }
@@ -61,6 +73,10 @@ Variable HardTanh::forward(const Variable& input) {
   return clamp(input, -1.0, 1.0);
 }
 
+Tensor HardTanh::forwardTensor(const Tensor& input) {
+  return fl::clip(input, -1.0, 1.0);
+}
+
 std::unique_ptr<Module> HardTanh::clone() const {
   return std::make_unique<HardTanh>(*this);
 }
@@ -75,6 +91,10 @@ Variable ReLU::forward(const Variable& input) {
   return max(input, 0.0);
 }
 
+Tensor ReLU::forwardTensor(const Tensor& input) {
+  return fl::maximum(input, 0.0);
+}
+
 std::unique_ptr<Module> ReLU::clone() const {
   return std::make_unique<ReLU>(*this);
 }
@@ -89,6 +109,10 @@ Variable ReLU6::forward(const Variable& input) {
   return clamp(input, 0.0, 6.0);
 }
 
+Tensor ReLU6::forwardTensor(const Tensor& input) {
+  return fl::clip(input, 0.0, 6.0);
+}
+
 std::unique_ptr<Module> ReLU6::clone() const {
   return std::make_unique<ReLU6>(*this);
 }
@@ -103,6 +127,10 @@ Variable LeakyReLU::forward(const Variable& input) {
   return max(input, mSlope_ * input);
 }
 
+Tensor LeakyReLU::forwardTensor(const Tensor& input) {
+  return fl::maximum(input, mSlope_ * input);
+}
+
 std::unique_ptr<Module> LeakyReLU::clone() const {
   return std::make_unique<LeakyReLU>(*this);
 }
@@ -22,6 +22,8 @@ class FL_API Sigmoid : public UnaryModule {
 
   Variable forward(const Variable& input) override;
 
+  Tensor forwardTensor(const Tensor& input) override;
+
   std::unique_ptr<Module> clone() const override;
   std::string prettyString() const override;
 
@@ -39,6 +41,8 @@ class FL_API Log : public UnaryModule {
 
   Variable forward(const Variable& input) override;
 
+  Tensor forwardTensor(const Tensor& input) override;
+
   std::unique_ptr<Module> clone() const override;
   std::string prettyString() const override;
 
@@ -58,6 +62,8 @@ class FL_API Tanh : public UnaryModule {
 
   Variable forward(const Variable& input) override;
 
+  Tensor forwardTensor(const Tensor& input) override;
+
   std::unique_ptr<Module> clone() const override;
   std::string prettyString() const override;
 
@@ -81,6 +87,8 @@ class FL_API HardTanh : public UnaryModule {
 
   Variable forward(const Variable& input) override;
 
+  Tensor forwardTensor(const Tensor& input) override;
+
   std::unique_ptr<Module> clone() const override;
   std::string prettyString() const override;
 
@@ -100,6 +108,8 @@ class FL_API ReLU : public UnaryModule {
 
   Variable forward(const Variable& input) override;
 
+  Tensor forwardTensor(const Tensor& input) override;
+
   std::unique_ptr<Module> clone() const override;
   std::string prettyString() const override;
 
@@ -119,6 +129,8 @@ class FL_API ReLU6 : public UnaryModule {
 
   Variable forward(const Variable& input) override;
 
+  Tensor forwardTensor(const Tensor& input) override;
+
   std::unique_ptr<Module> clone() const override;
   std::string prettyString() const override;
 
@@ -160,6 +172,8 @@ class FL_API LeakyReLU : public UnaryModule {
 
   Variable forward(const Variable& input) override;
 
+  Tensor forwardTensor(const Tensor& input) override;
+
   std::unique_ptr<Module> clone() const override;
   std::string prettyString() const override;
 };
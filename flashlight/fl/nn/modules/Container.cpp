@@ -7,12 +7,74 @@
 
 #include "flashlight/fl/nn/modules/Container.h"
 
+#include <algorithm>
+
 #include "flashlight/fl/autograd/Variable.h"
 
 namespace fl {
 
 Container::Container() = default;
 
+std::vector<Variable> Container::checkpointSegment(
+    const std::vector<ModulePtr>& segment,
+    const std::vector<Variable>& input) {
+  // Forward without building a graph - intermediate activations are freed as
+  // soon as each module returns; only the segment boundary is retained
+  std::vector<Variable> output;
+  {
+    NoGradGuard noGrad;
+    output = input;
+    for (auto& module : segment) {
+      output = module->forward(output);
+    }
+  }
+  if (output.size() != 1) {
+    throw std::invalid_argument(
+        "Container::checkpointSegment - only single-output segments "
+        "can be checkpointed");
+  }
+
+  // Graph inputs of the checkpoint node: the real segment inputs, followed
+  // by the segment parameters so gradient requirements propagate to the node
+  std::vector<Variable> nodeInputs = input;
+  for (auto& module : segment) {
+    for (auto& param : module->params()) {
+      nodeInputs.push_back(param.withoutData());
+    }
+  }
+
+  const size_t numInputs = input.size();
+  auto gradFunc = [segment, numInputs](
+                      std::vector<Variable>& inputs,
+                      const Variable& gradOutput) {
+    // Recompute the segment with graph construction enabled, from fresh
+    // leaves sharing the stored input tensors, and backpropagate through the
+    // recomputed subgraph. Parameter Variables are shared with the modules,
+    // so their gradients accumulate as usual; input gradients are forwarded
+    // from the leaves to the real inputs, where the outer backward pass
+    // picks them up.
+    // Gradient functions run with graph construction disabled; the
+    // recomputation needs a graph for the inner backward, so force it on
+    detail::GradModeGuard gradMode(true);
+    std::vector<Variable> leaves;
+    leaves.reserve(numInputs);
+    for (size_t i = 0; i < numInputs; ++i) {
+      leaves.emplace_back(inputs[i].tensor(), inputs[i].isCalcGrad());
+    }
+    auto recomputed = leaves;
+    for (auto& module : segment) {
+      recomputed = module->forward(recomputed);
+    }
+    recomputed.front().backward(gradOutput);
+    for (size_t i = 0; i < numInputs; ++i) {
+      if (leaves[i].isGradAvailable()) {
+        inputs[i].addGrad(leaves[i].grad());
+      }
+    }
+  };
+  return {Variable(output.front().tensor(), std::move(nodeInputs), gradFunc)};
+}
+
 void Container::clear() {
   childParamIdx_.clear();
   modules_.clear();
@@ -85,6 +147,70 @@ void Container::setParams(const Variable& var, int position) {
   }
 }
 
+namespace {
+
+std::vector<Shape> variableShapes(const std::vector<Variable>& vars) {
+  std::vector<Shape> shapes;
+  shapes.reserve(vars.size());
+  for (const auto& var : vars) {
+    shapes.push_back(var.shape());
+  }
+  return shapes;
+}
+
+std::vector<Variable> dummyInputs(
+    const std::vector<Shape>& shapes,
+    fl::dtype type) {
+  std::vector<Variable> inputs;
+  inputs.reserve(shapes.size());
+  for (const auto& shape : shapes) {
+    inputs.emplace_back(fl::full(shape, 0., type), false);
+  }
+  return inputs;
+}
+
+void describeParams(const Module& module, ModuleGraphNode& node) {
+  for (const auto& param : module.params()) {
+    node.numParams += param.elements();
+    node.paramBytes += param.bytes();
+  }
+}
+
+} // namespace
+
+ModuleGraphNode Container::exportGraph(
+    const std::vector<Shape>& inputShapes,
+    fl::dtype type /* = fl::dtype::f32 */) const {
+  // propagation only needs shapes - keep the dummy forward off the autograd
+  // graph so the intermediate activations are freed as each module returns
+  NoGradGuard noGrad;
+
+  ModuleGraphNode node;
+  node.label = prettyString();
+  describeParams(*this, node);
+  node.inputShapes = inputShapes;
+
+  auto outputs = dummyInputs(inputShapes, type);
+  node.children.reserve(modules_.size());
+  for (const auto& module : modules_) {
+    if (const auto* container = dynamic_cast<const Container*>(module.get())) {
+      node.children.push_back(
+          container->exportGraph(variableShapes(outputs), type));
+      outputs = dummyInputs(node.children.back().outputShapes, type);
+    } else {
+      ModuleGraphNode child;
+      child.label = module->prettyString();
+      describeParams(*module, child);
+      child.inputShapes = variableShapes(outputs);
+      outputs = module->forward(outputs);
+      child.outputShapes = variableShapes(outputs);
+      node.children.push_back(std::move(child));
+    }
+  }
+  node.outputShapes = variableShapes(outputs);
+  return node;
+}
+
 std::string Container::prettyString() const {
   std::ostringstream ss;
   ss << " [input";
@@ -100,7 +226,50 @@ std::string Container::prettyString() const {
 
 Sequential::Sequential() = default;
 
+Sequential::Sequential(const Sequential& other) {
+  train_ = other.train_;
+  checkpointEvery_ = other.checkpointEvery_;
+  for (auto& mod : other.modules_) {
+    add(mod->clone());
+  }
+}
+
+Sequential& Sequential::operator=(const Sequential& other) {
+  train_ = other.train_;
+  checkpointEvery_ = other.checkpointEvery_;
+  clear();
+  for (auto& mod : other.modules_) {
+    add(mod->clone());
+  }
+  return *this;
+}
+
+std::unique_ptr<Module> Sequential::clone() const {
+  return std::make_unique<Sequential>(*this);
+}
+
+void Sequential::setCheckpointing(int everyN) {
+  if (everyN < 0) {
+    throw std::invalid_argument(
+        "Sequential::setCheckpointing - everyN must be non-negative");
+  }
+  checkpointEvery_ = everyN;
+}
+
 std::vector<Variable> Sequential::forward(const std::vector<Variable>& input) {
+  // Checkpointing only pays off when a graph would otherwise be built
+  if (checkpointEvery_ > 0 && train_ && detail::gradMode()) {
+    auto output = input;
+    for (size_t i = 0; i < modules_.size();
+         i += static_cast<size_t>(checkpointEvery_)) {
+      const size_t end =
+          std::min(modules_.size(), i + static_cast<size_t>(checkpointEvery_));
+      const std::vector<ModulePtr> segment(
+          modules_.begin() + i, modules_.begin() + end);
+      output = checkpointSegment(segment, output);
+    }
+    return output;
+  }
   auto output = input;
   for (auto& module : modules_) {
     output = module->forward(output);
@@ -108,11 +277,28 @@ std::vector<Variable> Sequential::forward(const std::vector<Variable>& input) {
   return output;
 }
 
-Variable Sequential::forward(const Variable& input) {
-  std::vector<Variable> output = {input};
+void Sequential::forward(ForwardContext& ctx) {
+  // checkpointed segments rebuild their inputs during backward, so they run
+  // through the allocating path
+  if (checkpointEvery_ > 0 && train_ && detail::gradMode()) {
+    Module::forward(ctx);
+    return;
+  }
   for (auto& module : modules_) {
-    output = module->forward(output);
+    module->forward(ctx);
+  }
+}
+
+Tensor Sequential::forwardTensor(const Tensor& input) {
+  auto output = input;
+  for (auto& module : modules_) {
+    output = module->forwardTensor(output);
   }
+  return output;
+}
+
+Variable Sequential::forward(const Variable& input) {
+  auto output = forward(std::vector<Variable>{input});
   if (output.size() != 1) {
     throw std::invalid_argument("Module output size is not 1");
   }
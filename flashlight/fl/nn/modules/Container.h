@@ -21,6 +21,28 @@ namespace fl {
 
 typedef std::shared_ptr<Module> ModulePtr;
 
+/**
+ * A node of a structured module dataflow graph; see
+ * `Container::exportGraph`. One node describes one module: its label, its
+ * parameter footprint, the input/output shapes propagated through it, and -
+ * for nested containers - one child node per contained module.
+ */
+struct FL_API ModuleGraphNode {
+  /// The module's `prettyString` label; container labels include their
+  /// children's labels
+  std::string label;
+  /// Total number of parameter elements held by the module
+  int64_t numParams{0};
+  /// Total parameter storage in bytes
+  int64_t paramBytes{0};
+  /// Shapes of the inputs fed to the module during propagation
+  std::vector<Shape> inputShapes;
+  /// Shapes of the outputs the module produced
+  std::vector<Shape> outputShapes;
+  /// One child node per contained module, in `modules()` order
+  std::vector<ModuleGraphNode> children;
+};
+
 /**
  * A computation unit capable of forward computation that contains a
  * collection of multiple `Module` and their respective parameters.
@@ -46,6 +68,27 @@ class FL_API Container : public Module {
    */
   virtual void clear();
 
+  /**
+   * Runs `input` through the given segment of modules with activation
+   * checkpointing: the segment executes without building an autograd graph,
+   * so its intermediate activations are freed as soon as forward returns,
+   * and is re-run inside the returned Variable's gradient function to
+   * recompute them during the backward pass. Parameter gradients accumulate
+   * as usual via the recomputation. Only single-output segments can be
+   * checkpointed.
+   *
+   * Note that stochastic modules (e.g. `Dropout`) re-sample during
+   * recomputation.
+   *
+   * @param[in] segment the modules to run, in order
+   * @param[in] input the input to the first module of the segment
+   * @return the segment output, connected to `input` through a single graph
+   * node holding no intermediate activations
+   */
+  static std::vector<Variable> checkpointSegment(
+      const std::vector<ModulePtr>& segment,
+      const std::vector<Variable>& input);
+
   /**
    * Find orphaned params (i.e. params not in modules contained in the modules_
    * list). This can be used to preserve the order of orphaned params when
@@ -160,6 +203,31 @@ class FL_API Container : public Module {
    */
   void setParams(const Variable& var, int position) override;
 
+  /**
+   * Exports a structured dataflow graph of the container: one node per
+   * contained module, with its label, parameter footprint, and the
+   * input/output shapes propagated from the given input spec by forwarding
+   * dummy tensors (no gradient graph is built and parameters are not
+   * modified). This gives memory-planning and capacity tooling the per-layer
+   * activation and parameter sizes without running the real model and
+   * measuring device memory from the outside.
+   *
+   * Shape propagation feeds each module the previous module's outputs in
+   * `modules()` order, as `Sequential` forwards; containers whose forward
+   * wires modules differently still get correct labels and parameter counts
+   * per node, but their propagated shapes reflect sequential application.
+   * Nested containers recurse. Throws whatever a module's forward throws if
+   * the input spec is incompatible with it.
+   *
+   * @param[in] inputShapes the shapes of the container inputs; a dummy f32
+   * tensor of each shape is forwarded
+   * @param[in] type the element type of the dummy inputs
+   * @return the container's graph node, with one child per contained module
+   */
+  virtual ModuleGraphNode exportGraph(
+      const std::vector<Shape>& inputShapes,
+      fl::dtype type = fl::dtype::f32) const;
+
   /**
    * Generates a stringified representation of the module.
    *
@@ -246,10 +314,39 @@ class FL_API Sequential : public Container {
    */
   std::vector<Variable> forward(const std::vector<Variable>& input) override;
 
+  /**
+   * Context-threading overload: forwards the context through each `Module` in
+   * order, reusing the context's buffers at every layer boundary. Falls back
+   * to the allocating path when activation checkpointing is active.
+   */
+  void forward(ForwardContext& ctx) override;
+
+  /**
+   * Tensor fast-path overload: forwards the tensor through each `Module` in
+   * order via `forwardTensor`, so no `Variable` wrappers are built at the
+   * layer boundaries.
+   */
+  Tensor forwardTensor(const Tensor& input) override;
+
   Variable forward(const Variable& input);
 
   Variable operator()(const Variable& input);
 
+  /**
+   * Enables activation checkpointing: during training, modules are forwarded
+   * in segments of `everyN`, and only segment-boundary activations are kept -
+   * activations inside a segment are freed after forward and recomputed
+   * during the backward pass (see `Container::checkpointSegment`). This
+   * trades one extra forward pass through each segment for holding
+   * `1 / everyN` of the intermediate activations, allowing correspondingly
+   * larger batches for deep networks. Has no effect in eval mode or under a
+   * `NoGradGuard`.
+   *
+   * @param[in] everyN segment length in modules; 0 (the default) disables
+   * checkpointing
+   */
+  void setCheckpointing(int everyN);
+
   /**
    * Generates a stringified representation of the `Sequential` by concatenating
    * string representations for each contained `Module`
@@ -258,13 +355,21 @@ class FL_API Sequential : public Container {
    */
   std::string prettyString() const override;
 
-  FL_BASIC_CONTAINER_CLONING(Sequential)
+  Sequential(const Sequential& other);
+  Sequential& operator=(const Sequential& other);
+  Sequential(Sequential&& other) = default;
+  Sequential& operator=(Sequential&& other) = default;
+  std::unique_ptr<Module> clone() const override;
 
  private:
-  FL_SAVE_LOAD_WITH_BASE(Container)
+  // Checkpoint segment length; 0 disables checkpointing
+  int checkpointEvery_{0};
+
+  FL_SAVE_LOAD_WITH_BASE(Container, fl::versioned(checkpointEvery_, 1))
 };
 
 } // namespace fl
 
 CEREAL_REGISTER_TYPE(fl::Container)
 CEREAL_REGISTER_TYPE(fl::Sequential)
+CEREAL_CLASS_VERSION(fl::Sequential, 1)
@@ -22,6 +22,13 @@ Variable Dropout::forward(const Variable& input) {
   }
 }
 
+Tensor Dropout::forwardTensor(const Tensor& input) {
+  if (train_) {
+    return Module::forwardTensor(input);
+  }
+  return input;
+}
+
 std::unique_ptr<Module> Dropout::clone() const {
   return std::make_unique<Dropout>(*this);
 }
@@ -37,6 +37,8 @@ class FL_API Dropout : public UnaryModule {
 
   Variable forward(const Variable& input) override;
 
+  Tensor forwardTensor(const Tensor& input) override;
+
   std::unique_ptr<Module> clone() const override;
 
   std::string prettyString() const override;
@@ -14,18 +14,27 @@
 
 namespace fl {
 
-Embedding::Embedding(int embeddingDim, int numEmbeddings)
-    : embeddingDim_(embeddingDim), numEmbeddings_(numEmbeddings) {
+Embedding::Embedding(
+    int embeddingDim,
+    int numEmbeddings,
+    bool sparseGrad /* = false */)
+    : embeddingDim_(embeddingDim),
+      numEmbeddings_(numEmbeddings),
+      sparseGrad_(sparseGrad) {
   initialize();
 }
 
-Embedding::Embedding(const Variable& w)
-    : UnaryModule({w}), embeddingDim_(w.dim(0)), numEmbeddings_(w.dim(1)) {}
+Embedding::Embedding(const Variable& w, bool sparseGrad /* = false */)
+    : UnaryModule({w}),
+      embeddingDim_(w.dim(0)),
+      numEmbeddings_(w.dim(1)),
+      sparseGrad_(sparseGrad) {}
 
 Embedding::Embedding(const Embedding& other)
     : UnaryModule(other.copyParams()),
       embeddingDim_(other.embeddingDim_),
-      numEmbeddings_(other.numEmbeddings_) {
+      numEmbeddings_(other.numEmbeddings_),
+      sparseGrad_(other.sparseGrad_) {
   train_ = other.train_;
 }
 
@@ -34,6 +43,7 @@ Embedding& Embedding::operator=(const Embedding& other) {
   train_ = other.train_;
   embeddingDim_ = other.embeddingDim_;
   numEmbeddings_ = other.numEmbeddings_;
+  sparseGrad_ = other.sparseGrad_;
   return *this;
 }
 
@@ -45,7 +55,7 @@ void Embedding::initialize() {
 }
 
 Variable Embedding::forward(const Variable& input) {
-  return embedding(input, params_[0]);
+  return embedding(input, params_[0], sparseGrad_);
 }
 
 std::unique_ptr<Module> Embedding::clone() const {
@@ -56,6 +66,9 @@ std::string Embedding::prettyString() const {
   std::ostringstream ss;
   ss << "Embedding (embeddings: " << numEmbeddings_
      << ") (dim: " << embeddingDim_ << ")";
+  if (sparseGrad_) {
+    ss << " (sparseGrad)";
+  }
   return ss.str();
 }
 
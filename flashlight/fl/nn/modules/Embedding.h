@@ -24,8 +24,13 @@ class FL_API Embedding : public UnaryModule {
 
   int embeddingDim_;
   int numEmbeddings_;
+  bool sparseGrad_{false};
 
-  FL_SAVE_LOAD_WITH_BASE(UnaryModule, embeddingDim_, numEmbeddings_)
+  FL_SAVE_LOAD_WITH_BASE(
+      UnaryModule,
+      embeddingDim_,
+      numEmbeddings_,
+      fl::versioned(sparseGrad_, 1))
 
   void initialize();
 
@@ -35,16 +40,22 @@ class FL_API Embedding : public UnaryModule {
    *
    * @param embeddingDim the size of each embedding vector
    * @param numEmbeddings the size of the dictionary of embeddings
+   * @param sparseGrad whether the backward pass accumulates the gradient of
+   *  the embedding table in sparse form, touching only the vectors actually
+   *  looked up - see `fl::embedding`.
    */
-  Embedding(int embeddingDim, int numEmbeddings);
+  Embedding(int embeddingDim, int numEmbeddings, bool sparseGrad = false);
 
   /**
    * Constructs an Embedding module from the weight parameter \f$w\f$.
    *
    * @param w the 2D `Variable` tensor for the weight \f$w\f$.
    *  The shape should be [`embeddingDim`, `numEmbeddings`].
+   * @param sparseGrad whether the backward pass accumulates the gradient of
+   *  the embedding table in sparse form, touching only the vectors actually
+   *  looked up - see `fl::embedding`.
    */
-  explicit Embedding(const Variable& w);
+  explicit Embedding(const Variable& w, bool sparseGrad = false);
 
   /**
    * Constructs an Embedding module from another, performing a copy of the
@@ -76,3 +87,4 @@ class FL_API Embedding : public UnaryModule {
 } // namespace fl
 
 CEREAL_REGISTER_TYPE(fl::Embedding)
+CEREAL_CLASS_VERSION(fl::Embedding, 1)
@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "flashlight/fl/nn/modules/HostEmbedding.h"
+
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <stdexcept>
+
+#include "flashlight/fl/runtime/PinnedMemoryPool.h"
+#include "flashlight/fl/tensor/Index.h"
+
+namespace fl {
+
+HostEmbedding::HostEmbedding(int embeddingDim, int numEmbeddings)
+    : embeddingDim_(embeddingDim), numEmbeddings_(numEmbeddings) {
+  if (embeddingDim_ <= 0 || numEmbeddings_ <= 0) {
+    throw std::invalid_argument(
+        "HostEmbedding - embeddingDim and numEmbeddings must be positive");
+  }
+  initialize();
+}
+
+HostEmbedding::HostEmbedding(const Variable& w)
+    : embeddingDim_(w.dim(0)), numEmbeddings_(w.dim(1)) {
+  table_ = w.tensor().astype(fl::dtype::f32).toHostVector<float>();
+}
+
+HostEmbedding::HostEmbedding(const HostEmbedding& other)
+    : embeddingDim_(other.embeddingDim_),
+      numEmbeddings_(other.numEmbeddings_),
+      table_(other.table_),
+      rowGradients_(other.rowGradients_) {
+  train_ = other.train_;
+}
+
+HostEmbedding& HostEmbedding::operator=(const HostEmbedding& other) {
+  embeddingDim_ = other.embeddingDim_;
+  numEmbeddings_ = other.numEmbeddings_;
+  table_ = other.table_;
+  rowGradients_ = other.rowGradients_;
+  train_ = other.train_;
+  return *this;
+}
+
+void HostEmbedding::initialize() {
+  // same distribution as Embedding, drawn on the host - routing the init
+  // through the device would allocate the full table there, which is the
+  // very thing this module avoids
+  double stdv = std::sqrt(1.0 / (double)embeddingDim_);
+  std::mt19937 rng;
+  std::uniform_real_distribution<float> dist(-stdv, stdv);
+  table_.resize(
+      static_cast<size_t>(embeddingDim_) * numEmbeddings_);
+  for (auto& value : table_) {
+    value = dist(rng);
+  }
+}
+
+Variable HostEmbedding::forward(const Variable& input) {
+  if (input.ndim() > 3) {
+    throw std::invalid_argument(
+        "HostEmbedding::forward - input must have at most three dimensions");
+  }
+  auto indices =
+      input.tensor().astype(fl::dtype::s32).toHostVector<int>();
+
+  // Deduplicate: batches repeat hot vocabulary, so each distinct row is
+  // staged and uploaded once, and the expansion to batch order happens on
+  // the device
+  std::unordered_map<int, int> slotOf;
+  std::vector<int> rows; // distinct table rows, in first-appearance order
+  std::vector<int> slots(indices.size());
+  for (size_t i = 0; i < indices.size(); ++i) {
+    const int idx = indices[i];
+    if (idx < 0 || idx >= numEmbeddings_) {
+      throw std::invalid_argument(
+          "HostEmbedding::forward - index " + std::to_string(idx) +
+          " out of range");
+    }
+    auto res = slotOf.emplace(idx, static_cast<int>(rows.size()));
+    if (res.second) {
+      rows.push_back(idx);
+    }
+    slots[i] = res.first->second;
+  }
+
+  // gather the distinct rows into pinned staging; the upload from pinned
+  // memory is asynchronous and overlaps preceding device work
+  const size_t rowBytes = static_cast<size_t>(embeddingDim_) * sizeof(float);
+  auto staging =
+      PinnedMemoryPool::getInstance().acquire(rows.size() * rowBytes);
+  auto* dst = static_cast<float*>(staging.data());
+  for (size_t s = 0; s < rows.size(); ++s) {
+    std::memcpy(
+        dst + s * embeddingDim_,
+        table_.data() + static_cast<size_t>(rows[s]) * embeddingDim_,
+        rowBytes);
+  }
+  auto deviceRows = Tensor::fromBuffer(
+      {embeddingDim_, static_cast<Dim>(rows.size())},
+      static_cast<const float*>(staging.data()),
+      Location::Host);
+
+  auto slotsTensor =
+      Tensor::fromVector({static_cast<Dim>(slots.size())}, slots);
+  auto result = deviceRows(fl::span, slotsTensor);
+  std::vector<Dim> outDims = {embeddingDim_};
+  for (int d = 0; d < input.ndim(); ++d) {
+    outDims.push_back(input.dim(d));
+  }
+  result = fl::reshape(result, Shape(outDims));
+
+  if (!train_) {
+    return Variable(result, false);
+  }
+  auto gradFunc = [this, rows = std::move(rows), slots = std::move(slots)](
+                      std::vector<Variable>& /* inputs */,
+                      const Variable& gradOutput) {
+    // scatter-add into the sparse host accumulator, one transfer per batch
+    auto grad = fl::reshape(
+                    gradOutput.tensor(),
+                    {embeddingDim_, static_cast<Dim>(slots.size())})
+                    .toHostVector<float>();
+    for (size_t i = 0; i < slots.size(); ++i) {
+      auto& acc = rowGradients_[rows[slots[i]]];
+      if (acc.empty()) {
+        acc.assign(embeddingDim_, 0.0f);
+      }
+      const float* g = grad.data() + i * embeddingDim_;
+      for (int j = 0; j < embeddingDim_; ++j) {
+        acc[j] += g[j];
+      }
+    }
+  };
+  // the grad-enabled handle gets the gradFunc recorded; the indices carry no
+  // gradient of their own
+  return Variable(result, {gradHandle_, input.withoutData()}, gradFunc);
+}
+
+void HostEmbedding::applyGradients(double learningRate) {
+  for (const auto& rowGrad : rowGradients_) {
+    float* row =
+        table_.data() + static_cast<size_t>(rowGrad.first) * embeddingDim_;
+    for (int j = 0; j < embeddingDim_; ++j) {
+      row[j] -= learningRate * rowGrad.second[j];
+    }
+  }
+  rowGradients_.clear();
+}
+
+size_t HostEmbedding::pendingGradientRows() const {
+  return rowGradients_.size();
+}
+
+std::unique_ptr<Module> HostEmbedding::clone() const {
+  return std::make_unique<HostEmbedding>(*this);
+}
+
+std::string HostEmbedding::prettyString() const {
+  std::ostringstream ss;
+  ss << "HostEmbedding (embeddings: " << numEmbeddings_
+     << ") (dim: " << embeddingDim_ << ") (host resident)";
+  return ss.str();
+}
+
+} // namespace fl
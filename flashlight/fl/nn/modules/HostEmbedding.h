@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <unordered_map>
+#include <vector>
+
+#include "flashlight/fl/nn/modules/Module.h"
+
+namespace fl {
+
+/**
+ * An embedding table resident in host memory, for dictionaries too large to
+ * keep on the device alongside the rest of the model and its optimizer state.
+ *
+ * The table never lives on the device. `forward` uploads only the rows the
+ * batch references: the distinct indices are gathered into a pinned staging
+ * buffer and transferred once - batches repeat hot vocabulary, so the upload
+ * is typically far smaller than the raw index count - then expanded to the
+ * batch layout on the device. The transfer runs asynchronously from pinned
+ * memory and overlaps preceding device work.
+ *
+ * Gradients flow back to the host: the backward pass scatter-adds the output
+ * gradient into a sparse per-row accumulator, touching only the rows looked
+ * up. The table is not exposed through `params()`, so device optimizers never
+ * see it; updates are applied with `applyGradients`, a plain SGD step over
+ * the touched rows:
+ *
+ * \code
+ * HostEmbedding embedding(512, 2000000);
+ * auto output = embedding.forward(indices);
+ * // ... loss.backward() ...
+ * embedding.applyGradients(learningRate);
+ * \endcode
+ */
+class FL_API HostEmbedding : public UnaryModule {
+ private:
+  HostEmbedding() = default; // Intentionally private
+
+  int embeddingDim_{0};
+  int numEmbeddings_{0};
+  /// Row-contiguous table: row `i` is `table_[i * embeddingDim_]` onwards
+  /// (column `i` of the logical [embeddingDim, numEmbeddings] weight)
+  std::vector<float> table_;
+  /// Sparse host gradient accumulator, row index -> summed gradient
+  std::unordered_map<int, std::vector<float>> rowGradients_;
+  /// Grad-enabled leaf threaded through forward outputs so the backward pass
+  /// reaches the scatter gradFunc; the table itself is not a Variable
+  Variable gradHandle_ = Variable(Tensor(), true);
+
+  FL_SAVE_LOAD_WITH_BASE(UnaryModule, embeddingDim_, numEmbeddings_, table_)
+
+  void initialize();
+
+ public:
+  /**
+   * Constructs a HostEmbedding module with uniformly-initialized weights.
+   *
+   * @param embeddingDim the size of each embedding vector
+   * @param numEmbeddings the size of the dictionary of embeddings
+   */
+  HostEmbedding(int embeddingDim, int numEmbeddings);
+
+  /**
+   * Constructs a HostEmbedding module from the weight \f$w\f$, copying it to
+   * the host.
+   *
+   * @param w the 2D weight tensor, of shape [`embeddingDim`,
+   * `numEmbeddings`].
+   */
+  explicit HostEmbedding(const Variable& w);
+
+  HostEmbedding(const HostEmbedding& other);
+
+  HostEmbedding& operator=(const HostEmbedding& other);
+
+  HostEmbedding(HostEmbedding&& other) = default;
+
+  HostEmbedding& operator=(HostEmbedding&& other) = default;
+
+  Variable forward(const Variable& input) override;
+
+  /**
+   * Applies the accumulated row gradients to the host table as a plain SGD
+   * step - `row -= learningRate * gradient` for each touched row - and
+   * clears the accumulator.
+   */
+  void applyGradients(double learningRate);
+
+  /**
+   * Returns the number of table rows with accumulated gradient pending.
+   */
+  size_t pendingGradientRows() const;
+
+  std::unique_ptr<Module> clone() const override;
+
+  std::string prettyString() const override;
+};
+
+} // namespace fl
+
+CEREAL_REGISTER_TYPE(fl::HostEmbedding)
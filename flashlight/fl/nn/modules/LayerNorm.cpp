@@ -22,15 +22,18 @@ LayerNorm::LayerNorm(
     int axis,
     double eps /*  = 1e-5*/,
     bool affine /*  = true*/,
-    int axisSize /* = kLnVariableAxisSize */)
-    : LayerNorm(std::vector<int>({axis}), eps, affine, axisSize) {}
+    int axisSize /* = kLnVariableAxisSize */,
+    Epilogue epilogue /* = Epilogue::BIAS */)
+    : LayerNorm(std::vector<int>({axis}), eps, affine, axisSize, epilogue) {}
 
 LayerNorm::LayerNorm(
     const std::vector<int>& axis,
     double eps /* = 1e-5 */,
     bool affine /* = true */,
-    int axisSize /* = kLnVariableAxisSize */)
-    : epsilon_(eps), affine_(affine), axisSize_(axisSize) {
+    int axisSize /* = kLnVariableAxisSize */,
+    Epilogue epilogue /* = Epilogue::BIAS */)
+    : epsilon_(eps), affine_(affine), axisSize_(axisSize),
+      epilogue_(epilogue) {
   for (int d = 0; d < kLnExpectedNumDims; ++d) {
     if (std::find(axis.begin(), axis.end(), d) == axis.end()) {
       axisComplement_.push_back(d);
@@ -56,8 +59,6 @@ Variable LayerNorm::forward(const Variable& _input) {
         std::to_string(kLnExpectedNumDims) + " or fewer dimensions.");
   }
 
-  Variable dummyInMean, dummyInVar;
-
   Variable inputToBn = input;
   std::vector<int> inNormAxes;
   // reorder is only required if axisComplement_ is not continuous
@@ -83,18 +84,29 @@ Variable LayerNorm::forward(const Variable& _input) {
     }
     inputToBn = reorder(input, reorderDims);
   }
-  auto paramsType =
-      (input.type() == fl::dtype::f16) ? fl::dtype::f32 : input.type();
-  auto output = batchnorm(
-      inputToBn,
-      Variable(Tensor(paramsType), false),
-      Variable(Tensor(paramsType), false),
-      dummyInMean,
-      dummyInVar,
-      inNormAxes,
-      true,
-      0.0,
-      epsilon_);
+  // The affine parameters broadcast over the normalized axes - singleton on
+  // the feature axes, which in the (possibly reordered) input to the norm are
+  // the positions in inNormAxes
+  Variable weight, bias;
+  if (affine_) {
+    weight = params_[0];
+    bias = params_[1];
+    if (axisSize_ != kLnVariableAxisSize) {
+      Shape affineDims = inputToBn.shape();
+      for (int ax : inNormAxes) {
+        affineDims[ax] = 1;
+      }
+      if (affineDims.elements() != axisSize_) {
+        throw std::invalid_argument(
+            "[LayerNorm] Input size along the norm axis doesn't with axisSize.");
+      }
+      weight = moddims(params_[0], affineDims);
+      bias = moddims(params_[1], affineDims);
+    }
+  }
+
+  auto output =
+      layerNorm(inputToBn, weight, bias, inNormAxes, epsilon_, epilogue_);
 
   if (!axesContinuous) {
     std::vector<std::pair<int, int>> restoreDims;
@@ -109,27 +121,204 @@ Variable LayerNorm::forward(const Variable& _input) {
     output = reorder(output, restoreDimsShape);
   }
 
+  return moddims(output, _input.shape());
+}
+
+Variable LayerNorm::forwardAdd(
+    const Variable& _residual,
+    const Variable& _input,
+    double pDropout /* = 0.0 */) {
+  // Activation epilogues aren't supported by the fused add ops; compose
+  if (epilogue_ != Epilogue::NONE && epilogue_ != Epilogue::BIAS) {
+    return forward(
+        _residual + dropout(_input, pDropout).astype(_residual.type()));
+  }
+  if (_residual.shape() != _input.shape()) {
+    throw std::invalid_argument(
+        "LayerNorm::forwardAdd - residual and input must have the same shape");
+  }
+
+  // Shape plumbing mirrors `forward` above, applied to both operands
+  Variable residual = _residual;
+  Variable input = _input;
+  if (input.ndim() < kLnExpectedNumDims) {
+    std::vector<Dim> s = _input.shape().get();
+    for (unsigned i = s.size(); i < kLnExpectedNumDims; ++i) {
+      s.push_back(1);
+    }
+    residual = moddims(_residual, Shape(s));
+    input = moddims(_input, Shape(s));
+  } else if (input.ndim() > kLnExpectedNumDims) {
+    throw std::invalid_argument(
+        "LayerNorm::forwardAdd - input must be " +
+        std::to_string(kLnExpectedNumDims) + " or fewer dimensions.");
+  }
+
+  Variable residualToBn = residual;
+  Variable inputToBn = input;
+  std::vector<int> inNormAxes;
+  // reorder is only required if axisComplement_ is not continuous
+  Shape reorderDims(std::vector<Dim>(input.ndim()));
+  auto maxAxis =
+      *std::max_element(axisComplement_.begin(), axisComplement_.end());
+  auto minAxis =
+      *std::min_element(axisComplement_.begin(), axisComplement_.end());
+  bool axesContinuous = (axisComplement_.size() == (maxAxis - minAxis + 1));
+  if (axesContinuous) {
+    inNormAxes = axisComplement_;
+  } else {
+    int i = 0;
+    for (int d = 0; d < input.ndim(); ++d) {
+      if (std::find(axisComplement_.begin(), axisComplement_.end(), d) ==
+          axisComplement_.end()) {
+        reorderDims[i++] = d;
+      }
+    }
+    for (auto n : axisComplement_) {
+      inNormAxes.push_back(i);
+      reorderDims[i++] = n;
+    }
+    residualToBn = reorder(residual, reorderDims);
+    inputToBn = reorder(input, reorderDims);
+  }
+  Variable weight, bias;
   if (affine_) {
-    Variable weight = params_[0].astype(output.type());
-    Variable bias = params_[1].astype(output.type());
+    weight = params_[0];
+    bias = params_[1];
     if (axisSize_ != kLnVariableAxisSize) {
-      Shape affineDims = input.shape();
-      for (int ax : axisComplement_) {
+      Shape affineDims = inputToBn.shape();
+      for (int ax : inNormAxes) {
         affineDims[ax] = 1;
       }
       if (affineDims.elements() != axisSize_) {
         throw std::invalid_argument(
             "[LayerNorm] Input size along the norm axis doesn't with axisSize.");
       }
-      weight = moddims(params_[0].astype(output.type()), affineDims);
-      bias = moddims(params_[1].astype(output.type()), affineDims);
+      weight = moddims(params_[0], affineDims);
+      bias = moddims(params_[1], affineDims);
     }
-    output = tileAs(weight, input) * output + tileAs(bias, input);
+  }
+
+  auto output = (pDropout > 0.0)
+      ? addDropoutNorm(
+            residualToBn,
+            inputToBn,
+            pDropout,
+            weight,
+            bias,
+            inNormAxes,
+            epsilon_)
+      : addNorm(residualToBn, inputToBn, weight, bias, inNormAxes, epsilon_);
+
+  if (!axesContinuous) {
+    std::vector<std::pair<int, int>> restoreDims;
+    for (size_t i = 0; i < reorderDims.ndim(); ++i) {
+      restoreDims.emplace_back(reorderDims[i], i);
+    }
+    std::sort(restoreDims.begin(), restoreDims.end());
+    Shape restoreDimsShape(std::vector<Dim>(restoreDims.size()));
+    for (size_t i = 0; i < restoreDims.size(); ++i) {
+      restoreDimsShape[i] = restoreDims[i].second;
+    }
+    output = reorder(output, restoreDimsShape);
   }
 
   return moddims(output, _input.shape());
 }
 
+Tensor LayerNorm::forwardTensor(const Tensor& _input) {
+  // Activation epilogues are fused inside the autograd layerNorm op; leave
+  // them to the Variable fallback rather than duplicating that handling here
+  if (epilogue_ != Epilogue::NONE && epilogue_ != Epilogue::BIAS) {
+    return Module::forwardTensor(_input);
+  }
+
+  Tensor input = _input;
+  if (input.ndim() < kLnExpectedNumDims) {
+    std::vector<Dim> s = _input.shape().get();
+    for (unsigned i = s.size(); i < kLnExpectedNumDims; ++i) {
+      s.push_back(1);
+    }
+    input = fl::reshape(_input, Shape(s));
+  } else if (input.ndim() > kLnExpectedNumDims) {
+    throw std::invalid_argument(
+        "LayerNorm::forwardTensor - input must be " +
+        std::to_string(kLnExpectedNumDims) + " or fewer dimensions.");
+  }
+
+  Tensor inputToBn = input;
+  std::vector<int> inNormAxes;
+  // reorder is only required if axisComplement_ is not continuous
+  Shape reorderDims(std::vector<Dim>(input.ndim()));
+  auto maxAxis =
+      *std::max_element(axisComplement_.begin(), axisComplement_.end());
+  auto minAxis =
+      *std::min_element(axisComplement_.begin(), axisComplement_.end());
+  bool axesContinuous = (axisComplement_.size() == (maxAxis - minAxis + 1));
+  if (axesContinuous) {
+    inNormAxes = axisComplement_;
+  } else {
+    int i = 0;
+    for (int d = 0; d < input.ndim(); ++d) {
+      if (std::find(axisComplement_.begin(), axisComplement_.end(), d) ==
+          axisComplement_.end()) {
+        reorderDims[i++] = d;
+      }
+    }
+    for (auto n : axisComplement_) {
+      inNormAxes.push_back(i);
+      reorderDims[i++] = n;
+    }
+    inputToBn = fl::transpose(input, reorderDims);
+  }
+
+  // Normalization statistics always accumulate in f32
+  auto output = (inputToBn.type() == fl::dtype::f16)
+      ? inputToBn.astype(fl::dtype::f32)
+      : inputToBn;
+  auto mean = fl::mean(output, inNormAxes, /* keepDims = */ true);
+  auto var =
+      fl::var(output, inNormAxes, /* bias = */ true, /* keepDims = */ true);
+  output = (output - detail::tileAs(mean, output.shape())) /
+      detail::tileAs(fl::sqrt(var + epsilon_), output.shape());
+
+  if (affine_) {
+    auto weight = params_[0].tensor().astype(output.type());
+    auto bias = params_[1].tensor().astype(output.type());
+    if (axisSize_ != kLnVariableAxisSize) {
+      Shape affineDims = inputToBn.shape();
+      for (int ax : inNormAxes) {
+        affineDims[ax] = 1;
+      }
+      if (affineDims.elements() != axisSize_) {
+        throw std::invalid_argument(
+            "[LayerNorm] Input size along the norm axis doesn't with axisSize.");
+      }
+      weight = fl::reshape(weight, affineDims);
+      bias = fl::reshape(bias, affineDims);
+    }
+    // a single fused elementwise pass over the normalized activations
+    output = detail::tileAs(weight, output.shape()) * output +
+        detail::tileAs(bias, output.shape());
+  }
+  output = output.astype(inputToBn.type());
+
+  if (!axesContinuous) {
+    std::vector<std::pair<int, int>> restoreDims;
+    for (size_t i = 0; i < reorderDims.ndim(); ++i) {
+      restoreDims.emplace_back(reorderDims[i], i);
+    }
+    std::sort(restoreDims.begin(), restoreDims.end());
+    Shape restoreDimsShape(std::vector<Dim>(restoreDims.size()));
+    for (size_t i = 0; i < restoreDims.size(); ++i) {
+      restoreDimsShape[i] = restoreDims[i].second;
+    }
+    output = fl::transpose(output, restoreDimsShape);
+  }
+
+  return fl::reshape(output, _input.shape());
+}
+
 void LayerNorm::initialize() {
   if (affine_) {
     auto paramDim = (axisSize_ == kLnVariableAxisSize) ? 1 : axisSize_;
@@ -153,7 +342,15 @@ std::string LayerNorm::prettyString() const {
       ss << d << " ";
     }
   }
-  ss << "} , size : " << axisSize_ << ")";
+  ss << "} , size : " << axisSize_;
+  if (epilogue_ == Epilogue::BIAS_RELU) {
+    ss << " , epilogue : relu";
+  } else if (epilogue_ == Epilogue::BIAS_GELU) {
+    ss << " , epilogue : gelu";
+  } else if (epilogue_ == Epilogue::BIAS_SWISH) {
+    ss << " , epilogue : swish";
+  }
+  ss << ")";
   return ss.str();
 }
 
@@ -41,12 +41,16 @@ class FL_API LayerNorm : public UnaryModule {
    *  elementwise affine transform. If the feat size is variable, use
    *  `kLnVariableAxisSize` which uses singleton weight, bias and tiles them
    *  dynamically according to the given input.
+   * @param epilogue activation fused into the normalization output - see
+   *  `fl::layerNorm`. Saves a separate activation op when the module is
+   *  always followed by the same activation.
    */
   explicit LayerNorm(
       int axis,
       double eps = 1e-5,
       bool affine = true,
-      int axisSize = kLnVariableAxisSize);
+      int axisSize = kLnVariableAxisSize,
+      Epilogue epilogue = Epilogue::BIAS);
 
   /**
    * Constructs a LayerNorm module.
@@ -62,15 +66,39 @@ class FL_API LayerNorm : public UnaryModule {
    *  elementwise affine transform. If the feat size is variable, use
    *  `kLnVariableAxisSize` which uses singleton weight, bias and tiles them
    *  dynamically according to the given input.
+   * @param epilogue activation fused into the normalization output - see
+   *  `fl::layerNorm`. Saves a separate activation op when the module is
+   *  always followed by the same activation.
    */
   explicit LayerNorm(
       const std::vector<int>& axis,
       double eps = 1e-5,
       bool affine = true,
-      int axisSize = kLnVariableAxisSize);
+      int axisSize = kLnVariableAxisSize,
+      Epilogue epilogue = Epilogue::BIAS);
 
   Variable forward(const Variable& input) override;
 
+  /**
+   * Fused residual variant: computes `forward(residual + dropout(input,
+   * pDropout))` through the single-pass `fl::addNorm` / `fl::addDropoutNorm`
+   * ops, so the residual add (and dropout mask) do not each cost a full
+   * extra pass over the activations. `input` is cast to `residual`'s type
+   * before the add. Falls back to composing the ops when an activation
+   * epilogue is configured.
+   *
+   * @param residual the residual branch
+   * @param input the sublayer branch, with the same shape as `residual`
+   * @param pDropout dropout probability applied to `input` before the add;
+   *  pass the effective (train-gated) probability
+   */
+  Variable forwardAdd(
+      const Variable& residual,
+      const Variable& input,
+      double pDropout = 0.0);
+
+  Tensor forwardTensor(const Tensor& input) override;
+
   std::unique_ptr<Module> clone() const override;
 
   std::string prettyString() const override;
@@ -84,13 +112,15 @@ class FL_API LayerNorm : public UnaryModule {
   double epsilon_;
   bool affine_;
   int axisSize_{kLnVariableAxisSize};
+  Epilogue epilogue_{Epilogue::BIAS};
 
   FL_SAVE_LOAD_WITH_BASE(
       UnaryModule,
       axisComplement_,
       epsilon_,
       affine_,
-      fl::versioned(axisSize_, 1))
+      fl::versioned(axisSize_, 1),
+      fl::versioned(epilogue_, 2))
 
   void initialize();
 };
@@ -98,4 +128,4 @@ class FL_API LayerNorm : public UnaryModule {
 } // namespace fl
 
 CEREAL_REGISTER_TYPE(fl::LayerNorm)
-CEREAL_CLASS_VERSION(fl::LayerNorm, 1)
+CEREAL_CLASS_VERSION(fl::LayerNorm, 2)
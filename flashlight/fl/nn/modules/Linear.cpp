@@ -59,6 +59,30 @@ Variable Linear::forward(const Variable& input) {
   return linear(input, params_[0].astype(input.type()));
 }
 
+Tensor Linear::forwardTensor(const Tensor& input) {
+  auto weight = params_[0].tensor();
+  if (weight.type() != input.type()) {
+    weight = weight.astype(input.type());
+  }
+
+  Shape to2d({input.dim(0), input.elements() / input.dim(0)});
+  auto to4d = input.shape();
+  to4d[0] = weight.dim(0);
+
+  auto output = fl::reshape(fl::matmul(weight, fl::reshape(input, to2d)), to4d);
+
+  if (bias_) {
+    auto bias = params_[1].tensor();
+    if (bias.type() != output.type()) {
+      bias = bias.astype(output.type());
+    }
+    auto tiledims = output.shape();
+    tiledims[0] = 1;
+    output = output + fl::tile(bias, tiledims);
+  }
+  return output;
+}
+
 void Linear::initialize() {
   int fanIn = nIn_;
   auto w = Variable(
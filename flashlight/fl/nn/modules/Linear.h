@@ -74,6 +74,8 @@ class FL_API Linear : public UnaryModule {
 
   Variable forward(const Variable& input) override;
 
+  Tensor forwardTensor(const Tensor& input) override;
+
   std::unique_ptr<Module> clone() const override;
 
   std::string prettyString() const override;
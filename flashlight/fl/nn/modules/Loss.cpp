@@ -128,6 +128,50 @@ Variable AdaptiveSoftMaxLoss::cast(
   return Variable(output, {input.withoutData()}, gradFunc);
 }
 
+AdaptiveSoftMaxLoss::ClusterPartition AdaptiveSoftMaxLoss::partitionTargets(
+    const Tensor& target,
+    const std::vector<int>& cutoff) const {
+  const auto targetHost = target.astype(fl::dtype::s32).toHostVector<int>();
+  const int numClusters = cutoff.size() - 1;
+  std::vector<int> headTarget(targetHost.size(), 0);
+  std::vector<std::vector<int>> positions(numClusters);
+  std::vector<std::vector<int>> inClusterTarget(numClusters);
+  for (size_t j = 0; j < targetHost.size(); ++j) {
+    const int t = targetHost[j];
+    if (t < cutoff[0]) {
+      // shortlist target (or an ignore index, which is below the shortlist)
+      headTarget[j] = t;
+      continue;
+    }
+    for (int i = 0; i < numClusters; ++i) {
+      if (t >= cutoff[i] && t < cutoff[i + 1]) {
+        headTarget[j] = cutoff[0] + i;
+        positions[i].push_back(j);
+        inClusterTarget[i].push_back(t - cutoff[i]);
+        break;
+      }
+    }
+  }
+
+  ClusterPartition part;
+  part.headTarget = Tensor::fromVector(target.shape(), headTarget);
+  part.tailCounts.resize(numClusters);
+  std::vector<int> tailPositions;
+  std::vector<int> tailTarget;
+  for (int i = 0; i < numClusters; ++i) {
+    part.tailCounts[i] = positions[i].size();
+    tailPositions.insert(
+        tailPositions.end(), positions[i].begin(), positions[i].end());
+    tailTarget.insert(
+        tailTarget.end(), inClusterTarget[i].begin(), inClusterTarget[i].end());
+  }
+  if (!tailPositions.empty()) {
+    part.tailPositions = Tensor::fromVector(tailPositions);
+    part.tailTarget = Tensor::fromVector(tailTarget);
+  }
+  return part;
+}
+
 Variable AdaptiveSoftMaxLoss::forward(
     const Variable& inputs,
     const Variable& targets) {
@@ -158,34 +202,46 @@ Variable AdaptiveSoftMaxLoss::forward(
   auto target = moddims(targets, {T * B});
 
   auto headOutput = matmul(params_[0], input);
-  auto headTarget = Variable(target.tensor(), false) * (target < cutoff[0]);
+  // Assign every target to its cluster once, in a single host pass, rather
+  // than recomputing device-side assignment masks per cluster
+  auto partition = partitionTargets(target.tensor(), cutoff);
   // TODO: check the type of res
   auto res = Variable(fl::full({T * B}, 0, fl::dtype::f32), true);
 
-  // Tail forwawrd
-  for (int i = 0; i < cutoff.size() - 1; i++) {
-    auto mask = (target >= cutoff[i]) && (target < cutoff[i + 1]);
-    if (!fl::any(mask.tensor()).scalar<char>()) {
-      continue;
+  // Tail forward: one gather of every tail position, per-cluster low-rank
+  // projections over contiguous views of the gathered input (the positions
+  // are grouped by cluster), and one scatter of the local losses back
+  if (!partition.tailPositions.isEmpty()) {
+    auto selectedInput =
+        embedding(Variable(partition.tailPositions, false), input);
+    auto tailTarget = Variable(partition.tailTarget, false);
+    std::vector<Variable> localLoss;
+    int offset = 0;
+    for (int i = 0; i < partition.tailCounts.size(); i++) {
+      const int count = partition.tailCounts[i];
+      if (count == 0) {
+        continue;
+      }
+      auto clusterInput =
+          selectedInput(fl::span, fl::range(offset, offset + count));
+      auto tailOutput = matmul(params_[1 + i * 2], clusterInput);
+      tailOutput = matmul(params_[2 + i * 2], tailOutput);
+      localLoss.push_back(categoricalCrossEntropy(
+          logSoftmax(tailOutput, 0),
+          tailTarget(fl::range(offset, offset + count)),
+          ReduceMode::NONE,
+          ignoreIndex_));
+      offset += count;
     }
-
-    auto indicesArray = fl::nonzero(mask.tensor());
-    headTarget =
-        headTarget + (mask * (cutoff[0] + i)).astype(headTarget.type());
-    auto tailTarget = target(indicesArray) - cutoff[i];
-    auto selectedInput = embedding(Variable(indicesArray, false), input);
-    auto tailOutput = matmul(params_[1 + i * 2], selectedInput);
-    tailOutput = matmul(params_[2 + i * 2], tailOutput);
-    auto localLoss = categoricalCrossEntropy(
-        logSoftmax(tailOutput, 0), tailTarget, ReduceMode::NONE, ignoreIndex_);
-    res = res + cast(localLoss, res.shape(), indicesArray);
+    res = res +
+        cast(concatenate(localLoss, 0), res.shape(), partition.tailPositions);
   }
 
   // Head forward
   res = res +
       categoricalCrossEntropy(
             logSoftmax(headOutput, 0),
-            headTarget,
+            Variable(partition.headTarget, false),
             ReduceMode::NONE,
             ignoreIndex_);
 
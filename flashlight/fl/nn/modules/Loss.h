@@ -191,6 +191,27 @@ class FL_API AdaptiveSoftMaxLoss : public BinaryModule {
   Variable
   cast(const Variable& input, const Shape& outDims, const Tensor& indices);
 
+  // Per-batch partitioning of the flattened targets across the head and tail
+  // clusters of the adaptive softmax, computed once per forward with a single
+  // host pass over the targets (see partitionTargets)
+  struct ClusterPartition {
+    /// Head targets: shortlist targets unchanged, tail targets replaced by
+    /// their cluster's slot in the head
+    Tensor headTarget;
+    /// Flattened positions falling in a tail cluster, grouped by cluster in
+    /// cluster order; empty when every target is in the shortlist
+    Tensor tailPositions;
+    /// In-cluster targets (offset by the cluster's cutoff), one per entry of
+    /// `tailPositions`
+    Tensor tailTarget;
+    /// Number of positions in each tail cluster
+    std::vector<int> tailCounts;
+  };
+
+  ClusterPartition partitionTargets(
+      const Tensor& target,
+      const std::vector<int>& cutoff) const;
+
  public:
   AdaptiveSoftMaxLoss() = default;
 
@@ -5,10 +5,12 @@
  * LICENSE file in the root directory of this source tree.
  */
 
+#include <iterator>
 #include <stdexcept>
 
 #include "flashlight/fl/nn/modules/Module.h"
 
+#include "flashlight/fl/common/Trace.h"
 #include "flashlight/fl/common/Utils.h"
 #include "flashlight/fl/nn/Init.h"
 
@@ -71,9 +73,31 @@ int Module::numParamTensors() const {
 }
 
 std::vector<Variable> Module::operator()(const std::vector<Variable>& input) {
+  FL_TRACE_SCOPE(this->prettyString());
   return this->forward(input);
 }
 
+void Module::forward(ForwardContext& ctx) {
+  // allocating fallback -- move the result into the context's buffer so its
+  // capacity is still reused on subsequent steps
+  auto result = forward(ctx.inputs());
+  auto& out = ctx.scratch();
+  out.clear();
+  std::move(result.begin(), result.end(), std::back_inserter(out));
+  ctx.advance();
+}
+
+Tensor Module::forwardTensor(const Tensor& input) {
+  // Variable fallback -- wrap the input without gradient tracking and unwrap
+  // the result
+  auto result = forward({Variable(input, false)});
+  if (result.size() != 1) {
+    throw std::invalid_argument(
+        "Module::forwardTensor expects a module with exactly one output");
+  }
+  return result.front().tensor();
+}
+
 UnaryModule::UnaryModule() = default;
 
 UnaryModule::UnaryModule(const std::vector<Variable>& params)
@@ -87,7 +111,18 @@ std::vector<Variable> UnaryModule::forward(
   return {forward(inputs[0])};
 }
 
+void UnaryModule::forward(ForwardContext& ctx) {
+  if (ctx.inputs().size() != 1) {
+    throw std::invalid_argument("UnaryModule expects only one input");
+  }
+  auto& out = ctx.scratch();
+  out.clear();
+  out.push_back(forward(ctx.inputs()[0]));
+  ctx.advance();
+}
+
 Variable UnaryModule::operator()(const Variable& input) {
+  FL_TRACE_SCOPE(this->prettyString());
   return this->forward(input);
 }
 
@@ -104,9 +139,20 @@ std::vector<Variable> BinaryModule::forward(
   return {forward(inputs[0], inputs[1])};
 }
 
+void BinaryModule::forward(ForwardContext& ctx) {
+  if (ctx.inputs().size() != 2) {
+    throw std::invalid_argument("BinaryModule expects two inputs");
+  }
+  auto& out = ctx.scratch();
+  out.clear();
+  out.push_back(forward(ctx.inputs()[0], ctx.inputs()[1]));
+  ctx.advance();
+}
+
 Variable BinaryModule::operator()(
     const Variable& input1,
     const Variable& input2) {
+  FL_TRACE_SCOPE(this->prettyString());
   return this->forward(input1, input2);
 }
 
@@ -10,6 +10,7 @@
 #include "flashlight/fl/autograd/Variable.h"
 #include "flashlight/fl/common/Defines.h"
 #include "flashlight/fl/common/Serialization.h"
+#include "flashlight/fl/nn/ForwardContext.h"
 
 #include <stdexcept>
 #include <string>
@@ -129,6 +130,31 @@ class FL_API Module {
   virtual std::vector<Variable> forward(
       const std::vector<Variable>& inputs) = 0;
 
+  /**
+   * Performs forward computation reading inputs from, and writing outputs
+   * back to, a caller-owned `ForwardContext` — the context's buffers are
+   * reused across layers and steps, so no inter-layer vectors are allocated.
+   * The base implementation falls back to the allocating overload; modules
+   * on hot forward paths override it.
+   *
+   * @param ctx the context whose `inputs()` hold the module's inputs; after
+   * the call its `outputs()` hold the result of the forward computation
+   */
+  virtual void forward(ForwardContext& ctx);
+
+  /**
+   * Performs tensor-in/tensor-out forward computation, skipping `Variable`
+   * construction and its shared-pointer bookkeeping entirely. Intended for
+   * inference: no gradient information is recorded, regardless of the
+   * module's mode. The base implementation falls back to the `Variable`
+   * overload with gradient calculation disabled; modules on hot inference
+   * paths override it with pure tensor arithmetic.
+   *
+   * @param input the value to compute forward computation for the module
+   * @return a tensor containing the result of the forward computation
+   */
+  virtual Tensor forwardTensor(const Tensor& input);
+
   /**
    * Overload for forward computation for the module.
    *
@@ -169,6 +195,8 @@ class FL_API UnaryModule : public Module {
 
   std::vector<Variable> forward(const std::vector<Variable>& inputs) override;
 
+  void forward(ForwardContext& ctx) override;
+
   virtual Variable forward(const Variable& input) = 0;
 
   Variable operator()(const Variable& input);
@@ -192,6 +220,8 @@ class FL_API BinaryModule : public Module {
 
   std::vector<Variable> forward(const std::vector<Variable>& inputs) override;
 
+  void forward(ForwardContext& ctx) override;
+
   virtual Variable forward(const Variable& input1, const Variable& input2) = 0;
 
   Variable operator()(const Variable& input1, const Variable& input2);
@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "flashlight/fl/nn/modules/ParallelLinear.h"
+
+#include <sstream>
+#include <stdexcept>
+
+#include "flashlight/fl/autograd/Functions.h"
+#include "flashlight/fl/distributed/DistributedApi.h"
+
+namespace fl {
+
+namespace {
+
+int activeWorldSize() {
+  return isDistributedInit() ? getWorldSize() : 1;
+}
+
+int shardDim(int dim, int worldSize, const char* name) {
+  if (dim % worldSize != 0) {
+    std::ostringstream oss;
+    oss << name << ": sharded dimension (" << dim
+        << ") is not divisible by the world size (" << worldSize << ")";
+    throw std::invalid_argument(oss.str());
+  }
+  return dim / worldSize;
+}
+
+// identity whose backward all-reduces the gradient across ranks; the
+// reduction runs on the communication stream, overlapping the backward
+// compute of earlier layers
+Variable allReduceInBackward(const Variable& input) {
+  auto gradFunc = [](std::vector<Variable>& inputs,
+                     const Variable& gradOutput) {
+    Tensor reduced = gradOutput.tensor().copy();
+    allReduce(reduced, /* async = */ true);
+    inputs[0].addGrad(Variable(reduced, false));
+  };
+  return Variable(input.tensor(), {input}, gradFunc);
+}
+
+// all-reduce the value across ranks; the backward is the identity, since
+// every rank receives the same output gradient
+Variable allReduceInForward(const Variable& input) {
+  Tensor reduced = input.tensor().copy();
+  allReduce(reduced, /* async = */ true);
+  auto gradFunc = [](std::vector<Variable>& inputs,
+                     const Variable& gradOutput) {
+    inputs[0].addGrad(Variable(gradOutput.tensor(), false));
+  };
+  return Variable(reduced, {input}, gradFunc);
+}
+
+} // namespace
+
+ColumnParallelLinear::ColumnParallelLinear(
+    int input_size,
+    int output_size,
+    bool bias /* = true */)
+    : Linear(
+          input_size,
+          shardDim(output_size, activeWorldSize(), "ColumnParallelLinear"),
+          bias),
+      worldSize_(activeWorldSize()) {}
+
+int ColumnParallelLinear::worldSize() const {
+  return worldSize_;
+}
+
+Variable ColumnParallelLinear::forward(const Variable& input) {
+  if (worldSize_ <= 1) {
+    return Linear::forward(input);
+  }
+  return Linear::forward(allReduceInBackward(input));
+}
+
+std::unique_ptr<Module> ColumnParallelLinear::clone() const {
+  return std::make_unique<ColumnParallelLinear>(*this);
+}
+
+std::string ColumnParallelLinear::prettyString() const {
+  std::ostringstream ss;
+  ss << "ColumnParallel (x" << worldSize_ << ") " << Linear::prettyString();
+  return ss.str();
+}
+
+RowParallelLinear::RowParallelLinear(
+    int input_size,
+    int output_size,
+    bool bias /* = true */)
+    : Linear(
+          shardDim(input_size, activeWorldSize(), "RowParallelLinear"),
+          output_size,
+          bias),
+      worldSize_(activeWorldSize()) {}
+
+int RowParallelLinear::worldSize() const {
+  return worldSize_;
+}
+
+Variable RowParallelLinear::forward(const Variable& input) {
+  if (worldSize_ <= 1) {
+    return Linear::forward(input);
+  }
+  // partial product over this rank's input shard; the bias is added only
+  // after the reduction so it is not summed once per rank
+  auto output = linear(input, params_[0].astype(input.type()));
+  output = allReduceInForward(output);
+  if (params_.size() > 1) {
+    output = output + tileAs(params_[1].astype(input.type()), output);
+  }
+  return output;
+}
+
+std::unique_ptr<Module> RowParallelLinear::clone() const {
+  return std::make_unique<RowParallelLinear>(*this);
+}
+
+std::string RowParallelLinear::prettyString() const {
+  std::ostringstream ss;
+  ss << "RowParallel (x" << worldSize_ << ") " << Linear::prettyString();
+  return ss.str();
+}
+
+} // namespace fl
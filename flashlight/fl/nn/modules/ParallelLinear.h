@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include "flashlight/fl/nn/modules/Linear.h"
+
+namespace fl {
+
+/**
+ * A `Linear` whose weight is sharded across distributed ranks along the
+ * output dimension: each rank holds `output_size / worldSize` rows and
+ * computes that slice of the output. The forward needs no communication --
+ * the output stays sharded -- while the backward all-reduces the input
+ * gradient, which every rank's weight shard contributes to. The reduction
+ * runs asynchronously on the communication stream, overlapping the backward
+ * compute of earlier layers.
+ *
+ * Pair with `RowParallelLinear`, which consumes a sharded input, to run a
+ * two-layer block (e.g. a Transformer FFN, or QKV projection plus output
+ * projection) with exactly one all-reduce in forward and one in backward.
+ * When the distributed environment is not initialized the layer degenerates
+ * to a plain `Linear`.
+ */
+class FL_API ColumnParallelLinear : public Linear {
+  int worldSize_{1};
+
+  ColumnParallelLinear() : Linear(1, 1, /* bias = */ false) {} // serialization
+
+  FL_SAVE_LOAD_WITH_BASE(Linear, worldSize_)
+
+ public:
+  /**
+   * Constructs this rank's shard of a `Linear` with the given full sizes.
+   *
+   * @param input_size the size of each input sample
+   * @param output_size the size of each output sample across all ranks; must
+   * be divisible by the world size
+   * @param bias whether the layer includes a (sharded) bias term
+   */
+  ColumnParallelLinear(int input_size, int output_size, bool bias = true);
+
+  /**
+   * The number of ranks the weight is sharded across.
+   */
+  int worldSize() const;
+
+  Variable forward(const Variable& input) override;
+
+  std::unique_ptr<Module> clone() const override;
+
+  std::string prettyString() const override;
+};
+
+/**
+ * A `Linear` whose weight is sharded across distributed ranks along the
+ * input dimension: each rank holds `input_size / worldSize` columns and
+ * consumes the matching input shard (e.g. the output of a
+ * `ColumnParallelLinear`). The forward all-reduces the per-rank partial
+ * outputs -- asynchronously, so the reduction overlaps the next layer's
+ * compute -- and the bias, replicated on every rank, is added after the
+ * reduction. The backward needs no communication. See
+ * `ColumnParallelLinear` for how the two variants pair up.
+ */
+class FL_API RowParallelLinear : public Linear {
+  int worldSize_{1};
+
+  RowParallelLinear() : Linear(1, 1, /* bias = */ false) {} // serialization
+
+  FL_SAVE_LOAD_WITH_BASE(Linear, worldSize_)
+
+ public:
+  /**
+   * Constructs this rank's shard of a `Linear` with the given full sizes.
+   *
+   * @param input_size the size of each input sample across all ranks; must
+   * be divisible by the world size
+   * @param output_size the size of each output sample
+   * @param bias whether the layer includes a bias term (added once, after
+   * the cross-rank reduction)
+   */
+  RowParallelLinear(int input_size, int output_size, bool bias = true);
+
+  /**
+   * The number of ranks the weight is sharded across.
+   */
+  int worldSize() const;
+
+  Variable forward(const Variable& input) override;
+
+  std::unique_ptr<Module> clone() const override;
+
+  std::string prettyString() const override;
+};
+
+} // namespace fl
+
+CEREAL_REGISTER_TYPE(fl::ColumnParallelLinear)
+CEREAL_REGISTER_TYPE(fl::RowParallelLinear)
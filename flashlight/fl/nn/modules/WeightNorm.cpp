@@ -5,6 +5,7 @@
  * LICENSE file in the root directory of this source tree.
  */
 
+#include <optional>
 #include <stdexcept>
 
 #include "flashlight/fl/nn/modules/Conv2D.h"
@@ -42,6 +43,14 @@ void WeightNorm::transformDims() {
 }
 
 void WeightNorm::computeWeight() {
+  // At inference the parameters are frozen: materialize the normalized
+  // weight detached from the autograd graph, so the one weight cached by
+  // eval() (and refreshed by setParams) is a plain tensor and forwards
+  // build no graph through v and g
+  std::optional<NoGradGuard> noGrad;
+  if (!train_) {
+    noGrad.emplace();
+  }
   auto v = params_[0];
   auto g = params_[1];
   Variable nm;
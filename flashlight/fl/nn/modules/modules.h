@@ -15,9 +15,11 @@
 #include "flashlight/fl/nn/modules/Conv2D.h"
 #include "flashlight/fl/nn/modules/Dropout.h"
 #include "flashlight/fl/nn/modules/Embedding.h"
+#include "flashlight/fl/nn/modules/HostEmbedding.h"
 #include "flashlight/fl/nn/modules/Identity.h"
 #include "flashlight/fl/nn/modules/LayerNorm.h"
 #include "flashlight/fl/nn/modules/Linear.h"
+#include "flashlight/fl/nn/modules/ParallelLinear.h"
 #include "flashlight/fl/nn/modules/Loss.h"
 #include "flashlight/fl/nn/modules/Module.h"
 #include "flashlight/fl/nn/modules/Normalize.h"
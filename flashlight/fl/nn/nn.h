@@ -7,7 +7,10 @@
 
 #pragma once
 
+#include "flashlight/fl/nn/DataParallel.h"
+#include "flashlight/fl/nn/PipelineParallel.h"
 #include "flashlight/fl/nn/DistributedUtils.h"
+#include "flashlight/fl/nn/ForwardContext.h"
 #include "flashlight/fl/nn/Init.h"
 #include "flashlight/fl/nn/Utils.h"
 #include "flashlight/fl/nn/modules/modules.h"
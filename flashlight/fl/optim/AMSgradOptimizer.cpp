@@ -46,8 +46,12 @@ AMSgradOptimizer::AMSgradOptimizer(
 }
 
 void AMSgradOptimizer::step() {
+  if (!updateGradAccumulation()) {
+    return;
+  }
+  beginShardedStep();
   for (size_t i = 0; i < parameters_.size(); i++) {
-    if (!parameters_[i].isGradAvailable()) {
+    if (!parameters_[i].isGradAvailable() || !ownsParam(i)) {
       continue;
     }
 
@@ -55,7 +59,7 @@ void AMSgradOptimizer::step() {
     Tensor& data = parameters_[i].tensor();
 
     if (wd_ != 0) {
-      data = data - wd_ * data;
+      data = data - wd_ * wdScaleFor(i) * data;
     }
 
     Tensor& biasedFirst = biasedFirst_[i];
@@ -69,10 +73,12 @@ void AMSgradOptimizer::step() {
     fl::eval(biasedSecond);
     fl::eval(maxExpAvgSq);
 
-    data = data - (lr_ * biasedFirst) / (fl::sqrt(maxExpAvgSq) + eps_);
+    data = data -
+        (lr_ * lrScaleFor(i) * biasedFirst) / (fl::sqrt(maxExpAvgSq) + eps_);
 
     fl::eval(data);
   }
+  endShardedStep();
 }
 
 std::string AMSgradOptimizer::prettyString() const {
@@ -38,8 +38,12 @@ AdadeltaOptimizer::AdadeltaOptimizer(
 }
 
 void AdadeltaOptimizer::step() {
+  if (!updateGradAccumulation()) {
+    return;
+  }
+  beginShardedStep();
   for (size_t i = 0; i < parameters_.size(); i++) {
-    if (!parameters_[i].isGradAvailable()) {
+    if (!parameters_[i].isGradAvailable() || !ownsParam(i)) {
       continue;
     }
 
@@ -48,7 +52,7 @@ void AdadeltaOptimizer::step() {
 
     if (wd_ != 0) {
       // Weight decay term
-      data = data - wd_ * data;
+      data = data - wd_ * wdScaleFor(i) * data;
     }
 
     Tensor& accGrad = accGrad_[i];
@@ -59,12 +63,13 @@ void AdadeltaOptimizer::step() {
 
     auto delta = fl::sqrt(accDelta + eps_) / fl::sqrt(accGrad + eps_) * grad;
 
-    data = data - lr_ * delta;
+    data = data - lr_ * lrScaleFor(i) * delta;
     fl::eval(data);
 
     accDelta = rho_ * accDelta + (1 - rho_) * delta * delta;
     fl::eval(accDelta);
   }
+  endShardedStep();
 }
 
 std::string AdadeltaOptimizer::prettyString() const {
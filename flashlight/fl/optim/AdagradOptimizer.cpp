@@ -10,6 +10,7 @@
 #include <cmath>
 
 #include "flashlight/fl/tensor/Compute.h"
+#include "flashlight/fl/tensor/Index.h"
 
 namespace fl {
 
@@ -29,8 +30,17 @@ AdagradOptimizer::AdagradOptimizer(
 }
 
 void AdagradOptimizer::step() {
+  if (!updateGradAccumulation()) {
+    return;
+  }
+  beginShardedStep();
   for (size_t i = 0; i < parameters_.size(); i++) {
-    if (!parameters_[i].isGradAvailable()) {
+    if (!parameters_[i].isGradAvailable() || !ownsParam(i)) {
+      continue;
+    }
+
+    if (parameters_[i].isSparseGradAvailable()) {
+      stepSparse(i);
       continue;
     }
 
@@ -40,14 +50,41 @@ void AdagradOptimizer::step() {
 
     if (wd_ != 0) {
       // Weight decay term
-      data = data - wd_ * data;
+      data = data - wd_ * wdScaleFor(i) * data;
     }
 
     variance = variance + grad * grad;
     fl::eval(variance);
-    data = data - lr_ * grad / (fl::sqrt(variance) + eps_);
+    data = data - lr_ * lrScaleFor(i) * grad / (fl::sqrt(variance) + eps_);
     fl::eval(data);
   }
+  endShardedStep();
+}
+
+void AdagradOptimizer::stepSparse(size_t i) {
+  // Update only the parameter slices and variance rows the sparse gradient
+  // touches; everything else is untouched, matching the dense update for a
+  // gradient which is zero outside the indexed slices (apart from weight
+  // decay, which here also applies only to the touched slices)
+  const SparseGrad& sparse = parameters_[i].sparseGrad();
+  const Tensor& vals = sparse.values;
+  Tensor& data = parameters_[i].tensor();
+  Tensor& variance = variance_[i];
+
+  std::vector<Index> sel(data.ndim(), fl::span);
+  sel.back() = sparse.indices;
+
+  if (wd_ != 0) {
+    // Weight decay term
+    data(sel) = data(sel) - wd_ * wdScaleFor(i) * data(sel);
+  }
+
+  Tensor varianceRows = variance(sel) + vals * vals;
+  variance(sel) = varianceRows;
+  fl::eval(variance);
+  data(sel) = data(sel) -
+      lr_ * lrScaleFor(i) * vals / (fl::sqrt(varianceRows) + eps_);
+  fl::eval(data);
 }
 
 std::string AdagradOptimizer::prettyString() const {
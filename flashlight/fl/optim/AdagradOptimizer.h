@@ -32,6 +32,11 @@ class FL_API AdagradOptimizer : public FirstOrderOptimizer {
   float wd_;
   std::vector<Tensor> variance_; // store sum_{tau=0}^{tau=t} grad_tau*grad_tau
 
+  // Row-wise update of parameter `i` from its sparse gradient (see
+  // `Variable::addSparseGrad`), touching only the indexed slices of the
+  // parameter and its variance state
+  void stepSparse(size_t i);
+
  public:
   /** Construct an Adagrad optimizer
    * @param parameters The parameters from e.g. `model.parameters()`.
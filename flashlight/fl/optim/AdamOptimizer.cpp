@@ -10,6 +10,7 @@
 #include <cmath>
 
 #include "flashlight/fl/tensor/Compute.h"
+#include "flashlight/fl/tensor/Index.h"
 
 using std::vector;
 
@@ -21,7 +22,8 @@ AdamOptimizer::AdamOptimizer(
     float beta1 /* = 0.9 */,
     float beta2 /* = 0.999 */,
     float epsilon /* = 1e-8 */,
-    float weightDecay /* = 0 */)
+    float weightDecay /* = 0 */,
+    bool quantizeMoments /* = false */)
     : FirstOrderOptimizer(parameters, learningRate),
       beta1_(beta1),
       beta2_(beta2),
@@ -29,7 +31,20 @@ AdamOptimizer::AdamOptimizer(
       wd_(weightDecay),
       count_(0),
       biasedFirst_(),
-      biasedSecond_() {
+      biasedSecond_(),
+      quantizeMoments_(quantizeMoments) {
+  if (quantizeMoments_) {
+    qFirst_.resize(parameters.size());
+    qSecond_.resize(parameters.size());
+    scaleFirst_.resize(parameters.size());
+    scaleSecond_.resize(parameters.size());
+    for (size_t i = 0; i < parameters_.size(); i++) {
+      const auto zeros = fl::full(parameters_[i].shape(), 0, fl::dtype::f32);
+      quantizeMoment(zeros, qFirst_[i], scaleFirst_[i]);
+      quantizeMoment(zeros, qSecond_[i], scaleSecond_[i]);
+    }
+    return;
+  }
   biasedFirst_.reserve(parameters.size());
   biasedSecond_.reserve(parameters.size());
 
@@ -43,13 +58,35 @@ AdamOptimizer::AdamOptimizer(
 }
 
 void AdamOptimizer::step() {
-  count_++;
+  if (!updateGradAccumulation()) {
+    return;
+  }
+  if (advanceStepCount()) {
+    count_++;
+  }
   float correctedBias1 = 1 - std::pow(beta1_, count_);
   float correctedBias2 = 1 - std::pow(beta2_, count_);
   float correctedLr = lr_ * std::sqrt(correctedBias2) / correctedBias1;
 
+  beginShardedStep();
+  if (quantizeMoments_) {
+    stepQuantized(correctedLr);
+    endShardedStep();
+    return;
+  }
+  if (fusedStep_) {
+    stepFused(correctedLr);
+    endShardedStep();
+    return;
+  }
+
   for (size_t i = 0; i < parameters_.size(); i++) {
-    if (!parameters_[i].isGradAvailable()) {
+    if (!parameters_[i].isGradAvailable() || !ownsParam(i)) {
+      continue;
+    }
+
+    if (parameters_[i].isSparseGradAvailable()) {
+      stepSparse(i, correctedLr);
       continue;
     }
 
@@ -58,7 +95,7 @@ void AdamOptimizer::step() {
 
     if (wd_ != 0) {
       // Weight decay term
-      data = data - wd_ * lr_ * data;
+      data = data - wd_ * wdScaleFor(i) * lr_ * lrScaleFor(i) * data;
     }
 
     Tensor& biasedFirst = biasedFirst_[i];
@@ -70,10 +107,183 @@ void AdamOptimizer::step() {
     fl::eval(biasedFirst);
     fl::eval(biasedSecond);
 
-    data = data - (correctedLr * biasedFirst) / (fl::sqrt(biasedSecond) + eps_);
+    data = data -
+        (correctedLr * lrScaleFor(i) * biasedFirst) /
+            (fl::sqrt(biasedSecond) + eps_);
 
     fl::eval(data);
   }
+  endShardedStep();
+}
+
+void AdamOptimizer::stepFused(float correctedLr) {
+  for (const auto& group : makeFlatGroups()) {
+    const Tensor grad = flattenGroup(group, [this](size_t i) -> const Tensor& {
+      return parameters_[i].grad().tensor();
+    });
+    Tensor data = flattenGroup(group, [this](size_t i) -> const Tensor& {
+      return parameters_[i].tensor();
+    });
+
+    if (wd_ != 0) {
+      // Weight decay term
+      data = data - wd_ * group.wdScale * lr_ * group.lrScale * data;
+    }
+
+    Tensor biasedFirst = flattenGroup(
+        group, [this](size_t i) -> const Tensor& { return biasedFirst_[i]; });
+    Tensor biasedSecond = flattenGroup(
+        group, [this](size_t i) -> const Tensor& { return biasedSecond_[i]; });
+
+    biasedFirst = beta1_ * biasedFirst + (1 - beta1_) * grad;
+    biasedSecond = beta2_ * biasedSecond + (1 - beta2_) * grad * grad;
+
+    data = data -
+        (correctedLr * group.lrScale * biasedFirst) /
+            (fl::sqrt(biasedSecond) + eps_);
+
+    unflattenGroup(group, biasedFirst, [this](size_t i, Tensor&& m) {
+      biasedFirst_[i] = std::move(m);
+      fl::eval(biasedFirst_[i]);
+    });
+    unflattenGroup(group, biasedSecond, [this](size_t i, Tensor&& m) {
+      biasedSecond_[i] = std::move(m);
+      fl::eval(biasedSecond_[i]);
+    });
+    unflattenGroup(group, data, [this](size_t i, Tensor&& d) {
+      parameters_[i].tensor() = std::move(d);
+      fl::eval(parameters_[i].tensor());
+    });
+  }
+}
+
+void AdamOptimizer::stepSparse(size_t i, float correctedLr) {
+  // Lazy sparse Adam: only the moment rows touched by this step's indices
+  // are decayed and updated - untouched rows keep their moments unchanged
+  // rather than decaying every step as in the dense update. Bias correction
+  // still uses the global step count.
+  const SparseGrad& sparse = parameters_[i].sparseGrad();
+  const Tensor& vals = sparse.values;
+  Tensor& data = parameters_[i].tensor();
+
+  std::vector<Index> sel(data.ndim(), fl::span);
+  sel.back() = sparse.indices;
+
+  if (wd_ != 0) {
+    // Weight decay term
+    data(sel) =
+        data(sel) - wd_ * wdScaleFor(i) * lr_ * lrScaleFor(i) * data(sel);
+  }
+
+  Tensor& biasedFirst = biasedFirst_[i];
+  Tensor& biasedSecond = biasedSecond_[i];
+
+  Tensor firstRows = beta1_ * biasedFirst(sel) + (1 - beta1_) * vals;
+  Tensor secondRows = beta2_ * biasedSecond(sel) + (1 - beta2_) * vals * vals;
+  biasedFirst(sel) = firstRows;
+  biasedSecond(sel) = secondRows;
+
+  fl::eval(biasedFirst);
+  fl::eval(biasedSecond);
+
+  data(sel) = data(sel) -
+      (correctedLr * lrScaleFor(i) * firstRows) /
+          (fl::sqrt(secondRows) + eps_);
+
+  fl::eval(data);
+}
+
+void AdamOptimizer::stepQuantized(float correctedLr) {
+  for (size_t i = 0; i < parameters_.size(); i++) {
+    if (!parameters_[i].isGradAvailable() || !ownsParam(i)) {
+      continue;
+    }
+
+    const Tensor& grad = parameters_[i].grad().tensor();
+    Tensor& data = parameters_[i].tensor();
+
+    if (wd_ != 0) {
+      // Weight decay term
+      data = data - wd_ * wdScaleFor(i) * lr_ * lrScaleFor(i) * data;
+    }
+
+    Tensor biasedFirst =
+        dequantizeMoment(qFirst_[i], scaleFirst_[i], data.shape())
+            .astype(data.type());
+    Tensor biasedSecond =
+        dequantizeMoment(qSecond_[i], scaleSecond_[i], data.shape())
+            .astype(data.type());
+
+    biasedFirst = beta1_ * biasedFirst + (1 - beta1_) * grad;
+    biasedSecond = beta2_ * biasedSecond + (1 - beta2_) * grad * grad;
+
+    quantizeMoment(biasedFirst, qFirst_[i], scaleFirst_[i]);
+    quantizeMoment(biasedSecond, qSecond_[i], scaleSecond_[i]);
+
+    data = data -
+        (correctedLr * lrScaleFor(i) * biasedFirst) /
+            (fl::sqrt(biasedSecond) + eps_);
+
+    fl::eval(data);
+  }
+}
+
+void AdamOptimizer::quantizeMoment(
+    const Tensor& moment,
+    Tensor& codes,
+    Tensor& scales) const {
+  Tensor flat = moment.flatten().astype(fl::dtype::f32);
+  const int64_t numElements = flat.elements();
+  const int64_t numBlocks =
+      (numElements + kQuantBlockSize - 1) / kQuantBlockSize;
+  const int64_t padded = numBlocks * kQuantBlockSize;
+  if (padded != numElements) {
+    flat = fl::concatenate(
+        {flat, fl::full({padded - numElements}, 0., fl::dtype::f32)}, 0);
+  }
+  const Tensor blocks = fl::reshape(flat, {kQuantBlockSize, numBlocks});
+  scales = fl::amax(fl::abs(blocks), {0}, /* keepDims = */ true) / 127;
+  // zero blocks quantize to the zero code; avoid dividing by a zero scale
+  const Tensor safeScales = fl::where(scales > 0, scales, 1.);
+  codes = fl::clip(
+              fl::rint(blocks / fl::tile(safeScales, {kQuantBlockSize, 1})) +
+                  128,
+              0.,
+              255.)
+              .astype(fl::dtype::u8);
+  fl::eval(codes);
+  fl::eval(scales);
+}
+
+Tensor AdamOptimizer::dequantizeMoment(
+    const Tensor& codes,
+    const Tensor& scales,
+    const Shape& shape) const {
+  const Tensor blocks = (codes.astype(fl::dtype::f32) - 128) *
+      fl::tile(scales, {kQuantBlockSize, 1});
+  Tensor flat = blocks.flatten();
+  const int64_t numElements = shape.elements();
+  if (flat.elements() != numElements) {
+    flat = flat(fl::range(0, numElements));
+  }
+  return fl::reshape(flat, shape);
+}
+
+void AdamOptimizer::releaseNonOwnedState() {
+  for (size_t i = 0; i < parameters_.size(); i++) {
+    if (ownsParam(i)) {
+      continue;
+    }
+    if (quantizeMoments_) {
+      qFirst_[i] = Tensor();
+      qSecond_[i] = Tensor();
+      scaleFirst_[i] = Tensor();
+      scaleSecond_[i] = Tensor();
+    } else {
+      biasedFirst_[i] = Tensor();
+      biasedSecond_[i] = Tensor();
+    }
+  }
 }
 
 std::string AdamOptimizer::prettyString() const {
@@ -83,6 +293,9 @@ std::string AdamOptimizer::prettyString() const {
   if (wd_ != 0) {
     ss << " (weight decay=" << wd_ << ")";
   }
+  if (quantizeMoments_) {
+    ss << " (8-bit moments)";
+  }
 
   return ss.str();
 }
@@ -31,10 +31,18 @@ class FL_API AdamOptimizer : public FirstOrderOptimizer {
       fl::serializeAs<double>(wd_),
       count_,
       biasedFirst_,
-      biasedSecond_)
+      biasedSecond_,
+      fl::versioned(quantizeMoments_, 1),
+      fl::versioned(qFirst_, 1),
+      fl::versioned(qSecond_, 1),
+      fl::versioned(scaleFirst_, 1),
+      fl::versioned(scaleSecond_, 1))
 
   AdamOptimizer() = default; // Intentionally private
 
+  // number of moment elements sharing one 8-bit quantization scale
+  static constexpr int64_t kQuantBlockSize = 2048;
+
   float beta1_;
   float beta2_;
   float eps_;
@@ -42,6 +50,41 @@ class FL_API AdamOptimizer : public FirstOrderOptimizer {
   int count_;
   std::vector<Tensor> biasedFirst_;
   std::vector<Tensor> biasedSecond_;
+  // 8-bit moment storage: codes are u8 of shape {kQuantBlockSize, numBlocks}
+  // with an f32 absmax scale per block; biasedFirst_/biasedSecond_ stay empty
+  // in this mode
+  bool quantizeMoments_{false};
+  std::vector<Tensor> qFirst_;
+  std::vector<Tensor> qSecond_;
+  std::vector<Tensor> scaleFirst_;
+  std::vector<Tensor> scaleSecond_;
+
+  // Fused multi-tensor update applied to per-type flattened chunks; see
+  // FirstOrderOptimizer::setFusedStep.
+  void stepFused(float correctedLr);
+
+  // Dequantize-update-requantize step over the 8-bit moment storage.
+  void stepQuantized(float correctedLr);
+
+  // Row-wise update of parameter `i` from its sparse gradient (see
+  // `Variable::addSparseGrad`), touching only the indexed slices of the
+  // parameter and its moments.
+  void stepSparse(size_t i, float correctedLr);
+
+  // Drop the moments of parameters this rank does not own; see
+  // FirstOrderOptimizer::shardStateAcrossRanks.
+  void releaseNonOwnedState() override;
+
+  // Quantize a moment tensor into block-wise 8-bit codes and per-block
+  // scales, zero-padding the final block.
+  void quantizeMoment(const Tensor& moment, Tensor& codes, Tensor& scales)
+      const;
+
+  // Reconstruct a moment tensor of the given shape from its codes and scales.
+  Tensor dequantizeMoment(
+      const Tensor& codes,
+      const Tensor& scales,
+      const Shape& shape) const;
 
  public:
   /** Construct an Adam optimizer.
@@ -52,6 +95,11 @@ class FL_API AdamOptimizer : public FirstOrderOptimizer {
    * @param epsilon A small value used for numerical stability.
    * @param weightDecay The amount of L2 weight decay to use for all the
    * parameters.
+   * @param quantizeMoments Store both moments block-wise in 8 bits with an
+   * f32 absmax scale per 2048-element block, cutting optimizer state memory
+   * to roughly a quarter. Moments are dequantized, updated and requantized
+   * inside step(), so updates are approximate; the fused multi-tensor path
+   * is ignored in this mode.
    */
   AdamOptimizer(
       const std::vector<Variable>& parameters,
@@ -59,7 +107,8 @@ class FL_API AdamOptimizer : public FirstOrderOptimizer {
       float beta1 = 0.9,
       float beta2 = 0.999,
       float epsilon = 1e-8,
-      float weightDecay = 0);
+      float weightDecay = 0,
+      bool quantizeMoments = false);
 
   void step() override;
 
@@ -69,3 +118,4 @@ class FL_API AdamOptimizer : public FirstOrderOptimizer {
 } // namespace fl
 
 CEREAL_REGISTER_TYPE(fl::AdamOptimizer)
+CEREAL_CLASS_VERSION(fl::AdamOptimizer, 1)
@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "flashlight/fl/optim/EMAUpdater.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+#include "flashlight/fl/tensor/Compute.h"
+#include "flashlight/fl/tensor/Index.h"
+
+namespace fl {
+
+EMAUpdater::EMAUpdater(
+    const std::vector<Variable>& parameters,
+    double decay /* = 0.999 */)
+    : parameters_(parameters.begin(), parameters.end()), decay_(decay) {
+  if (decay_ < 0 || decay_ >= 1) {
+    throw std::invalid_argument("EMAUpdater - decay must be in [0, 1)");
+  }
+  shadow_.reserve(parameters_.size());
+  for (const auto& param : parameters_) {
+    shadow_.push_back(param.tensor().copy());
+    fl::eval(shadow_.back());
+  }
+}
+
+void EMAUpdater::update() {
+  if (swapped_) {
+    throw std::logic_error(
+        "EMAUpdater::update - the model currently holds the shadow "
+        "weights; call swapForEval to restore the training weights first");
+  }
+  // Fuse the lerp over all parameters of a common type into one update on a
+  // flattened chunk rather than launching one small kernel per parameter
+  std::vector<fl::dtype> types;
+  for (const auto& param : parameters_) {
+    const auto type = param.type();
+    if (std::find(types.begin(), types.end(), type) == types.end()) {
+      types.push_back(type);
+    }
+  }
+  for (const auto type : types) {
+    std::vector<size_t> indices;
+    std::vector<Tensor> paramFlats;
+    std::vector<Tensor> shadowFlats;
+    for (size_t i = 0; i < parameters_.size(); i++) {
+      if (parameters_[i].type() != type) {
+        continue;
+      }
+      indices.push_back(i);
+      paramFlats.push_back(parameters_[i].tensor().flatten());
+      shadowFlats.push_back(shadow_[i].flatten());
+    }
+    Tensor flatShadow = fl::concatenate(shadowFlats, 0);
+    flatShadow = decay_ * flatShadow +
+        (1 - decay_) * fl::concatenate(paramFlats, 0);
+    int64_t offset = 0;
+    for (const auto i : indices) {
+      const auto numElements = parameters_[i].elements();
+      shadow_[i] = fl::reshape(
+          flatShadow(fl::range(offset, offset + numElements)),
+          parameters_[i].shape());
+      fl::eval(shadow_[i]);
+      offset += numElements;
+    }
+  }
+}
+
+void EMAUpdater::swapForEval() {
+  for (size_t i = 0; i < parameters_.size(); i++) {
+    std::swap(parameters_[i].tensor(), shadow_[i]);
+  }
+  swapped_ = !swapped_;
+}
+
+bool EMAUpdater::swapped() const {
+  return swapped_;
+}
+
+double EMAUpdater::decay() const {
+  return decay_;
+}
+
+void EMAUpdater::setDecay(double decay) {
+  if (decay < 0 || decay >= 1) {
+    throw std::invalid_argument("EMAUpdater - decay must be in [0, 1)");
+  }
+  decay_ = decay;
+}
+
+} // namespace fl
@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "flashlight/fl/autograd/Variable.h"
+#include "flashlight/fl/common/Defines.h"
+#include "flashlight/fl/tensor/TensorBase.h"
+
+namespace fl {
+
+/**
+ * Maintains an exponential moving average of a set of parameters (e.g.
+ * `model.params()`) for stochastic weight averaging, updated as
+ * \f[ shadow = decay \times shadow + (1 - decay) \times param \f]
+ * after each optimizer step.
+ *
+ * The shadow parameters of a common type are updated as one fused
+ * multi-tensor lerp over a flattened chunk rather than one small kernel per
+ * parameter, and `swapForEval` exchanges tensor handles between the model and
+ * the shadow copy without copying any data, so evaluating with averaged
+ * weights costs nothing beyond the swap:
+ *
+ * \code{.cpp}
+ * EMAUpdater ema(model.params(), 0.999);
+ * for (...) {
+ *   // forward/backward/step
+ *   ema.update();
+ * }
+ * ema.swapForEval(); // model now holds the averaged weights
+ * evaluate(model);
+ * ema.swapForEval(); // restore the training weights
+ * \endcode
+ */
+class FL_API EMAUpdater {
+ private:
+  FL_SAVE_LOAD(decay_, parameters_, shadow_)
+
+  EMAUpdater() = default; // Intentionally private
+
+  std::vector<Variable> parameters_;
+  std::vector<Tensor> shadow_;
+  double decay_{0.999};
+  // whether the model currently holds the shadow weights (runtime state;
+  // not serialized)
+  bool swapped_{false};
+
+ public:
+  /**
+   * Construct an EMA updater shadowing the given parameters. The shadow
+   * copies are initialized from the parameters' current values.
+   *
+   * @param parameters the parameters to average, from e.g. `model.params()`.
+   * @param decay the averaging decay; the shadow tracks roughly the last
+   * \f$ 1 / (1 - decay) \f$ updates.
+   */
+  explicit EMAUpdater(
+      const std::vector<Variable>& parameters,
+      double decay = 0.999);
+
+  /**
+   * Fold the parameters' current values into the shadow copies. Throws if
+   * the model currently holds the shadow weights (see `swapForEval`).
+   */
+  void update();
+
+  /**
+   * Exchange the tensor handles of the parameters and the shadow copies -
+   * no data is copied. After an odd number of calls the model holds the
+   * averaged weights and the shadow holds the training weights; call again
+   * to restore them. `update` may not be called while swapped.
+   */
+  void swapForEval();
+
+  /**
+   * Whether the model currently holds the averaged weights.
+   */
+  bool swapped() const;
+
+  double decay() const;
+  void setDecay(double decay);
+};
+
+} // namespace fl
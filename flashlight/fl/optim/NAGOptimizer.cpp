@@ -37,10 +37,14 @@ NAGOptimizer::NAGOptimizer(
 }
 
 void NAGOptimizer::step() {
+  if (!updateGradAccumulation()) {
+    return;
+  }
+  beginShardedStep();
   float correctedLr = lr_ / oldLr_;
 
   for (size_t i = 0; i < parameters_.size(); i++) {
-    if (!parameters_[i].isGradAvailable()) {
+    if (!parameters_[i].isGradAvailable() || !ownsParam(i)) {
       continue;
     }
 
@@ -49,16 +53,17 @@ void NAGOptimizer::step() {
 
     if (wd_ != 0) {
       // Weight decay term
-      data = data * (1 - lr_ * wd_);
+      data = data * (1 - lr_ * lrScaleFor(i) * wd_ * wdScaleFor(i));
     }
     Tensor& velocity = velocities_[i];
     // this velocity corresponds to fairseq velocity * -1
-    velocity = mu_ * velocity * correctedLr + lr_ * grad;
+    velocity = mu_ * velocity * correctedLr + lr_ * lrScaleFor(i) * grad;
     fl::eval(velocity);
-    grad = grad * lr_ + velocity * mu_;
+    grad = grad * lr_ * lrScaleFor(i) + velocity * mu_;
     data = data - grad;
     fl::eval(data);
   }
+  endShardedStep();
   oldLr_ = lr_;
 }
 
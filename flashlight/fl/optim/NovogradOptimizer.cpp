@@ -41,8 +41,12 @@ NovogradOptimizer::NovogradOptimizer(
 }
 
 void NovogradOptimizer::step() {
+  if (!updateGradAccumulation()) {
+    return;
+  }
+  beginShardedStep();
   for (size_t i = 0; i < parameters_.size(); i++) {
-    if (!parameters_[i].isGradAvailable()) {
+    if (!parameters_[i].isGradAvailable() || !ownsParam(i)) {
       continue;
     }
 
@@ -56,13 +60,14 @@ void NovogradOptimizer::step() {
     accGrad = beta1_ * accGrad +
         (1 - beta1_) *
             (grad / (static_cast<float>(std::sqrt(accGradNorm_[i]) + eps_)) +
-             wd_ * data);
+             wd_ * wdScaleFor(i) * data);
     fl::eval(accGrad);
 
-    data = data - (lr_ * accGrad);
+    data = data - (lr_ * lrScaleFor(i) * accGrad);
 
     fl::eval(data);
   }
+  endShardedStep();
 }
 
 std::string NovogradOptimizer::prettyString() const {
@@ -7,7 +7,14 @@
 
 #include "flashlight/fl/optim/Optimizers.h"
 
+#include <algorithm>
 #include <cmath>
+#include <numeric>
+#include <stdexcept>
+
+#include "flashlight/fl/distributed/DistributedApi.h"
+#include "flashlight/fl/tensor/Compute.h"
+#include "flashlight/fl/tensor/Index.h"
 
 using std::vector;
 
@@ -21,7 +28,232 @@ FirstOrderOptimizer::FirstOrderOptimizer(
     double learningRate)
     : parameters_(parameters.begin(), parameters.end()), lr_(learningRate) {}
 
+void FirstOrderOptimizer::accumulateGrads(int64_t numMicrobatches) {
+  if (numMicrobatches < 1) {
+    throw std::invalid_argument(
+        "FirstOrderOptimizer::accumulateGrads - "
+        "numMicrobatches must be positive");
+  }
+  accumSteps_ = numMicrobatches;
+  accumCount_ = 0;
+}
+
+bool FirstOrderOptimizer::updateGradAccumulation() {
+  if (accumSteps_ <= 1) {
+    return true;
+  }
+  if (++accumCount_ < accumSteps_) {
+    return false;
+  }
+  accumCount_ = 0;
+  // average the gradients folded over the microbatches
+  for (auto& parameter : parameters_) {
+    if (!parameter.isGradAvailable()) {
+      continue;
+    }
+    Tensor& grad = parameter.grad().tensor();
+    grad = grad / accumSteps_;
+    fl::eval(grad);
+  }
+  return true;
+}
+
+void FirstOrderOptimizer::stepParams(const std::vector<size_t>& indices) {
+  if (accumSteps_ > 1 || sharded_) {
+    throw std::runtime_error(
+        "FirstOrderOptimizer::stepParams - partial steps are not supported "
+        "with gradient accumulation or sharded optimizer state");
+  }
+  if (indices.empty()) {
+    return;
+  }
+  stepFilter_.assign(parameters_.size(), 0);
+  for (const auto idx : indices) {
+    if (idx >= parameters_.size()) {
+      stepFilter_.clear();
+      throw std::invalid_argument(
+          "FirstOrderOptimizer::stepParams - parameter index out of range");
+    }
+    stepFilter_[idx] = 1;
+  }
+  step();
+  stepFilter_.clear();
+}
+
+bool FirstOrderOptimizer::advanceStepCount() {
+  if (stepFilter_.empty()) {
+    // full steps always advance and end any partial-step sequence
+    stepCountersAdvanced_ = false;
+    return true;
+  }
+  if (stepCountersAdvanced_) {
+    return false;
+  }
+  stepCountersAdvanced_ = true;
+  return true;
+}
+
+void FirstOrderOptimizer::setParamGroups(const std::vector<ParamGroup>& groups) {
+  std::vector<double> lrScale(parameters_.size(), 1.0);
+  std::vector<double> wdScale(parameters_.size(), 1.0);
+  std::vector<bool> assigned(parameters_.size(), false);
+  for (const auto& group : groups) {
+    for (const auto idx : group.params) {
+      if (idx >= parameters_.size()) {
+        throw std::invalid_argument(
+            "FirstOrderOptimizer::setParamGroups - "
+            "parameter index out of range");
+      }
+      if (assigned[idx]) {
+        throw std::invalid_argument(
+            "FirstOrderOptimizer::setParamGroups - "
+            "parameter assigned to more than one group");
+      }
+      assigned[idx] = true;
+      lrScale[idx] = group.lrMultiplier;
+      wdScale[idx] = group.wdMultiplier;
+    }
+  }
+  if (groups.empty()) {
+    paramLrScale_.clear();
+    paramWdScale_.clear();
+  } else {
+    paramLrScale_ = std::move(lrScale);
+    paramWdScale_ = std::move(wdScale);
+  }
+}
+
+void FirstOrderOptimizer::shardStateAcrossRanks(bool shard) {
+  if (!shard || getWorldSize() <= 1) {
+    sharded_ = false;
+    paramOwner_.clear();
+    return;
+  }
+  const int worldSize = getWorldSize();
+  shardRank_ = getWorldRank();
+  paramOwner_.assign(parameters_.size(), 0);
+  // greedy largest-first assignment to the least-loaded rank balances the
+  // per-rank update work and state
+  std::vector<size_t> order(parameters_.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [this](size_t a, size_t b) {
+    return parameters_[a].bytes() > parameters_[b].bytes();
+  });
+  std::vector<size_t> load(worldSize, 0);
+  for (const auto idx : order) {
+    const auto owner =
+        std::min_element(load.begin(), load.end()) - load.begin();
+    paramOwner_[idx] = owner;
+    load[owner] += parameters_[idx].bytes();
+  }
+  sharded_ = true;
+  releaseNonOwnedState();
+}
+
+void FirstOrderOptimizer::beginShardedStep() {
+  if (!sharded_) {
+    return;
+  }
+  std::vector<Tensor*> grads;
+  std::vector<int> roots;
+  for (size_t i = 0; i < parameters_.size(); i++) {
+    if (!parameters_[i].isGradAvailable()) {
+      continue;
+    }
+    grads.push_back(&parameters_[i].grad().tensor());
+    roots.push_back(paramOwner_[i]);
+  }
+  reduceMultiple(grads, roots);
+  // average the summed gradients on the owning rank
+  const auto worldSize = getWorldSize();
+  for (size_t i = 0; i < parameters_.size(); i++) {
+    if (!ownsParam(i) || !parameters_[i].isGradAvailable()) {
+      continue;
+    }
+    Tensor& grad = parameters_[i].grad().tensor();
+    grad = grad / worldSize;
+    fl::eval(grad);
+  }
+}
+
+void FirstOrderOptimizer::endShardedStep() {
+  if (!sharded_) {
+    return;
+  }
+  std::vector<Tensor*> data;
+  std::vector<int> roots;
+  for (size_t i = 0; i < parameters_.size(); i++) {
+    if (!parameters_[i].isGradAvailable()) {
+      continue;
+    }
+    data.push_back(&parameters_[i].tensor());
+    roots.push_back(paramOwner_[i]);
+  }
+  broadcastMultiple(data, roots);
+}
+
+std::vector<FirstOrderOptimizer::FlatGroup>
+FirstOrderOptimizer::makeFlatGroups() const {
+  std::vector<FlatGroup> groups;
+  for (size_t i = 0; i < parameters_.size(); i++) {
+    if (!parameters_[i].isGradAvailable() || !ownsParam(i)) {
+      continue;
+    }
+    const auto type = parameters_[i].type();
+    const auto lrScale = lrScaleFor(i);
+    const auto wdScale = wdScaleFor(i);
+    FlatGroup* group = nullptr;
+    for (auto& g : groups) {
+      if (g.type == type && g.lrScale == lrScale && g.wdScale == wdScale) {
+        group = &g;
+        break;
+      }
+    }
+    if (!group) {
+      groups.emplace_back();
+      group = &groups.back();
+      group->type = type;
+      group->lrScale = lrScale;
+      group->wdScale = wdScale;
+    }
+    group->indices.push_back(i);
+    group->offsets.push_back(group->numElements);
+    group->numElements += parameters_[i].elements();
+  }
+  return groups;
+}
+
+Tensor FirstOrderOptimizer::flattenGroup(
+    const FlatGroup& group,
+    const std::function<const Tensor&(size_t)>& get) const {
+  std::vector<Tensor> flats;
+  flats.reserve(group.indices.size());
+  for (const auto idx : group.indices) {
+    flats.push_back(get(idx).flatten());
+  }
+  return fl::concatenate(flats, 0);
+}
+
+void FirstOrderOptimizer::unflattenGroup(
+    const FlatGroup& group,
+    const Tensor& flat,
+    const std::function<void(size_t, Tensor&&)>& set) const {
+  for (size_t j = 0; j < group.indices.size(); j++) {
+    const auto idx = group.indices[j];
+    const auto begin = group.offsets[j];
+    const auto end = begin + parameters_[idx].elements();
+    set(
+        idx,
+        fl::reshape(flat(fl::range(begin, end)), parameters_[idx].shape()));
+  }
+}
+
 void FirstOrderOptimizer::zeroGrad() {
+  // mid-accumulation, gradients must keep folding across microbatches
+  if (accumCount_ != 0) {
+    return;
+  }
+  stepCountersAdvanced_ = false;
   for (auto& parameter : parameters_) {
     parameter.zeroGrad();
   }
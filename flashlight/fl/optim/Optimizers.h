@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <functional>
 #include <vector>
 
 #include "flashlight/fl/autograd/Variable.h"
@@ -34,12 +35,138 @@ class FL_API FirstOrderOptimizer {
   FL_SAVE_LOAD(lr_, parameters_)
 
  protected:
+  /**
+   * Parameters of a common type fused into one contiguous chunk for the
+   * fused update path.
+   */
+  struct FlatGroup {
+    fl::dtype type;
+    double lrScale{1.0};
+    double wdScale{1.0};
+    std::vector<size_t> indices; // positions into parameters_
+    std::vector<int64_t> offsets; // flat element offset of each parameter
+    int64_t numElements{0};
+  };
+
   std::vector<Variable> parameters_;
   double lr_;
+  // gradient accumulation span and position within it (runtime config; not
+  // serialized)
+  int64_t accumSteps_{1};
+  int64_t accumCount_{0};
+  // whether step() should use the fused multi-tensor path (runtime config;
+  // not serialized)
+  bool fusedStep_{false};
+  // per-parameter learning-rate and weight-decay multipliers expanded from
+  // setParamGroups; empty when no groups are set (runtime config; not
+  // serialized)
+  std::vector<double> paramLrScale_;
+  std::vector<double> paramWdScale_;
+  // ZeRO-style sharding: the rank owning each parameter's update and state;
+  // empty unless sharded (runtime config; not serialized)
+  bool sharded_{false};
+  int shardRank_{0};
+  std::vector<int> paramOwner_;
 
   FirstOrderOptimizer() = default;
 
+  /** The learning-rate multiplier of parameter `i`'s group. */
+  double lrScaleFor(size_t i) const {
+    return paramLrScale_.empty() ? 1.0 : paramLrScale_[i];
+  }
+
+  /** The weight-decay multiplier of parameter `i`'s group. */
+  double wdScaleFor(size_t i) const {
+    return paramWdScale_.empty() ? 1.0 : paramWdScale_[i];
+  }
+
+  // partial-step filter set by stepParams(); empty selects all parameters
+  // (runtime config; not serialized)
+  std::vector<char> stepFilter_;
+  // whether per-step counters already advanced during the current sequence
+  // of partial steps; reset by zeroGrad() and by full steps
+  bool stepCountersAdvanced_{false};
+
+  /** Whether this step updates parameter `i`; false when a partial step's
+   * filter excludes it or, if sharded, this rank does not own it. */
+  bool ownsParam(size_t i) const {
+    if (!stepFilter_.empty() && !stepFilter_[i]) {
+      return false;
+    }
+    return !sharded_ || paramOwner_[i] == shardRank_;
+  }
+
+  /**
+   * Whether a step() implementation should advance its per-step counters
+   * (e.g. Adam's bias-correction count). Always true for a full step();
+   * during a sequence of partial steps (see stepParams) only the first call
+   * returns true, so the whole sequence counts as one logical step.
+   */
+  bool advanceStepCount();
+
+  /**
+   * Reduce each parameter's gradient onto its owning rank and average it
+   * there; called at the top of step() implementations after the
+   * accumulation gate. No-op unless sharded.
+   */
+  void beginShardedStep();
+
+  /**
+   * Broadcast updated parameters back from their owning ranks; called at the
+   * end of step() implementations. No-op unless sharded.
+   */
+  void endShardedStep();
+
+  /**
+   * Release optimizer state held for parameters this rank does not own.
+   * Overridden by optimizers that support dropping sharded state.
+   */
+  virtual void releaseNonOwnedState() {}
+
+  /**
+   * Called at the top of step() implementations. While accumulating, the
+   * first `accumSteps_ - 1` calls return false without touching the
+   * optimizer state -- gradients keep folding across microbatches via
+   * `Variable::addGrad` -- and the final call averages the folded gradients
+   * in place and returns true so the (single) moment update runs.
+   */
+  bool updateGradAccumulation();
+
+  /**
+   * Group the parameters that currently have gradients by type, recording
+   * the flat element offset each parameter occupies within its group.
+   */
+  std::vector<FlatGroup> makeFlatGroups() const;
+
+  /**
+   * Flatten one tensor per parameter in the group (fetched via `get` with the
+   * parameter's index) into a single contiguous 1-D tensor, in group order.
+   */
+  Tensor flattenGroup(
+      const FlatGroup& group,
+      const std::function<const Tensor&(size_t)>& get) const;
+
+  /**
+   * Split a flat group tensor back into per-parameter tensors, invoking `set`
+   * with each parameter's index and its slice reshaped to the parameter's
+   * shape.
+   */
+  void unflattenGroup(
+      const FlatGroup& group,
+      const Tensor& flat,
+      const std::function<void(size_t, Tensor&&)>& set) const;
+
  public:
+  /**
+   * A set of parameters sharing learning-rate and weight-decay multipliers;
+   * see setParamGroups.
+   */
+  struct ParamGroup {
+    std::vector<size_t> params; // positions into the parameters vector
+    double lrMultiplier{1.0};
+    double wdMultiplier{1.0};
+  };
+
   /** The `FirstOrderOptimizer` base class constructor.
    * @param parameters The parameters from e.g. `model.parameters()`
    * @param learningRate The learning rate.
@@ -50,6 +177,19 @@ class FL_API FirstOrderOptimizer {
 
   virtual void step() = 0;
 
+  /**
+   * Run the update for only the given parameters, e.g. for the parameters of
+   * one reducer bucket as soon as its reduction completes, so the remaining
+   * buckets' communication overlaps the earlier buckets' updates (see
+   * ``CoalescingReducer::setFlushCallback``). The partial steps between two
+   * zeroGrad() calls form one logical step: per-step counters advance once,
+   * and each parameter should appear in at most one subset. Throws
+   * `std::runtime_error` when gradient accumulation or sharded optimizer
+   * state is enabled - both need the full gradient set in a single step().
+   * @param indices positions of the parameters to update.
+   */
+  void stepParams(const std::vector<size_t>& indices);
+
   /** Get the learning rate. */
   double getLr() const {
     return lr_;
@@ -60,6 +200,61 @@ class FL_API FirstOrderOptimizer {
     lr_ = lr;
   }
 
+  /** Assign parameters to groups with per-group learning-rate and
+   * weight-decay multipliers, e.g. for layer-wise learning-rate decay,
+   * without splitting the model across several optimizer instances. The
+   * multipliers scale the optimizer's base learning rate and weight decay,
+   * so schedules driven through setLr() apply to every group; parameters not
+   * named in any group keep multipliers of 1. Passing an empty vector clears
+   * all groups. Throws `std::invalid_argument` if an index is out of range or
+   * a parameter is assigned to more than one group.
+   * @param groups The parameter groups.
+   */
+  void setParamGroups(const std::vector<ParamGroup>& groups);
+
+  /** Shard the optimizer update and its state across distributed ranks (ZeRO
+   * style). Parameters are partitioned with a greedy largest-first
+   * assignment to the least-loaded rank; step() then reduces each gradient
+   * onto its owner (averaging over ranks), updates only the owned shard, and
+   * broadcasts the updated parameters back, so each rank runs roughly
+   * 1/worldSize of the update arithmetic and optimizers that support it
+   * (currently SGD and Adam) drop the moment state of parameters they do not
+   * own. The optimizer performs the gradient synchronization itself, so do
+   * not also register a distributed ``Reducer``. A no-op in single-process
+   * runs. Checkpoints written while sharded contain only this rank's state.
+   * @param shard Whether to shard across ranks; false restores replicated
+   * updates (released state is not restored).
+   */
+  void shardStateAcrossRanks(bool shard);
+
+  /** Accumulate gradients over `numMicrobatches` backward passes before
+   * applying a single optimizer update: step() folds microbatch gradients
+   * and only runs the moment updates (with the gradients averaged) on every
+   * `numMicrobatches`-th call, and zeroGrad() is a no-op mid-accumulation
+   * so the usual `step(); zeroGrad();` loop works unchanged.
+   * @param numMicrobatches The number of microbatches per effective batch;
+   * 1 (the default) disables accumulation.
+   */
+  void accumulateGrads(int64_t numMicrobatches);
+
+  /** Enable or disable the fused multi-tensor update path. When enabled,
+   * step() implementations that support it flatten the parameters, gradients
+   * and optimizer moments of a common type into single contiguous tensors --
+   * the way `CoalescingReducer` coalesces gradients for allreduce -- and run
+   * the update arithmetic with a handful of kernels per step rather than a
+   * handful per parameter, which matters when launch latency dominates over
+   * many small parameters. Optimizers without fused support ignore the flag.
+   * @param fused Whether step() should use the fused path.
+   */
+  void setFusedStep(bool fused) {
+    fusedStep_ = fused;
+  }
+
+  /** Whether the fused multi-tensor update path is enabled. */
+  bool fusedStep() const {
+    return fusedStep_;
+  }
+
   /** Zero the gradients for all the parameters being optimized. Typically
    * this will be called after every call to step().
    */
@@ -46,8 +46,12 @@ RMSPropOptimizer::RMSPropOptimizer(
 }
 
 void RMSPropOptimizer::step() {
+  if (!updateGradAccumulation()) {
+    return;
+  }
+  beginShardedStep();
   for (size_t i = 0; i < parameters_.size(); i++) {
-    if (!parameters_[i].isGradAvailable()) {
+    if (!parameters_[i].isGradAvailable() || !ownsParam(i)) {
       continue;
     }
 
@@ -56,7 +60,7 @@ void RMSPropOptimizer::step() {
 
     if (wd_ != 0) {
       // Weight decay term
-      data = data - wd_ * data;
+      data = data - wd_ * wdScaleFor(i) * data;
     }
 
     Tensor& second = second_[i];
@@ -73,10 +77,11 @@ void RMSPropOptimizer::step() {
       fl::eval(first);
     }
 
-    data = data - (lr_ * grad) / (fl::sqrt(moments) + eps_);
+    data = data - (lr_ * lrScaleFor(i) * grad) / (fl::sqrt(moments) + eps_);
 
     fl::eval(data);
   }
+  endShardedStep();
 }
 
 std::string RMSPropOptimizer::prettyString() const {
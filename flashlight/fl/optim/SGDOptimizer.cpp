@@ -36,8 +36,17 @@ SGDOptimizer::SGDOptimizer(
 }
 
 void SGDOptimizer::step() {
+  if (!updateGradAccumulation()) {
+    return;
+  }
+  beginShardedStep();
+  if (fusedStep_) {
+    stepFused();
+    endShardedStep();
+    return;
+  }
   for (size_t i = 0; i < parameters_.size(); i++) {
-    if (!parameters_[i].isGradAvailable()) {
+    if (!parameters_[i].isGradAvailable() || !ownsParam(i)) {
       continue;
     }
 
@@ -46,7 +55,7 @@ void SGDOptimizer::step() {
 
     if (wd_ != 0) {
       // Weight decay term
-      grad = grad + wd_ * data;
+      grad = grad + wd_ * wdScaleFor(i) * data;
     }
 
     if (mu_ != 0) {
@@ -62,9 +71,57 @@ void SGDOptimizer::step() {
         grad = velocity;
       }
     }
-    data = data - lr_ * grad;
+    data = data - lr_ * lrScaleFor(i) * grad;
     fl::eval(data);
   }
+  endShardedStep();
+}
+
+void SGDOptimizer::stepFused() {
+  for (const auto& group : makeFlatGroups()) {
+    Tensor grad = flattenGroup(group, [this](size_t i) -> const Tensor& {
+      return parameters_[i].grad().tensor();
+    });
+    Tensor data = flattenGroup(group, [this](size_t i) -> const Tensor& {
+      return parameters_[i].tensor();
+    });
+
+    if (wd_ != 0) {
+      // Weight decay term
+      grad = grad + wd_ * group.wdScale * data;
+    }
+
+    if (mu_ != 0) {
+      Tensor velocity = flattenGroup(
+          group, [this](size_t i) -> const Tensor& { return velocities_[i]; });
+
+      // Regular momentum
+      velocity = mu_ * velocity + grad;
+      if (useNesterov_) {
+        // Update for nesterov momentum
+        grad += velocity * mu_;
+      } else {
+        grad = velocity;
+      }
+      unflattenGroup(group, velocity, [this](size_t i, Tensor&& v) {
+        velocities_[i] = std::move(v);
+        fl::eval(velocities_[i]);
+      });
+    }
+    data = data - lr_ * group.lrScale * grad;
+    unflattenGroup(group, data, [this](size_t i, Tensor&& d) {
+      parameters_[i].tensor() = std::move(d);
+      fl::eval(parameters_[i].tensor());
+    });
+  }
+}
+
+void SGDOptimizer::releaseNonOwnedState() {
+  for (size_t i = 0; i < velocities_.size(); i++) {
+    if (!ownsParam(i)) {
+      velocities_[i] = Tensor();
+    }
+  }
 }
 
 std::string SGDOptimizer::prettyString() const {
@@ -44,6 +44,14 @@ class FL_API SGDOptimizer : public FirstOrderOptimizer {
   float wd_;
   std::vector<Tensor> velocities_;
 
+  // Fused multi-tensor update applied to per-type flattened chunks; see
+  // FirstOrderOptimizer::setFusedStep.
+  void stepFused();
+
+  // Drop velocities of parameters this rank does not own; see
+  // FirstOrderOptimizer::shardStateAcrossRanks.
+  void releaseNonOwnedState() override;
+
  public:
   /** SGDOptimizer constructor.
    * @param parameters The parameters from e.g. `model.parameters()`
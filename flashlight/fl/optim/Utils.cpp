@@ -14,15 +14,30 @@
 namespace fl {
 
 double clipGradNorm(const std::vector<Variable>& parameters, double maxNorm) {
-  double gradNorm = 0.0;
+  // Accumulate the squared norms into a single device scalar and read it
+  // back once, instead of synchronizing on every parameter's partial sum.
+  // Accumulation happens in f64 only when some gradient is f64, so backends
+  // without double support still work.
+  fl::dtype accType = fl::dtype::f32;
+  for (const auto& p : parameters) {
+    if (p.isGradAvailable() && p.grad().type() == fl::dtype::f64) {
+      accType = fl::dtype::f64;
+      break;
+    }
+  }
+  Tensor squaredNorm;
   for (const auto& p : parameters) {
     if (!p.isGradAvailable()) {
       continue;
     }
     const auto& grad = p.grad().tensor();
-    gradNorm += fl::sum(grad * grad).asScalar<double>();
+    auto partial = fl::sum(grad * grad).astype(accType);
+    squaredNorm = squaredNorm.isEmpty() ? partial : squaredNorm + partial;
+  }
+  if (squaredNorm.isEmpty()) {
+    return 0.0;
   }
-  gradNorm = std::sqrt(gradNorm);
+  const double gradNorm = std::sqrt(squaredNorm.asScalar<double>());
   double scale = maxNorm / (gradNorm + 1e-6);
   if (scale >= 1.0) {
     return gradNorm;
@@ -11,6 +11,7 @@
 #include "flashlight/fl/optim/AdadeltaOptimizer.h"
 #include "flashlight/fl/optim/AdagradOptimizer.h"
 #include "flashlight/fl/optim/AdamOptimizer.h"
+#include "flashlight/fl/optim/EMAUpdater.h"
 #include "flashlight/fl/optim/NAGOptimizer.h"
 #include "flashlight/fl/optim/NovogradOptimizer.h"
 #include "flashlight/fl/optim/Optimizers.h"
@@ -6,11 +6,70 @@
  */
 
 #include "flashlight/fl/runtime/CUDADevice.h"
+
+#include <stdexcept>
+#include <utility>
+
+#include "flashlight/fl/runtime/CUDAStream.h"
 #include "flashlight/fl/runtime/CUDAUtils.h"
+#include "flashlight/fl/runtime/DeviceManager.h"
 
 namespace fl {
 
-CUDADevice::CUDADevice(const int nativeId) : nativeId_(nativeId) {}
+namespace {
+
+// Bound the freelists so bursts of concurrent syncs or acquisitions don't
+// pin device resources indefinitely
+constexpr size_t kMaxPooledEvents = 64;
+constexpr size_t kMaxPooledStreamsPerPriority = 8;
+
+} // namespace
+
+CUDAEventPool::~CUDAEventPool() {
+#ifdef NO_CUDA_STREAM_DESTROY_EVENT
+  // Ideally we should destroy the pooled events, but there is a race hazard
+  // between pool destruction in global context and CUDA shutdown (sometimes
+  // the latter may precede the former). So we destroy them only when it's
+  // safe to do so
+#else
+  for (auto event : events_) {
+    FL_CUDA_CHECK(cudaEventDestroy(event));
+  }
+#endif
+}
+
+cudaEvent_t CUDAEventPool::acquire() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!events_.empty()) {
+      auto event = events_.back();
+      events_.pop_back();
+      return event;
+    }
+  }
+  cudaEvent_t event;
+  // events are used for relative synchronization only -- disable timing to
+  // reduce overhead
+  FL_CUDA_CHECK(
+      cudaEventCreate(&event, cudaEventDefault | cudaEventDisableTiming));
+  return event;
+}
+
+void CUDAEventPool::release(cudaEvent_t event) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (events_.size() < kMaxPooledEvents) {
+      events_.push_back(event);
+      return;
+    }
+  }
+#ifndef NO_CUDA_STREAM_DESTROY_EVENT
+  FL_CUDA_CHECK(cudaEventDestroy(event));
+#endif
+}
+
+CUDADevice::CUDADevice(const int nativeId)
+    : nativeId_(nativeId), eventPool_(std::make_shared<CUDAEventPool>()) {}
 
 int CUDADevice::nativeId() const {
   return nativeId_;
@@ -20,4 +79,61 @@ void CUDADevice::setActiveImpl() const {
   FL_CUDA_CHECK(cudaSetDevice(nativeId_));
 }
 
+const std::shared_ptr<CUDAEventPool>& CUDADevice::eventPool() const {
+  return eventPool_;
+}
+
+std::shared_ptr<CUDAStream> CUDADevice::acquireStream(
+    CUDAStreamPriority priority) {
+  {
+    std::lock_guard<std::mutex> lock(poolMutex_);
+    auto& idle = streamPool_[priority];
+    if (!idle.empty()) {
+      auto stream = std::move(idle.back());
+      idle.pop_back();
+      return stream;
+    }
+  }
+  auto& manager = DeviceManager::getInstance();
+  const auto& oldActiveDevice = manager.getActiveDevice(DeviceType::CUDA);
+  // satisfies assumptions of CUDAStream::createManagedWithPriority
+  bool needDeviceSwitch = &oldActiveDevice != this;
+  if (needDeviceSwitch) {
+    setActive();
+  }
+  // native CUDA priorities are lower-is-higher; map `High` onto the greatest
+  // priority the device supports and `Normal` onto the default (least) one
+  int leastPriority, greatestPriority;
+  FL_CUDA_CHECK(
+      cudaDeviceGetStreamPriorityRange(&leastPriority, &greatestPriority));
+  auto stream = CUDAStream::createManagedWithPriority(
+      priority == CUDAStreamPriority::High ? greatestPriority : leastPriority);
+  if (needDeviceSwitch) {
+    oldActiveDevice.setActive();
+  }
+  std::lock_guard<std::mutex> lock(poolMutex_);
+  pooledStreamClass_.emplace(stream.get(), priority);
+  return stream;
+}
+
+void CUDADevice::releaseStream(std::shared_ptr<CUDAStream> stream) {
+  if (!stream || &stream->device() != this) {
+    throw std::invalid_argument(
+        "CUDADevice::releaseStream - stream was not created on this device");
+  }
+  std::lock_guard<std::mutex> lock(poolMutex_);
+  auto iter = pooledStreamClass_.find(stream.get());
+  if (iter == pooledStreamClass_.end()) {
+    throw std::invalid_argument(
+        "CUDADevice::releaseStream - "
+        "stream was not obtained from acquireStream");
+  }
+  auto& idle = streamPool_[iter->second];
+  if (idle.size() < kMaxPooledStreamsPerPriority) {
+    idle.push_back(std::move(stream));
+  } else {
+    pooledStreamClass_.erase(iter);
+  }
+}
+
 } // namespace fl
@@ -1,4 +1,3 @@
-
 /*
  * Copyright (c) Meta Platforms, Inc. and affiliates.
  *
@@ -8,10 +7,72 @@
 
 #pragma once
 
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <cuda_runtime.h>
+
 #include "flashlight/fl/runtime/Device.h"
 
 namespace fl {
 
+class CUDAStream;
+
+/**
+ * Scheduling priority classes for pooled streams - see
+ * `CUDADevice::acquireStream`. `High` maps onto the greatest stream priority
+ * the device supports, for latency-sensitive work (reducers, prefetchers)
+ * that must preempt bulk compute.
+ */
+enum class CUDAStreamPriority { Normal = 0, High = 1 };
+
+/**
+ * A bounded freelist of timing-disabled CUDA events, so that high-frequency
+ * relative-sync points stop hitting `cudaEventCreate` in steady state. All
+ * events in a pool belong to one device; that device must be active when
+ * acquiring (in case a new event gets created).
+ *
+ * Shared (via shared_ptr) between a CUDADevice and the streams created on it
+ * so recycled events remain valid regardless of the order in which device and
+ * streams are destroyed at shutdown.
+ */
+class FL_API CUDAEventPool {
+  std::mutex mutex_;
+  std::vector<cudaEvent_t> events_;
+
+ public:
+  CUDAEventPool() = default;
+
+  /**
+   * Destroys pooled events (unless built with NO_CUDA_STREAM_DESTROY_EVENT).
+   */
+  ~CUDAEventPool();
+
+  // no copy/move -- events are owned resources handed out by raw handle
+  CUDAEventPool(const CUDAEventPool&) = delete;
+  CUDAEventPool(CUDAEventPool&&) = delete;
+  CUDAEventPool& operator=(const CUDAEventPool&) = delete;
+  CUDAEventPool& operator=(CUDAEventPool&&) = delete;
+
+  /**
+   * Take an event from the freelist, creating one only if it is empty.
+   *
+   * @return an event associated with the pool's device.
+   */
+  cudaEvent_t acquire();
+
+  /**
+   * Return an event obtained from acquire() to the freelist. Makes no CUDA
+   * call when the freelist has room, so it is safe to call from destructors
+   * racing with CUDA shutdown.
+   *
+   * @param[in] event the event to recycle.
+   */
+  void release(cudaEvent_t event);
+};
+
 /**
  * Represents a CUDA device.
  */
@@ -20,6 +81,17 @@ class FL_API CUDADevice : public DeviceTrait<CUDADevice> {
   const int nativeId_;
   // TODO metadata, e.g., memory/compute capacity
 
+  // relative-sync events recycled across the streams on this device
+  const std::shared_ptr<CUDAEventPool> eventPool_;
+  // idle pooled streams per priority class (see acquireStream), and the
+  // class each live pooled stream was created with
+  std::unordered_map<
+      CUDAStreamPriority,
+      std::vector<std::shared_ptr<CUDAStream>>>
+      streamPool_;
+  std::unordered_map<const CUDAStream*, CUDAStreamPriority> pooledStreamClass_;
+  std::mutex poolMutex_;
+
  public:
   static constexpr DeviceType type = DeviceType::CUDA;
 
@@ -41,6 +113,40 @@ class FL_API CUDADevice : public DeviceTrait<CUDADevice> {
    * Set the underlying CUDA device as active.
    */
   void setActiveImpl() const override;
+
+  /**
+   * Returns this device's relative-sync event pool; streams created on the
+   * device draw their sync events from it.
+   *
+   * @return a shared pointer to the event pool.
+   */
+  const std::shared_ptr<CUDAEventPool>& eventPool() const;
+
+  /**
+   * Acquire a stream from the bounded per-priority stream pool, creating a
+   * managed non-blocking stream at the requested scheduling priority only
+   * when the pool has no idle stream of that class. Pooled streams stay
+   * registered on the device; pass them back with releaseStream() when done
+   * so subsequent acquisitions reuse them instead of creating raw streams.
+   *
+   * @param[in] priority the scheduling priority class.
+   * @return a stream created on this device.
+   */
+  std::shared_ptr<CUDAStream> acquireStream(
+      CUDAStreamPriority priority = CUDAStreamPriority::Normal);
+
+  /**
+   * Return a stream obtained from acquireStream() to its priority pool.
+   * Beyond the pool bound the stream simply stops being recycled (it remains
+   * valid and registered). Pending work on the stream is unaffected - the
+   * next acquirer's work serializes behind it.
+   *
+   * Throws invalid_argument if the stream was not obtained from
+   * acquireStream() on this device.
+   *
+   * @param[in] stream the stream to recycle.
+   */
+  void releaseStream(std::shared_ptr<CUDAStream> stream);
 };
 
 } // namespace fl
@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "flashlight/fl/runtime/CUDAGraph.h"
+
+#include <stdexcept>
+
+#include "flashlight/fl/runtime/CUDAUtils.h"
+
+namespace fl {
+
+CUDAGraph::CUDAGraph(std::shared_ptr<CUDAStream> stream)
+    : stream_(std::move(stream)) {
+  if (!stream_) {
+    throw std::invalid_argument("CUDAGraph - stream is null");
+  }
+}
+
+CUDAGraph::~CUDAGraph() {
+  reset();
+}
+
+void CUDAGraph::beginCapture() {
+  if (capturing_ || graphExec_) {
+    throw std::runtime_error(
+        "CUDAGraph::beginCapture - "
+        "already capturing or captured; call reset() first");
+  }
+  // thread-local mode so unrelated streams/threads may keep running
+  FL_CUDA_CHECK(cudaStreamBeginCapture(
+      stream_->handle(), cudaStreamCaptureModeThreadLocal));
+  capturing_ = true;
+}
+
+void CUDAGraph::endCapture() {
+  if (!capturing_) {
+    throw std::runtime_error(
+        "CUDAGraph::endCapture - no capture in progress");
+  }
+  capturing_ = false;
+  FL_CUDA_CHECK(cudaStreamEndCapture(stream_->handle(), &graph_));
+  FL_CUDA_CHECK(cudaGraphInstantiate(
+      &graphExec_, graph_, /* pErrorNode = */ nullptr, /* pLogBuffer = */
+      nullptr, /* bufferSize = */ 0));
+}
+
+void CUDAGraph::replay() {
+  if (!graphExec_) {
+    throw std::runtime_error("CUDAGraph::replay - no captured graph");
+  }
+  FL_CUDA_CHECK(cudaGraphLaunch(graphExec_, stream_->handle()));
+}
+
+bool CUDAGraph::captured() const {
+  return graphExec_ != nullptr;
+}
+
+void CUDAGraph::reset() {
+  if (capturing_) {
+    // abort the in-flight capture; ignore the resulting invalidated graph
+    cudaGraph_t abandoned;
+    cudaStreamEndCapture(stream_->handle(), &abandoned);
+    if (abandoned) {
+      cudaGraphDestroy(abandoned);
+    }
+    capturing_ = false;
+  }
+  if (graphExec_) {
+    cudaGraphExecDestroy(graphExec_);
+    graphExec_ = nullptr;
+  }
+  if (graph_) {
+    cudaGraphDestroy(graph_);
+    graph_ = nullptr;
+  }
+}
+
+CUDAGraphStep::CUDAGraphStep(std::shared_ptr<CUDAStream> stream)
+    : graph_(std::move(stream)) {}
+
+void CUDAGraphStep::run(uint64_t key, const std::function<void()>& step) {
+  if (key != key_) {
+    // the kernel sequence changed (e.g. new input shapes) - drop the graph
+    graph_.reset();
+    warmedUp_ = false;
+    key_ = key;
+  }
+  if (graph_.captured()) {
+    graph_.replay();
+    return;
+  }
+  if (!warmedUp_) {
+    // run once uncaptured so lazy allocations and autotuning settle before
+    // the kernel sequence is recorded
+    step();
+    warmedUp_ = true;
+    return;
+  }
+  graph_.beginCapture();
+  try {
+    step();
+  } catch (...) {
+    graph_.reset();
+    throw;
+  }
+  graph_.endCapture();
+}
+
+} // namespace fl
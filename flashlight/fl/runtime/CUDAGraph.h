@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+#include "flashlight/fl/runtime/CUDAStream.h"
+
+#include <cuda_runtime.h>
+
+namespace fl {
+
+/**
+ * An abstraction for CUDA graph capture and replay on a `CUDAStream`.
+ *
+ * Work enqueued on the stream between `beginCapture` and `endCapture` is
+ * recorded into a graph instead of executing; `replay` then launches the
+ * whole recorded kernel sequence with a single call, eliminating per-kernel
+ * launch and dispatch overhead for iteration-invariant work.
+ *
+ * Replay re-executes the captured kernels on the captured device buffers:
+ * callers must keep those allocations alive and stable across replays, and
+ * write fresh inputs into the captured input buffers before each replay.
+ * Any change that alters the kernel sequence (e.g. an input shape change)
+ * requires a recapture; see `CUDAGraphStep` for a keyed wrapper handling
+ * this.
+ */
+class FL_API CUDAGraph {
+ public:
+  /**
+   * Creates a graph that captures and replays on the given stream.
+   */
+  explicit CUDAGraph(std::shared_ptr<CUDAStream> stream);
+
+  ~CUDAGraph();
+  CUDAGraph(const CUDAGraph&) = delete;
+  CUDAGraph& operator=(const CUDAGraph&) = delete;
+
+  /**
+   * Starts capturing work enqueued on the stream. Capture is thread-local:
+   * work enqueued from other threads onto the same stream is not recorded.
+   * Throws if already capturing or already captured (call `reset` first).
+   */
+  void beginCapture();
+
+  /**
+   * Ends capture and instantiates the recorded graph for replay.
+   */
+  void endCapture();
+
+  /**
+   * Launches the captured graph on the stream. Throws if no capture has
+   * completed.
+   */
+  void replay();
+
+  /**
+   * Whether a capture has completed and the graph is replayable.
+   */
+  bool captured() const;
+
+  /**
+   * Discards the captured graph, allowing a fresh capture.
+   */
+  void reset();
+
+ private:
+  std::shared_ptr<CUDAStream> stream_;
+  cudaGraph_t graph_{nullptr};
+  cudaGraphExec_t graphExec_{nullptr};
+  bool capturing_{false};
+};
+
+/**
+ * A shape-keyed capture-or-replay wrapper for steady-state steps.
+ *
+ * The first call with a given key runs `step` under capture (after one
+ * uncaptured warmup call, since backends typically lazily-allocate on the
+ * first iteration); subsequent calls with the same key replay the recorded
+ * graph without running `step`. A call with a different key - e.g. a hash
+ * of the batch's input shapes - invalidates the cached graph and
+ * recaptures.
+ */
+class FL_API CUDAGraphStep {
+ public:
+  explicit CUDAGraphStep(std::shared_ptr<CUDAStream> stream);
+
+  /**
+   * Runs or replays one step.
+   *
+   * @param[in] key identifies the kernel sequence; derive it from every
+   * property that changes the sequence (input shapes, mode flags).
+   * @param[in] step the work to capture/replay.
+   */
+  void run(uint64_t key, const std::function<void()>& step);
+
+ private:
+  CUDAGraph graph_;
+  uint64_t key_{0};
+  bool warmedUp_{false};
+};
+
+} // namespace fl
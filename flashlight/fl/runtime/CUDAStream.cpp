@@ -15,14 +15,13 @@
 namespace fl {
 
 CUDAStream::CUDAStream(CUDADevice& device, cudaStream_t stream, bool managed)
-    : device_(device), nativeStream_(stream), managed_(managed) {
-  // Ensure `event_` and `nativeStream_` are associated with the same device
+    : device_(device),
+      nativeStream_(stream),
+      managed_(managed),
+      eventPool_(device.eventPool()) {
   assert(
       &DeviceManager::getInstance().getActiveDevice(DeviceType::CUDA) ==
       &device);
-  // `event_` is used by relativeSync only -- disable timing to reduce overhead
-  FL_CUDA_CHECK(
-      cudaEventCreate(&event_, cudaEventDefault | cudaEventDisableTiming));
 }
 
 std::shared_ptr<CUDAStream> CUDAStream::makeSharedAndRegister(
@@ -51,6 +50,16 @@ std::shared_ptr<CUDAStream> CUDAStream::createUnmanaged(int flag) {
   return CUDAStream::create(flag, /* managed */ false);
 }
 
+std::shared_ptr<CUDAStream> CUDAStream::createManagedWithPriority(
+    int priority,
+    int flag) {
+  cudaStream_t nativeStream;
+  FL_CUDA_CHECK(cudaStreamCreateWithPriority(&nativeStream, flag, priority));
+  auto& manager = DeviceManager::getInstance();
+  auto& device = manager.getActiveDevice(DeviceType::CUDA).impl<CUDADevice>();
+  return makeSharedAndRegister(device, nativeStream, /* managed */ true);
+}
+
 std::shared_ptr<CUDAStream> CUDAStream::wrapUnmanaged(
     int deviceId,
     cudaStream_t stream) {
@@ -73,20 +82,14 @@ std::shared_ptr<CUDAStream> CUDAStream::wrapUnmanaged(
 CUDAStream::~CUDAStream() {
   if (managed_) {
     FL_CUDA_CHECK(cudaStreamDestroy(nativeStream_));
-    // Ideally we should unconditionally destroy the event we created, but there
-    // is a race hazard between CUDAStream destructor in global context and CUDA
-    // shutdown (sometimes the latter may precede the former). So we destroy the
-    // event only when it's safe to do so
-    FL_CUDA_CHECK(cudaEventDestroy(event_));
-  } else {
-#ifdef NO_CUDA_STREAM_DESTROY_EVENT
-    // Note that this case only results in cuda event "resource leak" if someone
-    // creates an unmanaged cuda stream. But managed cuda streams are often used
-    // in a global context and released at program shutdown (e.g., for cudnn).
-    // So chances of real resource leak is very low.
-#else
-    FL_CUDA_CHECK(cudaEventDestroy(event_));
-#endif
+  }
+  // Return the sync event (if one was ever acquired) to the device freelist.
+  // This makes no CUDA call in steady state, which sidesteps the race hazard
+  // between CUDAStream destructor in global context and CUDA shutdown
+  // (sometimes the latter may precede the former) -- the pool destroys
+  // events only when it's safe to do so
+  if (event_ != nullptr) {
+    eventPool_->release(event_);
   }
 }
 
@@ -102,18 +105,37 @@ void CUDAStream::sync() const {
   FL_CUDA_CHECK(cudaStreamSynchronize(this->nativeStream_));
 }
 
+cudaEvent_t CUDAStream::syncEvent() const {
+  if (event_ == nullptr) {
+    auto& manager = DeviceManager::getInstance();
+    const auto& oldActiveDevice = manager.getActiveDevice(DeviceType::CUDA);
+    // a freshly created event associates with the active device -- ensure it
+    // matches the device of `nativeStream_`
+    bool needDeviceSwitch = &oldActiveDevice != &device_;
+    if (needDeviceSwitch) {
+      device_.setActive();
+    }
+    event_ = eventPool_->acquire();
+    if (needDeviceSwitch) {
+      oldActiveDevice.setActive();
+    }
+  }
+  return event_;
+}
+
 void CUDAStream::relativeSync(const CUDAStream& waitOn) const {
+  // event and stream from same instance are guaranteed to have been created
+  // from the same device
+  auto event = waitOn.syncEvent();
   auto& manager = DeviceManager::getInstance();
   auto* oldActiveCUDADevice = &manager.getActiveDevice(DeviceType::CUDA);
   bool needDeviceSwitch = oldActiveCUDADevice != &device_;
   if (needDeviceSwitch) {
     device_.setActive();
   }
-  // event and stream from same instance are guaranteed to have been created
-  // from the same device
-  FL_CUDA_CHECK(cudaEventRecord(waitOn.event_, waitOn.nativeStream_));
+  FL_CUDA_CHECK(cudaEventRecord(event, waitOn.nativeStream_));
   FL_CUDA_CHECK(cudaStreamWaitEvent(
-      this->nativeStream_, waitOn.event_, /* cudaEventWaitDefault = */ 0));
+      this->nativeStream_, event, /* cudaEventWaitDefault = */ 0));
   if (needDeviceSwitch) {
     oldActiveCUDADevice->setActive();
   }
@@ -24,9 +24,14 @@ class FL_API CUDAStream : public StreamTrait<CUDAStream> {
   cudaStream_t nativeStream_;
   // whether the native stream's lifetime is managed by this object
   const bool managed_;
-  // re-used for relative synchronization to reduce overhead. Guaranteed to
-  // associate with the same device as `nativeStream_`, i.e., `device_`
-  cudaEvent_t event_;
+  // pool `event_` is drawn from; shared with `device_` so a recycled event
+  // stays valid no matter the destruction order of device and streams
+  const std::shared_ptr<CUDAEventPool> eventPool_;
+  // re-used for relative synchronization to reduce overhead; acquired lazily
+  // upon the first relativeSync against this stream (see syncEvent()).
+  // Guaranteed to associate with the same device as `nativeStream_`, i.e.,
+  // `device_`
+  mutable cudaEvent_t event_{nullptr};
 
   /**
    * A barebones constructor which just initializes the fields.
@@ -60,6 +65,15 @@ class FL_API CUDAStream : public StreamTrait<CUDAStream> {
   // A fully configurable create, hidden for internal use.
   static std::shared_ptr<CUDAStream> create(int flag, bool managed);
 
+  /**
+   * Return the event other streams record/wait on to synchronize against
+   * this stream, acquiring one from the device's event pool upon first use.
+   * Temporarily sets `device_` active if a new event must be created.
+   *
+   * @return an event associated with the same device as `nativeStream_`.
+   */
+  cudaEvent_t syncEvent() const;
+
  public:
   // prevent name hiding
   using StreamTrait<CUDAStream>::relativeSync;
@@ -106,6 +120,23 @@ class FL_API CUDAStream : public StreamTrait<CUDAStream> {
   static std::shared_ptr<CUDAStream> createUnmanaged(
       int flag = cudaStreamDefault);
 
+  /**
+   * Create a managed CUDAStream around an internally created native CUDA
+   * stream with the given native scheduling priority, and automatically
+   * register it on the active CUDA device in DeviceManager. See
+   * `CUDADevice::acquireStream` for a pooled alternative with portable
+   * priority classes.
+   *
+   * @param[in] priority the native CUDA stream priority (lower-is-higher;
+   * see cudaDeviceGetStreamPriorityRange).
+   * @param[in] flag the flag used for creating native CUDA stream.
+   *
+   * @return a shared pointer to the CUDAStream created.
+   */
+  static std::shared_ptr<CUDAStream> createManagedWithPriority(
+      int priority,
+      int flag = cudaStreamNonBlocking);
+
   /**
    * Destroy any stream managed by this object.
    */
@@ -6,12 +6,24 @@
  */
 
 #include <algorithm>
+#include <utility>
 
 #include "flashlight/fl/runtime/Device.h"
 #include "flashlight/fl/runtime/DeviceManager.h"
 
+namespace {
+
+// see fl::detail::activeX64DeviceId
+thread_local int threadActiveX64DeviceId = fl::kX64DeviceId;
+
+} // namespace
+
 namespace fl {
 
+int detail::activeX64DeviceId() {
+  return threadActiveX64DeviceId;
+}
+
 void deviceImplTypeCheck(DeviceType expect, DeviceType actual) {
   if (expect != actual) {
     std::ostringstream oss;
@@ -51,12 +63,26 @@ void Device::setActive() const {
   }
 }
 
+X64Device::X64Device(numa::NumaNode numaNode)
+    : numaNode_(std::move(numaNode)) {}
+
 int X64Device::nativeId() const {
-  return fl::kX64DeviceId;
+  return numaNode_.has_value() ? kX64NumaDeviceIdOffset + numaNode_->id
+                               : fl::kX64DeviceId;
 }
 
 void X64Device::setActiveImpl() const {
-  // no op, CPU device is always active
+  if (numaNode_.has_value()) {
+    numa::bindCallingThread(numaNode_.value());
+  } else {
+    // machine-wide device -- release any binding this thread acquired
+    numa::unbindCallingThread();
+  }
+  threadActiveX64DeviceId = nativeId();
+}
+
+const std::optional<numa::NumaNode>& X64Device::numaNode() const {
+  return numaNode_;
 }
 
 } // namespace fl
@@ -9,6 +9,7 @@
 
 #include <functional>
 #include <memory>
+#include <optional>
 #include <sstream>
 #include <stdexcept>
 #include <unordered_set>
@@ -16,6 +17,7 @@
 
 #include "flashlight/fl/common/Defines.h"
 #include "flashlight/fl/runtime/DeviceType.h"
+#include "flashlight/fl/runtime/NumaUtils.h"
 #include "flashlight/fl/runtime/Stream.h"
 
 namespace fl {
@@ -23,6 +25,17 @@ namespace fl {
 // throw invalid_argument with descriptive message if given types don't match
 FL_API void deviceImplTypeCheck(DeviceType expect, DeviceType actual);
 
+namespace detail {
+
+/**
+ * Native id of the x64 device most recently set active by the calling thread.
+ * Thread-local because CPU device binding (thread & memory affinity) is
+ * per-thread state.
+ */
+FL_API int activeX64DeviceId();
+
+} // namespace detail
+
 /**
  * An abstraction that represents framework-level (as opposed to hardware-level)
  * computing device.
@@ -147,12 +160,32 @@ class DeviceTrait : public Device {
  * A dummy to represent CPU device.
  */
 class FL_API X64Device : public DeviceTrait<X64Device> {
+  // NUMA node this device is pinned to; empty for the machine-wide device.
+  const std::optional<numa::NumaNode> numaNode_;
+
  public:
   static constexpr DeviceType type = DeviceType::x64;
 
   X64Device() = default;
+
+  /**
+   * Construct a CPU sub-device pinned to the given NUMA node. Setting it
+   * active pins the calling thread (and the worker threads it spawns
+   * afterwards) to the node's CPUs and prefers node-local allocation.
+   *
+   * @param[in] numaNode the NUMA node this device is pinned to
+   */
+  explicit X64Device(numa::NumaNode numaNode);
+
   int nativeId() const override;
   void setActiveImpl() const override;
+
+  /**
+   * Get the NUMA node this device is pinned to.
+   *
+   * @return the NUMA node, or std::nullopt for the machine-wide CPU device.
+   */
+  const std::optional<numa::NumaNode>& numaNode() const;
 };
 
 } // namespace fl
@@ -18,7 +18,7 @@ namespace {
 
 int getActiveDeviceId(const fl::DeviceType type) {
   switch (type) {
-    case fl::DeviceType::x64: return fl::kX64DeviceId;
+    case fl::DeviceType::x64: return fl::detail::activeX64DeviceId();
     case fl::DeviceType::CUDA: {
 #if FL_BACKEND_CUDA
       return fl::cuda::getActiveDeviceId();
@@ -102,4 +102,14 @@ Device& DeviceManager::getActiveDevice(const DeviceType type) const {
   return *deviceTypeToInfo_.at(type).at(activeDeviceId);
 }
 
+void DeviceManager::enableNumaPolicy() {
+  auto& x64Info = deviceTypeToInfo_.at(DeviceType::x64);
+  for (auto& node : numa::getNumaNodes()) {
+    const int id = kX64NumaDeviceIdOffset + node.id;
+    if (x64Info.count(id) == 0) {
+      x64Info.emplace(id, std::make_unique<X64Device>(std::move(node)));
+    }
+  }
+}
+
 } // namespace fl
@@ -22,6 +22,12 @@ namespace fl {
  */
 constexpr int kX64DeviceId = 0;
 
+/**
+ * Offset added to a NUMA node id to form the native id of the corresponding
+ * CPU sub-device (the machine-wide CPU device keeps `kX64DeviceId`).
+ */
+constexpr int kX64NumaDeviceIdOffset = 1;
+
 /**
  * A singleton to manage all supported types of devices.
  */
@@ -102,6 +108,18 @@ class FL_API DeviceManager {
    * @return a reference to the active device of given type.
    */
   Device& getActiveDevice(const DeviceType type) const;
+
+  /**
+   * Enables the NUMA execution policy: registers one x64 sub-device per NUMA
+   * node (with native id `kX64NumaDeviceIdOffset + nodeId`) next to the
+   * machine-wide CPU device. Setting a sub-device active pins the calling
+   * thread to the node's CPUs and prefers node-local memory allocation there,
+   * so that, e.g., one model replica can run per socket without cross-node
+   * traffic. Setting the machine-wide device active undoes the binding.
+   *
+   * Idempotent; the machine-wide device and existing streams are unaffected.
+   */
+  void enableNumaPolicy();
 };
 
 } // namespace fl
@@ -0,0 +1,173 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "flashlight/fl/runtime/NumaUtils.h"
+
+#include <algorithm>
+#include <fstream>
+#include <numeric>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+#ifdef __linux__
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#endif
+
+namespace fl {
+namespace numa {
+
+namespace {
+
+#ifdef __linux__
+
+// Mirrors the kernel memory policy ABI (include/uapi/linux/mempolicy.h);
+// `set_mempolicy` has no glibc wrapper, so we avoid a libnuma dependency by
+// invoking the syscall directly.
+constexpr int kMpolDefault = 0;
+constexpr int kMpolPreferred = 1;
+
+// Whether `bindCallingThread` bound the calling thread. Tracked so that
+// unbinding never clobbers externally applied affinity (e.g., taskset).
+thread_local bool callingThreadIsBound = false;
+
+std::string readSysFsFile(const std::string& path) {
+  std::ifstream file(path);
+  std::string line;
+  std::getline(file, line);
+  return line;
+}
+
+void setThreadAffinity(const std::vector<int>& cpus, const char* errorPrefix) {
+  cpu_set_t cpuSet;
+  CPU_ZERO(&cpuSet);
+  for (const int cpu : cpus) {
+    CPU_SET(cpu, &cpuSet);
+  }
+  if (sched_setaffinity(0, sizeof(cpu_set_t), &cpuSet) != 0) {
+    throw std::runtime_error(
+        std::string(errorPrefix) +
+        " failed to set thread affinity: " + std::strerror(errno));
+  }
+}
+
+void setMemPolicy(
+    const int mode,
+    const unsigned long* nodeMask,
+    const unsigned long maxNode,
+    const char* errorPrefix) {
+  if (syscall(SYS_set_mempolicy, mode, nodeMask, maxNode) != 0) {
+    throw std::runtime_error(
+        std::string(errorPrefix) +
+        " failed to set memory policy: " + std::strerror(errno));
+  }
+}
+
+#endif // __linux__
+
+std::vector<NumaNode> singleNodeFallback() {
+  std::vector<int> allCpus(std::max(1u, std::thread::hardware_concurrency()));
+  std::iota(allCpus.begin(), allCpus.end(), 0);
+  return {NumaNode{0, std::move(allCpus)}};
+}
+
+} // namespace
+
+std::vector<NumaNode> getNumaNodes() {
+#ifdef __linux__
+  const auto nodeIds =
+      detail::parseCpuList(readSysFsFile("/sys/devices/system/node/online"));
+  std::vector<NumaNode> nodes;
+  for (const int nodeId : nodeIds) {
+    auto cpus = detail::parseCpuList(readSysFsFile(
+        "/sys/devices/system/node/node" + std::to_string(nodeId) + "/cpulist"));
+    if (!cpus.empty()) {
+      nodes.push_back(NumaNode{nodeId, std::move(cpus)});
+    }
+  }
+  if (!nodes.empty()) {
+    return nodes;
+  }
+#endif
+  return singleNodeFallback();
+}
+
+#ifdef __linux__
+
+void bindCallingThread(const NumaNode& node) {
+  constexpr auto maxNodes = sizeof(unsigned long) * 8;
+  if (node.id < 0 || node.id >= static_cast<int>(maxNodes)) {
+    std::ostringstream oss;
+    oss << "[fl::numa::bindCallingThread] invalid NUMA node id: " << node.id;
+    throw std::invalid_argument(oss.str());
+  }
+  setThreadAffinity(node.cpus, "[fl::numa::bindCallingThread]");
+  const unsigned long nodeMask = 1UL << node.id;
+  setMemPolicy(
+      kMpolPreferred, &nodeMask, maxNodes + 1, "[fl::numa::bindCallingThread]");
+  callingThreadIsBound = true;
+}
+
+void unbindCallingThread() {
+  if (!callingThreadIsBound) {
+    return;
+  }
+  std::vector<int> allCpus;
+  for (const auto& node : getNumaNodes()) {
+    allCpus.insert(allCpus.end(), node.cpus.begin(), node.cpus.end());
+  }
+  setThreadAffinity(allCpus, "[fl::numa::unbindCallingThread]");
+  setMemPolicy(kMpolDefault, nullptr, 0, "[fl::numa::unbindCallingThread]");
+  callingThreadIsBound = false;
+}
+
+#else
+
+void bindCallingThread(const NumaNode& /* node */) {
+  // affinity control is unsupported on this platform
+}
+
+void unbindCallingThread() {}
+
+#endif // __linux__
+
+namespace detail {
+
+std::vector<int> parseCpuList(const std::string& cpuList) {
+  std::vector<int> ids;
+  std::istringstream iss(cpuList);
+  std::string token;
+  while (std::getline(iss, token, ',')) {
+    const auto dashPos = token.find('-');
+    try {
+      if (dashPos == std::string::npos) {
+        ids.push_back(std::stoi(token));
+      } else {
+        const int first = std::stoi(token.substr(0, dashPos));
+        const int last = std::stoi(token.substr(dashPos + 1));
+        for (int id = first; id <= last; id++) {
+          ids.push_back(id);
+        }
+      }
+    } catch (const std::logic_error&) {
+      std::ostringstream oss;
+      oss << "[fl::numa::detail::parseCpuList] malformed cpulist: " << cpuList;
+      throw std::invalid_argument(oss.str());
+    }
+  }
+  return ids;
+}
+
+} // namespace detail
+
+} // namespace numa
+} // namespace fl
@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "flashlight/fl/common/Defines.h"
+
+namespace fl {
+namespace numa {
+
+/**
+ * A NUMA node and the logical CPUs that belong to it.
+ */
+struct FL_API NumaNode {
+  /** Native id of the node, as reported by the OS. */
+  int id;
+  /** Logical CPUs hosted on this node. */
+  std::vector<int> cpus;
+};
+
+/**
+ * Enumerate the NUMA nodes of this machine.
+ *
+ * Falls back to a single node holding all logical CPUs when topology
+ * information is unavailable (e.g., on non-Linux platforms).
+ *
+ * @return a vector of all NUMA nodes that host at least one CPU.
+ */
+FL_API std::vector<NumaNode> getNumaNodes();
+
+/**
+ * Pin the calling thread to the CPUs of the given node and prefer node-local
+ * memory allocation on it. Worker threads spawned afterwards (e.g., the OpenMP
+ * threads backing oneDNN primitives) inherit the affinity, and first-touch
+ * allocation then places tensor data on the local node.
+ *
+ * Throws a runtime_error if the binding cannot be applied. No-op on platforms
+ * without affinity support.
+ *
+ * @param[in] node the NUMA node to bind the calling thread to.
+ */
+FL_API void bindCallingThread(const NumaNode& node);
+
+/**
+ * Undo `bindCallingThread` for the calling thread: restore machine-wide
+ * affinity and the default memory allocation policy. No-op if the calling
+ * thread was never bound.
+ */
+FL_API void unbindCallingThread();
+
+namespace detail {
+
+/**
+ * Parse a Linux cpulist string, e.g., "0-3,8,10-11", into individual ids.
+ *
+ * @return the ids denoted by the list, in order of appearance.
+ */
+FL_API std::vector<int> parseCpuList(const std::string& cpuList);
+
+} // namespace detail
+
+} // namespace numa
+} // namespace fl
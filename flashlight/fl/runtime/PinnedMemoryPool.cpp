@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "flashlight/fl/runtime/PinnedMemoryPool.h"
+
+#if FL_BACKEND_CUDA
+#include <cuda_runtime.h>
+
+#include "flashlight/fl/runtime/CUDAUtils.h"
+#endif
+
+namespace fl {
+
+namespace {
+
+constexpr size_t kMinBucketBytes = 4096;
+
+size_t roundUpToBucket(size_t bytes) {
+  size_t bucket = kMinBucketBytes;
+  while (bucket < bytes) {
+    bucket <<= 1;
+  }
+  return bucket;
+}
+
+} // namespace
+
+PinnedMemoryPool::Buffer::Buffer(
+    void* data,
+    size_t size,
+    size_t capacity,
+    PinnedMemoryPool* pool)
+    : data_(data), size_(size), capacity_(capacity), pool_(pool) {}
+
+PinnedMemoryPool::Buffer::~Buffer() {
+  if (pool_ != nullptr) {
+    pool_->release(data_, capacity_);
+  }
+}
+
+PinnedMemoryPool::Buffer::Buffer(Buffer&& other) noexcept
+    : data_(other.data_),
+      size_(other.size_),
+      capacity_(other.capacity_),
+      pool_(other.pool_) {
+  other.data_ = nullptr;
+  other.size_ = 0;
+  other.capacity_ = 0;
+  other.pool_ = nullptr;
+}
+
+PinnedMemoryPool::Buffer& PinnedMemoryPool::Buffer::operator=(
+    Buffer&& other) noexcept {
+  if (this != &other) {
+    if (pool_ != nullptr) {
+      pool_->release(data_, capacity_);
+    }
+    data_ = other.data_;
+    size_ = other.size_;
+    capacity_ = other.capacity_;
+    pool_ = other.pool_;
+    other.data_ = nullptr;
+    other.size_ = 0;
+    other.capacity_ = 0;
+    other.pool_ = nullptr;
+  }
+  return *this;
+}
+
+void* PinnedMemoryPool::Buffer::data() const {
+  return data_;
+}
+
+size_t PinnedMemoryPool::Buffer::size() const {
+  return size_;
+}
+
+PinnedMemoryPool& PinnedMemoryPool::getInstance() {
+  static PinnedMemoryPool instance;
+  return instance;
+}
+
+PinnedMemoryPool::~PinnedMemoryPool() {
+  clearCache();
+}
+
+void* PinnedMemoryPool::allocatePinned(size_t bytes) {
+#if FL_BACKEND_CUDA
+  void* data = nullptr;
+  FL_CUDA_CHECK(cudaHostAlloc(&data, bytes, cudaHostAllocDefault));
+  return data;
+#else
+  return new char[bytes];
+#endif
+}
+
+void PinnedMemoryPool::deallocatePinned(void* data) {
+#if FL_BACKEND_CUDA
+  FL_CUDA_CHECK(cudaFreeHost(data));
+#else
+  delete[] static_cast<char*>(data);
+#endif
+}
+
+PinnedMemoryPool::Buffer PinnedMemoryPool::acquire(size_t bytes) {
+  const size_t capacity = roundUpToBucket(bytes);
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto freeListIter = freeLists_.find(capacity);
+    if (freeListIter != freeLists_.end() && !freeListIter->second.empty()) {
+      void* data = freeListIter->second.back();
+      freeListIter->second.pop_back();
+      cachedBytes_ -= capacity;
+      return Buffer(data, bytes, capacity, this);
+    }
+  }
+  return Buffer(allocatePinned(capacity), bytes, capacity, this);
+}
+
+void PinnedMemoryPool::release(void* data, size_t capacity) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (cachedBytes_ + capacity <= maxCachedBytes_) {
+      freeLists_[capacity].push_back(data);
+      cachedBytes_ += capacity;
+      return;
+    }
+  }
+  deallocatePinned(data);
+}
+
+void PinnedMemoryPool::setMaxCachedBytes(size_t bytes) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  maxCachedBytes_ = bytes;
+}
+
+size_t PinnedMemoryPool::getMaxCachedBytes() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return maxCachedBytes_;
+}
+
+size_t PinnedMemoryPool::cachedBytes() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return cachedBytes_;
+}
+
+void PinnedMemoryPool::clearCache() {
+  std::map<size_t, std::vector<void*>> freeLists;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    freeLists.swap(freeLists_);
+    cachedBytes_ = 0;
+  }
+  for (auto& [capacity, buffers] : freeLists) {
+    (void)capacity;
+    for (void* data : buffers) {
+      deallocatePinned(data);
+    }
+  }
+}
+
+} // namespace fl
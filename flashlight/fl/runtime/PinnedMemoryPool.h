@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <vector>
+
+#include "flashlight/fl/common/Defines.h"
+
+namespace fl {
+
+/**
+ * A singleton pool of page-locked (pinned) host buffers, recycled across
+ * iterations the way `CachingMemoryManager` recycles device blocks. Pinned
+ * staging buffers let host<->device copies run at full interconnect bandwidth
+ * instead of going through pageable memory.
+ *
+ * Buffers are bucketed by power-of-two capacity; released buffers go back to
+ * their bucket's free list until `maxCachedBytes` is reached, after which
+ * they get freed eagerly.
+ *
+ * When CUDA is unavailable the pool degrades to regular heap allocations, so
+ * callers can use it unconditionally.
+ */
+class FL_API PinnedMemoryPool {
+ public:
+  /**
+   * An RAII handle to a pooled pinned buffer -- returns the buffer to the
+   * pool on destruction.
+   */
+  class FL_API Buffer {
+    void* data_{nullptr};
+    size_t size_{0}; // requested size
+    size_t capacity_{0}; // bucket size
+    PinnedMemoryPool* pool_{nullptr};
+
+    Buffer(void* data, size_t size, size_t capacity, PinnedMemoryPool* pool);
+
+   public:
+    Buffer() = default;
+    ~Buffer();
+    // move-only
+    Buffer(const Buffer&) = delete;
+    Buffer& operator=(const Buffer&) = delete;
+    Buffer(Buffer&& other) noexcept;
+    Buffer& operator=(Buffer&& other) noexcept;
+
+    void* data() const;
+    size_t size() const;
+
+    friend class PinnedMemoryPool;
+  };
+
+  /**
+   * Gets the singleton PinnedMemoryPool.
+   */
+  static PinnedMemoryPool& getInstance();
+
+  /**
+   * Acquire a pinned buffer of at least `bytes` bytes, reusing a cached
+   * buffer when one of matching capacity is available.
+   */
+  Buffer acquire(size_t bytes);
+
+  /**
+   * Cap on the total bytes kept on free lists; 0 disables caching.
+   */
+  void setMaxCachedBytes(size_t bytes);
+  size_t getMaxCachedBytes() const;
+
+  /**
+   * Total bytes currently held on free lists.
+   */
+  size_t cachedBytes() const;
+
+  /**
+   * Free all cached buffers.
+   */
+  void clearCache();
+
+ private:
+  PinnedMemoryPool() = default;
+  ~PinnedMemoryPool();
+  PinnedMemoryPool(const PinnedMemoryPool&) = delete;
+  PinnedMemoryPool(PinnedMemoryPool&&) = delete;
+  PinnedMemoryPool& operator=(const PinnedMemoryPool&) = delete;
+  PinnedMemoryPool& operator=(PinnedMemoryPool&&) = delete;
+
+  // called by Buffer on destruction
+  void release(void* data, size_t capacity);
+
+  static void* allocatePinned(size_t bytes);
+  static void deallocatePinned(void* data);
+
+  mutable std::mutex mutex_;
+  // bucket capacity --> free buffers of that capacity
+  std::map<size_t, std::vector<void*>> freeLists_;
+  size_t cachedBytes_{0};
+  size_t maxCachedBytes_{1UL << 30}; // 1 GiB
+};
+
+} // namespace fl
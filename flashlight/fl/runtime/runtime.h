@@ -9,4 +9,5 @@
 
 #include "flashlight/fl/runtime/Device.h"
 #include "flashlight/fl/runtime/DeviceManager.h"
+#include "flashlight/fl/runtime/NumaUtils.h"
 #include "flashlight/fl/runtime/Stream.h"
@@ -7,12 +7,76 @@
 
 #include "flashlight/fl/tensor/Random.h"
 
+#include <array>
+#include <cmath>
+#include <vector>
+
 #include "flashlight/fl/tensor/DefaultTensorType.h"
 #include "flashlight/fl/tensor/TensorBackend.h"
 #include "flashlight/fl/tensor/TensorBase.h"
 
 namespace fl {
 
+namespace {
+
+/*
+ * Philox 4x32-10 (Salmon et al., "Parallel Random Numbers: As Easy as 1, 2,
+ * 3"): a keyed bijection on a 128-bit counter. Any position in a (seed,
+ * counter) stream can be evaluated independently, so draws need no shared
+ * generator state and can be replayed exactly - the properties `philoxRand`
+ * documents. Generation runs on the host in f32; four 32-bit lanes come out
+ * of each counter block.
+ */
+
+constexpr uint32_t kPhiloxM0 = 0xD2511F53;
+constexpr uint32_t kPhiloxM1 = 0xCD9E8D57;
+constexpr uint32_t kPhiloxW0 = 0x9E3779B9;
+constexpr uint32_t kPhiloxW1 = 0xBB67AE85;
+constexpr int kPhiloxRounds = 10;
+
+std::array<uint32_t, 4>
+philox4x32(uint64_t seed, uint64_t counter, uint64_t block) {
+  std::array<uint32_t, 4> ctr = {
+      static_cast<uint32_t>(block),
+      static_cast<uint32_t>(block >> 32),
+      static_cast<uint32_t>(counter),
+      static_cast<uint32_t>(counter >> 32)};
+  uint32_t key0 = static_cast<uint32_t>(seed);
+  uint32_t key1 = static_cast<uint32_t>(seed >> 32);
+  for (int round = 0; round < kPhiloxRounds; ++round) {
+    const uint64_t product0 = static_cast<uint64_t>(kPhiloxM0) * ctr[0];
+    const uint64_t product1 = static_cast<uint64_t>(kPhiloxM1) * ctr[2];
+    ctr = {
+        static_cast<uint32_t>(product1 >> 32) ^ ctr[1] ^ key0,
+        static_cast<uint32_t>(product1),
+        static_cast<uint32_t>(product0 >> 32) ^ ctr[3] ^ key1,
+        static_cast<uint32_t>(product0)};
+    key0 += kPhiloxW0;
+    key1 += kPhiloxW1;
+  }
+  return ctr;
+}
+
+// map the high 24 bits to [0, 1) - each value is exactly representable in f32
+float toUnitFloat(uint32_t bits) {
+  return static_cast<float>(bits >> 8) * (1.0f / (1 << 24));
+}
+
+std::vector<float>
+philoxUniform(size_t numElements, uint64_t seed, uint64_t counter) {
+  std::vector<float> values(numElements);
+  const uint64_t numBlocks = (numElements + 3) / 4;
+  for (uint64_t block = 0; block < numBlocks; ++block) {
+    const auto lanes = philox4x32(seed, counter, block);
+    for (size_t lane = 0; lane < 4 && block * 4 + lane < numElements; ++lane) {
+      values[block * 4 + lane] = toUnitFloat(lanes[lane]);
+    }
+  }
+  return values;
+}
+
+} // namespace
+
 void setSeed(const int seed) {
   defaultTensorBackend().setSeed(seed);
 }
@@ -25,4 +89,37 @@ Tensor rand(const Shape& shape, dtype type) {
   return defaultTensorBackend().rand(shape, type);
 }
 
+Tensor philoxRand(
+    const Shape& shape,
+    uint64_t seed,
+    uint64_t counter,
+    dtype type /* = dtype::f32 */) {
+  auto result = Tensor::fromVector(
+      shape, philoxUniform(shape.elements(), seed, counter));
+  return type == dtype::f32 ? result : result.astype(type);
+}
+
+Tensor philoxRandn(
+    const Shape& shape,
+    uint64_t seed,
+    uint64_t counter,
+    dtype type /* = dtype::f32 */) {
+  const size_t numElements = shape.elements();
+  // Box-Muller consumes uniforms in pairs - draw an extra one if needed
+  auto uniform =
+      philoxUniform(numElements + (numElements % 2), seed, counter);
+  std::vector<float> values(numElements);
+  for (size_t i = 0; i < numElements; i += 2) {
+    // 1 - u lies in (0, 1], keeping the log finite
+    const float radius = std::sqrt(-2.0f * std::log(1.0f - uniform[i]));
+    const float theta = 2.0f * static_cast<float>(M_PI) * uniform[i + 1];
+    values[i] = radius * std::cos(theta);
+    if (i + 1 < numElements) {
+      values[i + 1] = radius * std::sin(theta);
+    }
+  }
+  auto result = Tensor::fromVector(shape, std::move(values));
+  return type == dtype::f32 ? result : result.astype(type);
+}
+
 } // namespace fl
@@ -7,6 +7,8 @@
 
 #pragma once
 
+#include <cstdint>
+
 #include "flashlight/fl/common/Defines.h"
 #include "flashlight/fl/tensor/Shape.h"
 #include "flashlight/fl/tensor/TensorBase.h"
@@ -42,4 +44,46 @@ FL_API Tensor randn(const Shape& shape, dtype type = dtype::f32);
  */
 FL_API Tensor rand(const Shape& shape, dtype type = dtype::f32);
 
+/**
+ * Initialize a tensor with elements sampled uniformly from [0, 1) using a
+ * stateless counter-based generator (Philox 4x32-10).
+ *
+ * Unlike `fl::rand`, which draws from the backend's global generator state,
+ * the result is a pure function of `(seed, counter, shape)`: callers on any
+ * thread or stream can sample without synchronizing on shared state, and a
+ * draw can be reproduced later - e.g. to regenerate a dropout mask in the
+ * backward pass - by replaying the same seed and counter. Distinct counters
+ * yield independent streams; values are generated in f32 and cast to `type`.
+ *
+ * @param[in] shape the shape of the tensor to create
+ * @param[in] seed the generator key, typically fixed for a run
+ * @param[in] counter the position in the seed's stream, typically advanced
+ * per draw
+ * @param[in] type the type of the tensor. Defaults to float
+ * @return a tensor with the given dimensions with elements sampled accordingly
+ */
+FL_API Tensor philoxRand(
+    const Shape& shape,
+    uint64_t seed,
+    uint64_t counter,
+    dtype type = dtype::f32);
+
+/**
+ * Initialize a tensor with elements sampled from the standard normal
+ * distribution using a stateless counter-based generator (Philox 4x32-10).
+ * See `philoxRand` for the (seed, counter) semantics.
+ *
+ * @param[in] shape the shape of the tensor to create
+ * @param[in] seed the generator key, typically fixed for a run
+ * @param[in] counter the position in the seed's stream, typically advanced
+ * per draw
+ * @param[in] type the type of the tensor. Defaults to float
+ * @return a tensor with the given dimensions with elements sampled accordingly
+ */
+FL_API Tensor philoxRandn(
+    const Shape& shape,
+    uint64_t seed,
+    uint64_t counter,
+    dtype type = dtype::f32);
+
 } // namespace fl
@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "flashlight/fl/tensor/Compute.h"
+#include "flashlight/fl/tensor/Index.h"
+#include "flashlight/fl/tensor/TensorBase.h"
+#include "flashlight/fl/tensor/Types.h"
+
+namespace fl {
+
+template <typename T>
+class ScalarFuture;
+
+template <typename T>
+std::vector<ScalarFuture<T>> asScalarsAsync(const std::vector<Tensor>& tensors);
+
+/**
+ * A deferred scalar read from a tensor.
+ *
+ * `Tensor::scalar` and `Tensor::asScalar` block on a device sync per call;
+ * code that reads several scalars per training step (loss, gradient norm,
+ * scale factor, overflow flags) pays one sync each. A `ScalarFuture` instead
+ * stages the read on the device and defers the host transfer until `get()`,
+ * so computation enqueued in between is not serialized against the read.
+ *
+ * Futures created together via `asScalarsAsync` share one staging tensor and
+ * resolve with a single device-to-host transfer the first time any of them is
+ * read - at most one sync per batch regardless of how many scalars it holds:
+ *
+ * \code{.cpp}
+ * auto futures = fl::asScalarsAsync<float>({loss, gradNorm, scale});
+ * // ... enqueue more device work ...
+ * float lossVal = futures[0].get(); // one sync resolves all three
+ * float normVal = futures[1].get(); // no sync
+ * \endcode
+ */
+template <typename T>
+class ScalarFuture {
+  // Staging state shared by all futures from one batch - the scalars are
+  // packed into a single device tensor and come back in one transfer.
+  struct Batch {
+    Tensor staged; // 1-D, one element per future in the batch
+    std::vector<T> values;
+    bool resolved{false};
+
+    void resolve() {
+      if (!resolved) {
+        values = staged.toHostVector<T>();
+        staged = Tensor(); // release device memory
+        resolved = true;
+      }
+    }
+  };
+
+  std::shared_ptr<Batch> batch_;
+  size_t index_;
+
+  ScalarFuture(std::shared_ptr<Batch> batch, size_t index)
+      : batch_(std::move(batch)), index_(index) {}
+
+  template <typename U>
+  friend std::vector<ScalarFuture<U>> asScalarsAsync(
+      const std::vector<Tensor>& tensors);
+
+ public:
+  /**
+   * Stage a deferred read of the first element of the given tensor, cast to
+   * `T` on the device. Doesn't block.
+   */
+  explicit ScalarFuture(const Tensor& tensor)
+      : batch_(std::make_shared<Batch>()), index_(0) {
+    if (tensor.isEmpty()) {
+      throw std::invalid_argument(
+          "ScalarFuture - cannot read a scalar from an empty tensor");
+    }
+    batch_->staged =
+        tensor.flat(fl::range(0, 1)).astype(dtype_traits<T>::fl_type);
+    fl::eval(batch_->staged);
+  }
+
+  /**
+   * Whether the value has already been transferred to the host; if so,
+   * `get()` won't block.
+   */
+  bool resolved() const {
+    return batch_->resolved;
+  }
+
+  /**
+   * The scalar value. Blocks on the device-to-host transfer the first time
+   * any future in this future's batch is read; subsequent calls are free.
+   */
+  T get() const {
+    batch_->resolve();
+    return batch_->values[index_];
+  }
+};
+
+/**
+ * Stage deferred scalar reads of the first element of each given tensor, cast
+ * to `T` on the device. The reads are packed into one staging tensor and
+ * resolve together with a single device sync on the first `get()`; this call
+ * itself doesn't block.
+ *
+ * @param[in] tensors the tensors whose first elements to read.
+ * @return one future per input tensor, in order.
+ */
+template <typename T>
+std::vector<ScalarFuture<T>> asScalarsAsync(const std::vector<Tensor>& tensors) {
+  std::vector<ScalarFuture<T>> futures;
+  if (tensors.empty()) {
+    return futures;
+  }
+  std::vector<Tensor> firsts;
+  firsts.reserve(tensors.size());
+  for (const auto& tensor : tensors) {
+    if (tensor.isEmpty()) {
+      throw std::invalid_argument(
+          "asScalarsAsync - cannot read a scalar from an empty tensor");
+    }
+    firsts.push_back(
+        tensor.flat(fl::range(0, 1)).astype(dtype_traits<T>::fl_type));
+  }
+  auto batch = std::make_shared<typename ScalarFuture<T>::Batch>();
+  batch->staged = fl::concatenate(firsts, 0);
+  fl::eval(batch->staged); // enqueue without blocking
+  futures.reserve(tensors.size());
+  for (size_t i = 0; i < tensors.size(); ++i) {
+    futures.push_back(ScalarFuture<T>(batch, i));
+  }
+  return futures;
+}
+
+/**
+ * Read the first element of each given tensor, cast to `T`, with a single
+ * device sync for the whole batch. The blocking counterpart of
+ * `asScalarsAsync`.
+ *
+ * @param[in] tensors the tensors whose first elements to read.
+ * @return one scalar per input tensor, in order.
+ */
+template <typename T>
+std::vector<T> asScalars(const std::vector<Tensor>& tensors) {
+  std::vector<T> values;
+  values.reserve(tensors.size());
+  for (const auto& future : asScalarsAsync<T>(tensors)) {
+    values.push_back(future.get());
+  }
+  return values;
+}
+
+} // namespace fl
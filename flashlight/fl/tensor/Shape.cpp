@@ -15,8 +15,9 @@
 
 namespace fl {
 
-Shape::Shape(std::vector<Dim> d) : dims_(std::move(d)) {}
-Shape::Shape(std::initializer_list<Dim> d) : Shape(std::vector<Dim>(d)) {}
+Shape::Shape(std::vector<Dim> d) : dims_(d.begin(), d.end()) {}
+Shape::Shape(DimVector d) : dims_(std::move(d)) {}
+Shape::Shape(std::initializer_list<Dim> d) : dims_(d) {}
 
 const Dim kEmptyShapeNumberOfElements = 1;
 
@@ -73,11 +74,11 @@ bool Shape::operator!=(const std::initializer_list<Dim>& other) const {
   return !(this->operator==(other));
 }
 
-const std::vector<Dim>& Shape::get() const {
+const DimVector& Shape::get() const {
   return dims_;
 }
 
-std::vector<Dim>& Shape::get() {
+DimVector& Shape::get() {
   return dims_;
 };
 
@@ -14,12 +14,21 @@
 #include <vector>
 
 #include "flashlight/fl/common/Defines.h"
+#include "flashlight/fl/common/SmallVector.h"
 
 namespace fl {
 
 // The type of a dimension.
 using Dim = long long;
 
+// Inline dimension storage capacity. Backend ranks are small (4 for
+// ArrayFire, 8 elsewhere), so shapes within this bound - in practice, all of
+// them - never touch the heap; larger shapes spill transparently.
+constexpr std::size_t kShapeInlineDims = 8;
+
+// Storage for a shape's dimension values.
+using DimVector = detail::SmallVector<Dim, kShapeInlineDims>;
+
 /**
  * An object describing the dimensions of a tensor.
  *
@@ -42,9 +51,10 @@ using Dim = long long;
  * backing storage or handles.
  */
 class FL_API Shape {
-  // Storage for the dimension values. Defaults to an empty Shape {0}, whereas
-  // {} is a scalar shape.
-  std::vector<Dim> dims_;
+  // Storage for the dimension values - inline up to kShapeInlineDims, so
+  // temporary shapes involve no heap traffic. Defaults to an empty Shape {0},
+  // whereas {} is a scalar shape.
+  DimVector dims_;
 
   /**
    * Check if a dimension is valid (i.e. in bounds) given the current size of
@@ -69,6 +79,11 @@ class FL_API Shape {
    */
   explicit Shape(std::vector<Dim> d);
 
+  /**
+   * Initialize a Shape via its dimension storage.
+   */
+  explicit Shape(DimVector d);
+
   /**
    * Initialize a Shape via an initializer list.
    */
@@ -111,10 +126,11 @@ class FL_API Shape {
   bool operator!=(const std::initializer_list<Dim>& other) const;
 
   /**
-   * Gets a reference to the underying dims vector.
+   * Gets a reference to the underlying dims storage. `DimVector` converts
+   * implicitly to `std::vector<Dim>` for consumers that need one.
    */
-  const std::vector<Dim>& get() const;
-  std::vector<Dim>& get();
+  const DimVector& get() const;
+  DimVector& get();
 
   /**
    * Returns a string representation of the Shape
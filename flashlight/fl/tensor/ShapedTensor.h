@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <array>
+#include <stdexcept>
+#include <utility>
+
+#include "flashlight/fl/tensor/Shape.h"
+#include "flashlight/fl/tensor/TensorBase.h"
+
+namespace fl {
+
+/**
+ * A thin wrapper around `Tensor` whose shape is fixed at compile time.
+ *
+ * The shape is validated once at construction; from then on the dimensions,
+ * element count and (contiguous, column-major) strides are compile-time
+ * constants, and wrapper-level operations neither re-derive shapes nor touch
+ * `Shape`'s heap-backed dimension storage. Shape agreement between operands
+ * is enforced by the type system, so mismatches in wrapped code are compile
+ * errors rather than runtime throws - e.g. `matmul` only accepts operands
+ * whose inner dimensions line up, and produces the statically-known result
+ * type.
+ *
+ * Backend dispatch below the wrapper is unchanged: kernels still run through
+ * the dynamic `Tensor` API. The wrapper removes the shape bookkeeping around
+ * hot fixed-shape call sites (e.g. batch-1 serving graphs); drop to
+ * `tensor()` for anything it doesn't cover.
+ *
+ * \code{.cpp}
+ * ShapedTensor<512, 1> x(fl::rand({512, 1}));
+ * ShapedTensor<512, 512> w(fl::rand({512, 512}));
+ * auto y = matmul(w, x); // ShapedTensor<512, 1>, checked at compile time
+ * \endcode
+ */
+template <Dim... dims>
+class ShapedTensor {
+  static_assert(sizeof...(dims) > 0, "ShapedTensor - shape must be nonempty");
+
+  // Tag for internal construction from ops whose result shape is known
+  struct SkipCheck {};
+
+  Tensor tensor_;
+
+  ShapedTensor(Tensor t, SkipCheck) : tensor_(std::move(t)) {}
+
+  template <Dim...>
+  friend class ShapedTensor;
+
+  template <Dim M, Dim K, Dim N>
+  friend ShapedTensor<M, N> matmul(
+      const ShapedTensor<M, K>& lhs,
+      const ShapedTensor<K, N>& rhs);
+
+ public:
+  static constexpr size_t kNDim = sizeof...(dims);
+  static constexpr std::array<Dim, kNDim> kDims = {dims...};
+  static constexpr Dim kElements = (dims * ...);
+  /// Contiguous column-major strides - the first dimension is innermost
+  static constexpr std::array<Dim, kNDim> kStrides = []() {
+    std::array<Dim, kNDim> strides{};
+    Dim stride = 1;
+    for (size_t i = 0; i < kNDim; ++i) {
+      strides[i] = stride;
+      stride *= kDims[i];
+    }
+    return strides;
+  }();
+
+  /**
+   * Wrap a tensor, checking once that its runtime shape matches the static
+   * dimensions.
+   */
+  explicit ShapedTensor(Tensor t) : tensor_(std::move(t)) {
+    if (tensor_.shape() != Shape({dims...})) {
+      throw std::invalid_argument(
+          "ShapedTensor - tensor shape " + tensor_.shape().toString() +
+          " doesn't match static shape " + Shape({dims...}).toString());
+    }
+  }
+
+  static constexpr size_t ndim() {
+    return kNDim;
+  }
+
+  static constexpr Dim elements() {
+    return kElements;
+  }
+
+  template <size_t index>
+  static constexpr Dim dim() {
+    static_assert(index < kNDim, "ShapedTensor::dim - index out of bounds");
+    return kDims[index];
+  }
+
+  template <size_t index>
+  static constexpr Dim stride() {
+    static_assert(index < kNDim, "ShapedTensor::stride - index out of bounds");
+    return kStrides[index];
+  }
+
+  /**
+   * The underlying dynamically-shaped tensor; use for any operation the
+   * wrapper doesn't cover.
+   */
+  const Tensor& tensor() const {
+    return tensor_;
+  }
+
+  Tensor& tensor() {
+    return tensor_;
+  }
+
+  ShapedTensor operator+(const ShapedTensor& other) const {
+    return ShapedTensor(tensor_ + other.tensor_, SkipCheck{});
+  }
+
+  ShapedTensor operator-(const ShapedTensor& other) const {
+    return ShapedTensor(tensor_ - other.tensor_, SkipCheck{});
+  }
+
+  ShapedTensor operator*(const ShapedTensor& other) const {
+    return ShapedTensor(tensor_ * other.tensor_, SkipCheck{});
+  }
+
+  ShapedTensor operator/(const ShapedTensor& other) const {
+    return ShapedTensor(tensor_ / other.tensor_, SkipCheck{});
+  }
+
+  ShapedTensor operator+(const double scalar) const {
+    return ShapedTensor(tensor_ + scalar, SkipCheck{});
+  }
+
+  ShapedTensor operator-(const double scalar) const {
+    return ShapedTensor(tensor_ - scalar, SkipCheck{});
+  }
+
+  ShapedTensor operator*(const double scalar) const {
+    return ShapedTensor(tensor_ * scalar, SkipCheck{});
+  }
+
+  ShapedTensor operator/(const double scalar) const {
+    return ShapedTensor(tensor_ / scalar, SkipCheck{});
+  }
+};
+
+/**
+ * Matrix multiply two statically-shaped matrices. The inner dimensions must
+ * agree at compile time and the result shape is statically known.
+ */
+template <Dim M, Dim K, Dim N>
+ShapedTensor<M, N> matmul(
+    const ShapedTensor<M, K>& lhs,
+    const ShapedTensor<K, N>& rhs) {
+  return ShapedTensor<M, N>(
+      fl::matmul(lhs.tensor(), rhs.tensor()),
+      typename ShapedTensor<M, N>::SkipCheck{});
+}
+
+} // namespace fl
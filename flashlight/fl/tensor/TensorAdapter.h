@@ -86,7 +86,9 @@ class FL_API TensorAdapterBase {
   virtual TensorBackend& backend() const = 0;
 
   /**
-   * Deep copy the tensor, including underlying data.
+   * Deep copy the tensor, including underlying data. The copy is not required
+   * to be eager -- the implementation can use copy-on-write, as long as a
+   * mutation of either tensor is never observable through the other.
    */
   virtual Tensor copy() = 0;
 
@@ -7,6 +7,11 @@
 
 #include "flashlight/fl/tensor/TensorBackend.h"
 
+#include <algorithm>
+#include <thread>
+
+#include "flashlight/fl/tensor/DefaultTensorType.h"
+
 namespace fl {
 namespace detail {
 
@@ -24,6 +29,56 @@ bool TensorBackend::isDataTypeSupported(const fl::dtype& dtype) const {
   return supported;
 }
 
+void TensorBackend::setIntraOpNumThreads(const int numThreads) {
+  if (numThreads < 0) {
+    throw std::invalid_argument(
+        "TensorBackend::setIntraOpNumThreads - thread count must be >= 0");
+  }
+  intraOpNumThreads_ = numThreads;
+}
+
+int TensorBackend::getIntraOpNumThreads() const {
+  return intraOpNumThreads_;
+}
+
+void TensorBackend::setInterOpNumThreads(const int numThreads) {
+  if (numThreads < 0) {
+    throw std::invalid_argument(
+        "TensorBackend::setInterOpNumThreads - thread count must be >= 0");
+  }
+  interOpNumThreads_ = numThreads;
+}
+
+int TensorBackend::getInterOpNumThreads() const {
+  return interOpNumThreads_;
+}
+
+Tensor TensorBackend::fromExternalBuffer(
+    const Shape& shape,
+    dtype type,
+    void* ptr,
+    Location memoryLocation,
+    std::function<void()> deleter) {
+  // no adoption support - copy out of the caller's buffer and release it
+  auto copy = Tensor(shape, type, ptr, memoryLocation);
+  if (deleter) {
+    deleter();
+  }
+  return copy;
+}
+
+int partitionCpuThreads(const int loaderThreads) {
+  if (loaderThreads < 0) {
+    throw std::invalid_argument(
+        "partitionCpuThreads - loaderThreads must be >= 0");
+  }
+  const int cores =
+      std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+  const int computeThreads = std::max(1, cores - loaderThreads);
+  defaultTensorBackend().setIntraOpNumThreads(computeThreads);
+  return computeThreads;
+}
+
 Tensor TensorBackend::clip(
     const Tensor& tensor,
     const Tensor& low,
@@ -49,6 +49,61 @@ class TensorBackend {
   virtual void setMemMgrLoggingEnabled(const bool enabled) = 0;
   virtual void setMemMgrFlushInterval(const size_t interval) = 0;
 
+  /* ---------------------- CPU Parallelism Controls ----------------------- */
+  /**
+   * Bounds the number of CPU threads a single operator may use (the intra-op
+   * thread team). Without a bound, backends size their thread teams to the
+   * whole machine and oversubscribe cores that data-loader threads are also
+   * using. A count of 0 restores the backend default. Backends whose thread
+   * team is not configurable record the request but run with their defaults.
+   *
+   * @param[in] numThreads the thread bound, or 0 for the backend default
+   */
+  virtual void setIntraOpNumThreads(const int numThreads);
+
+  /**
+   * Returns the configured intra-op thread bound; 0 means the backend
+   * default.
+   */
+  virtual int getIntraOpNumThreads() const;
+
+  /**
+   * Bounds how many independent operators the backend evaluates concurrently
+   * (inter-op parallelism). Semantics otherwise match
+   * `setIntraOpNumThreads`.
+   *
+   * @param[in] numThreads the thread bound, or 0 for the backend default
+   */
+  virtual void setInterOpNumThreads(const int numThreads);
+
+  /**
+   * Returns the configured inter-op thread bound; 0 means the backend
+   * default.
+   */
+  virtual int getInterOpNumThreads() const;
+
+  /* -------------------------- External Memory --------------------------- */
+  /**
+   * Creates a tensor viewing caller-owned memory without copying, when the
+   * backend can adopt the pointer. The caller keeps ownership of the buffer
+   * and must keep it valid until `deleter` runs; `deleter` is invoked once
+   * no tensor references the buffer any longer. Backends (or memory spaces)
+   * that cannot adopt external pointers fall back to copying and run
+   * `deleter` before returning.
+   *
+   * @param[in] shape the shape of the resulting tensor
+   * @param[in] type the type of the underlying data
+   * @param[in] ptr the caller-owned buffer
+   * @param[in] memoryLocation where `ptr` resides
+   * @param[in] deleter lifetime callback for the buffer; may be empty
+   */
+  virtual Tensor fromExternalBuffer(
+      const Shape& shape,
+      dtype type,
+      void* ptr,
+      Location memoryLocation,
+      std::function<void()> deleter);
+
   /* -------------------------- Rand Functions -------------------------- */
   virtual void setSeed(const int seed) = 0;
   virtual Tensor randn(const Shape& shape, dtype type) = 0;
@@ -302,8 +357,23 @@ class TensorBackend {
  protected:
   std::unordered_map<TensorExtensionType, std::unique_ptr<TensorExtensionBase>>
       extensions_;
+  // requested thread bounds; 0 means the backend default
+  int intraOpNumThreads_{0};
+  int interOpNumThreads_{0};
 };
 
+/**
+ * Partitions the machine's cores between data-loader threads and backend
+ * compute threads instead of letting the two thread teams fight over the
+ * same cores. Reserves `loaderThreads` cores for loaders (e.g.
+ * `fl::ThreadPool` prefetch workers) and applies the remainder - at least
+ * one core - as the intra-op thread bound of the default tensor backend.
+ *
+ * @param[in] loaderThreads cores to reserve for data-loading threads
+ * @return the number of cores granted to backend compute
+ */
+FL_API int partitionCpuThreads(const int loaderThreads);
+
 /**
  * Convert a Tensor from one backend to another.
  *
@@ -11,10 +11,20 @@
 #include <utility>
 #include <algorithm>
 
+#include "flashlight/fl/runtime/Device.h"
+#include "flashlight/fl/runtime/DeviceManager.h"
+#include "flashlight/fl/runtime/Stream.h"
 #include "flashlight/fl/tensor/DefaultTensorType.h"
 #include "flashlight/fl/tensor/TensorAdapter.h"
 #include "flashlight/fl/tensor/TensorBackend.h"
 
+#if FL_BACKEND_CUDA
+#include <cuda_runtime.h>
+
+#include "flashlight/fl/runtime/CUDAStream.h"
+#include "flashlight/fl/runtime/CUDAUtils.h"
+#endif
+
 #define FL_TENSOR_BACKENDS_MATCH_CHECK(...)             \
   if (!detail::areBackendsEqual(__VA_ARGS__)) {         \
     throw std::invalid_argument(                        \
@@ -67,6 +77,16 @@ Tensor::Tensor(const Shape& shape, fl::dtype type /* = fl::dtype::f32 */)
 Tensor::Tensor(fl::dtype type)
     : impl_(detail::getDefaultAdapter(Shape({0}), type)) {}
 
+Tensor Tensor::fromExternalBuffer(
+    Shape s,
+    fl::dtype t,
+    void* ptr,
+    Location memoryLocation,
+    std::function<void()> deleter) {
+  return defaultTensorBackend().fromExternalBuffer(
+      s, t, ptr, memoryLocation, std::move(deleter));
+}
+
 Tensor Tensor::copy() const {
   return impl_->copy();
 }
@@ -242,6 +262,14 @@ FL_API void Tensor::host(void* ptr) const {
 }
 #undef FL_CREATE_MEMORY_OPS
 
+PinnedMemoryPool::Buffer Tensor::hostPinned() const {
+  auto buffer = PinnedMemoryPool::getInstance().acquire(bytes());
+  if (!isEmpty()) {
+    impl_->host(buffer.data());
+  }
+  return buffer;
+}
+
 void Tensor::unlock() const {
   impl_->unlock();
 }
@@ -262,6 +290,82 @@ const Stream& Tensor::stream() const {
   return impl_->stream();
 }
 
+Tensor Tensor::toDevice(const Device& device, Stream& stream) const {
+  if (&stream.device() != &device) {
+    throw std::invalid_argument(
+        "Tensor::toDevice - given stream does not belong to the given device");
+  }
+  const Device& srcDevice = this->stream().device();
+  if (&srcDevice == &device) {
+    return copy();
+  }
+
+#if FL_BACKEND_CUDA
+  if (srcDevice.type() == DeviceType::CUDA &&
+      device.type() == DeviceType::CUDA && !isEmpty()) {
+    // Enable peer access in both directions where the topology allows it.
+    // Without it cudaMemcpyPeerAsync still works, but the driver stages the
+    // transfer through host memory instead of the peer interconnect.
+    auto enablePeerAccess = [](const Device& from, const Device& to) {
+      int canAccess = 0;
+      FL_CUDA_CHECK(
+          cudaDeviceCanAccessPeer(&canAccess, from.nativeId(), to.nativeId()));
+      if (!canAccess) {
+        return;
+      }
+      from.setActive();
+      const auto err = cudaDeviceEnablePeerAccess(to.nativeId(), 0);
+      if (err != cudaSuccess && err != cudaErrorPeerAccessAlreadyEnabled) {
+        FL_CUDA_CHECK(err);
+      }
+      cudaGetLastError(); // clear cudaErrorPeerAccessAlreadyEnabled
+    };
+    enablePeerAccess(srcDevice, device);
+    enablePeerAccess(device, srcDevice);
+
+    auto& manager = DeviceManager::getInstance();
+    const Device& previous = manager.getActiveDevice(DeviceType::CUDA);
+    device.setActive();
+    Tensor out(shape(), type());
+    previous.setActive();
+
+    // Materializing the device pointer may enqueue lazy computations on the
+    // source stream, so grab it before synchronizing: the copy must see the
+    // computations that produce this tensor.
+    void* srcPtr = this->device<void>();
+    void* dstPtr = out.device<void>();
+    const Stream& srcStream = this->stream();
+    stream.relativeSync(srcStream);
+    FL_CUDA_CHECK(cudaMemcpyPeerAsync(
+        dstPtr,
+        device.nativeId(),
+        srcPtr,
+        srcDevice.nativeId(),
+        bytes(),
+        stream.impl<CUDAStream>().handle()));
+    // The source must not be mutated before the copy has read it, and later
+    // work on the result must see the copied bytes.
+    srcStream.relativeSync(stream);
+    out.stream().relativeSync(stream);
+    // Unlocking before completion is safe: both buffers are only reused in
+    // stream order, after the events recorded by the relativeSyncs above.
+    unlock();
+    out.unlock();
+    return out;
+  }
+#endif
+
+  // No direct path between the two devices - stage through host memory.
+  std::vector<uint8_t> buffer(bytes());
+  host(buffer.data());
+  const Device& previous =
+      DeviceManager::getInstance().getActiveDevice(device.type());
+  device.setActive();
+  auto out = Tensor::fromBuffer(shape(), type(), buffer.data(), Location::Host);
+  previous.setActive();
+  return out;
+}
+
 void Tensor::setContext(void* context) {
   impl_->setContext(context);
 }
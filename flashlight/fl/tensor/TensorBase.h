@@ -16,6 +16,7 @@
 #include <utility>
 #include <vector>
 
+#include "flashlight/fl/runtime/PinnedMemoryPool.h"
 #include "flashlight/fl/tensor/Shape.h"
 #include "flashlight/fl/tensor/Types.h"
 
@@ -43,6 +44,9 @@ class Index;
 // See runtime/Stream.h
 class Stream;
 
+// See runtime/Device.h
+class Device;
+
 /// Location of memory or tensors.
 enum class Location { Host, Device };
 /// Alias to make it semantically clearer when referring to buffer location
@@ -255,6 +259,34 @@ class FL_API Tensor {
     return Tensor(s, t, ptr, memoryLocation);
   }
 
+  /**
+   * Create a tensor viewing an existing caller-owned buffer without copying,
+   * when the default backend can adopt the pointer (see
+   * `TensorBackend::fromExternalBuffer`). The caller keeps ownership of the
+   * memory and must keep it valid until `deleter` is invoked, which happens
+   * once the returned tensor (and anything sharing its buffer) no longer
+   * references it. Backends without adoption support copy and run `deleter`
+   * before returning.
+   *
+   * NOTE: with copy-on-write backends (e.g. ArrayFire), `Tensor::copy()` of
+   * the returned tensor may lazily reference the external buffer without
+   * extending its lifetime; don't free the buffer in `deleter` while such
+   * copies are outstanding.
+   *
+   * @param[in] s the shape of the resulting tensor
+   * @param[in] t the type of the underlying data
+   * @param[in] ptr the caller-owned buffer
+   * @param[in] memoryLocation where `ptr` resides
+   * @param[in] deleter lifetime callback for the buffer; may be empty
+   * @return a tensor over the given buffer
+   */
+  static Tensor fromExternalBuffer(
+      Shape s,
+      fl::dtype t,
+      void* ptr,
+      Location memoryLocation,
+      std::function<void()> deleter);
+
   /**
    * Deep-copies the tensor, including underlying data.
    */
@@ -351,6 +383,24 @@ class FL_API Tensor {
    */
   virtual const Stream& stream() const;
 
+  /**
+   * Copies this tensor to another device, with the copy enqueued on `stream`
+   * (which must belong to `device`). The copy is ordered against this
+   * tensor's producing computations and against later work on the result via
+   * `Stream::relativeSync`, so the calling thread is not blocked. Between two
+   * CUDA devices the transfer is a single `cudaMemcpyPeerAsync`, going over
+   * the peer-to-peer interconnect where the topology allows it (and staging
+   * through host memory inside the driver where it doesn't); between other
+   * device combinations the copy stages through a host buffer and
+   * synchronizes. If `device` already holds this tensor, this is equivalent
+   * to `copy()`.
+   *
+   * @param[in] device the device on which to place the copy.
+   * @param[in] stream the stream of `device` on which to enqueue the copy.
+   * @return a tensor on `device` holding a copy of this tensor's data.
+   */
+  Tensor toDevice(const Device& device, Stream& stream) const;
+
   /**
    * Returns a tensor with elements cast as a particular type
    *
@@ -454,34 +504,13 @@ class FL_API Tensor {
    */
   template <typename T>
   T asScalar() const {
-    // Implicitly cast to the requested return type
-    switch (type()) {
-      case dtype::f16:
-        return astype(dtype::f32).scalar<float>();
-      case dtype::f32:
-        return scalar<float>();
-      case dtype::f64:
-        return scalar<double>();
-      case dtype::s32:
-        return scalar<int>();
-      case dtype::u32:
-        return scalar<unsigned int>();
-      case dtype::b8:
-        return scalar<char>();
-      case dtype::u8:
-        return scalar<unsigned char>();
-      case dtype::s64:
-        return scalar<long long>();
-      case dtype::u64:
-        return scalar<unsigned long long>();
-      case dtype::s16:
-        return scalar<short>();
-      case dtype::u16:
-        return scalar<unsigned short>();
-      default:
-        throw std::invalid_argument(
-            "Tensor::asScaler - no castable type exists.");
+    if (type() == dtype::f16) {
+      return astype(dtype::f32).scalar<float>();
     }
+    // dispatch on the native element type through the compile-time table and
+    // implicitly cast to the requested return type
+    return typeDispatch(
+        type(), [this](auto tag) -> T { return scalar<decltype(tag)>(); });
   }
 
   /**
@@ -530,6 +559,17 @@ class FL_API Tensor {
   template <typename T>
   void host(T* ptr) const;
 
+  /**
+   * Copies the tensor's underlying data into a pooled page-locked (pinned)
+   * host buffer acquired from `PinnedMemoryPool`. Pinned buffers give
+   * full-bandwidth host<->device copies and get recycled across calls, so
+   * this is the preferred staging path in input pipelines.
+   *
+   * @return an RAII buffer handle holding the tensor's data on the host; the
+   * buffer returns to the pool when the handle goes out of scope.
+   */
+  PinnedMemoryPool::Buffer hostPinned() const;
+
   /**
    * Returns a vector on the host contaning a flat representation of the tensor.
    * The resulting vector is a copy of the underlying tensor memory, even if on
@@ -41,32 +41,10 @@ const std::unordered_map<std::string, dtype> kStringToType = {
 };
 
 size_t getTypeSize(dtype type) {
-  switch (type) {
-    case dtype::f16:
-      return sizeof(float) / 2;
-    case dtype::f32:
-      return sizeof(float);
-    case dtype::f64:
-      return sizeof(double);
-    case dtype::b8:
-      return sizeof(unsigned char);
-    case dtype::s16:
-      return sizeof(short);
-    case dtype::s64:
-      return sizeof(long long);
-    case dtype::s32:
-      return sizeof(int);
-    case dtype::u8:
-      return sizeof(unsigned char);
-    case dtype::u16:
-      return sizeof(unsigned short);
-    case dtype::u32:
-      return sizeof(unsigned);
-    case dtype::u64:
-      return sizeof(unsigned long long);
-    default:
-      throw std::invalid_argument("getTypeSize - invalid type queried.");
+  if (type == dtype::f16) {
+    return sizeof(float) / 2; // no native host type
   }
+  return typeDispatch(type, [](auto tag) { return sizeof(tag); });
 }
 
 const std::string& dtypeToString(dtype type) {
@@ -7,8 +7,11 @@
 
 #pragma once
 
+#include <cstddef>
 #include <ostream>
+#include <stdexcept>
 #include <string>
+#include <utility>
 
 #include "flashlight/fl/common/Defines.h"
 
@@ -83,4 +86,57 @@ FL_TYPE_TRAIT(bool, dtype::u8, dtype::u8, "bool");
 FL_TYPE_TRAIT(short, dtype::s16, dtype::s16, "short");
 FL_TYPE_TRAIT(unsigned short, dtype::u16, dtype::u16, "short");
 
+namespace detail {
+
+template <typename T, typename Fn>
+auto typeDispatchCall(Fn&& fn) -> decltype(fn(T{})) {
+  return fn(T{});
+}
+
+} // namespace detail
+
+/**
+ * Invokes `fn` with a zero value of the native type corresponding to `type`
+ * and returns the result. Dispatch goes through a table of function pointers
+ * instantiated at compile time - a single indexed call per invocation rather
+ * than a chain of runtime type branches - and the callable is specialized
+ * per type, so dtype-generic inner loops get compiled (and vectorized) for
+ * each concrete element type:
+ *
+ * \code
+ * auto bytes = fl::typeDispatch(tensor.type(), [&](auto tag) {
+ *   using T = decltype(tag); // tensor's native element type
+ *   return tensor.elements() * sizeof(T);
+ * });
+ * \endcode
+ *
+ * `f16` has no native host type and is not dispatchable; handle it before
+ * calling.
+ */
+template <typename Fn>
+auto typeDispatch(dtype type, Fn&& fn) {
+  using Ret = decltype(fn(float{}));
+  using Call = Ret (*)(Fn&&);
+  // one entry per fl::dtype enumerator, in declaration order
+  static constexpr Call kTable[] = {
+      nullptr, // f16 - no native host type
+      &detail::typeDispatchCall<float, Fn>, // f32
+      &detail::typeDispatchCall<double, Fn>, // f64
+      &detail::typeDispatchCall<char, Fn>, // b8
+      &detail::typeDispatchCall<short, Fn>, // s16
+      &detail::typeDispatchCall<int, Fn>, // s32
+      &detail::typeDispatchCall<long long, Fn>, // s64
+      &detail::typeDispatchCall<unsigned char, Fn>, // u8
+      &detail::typeDispatchCall<unsigned short, Fn>, // u16
+      &detail::typeDispatchCall<unsigned int, Fn>, // u32
+      &detail::typeDispatchCall<unsigned long long, Fn>, // u64
+  };
+  const auto idx = static_cast<size_t>(type);
+  if (idx >= sizeof(kTable) / sizeof(kTable[0]) || kTable[idx] == nullptr) {
+    throw std::invalid_argument(
+        "typeDispatch - type has no native host type to dispatch on");
+  }
+  return kTable[idx](std::forward<Fn>(fn));
+}
+
 } // namespace fl
@@ -5,6 +5,7 @@
  * LICENSE file in the root directory of this source tree.
  */
 
+#include <af/algorithm.h>
 #include <af/array.h>
 #include <af/cuda.h>
 #include <af/device.h>
@@ -78,9 +79,111 @@ __global__ void advancedIndexKernel(
   }
 }
 
+// Fused gather/scatter for index expressions where a single dimension is
+// indexed by an array and every other dimension is a full span, e.g. the
+// backward of an embedding-style lookup `emb(span, idx)`. The indices are
+// pre-sorted together with their original positions; the thread owning the
+// first element of a run of duplicates reduces the whole run and issues a
+// single write, so the scatter needs no atomics and accumulates
+// deterministically.
+template <class Float, class Index>
+__global__ void advancedIndexSegmentedKernel(
+    const Float* inp,
+    const Index* sortedIdx,
+    const unsigned* sortedPos,
+    const dim_t nIdx,
+    const dim_t innerStride,
+    const dim_t outerCount,
+    const dim_t outDim,
+    Float* out) {
+  const dim_t sliceSize = innerStride * outerCount;
+  for (dim_t tid = threadIdx.x + (dim_t)blockIdx.x * BLOCK_SIZE;
+       tid < nIdx * sliceSize;
+       tid += (dim_t)GRID_SIZE * BLOCK_SIZE) {
+    const dim_t i = tid / sliceSize;
+    if (i > 0 && sortedIdx[i] == sortedIdx[i - 1]) {
+      continue; // not the head of a run; reduced by the head's thread
+    }
+    const dim_t inner = tid % innerStride;
+    const dim_t outer = (tid % sliceSize) / innerStride;
+    Float acc = 0;
+    for (dim_t j = i; j < nIdx && sortedIdx[j] == sortedIdx[i]; ++j) {
+      acc += inp
+          [inner + (dim_t)sortedPos[j] * innerStride +
+           outer * innerStride * nIdx];
+    }
+    out[inner + (dim_t)sortedIdx[i] * innerStride +
+        outer * innerStride * outDim] += acc;
+  }
+}
+
 namespace fl {
 namespace detail {
 
+namespace {
+
+// Returns the only dimension indexed by an array if every other dimension is
+// a full span -- the patterns the fused segmented kernel handles -- else -1.
+int fusedScatterDim(
+    const af::dim4& idxStart,
+    const af::dim4& idxEnd,
+    const af::dim4& outDims,
+    const std::vector<af::array>& idxArr) {
+  int arrayDim = -1;
+  for (int i = 0; i < 4; ++i) {
+    if (!idxArr[i].isempty()) {
+      if (arrayDim >= 0) {
+        return -1;
+      }
+      arrayDim = i;
+    } else if (idxStart[i] != 0 || idxEnd[i] - idxStart[i] != outDims[i]) {
+      return -1;
+    }
+  }
+  return arrayDim;
+}
+
+template <class Index>
+void advancedIndexSegmented(
+    const af::array& inpCast,
+    af::array& outCast,
+    const af::array& idx,
+    const dim_t innerStride,
+    const dim_t outerCount,
+    const dim_t outDim) {
+  const dim_t nIdx = idx.elements();
+  af::array sortedIdx, sortedPos;
+  af::sort(sortedIdx, sortedPos, af::flat(idx), 0, /* isAscending = */ true);
+
+  const void* inpRawPtr = inpCast.device<void>();
+  void* outRawPtr = outCast.device<void>();
+  const void* idxRawPtr = sortedIdx.device<void>();
+  const void* posRawPtr = sortedPos.device<void>();
+
+  cudaStream_t stream = afcu::getStream(af::getDevice());
+  advancedIndexSegmentedKernel<float, Index>
+      <<<GRID_SIZE, BLOCK_SIZE, 0, stream>>>(
+          static_cast<const float*>(inpRawPtr),
+          static_cast<const Index*>(idxRawPtr),
+          static_cast<const unsigned*>(posRawPtr),
+          nIdx,
+          innerStride,
+          outerCount,
+          outDim,
+          static_cast<float*>(outRawPtr));
+  if (cudaPeekAtLastError() != cudaSuccess) {
+    throw std::runtime_error(
+        "ArrayFireTensor advancedIndexSegmented kernel CUDA failure");
+  }
+
+  inpCast.unlock();
+  outCast.unlock();
+  sortedIdx.unlock();
+  sortedPos.unlock();
+}
+
+} // namespace
+
 void advancedIndex(
     const af::array& inp,
     const af::dim4& idxStart,
@@ -101,15 +204,10 @@ void advancedIndex(
     throw std::invalid_argument("Index array vector must be length 4");
   }
 
-  af::dim4 idxPtr;
-  // Extract raw device pointers for dimensions
-  // that have an array as af::index variable
-
   // Dtype checking
   std::vector<af::dtype> idxTypes;
   for (int i = 0; i < 4; i++) {
     if (idxArr[i].isempty()) {
-      idxPtr[i] = 0;
       continue;
     }
     if (validIndexTypes.find(idxArr[i].type()) == validIndexTypes.end()) {
@@ -118,7 +216,6 @@ void advancedIndex(
           std::to_string(idxArr[i].type()));
     }
     idxTypes.push_back(idxArr[i].type());
-    idxPtr[i] = (dim_t)(idxArr[i].device<void>());
   }
   for (int i = 0; i + 1 < idxTypes.size(); i++) {
     if (idxTypes[i] != idxTypes[i + 1]) {
@@ -136,6 +233,55 @@ void advancedIndex(
     outCast = out.as(af::dtype::f32);
   }
 
+  // Single-pass fused path: one array-indexed dimension with every other
+  // dimension a full span scatters with a sort plus segmented reduction
+  // instead of the atomicAdd-per-element kernel below.
+  const int arrayDim = fusedScatterDim(idxStart, idxEnd, outDims, idxArr);
+  if (arrayDim >= 0) {
+    dim_t innerStride = 1;
+    dim_t outerCount = 1;
+    for (int i = 0; i < arrayDim; ++i) {
+      innerStride *= idxEnd[i] - idxStart[i];
+    }
+    for (int i = arrayDim + 1; i < 4; ++i) {
+      outerCount *= idxEnd[i] - idxStart[i];
+    }
+    const dim_t outDim = outDims[arrayDim];
+    const auto& idx = idxArr[arrayDim];
+    switch (idx.type()) {
+      case af::dtype::s32:
+        advancedIndexSegmented<int32_t>(
+            inpCast, outCast, idx, innerStride, outerCount, outDim);
+        break;
+      case af::dtype::s64:
+        advancedIndexSegmented<int64_t>(
+            inpCast, outCast, idx, innerStride, outerCount, outDim);
+        break;
+      case af::dtype::u32:
+        advancedIndexSegmented<uint32_t>(
+            inpCast, outCast, idx, innerStride, outerCount, outDim);
+        break;
+      case af::dtype::u64:
+        advancedIndexSegmented<uint64_t>(
+            inpCast, outCast, idx, innerStride, outerCount, outDim);
+        break;
+      default:
+        throw std::invalid_argument("Index type must be one of s32/s64/u32/u64");
+    }
+    out = outCast;
+    if (outType == af::dtype::f16) {
+      out = outCast.as(af::dtype::f16);
+    }
+    return;
+  }
+
+  // Extract raw device pointers for dimensions
+  // that have an array as af::index variable
+  af::dim4 idxPtr;
+  for (int i = 0; i < 4; i++) {
+    idxPtr[i] = idxArr[i].isempty() ? 0 : (dim_t)(idxArr[i].device<void>());
+  }
+
   void* inpRawPtr = inpCast.device<void>();
   void* outRawPtr = outCast.device<void>();
   af::array arrIdxPtr(4, idxPtr.get());
@@ -9,11 +9,168 @@
 
 #include <af/blas.h>
 
+#if FL_ARRAYFIRE_USE_CUDA
+  #include <optional>
+  #include <stdexcept>
+  #include <unordered_map>
+
+  #include <cublas_v2.h>
+
+  #include <af/cuda.h>
+#endif
+
 #include "flashlight/fl/tensor/backend/af/ArrayFireTensor.h"
 #include "flashlight/fl/tensor/backend/af/Utils.h"
 
 namespace fl {
 
+#if FL_ARRAYFIRE_USE_CUDA
+namespace {
+
+struct CublasHandle {
+  cublasHandle_t handle{nullptr};
+
+  CublasHandle() {
+    if (cublasCreate(&handle) != CUBLAS_STATUS_SUCCESS) {
+      throw std::runtime_error(
+          "ArrayFireBackend::matmul - failed to create cuBLAS handle");
+    }
+  }
+
+  ~CublasHandle() {
+    if (handle) {
+      cublasDestroy(handle);
+    }
+  }
+};
+
+// One handle per (thread, device): cuBLAS handles aren't thread safe and are
+// bound to the device current at creation
+cublasHandle_t getCublasHandle(int afDevice) {
+  static thread_local std::unordered_map<int, CublasHandle> handles;
+  return handles[afDevice].handle;
+}
+
+// Dispatches one cublasGemmStridedBatchedEx over all batch dims for batched
+// operands, including transposed ones: AF lowers some batched layout/transpose
+// combinations to per-batch GEMMs, which fragments e.g. the per-head attention
+// matmuls. AF arrays are column major with the batch dims outermost, which is
+// exactly the strided-batched layout, and transposes become op flags instead
+// of materialized copies. Returns an empty optional for the combinations left
+// to af::matmul: unbatched or broadcast-batched operands and types other than
+// f32/f64.
+std::optional<af::array> tryBatchedGemm(
+    const af::array& lhs,
+    const af::array& rhs,
+    MatrixProperty lhsProp,
+    MatrixProperty rhsProp) {
+  if (lhs.type() != rhs.type() ||
+      (lhs.type() != af::dtype::f32 && lhs.type() != af::dtype::f64)) {
+    return std::nullopt;
+  }
+  const af::dim4 lDims = lhs.dims();
+  const af::dim4 rDims = rhs.dims();
+  if (lDims[2] != rDims[2] || lDims[3] != rDims[3]) {
+    return std::nullopt; // broadcast over batch dims - AF tiles these
+  }
+  const long long batches =
+      static_cast<long long>(lDims[2]) * static_cast<long long>(lDims[3]);
+  if (batches <= 1) {
+    return std::nullopt; // plain GEMM - AF dispatches it directly
+  }
+  const bool transA = lhsProp == MatrixProperty::Transpose;
+  const bool transB = rhsProp == MatrixProperty::Transpose;
+  const int m = transA ? lDims[1] : lDims[0];
+  const int k = transA ? lDims[0] : lDims[1];
+  const int n = transB ? rDims[0] : rDims[1];
+  if ((transB ? rDims[1] : rDims[0]) != k) {
+    return std::nullopt; // dimension mismatch - let af::matmul report it
+  }
+
+  af::array out(af::dim4(m, n, lDims[2], lDims[3]), lhs.type());
+
+  auto handle = getCublasHandle(af::getDevice());
+  cublasSetStream(handle, afcu::getStream(af::getDevice()));
+
+  // each batch matrix is contiguous; the batch stride is one matrix
+  const long long strideA = static_cast<long long>(lDims[0]) * lDims[1];
+  const long long strideB = static_cast<long long>(rDims[0]) * rDims[1];
+  const long long strideC = static_cast<long long>(m) * n;
+  const auto opA = transA ? CUBLAS_OP_T : CUBLAS_OP_N;
+  const auto opB = transB ? CUBLAS_OP_T : CUBLAS_OP_N;
+
+  // device() evaluates pending JIT nodes and locks the buffers against the
+  // memory manager for the duration of the call; the GEMM runs on the AF
+  // stream, so it's ordered after any AF work producing the operands
+  cublasStatus_t status;
+  if (lhs.type() == af::dtype::f32) {
+    const float alpha = 1.0f;
+    const float beta = 0.0f;
+    status = cublasGemmStridedBatchedEx(
+        handle,
+        opA,
+        opB,
+        m,
+        n,
+        k,
+        &alpha,
+        lhs.device<float>(),
+        CUDA_R_32F,
+        lDims[0],
+        strideA,
+        rhs.device<float>(),
+        CUDA_R_32F,
+        rDims[0],
+        strideB,
+        &beta,
+        out.device<float>(),
+        CUDA_R_32F,
+        m,
+        strideC,
+        batches,
+        CUBLAS_COMPUTE_32F,
+        CUBLAS_GEMM_DEFAULT);
+  } else {
+    const double alpha = 1.0;
+    const double beta = 0.0;
+    status = cublasGemmStridedBatchedEx(
+        handle,
+        opA,
+        opB,
+        m,
+        n,
+        k,
+        &alpha,
+        lhs.device<double>(),
+        CUDA_R_64F,
+        lDims[0],
+        strideA,
+        rhs.device<double>(),
+        CUDA_R_64F,
+        rDims[0],
+        strideB,
+        &beta,
+        out.device<double>(),
+        CUDA_R_64F,
+        m,
+        strideC,
+        batches,
+        CUBLAS_COMPUTE_64F,
+        CUBLAS_GEMM_DEFAULT);
+  }
+  lhs.unlock();
+  rhs.unlock();
+  out.unlock();
+  if (status != CUBLAS_STATUS_SUCCESS) {
+    throw std::runtime_error(
+        "ArrayFireBackend::matmul - cuBLAS strided-batched GEMM failed");
+  }
+  return out;
+}
+
+} // namespace
+#endif // FL_ARRAYFIRE_USE_CUDA
+
 Tensor ArrayFireBackend::matmul(
     const Tensor& lhs,
     const Tensor& rhs,
@@ -45,6 +202,15 @@ Tensor ArrayFireBackend::matmul(
     }
   }
 
+#if FL_ARRAYFIRE_USE_CUDA
+  if (lhs.ndim() > 2 && rhs.ndim() > 2) {
+    auto batched = tryBatchedGemm(lhsArray, rhsArray, lhsProp, rhsProp);
+    if (batched) {
+      return toTensor<ArrayFireTensor>(std::move(*batched), numDims);
+    }
+  }
+#endif
+
   auto arr = af::matmul(
       lhsArray,
       rhsArray,
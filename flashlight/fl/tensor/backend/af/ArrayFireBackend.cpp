@@ -203,6 +203,33 @@ void ArrayFireBackend::setSeed(const int seed) {
   af::setSeed(seed);
 }
 
+Tensor ArrayFireBackend::fromExternalBuffer(
+    const Shape& shape,
+    fl::dtype type,
+    void* ptr,
+    Location memoryLocation,
+    std::function<void()> deleter) {
+  // ArrayFire can only adopt pointers in its own memory space: device
+  // pointers always, host pointers when the CPU backend is active (there
+  // device and host memory coincide)
+  const bool adoptable = memoryLocation == Location::Device ||
+      af::getActiveBackend() == AF_BACKEND_CPU;
+  if (!adoptable) {
+    return TensorBackend::fromExternalBuffer(
+        shape, type, ptr, memoryLocation, std::move(deleter));
+  }
+  auto dims = detail::flToAfDims(shape);
+  af_array handle;
+  AF_CHECK(af_device_array(
+      &handle, ptr, dims.ndims(), dims.get(), detail::flToAfType(type)));
+  af::array array(handle);
+  // the caller owns the buffer - lock it so ArrayFire's memory manager
+  // never frees or recycles it
+  array.lock();
+  return toTensor<ArrayFireTensor>(
+      std::move(array), shape.ndim(), std::move(deleter));
+}
+
 Tensor ArrayFireBackend::randn(const Shape& shape, dtype type) {
   return toTensor<ArrayFireTensor>(
       af::randn(detail::flToAfDims(shape), detail::flToAfType(type)),
@@ -72,6 +72,14 @@ class ArrayFireBackend : public TensorBackend {
   void setMemMgrLoggingEnabled(const bool enabled) override;
   void setMemMgrFlushInterval(const size_t interval) override;
 
+  /* -------------------------- External Memory -------------------------- */
+  Tensor fromExternalBuffer(
+      const Shape& shape,
+      fl::dtype type,
+      void* ptr,
+      Location memoryLocation,
+      std::function<void()> deleter) override;
+
   /* -------------------------- Rand Functions -------------------------- */
   void setSeed(const int seed) override;
   Tensor randn(const Shape& shape, dtype type) override;
@@ -44,6 +44,20 @@ ArrayFireTensor::ArrayFireTensor(af::array&& array, const unsigned numDims)
     : arrayHandle_(std::make_shared<af::array>(std::move(array))),
       numDims_(numDims) {}
 
+ArrayFireTensor::ArrayFireTensor(
+    af::array&& array,
+    const unsigned numDims,
+    std::function<void()> bufferGuard)
+    : arrayHandle_(
+          new af::array(std::move(array)),
+          [guard = std::move(bufferGuard)](af::array* arr) {
+            delete arr;
+            if (guard) {
+              guard();
+            }
+          }),
+      numDims_(numDims) {}
+
 ArrayFireTensor::ArrayFireTensor(
     std::shared_ptr<af::array> arr,
     std::vector<af::index>&& afIndices,
@@ -137,11 +151,26 @@ af::array& ArrayFireTensor::getHandle() {
   // the conversion.
   if (!std::holds_alternative<ArrayComponent>(handle_)) {
     auto& idxComp = std::get<IndexedArrayComponent>(handle_);
-    arrayHandle_ = std::make_shared<af::array>(detail::condenseIndices(
-        idxComp.get(*this),
-        /* keepDims = */ false,
-        indexTypes_,
-        /* isFlat = */ idxComp.isFlat));
+    // Seq-only patterns selecting a memory-contiguous region are lowered to
+    // one packed copy of the flattened slab rather than the generic indexing
+    // kernel, which computes a strided address per element
+    std::optional<af::array> slab;
+    if (!idxComp.isFlat) {
+      slab = detail::contiguousSlabIndex(*arrayHandle_, indices_.value());
+    }
+    if (slab) {
+      arrayHandle_ = std::make_shared<af::array>(detail::condenseIndices(
+          slab.value(),
+          /* keepDims = */ false,
+          indexTypes_,
+          /* isFlat = */ false));
+    } else {
+      arrayHandle_ = std::make_shared<af::array>(detail::condenseIndices(
+          idxComp.get(*this),
+          /* keepDims = */ false,
+          indexTypes_,
+          /* isFlat = */ idxComp.isFlat));
+    }
     // Clear state
     handle_ = ArrayComponent(); // set to passthrough
     indices_ = {}; // remove indices
@@ -156,9 +185,25 @@ std::unique_ptr<TensorAdapterBase> ArrayFireTensor::clone() const {
       std::move(arr), numDims());
 }
 
+void ArrayFireTensor::detachIfShared() {
+  int refCount = 0;
+  AF_CHECK(af_get_data_ref_count(&refCount, arrayHandle_->get()));
+  if (refCount > 1) {
+    // Replace the array in place rather than rebinding arrayHandle_ so
+    // tensors sharing the handle (shallow copies, views) observe the write.
+    *arrayHandle_ = arrayHandle_->copy();
+  }
+}
+
 Tensor ArrayFireTensor::copy() {
   getHandle(); // if this tensor was a view, run indexing and promote
-  return toTensor<ArrayFireTensor>(arrayHandle_->copy(), numDims());
+  // A copy-constructed af::array shares the underlying buffer under
+  // ArrayFire's internal refcounting. ArrayFire's assignment path deep-copies
+  // a shared buffer before writing to it, so the copy remains logically deep
+  // while costing no bandwidth until either side is mutated; writes that
+  // bypass that path detach first via detachIfShared(). Copy-then-read,
+  // which dominates in practice, never touches the data.
+  return toTensor<ArrayFireTensor>(af::array(*arrayHandle_), numDims());
 }
 
 Tensor ArrayFireTensor::shallowCopy() {
@@ -213,7 +258,11 @@ void ArrayFireTensor::scalar(void* out) {
 }
 
 void ArrayFireTensor::device(void** out) {
-  AF_CHECK(af_get_device_ptr(out, getHandle().get()));
+  getHandle(); // if this tensor was a view, run indexing and promote
+  // The caller may write through the raw pointer, which bypasses ArrayFire's
+  // copy-on-write handling of shared buffers.
+  detachIfShared();
+  AF_CHECK(af_get_device_ptr(out, arrayHandle_->get()));
 }
 
 void ArrayFireTensor::host(void* out) {
@@ -586,6 +635,9 @@ void ArrayFireTensor::inPlaceAdd(const Tensor& tensor) {
       idxFunc(af::span, i);
     }
 
+    // The kernel writes the output buffer in place, bypassing ArrayFire's
+    // copy-on-write handling of shared buffers.
+    detachIfShared();
     fl::detail::advancedIndex(
         toArray(tensor), idxStart, idxEnd, inDims, idxArr, *arrayHandle_);
   }
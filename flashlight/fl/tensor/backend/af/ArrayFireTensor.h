@@ -11,6 +11,7 @@
 #include <af/array.h>
 #include <af/statistics.h>
 
+#include <functional>
 #include <variant>
 
 #include "flashlight/fl/runtime/Stream.h"
@@ -109,6 +110,17 @@ class ArrayFireTensor : public TensorAdapterBase {
    */
   unsigned numDims_{1};
 
+  /**
+   * Deep-copies the underlying af::array in place if its buffer is shared
+   * with another array - e.g. an outstanding lazy copy from
+   * ArrayFireTensor::copy().
+   *
+   * ArrayFire's own assignment path already copies a shared buffer before
+   * writing to it; this is only needed before writes that bypass that path,
+   * namely raw device-pointer access and custom in-place kernels.
+   */
+  void detachIfShared();
+
  public:
  constexpr static TensorBackendType tensorBackendType = TensorBackendType::ArrayFire;
 
@@ -127,6 +139,17 @@ class ArrayFireTensor : public TensorAdapterBase {
    */
   explicit ArrayFireTensor(af::array&& array, const unsigned numDims);
 
+  /**
+   * Construct an ArrayFireTensor viewing caller-owned memory. `array` must
+   * have been created over (and locked on) the external pointer so
+   * ArrayFire's memory manager never frees it; `bufferGuard` runs once the
+   * last tensor sharing the handle releases it.
+   */
+  ArrayFireTensor(
+      af::array&& array,
+      const unsigned numDims,
+      std::function<void()> bufferGuard);
+
   /**
    * Default initialization - empty ArrayFire array and empty shape.
    */
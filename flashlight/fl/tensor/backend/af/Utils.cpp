@@ -7,6 +7,8 @@
 
 #include "flashlight/fl/tensor/backend/af/Utils.h"
 
+#include <af/internal.h>
+
 #include <stdexcept>
 #include <unordered_map>
 
@@ -224,6 +226,75 @@ af::array condenseIndices(
   }
 }
 
+std::optional<af::array> contiguousSlabIndex(
+    const af::array& arr,
+    const std::vector<af::index>& indices) {
+  if (indices.size() != AF_MAX_DIMS || arr.elements() == 0 ||
+      !af::isLinear(arr)) {
+    return std::nullopt;
+  }
+  const af::dim4 dims = arr.dims();
+  dim_t begin[AF_MAX_DIMS];
+  dim_t length[AF_MAX_DIMS];
+  // Decode each index into a unit-stride interval [begin, begin + length)
+  for (unsigned i = 0; i < AF_MAX_DIMS; ++i) {
+    if (indices[i].isspan()) {
+      begin[i] = 0;
+      length[i] = dims[i];
+      continue;
+    }
+    const af_index_t& index = indices[i].get();
+    if (!index.isSeq) {
+      // tensor index - arbitrary gather
+      return std::nullopt;
+    }
+    const af_seq& seq = index.idx.seq;
+    // Strided, reversed, or from-the-end sequences go through the generic
+    // kernel
+    if (seq.step != 1 || seq.begin < 0 || seq.end < seq.begin ||
+        static_cast<dim_t>(seq.end) >= dims[i]) {
+      return std::nullopt;
+    }
+    begin[i] = static_cast<dim_t>(seq.begin);
+    length[i] = static_cast<dim_t>(seq.end) - static_cast<dim_t>(seq.begin) + 1;
+  }
+
+  // With column-major storage, the region is contiguous iff every dimension
+  // below the first partially-indexed one is fully spanned and every
+  // dimension above it selects a single element
+  int partialDim = -1;
+  for (unsigned i = 0; i < AF_MAX_DIMS; ++i) {
+    if (partialDim >= 0) {
+      // past the partial dimension every index must select a single element;
+      // even a fully-spanned dimension here would make the region strided
+      if (length[i] != 1) {
+        return std::nullopt;
+      }
+      continue;
+    }
+    if (begin[i] == 0 && length[i] == dims[i]) {
+      continue; // full dimension below the partial one
+    }
+    partialDim = i;
+  }
+
+  dim_t offset = 0;
+  dim_t total = 1;
+  dim_t stride = 1;
+  for (unsigned i = 0; i < AF_MAX_DIMS; ++i) {
+    offset += begin[i] * stride;
+    total *= length[i];
+    stride *= dims[i];
+  }
+
+  // One coalesced copy of the flat region; moddims on a linear array only
+  // rewrites metadata
+  af::array flat = af::moddims(arr, af::dim4(dims.elements()));
+  af::array slab = flat(af::seq(offset, offset + total - 1));
+  return af::moddims(
+      slab, af::dim4(length[0], length[1], length[2], length[3]));
+}
+
 af_source flToAfLocation(Location location) {
   switch (location) {
     case Location::Host:
@@ -104,6 +104,20 @@ af::array condenseIndices(
     const std::optional<std::vector<detail::IndexType>>& indexTypes = {},
     const bool isFlat = false);
 
+/**
+ * If the given seq-only index pattern selects a region that is contiguous in
+ * memory (all dimensions below the partially-indexed one fully spanned with
+ * unit stride, all dimensions above it indexed to a single element),
+ * materialize it with a single packed copy of the flat region instead of the
+ * generic indexing kernel, which computes a strided address per element.
+ * Returns the materialized slab reshaped to the per-dimension index lengths,
+ * or std::nullopt if the pattern doesn't qualify (tensor indices, strided or
+ * reversed sequences, non-contiguous regions, or a non-linear source array).
+ */
+std::optional<af::array> contiguousSlabIndex(
+    const af::array& arr,
+    const std::vector<af::index>& indices);
+
 /**
  * Convert a Flashlight Location into an ArrayFire location (host or device).
  */
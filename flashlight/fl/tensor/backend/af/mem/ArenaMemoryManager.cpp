@@ -0,0 +1,279 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "flashlight/fl/tensor/backend/af/mem/ArenaMemoryManager.h"
+
+#include <atomic>
+#include <stdexcept>
+#include <string>
+
+namespace fl {
+
+namespace {
+
+// bump allocations are rounded up to this many bytes
+constexpr size_t kArenaAlignment = 512;
+
+// Managers get process-unique ids so the thread-local arena cache can't
+// confuse a new manager reusing a destroyed manager's address.
+uint64_t nextArenaManagerId() {
+  static std::atomic<uint64_t> id(1);
+  return id.fetch_add(1);
+}
+
+struct ArenaCacheEntry {
+  uint64_t ownerId{0};
+  ArenaMemoryManager::ThreadArena* arena{nullptr};
+};
+
+// Caches the calling thread's arena (or its absence) for the last manager it
+// touched, so the scoped alloc/free fast path takes no lock. Safe because an
+// arena is only created and torn down by its manager, and only its owning
+// thread inserts into the cache for it.
+thread_local ArenaCacheEntry tlsArenaCache;
+
+} // namespace
+
+ArenaMemoryManager::ArenaMemoryManager(
+    int numDevices,
+    std::shared_ptr<MemoryManagerDeviceInterface> deviceInterface,
+    size_t arenaBytes /* = kDefaultArenaBytes */)
+    : CachingMemoryManager(numDevices, deviceInterface),
+      arenaBytes_(arenaBytes),
+      id_(nextArenaManagerId()) {
+  if (arenaBytes_ == 0) {
+    throw std::invalid_argument(
+        "ArenaMemoryManager::ArenaMemoryManager - arenaBytes must be nonzero");
+  }
+}
+
+ArenaMemoryManager::ThreadArena* ArenaMemoryManager::currentThreadArena()
+    const {
+  if (tlsArenaCache.ownerId == id_) {
+    return tlsArenaCache.arena;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = arenas_.find(std::this_thread::get_id());
+  ThreadArena* arena = it == arenas_.end() ? nullptr : it->second.get();
+  tlsArenaCache = {id_, arena};
+  return arena;
+}
+
+ArenaMemoryManager::ThreadArena& ArenaMemoryManager::getOrCreateThreadArena() {
+  if (ThreadArena* arena = currentThreadArena()) {
+    return *arena;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto& arena = arenas_[std::this_thread::get_id()];
+  if (!arena) {
+    arena = std::make_unique<ThreadArena>();
+  }
+  tlsArenaCache = {id_, arena.get()};
+  return *arena;
+}
+
+bool ArenaMemoryManager::ownedByAnyArena(const void* ptr) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (const auto& entry : arenas_) {
+    if (entry.second->owns(ptr)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void ArenaMemoryManager::beginScope() {
+  auto& arena = getOrCreateThreadArena();
+  arena.scopeOffsets_.push_back(arena.offset_);
+}
+
+void ArenaMemoryManager::endScope() {
+  ThreadArena* arena = currentThreadArena();
+  if (!arena || arena->scopeOffsets_.empty()) {
+    throw std::runtime_error(
+        "ArenaMemoryManager::endScope - no open scope on this thread");
+  }
+  const size_t scopeStart = arena->scopeOffsets_.back();
+  // Scoped lifetimes are perfectly nested by contract: everything allocated
+  // since the matching beginScope must be dead before the scope closes. Fail
+  // loudly otherwise, since rewinding would hand live memory to later
+  // allocations; the scope stays open so the caller can release and retry.
+  size_t liveInScope = 0;
+  for (const auto& entry : arena->live_) {
+    const size_t offset = static_cast<const char*>(entry.first) -
+        static_cast<const char*>(arena->base_);
+    if (offset >= scopeStart) {
+      ++liveInScope;
+    }
+  }
+  if (liveInScope > 0) {
+    throw std::runtime_error(
+        "ArenaMemoryManager::endScope - " + std::to_string(liveInScope) +
+        " allocation(s) from the ending scope are still live; evaluate and "
+        "release scoped tensors before closing the scope");
+  }
+  arena->scopeOffsets_.pop_back();
+  arena->offset_ = scopeStart;
+}
+
+size_t ArenaMemoryManager::arenaBytesUsed() const {
+  ThreadArena* arena = currentThreadArena();
+  return arena ? arena->offset_ : 0;
+}
+
+void* ArenaMemoryManager::alloc(
+    bool userLock,
+    const unsigned ndims,
+    dim_t* dims,
+    const unsigned elSize) {
+  ThreadArena* arena = currentThreadArena();
+  // Bump-allocate only inside a scope; user-locked allocations are long-lived
+  // by contract and go to the caching manager with everything else.
+  if (!arena || arena->scopeOffsets_.empty() || userLock) {
+    return CachingMemoryManager::alloc(userLock, ndims, dims, elSize);
+  }
+  size_t size = elSize;
+  for (unsigned i = 0; i < ndims; ++i) {
+    size *= dims[i];
+  }
+  if (size == 0) {
+    return nullptr;
+  }
+  size = kArenaAlignment * ((size + kArenaAlignment - 1) / kArenaAlignment);
+  if (!arena->base_) {
+    // the arena's device buffer is allocated lazily so threads that never
+    // open a scope cost nothing
+    arena->base_ = deviceInterface->nativeAlloc(arenaBytes_); // could throw
+    arena->capacity_ = arenaBytes_;
+  }
+  if (arena->offset_ + size > arena->capacity_) {
+    // exhausted or oversized: fall back rather than fail the request
+    return CachingMemoryManager::alloc(userLock, ndims, dims, elSize);
+  }
+  void* ptr = static_cast<char*>(arena->base_) + arena->offset_;
+  arena->offset_ += size;
+  arena->live_.emplace(ptr, Slot(size, userLock));
+  return ptr;
+}
+
+size_t ArenaMemoryManager::allocated(void* ptr) {
+  if (!ptr) {
+    return 0;
+  }
+  if (ThreadArena* arena = currentThreadArena()) {
+    if (arena->owns(ptr)) {
+      auto it = arena->live_.find(ptr);
+      return it == arena->live_.end() ? 0 : it->second.size_;
+    }
+  }
+  if (ownedByAnyArena(ptr)) {
+    // another thread's arena; its bookkeeping can't be read safely from here
+    return 0;
+  }
+  return CachingMemoryManager::allocated(ptr);
+}
+
+void ArenaMemoryManager::unlock(void* ptr, bool userUnlock) {
+  if (!ptr) {
+    return;
+  }
+  if (ThreadArena* arena = currentThreadArena()) {
+    if (arena->owns(ptr)) {
+      auto it = arena->live_.find(ptr);
+      if (it == arena->live_.end()) {
+        return;
+      }
+      if (userUnlock) {
+        it->second.userLock_ = false;
+      } else {
+        it->second.managerLock_ = false;
+      }
+      if (!it->second.inUse()) {
+        // the bytes themselves are reclaimed wholesale at endScope
+        arena->live_.erase(it);
+      }
+      return;
+    }
+  }
+  if (ownedByAnyArena(ptr)) {
+    throw std::runtime_error(
+        "ArenaMemoryManager::unlock - scoped memory released on a different "
+        "thread than its scope; scoped allocations are thread-confined");
+  }
+  CachingMemoryManager::unlock(ptr, userUnlock);
+}
+
+void ArenaMemoryManager::userLock(const void* ptr) {
+  if (ThreadArena* arena = currentThreadArena()) {
+    if (arena->owns(ptr)) {
+      auto it = arena->live_.find(const_cast<void*>(ptr));
+      if (it != arena->live_.end()) {
+        it->second.userLock_ = true;
+      }
+      return;
+    }
+  }
+  CachingMemoryManager::userLock(ptr);
+}
+
+void ArenaMemoryManager::userUnlock(const void* ptr) {
+  if (ThreadArena* arena = currentThreadArena()) {
+    if (arena->owns(ptr)) {
+      auto it = arena->live_.find(const_cast<void*>(ptr));
+      if (it != arena->live_.end()) {
+        it->second.userLock_ = false;
+        if (!it->second.inUse()) {
+          arena->live_.erase(it);
+        }
+      }
+      return;
+    }
+  }
+  CachingMemoryManager::userUnlock(ptr);
+}
+
+bool ArenaMemoryManager::isUserLocked(const void* ptr) {
+  if (ThreadArena* arena = currentThreadArena()) {
+    if (arena->owns(ptr)) {
+      auto it = arena->live_.find(const_cast<void*>(ptr));
+      return it != arena->live_.end() && it->second.userLock_;
+    }
+  }
+  return CachingMemoryManager::isUserLocked(ptr);
+}
+
+void ArenaMemoryManager::shutdown() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& entry : arenas_) {
+      if (entry.second->base_) {
+        deviceInterface->nativeFree(entry.second->base_);
+      }
+    }
+    arenas_.clear();
+  }
+  CachingMemoryManager::shutdown();
+}
+
+void ArenaMemoryManager::printInfo(
+    const char* msg,
+    const int device,
+    std::ostream* ostream /* = &std::cout */) {
+  CachingMemoryManager::printInfo(msg, device, ostream);
+  std::lock_guard<std::mutex> lock(mutex_);
+  size_t capacity = 0;
+  size_t used = 0;
+  for (const auto& entry : arenas_) {
+    // foreign offsets are read unsynchronized; this is diagnostic output
+    capacity += entry.second->capacity_;
+    used += entry.second->offset_;
+  }
+  *ostream << "Arenas: " << arenas_.size() << " thread(s), " << used << " / "
+           << capacity << " bytes in use" << std::endl;
+}
+
+} // namespace fl
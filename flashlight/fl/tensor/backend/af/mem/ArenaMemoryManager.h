@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "flashlight/fl/tensor/backend/af/mem/CachingMemoryManager.h"
+
+namespace fl {
+
+/**
+ * A memory manager for request-scoped inference workloads.
+ *
+ * Serving a request allocates tensors whose lifetimes are perfectly nested
+ * inside the request: everything allocated while computing a response is dead
+ * by the time the response is returned. This manager exploits that shape.
+ * Each thread owns a fixed-capacity device arena; inside a scope (opened with
+ * `beginScope` and closed with `endScope`), allocations are bump-pointer
+ * increments on the owning thread's arena and take no lock, and `endScope`
+ * reclaims the whole scope by rewinding the bump pointer. Scopes nest -
+ * `endScope` rewinds to where the matching `beginScope` left off.
+ *
+ * Everything else - allocations made outside a scope (model weights and other
+ * long-lived tensors), user-locked allocations, and scoped allocations that
+ * don't fit the arena's remaining capacity - falls back to the inherited
+ * `CachingMemoryManager` behavior.
+ *
+ * Scoped allocations are thread-confined: memory bump-allocated from a
+ * thread's arena must be released on that thread before its scope ends.
+ * `endScope` throws if allocations from the ending scope are still live, so
+ * lifetime violations fail loudly instead of corrupting reused memory;
+ * callers should evaluate and release any lazily-computed results before
+ * closing a scope.
+ */
+class ArenaMemoryManager : public CachingMemoryManager {
+ public:
+  static constexpr size_t kDefaultArenaBytes = (1UL << 27); // 128 MiB
+
+  /**
+   * Creates an ArenaMemoryManager.
+   *
+   * @param[in] numDevices number of devices, forwarded to the caching manager
+   * used for non-scoped allocations.
+   * @param[in] deviceInterface a pointer to a `MemoryManagerDeviceInterface`.
+   * Function pointers on the interface will be defined once the memory manager
+   * is installed.
+   * @param[in] arenaBytes the fixed capacity of each per-thread arena. The
+   * arena's device buffer is allocated lazily on its thread's first scoped
+   * allocation.
+   */
+  ArenaMemoryManager(
+      int numDevices,
+      std::shared_ptr<MemoryManagerDeviceInterface> deviceInterface,
+      size_t arenaBytes = kDefaultArenaBytes);
+  ~ArenaMemoryManager() override = default;
+
+  /**
+   * Opens a request scope on the calling thread. Subsequent allocations on
+   * this thread are bump-allocated from the thread's arena until the matching
+   * `endScope`.
+   */
+  void beginScope();
+
+  /**
+   * Closes the calling thread's innermost scope, rewinding the arena to where
+   * the matching `beginScope` left off. Throws `std::runtime_error` if no
+   * scope is open or if allocations made in the ending scope are still live.
+   */
+  void endScope();
+
+  /**
+   * Returns the number of arena bytes in use on the calling thread (0 when
+   * the thread has no arena).
+   */
+  size_t arenaBytesUsed() const;
+
+  void* alloc(
+      bool userLock,
+      const unsigned ndims,
+      dim_t* dims,
+      const unsigned elSize) override;
+  size_t allocated(void* ptr) override;
+  void unlock(void* ptr, bool userLock) override;
+  void userLock(const void* ptr) override;
+  void userUnlock(const void* ptr) override;
+  bool isUserLocked(const void* ptr) override;
+  void shutdown() override;
+  void printInfo(
+      const char* msg,
+      const int device,
+      std::ostream* ostream = &std::cout) override;
+
+  // A bump-allocated unit of arena memory; mirrors the lock flags on
+  // `CachingMemoryManager::Block` so AF's lock semantics hold for arena
+  // pointers too.
+  struct Slot {
+    size_t size_;
+    bool managerLock_;
+    bool userLock_;
+
+    bool inUse() const {
+      return managerLock_ || userLock_;
+    }
+
+    explicit Slot(size_t size, bool userLock)
+        : size_(size), managerLock_(!userLock), userLock_(userLock) {}
+  };
+
+  // Per-thread arena state. Only the owning thread touches an arena (the
+  // fast path takes no lock); `mutex_` guards the map of arenas itself.
+  struct ThreadArena {
+    void* base_{nullptr};
+    size_t capacity_{0};
+    size_t offset_{0};
+    // bump-pointer positions saved by nested `beginScope` calls
+    std::vector<size_t> scopeOffsets_;
+    // live bump allocations by pointer
+    std::unordered_map<void*, Slot> live_;
+
+    bool owns(const void* ptr) const {
+      return base_ && ptr >= base_ &&
+          ptr < static_cast<const char*>(base_) + capacity_;
+    }
+  };
+
+ private:
+  ArenaMemoryManager(const ArenaMemoryManager& other) = delete;
+  ArenaMemoryManager(ArenaMemoryManager&& other) = delete;
+  ArenaMemoryManager& operator=(const ArenaMemoryManager& other) = delete;
+  ArenaMemoryManager& operator=(ArenaMemoryManager&& other) = delete;
+
+  // Returns the calling thread's arena, or nullptr if the thread never opened
+  // a scope. Cached thread-locally so the fast path skips the map lookup.
+  ThreadArena* currentThreadArena() const;
+  // Returns the calling thread's arena, creating it on first use.
+  ThreadArena& getOrCreateThreadArena();
+  // Whether `ptr` belongs to any thread's arena. Used on the fallback free
+  // path to catch scoped memory released off its owning thread.
+  bool ownedByAnyArena(const void* ptr) const;
+
+  const size_t arenaBytes_;
+  // process-unique manager id backing the thread-local arena cache
+  const uint64_t id_;
+  // guards arenas_; arena contents are thread-confined and not locked
+  mutable std::mutex mutex_;
+  std::unordered_map<std::thread::id, std::unique_ptr<ThreadArena>> arenas_;
+};
+
+} // namespace fl
@@ -11,6 +11,7 @@
 #include <cmath>
 #include <iostream>
 #include <limits>
+#include <map>
 #include <memory>
 #include <mutex>
 #include <numeric>
@@ -18,6 +19,13 @@
 #include <string>
 #include <vector>
 
+#include "flashlight/fl/runtime/Stream.h"
+
+#if FL_BACKEND_CUDA
+#include "flashlight/fl/runtime/CUDAStream.h"
+#include "flashlight/fl/runtime/CUDAUtils.h"
+#endif
+
 namespace fl {
 
 namespace {
@@ -36,6 +44,8 @@ constexpr size_t kRoundLarge = 2097152; // round up large allocs to 2 MiB
 // Environment variables names, specifying number of mega bytes as floats.
 constexpr const char* kMemRecyclingSize = "FL_MEM_RECYCLING_SIZE_MB";
 constexpr const char* kMemSplitSize = "FL_MEM_SPLIT_SIZE_MB";
+// Environment variable specifying size-class rounding divisions (unsigned).
+constexpr const char* kMemPower2Divisions = "FL_MEM_POW2_ROUNDING_DIVISIONS";
 constexpr double kMB = static_cast<double>(1UL << 20);
 
 size_t roundSize(size_t size) {
@@ -46,6 +56,21 @@ size_t roundSize(size_t size) {
   }
 }
 
+// Round up to the next size class -- each [2^n, 2^(n+1)) interval is split
+// into `divisions` classes, so variable-size workloads funnel into a bounded
+// set of block sizes instead of fragmenting the pool.
+size_t roundSizeClass(size_t size, unsigned divisions) {
+  size_t power = kMinBlockSize;
+  while (power * 2 <= size) {
+    power *= 2;
+  }
+  if (power == size) {
+    return size;
+  }
+  const size_t step = std::max(power / divisions, kMinBlockSize);
+  return ((size + step - 1) / step) * step;
+}
+
 size_t getAllocationSize(size_t size) {
   if (size <= kSmallSize) {
     return kSmallBuffer;
@@ -95,6 +120,63 @@ size_t getEnvAsBytesFromFloatMb(const char* name, size_t defaultVal) {
   return defaultVal;
 }
 
+#if FL_BACKEND_CUDA
+// Completion tracked by an event recorded on the using stream at free time,
+// so the pool learns the block is reusable without a device sync.
+class CudaStreamFreeEvent : public CachingMemoryManager::StreamFreeEvent {
+  cudaEvent_t event_;
+
+ public:
+  explicit CudaStreamFreeEvent(const CUDAStream& stream) {
+    FL_CUDA_CHECK(cudaEventCreateWithFlags(&event_, cudaEventDisableTiming));
+    FL_CUDA_CHECK(cudaEventRecord(event_, stream.handle()));
+  }
+
+  ~CudaStreamFreeEvent() override {
+    cudaEventDestroy(event_);
+  }
+
+  bool ready() const override {
+    return cudaEventQuery(event_) == cudaSuccess;
+  }
+};
+#endif
+
+std::vector<std::unique_ptr<CachingMemoryManager::StreamFreeEvent>>
+makeStreamFreeEvents(const std::unordered_set<const Stream*>& streams) {
+  std::vector<std::unique_ptr<CachingMemoryManager::StreamFreeEvent>> events;
+#if FL_BACKEND_CUDA
+  for (const Stream* stream : streams) {
+    if (stream->type() == StreamType::CUDA) {
+      events.emplace_back(
+          std::make_unique<CudaStreamFreeEvent>(stream->impl<CUDAStream>()));
+    }
+  }
+#else
+  // synchronous streams have drained by free time -- nothing to wait on
+  (void)streams;
+#endif
+  return events;
+}
+
+/**
+ * Returns the named environment variable parsed as an unsigned integer, or
+ * defaultVal if unset.
+ */
+unsigned getEnvAsUnsigned(const char* name, unsigned defaultVal) {
+  const char* env = std::getenv(name);
+  if (env) {
+    try {
+      return static_cast<unsigned>(std::stoul(env));
+    } catch (std::exception& ex) {
+      std::cerr << "getEnvAsUnsigned: Invalid environment "
+                << "variable value: name=" << name << " value=" << env;
+      throw ex;
+    }
+  }
+  return defaultVal;
+}
+
 } // namespace
 
 CachingMemoryManager::DeviceMemoryInfo::DeviceMemoryInfo(int id)
@@ -109,6 +191,8 @@ CachingMemoryManager::CachingMemoryManager(
   recyclingSizeLimit_ =
       getEnvAsBytesFromFloatMb(kMemRecyclingSize, recyclingSizeLimit_);
   splitSizeLimit_ = getEnvAsBytesFromFloatMb(kMemSplitSize, splitSizeLimit_);
+  roundingPower2Divisions_ =
+      getEnvAsUnsigned(kMemPower2Divisions, roundingPower2Divisions_);
 
   for (int i = 0; i < numDevices; ++i) {
     deviceMemInfos_.emplace(
@@ -126,6 +210,18 @@ void CachingMemoryManager::setSplitSizeLimit(size_t limit) {
   splitSizeLimit_ = limit;
 }
 
+void CachingMemoryManager::setRoundingPower2Divisions(unsigned divisions) {
+  roundingPower2Divisions_ = divisions;
+}
+
+size_t CachingMemoryManager::computeRoundedSize(size_t size) const {
+  size = roundSize(size);
+  if (roundingPower2Divisions_ == 0) {
+    return size;
+  }
+  return roundSizeClass(size, roundingPower2Divisions_);
+}
+
 void CachingMemoryManager::shutdown() {
   signalMemoryCleanup();
 }
@@ -151,7 +247,36 @@ void* CachingMemoryManager::alloc(
     dim_t* dims,
     const unsigned elementSize) {
   auto& memoryInfo = getDeviceMemoryInfo();
-  std::lock_guard<std::recursive_mutex> lock(memoryInfo.mutexAll_);
+  void* ptr = nullptr;
+  size_t allocatedBytes = 0;
+  {
+    std::lock_guard<std::recursive_mutex> lock(memoryInfo.mutexAll_);
+    ptr = allocLocked(memoryInfo, userLock, ndims, dims, elementSize);
+    allocatedBytes = memoryInfo.stats_.allocatedBytes_;
+  }
+  // observers run outside the allocator lock so other threads keep
+  // allocating while a callback reacts to a watermark crossing
+  if (ptr != nullptr && hasMemoryObservers()) {
+    const size_t capacity =
+        this->deviceInterface->getMaxMemorySize(memoryInfo.deviceId_);
+    if (capacity > 0) {
+      notifyMemoryObservers(
+          memoryInfo.deviceId_,
+          static_cast<float>(
+              static_cast<double>(allocatedBytes) /
+              static_cast<double>(capacity)));
+    }
+  }
+  return ptr;
+}
+
+void* CachingMemoryManager::allocLocked(
+    DeviceMemoryInfo& memoryInfo,
+    bool userLock,
+    const unsigned ndims,
+    dim_t* dims,
+    const unsigned elementSize) {
+  processPendingFrees();
   size_t size = elementSize;
   for (unsigned i = 0; i < ndims; ++i) {
     size *= dims[i];
@@ -159,7 +284,7 @@ void* CachingMemoryManager::alloc(
   if (size == 0) {
     return nullptr;
   }
-  size = roundSize(size);
+  size = computeRoundedSize(size);
   const bool isSmallAlloc = (size <= kSmallSize);
   CachingMemoryManager::Block searchKey(size);
   CachingMemoryManager::BlockSet& pool =
@@ -177,9 +302,19 @@ void* CachingMemoryManager::alloc(
   } else {
     void* ptr = nullptr;
     size_t allocSize = getAllocationSize(size);
-    mallocWithRetry(allocSize, &ptr); // could throw
-    block = new Block(allocSize, ptr);
-    memoryInfo.stats_.allocatedBytes_ += allocSize;
+    try {
+      mallocWithRetry(allocSize, &ptr); // could throw
+      block = new Block(allocSize, ptr);
+      memoryInfo.stats_.allocatedBytes_ += allocSize;
+    } catch (std::exception&) {
+      // best-fit fallback: recycle any cached block that fits, ignoring the
+      // recycling size limit, before failing the allocation
+      block = recycleAnyBlock(memoryInfo, size);
+      if (block == nullptr) {
+        throw;
+      }
+      ++memoryInfo.stats_.oversizedRecycles_;
+    }
   }
 
   // If the block is larger than the requested size to handle another
@@ -205,6 +340,7 @@ void* CachingMemoryManager::alloc(
     remaining->size_ -= size;
     pool.insert(remaining);
     memoryInfo.stats_.cachedBytes_ += remaining->size_;
+    ++memoryInfo.stats_.totalSplits_;
   }
 
   block->managerLock_ = !userLock;
@@ -262,6 +398,17 @@ void CachingMemoryManager::freeBlock(CachingMemoryManager::Block* block) {
   auto& memoryInfo = getDeviceMemoryInfo();
   std::lock_guard<std::recursive_mutex> lock(memoryInfo.mutexAll_);
 
+  // a block used on foreign streams only returns to the pool once events
+  // recorded on those streams clear (see processPendingFrees)
+  if (!block->streamUses_.empty()) {
+    auto events = makeStreamFreeEvents(block->streamUses_);
+    block->streamUses_.clear();
+    if (!events.empty()) {
+      memoryInfo.pendingFrees_.emplace_back(block, std::move(events));
+      return;
+    }
+  }
+
   const bool isSmallAlloc = (block->size_ <= kSmallSize);
   CachingMemoryManager::BlockSet& pool =
       isSmallAlloc ? memoryInfo.smallBlocks_ : memoryInfo.largeBlocks_;
@@ -272,6 +419,63 @@ void CachingMemoryManager::freeBlock(CachingMemoryManager::Block* block) {
   memoryInfo.stats_.cachedBytes_ += block->size_;
 }
 
+void CachingMemoryManager::recordStreamUse(
+    const void* ptr,
+    const Stream& stream) {
+  if (!ptr) {
+    return;
+  }
+  auto& memoryInfo = getDeviceMemoryInfo();
+  std::lock_guard<std::recursive_mutex> lock(memoryInfo.mutexAll_);
+  auto it = memoryInfo.allocatedBlocks_.find(const_cast<void*>(ptr));
+  if (it == memoryInfo.allocatedBlocks_.end()) {
+    return;
+  }
+  it->second->streamUses_.insert(&stream);
+}
+
+void CachingMemoryManager::processPendingFrees() {
+  auto& memoryInfo = getDeviceMemoryInfo();
+  std::lock_guard<std::recursive_mutex> lock(memoryInfo.mutexAll_);
+  auto& pendingFrees = memoryInfo.pendingFrees_;
+  for (auto it = pendingFrees.begin(); it != pendingFrees.end();) {
+    const bool cleared = std::all_of(
+        it->second.begin(),
+        it->second.end(),
+        [](const std::unique_ptr<StreamFreeEvent>& event) {
+          return event->ready();
+        });
+    if (cleared) {
+      Block* block = it->first;
+      it = pendingFrees.erase(it);
+      freeBlock(block); // stream uses cleared -- goes to the pool
+    } else {
+      ++it;
+    }
+  }
+}
+
+CachingMemoryManager::Block* CachingMemoryManager::recycleAnyBlock(
+    DeviceMemoryInfo& memoryInfo,
+    size_t size) {
+  CachingMemoryManager::Block searchKey(size);
+  CachingMemoryManager::Block* bestFit = nullptr;
+  CachingMemoryManager::BlockSet* bestPool = nullptr;
+  for (auto* pool : {&memoryInfo.smallBlocks_, &memoryInfo.largeBlocks_}) {
+    auto it = pool->lower_bound(&searchKey);
+    if (it != pool->end() &&
+        (bestFit == nullptr || (*it)->size_ < bestFit->size_)) {
+      bestFit = *it;
+      bestPool = pool;
+    }
+  }
+  if (bestFit != nullptr) {
+    bestPool->erase(bestFit);
+    memoryInfo.stats_.cachedBytes_ -= bestFit->size_;
+  }
+  return bestFit;
+}
+
 /** combine previously split blocks */
 void CachingMemoryManager::tryMergeBlocks(
     CachingMemoryManager::Block* dst,
@@ -354,6 +558,7 @@ void CachingMemoryManager::signalMemoryCleanup() {
   // Free all non-split cached blocks on device
   auto& memoryInfo = getDeviceMemoryInfo();
   std::lock_guard<std::recursive_mutex> lock(memoryInfo.mutexAll_);
+  processPendingFrees();
 
   freeBlocks(
       memoryInfo.largeBlocks_,
@@ -392,6 +597,67 @@ void CachingMemoryManager::printInfo(
           << "\nTotal native calls: " << memInfo.stats_.totalNativeMallocs_
           << "(mallocs), " << memInfo.stats_.totalNativeFrees_ << "(frees)"
           << std::endl;
+
+  // fragmentation stats over the cached pools
+  size_t cachedBlocks = 0;
+  size_t splitBlocks = 0;
+  size_t largestCachedBlock = 0;
+  for (const auto* pool : {&memInfo.smallBlocks_, &memInfo.largeBlocks_}) {
+    for (const auto* block : *pool) {
+      ++cachedBlocks;
+      if (block->isSplit()) {
+        ++splitBlocks;
+      }
+      largestCachedBlock = std::max(largestCachedBlock, block->size_);
+    }
+  }
+  const double fragmentationRatio = memInfo.stats_.cachedBytes_ == 0
+      ? 0.0
+      : 1.0 -
+          static_cast<double>(largestCachedBlock) /
+              static_cast<double>(memInfo.stats_.cachedBytes_);
+  ostream << "Cached blocks: " << cachedBlocks << " (" << splitBlocks
+          << " split), Largest cached block: "
+          << formatMemory(largestCachedBlock)
+          << ", Fragmentation ratio: " << fragmentationRatio
+          << "\nTotal splits: " << memInfo.stats_.totalSplits_
+          << ", Oversized recycles: " << memInfo.stats_.oversizedRecycles_
+          << std::endl;
+}
+
+MemoryManagerAdapter::MemorySnapshot CachingMemoryManager::snapshot(
+    int device /* = -1 */) {
+  auto& memoryInfo = getDeviceMemoryInfo(device);
+  std::lock_guard<std::recursive_mutex> lock(memoryInfo.mutexAll_);
+
+  MemorySnapshot snapshot;
+  snapshot.deviceId = memoryInfo.deviceId_;
+  snapshot.capacityBytes =
+      this->deviceInterface->getMaxMemorySize(memoryInfo.deviceId_);
+  snapshot.allocatedBytes = memoryInfo.stats_.allocatedBytes_;
+  snapshot.cachedBytes = memoryInfo.stats_.cachedBytes_;
+
+  std::map<size_t, MemorySnapshot::SizeClassUsage> sizeClasses;
+  for (const auto& entry : memoryInfo.allocatedBlocks_) {
+    auto& usage = sizeClasses[entry.second->size_];
+    usage.blockSize = entry.second->size_;
+    ++usage.allocatedBlocks;
+    usage.allocatedBytes += entry.second->size_;
+  }
+  for (const auto* pool :
+       {&memoryInfo.smallBlocks_, &memoryInfo.largeBlocks_}) {
+    for (const auto* block : *pool) {
+      auto& usage = sizeClasses[block->size_];
+      usage.blockSize = block->size_;
+      ++usage.cachedBlocks;
+      usage.cachedBytes += block->size_;
+    }
+  }
+  snapshot.sizeClasses.reserve(sizeClasses.size());
+  for (const auto& entry : sizeClasses) {
+    snapshot.sizeClasses.push_back(entry.second);
+  }
+  return snapshot;
 }
 
 void CachingMemoryManager::userLock(const void* ptr) {
@@ -15,6 +15,7 @@
 #include <ostream>
 #include <set>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include "flashlight/fl/tensor/backend/af/mem/MemoryManagerAdapter.h"
@@ -22,6 +23,8 @@
 
 namespace fl {
 
+class Stream;
+
 /**
  * Reimplementation of CudaCachingAllocator from Torch adapted for flashlight
  * Sources :
@@ -55,10 +58,36 @@ class CachingMemoryManager : public MemoryManagerAdapter {
   bool jitTreeExceedsMemoryPressure(size_t bytes) override;
   void addMemoryManagement(int device) override;
   void removeMemoryManagement(int device) override;
+  // Per-size-class usage built from the per-block state under the device
+  // lock; one pass over the allocated and cached block sets.
+  MemorySnapshot snapshot(int device = -1) override;
   // Set runtime options: RecyclingSizeLimit, SplitSizeLimit, ... Warning: not
   // thread safe
   void setRecyclingSizeLimit(size_t);
   void setSplitSizeLimit(size_t);
+  // Low-fragmentation mode: round allocations up to size classes, where each
+  // [2^n, 2^(n+1)) interval is split into `divisions` classes. Fewer distinct
+  // block sizes means freed blocks get recycled instead of fragmenting the
+  // pool under variable-size workloads. 0 (default) keeps exact rounding.
+  void setRoundingPower2Divisions(unsigned divisions);
+
+  // Mark `ptr`'s block as used on `stream` (beyond its allocation stream).
+  // When such a block is freed, it only returns to the pool once its recorded
+  // streams have drained past the point of free -- tracked with events on
+  // CUDA builds instead of a device sync -- so cross-stream reuse is safe
+  // without stalling the pool.
+  void recordStreamUse(const void* ptr, const Stream& stream);
+
+  // Return pending cross-stream frees whose events have cleared to the pool;
+  // called on every alloc, and usable directly by callers that want to drain
+  // eagerly.
+  void processPendingFrees();
+
+  // Completion token for a block freed while in use on foreign streams.
+  struct StreamFreeEvent {
+    virtual ~StreamFreeEvent() = default;
+    virtual bool ready() const = 0;
+  };
 
   // Block denotes a single allocated unit of memory.
   struct Block {
@@ -68,6 +97,8 @@ class CachingMemoryManager : public MemoryManagerAdapter {
     bool userLock_; // whether the memory is locked by the user
     Block* prev_; // prev block if split from a larger allocation
     Block* next_; // next block if split from a larger allocation
+    // streams (other than the allocation stream) this block was used on
+    std::unordered_set<const Stream*> streamUses_;
 
     bool isSplit() const {
       return (prev_ != nullptr) || (next_ != nullptr);
@@ -95,12 +126,16 @@ class CachingMemoryManager : public MemoryManagerAdapter {
     size_t totalNativeFrees_;
     size_t allocatedBytes_; // memory allocated by mem manager for the program
     size_t cachedBytes_; // memory held by mem manager & not used by the program
+    size_t totalSplits_; // # of times a cached block got split
+    size_t oversizedRecycles_; // # of last-ditch recycles past size limits
 
     MemoryAllocationStats()
         : totalNativeMallocs_(0),
           totalNativeFrees_(0),
           allocatedBytes_(0),
-          cachedBytes_(0) {}
+          cachedBytes_(0),
+          totalSplits_(0),
+          oversizedRecycles_(0) {}
   };
 
   // Stores the mutex and misc variables per device so that we operate in a
@@ -120,6 +155,10 @@ class CachingMemoryManager : public MemoryManagerAdapter {
     // allocated blocks by device pointer
     std::unordered_map<void*, Block*> allocatedBlocks_;
 
+    // blocks freed while used on foreign streams, waiting on their events
+    std::vector<std::pair<Block*, std::vector<std::unique_ptr<StreamFreeEvent>>>>
+        pendingFrees_;
+
     MemoryAllocationStats stats_;
 
     explicit DeviceMemoryInfo(int id);
@@ -140,11 +179,26 @@ class CachingMemoryManager : public MemoryManagerAdapter {
   void
   freeBlocks(BlockSet& blocks, BlockSet::iterator it, BlockSet::iterator end);
 
+  // The body of `alloc`, called with the device lock held; `alloc` itself
+  // only wraps it so memory observers can be notified outside the lock.
+  void* allocLocked(
+      DeviceMemoryInfo& memoryInfo,
+      bool userLock,
+      const unsigned ndims,
+      dim_t* dims,
+      const unsigned elSize);
+
   void mallocWithRetry(size_t size, void** ptr);
 
   void tryMergeBlocks(Block* dst, Block* src, BlockSet& freeBlocks);
   void freeBlock(Block* block);
 
+  // requested size --> pool block size, honoring the rounding options
+  size_t computeRoundedSize(size_t size) const;
+  // Last-ditch recycle of any sufficiently large cached block (ignoring the
+  // recycling size limit) when native allocation fails; nullptr if none fits.
+  Block* recycleAnyBlock(DeviceMemoryInfo& memoryInfo, size_t size);
+
  private:
   // Non-const runtime options in order to fine tune the behavior of this
   // manager. Prevents to recycle some buffers, to be set by the user if
@@ -153,6 +207,8 @@ class CachingMemoryManager : public MemoryManagerAdapter {
   // size_t recyclingSizeLimit;
   // Prevents to split big buffers, to be set by the user if desired:
   size_t splitSizeLimit_{std::numeric_limits<size_t>::max()};
+  // Power-of-two size-class rounding divisions; 0 keeps exact rounding:
+  unsigned roundingPower2Divisions_{0};
 };
 
 } // namespace fl
@@ -7,6 +7,7 @@
 
 #include "flashlight/fl/tensor/backend/af/mem/MemoryManagerAdapter.h"
 
+#include <algorithm>
 #include <stdexcept>
 #include <utility>
 
@@ -75,4 +76,69 @@ size_t MemoryManagerAdapter::getMemStepSize() {
 
 void MemoryManagerAdapter::setMemStepSize(size_t size) {}
 
+size_t MemoryManagerAdapter::registerMemoryObserver(
+    float watermark,
+    MemoryObserverCallback callback) {
+  if (!(watermark > 0.f && watermark <= 1.f)) {
+    throw std::invalid_argument(
+        "MemoryManagerAdapter::registerMemoryObserver - "
+        "watermark must be in (0, 1].");
+  }
+  if (!callback) {
+    throw std::invalid_argument(
+        "MemoryManagerAdapter::registerMemoryObserver - "
+        "callback is empty.");
+  }
+  std::lock_guard<std::mutex> lock(observerMutex_);
+  const size_t id = nextObserverId_++;
+  observers_.push_back(MemoryObserver{id, watermark, std::move(callback), {}});
+  hasObservers_.store(true, std::memory_order_release);
+  return id;
+}
+
+void MemoryManagerAdapter::unregisterMemoryObserver(size_t id) {
+  std::lock_guard<std::mutex> lock(observerMutex_);
+  observers_.erase(
+      std::remove_if(
+          observers_.begin(),
+          observers_.end(),
+          [id](const MemoryObserver& observer) { return observer.id == id; }),
+      observers_.end());
+  hasObservers_.store(!observers_.empty(), std::memory_order_release);
+}
+
+bool MemoryManagerAdapter::hasMemoryObservers() const {
+  return hasObservers_.load(std::memory_order_relaxed);
+}
+
+void MemoryManagerAdapter::notifyMemoryObservers(
+    int device,
+    float utilization) {
+  // gather the callbacks to fire under the lock, but invoke them outside it,
+  // so a callback can (un)register observers without deadlocking
+  std::vector<MemoryObserverCallback> toFire;
+  {
+    std::lock_guard<std::mutex> lock(observerMutex_);
+    for (auto& observer : observers_) {
+      bool& above = observer.above[device];
+      if (!above && utilization >= observer.watermark) {
+        above = true;
+        toFire.push_back(observer.callback);
+      } else if (above && utilization < observer.watermark) {
+        above = false; // re-arm
+      }
+    }
+  }
+  for (auto& callback : toFire) {
+    callback(device, utilization);
+  }
+}
+
+MemoryManagerAdapter::MemorySnapshot MemoryManagerAdapter::snapshot(
+    int device) {
+  MemorySnapshot snapshot;
+  snapshot.deviceId = device;
+  return snapshot;
+}
+
 } // namespace fl
@@ -9,13 +9,17 @@
 
 #include <af/memory.h>
 
+#include <atomic>
 #include <fstream>
 #include <functional>
 #include <iostream>
 #include <memory>
+#include <mutex>
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 #include "flashlight/fl/tensor/backend/af/mem/MemoryManagerDeviceInterface.h"
 
@@ -94,6 +98,71 @@ class MemoryManagerAdapter {
   virtual size_t getMemStepSize();
   virtual void setMemStepSize(size_t size);
 
+  /**
+   * A point-in-time view of a memory manager's usage on one device, intended
+   * for metrics pipelines and memory-pressure handling. `sizeClasses`
+   * aggregates blocks by their (rounded) pool block size; managers that do
+   * not track per-size-class state return an empty vector.
+   */
+  struct MemorySnapshot {
+    struct SizeClassUsage {
+      size_t blockSize{0}; // pool block size in bytes
+      size_t allocatedBlocks{0}; // blocks handed out to the program
+      size_t allocatedBytes{0};
+      size_t cachedBlocks{0}; // blocks held on free lists
+      size_t cachedBytes{0};
+    };
+    int deviceId{-1};
+    size_t capacityBytes{0}; // total memory of the device
+    size_t allocatedBytes{0}; // native allocator footprint of the manager
+    size_t cachedBytes{0}; // bytes held on free lists, not used by the program
+    std::vector<SizeClassUsage> sizeClasses; // ascending by blockSize
+  };
+
+  /**
+   * Callback invoked when device memory utilization crosses an observer's
+   * watermark; receives the device id and the utilization at the time of the
+   * crossing. Callbacks run on the allocating thread, outside the allocator
+   * lock, and should be fast; heavyweight reactions (shrinking batch sizes,
+   * flushing caches, ...) should be deferred to the training loop.
+   */
+  using MemoryObserverCallback =
+      std::function<void(int device, float utilization)>;
+
+  /**
+   * Registers a memory observer fired when the device memory utilization (the
+   * manager's native allocator footprint over the device capacity) rises past
+   * `watermark`. Observers are edge-triggered: after firing, an observer is
+   * re-armed only once utilization drops back below its watermark, so a
+   * training loop hovering above the watermark gets one notification, not one
+   * per allocation.
+   *
+   * @param[in] watermark the utilization threshold, in (0, 1].
+   * @param[in] callback the callback to fire on an upward crossing.
+   * @return an id with which the observer can be unregistered.
+   */
+  size_t registerMemoryObserver(
+      float watermark,
+      MemoryObserverCallback callback);
+
+  /**
+   * Unregisters a memory observer; ids of already-removed observers are
+   * ignored.
+   *
+   * @param[in] id the id returned by `registerMemoryObserver`.
+   */
+  void unregisterMemoryObserver(size_t id);
+
+  /**
+   * Returns a snapshot of the manager's usage on a device. The base
+   * implementation returns an empty snapshot; managers with per-block state
+   * (e.g. `CachingMemoryManager`) override this with a filled-in view.
+   *
+   * @param[in] device the device to snapshot; -1 for the active device.
+   * @return the usage snapshot.
+   */
+  virtual MemorySnapshot snapshot(int device = -1);
+
   /**
    * Logs information to the `MemoryManagerAdapters`'s log stream. If logging
    * mode is enabled, function calls to virtual base class methods are logged.
@@ -152,7 +221,35 @@ class MemoryManagerAdapter {
   // AF memory manager entity containing relevant function pointers
   af_memory_manager interface_;
 
+  /**
+   * Fires the registered observers whose watermarks `utilization` crosses
+   * upward on `device` (and re-arms those it drops below). Derived managers
+   * call this from their allocation paths, outside their allocator locks;
+   * guard the call with `hasMemoryObservers()` to keep the no-observer case
+   * free.
+   */
+  void notifyMemoryObservers(int device, float utilization);
+
+  /**
+   * Returns whether any memory observer is registered; a single relaxed
+   * atomic load, cheap enough for per-allocation checks.
+   */
+  bool hasMemoryObservers() const;
+
  private:
+  // Memory observer components
+  struct MemoryObserver {
+    size_t id;
+    float watermark;
+    MemoryObserverCallback callback;
+    // per-device: whether utilization is currently above the watermark
+    std::unordered_map<int, bool> above;
+  };
+  mutable std::mutex observerMutex_;
+  std::vector<MemoryObserver> observers_;
+  size_t nextObserverId_{1};
+  std::atomic<bool> hasObservers_{false};
+
   // Logging components
   bool loggingEnabled_{false};
   std::ostream* logStream_;
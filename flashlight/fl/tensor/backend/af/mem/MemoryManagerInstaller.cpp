@@ -14,6 +14,7 @@
 #include <af/device.h>
 
 #include "flashlight/fl/tensor/backend/af/Utils.h"
+#include "flashlight/fl/tensor/backend/af/mem/ArenaMemoryManager.h"
 #include "flashlight/fl/tensor/backend/af/mem/CachingMemoryManager.h"
 
 namespace fl {
@@ -229,6 +230,19 @@ void MemoryManagerInstaller::installDefaultMemoryManager() {
   installer.setAsMemoryManager();
 }
 
+std::shared_ptr<ArenaMemoryManager>
+MemoryManagerInstaller::installArenaMemoryManager(size_t arenaBytes /* = 0 */) {
+  auto deviceInterface = std::make_shared<MemoryManagerDeviceInterface>();
+  auto adapter = arenaBytes == 0
+      ? std::make_shared<ArenaMemoryManager>(
+            af::getDeviceCount(), deviceInterface)
+      : std::make_shared<ArenaMemoryManager>(
+            af::getDeviceCount(), deviceInterface, arenaBytes);
+  auto installer = MemoryManagerInstaller(adapter);
+  installer.setAsMemoryManager();
+  return adapter;
+}
+
 void MemoryManagerInstaller::unsetMemoryManager() {
   // Make sure we don't reset the default AF memory manager if it's set
   if (currentlyInstalledMemoryManager_) {
@@ -16,6 +16,8 @@
 
 namespace fl {
 
+class ArenaMemoryManager;
+
 /**
  * Manages memory managers and abstracts away parts of the ArrayFire C memory
  * manager API that enables setting active memory managers in ArrayFire.
@@ -88,6 +90,19 @@ class MemoryManagerInstaller {
    */
   static void installDefaultMemoryManager();
 
+  /**
+   * Initializes and installs an `ArenaMemoryManager` for request-scoped
+   * inference workloads. Only sets the memory manager - doesn't set an AF
+   * pinned memory manager.
+   *
+   * @param[in] arenaBytes the per-thread arena capacity; 0 uses the manager's
+   * default capacity.
+   * @return the installed manager, so callers can open and close request
+   * scopes on it.
+   */
+  static std::shared_ptr<ArenaMemoryManager> installArenaMemoryManager(
+      size_t arenaBytes = 0);
+
   /**
    * Unsets the currently-set custom ArrayFire memory manager. If no custom
    * memory manager is set, results in a noop, since the default memory manager
@@ -74,6 +74,10 @@ Optimizer& JitBackend::optimizer() {
   return optimizer_;
 }
 
+CompiledGraphCache& JitBackend::graphCache() {
+  return graphCache_;
+}
+
 TensorBackend& JitBackend::wrappedBackend() {
   return wrappedBackend_;
 }
@@ -9,6 +9,7 @@
 
 #include "flashlight/fl/tensor/TensorAdapter.h"
 #include "flashlight/fl/tensor/TensorBackend.h"
+#include "flashlight/fl/tensor/backend/jit/eval/CompiledGraphCache.h"
 #include "flashlight/fl/tensor/backend/jit/eval/Evaluator.h"
 #include "flashlight/fl/tensor/backend/jit/ir/BinaryNode.h"
 #include "flashlight/fl/tensor/backend/jit/ir/Node.h"
@@ -25,6 +26,7 @@ class JitBackend : public TensorBackend {
   std::function<Tensor(NodePtr)> jitTensorCreator_;
   Evaluator evaluator_;
   Optimizer optimizer_;
+  CompiledGraphCache graphCache_;
 
   template <typename T>
   Tensor fullWithType(const Shape& shape, T value, dtype type);
@@ -49,6 +51,7 @@ class JitBackend : public TensorBackend {
 
   Evaluator& evaluator();
   Optimizer& optimizer();
+  CompiledGraphCache& graphCache();
   TensorBackend& wrappedBackend();
 
   /* -------------------------- Compute Functions -------------------------- */
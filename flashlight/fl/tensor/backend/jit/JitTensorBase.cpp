@@ -395,8 +395,21 @@ NodePtr JitTensorBase::node() const {
 
 void JitTensorBase::eval() const {
   if (!node()->getResult().has_value()) {
+    auto& graphCache = backend().graphCache();
+    // structurally identical graphs skip optimization & replay the recorded
+    // optimized graph with this graph's leaf tensors bound in
+    auto replayed = graphCache.lookupAndReplay(node(), evaluator());
+    if (replayed.has_value()) {
+      node()->setResult(std::move(replayed.value()));
+      return;
+    }
+    // capture structure before optimization mutates the graph in place
+    const auto pendingRecord = graphCache.prepareRecord(node());
     sharedData_->replaceNode(optimizer().optimize(node()));
     evaluator().eval(node());
+    if (pendingRecord != nullptr) {
+      graphCache.record(pendingRecord, node());
+    }
   }
 }
 
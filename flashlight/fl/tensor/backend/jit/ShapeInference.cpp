@@ -7,48 +7,144 @@
 
 #include "flashlight/fl/tensor/backend/jit/ShapeInference.h"
 
+#include <array>
 #include <cassert>
+#include <cstdint>
 #include <numeric>
 #include <sstream>
 #include <unordered_set>
 
 namespace fl {
 
+namespace {
+
+// Op tags prefixed onto memo keys, so identical operand words can't collide
+// across inference functions
+enum class ShapeInferenceOp : int64_t {
+  Reduction = 1,
+  Transpose,
+  Tile,
+  Pad,
+  Matmul,
+};
+
+// Key capacity and table size for the shape-inference memo below. The table
+// is direct-mapped, so entries just get overwritten on conflict; 256 slots
+// comfortably cover the handful of distinct (op, shapes, params) combinations
+// a graph-building loop cycles through.
+constexpr size_t kMemoKeyMaxWords = 16;
+constexpr size_t kMemoEntries = 256; // must be a power of two
+
+// A small inline key -- the op tag plus the flattened dims/params as int64
+// words, hashed (FNV-1a) as the words are appended. Keys too large to fit
+// inline mark themselves as overflowed and bypass the memo.
+struct ShapeMemoKey {
+  std::array<int64_t, kMemoKeyMaxWords> words;
+  size_t numWords{0};
+  uint64_t hash{14695981039346656037ull};
+  bool overflow{false};
+
+  explicit ShapeMemoKey(ShapeInferenceOp op) {
+    add(static_cast<int64_t>(op));
+  }
+
+  void add(int64_t word) {
+    if (numWords == kMemoKeyMaxWords) {
+      overflow = true;
+      return;
+    }
+    words[numWords++] = word;
+    hash = (hash ^ static_cast<uint64_t>(word)) * 1099511628211ull;
+  }
+
+  void add(const Shape& shape) {
+    add(shape.ndim());
+    for (int axis = 0; axis < shape.ndim(); axis++) {
+      add(shape.dim(axis));
+    }
+  }
+
+  bool operator==(const ShapeMemoKey& other) const {
+    return numWords == other.numWords &&
+        std::equal(
+               words.begin(), words.begin() + numWords, other.words.begin());
+  }
+};
+
+struct ShapeMemoEntry {
+  ShapeMemoKey key{ShapeInferenceOp::Reduction};
+  Shape result;
+  bool valid{false};
+};
+
+// Memoize `compute` under `key`. Node construction recomputes output shapes
+// for every node, and workloads with dynamic batch but fixed feature dims
+// produce mostly previously-seen results, so hits skip the inference logic
+// (and its allocations) entirely. The table is thread-local -- concurrent
+// graph builders don't contend on a lock -- and only successful inferences
+// are recorded, so invalid inputs throw on every call as before.
+template <typename F>
+Shape memoized(const ShapeMemoKey& key, F&& compute) {
+  if (key.overflow) {
+    return compute();
+  }
+  static thread_local std::array<ShapeMemoEntry, kMemoEntries> memo;
+  auto& entry = memo[key.hash & (kMemoEntries - 1)];
+  if (entry.valid && entry.key == key) {
+    return entry.result;
+  }
+  Shape result = compute();
+  entry.key = key;
+  entry.result = result;
+  entry.valid = true;
+  return result;
+}
+
+} // namespace
+
 Shape inferReductionOutputShape(
     const Shape& inputShape,
     const std::vector<int>& axes,
     bool keepDims) {
-  // NOTE the tensor API requires this, see reduction tests
-  if (inputShape.ndim() == 0) {
-    return inputShape;
-  }
+  ShapeMemoKey key(ShapeInferenceOp::Reduction);
+  key.add(inputShape);
+  key.add(static_cast<int64_t>(keepDims));
   for (const auto axis : axes) {
-    if (axis < 0 || axis >= inputShape.ndim()) {
-      std::ostringstream oss;
-      oss << "[inferReductionOutputShape] Invalid axis for reduction: " << axis
-          << " for tensor of shape: " << inputShape;
-      throw std::invalid_argument(oss.str());
-    }
+    key.add(axis);
   }
-  std::unordered_set<int> axesToReduce;
-  if (axes.empty()) {
-    for (int aixs = 0; aixs < inputShape.ndim(); aixs++) {
-      axesToReduce.insert(aixs);
+  return memoized(key, [&]() -> Shape {
+    // NOTE the tensor API requires this, see reduction tests
+    if (inputShape.ndim() == 0) {
+      return inputShape;
     }
-  } else {
-    axesToReduce.insert(axes.begin(), axes.end());
-  }
-  std::vector<Dim> outputDims;
-  for (int axis = 0; axis < inputShape.ndim(); axis++) {
-    if (axesToReduce.find(axis) != axesToReduce.end()) {
-      if (keepDims) {
-        outputDims.push_back(1);
+    for (const auto axis : axes) {
+      if (axis < 0 || axis >= inputShape.ndim()) {
+        std::ostringstream oss;
+        oss << "[inferReductionOutputShape] Invalid axis for reduction: "
+            << axis << " for tensor of shape: " << inputShape;
+        throw std::invalid_argument(oss.str());
+      }
+    }
+    std::unordered_set<int> axesToReduce;
+    if (axes.empty()) {
+      for (int aixs = 0; aixs < inputShape.ndim(); aixs++) {
+        axesToReduce.insert(aixs);
       }
     } else {
-      outputDims.push_back(inputShape.dim(axis));
+      axesToReduce.insert(axes.begin(), axes.end());
     }
-  }
-  return Shape(outputDims);
+    std::vector<Dim> outputDims;
+    for (int axis = 0; axis < inputShape.ndim(); axis++) {
+      if (axesToReduce.find(axis) != axesToReduce.end()) {
+        if (keepDims) {
+          outputDims.push_back(1);
+        }
+      } else {
+        outputDims.push_back(inputShape.dim(axis));
+      }
+    }
+    return Shape(outputDims);
+  });
 }
 
 std::vector<Shape> broadcastShapesToMaxRank(
@@ -66,7 +162,7 @@ std::vector<Shape> broadcastShapesToMaxRank(
     maxRank = std::max(maxRank, tensor.ndim());
   }
   for (const auto& tensor : tensors) {
-    auto dims = tensor.shape().get();
+    std::vector<Dim> dims = tensor.shape().get();
     dims.insert(dims.end(), maxRank - dims.size(), 1);
     shapes.push_back(Shape(dims));
   }
@@ -74,44 +170,54 @@ std::vector<Shape> broadcastShapesToMaxRank(
 }
 
 Shape inferTransposeOutputShape(const Shape& inputShape, const Shape& axes) {
-  const auto inputRank = inputShape.ndim();
-  std::vector<Dim> outputDims = inputShape.get();
-  std::vector<Dim> oldToNewAxes = axes.get();
-  if (axes.ndim() == 0) { // default, reverse all axes
-    oldToNewAxes.resize(inputRank);
-    std::reverse(outputDims.begin(), outputDims.end());
-    std::iota(oldToNewAxes.begin(), oldToNewAxes.end(), 0);
-    std::reverse(oldToNewAxes.begin(), oldToNewAxes.end());
-  } else if (axes.ndim() == inputRank) {
-    for (int axis = 0; axis < axes.ndim(); axis++) {
-      outputDims[axis] = inputShape.dim(oldToNewAxes[axis]);
+  ShapeMemoKey key(ShapeInferenceOp::Transpose);
+  key.add(inputShape);
+  key.add(axes);
+  return memoized(key, [&]() -> Shape {
+    const auto inputRank = inputShape.ndim();
+    std::vector<Dim> outputDims = inputShape.get();
+    std::vector<Dim> oldToNewAxes = axes.get();
+    if (axes.ndim() == 0) { // default, reverse all axes
+      oldToNewAxes.resize(inputRank);
+      std::reverse(outputDims.begin(), outputDims.end());
+      std::iota(oldToNewAxes.begin(), oldToNewAxes.end(), 0);
+      std::reverse(oldToNewAxes.begin(), oldToNewAxes.end());
+    } else if (axes.ndim() == inputRank) {
+      for (int axis = 0; axis < axes.ndim(); axis++) {
+        outputDims[axis] = inputShape.dim(oldToNewAxes[axis]);
+      }
+    } else {
+      std::ostringstream oss;
+      oss << "[JitBackend::transpose] Invalid axes: " << axes
+          << " for shape: " << inputShape;
+      throw std::runtime_error(oss.str());
     }
-  } else {
-    std::ostringstream oss;
-    oss << "[JitBackend::transpose] Invalid axes: " << axes
-        << " for shape: " << inputShape;
-    throw std::runtime_error(oss.str());
-  }
-  return Shape(outputDims);
+    return Shape(outputDims);
+  });
 }
 
 Shape inferTileOutputShape(const Shape& inputShape, const Shape& tileDims) {
-  std::vector<Dim> paddedTensorDims = inputShape.get();
-  std::vector<Dim> paddedTileDims = tileDims.get();
-  const auto inputRank = inputShape.ndim();
-  const auto tileRank = tileDims.ndim();
-  if (inputRank > tileRank) {
-    const auto diff = inputRank - tileRank;
-    paddedTileDims.insert(paddedTileDims.end(), diff, 1);
-  } else {
-    const auto diff = tileRank - inputRank;
-    paddedTensorDims.insert(paddedTensorDims.end(), diff, 1);
-  }
-  std::vector<Dim> outputDims;
-  for (unsigned i = 0; i < paddedTensorDims.size(); i++) {
-    outputDims.push_back(paddedTensorDims[i] * paddedTileDims[i]);
-  }
-  return Shape(outputDims);
+  ShapeMemoKey key(ShapeInferenceOp::Tile);
+  key.add(inputShape);
+  key.add(tileDims);
+  return memoized(key, [&]() -> Shape {
+    std::vector<Dim> paddedTensorDims = inputShape.get();
+    std::vector<Dim> paddedTileDims = tileDims.get();
+    const auto inputRank = inputShape.ndim();
+    const auto tileRank = tileDims.ndim();
+    if (inputRank > tileRank) {
+      const auto diff = inputRank - tileRank;
+      paddedTileDims.insert(paddedTileDims.end(), diff, 1);
+    } else {
+      const auto diff = tileRank - inputRank;
+      paddedTensorDims.insert(paddedTensorDims.end(), diff, 1);
+    }
+    std::vector<Dim> outputDims;
+    for (unsigned i = 0; i < paddedTensorDims.size(); i++) {
+      outputDims.push_back(paddedTensorDims[i] * paddedTileDims[i]);
+    }
+    return Shape(outputDims);
+  });
 }
 
 Shape inferConcatenateOutputShape(
@@ -147,18 +253,28 @@ Shape inferConcatenateOutputShape(
 Shape inferPadOutputShape(
     const Shape& inputShape,
     const std::vector<std::pair<int, int>>& padWidths) {
-  std::vector<Dim> outputDims = inputShape.get();
-  if (padWidths.size() > static_cast<size_t>(inputShape.ndim())) {
-    throw std::runtime_error("[inferPadOutputShape] too many paddings");
-  }
-  for (unsigned axis = 0; axis < padWidths.size(); axis++) {
-    const auto& [beforeDim, afterDim] = padWidths[axis];
-    outputDims[axis] += beforeDim + afterDim;
+  ShapeMemoKey key(ShapeInferenceOp::Pad);
+  key.add(inputShape);
+  for (const auto& [beforeDim, afterDim] : padWidths) {
+    key.add(beforeDim);
+    key.add(afterDim);
   }
-  return Shape(outputDims);
+  return memoized(key, [&]() -> Shape {
+    std::vector<Dim> outputDims = inputShape.get();
+    if (padWidths.size() > static_cast<size_t>(inputShape.ndim())) {
+      throw std::runtime_error("[inferPadOutputShape] too many paddings");
+    }
+    for (unsigned axis = 0; axis < padWidths.size(); axis++) {
+      const auto& [beforeDim, afterDim] = padWidths[axis];
+      outputDims[axis] += beforeDim + afterDim;
+    }
+    return Shape(outputDims);
+  });
 }
 
-Shape inferMatmulOutputShape(
+namespace {
+
+Shape inferMatmulOutputShapeUncached(
     const Shape& lhsShape,
     const Shape& rhsShape,
     MatrixProperty lhsProp,
@@ -210,4 +326,21 @@ Shape inferMatmulOutputShape(
   return outputShape;
 }
 
+} // namespace
+
+Shape inferMatmulOutputShape(
+    const Shape& lhsShape,
+    const Shape& rhsShape,
+    MatrixProperty lhsProp,
+    MatrixProperty rhsProp) {
+  ShapeMemoKey key(ShapeInferenceOp::Matmul);
+  key.add(lhsShape);
+  key.add(rhsShape);
+  key.add(static_cast<int64_t>(lhsProp));
+  key.add(static_cast<int64_t>(rhsProp));
+  return memoized(key, [&]() -> Shape {
+    return inferMatmulOutputShapeUncached(lhsShape, rhsShape, lhsProp, rhsProp);
+  });
+}
+
 } // namespace fl
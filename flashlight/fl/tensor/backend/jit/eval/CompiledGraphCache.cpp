@@ -0,0 +1,290 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "flashlight/fl/tensor/backend/jit/eval/CompiledGraphCache.h"
+
+#include <unordered_set>
+
+#include "flashlight/fl/tensor/backend/jit/ir/BinaryNode.h"
+#include "flashlight/fl/tensor/backend/jit/ir/CustomNode.h"
+#include "flashlight/fl/tensor/backend/jit/ir/ScalarNode.h"
+
+namespace fl {
+
+struct CompiledGraphCache::PendingRecord {
+  size_t hash;
+  NodePtr clonedRoot;
+  // live node --> detached clone; optimization passes keep Value nodes alive,
+  // so this lets the optimized graph's clone share the same cloned leaves
+  std::unordered_map<Node*, NodePtr> liveToClone;
+  std::vector<ValueNodePtr> valueLeaves;
+};
+
+namespace {
+
+template <typename T>
+void hashCombine(size_t& seed, const T& val) {
+  seed ^= std::hash<T>()(val) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+}
+
+// hash of graph structure + leaf shapes/dtypes; nullopt if the graph contains
+// nodes whose evaluation isn't derivable from structure alone
+std::optional<size_t> structuralHash(
+    const NodePtr node,
+    std::unordered_map<Node*, size_t>& memo) {
+  const auto memoIter = memo.find(node.get());
+  if (memoIter != memo.end()) {
+    return memoIter->second;
+  }
+  size_t seed = std::hash<int>()(static_cast<int>(node->type()));
+  for (const auto dim : node->shape().get()) {
+    hashCombine(seed, dim);
+  }
+  switch (node->type()) {
+    case NodeType::Binary: {
+      hashCombine(seed, static_cast<int>(node->impl<BinaryNode>().op()));
+      for (const auto& input : node->inputs()) {
+        const auto inputHash = structuralHash(input, memo);
+        if (!inputHash.has_value()) {
+          return std::nullopt;
+        }
+        hashCombine(seed, inputHash.value());
+      }
+      break;
+    }
+    case NodeType::Scalar: {
+      const auto& scalarNode = node->impl<ScalarNode>();
+      hashCombine(seed, static_cast<int>(scalarNode.dataType()));
+      hashCombine(seed, scalarNode.scalar<double>());
+      hashCombine(seed, scalarNode.scalar<long long>());
+      break;
+    }
+    case NodeType::Value:
+      hashCombine(seed, static_cast<int>(node->impl<ValueNode>().value().type()));
+      break;
+    case NodeType::Custom:
+    case NodeType::Index:
+    case NodeType::IndexedUpdate:
+      return std::nullopt;
+  }
+  memo[node.get()] = seed;
+  return seed;
+}
+
+ScalarNodePtr cloneScalarNode(const ScalarNode& node) {
+  const auto type = node.dataType();
+  switch (type) {
+    case dtype::f16:
+    case dtype::f32:
+    case dtype::f64:
+      return ScalarNode::create(node.shape(), type, node.scalar<double>());
+    case dtype::u64:
+      return ScalarNode::create(
+          node.shape(), type, node.scalar<unsigned long long>());
+    default:
+      return ScalarNode::create(node.shape(), type, node.scalar<long long>());
+  }
+}
+
+// detached structural clone; `liveToClone` keeps shared nodes shared
+NodePtr cloneGraph(
+    const NodePtr node,
+    std::unordered_map<Node*, NodePtr>& liveToClone) {
+  const auto memoIter = liveToClone.find(node.get());
+  if (memoIter != liveToClone.end()) {
+    return memoIter->second;
+  }
+  NodePtr clone;
+  switch (node->type()) {
+    case NodeType::Binary: {
+      const auto& binaryNode = node->impl<BinaryNode>();
+      clone = BinaryNode::create(
+          cloneGraph(binaryNode.lhs(), liveToClone),
+          cloneGraph(binaryNode.rhs(), liveToClone),
+          binaryNode.op());
+      break;
+    }
+    case NodeType::Scalar:
+      clone = cloneScalarNode(node->impl<ScalarNode>());
+      break;
+    case NodeType::Value:
+      clone = ValueNode::create(Tensor(node->impl<ValueNode>().value()));
+      break;
+    case NodeType::Custom: {
+      // only reached for optimizer-introduced custom nodes, whose evaluation
+      // logic is a pure function of their inputs
+      const auto& customNode = node->impl<CustomNode>();
+      std::vector<NodePtr> inputClones;
+      for (const auto& input : node->inputs()) {
+        inputClones.push_back(cloneGraph(input, liveToClone));
+      }
+      clone = CustomNode::create(
+          std::string(customNode.name()),
+          std::move(inputClones),
+          node->shape(),
+          CustomNode::EvalFunc(customNode.evalFunc()));
+      break;
+    }
+    case NodeType::Index:
+    case NodeType::IndexedUpdate:
+      throw std::runtime_error(
+          "[CompiledGraphCache] Unexpected node type in cacheable graph");
+  }
+  liveToClone[node.get()] = clone;
+  return clone;
+}
+
+void collectValueLeaves(
+    const NodePtr node,
+    std::unordered_set<Node*>& visited,
+    std::vector<ValueNodePtr>& leaves) {
+  if (visited.find(node.get()) != visited.end()) {
+    return;
+  }
+  visited.insert(node.get());
+  if (node->isValue()) {
+    leaves.push_back(Node::cast<ValueNodePtr>(node));
+    return;
+  }
+  for (const auto& input : node->inputs()) {
+    collectValueLeaves(input, visited, leaves);
+  }
+}
+
+// structural match of a fresh graph against a recorded template, collecting
+// the fresh graph's leaf tensors in the template's leaf (DFS) order
+bool matchAndCollectLeafTensors(
+    const NodePtr node,
+    const NodePtr tmpl,
+    std::unordered_map<Node*, Node*>& memo,
+    std::vector<const Tensor*>& leafTensors) {
+  const auto memoIter = memo.find(node.get());
+  if (memoIter != memo.end()) {
+    return memoIter->second == tmpl.get();
+  }
+  if (node->type() != tmpl->type() || node->shape() != tmpl->shape()) {
+    return false;
+  }
+  memo[node.get()] = tmpl.get();
+  switch (node->type()) {
+    case NodeType::Binary: {
+      const auto& binaryNode = node->impl<BinaryNode>();
+      const auto& tmplBinaryNode = tmpl->impl<BinaryNode>();
+      return binaryNode.op() == tmplBinaryNode.op() &&
+          matchAndCollectLeafTensors(
+                 binaryNode.lhs(), tmplBinaryNode.lhs(), memo, leafTensors) &&
+          matchAndCollectLeafTensors(
+                 binaryNode.rhs(), tmplBinaryNode.rhs(), memo, leafTensors);
+    }
+    case NodeType::Scalar: {
+      const auto& scalarNode = node->impl<ScalarNode>();
+      const auto& tmplScalarNode = tmpl->impl<ScalarNode>();
+      return scalarNode.dataType() == tmplScalarNode.dataType() &&
+          scalarNode.scalar<double>() == tmplScalarNode.scalar<double>() &&
+          scalarNode.scalar<long long>() ==
+          tmplScalarNode.scalar<long long>();
+    }
+    case NodeType::Value: {
+      const auto& value = node->impl<ValueNode>().value();
+      if (value.type() != tmpl->impl<ValueNode>().value().type()) {
+        return false;
+      }
+      leafTensors.push_back(&value);
+      return true;
+    }
+    case NodeType::Custom:
+    case NodeType::IndexedUpdate:
+    case NodeType::Index:
+      return false; // uncacheable nodes never get recorded
+  }
+  throw std::runtime_error(
+      "[CompiledGraphCache] Unknown node type during match");
+}
+
+// Shared clones can carry uses from both the match template and the optimized
+// template, which inflates the evaluator's use counts and leaves results
+// behind after a replay; drop them so the next replay re-evaluates.
+void clearIntermediateResults(const NodePtr node, std::unordered_set<Node*>& visited) {
+  if (visited.find(node.get()) != visited.end()) {
+    return;
+  }
+  visited.insert(node.get());
+  for (const auto& input : node->inputs()) {
+    clearIntermediateResults(input, visited);
+  }
+  if (!node->isValue() && node->getResult().has_value()) {
+    node->unsetResult();
+  }
+}
+
+} // namespace
+
+std::optional<Tensor> CompiledGraphCache::lookupAndReplay(
+    NodePtr root,
+    Evaluator& evaluator) {
+  std::unordered_map<Node*, size_t> hashMemo;
+  const auto hash = structuralHash(root, hashMemo);
+  if (!hash.has_value()) {
+    return std::nullopt;
+  }
+  const auto entriesIter = hashToEntries_.find(hash.value());
+  if (entriesIter == hashToEntries_.end()) {
+    return std::nullopt;
+  }
+  for (auto& entry : entriesIter->second) {
+    std::unordered_map<Node*, Node*> matchMemo;
+    std::vector<const Tensor*> leafTensors;
+    if (!matchAndCollectLeafTensors(
+            root, entry.unoptimizedRoot, matchMemo, leafTensors) ||
+        leafTensors.size() != entry.valueLeaves.size()) {
+      continue;
+    }
+    // bind the fresh graph's leaf tensors into the recorded graph & replay
+    for (unsigned i = 0; i < leafTensors.size(); i++) {
+      entry.valueLeaves[i]->unsetResult();
+      entry.valueLeaves[i]->setResult(Tensor(*leafTensors[i]));
+    }
+    evaluator.eval(entry.optimizedRoot);
+    auto result = entry.optimizedRoot->takeResult();
+    std::unordered_set<Node*> visited;
+    clearIntermediateResults(entry.optimizedRoot, visited);
+    return result;
+  }
+  return std::nullopt;
+}
+
+std::shared_ptr<CompiledGraphCache::PendingRecord>
+CompiledGraphCache::prepareRecord(NodePtr root) {
+  std::unordered_map<Node*, size_t> hashMemo;
+  const auto hash = structuralHash(root, hashMemo);
+  if (!hash.has_value()) {
+    return nullptr;
+  }
+  auto pending = std::make_shared<PendingRecord>();
+  pending->hash = hash.value();
+  pending->clonedRoot = cloneGraph(root, pending->liveToClone);
+  std::unordered_set<Node*> visited;
+  collectValueLeaves(pending->clonedRoot, visited, pending->valueLeaves);
+  return pending;
+}
+
+void CompiledGraphCache::record(
+    std::shared_ptr<PendingRecord> pending,
+    NodePtr optimizedRoot) {
+  if (numEntries_ >= kMaxEntries) {
+    hashToEntries_.clear();
+    numEntries_ = 0;
+  }
+  // Value nodes survive optimization, so the optimized graph's clone shares
+  // the pending record's cloned leaves via `liveToClone`.
+  auto optimizedClone = cloneGraph(optimizedRoot, pending->liveToClone);
+  hashToEntries_[pending->hash].push_back(
+      {pending->clonedRoot, std::move(optimizedClone), pending->valueLeaves});
+  numEntries_++;
+}
+
+} // namespace fl
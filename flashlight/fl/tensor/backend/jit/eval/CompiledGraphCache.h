@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include "flashlight/fl/tensor/backend/jit/eval/Evaluator.h"
+#include "flashlight/fl/tensor/backend/jit/ir/Node.h"
+#include "flashlight/fl/tensor/backend/jit/ir/ValueNode.h"
+
+namespace fl {
+
+/**
+ * A cache of optimized JIT graphs keyed by graph structure plus leaf
+ * shapes/dtypes, so workloads that evaluate structurally identical graphs
+ * repeatedly (e.g., serving) skip `Optimizer` and replay a recorded graph with
+ * the new leaf tensors bound in.
+ *
+ * Cached graphs are detached clones -- recorded templates never alias nodes of
+ * live tensors, so rebinding leaves on replay can't corrupt outstanding
+ * results.
+ *
+ * NOTE only graphs made of Binary/Scalar/Value nodes get cached -- Custom and
+ * Index(edUpdate) nodes hold evaluation state that structural comparison can't
+ * prove equivalent. Custom nodes _introduced by optimization passes_ are fine
+ * to replay since their evaluation logic is a pure function of their inputs.
+ */
+class CompiledGraphCache {
+ public:
+  // clone of a graph captured before optimization mutates it in place
+  struct PendingRecord;
+
+  /**
+   * If a graph structurally identical to `root` has been recorded, rebind
+   * `root`'s leaf tensors into the recorded optimized graph, evaluate it with
+   * `evaluator`, and return the result; nullopt on miss/uncacheable graph.
+   */
+  std::optional<Tensor> lookupAndReplay(NodePtr root, Evaluator& evaluator);
+
+  /**
+   * Capture a detached structural clone of `root` for keying, before
+   * optimization rewrites the graph in place. Returns nullptr if the graph is
+   * not cacheable.
+   */
+  std::shared_ptr<PendingRecord> prepareRecord(NodePtr root);
+
+  /**
+   * Record the optimized form of a previously prepared graph for replays.
+   */
+  void record(std::shared_ptr<PendingRecord> pending, NodePtr optimizedRoot);
+
+ private:
+  struct Entry {
+    NodePtr unoptimizedRoot; // detached clone, used for structural matching
+    NodePtr optimizedRoot; // detached clone, gets replayed
+    std::vector<ValueNodePtr> valueLeaves; // rebind targets, in DFS order
+  };
+
+  // bound on recorded graphs -- the whole cache gets dropped when exceeded
+  static constexpr size_t kMaxEntries = 1024;
+
+  std::unordered_map<size_t, std::vector<Entry>> hashToEntries_;
+  size_t numEntries_{0};
+};
+
+} // namespace fl
@@ -10,6 +10,7 @@
 #include <chrono>
 #include <functional>
 #include <queue>
+#include <unordered_set>
 
 #include "flashlight/fl/tensor/backend/jit/JitTensorBase.h"
 #include "flashlight/fl/tensor/backend/jit/ir/ValueNode.h"
@@ -58,11 +59,91 @@ void Evaluator::profile(std::function<void()> func, NodePtr nodePtr) {
   nodeToTotTimeMs_.insert({nodePtr, durNs * 1000});
 }
 
+namespace {
+
+bool hasInPlaceEquivalent(const BinaryOp op) {
+  switch (op) {
+    case BinaryOp::Add:
+    case BinaryOp::Sub:
+    case BinaryOp::Mul:
+    case BinaryOp::Div:
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool isCommutative(const BinaryOp op) {
+  return op == BinaryOp::Add || op == BinaryOp::Mul;
+}
+
+} // namespace
+
+bool Evaluator::canReuseOperandBuffer(BinaryNodePtr node, NodePtr operand)
+    const {
+  // Value nodes hold tensors owned outside the graph; never write into them.
+  if (operand->isValue()) {
+    return false;
+  }
+  // last use -- the operand's buffer dies right after this evaluation
+  // (`nodeToResultUseCount_` includes external uses, so a count of 1 means
+  // the only remaining use is this very node)
+  const auto countIter = nodeToResultUseCount_.find(operand);
+  if (countIter == nodeToResultUseCount_.end() || countIter->second != 1) {
+    return false;
+  }
+  const auto& operandTensor = operand->getResult().value();
+  const auto& otherNode =
+      operand == node->lhs() ? node->rhs() : node->lhs();
+  const auto& otherTensor = otherNode->getResult().value();
+  // no broadcast of the accumulator, no dtype promotion
+  return operandTensor.shape() == node->shape() &&
+      operandTensor.type() == otherTensor.type();
+}
+
+void Evaluator::evalBinaryOpInPlace(
+    BinaryOp op,
+    Tensor& accumulator,
+    const Tensor& other) {
+  switch (op) {
+    case BinaryOp::Add:
+      accumulator += other;
+      return;
+    case BinaryOp::Sub:
+      accumulator -= other;
+      return;
+    case BinaryOp::Mul:
+      accumulator *= other;
+      return;
+    case BinaryOp::Div:
+      accumulator /= other;
+      return;
+    default:
+      throw std::runtime_error(
+          "[Evaluator::evalBinaryOpInPlace] Op has no in-place equivalent");
+  }
+}
+
 void Evaluator::evalBinaryNode(BinaryNodePtr node) {
   std::function<void()> func = [this, node] {
-    const auto& lhs = node->lhs()->getResult().value();
-    const auto& rhs = node->rhs()->getResult().value();
-    node->setResult(evalBinaryOp(node->op(), lhs, rhs));
+    const auto op = node->op();
+    const auto lhsNode = node->lhs();
+    const auto rhsNode = node->rhs();
+    if (hasInPlaceEquivalent(op) && canReuseOperandBuffer(node, lhsNode)) {
+      auto result = lhsNode->takeResult();
+      evalBinaryOpInPlace(op, result, rhsNode->getResult().value());
+      node->setResult(std::move(result));
+    } else if (
+        isCommutative(op) && canReuseOperandBuffer(node, rhsNode)) {
+      auto result = rhsNode->takeResult();
+      evalBinaryOpInPlace(op, result, lhsNode->getResult().value());
+      node->setResult(std::move(result));
+    } else {
+      node->setResult(evalBinaryOp(
+          op,
+          lhsNode->getResult().value(),
+          rhsNode->getResult().value()));
+    }
   };
   profile(func, node);
 }
@@ -221,6 +302,97 @@ void Evaluator::evalNodeDispatch(NodePtr node) {
   throw std::runtime_error("[Evaluator::evalNodeDispatch] Unknown node type");
 }
 
+void Evaluator::evalNodesPartitioned(NodePtr root) {
+  // collect input edges & consumers over the unevaluated part of the tree
+  std::unordered_map<NodePtr, unsigned> pendingInputs;
+  std::unordered_map<NodePtr, std::vector<NodePtr>> nodeToConsumers;
+  std::queue<NodePtr> worklist({root});
+  std::unordered_set<NodePtr> seen{root};
+  std::queue<NodePtr> ready;
+  while (!worklist.empty()) {
+    NodePtr node = worklist.front();
+    worklist.pop();
+    unsigned pending = 0;
+    for (const auto& input : node->inputs()) {
+      if (!input->getResult().has_value()) {
+        pending++;
+        nodeToConsumers[input].push_back(node);
+      }
+      if (seen.find(input) == seen.end()) {
+        seen.insert(input);
+        worklist.push(input);
+      }
+    }
+    pendingInputs[node] = pending;
+    if (pending == 0) {
+      ready.push(node);
+    }
+  }
+
+  // FIFO over the ready set walks independent branches in lockstep, so a
+  // multi-stream backend can overlap their execution; a node inherits the
+  // branch of its first input, and merge points become cross-branch edges.
+  std::unordered_map<NodePtr, unsigned> nodeToBranch;
+  unsigned numBranches = 0;
+  while (!ready.empty()) {
+    NodePtr node = ready.front();
+    ready.pop();
+    const auto& inputs = node->inputs();
+    auto branch = numBranches;
+    for (const auto& input : inputs) {
+      const auto iter = nodeToBranch.find(input);
+      if (iter != nodeToBranch.end()) {
+        branch = iter->second;
+        break;
+      }
+    }
+    if (branch == numBranches) {
+      numBranches++;
+    }
+    nodeToBranch[node] = branch;
+
+    if (!node->getResult().has_value()) {
+      // enforce cross-branch data dependencies before dispatching -- the
+      // node's own branch stream (proxied by a same-branch input result) must
+      // wait on producer streams from other branches.
+      const Stream* proxyStream = nullptr;
+      std::unordered_set<const Stream*> waitOns;
+      for (const auto& input : inputs) {
+        const auto& inputStream = input->getResult().value().stream();
+        const auto inputBranchIter = nodeToBranch.find(input);
+        if (inputBranchIter != nodeToBranch.end() &&
+            inputBranchIter->second == branch) {
+          proxyStream = &inputStream;
+        } else {
+          waitOns.insert(&inputStream);
+        }
+      }
+      if (proxyStream != nullptr) {
+        waitOns.erase(proxyStream);
+        if (!waitOns.empty()) {
+          proxyStream->relativeSync(waitOns);
+        }
+      }
+      evalNodeDispatch(node);
+      for (const auto& input : inputs) {
+        auto& count = nodeToResultUseCount_.at(input);
+        count--;
+        if (count == 0 && !input->isValue()) {
+          input->unsetResult();
+        }
+      }
+    }
+
+    for (const auto& consumer : nodeToConsumers[node]) {
+      auto& pending = pendingInputs.at(consumer);
+      pending--;
+      if (pending == 0) {
+        ready.push(consumer);
+      }
+    }
+  }
+}
+
 void Evaluator::evalNode(NodePtr node) {
   if (!node->getResult().has_value()) {
     for (const auto& input : node->inputs()) {
@@ -242,7 +414,11 @@ void Evaluator::evalNode(NodePtr node) {
 
 void Evaluator::eval(NodePtr node) {
   nodeToResultUseCount_ = getNodeToUseCountInTree(node);
-  evalNode(node);
+  if (streamParallelismEnabled_) {
+    evalNodesPartitioned(node);
+  } else {
+    evalNode(node);
+  }
   for (const auto& callback : postEvalCallbacks_) {
     callback(node, nodeToTotTimeMs_);
   }
@@ -250,6 +426,14 @@ void Evaluator::eval(NodePtr node) {
   nodeToResultUseCount_.clear();
 }
 
+void Evaluator::setStreamParallelism(bool active) {
+  this->streamParallelismEnabled_ = active;
+}
+
+bool Evaluator::getStreamParallelism() const {
+  return this->streamParallelismEnabled_;
+}
+
 void Evaluator::setProfilerState(bool active) {
   this->profilerEnabled_ = active;
 }
@@ -40,9 +40,14 @@ class Evaluator {
   // track time spent on executing a node alone (not its inputs)
   std::unordered_map<NodePtr, float> nodeToTotTimeMs_{};
   bool profilerEnabled_{false};
+  bool streamParallelismEnabled_{false};
   PostEvalCallbackList postEvalCallbacks_;
 
   void evalNode(NodePtr node);
+  // topological walk that interleaves independent branches and inserts
+  // `Stream::relativeSync` on cross-branch edges, so multi-stream backends can
+  // overlap independent subgraphs.
+  void evalNodesPartitioned(NodePtr root);
   void evalNodeDispatch(NodePtr node);
   // profile execution time of `func` and associate it with `nodePtr`
   void profile(std::function<void()> func, NodePtr nodePtr);
@@ -61,6 +66,13 @@ class Evaluator {
   Tensor evalBinaryOp(BinaryOp op, const Tensor& lhs, const Tensor& rhs);
   Tensor evalScalar(ScalarNodePtr node);
 
+  // in-place planning -- `operand`'s result buffer can host `node`'s result
+  // iff this evaluation is the last use of `operand` (liveness from
+  // `nodeToResultUseCount_`) and shape/dtype match exactly.
+  bool canReuseOperandBuffer(BinaryNodePtr node, NodePtr operand) const;
+  // apply `accumulator = accumulator <op> other` in place
+  void evalBinaryOpInPlace(BinaryOp op, Tensor& accumulator, const Tensor& other);
+
  public:
   /**
    * Creates a JIT graph Evaluator that dispatches to the given backend.
@@ -80,6 +92,16 @@ class Evaluator {
    */
   void eval(NodePtr node);
 
+  /**
+   * Toggle partitioned evaluation -- the graph gets walked in topological
+   * order with independent branches interleaved, and cross-branch data
+   * dependencies enforced via `Stream::relativeSync` instead of the serial
+   * recursive walk. No-op overhead on single-stream backends; lets
+   * multi-stream backends overlap independent subgraphs.
+   */
+  void setStreamParallelism(bool active);
+  bool getStreamParallelism() const;
+
   /**
    * TODO document
    */
@@ -112,6 +112,13 @@ void Node::setResult(Tensor&& tensor) {
   }
 }
 
+Tensor Node::takeResult() {
+  if (!result_.has_value()) {
+    throw std::invalid_argument("[Node::takeResult] Result not set");
+  }
+  return std::move(result_.value());
+}
+
 void Node::unsetResult() {
   if (result_.has_value()) {
     result_ = std::nullopt;
@@ -74,6 +74,10 @@ class Node {
   const std::optional<Tensor>& getResult() const;
   void setResult(Tensor&& tensor);
   void unsetResult();
+  // move the result out so its buffer can be reused (e.g., for in-place
+  // evaluation); leaves an engaged moved-from result so `unsetResult` stays
+  // valid -- caller must ensure no one else reads the result afterwards.
+  Tensor takeResult();
 
   // Convenient type checks
   bool isBinary() const;
@@ -12,6 +12,8 @@
 #include "flashlight/fl/tensor/TensorBackend.h"
 #include "flashlight/fl/tensor/backend/jit/opt/JitOptimizerExtension.h"
 #include "flashlight/fl/tensor/backend/jit/opt/JitOptimizerExtensionBackends.h"
+#include "flashlight/fl/tensor/backend/jit/opt/passes/CommonSubexpressionElimination.h"
+#include "flashlight/fl/tensor/backend/jit/opt/passes/ElementwiseFusion.h"
 #include "flashlight/fl/tensor/backend/jit/opt/passes/ScalarFolding.h"
 
 namespace fl {
@@ -33,11 +35,17 @@ Optimizer::Optimizer(TensorBackend& backend) : backend_(backend) {
   // 1. figure out a configuration API (e.g., LLVM pass style macro)
   // 2. think about ordering
   passes_.emplace_back(std::make_unique<ScalarFolding>());
+  // runs before fusion so shared subtrees get deduplicated first -- fusion
+  // passes see accurate use counts and won't duplicate shared computations.
+  passes_.emplace_back(std::make_unique<CommonSubexpressionElimination>());
   auto& registrar = detail::TensorExtensionRegistrar::getInstance();
   if (registrar.isTensorExtensionRegistered(
           backend_.backendType(), TensorExtensionType::JitOptimizer)) {
     extend(passes_, backend_.getExtension<JitOptimizerExtension>().passes());
   }
+  // runs after backend-specific fusion so specialized fusion gets first shot;
+  // whatever elementwise chains remain get fused generically.
+  passes_.emplace_back(std::make_unique<ElementwiseFusion>());
 }
 
 NodePtr Optimizer::optimize(NodePtr node) {
@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "flashlight/fl/tensor/backend/jit/opt/passes/CommonSubexpressionElimination.h"
+
+#include <unordered_map>
+#include <unordered_set>
+
+#include "flashlight/fl/tensor/backend/jit/ir/BinaryNode.h"
+#include "flashlight/fl/tensor/backend/jit/ir/ScalarNode.h"
+
+namespace fl {
+
+namespace {
+
+// Structural identity of a node -- two nodes with equal keys are guaranteed to
+// evaluate to the same result, so one can stand in for the other.
+struct NodeKey {
+  NodeType type;
+  std::vector<Node*> inputs; // already canonicalized representatives
+  Shape shape;
+  // NodeType::Binary payload
+  BinaryOp binaryOp{BinaryOp::Add};
+  // NodeType::Scalar payload -- both views together identify the stored
+  // variant regardless of which alternative it holds
+  dtype scalarType{dtype::f32};
+  double scalarFp{0};
+  long long scalarInt{0};
+  // identity-compared nodes (Value/Custom/Index/IndexedUpdate) key on `self`
+  Node* self{nullptr};
+
+  bool operator==(const NodeKey& other) const {
+    return type == other.type && inputs == other.inputs &&
+        shape == other.shape && binaryOp == other.binaryOp &&
+        scalarType == other.scalarType && scalarFp == other.scalarFp &&
+        scalarInt == other.scalarInt && self == other.self;
+  }
+};
+
+struct NodeKeyHash {
+  template <typename T>
+  static void combine(size_t& seed, const T& val) {
+    seed ^= std::hash<T>()(val) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+  }
+
+  size_t operator()(const NodeKey& key) const {
+    size_t seed = std::hash<int>()(static_cast<int>(key.type));
+    for (const auto* input : key.inputs) {
+      combine(seed, input);
+    }
+    for (const auto dim : key.shape.get()) {
+      combine(seed, dim);
+    }
+    combine(seed, static_cast<int>(key.binaryOp));
+    combine(seed, static_cast<int>(key.scalarType));
+    combine(seed, key.scalarFp);
+    combine(seed, key.scalarInt);
+    combine(seed, key.self);
+    return seed;
+  }
+};
+
+NodeKey makeKey(const NodePtr node) {
+  NodeKey key{};
+  key.type = node->type();
+  key.shape = node->shape();
+  switch (node->type()) {
+    case NodeType::Binary: {
+      const auto& binaryNode = node->impl<BinaryNode>();
+      key.binaryOp = binaryNode.op();
+      for (const auto& input : node->inputs()) {
+        key.inputs.push_back(input.get());
+      }
+      break;
+    }
+    case NodeType::Scalar: {
+      const auto& scalarNode = node->impl<ScalarNode>();
+      key.scalarType = scalarNode.dataType();
+      key.scalarFp = scalarNode.scalar<double>();
+      key.scalarInt = scalarNode.scalar<long long>();
+      break;
+    }
+    case NodeType::Custom:
+    case NodeType::Index:
+    case NodeType::IndexedUpdate:
+    case NodeType::Value:
+      key.self = node.get();
+      break;
+  }
+  return key;
+}
+
+class CseContext {
+  std::unordered_map<NodeKey, NodePtr, NodeKeyHash> keyToRepresentative_;
+  std::unordered_set<NodePtr> visited_;
+
+ public:
+  // Canonicalize inputs bottom-up, then fold `node` into its representative
+  // if an identical subtree has been seen already.
+  NodePtr canonicalize(NodePtr node) {
+    if (visited_.find(node) != visited_.end()) {
+      return node;
+    }
+    visited_.insert(node);
+    for (const auto& input : node->inputs()) {
+      canonicalize(input);
+    }
+    // inputs may have been rewritten above, so key off the current ones
+    const auto key = makeKey(node);
+    const auto iter = keyToRepresentative_.find(key);
+    if (iter == keyToRepresentative_.end()) {
+      keyToRepresentative_.emplace(key, node);
+      return node;
+    }
+    const auto representative = iter->second;
+    if (representative != node) {
+      node->replaceAllUsesWith(representative);
+    }
+    return representative;
+  }
+};
+
+} // namespace
+
+NodePtr CommonSubexpressionElimination::apply(NodePtr node) {
+  CseContext context;
+  return context.canonicalize(node);
+}
+
+} // namespace fl
@@ -0,0 +1,38 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include "flashlight/fl/tensor/backend/jit/opt/Pass.h"
+
+namespace fl {
+
+/**
+ * A pass that deduplicates structurally identical subtrees within a JIT tree,
+ * so `Evaluator` materializes each distinct computation exactly once.
+ *
+ * Nodes are hashed bottom-up by node type, (already canonicalized) inputs and
+ * shape, plus type-specific payload (binary op kind, scalar value); duplicate
+ * nodes get all their uses rewritten to a single representative via
+ * `replaceAllUsesWith`.
+ *
+ *  c1  v2  c1' v2        c1  v2
+ *   \  /    \  /          \  /
+ *    add    add    --->    add
+ *      \    /              /  \
+ *       \  /               \  /
+ *        mul                mul
+ *
+ * NOTE `ValueNode` and `CustomNode` are compared by identity -- their
+ * evaluation results aren't derivable from graph structure alone.
+ */
+class CommonSubexpressionElimination : public Pass {
+ public:
+  NodePtr apply(NodePtr node) override;
+};
+
+} // namespace fl
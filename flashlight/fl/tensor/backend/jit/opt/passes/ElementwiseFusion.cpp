@@ -0,0 +1,241 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "flashlight/fl/tensor/backend/jit/opt/passes/ElementwiseFusion.h"
+
+#include <optional>
+
+#include "flashlight/fl/tensor/backend/jit/ir/BinaryNode.h"
+#include "flashlight/fl/tensor/backend/jit/ir/CustomNode.h"
+#include "flashlight/fl/tensor/backend/jit/ir/ScalarNode.h"
+
+namespace fl {
+
+namespace {
+
+// One step of a fused chain -- `accumulator = accumulator <op> operand`, where
+// the operand is either an input of the fused node or an embedded literal.
+struct FusedStep {
+  BinaryOp op;
+  // index into the fused node's inputs; nullopt iff operand is a literal
+  std::optional<unsigned> inputIdx;
+  double literal{0};
+};
+
+Tensor applyBinop(const BinaryOp op, const Tensor& lhs, const Tensor& rhs) {
+  switch (op) {
+    case BinaryOp::Add:
+      return lhs + rhs;
+    case BinaryOp::Sub:
+      return lhs - rhs;
+    case BinaryOp::Mul:
+      return lhs * rhs;
+    case BinaryOp::Div:
+      return lhs / rhs;
+    case BinaryOp::Eq:
+      return lhs == rhs;
+    case BinaryOp::Neq:
+      return lhs != rhs;
+    case BinaryOp::Gt:
+      return lhs > rhs;
+    case BinaryOp::Gte:
+      return lhs >= rhs;
+    case BinaryOp::Lt:
+      return lhs < rhs;
+    case BinaryOp::Lte:
+      return lhs <= rhs;
+    case BinaryOp::Min:
+      return minimum(lhs, rhs);
+    case BinaryOp::Max:
+      return maximum(lhs, rhs);
+    case BinaryOp::Pow:
+      return power(lhs, rhs);
+    case BinaryOp::Mod:
+      return lhs % rhs;
+    case BinaryOp::And:
+      return lhs && rhs;
+    case BinaryOp::Or:
+      return lhs || rhs;
+    case BinaryOp::Shl:
+      return lhs << rhs;
+    case BinaryOp::Shr:
+      return lhs >> rhs;
+    case BinaryOp::BitAnd:
+      return lhs & rhs;
+    case BinaryOp::BitOr:
+      return lhs | rhs;
+    case BinaryOp::BitXor:
+      return lhs ^ rhs;
+  }
+  throw std::runtime_error("[applyBinop] Unknown binary operation type");
+}
+
+Tensor applyBinop(const BinaryOp op, const Tensor& lhs, const double rhs) {
+  switch (op) {
+    case BinaryOp::Add:
+      return lhs + rhs;
+    case BinaryOp::Sub:
+      return lhs - rhs;
+    case BinaryOp::Mul:
+      return lhs * rhs;
+    case BinaryOp::Div:
+      return lhs / rhs;
+    case BinaryOp::Min:
+      return minimum(lhs, rhs);
+    case BinaryOp::Max:
+      return maximum(lhs, rhs);
+    case BinaryOp::Pow:
+      return power(lhs, rhs);
+    default:
+      throw std::runtime_error(
+          "[applyBinop] Binary operation doesn't support literal operand");
+  }
+}
+
+// Literal embedding must not lose precision -- restrict to arithmetic binops
+// over floating-point scalars, which a `double` literal represents exactly.
+bool isLiteralEmbeddable(const BinaryOp op, const NodePtr node) {
+  switch (op) {
+    case BinaryOp::Add:
+    case BinaryOp::Sub:
+    case BinaryOp::Mul:
+    case BinaryOp::Div:
+    case BinaryOp::Min:
+    case BinaryOp::Max:
+    case BinaryOp::Pow:
+      break;
+    default:
+      return false;
+  }
+  if (!node->isScalar()) {
+    return false;
+  }
+  const auto type = node->impl<ScalarNode>().dataType();
+  return type == dtype::f32 || type == dtype::f64;
+}
+
+bool isFusionProfitable(const NodePtr node) {
+  // Fusing a node with multiple uses would force recomputation per use.
+  return node->uses().size() + node->externalUses().size() <= 1;
+}
+
+bool shouldNodeBeFused(const NodePtr node) {
+  return node->isBinary() && isFusionProfitable(node);
+}
+
+} // namespace
+
+struct ElementwiseFusion::SearchState {
+  SearchState(NodePtr root) : searchRoot(root) {}
+  NodePtr searchRoot;
+  // Assume `searchRoot == binop2`
+  //
+  // x0  x1
+  //  \  /
+  //  binop1  x2
+  //     \  /
+  //    binop2
+  //
+  // accumulatedSteps: { { binop2->op(), x2 }, { binop1->op(), x1 } }
+  // where each operand is recorded as a fused-node input or a literal.
+  std::vector<FusedStep> accumulatedSteps;
+  std::vector<NodePtr> inputNodes;
+
+  void addOperand(const BinaryOp op, const NodePtr operand) {
+    if (isLiteralEmbeddable(op, operand)) {
+      accumulatedSteps.push_back(
+          {op, std::nullopt, operand->impl<ScalarNode>().scalar<double>()});
+    } else {
+      // input index is patched in `fuseNodes` once the leaf input is known
+      accumulatedSteps.push_back({op, inputNodes.size(), 0});
+      inputNodes.push_back(operand);
+    }
+  }
+};
+
+NodePtr ElementwiseFusion::rewriteFrom(NodePtr node) {
+  SearchState state(node);
+  auto fusedNode = searchAndFuse(node, state);
+  node->replaceAllUsesWith(fusedNode);
+  return fusedNode;
+}
+
+NodePtr ElementwiseFusion::searchAndFuse(NodePtr node, SearchState& state) {
+  // TODO for now we just skip shared input, need to think more.
+  if (visited_.find(node) != visited_.end() || !shouldNodeBeFused(node)) {
+    return fuseNodes(node, state);
+  }
+  visited_.insert(node);
+
+  const auto& binaryNode = node->impl<BinaryNode>();
+  const auto lhs = binaryNode.lhs();
+  const auto rhs = binaryNode.rhs();
+  const auto op = binaryNode.op();
+  state.addOperand(
+      op, rhs->isScalar() ? rhs : rewriteFrom(rhs));
+  return searchAndFuse(lhs, state);
+}
+
+NodePtr ElementwiseFusion::fuseNodes(NodePtr node, SearchState& state) {
+  for (const auto& input : node->inputs()) {
+    rewriteFrom(input);
+  }
+  // Nothing to fuse, it's one of the following:
+  // 1. node
+  //
+  // 2. node  ...
+  //      \  /
+  //    searchRoot
+  if (state.accumulatedSteps.size() < 2) {
+    return state.searchRoot;
+  }
+
+  // `node` is the deepest lhs leaf -- it becomes input 0, and the steps get
+  // reversed into execution (bottom-up) order, with input indices shifted past
+  // the leaf.
+  std::vector<NodePtr> inputNodes{node};
+  inputNodes.insert(
+      inputNodes.end(), state.inputNodes.begin(), state.inputNodes.end());
+  std::vector<FusedStep> steps;
+  for (auto it = state.accumulatedSteps.rbegin();
+       it != state.accumulatedSteps.rend();
+       it++) {
+    FusedStep step = *it;
+    if (step.inputIdx.has_value()) {
+      step.inputIdx = step.inputIdx.value() + 1;
+    }
+    steps.push_back(step);
+  }
+
+  auto evalFunc = [steps = std::move(steps)](
+                      const std::vector<const Tensor*>& inputs) {
+    Tensor accumulator = *inputs[0];
+    for (const auto& step : steps) {
+      if (step.inputIdx.has_value()) {
+        accumulator =
+            applyBinop(step.op, accumulator, *inputs[step.inputIdx.value()]);
+      } else {
+        accumulator = applyBinop(step.op, accumulator, step.literal);
+      }
+    }
+    return accumulator;
+  };
+
+  return CustomNode::create(
+      "FusedElementwiseOp",
+      std::move(inputNodes),
+      state.searchRoot->shape(),
+      std::move(evalFunc));
+}
+
+NodePtr ElementwiseFusion::apply(NodePtr root) {
+  auto optimizedRoot = rewriteFrom(root);
+  visited_.clear();
+  return optimizedRoot;
+}
+
+} // namespace fl
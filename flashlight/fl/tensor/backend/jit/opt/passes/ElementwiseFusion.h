@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <unordered_set>
+
+#include "flashlight/fl/tensor/backend/jit/ir/Node.h"
+#include "flashlight/fl/tensor/backend/jit/opt/Pass.h"
+
+namespace fl {
+
+/**
+ * A backend-agnostic pass that merges chains of elementwise binary operations
+ * into a single `CustomNode`, so `Evaluator` materializes the entire chain at
+ * once instead of one node (and one intermediate tensor) at a time.
+ *
+ * NOTE
+ * 1. like `OneDnnOpFusion`, we avoid recomputation -- fuse iff intermediate
+ *    nodes are _only_ used as input nodes in the chain.
+ * 2. scalar operands of arithmetic ops get folded into the fused evaluation
+ *    logic as literals, so they never get materialized as full tensors.
+ *
+ * n1  c2
+ *  \  /
+ *   b2   n3
+ *    \  /
+ *     b1
+ *
+ * -->
+ *
+ *      n1  n3
+ *       \  /
+ * ------------------ CustomNode evaluating the chain without per-node
+ * | t = n1 + 2     | materialization (c2 captured as a literal)
+ * | t = t * n3     |
+ * ------------------
+ */
+class ElementwiseFusion : public Pass {
+  struct SearchState;
+
+  // Avoid re-visit, since fuser only need to apply once to each node.
+  std::unordered_set<NodePtr> visited_{};
+
+  // 1. Fuse _along_ some path from `node`.
+  // 2. recursively optimize other inputs along the fused path.
+  NodePtr rewriteFrom(NodePtr node);
+
+  // keep searching for nodes to fuse starting from `node`
+  NodePtr searchAndFuse(NodePtr node, SearchState& state);
+
+  // Actual fusion of an op-chain, `node` is a leaf input.
+  NodePtr fuseNodes(NodePtr node, SearchState& state);
+
+ public:
+  ElementwiseFusion() = default;
+  ~ElementwiseFusion() override = default;
+
+  NodePtr apply(NodePtr root) override;
+};
+
+} // namespace fl
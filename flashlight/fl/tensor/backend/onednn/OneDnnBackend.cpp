@@ -20,6 +20,10 @@
 #include <unordered_set>
 #include <vector>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 #include "flashlight/fl/tensor/TensorBase.h"
 #include "flashlight/fl/tensor/backend/onednn/OneDnnTensor.h"
 #include "flashlight/fl/tensor/backend/onednn/Utils.h"
@@ -451,6 +455,10 @@ const dnnl::engine& OneDnnBackend::cpuEngine() const {
   return engine_;
 }
 
+OneDnnPrimitiveCache& OneDnnBackend::primitiveCache() {
+  return primitiveCache_;
+}
+
 /* -------------------------- Compute Functions -------------------------- */
 
 void OneDnnBackend::eval(const Tensor& /* tensor */) {
@@ -484,6 +492,38 @@ void OneDnnBackend::setMemMgrFlushInterval(const size_t /* interval */) {
       "[OneDnnBackend] Currently no memory manager support");
 }
 
+void OneDnnBackend::setIntraOpNumThreads(const int numThreads) {
+  TensorBackend::setIntraOpNumThreads(numThreads);
+#ifdef _OPENMP
+  // OneDNN CPU primitives run on the OpenMP runtime by default, so bounding
+  // the OpenMP team bounds the per-op thread count
+  if (numThreads > 0) {
+    omp_set_num_threads(numThreads);
+  }
+#endif
+}
+
+/* -------------------------- External Memory -------------------------- */
+
+Tensor OneDnnBackend::fromExternalBuffer(
+    const Shape& shape,
+    fl::dtype type,
+    void* ptr,
+    Location memoryLocation,
+    std::function<void()> deleter) {
+  // TODO handle Location::Device once we add CL support
+  if (memoryLocation != Location::Host) {
+    throw std::invalid_argument(
+        "[OneDnnBackend::fromExternalBuffer] external buffer must be on host");
+  }
+  auto memDesc = detail::oneDnnContiguousMemDescFromShape(
+      shape, detail::flToOneDnnType(type));
+  // non-owning memory over the caller's buffer; the guard fires once the last
+  // tensor sharing it is destroyed
+  dnnl::memory memory(memDesc, engine_, ptr);
+  return toTensor<OneDnnTensor>(shape, std::move(memory), std::move(deleter));
+}
+
 /* -------------------------- Rand Functions -------------------------- */
 
 void OneDnnBackend::setSeed(const int seed) {
@@ -658,15 +698,25 @@ Tensor OneDnnBackend::reshape(const Tensor& tensor, const Shape& shape) {
   auto reshapedMem = dnnl::memory(reshapedMemDesc, engine_);
 
   // prepare primitive (use reorder to do a copy)
-  const auto reorderPrimitiveDesc =
-      dnnl::reorder::primitive_desc(engine_, memDesc, engine_, memDesc);
-  const auto reorderPrimitive = dnnl::reorder(reorderPrimitiveDesc);
+  const auto cacheKey = OneDnnPrimitiveCache::Key("reorder").add(memDesc);
+  const auto reorderPrimitive = primitiveCache_.get(cacheKey, [&]() {
+    return dnnl::reorder(
+        dnnl::reorder::primitive_desc(engine_, memDesc, engine_, memDesc));
+  });
 
   // execute primitive
   reorderPrimitive.execute(stream_->handle(), mem, reshapedMem);
   return toTensor<OneDnnTensor>(shape, std::move(reshapedMem));
 }
 
+// When the input layout is plain (strided without inner blocks), transpose is
+// a pure metadata change: we return a zero-copy view whose memory descriptor
+// has the axes permuted. Downstream primitives consume strided layouts
+// directly, so the data movement is deferred until a genuine layout boundary
+// (e.g., host read, contiguous copy). NOTE like indexing, such a view shares
+// the underlying memory with the input.
+//
+// Otherwise we fall back to materializing the transposed data:
 // 1. OneDNN doesn't have native support for tensor transpose.
 // 2. `reorder` is the best primitive to move data in this case.
 // 3. `reorder` requires same dims for input & output.
@@ -717,10 +767,23 @@ Tensor OneDnnBackend::transpose(
         " for shape: " + tensor.shape().toString());
   }
 
-  // prepare memories
   auto& srcTensor = toOneDnnTensor(tensor);
-  auto& srcMem = srcTensor.memory();
   const auto& srcMemDesc = srcTensor.memoryDesc();
+  if (srcMemDesc.get_format_kind() == dnnl::memory::format_kind::blocked &&
+      srcMemDesc.get_inner_nblks() == 0) {
+    // recall that internal dims are reversed from the logical col-major axes
+    const auto ndim = tensor.ndim();
+    std::vector<int> memAxesPermutation(ndim);
+    for (int newAxis = 0; newAxis < ndim; newAxis++) {
+      const auto oldAxis = oldToNewAxes[newAxis];
+      memAxesPermutation[ndim - 1 - oldAxis] = ndim - 1 - newAxis;
+    }
+    return srcTensor.view(
+        newShape, srcMemDesc.permute_axes(memAxesPermutation));
+  }
+
+  // prepare memories
+  auto& srcMem = srcTensor.memory();
   const auto type = srcMemDesc.get_data_type();
   const auto srcMemDims = srcMemDesc.get_dims();
   const auto dstMemDesc =
@@ -732,9 +795,13 @@ Tensor OneDnnBackend::transpose(
       getStridesAfterPermuteAxes(srcMemDims, oldToNewAxes);
   const auto reorderDstMemDesc =
       dnnl::memory::desc(srcMemDims, type, reorderDstStrides);
-  const auto reorderPrimitiveDesc = dnnl::reorder::primitive_desc(
-      engine_, srcMemDesc, engine_, reorderDstMemDesc);
-  const auto reorderPrimitive = dnnl::reorder(reorderPrimitiveDesc);
+  const auto cacheKey = OneDnnPrimitiveCache::Key("reorder")
+                            .add(srcMemDesc)
+                            .add(reorderDstMemDesc);
+  const auto reorderPrimitive = primitiveCache_.get(cacheKey, [&]() {
+    return dnnl::reorder(dnnl::reorder::primitive_desc(
+        engine_, srcMemDesc, engine_, reorderDstMemDesc));
+  });
 
   // execute primitive
   reorderPrimitive.execute(stream_->handle(), srcMem, dstMem);
@@ -778,6 +845,11 @@ Tensor OneDnnBackend::tile(const Tensor& tensor, const Shape& tileDims) {
       currTiledMem = newTiledMem;
     }
   }
+  if (currTiledMem == srcTensor.memory()) {
+    // no tiling was needed -- return a zero-copy view with the padded shape,
+    // which also retains the layout (e.g., offsets) if the input was a view
+    return srcTensor.view(Shape(finalDims), currTiledMemDesc);
+  }
   return toTensor<OneDnnTensor>(Shape(finalDims), std::move(currTiledMem));
 }
 
@@ -968,15 +1040,22 @@ Tensor OneDnnBackend::applyEltwiseOp(
   auto dstMem = dnnl::memory(dstMemDesc, engine_);
 
   // prepare unary primitive
-  const auto unaryPrimitiveDesc = dnnl::eltwise_forward::primitive_desc(
-      engine_,
-      dnnl::prop_kind::forward_inference,
-      alg,
-      memDesc,
-      dstMemDesc,
-      alpha,
-      beta);
-  const auto unaryPrimitive = dnnl::eltwise_forward(unaryPrimitiveDesc);
+  const auto cacheKey = OneDnnPrimitiveCache::Key("eltwise")
+                            .add(static_cast<int>(alg))
+                            .add(alpha)
+                            .add(beta)
+                            .add(memDesc)
+                            .add(dstMemDesc);
+  const auto unaryPrimitive = primitiveCache_.get(cacheKey, [&]() {
+    return dnnl::eltwise_forward(dnnl::eltwise_forward::primitive_desc(
+        engine_,
+        dnnl::prop_kind::forward_inference,
+        alg,
+        memDesc,
+        dstMemDesc,
+        alpha,
+        beta));
+  });
 
   // prepare arguments.
   const std::unordered_map<int, dnnl::memory> args = {
@@ -1138,9 +1217,15 @@ Tensor OneDnnBackend::applyBinop(
   auto dstMem = dnnl::memory(outputDesc.dstMemDesc, engine_);
 
   // prepare primitive
-  const auto binaryPrimitiveDesc = dnnl::binary::primitive_desc(
-      engine_, alg, lhsMemDesc, rhsMemDesc, outputDesc.dstMemDesc);
-  const auto binaryPrimitive = dnnl::binary(binaryPrimitiveDesc);
+  const auto cacheKey = OneDnnPrimitiveCache::Key("binary")
+                            .add(static_cast<int>(alg))
+                            .add(lhsMemDesc)
+                            .add(rhsMemDesc)
+                            .add(outputDesc.dstMemDesc);
+  const auto binaryPrimitive = primitiveCache_.get(cacheKey, [&]() {
+    return dnnl::binary(dnnl::binary::primitive_desc(
+        engine_, alg, lhsMemDesc, rhsMemDesc, outputDesc.dstMemDesc));
+  });
 
   // prepare arguments
   const std::unordered_map<int, dnnl::memory> args = {
@@ -1240,9 +1325,14 @@ Tensor OneDnnBackend::matmul(
   auto& weightsMem = lhsMem;
 
   // prepare primitive
-  const auto matmulPrimitiveDesc = dnnl::matmul::primitive_desc(
-      engine_, srcMemDesc, weightsMemDesc, dstMemArgDesc);
-  const auto matmulPrimitive = dnnl::matmul(matmulPrimitiveDesc);
+  const auto cacheKey = OneDnnPrimitiveCache::Key("matmul")
+                            .add(srcMemDesc)
+                            .add(weightsMemDesc)
+                            .add(dstMemArgDesc);
+  const auto matmulPrimitive = primitiveCache_.get(cacheKey, [&]() {
+    return dnnl::matmul(dnnl::matmul::primitive_desc(
+        engine_, srcMemDesc, weightsMemDesc, dstMemArgDesc));
+  });
 
   // prepare arguments.
   const std::unordered_map<int, dnnl::memory> args = {
@@ -1562,14 +1652,19 @@ Tensor OneDnnBackend::applyReductionOp(
       dstShape, srcMemDesc.get_data_type());
 
   // prepare reduction primitive
-  const auto reductionPrimitiveDesc = dnnl::reduction::primitive_desc(
-      engine_, alg, srcMemDesc, dstArgMemDesc, 0, 0);
-  const auto reductionPrimitive = dnnl::reduction(reductionPrimitiveDesc);
+  const auto cacheKey = OneDnnPrimitiveCache::Key("reduction")
+                            .add(static_cast<int>(alg))
+                            .add(srcMemDesc)
+                            .add(dstArgMemDesc);
+  const auto reductionPrimitive = primitiveCache_.get(cacheKey, [&]() {
+    return dnnl::reduction(dnnl::reduction::primitive_desc(
+        engine_, alg, srcMemDesc, dstArgMemDesc, 0, 0));
+  });
 
   // prepare dst memories
   auto dstMemDesc = dstArgMemDesc;
   if (!keepDims) {
-    dstShape = Shape(detail::removeIndices(dstShape.get(), axesToReduce));
+    dstShape = Shape(detail::removeIndices<Dim>(dstShape.get(), axesToReduce));
     dstMemDesc = detail::oneDnnContiguousMemDescFromShape(
         dstShape, srcMemDesc.get_data_type());
   }
@@ -13,6 +13,7 @@
 #include <optional>
 
 #include "flashlight/fl/tensor/backend/onednn/OneDnnCPUStream.h"
+#include "flashlight/fl/tensor/backend/onednn/OneDnnPrimitiveCache.h"
 
 #if FL_USE_MKL_RNG
   #include <mkl_vsl.h>
@@ -28,6 +29,9 @@ namespace fl {
 class OneDnnBackend : public TensorBackend {
   dnnl::engine engine_;
   std::shared_ptr<OneDnnCPUStream> stream_;
+  // Primitive creation is far more expensive than execution for small inputs;
+  // repeated op configurations reuse their primitives through this cache.
+  OneDnnPrimitiveCache primitiveCache_;
 #if FL_USE_MKL_RNG
   VSLStreamStatePtr randStream_;
 #else
@@ -103,6 +107,16 @@ class OneDnnBackend : public TensorBackend {
    */
   const dnnl::engine& cpuEngine() const;
 
+  /**
+   * Gets the backend's primitive cache. The cache is populated as ops run;
+   * to pre-warm it before serving traffic, run a representative input
+   * through the model once - primitives depend only on op configuration,
+   * not data.
+   *
+   * @return the primitive cache.
+   */
+  OneDnnPrimitiveCache& primitiveCache();
+
   /* -------------------------- Compute Functions -------------------------- */
   void eval(const Tensor& tensor) override;
   bool supportsDataType(const fl::dtype& dtype) const override;
@@ -112,6 +126,16 @@ class OneDnnBackend : public TensorBackend {
   void setMemMgrLogStream(std::ostream* stream) override;
   void setMemMgrLoggingEnabled(const bool enabled) override;
   void setMemMgrFlushInterval(const size_t interval) override;
+  // CPU parallelism - bounds the OpenMP team OneDNN CPU primitives run on
+  void setIntraOpNumThreads(const int numThreads) override;
+
+  /* -------------------------- External Memory -------------------------- */
+  Tensor fromExternalBuffer(
+      const Shape& shape,
+      fl::dtype type,
+      void* ptr,
+      Location memoryLocation,
+      std::function<void()> deleter) override;
 
   /* -------------------------- Rand Functions -------------------------- */
   void setSeed(const int seed) override;
@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "flashlight/fl/tensor/backend/onednn/OneDnnPrimitiveCache.h"
+
+namespace fl {
+
+namespace {
+
+void appendValue(std::string& key, long long value) {
+  key += ':';
+  key += std::to_string(value);
+}
+
+} // namespace
+
+OneDnnPrimitiveCache::Key::Key(const char* opTag) : key_(opTag) {}
+
+OneDnnPrimitiveCache::Key& OneDnnPrimitiveCache::Key::add(int value) {
+  appendValue(key_, value);
+  return *this;
+}
+
+OneDnnPrimitiveCache::Key& OneDnnPrimitiveCache::Key::add(float value) {
+  key_ += ':';
+  key_ += std::to_string(value);
+  return *this;
+}
+
+OneDnnPrimitiveCache::Key& OneDnnPrimitiveCache::Key::add(
+    const dnnl::memory::desc& memDesc) {
+  appendValue(key_, static_cast<int>(memDesc.get_data_type()));
+  appendValue(key_, static_cast<int>(memDesc.get_format_kind()));
+  for (const auto dim : memDesc.get_dims()) {
+    appendValue(key_, dim);
+  }
+  if (memDesc.get_format_kind() == dnnl::memory::format_kind::blocked) {
+    for (const auto stride : memDesc.get_strides()) {
+      appendValue(key_, stride);
+    }
+  }
+  return *this;
+}
+
+const std::string& OneDnnPrimitiveCache::Key::str() const {
+  return key_;
+}
+
+size_t OneDnnPrimitiveCache::size() const {
+  return cache_.size();
+}
+
+void OneDnnPrimitiveCache::clear() {
+  cache_.clear();
+}
+
+} // namespace fl
@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include <dnnl.hpp>
+
+#include "flashlight/fl/common/LRUCache.h"
+
+namespace fl {
+
+/**
+ * A cache of OneDNN primitives keyed by op configuration.
+ *
+ * Creating a dnnl primitive involves primitive descriptor creation and kernel
+ * generation - typically hundreds of microseconds, often far more than
+ * executing the primitive itself on small inputs. Ops that repeatedly run the
+ * same configuration (shapes, types, algorithm) should build a `Key`
+ * describing it and fetch the primitive through `get`, which constructs it
+ * only on the first call.
+ *
+ * The cache is populated by running ops; warming it up before serving
+ * traffic amounts to running a representative input through the model once
+ * (primitives depend only on op configuration, not data).
+ *
+ * Storage is a sharded `fl::LRUCache`, so concurrent ops on different
+ * configurations don't serialize on one mutex, and pathological workloads
+ * that never repeat a configuration stay bounded instead of growing without
+ * limit.
+ */
+class OneDnnPrimitiveCache {
+ public:
+  /**
+   * Incrementally builds a cache key from op configuration components. The
+   * op tag must be unique per op kind to avoid collisions between ops with
+   * identical descriptors.
+   */
+  class Key {
+   public:
+    explicit Key(const char* opTag);
+
+    Key& add(int value); // also covers dnnl enum classes via a cast
+    Key& add(float value);
+    Key& add(const dnnl::memory::desc& memDesc);
+
+    const std::string& str() const;
+
+   private:
+    std::string key_;
+  };
+
+  /**
+   * Returns the primitive cached under the given key, invoking `create` to
+   * build it on a miss. Any dnnl primitive kind can be stored; execution
+   * through the base `dnnl::primitive` is equivalent.
+   */
+  template <typename Factory>
+  dnnl::primitive get(const Key& key, Factory&& create) {
+    return *cache_.getOrPut(key.str(), [&create]() {
+      return std::make_shared<dnnl::primitive>(create());
+    });
+  }
+
+  /**
+   * The number of cached primitives.
+   */
+  size_t size() const;
+
+  /**
+   * Removes all cached primitives.
+   */
+  void clear();
+
+ private:
+  // bound on cached primitives, evicted least-recently-used first
+  static constexpr size_t kMaxPrimitives = 4096;
+
+  LRUCache<std::string, dnnl::primitive> cache_{kMaxPrimitives};
+};
+
+} // namespace fl
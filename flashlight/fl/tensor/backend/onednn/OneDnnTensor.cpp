@@ -11,7 +11,6 @@
 #include <cassert>
 #include <cstring>
 #include <memory>
-#include <numeric>
 #include <sstream>
 #include <stdexcept>
 
@@ -116,6 +115,9 @@ OneDnnTensor::SharedData::~SharedData() {
   assert(
       !isDevicePtrLocked &&
       "Must unlock device pointer before OneDnnTensor destruction.");
+  if (bufferGuard) {
+    bufferGuard();
+  }
 }
 
 OneDnnTensor::OneDnnTensor(
@@ -142,11 +144,15 @@ unsigned OneDnnTensor::getSizeInBytes() const {
   return numElems * typeSize;
 }
 
-OneDnnTensor::OneDnnTensor(const Shape& shape, dnnl::memory&& memory) {
+OneDnnTensor::OneDnnTensor(
+    const Shape& shape,
+    dnnl::memory&& memory,
+    std::function<void()> bufferGuard) {
   sharedData_ = std::make_shared<SharedData>();
   shape_ = shape;
   memDesc_ = memory.get_desc();
   sharedData_->memory = std::move(memory);
+  sharedData_->bufferGuard = std::move(bufferGuard);
 }
 
 OneDnnTensor::OneDnnTensor()
@@ -304,10 +310,17 @@ bool OneDnnTensor::isContiguous() {
   if (shape.ndim() == 0) { // scalar
     return true;
   }
-  const auto& dims = shape.get();
-  const auto leadingStride =
-      std::accumulate(dims.begin(), dims.end() - 1, 1, std::multiplies<Dim>());
-  return this->strides().get().back() == leadingStride;
+  // all strides must be dense -- views from indexing or transposition may have
+  // non-dense or permuted strides over the underlying memory
+  const auto strides = this->strides();
+  Dim expectedStride = 1;
+  for (int axis = 0; axis < shape.ndim(); axis++) {
+    if (strides[axis] != expectedStride) {
+      return false;
+    }
+    expectedStride *= shape[axis];
+  }
+  return true;
 }
 
 Shape OneDnnTensor::strides() {
@@ -684,6 +697,10 @@ const dnnl::memory::desc& OneDnnTensor::memoryDesc() const {
   return memDesc_;
 }
 
+Tensor OneDnnTensor::view(const Shape& shape, const dnnl::memory::desc& memDesc) {
+  return toTensor<OneDnnTensor>(sharedData_, shape, memDesc);
+}
+
 OneDnnTensor& toOneDnnTensor(const Tensor& tensor) {
   auto type = tensor.backendType();
   if (type != TensorBackendType::OneDnn) {
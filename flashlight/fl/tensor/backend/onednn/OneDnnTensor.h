@@ -10,6 +10,7 @@
 #include "flashlight/fl/tensor/TensorAdapter.h"
 #include "flashlight/fl/tensor/backend/onednn/OneDnnBackend.h"
 
+#include <functional>
 #include <memory>
 
 #include <dnnl.hpp>
@@ -53,6 +54,9 @@ class OneDnnTensor : public TensorAdapterBase {
     // Whether the data in `memory` is ready (its computation finished).
     bool isDataReady{false};
     bool isDevicePtrLocked{false};
+    // Invoked on destruction when `memory` wraps an external buffer whose
+    // lifetime is managed by the caller. See `Tensor::fromExternalBuffer`.
+    std::function<void()> bufferGuard;
 
     ~SharedData();
   };
@@ -96,8 +100,13 @@ class OneDnnTensor : public TensorAdapterBase {
    *
    * @param[in] shape the shape of the new tensor
    * @param[in] memory the memory handle containing underlying tensor data
+   * @param[in] bufferGuard optionally invoked once the last tensor sharing
+   * `memory` is destroyed; used when `memory` wraps a caller-owned buffer
    */
-  OneDnnTensor(const Shape& shape, dnnl::memory&& memory);
+  OneDnnTensor(
+      const Shape& shape,
+      dnnl::memory&& memory,
+      std::function<void()> bufferGuard = nullptr);
 
   /**
    * Construct an empty OneDNNTensor.
@@ -204,6 +213,17 @@ class OneDnnTensor : public TensorAdapterBase {
    * @return an immutable reference to the underlying OneDNN memory descriptro.
    */
   const dnnl::memory::desc& memoryDesc() const;
+
+  /**
+   * Create a view of this tensor over the same underlying memory, i.e., no
+   * data movement. For internal use only.
+   *
+   * @param[in] shape Flashlight shape of the view
+   * @param[in] memDesc OneDNN memory descriptor for the view; must have the
+   * same data type as the current memory descriptor
+   * @return a Tensor that shares the underlying memory of this tensor.
+   */
+  Tensor view(const Shape& shape, const dnnl::memory::desc& memDesc);
 };
 
 // Safe to drop `const`, as these are just checked version of `Tensor::impl`
@@ -10,6 +10,7 @@
 #include "flashlight/fl/tensor/Compute.h"
 #include "flashlight/fl/tensor/Init.h"
 #include "flashlight/fl/tensor/Random.h"
+#include "flashlight/fl/tensor/ScalarFuture.h"
 #include "flashlight/fl/tensor/Shape.h"
 #include "flashlight/fl/tensor/TensorBase.h"
 #include "flashlight/fl/tensor/Types.h"
@@ -119,6 +119,50 @@ TEST(AutogradBinaryOpsTest, CrossEntropy) {
       std::invalid_argument);
 }
 
+TEST(AutogradBinaryOpsTest, SoftmaxCrossEntropy) {
+  auto x = Variable(fl::rand({7, 10, 4}, fl::dtype::f64), true);
+  auto y = Variable(
+      (fl::rand({10, 4}, fl::dtype::u32) % 7).astype(fl::dtype::s32), false);
+  auto ignoreIdx = y(0, 0).scalar<int>();
+
+  // without smoothing, fuses what logSoftmax + categoricalCrossEntropy
+  // compute in two passes
+  std::vector<ReduceMode> modes = {
+      ReduceMode::NONE, ReduceMode::SUM, ReduceMode::MEAN};
+  for (auto mode : modes) {
+    auto fused = softmaxCrossEntropy(x, y, 0.0, mode, ignoreIdx);
+    auto composed =
+        categoricalCrossEntropy(logSoftmax(x, 0), y, mode, ignoreIdx);
+    ASSERT_TRUE(allClose(fused.tensor(), composed.tensor(), 1e-10));
+
+    auto func = [&](Variable& input) {
+      return softmaxCrossEntropy(input, y, 0.1, mode, ignoreIdx);
+    };
+    ASSERT_TRUE(fl::detail::jacobianTestImpl(func, x, 1E-5));
+  }
+
+  // smoothed loss mixes the target term with a uniform term over classes
+  const double eps = 0.2;
+  const int C = 7;
+  auto lp = logSoftmax(x, 0).tensor();
+  auto targetLogProb = -categoricalCrossEntropy(
+                            Variable(lp, false), y, ReduceMode::NONE)
+                            .tensor();
+  auto reference =
+      -(1.0 - eps) * targetLogProb - (eps / C) * fl::sum(lp, {0});
+  auto smoothed = softmaxCrossEntropy(x, y, eps, ReduceMode::NONE);
+  ASSERT_TRUE(allClose(smoothed.tensor(), reference, 1e-10));
+
+  ASSERT_THROW(
+      softmaxCrossEntropy(x, y, /* labelSmoothing = */ 1.0),
+      std::invalid_argument);
+  ASSERT_THROW(
+      softmaxCrossEntropy(
+          Variable(fl::rand({4, 5, 6}), false),
+          Variable(fl::rand({5, 8}), false)),
+      std::invalid_argument);
+}
+
 TEST(AutogradBinaryOpsTest, Linear) {
   std::vector<int> batchsizes = {1, 5};
   for (auto b : batchsizes) {
@@ -134,6 +178,43 @@ TEST(AutogradBinaryOpsTest, Linear) {
   }
 }
 
+TEST(AutogradBinaryOpsTest, LinearEpilogue) {
+  auto in = Variable(fl::rand({4, 5, 2}, fl::dtype::f64) * 2 - 1, true);
+  auto wt = Variable(fl::rand({6, 4}, fl::dtype::f64) * 2 - 1, true);
+  auto bs = Variable(fl::rand({6}, fl::dtype::f64) * 2 - 1, true);
+
+  // NONE ignores the bias
+  ASSERT_TRUE(allClose(
+      linear(in, wt, bs, Epilogue::NONE).tensor(), linear(in, wt).tensor()));
+
+  for (auto epilogue :
+       {Epilogue::BIAS, Epilogue::BIAS_RELU, Epilogue::BIAS_GELU}) {
+    auto inRef = Variable(in.tensor().copy(), true);
+    auto wtRef = Variable(wt.tensor().copy(), true);
+    auto bsRef = Variable(bs.tensor().copy(), true);
+    auto ref = linear(inRef, wtRef, bsRef);
+    if (epilogue == Epilogue::BIAS_RELU) {
+      ref = relu(ref);
+    } else if (epilogue == Epilogue::BIAS_GELU) {
+      ref = gelu(ref);
+    }
+
+    auto out = linear(in, wt, bs, epilogue);
+    ASSERT_TRUE(allClose(out.tensor(), ref.tensor(), 1e-7));
+
+    // fused backward matches the composed linear + activation lowering
+    auto grad = Variable(fl::rand(out.shape(), fl::dtype::f64), false);
+    in.zeroGrad();
+    wt.zeroGrad();
+    bs.zeroGrad();
+    out.backward(grad);
+    ref.backward(grad);
+    ASSERT_TRUE(allClose(in.grad().tensor(), inRef.grad().tensor(), 1e-7));
+    ASSERT_TRUE(allClose(wt.grad().tensor(), wtRef.grad().tensor(), 1e-7));
+    ASSERT_TRUE(allClose(bs.grad().tensor(), bsRef.grad().tensor(), 1e-7));
+  }
+}
+
 TEST_F(AutogradTestF16, LinearF16) {
   if (!fl::f16Supported()) {
     GTEST_SKIP() << "Half-precision not supported on this device";
@@ -175,6 +256,36 @@ TEST(AutogradBinaryOpsTest, MultiplyAdd) {
   ASSERT_TRUE(allClose(dy.tensor(), 2 * y.tensor() + x.tensor()));
 }
 
+TEST(AutogradBinaryOpsTest, AddInPlace) {
+  auto x = Variable(fl::rand({5}), true);
+  auto y = Variable(fl::rand({5}), true);
+  auto xTensorCopy = x.tensor().copy();
+
+  auto sum = x * 1.0; // writable intermediate; x's tensor is left intact
+  auto z = addInPlace(sum, y);
+  ASSERT_TRUE(allClose(z.tensor(), xTensorCopy + y.tensor()));
+
+  auto dz = Variable(fl::full({5}, 1.0), false);
+  z.backward(dz);
+  ASSERT_TRUE(allClose(x.grad().tensor(), fl::full({5}, 1.0)));
+  ASSERT_TRUE(allClose(y.grad().tensor(), fl::full({5}, 1.0)));
+}
+
+TEST(AutogradBinaryOpsTest, AddMul) {
+  auto x = Variable(fl::rand({5}, fl::dtype::f64), true);
+  auto y = Variable(fl::rand({5}, fl::dtype::f64), true);
+  auto z = Variable(fl::rand({5}, fl::dtype::f64), true);
+  ASSERT_TRUE(allClose(
+      addMul(x, y, z).tensor(), x.tensor() + y.tensor() * z.tensor()));
+
+  auto funcAddMulX = [&](Variable& in) { return addMul(in, y, z); };
+  ASSERT_TRUE(fl::detail::jacobianTestImpl(funcAddMulX, x));
+  auto funcAddMulY = [&](Variable& in) { return addMul(x, in, z); };
+  ASSERT_TRUE(fl::detail::jacobianTestImpl(funcAddMulY, y));
+  auto funcAddMulZ = [&](Variable& in) { return addMul(x, y, in); };
+  ASSERT_TRUE(fl::detail::jacobianTestImpl(funcAddMulZ, z));
+}
+
 TEST(AutogradBinaryOpsTest, MultiplyAddScalar) {
   auto x = Variable(fl::rand({5}), true);
   auto y = Variable(fl::rand({5}), true);
@@ -280,6 +391,61 @@ TEST(AutogradBinaryOpsTest, matmul) {
   }
 }
 
+TEST(AutogradBinaryOpsTest, einsum) {
+  auto a = Variable(fl::rand({5, 4}, fl::dtype::f64), true);
+  auto b = Variable(fl::rand({4, 6}, fl::dtype::f64), true);
+
+  // plain matmul, with and without an explicit output
+  ASSERT_TRUE(
+      allClose(einsum("ij,jk->ik", {a, b}).tensor(), matmul(a, b).tensor()));
+  ASSERT_TRUE(
+      allClose(einsum("ij,jk", {a, b}).tensor(), matmul(a, b).tensor()));
+
+  // transposed layouts fold into the GEMM
+  auto aT = Variable(fl::transpose(a.tensor()), true);
+  auto bT = Variable(fl::transpose(b.tensor()), true);
+  ASSERT_TRUE(
+      allClose(einsum("ji,jk->ik", {aT, b}).tensor(), matmul(a, b).tensor()));
+  ASSERT_TRUE(
+      allClose(einsum("ij,kj->ik", {a, bT}).tensor(), matmul(a, b).tensor()));
+
+  // transposed output and reductions
+  ASSERT_TRUE(allClose(
+      einsum("ij,jk->ki", {a, b}).tensor(),
+      transpose(matmul(a, b)).tensor()));
+  ASSERT_TRUE(
+      allClose(einsum("ij->j", {a}).tensor(), sum(a, {0}).tensor()));
+  ASSERT_TRUE(allClose(
+      einsum("ij,jk->k", {a, b}).tensor(), sum(matmul(a, b), {0}).tensor()));
+
+  // batched attention-style contraction over a shared head dimension
+  auto q = Variable(fl::rand({7, 8, 3}, fl::dtype::f64), true);
+  auto k = Variable(fl::rand({9, 8, 3}, fl::dtype::f64), true);
+  ASSERT_TRUE(allClose(
+      einsum("tdb,udb->tub", {q, k}).tensor(), matmulNT(q, k).tensor()));
+
+  // three operands - planned pairwise, same result as left association
+  auto c = Variable(fl::rand({6, 2}, fl::dtype::f64), true);
+  ASSERT_TRUE(allClose(
+      einsum("ij,jk,kl->il", {a, b, c}).tensor(),
+      matmul(matmul(a, b), c).tensor()));
+
+  // gradients flow through the composed ops
+  auto funcEinsumLhs = [&](Variable& input) {
+    return einsum("tdb,udb->tub", {input, k});
+  };
+  ASSERT_TRUE(fl::detail::jacobianTestImpl(funcEinsumLhs, q, 1E-6));
+  auto funcEinsumRhs = [&](Variable& input) {
+    return einsum("tdb,udb->tub", {q, input});
+  };
+  ASSERT_TRUE(fl::detail::jacobianTestImpl(funcEinsumRhs, k, 1E-6));
+
+  ASSERT_THROW(einsum("ij,jk->ik", {a}), std::invalid_argument);
+  ASSERT_THROW(einsum("ii->i", {a}), std::invalid_argument);
+  ASSERT_THROW(einsum("ij,ik->jk", {a, b}), std::invalid_argument);
+  ASSERT_THROW(einsum("ij,jk->iq", {a, b}), std::invalid_argument);
+}
+
 TEST(AutogradNormalizationTest, WeightNormLinear) {
   auto v = Variable(fl::rand({3, 2}), true);
   auto normDim = {1};
@@ -134,6 +134,44 @@ TEST_F(AutogradTestF16, ConvolveF16) {
   ASSERT_TRUE(fl::detail::jacobianTestImpl(funcConvBs, bs, 3e-2, 0.1));
 }
 
+TEST(AutogradConv2DTest, ConvolveEpilogue) {
+  auto in = Variable(fl::rand({8, 8, 3, 2}, fl::dtype::f32) * 2 - 1, true);
+  auto wt = Variable(fl::rand({3, 3, 3, 4}, fl::dtype::f32) * 2 - 1, true);
+  auto bs = Variable(fl::rand({1, 1, 4, 1}, fl::dtype::f32) * 2 - 1, true);
+
+  // NONE ignores the bias
+  ASSERT_TRUE(allClose(
+      conv2d(in, wt, bs, 1, 1, 1, 1, 1, 1, 1, Epilogue::NONE).tensor(),
+      conv2d(in, wt, 1, 1, 1, 1, 1, 1, 1).tensor()));
+
+  for (auto epilogue :
+       {Epilogue::BIAS, Epilogue::BIAS_RELU, Epilogue::BIAS_GELU}) {
+    auto inRef = Variable(in.tensor().copy(), true);
+    auto wtRef = Variable(wt.tensor().copy(), true);
+    auto bsRef = Variable(bs.tensor().copy(), true);
+    auto ref = conv2d(inRef, wtRef, bsRef, 1, 1, 1, 1, 1, 1, 1);
+    if (epilogue == Epilogue::BIAS_RELU) {
+      ref = relu(ref);
+    } else if (epilogue == Epilogue::BIAS_GELU) {
+      ref = gelu(ref);
+    }
+
+    auto out = conv2d(in, wt, bs, 1, 1, 1, 1, 1, 1, 1, epilogue);
+    ASSERT_TRUE(allClose(out.tensor(), ref.tensor(), 1e-4));
+
+    // fused backward matches the composed conv + activation lowering
+    auto grad = Variable(fl::rand(out.shape(), fl::dtype::f32), false);
+    in.zeroGrad();
+    wt.zeroGrad();
+    bs.zeroGrad();
+    out.backward(grad);
+    ref.backward(grad);
+    ASSERT_TRUE(allClose(in.grad().tensor(), inRef.grad().tensor(), 1e-4));
+    ASSERT_TRUE(allClose(wt.grad().tensor(), wtRef.grad().tensor(), 1e-4));
+    ASSERT_TRUE(allClose(bs.grad().tensor(), bsRef.grad().tensor(), 1e-4));
+  }
+}
+
 TEST(AutogradConv2DTest, ConvolveFilterGroups) {
   int channel = 8;
   int groups = 2;
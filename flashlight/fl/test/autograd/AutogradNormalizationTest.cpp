@@ -225,6 +225,58 @@ TEST(AutogradNormalizationTest, BatchNormTrainModeOutputMultipleAxis) {
   }
 }
 
+TEST(AutogradNormalizationTest, BatchNormRunningStatsUpdate) {
+  int numFeat = 3;
+  std::vector<int> featAxes = {2};
+  double momentum = 0.1;
+  auto input = Variable(fl::rand({13, 13, numFeat, 8}), false);
+  auto initMean = fl::rand({numFeat});
+  auto initVar = fl::rand({numFeat}) + 1.0;
+  auto runningMean = Variable(initMean.copy(), false);
+  auto runningVar = Variable(initVar.copy(), false);
+
+  batchnorm(
+      input,
+      Variable(),
+      Variable(),
+      runningMean,
+      runningVar,
+      featAxes,
+      true,
+      momentum,
+      1E-5);
+
+  // running = (1 - momentum) * running + momentum * batch; the variance
+  // tolerance absorbs backends that track the unbiased batch variance
+  std::vector<int> nrmAxes = {0, 1, 3};
+  auto batchMean = fl::mean(input.tensor(), nrmAxes).flatten();
+  auto batchVar = fl::var(input.tensor(), nrmAxes, true).flatten();
+  ASSERT_TRUE(allClose(
+      runningMean.tensor(),
+      (1 - momentum) * initMean + momentum * batchMean,
+      1E-4));
+  ASSERT_TRUE(allClose(
+      runningVar.tensor(),
+      (1 - momentum) * initVar + momentum * batchVar,
+      1E-3));
+
+  // eval mode consumes the updated running stats and leaves them unchanged
+  auto evalMean = runningMean.tensor().copy();
+  auto evalVar = runningVar.tensor().copy();
+  batchnorm(
+      input,
+      Variable(),
+      Variable(),
+      runningMean,
+      runningVar,
+      featAxes,
+      false,
+      momentum,
+      1E-5);
+  ASSERT_TRUE(allClose(runningMean.tensor(), evalMean));
+  ASSERT_TRUE(allClose(runningVar.tensor(), evalVar));
+}
+
 TEST(AutogradNormalizationTest, BatchNormJacobian) {
   // Jacobian Test with trainMode = true;
 
@@ -408,6 +460,219 @@ TEST_F(AutogradTestF16, LayerNormJacobianF16) {
   ASSERT_TRUE(fl::detail::jacobianTestImpl(funcLnIn, input, 1e-4, 1e-2));
 }
 
+TEST(AutogradNormalizationTest, LayerNormFusedOutput) {
+  // stats computed over axes {0, 1, 2} for each element along axis 3
+  std::vector<int> featAxes = {3};
+  auto input = Variable(fl::rand({4, 4, 3, 5}), true);
+  auto weight = Variable(fl::rand({4, 4, 3, 1}), true);
+  auto bias = Variable(fl::rand({4, 4, 3, 1}), true);
+
+  auto out = layerNorm(input, weight, bias, featAxes, 1E-5);
+  ASSERT_EQ(out.shape(), input.shape());
+
+  // matches the composed batchnorm + affine lowering
+  Variable dummyMean, dummyVar;
+  auto normalized = batchnorm(
+      input,
+      Variable(Tensor(fl::dtype::f32), false),
+      Variable(Tensor(fl::dtype::f32), false),
+      dummyMean,
+      dummyVar,
+      featAxes,
+      true,
+      0.0,
+      1E-5);
+  auto expected = tileAs(weight, input) * normalized + tileAs(bias, input);
+  ASSERT_TRUE(allClose(out.tensor(), expected.tensor(), 1e-4));
+
+  // no affine transform when weight and bias are empty
+  auto plain = layerNorm(input, Variable(), Variable(), featAxes, 1E-5);
+  ASSERT_TRUE(allClose(plain.tensor(), normalized.tensor(), 1e-4));
+}
+
+TEST(AutogradNormalizationTest, LayerNormFusedJacobian) {
+  std::vector<int> featAxes = {3};
+  auto input = Variable(fl::rand({3, 3, 2, 4}), true);
+  auto weight = Variable(fl::rand({3, 3, 2, 1}), true);
+  auto bias = Variable(fl::rand({3, 3, 2, 1}), true);
+
+  auto funcLnIn = [&](Variable& in) {
+    return layerNorm(in, weight, bias, featAxes, 1E-5);
+  };
+  ASSERT_TRUE(fl::detail::jacobianTestImpl(funcLnIn, input, 1e-2, 1e-4));
+
+  auto funcLnWt = [&](Variable& wt) {
+    return layerNorm(input, wt, bias, featAxes, 1E-5);
+  };
+  ASSERT_TRUE(fl::detail::jacobianTestImpl(funcLnWt, weight, 1e-2, 1e-4));
+
+  auto funcLnBs = [&](Variable& bs) {
+    return layerNorm(input, weight, bs, featAxes, 1E-5);
+  };
+  ASSERT_TRUE(fl::detail::jacobianTestImpl(funcLnBs, bias, 1e-2, 1e-4));
+}
+
+TEST(AutogradNormalizationTest, LayerNormFusedEpilogue) {
+  std::vector<int> featAxes = {3};
+  auto input = Variable(fl::rand({4, 4, 3, 5}), true);
+  auto weight = Variable(fl::rand({4, 4, 3, 1}), true);
+  auto bias = Variable(fl::rand({4, 4, 3, 1}), true);
+
+  // fused epilogue matches the composed layerNorm + activation lowering, in
+  // both the forward and the backward pass
+  for (auto epilogue :
+       {Epilogue::BIAS_RELU, Epilogue::BIAS_GELU, Epilogue::BIAS_SWISH}) {
+    auto inRef = Variable(input.tensor().copy(), true);
+    auto wtRef = Variable(weight.tensor().copy(), true);
+    auto bsRef = Variable(bias.tensor().copy(), true);
+    auto ref = layerNorm(inRef, wtRef, bsRef, featAxes, 1E-5);
+    if (epilogue == Epilogue::BIAS_RELU) {
+      ref = relu(ref);
+    } else if (epilogue == Epilogue::BIAS_GELU) {
+      ref = gelu(ref);
+    } else {
+      ref = swish(ref, 1.);
+    }
+
+    auto out = layerNorm(input, weight, bias, featAxes, 1E-5, epilogue);
+    ASSERT_TRUE(allClose(out.tensor(), ref.tensor(), 1e-4));
+
+    auto grad = Variable(fl::rand(out.shape()), false);
+    input.zeroGrad();
+    weight.zeroGrad();
+    bias.zeroGrad();
+    out.backward(grad);
+    ref.backward(grad);
+    ASSERT_TRUE(allClose(input.grad().tensor(), inRef.grad().tensor(), 1e-4));
+    ASSERT_TRUE(allClose(weight.grad().tensor(), wtRef.grad().tensor(), 1e-4));
+    ASSERT_TRUE(allClose(bias.grad().tensor(), bsRef.grad().tensor(), 1e-4));
+  }
+}
+
+TEST(AutogradNormalizationTest, AddNorm) {
+  std::vector<int> featAxes = {3};
+  auto residual = Variable(fl::rand({4, 4, 3, 5}), true);
+  auto input = Variable(fl::rand({4, 4, 3, 5}), true);
+  auto weight = Variable(fl::rand({4, 4, 3, 1}), true);
+  auto bias = Variable(fl::rand({4, 4, 3, 1}), true);
+
+  // matches the composed add + layerNorm lowering, in both the forward and
+  // the backward pass
+  auto resRef = Variable(residual.tensor().copy(), true);
+  auto inRef = Variable(input.tensor().copy(), true);
+  auto wtRef = Variable(weight.tensor().copy(), true);
+  auto bsRef = Variable(bias.tensor().copy(), true);
+  auto ref = layerNorm(resRef + inRef, wtRef, bsRef, featAxes, 1E-5);
+
+  auto out = addNorm(residual, input, weight, bias, featAxes, 1E-5);
+  ASSERT_EQ(out.shape(), residual.shape());
+  ASSERT_TRUE(allClose(out.tensor(), ref.tensor(), 1e-4));
+
+  auto grad = Variable(fl::rand(out.shape()), false);
+  out.backward(grad);
+  ref.backward(grad);
+  ASSERT_TRUE(allClose(residual.grad().tensor(), resRef.grad().tensor(), 1e-4));
+  ASSERT_TRUE(allClose(input.grad().tensor(), inRef.grad().tensor(), 1e-4));
+  ASSERT_TRUE(allClose(weight.grad().tensor(), wtRef.grad().tensor(), 1e-4));
+  ASSERT_TRUE(allClose(bias.grad().tensor(), bsRef.grad().tensor(), 1e-4));
+
+  // no affine transform when weight and bias are empty
+  auto plain =
+      addNorm(residual, input, Variable(), Variable(), featAxes, 1E-5);
+  auto plainRef = layerNorm(
+      Variable(residual.tensor() + input.tensor(), false),
+      Variable(),
+      Variable(),
+      featAxes,
+      1E-5);
+  ASSERT_TRUE(allClose(plain.tensor(), plainRef.tensor(), 1e-4));
+
+  EXPECT_THROW(
+      addNorm(residual, input, weight, Variable(), featAxes, 1E-5),
+      std::invalid_argument);
+  EXPECT_THROW(
+      addNorm(
+          residual,
+          Variable(fl::rand({4, 4, 3, 2}), true),
+          weight,
+          bias,
+          featAxes,
+          1E-5),
+      std::invalid_argument);
+}
+
+TEST(AutogradNormalizationTest, AddNormJacobian) {
+  std::vector<int> featAxes = {3};
+  auto residual = Variable(fl::rand({3, 3, 2, 4}), true);
+  auto input = Variable(fl::rand({3, 3, 2, 4}), true);
+  auto weight = Variable(fl::rand({3, 3, 2, 1}), true);
+  auto bias = Variable(fl::rand({3, 3, 2, 1}), true);
+
+  auto funcRes = [&](Variable& res) {
+    return addNorm(res, input, weight, bias, featAxes, 1E-5);
+  };
+  ASSERT_TRUE(fl::detail::jacobianTestImpl(funcRes, residual, 1e-2, 1e-4));
+
+  auto funcIn = [&](Variable& in) {
+    return addNorm(residual, in, weight, bias, featAxes, 1E-5);
+  };
+  ASSERT_TRUE(fl::detail::jacobianTestImpl(funcIn, input, 1e-2, 1e-4));
+
+  auto funcWt = [&](Variable& wt) {
+    return addNorm(residual, input, wt, bias, featAxes, 1E-5);
+  };
+  ASSERT_TRUE(fl::detail::jacobianTestImpl(funcWt, weight, 1e-2, 1e-4));
+
+  auto funcBs = [&](Variable& bs) {
+    return addNorm(residual, input, weight, bs, featAxes, 1E-5);
+  };
+  ASSERT_TRUE(fl::detail::jacobianTestImpl(funcBs, bias, 1e-2, 1e-4));
+}
+
+TEST(AutogradNormalizationTest, AddDropoutNorm) {
+  std::vector<int> featAxes = {3};
+  auto residual = Variable(fl::rand({4, 4, 3, 5}), true);
+  auto input = Variable(fl::rand({4, 4, 3, 5}), true);
+  auto weight = Variable(fl::rand({4, 4, 3, 1}), true);
+  auto bias = Variable(fl::rand({4, 4, 3, 1}), true);
+
+  // p = 0 reduces to addNorm
+  auto out = addDropoutNorm(residual, input, 0.0, weight, bias, featAxes, 1E-5);
+  auto ref = addNorm(
+      Variable(residual.tensor(), false),
+      Variable(input.tensor(), false),
+      Variable(weight.tensor(), false),
+      Variable(bias.tensor(), false),
+      featAxes,
+      1E-5);
+  ASSERT_TRUE(allClose(out.tensor(), ref.tensor(), 1e-4));
+
+  // a fully-masked branch contributes nothing: with a zero sublayer branch
+  // the result matches the norm of the residual alone, for any mask
+  auto zero = Variable(fl::full(residual.shape(), 0.0), true);
+  auto dropped =
+      addDropoutNorm(residual, zero, 0.5, weight, bias, featAxes, 1E-5);
+  auto resOnly = layerNorm(
+      Variable(residual.tensor(), false),
+      Variable(weight.tensor(), false),
+      Variable(bias.tensor(), false),
+      featAxes,
+      1E-5);
+  ASSERT_TRUE(allClose(dropped.tensor(), resOnly.tensor(), 1e-4));
+
+  // backward runs and the branch gradient is the masked, rescaled sum
+  // gradient: zero where dropped, 1 / (1 - p) times the residual gradient
+  // where kept
+  residual.zeroGrad();
+  zero.zeroGrad();
+  dropped.backward(Variable(fl::rand(dropped.shape()), false));
+  auto gradRatio = zero.grad().tensor() / residual.grad().tensor();
+  ASSERT_TRUE(
+      fl::all(
+          (fl::abs(gradRatio) < 1e-5) || (fl::abs(gradRatio - 2.0) < 1e-3))
+          .asScalar<bool>());
+}
+
 int main(int argc, char** argv) {
   ::testing::InitGoogleTest(&argc, argv);
   fl::init();
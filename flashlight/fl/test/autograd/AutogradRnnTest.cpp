@@ -181,6 +181,110 @@ TEST(AutogradRnnTest, Gru) {
   testRnnImpl(RnnMode::GRU);
 }
 
+TEST(AutogradRnnTest, PackedSequences) {
+  if (FL_BACKEND_CPU) {
+    GTEST_SKIP() << "RNN gradient computation not yet supported on CPU";
+  }
+
+  int numLayers = 2;
+  int hiddenSize = 2;
+  int inputSize = 2;
+  int batchSize = 4;
+  int seqLength = 6;
+  bool bidirectional = true;
+  auto mode = RnnMode::LSTM;
+  // deliberately unsorted to exercise the sort/unsort path
+  std::vector<int> seqLengths = {3, 6, 2, 5};
+
+  auto in = Variable(
+      fl::rand({inputSize, batchSize, seqLength}, fl::dtype::f32), true);
+  auto w = Variable(fl::rand({224}, fl::dtype::f32), true);
+
+  ASSERT_THROW(
+      rnn(in,
+          Variable(),
+          Variable(),
+          w,
+          /* seqLengths = */ {seqLength},
+          hiddenSize,
+          numLayers,
+          mode,
+          bidirectional,
+          0.0),
+      std::invalid_argument);
+
+  std::tuple<Variable, Variable, Variable> packed;
+  try {
+    packed = rnn(
+        in,
+        Variable(),
+        Variable(),
+        w,
+        seqLengths,
+        hiddenSize,
+        numLayers,
+        mode,
+        bidirectional,
+        0.0);
+  } catch (const std::runtime_error&) {
+    GTEST_SKIP() << "Backend has no packed-sequence RNN support";
+  }
+  auto [y, hy, cy] = packed;
+
+  auto grad = Variable(fl::rand(y.shape(), fl::dtype::f32), false);
+  y.backward(grad);
+
+  // each batch element must match a batch-1 run over its valid steps, with
+  // zero output and input gradient past its length and final states taken at
+  // its own last step
+  auto wGradSum = fl::full(w.shape(), 0., fl::dtype::f32);
+  for (int b = 0; b < batchSize; ++b) {
+    int len = seqLengths[b];
+    auto batch = fl::range(b, b + 1);
+    auto valid = fl::range(0, len);
+    auto inB = Variable(in.tensor()(fl::span, batch, valid).copy(), true);
+    auto wB = Variable(w.tensor().copy(), true);
+    auto [yB, hyB, cyB] = rnn(
+        inB,
+        Variable(),
+        Variable(),
+        wB,
+        hiddenSize,
+        numLayers,
+        mode,
+        bidirectional,
+        0.0);
+
+    ASSERT_TRUE(
+        allClose(y.tensor()(fl::span, batch, valid), yB.tensor(), 1e-4));
+    ASSERT_TRUE(allClose(hy.tensor()(fl::span, batch), hyB.tensor(), 1e-4));
+    ASSERT_TRUE(allClose(cy.tensor()(fl::span, batch), cyB.tensor(), 1e-4));
+    if (len < seqLength) {
+      auto pad = fl::range(len, seqLength);
+      ASSERT_TRUE(allClose(
+          y.tensor()(fl::span, batch, pad),
+          fl::full(y.tensor()(fl::span, batch, pad).shape(), 0., y.type())));
+    }
+
+    yB.backward(Variable(grad.tensor()(fl::span, batch, valid).copy(), false));
+    ASSERT_TRUE(allClose(
+        in.grad().tensor()(fl::span, batch, valid),
+        inB.grad().tensor(),
+        1e-4));
+    if (len < seqLength) {
+      auto pad = fl::range(len, seqLength);
+      ASSERT_TRUE(allClose(
+          in.grad().tensor()(fl::span, batch, pad),
+          fl::full(
+              in.grad().tensor()(fl::span, batch, pad).shape(),
+              0.,
+              in.type())));
+    }
+    wGradSum += wB.grad().tensor();
+  }
+  ASSERT_TRUE(allClose(w.grad().tensor(), wGradSum, 1e-3));
+}
+
 TEST_F(AutogradTestF16, RnnF16) {
   if (!fl::f16Supported()) {
     GTEST_SKIP() << "Half-precision not supported on this device";
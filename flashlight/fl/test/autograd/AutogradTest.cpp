@@ -185,6 +185,215 @@ TEST(AutogradTest, NoCalcGrad) {
   ASSERT_THROW(x.grad(), std::logic_error);
 }
 
+TEST(AutogradTest, NoGradGuard) {
+  auto x = Variable(fl::rand({5}), true);
+  auto y = Variable(fl::rand({5}), true);
+  {
+    fl::NoGradGuard noGrad;
+    auto z = x * x + x * y + y * y;
+    // No graph was built: forward values are right, backward is impossible
+    ASSERT_TRUE(allClose(
+        z.tensor(),
+        x.tensor() * x.tensor() + x.tensor() * y.tensor() +
+            y.tensor() * y.tensor()));
+    ASSERT_FALSE(z.isCalcGrad());
+    ASSERT_THROW(z.grad(), std::logic_error);
+
+    // Guards nest and restore the previous mode
+    { fl::NoGradGuard inner; }
+    ASSERT_FALSE(fl::detail::gradMode());
+  }
+  ASSERT_TRUE(fl::detail::gradMode());
+
+  // Graph construction works again after the guard is destroyed
+  auto z = x * y;
+  z.backward(Variable(fl::full({5}, 1.0), false));
+  ASSERT_TRUE(allClose(x.grad().tensor(), y.tensor()));
+}
+
+TEST(AutogradTest, OptimLevelGuard) {
+  if (!fl::f16Supported()) {
+    GTEST_SKIP() << "Half-precision not supported on device";
+  }
+  auto a = Variable(fl::rand({4, 6}), true);
+  auto b = Variable(fl::rand({6, 5}), true);
+  {
+    OptimLevelGuard amp(OptimLevel::O1);
+    ASSERT_EQ(OptimMode::get().getOptimLevel(), OptimLevel::O1);
+    // matmuls run in f16; excluded ops like softmax stay in f32
+    ASSERT_EQ(matmul(a, b).type(), fl::dtype::f16);
+    ASSERT_EQ(softmax(a, 0).type(), fl::dtype::f32);
+  }
+  // The previous level is restored and casting stops
+  ASSERT_EQ(OptimMode::get().getOptimLevel(), OptimLevel::DEFAULT);
+  ASSERT_EQ(matmul(a, b).type(), fl::dtype::f32);
+
+  // Gradients flow back to the original f32 Variables through the casts
+  // recorded during the guarded forward
+  Variable out;
+  {
+    OptimLevelGuard amp(OptimLevel::O1);
+    out = matmul(a, b);
+  }
+  out.backward(Variable(fl::full(out.shape(), 1.0, out.type()), false));
+  ASSERT_EQ(a.grad().type(), fl::dtype::f32);
+  ASSERT_EQ(a.grad().shape(), a.shape());
+}
+
+TEST(AutogradTest, DoubleBackward) {
+  auto x = Variable(fl::rand({5}, fl::dtype::f64), true);
+  auto y = x * x * x;
+  y.backward(/* retainGraph = */ false, /* createGraph = */ true);
+
+  // First derivative: 3x^2, recorded as a graph of its own
+  auto g = x.grad();
+  ASSERT_TRUE(allClose(g.tensor(), 3 * x.tensor() * x.tensor()));
+  ASSERT_TRUE(g.isCalcGrad());
+
+  // Differentiate the gradient itself: d(sum(g))/dx = 6x
+  x.zeroGrad();
+  g.backward();
+  ASSERT_TRUE(allClose(x.grad().tensor(), 6 * x.tensor()));
+  x.zeroGrad();
+}
+
+TEST(AutogradTest, GradientPenalty) {
+  auto a = Variable(fl::rand({4, 6}, fl::dtype::f64), true);
+  auto x = Variable(fl::rand({6, 1}, fl::dtype::f64), true);
+  auto loss = sum(matmul(a, x), {0});
+  loss.backward(/* retainGraph = */ false, /* createGraph = */ true);
+
+  // dloss/dx = a^T * ones -- the column sums of a
+  auto g = x.grad();
+  auto colSums = fl::sum(a.tensor(), {0});
+  ASSERT_TRUE(allClose(g.tensor(), fl::reshape(colSums, {6, 1})));
+
+  // Penalize the gradient norm; its gradient w.r.t. a_ij is twice the sum
+  // of column j, independent of i
+  auto penalty = sum(g * g, {0});
+  a.zeroGrad();
+  x.zeroGrad();
+  penalty.backward();
+  ASSERT_TRUE(allClose(
+      a.grad().tensor(),
+      fl::tile(fl::reshape(2 * colSums, {1, 6}), {4, 1})));
+  a.zeroGrad();
+}
+
+TEST(AutogradTest, ParallelBackward) {
+  auto xt = fl::rand({6, 3});
+  auto yt = fl::rand({6, 3});
+  // Two independent towers joined at the output, so the tape has levels
+  // with more than one data-independent node
+  auto buildAndBackward = [&xt, &yt]() {
+    auto x = Variable(xt, true);
+    auto y = Variable(yt, true);
+    auto left = sigmoid(x * y) + tanh(y);
+    auto right = tanh(x + y) * sigmoid(y);
+    auto z = left + right + x * x;
+    z.backward();
+    return std::make_pair(x.grad().tensor(), y.grad().tensor());
+  };
+
+  auto serial = buildAndBackward();
+  fl::setBackwardParallelism(4);
+  ASSERT_EQ(fl::backwardParallelism(), 4);
+  auto parallel = buildAndBackward();
+  fl::setBackwardParallelism(1);
+  ASSERT_TRUE(allClose(serial.first, parallel.first, 1e-5));
+  ASSERT_TRUE(allClose(serial.second, parallel.second, 1e-5));
+}
+
+TEST(AutogradTest, ParallelBackwardError) {
+  // A throwing gradFunc must drain its level before the error propagates;
+  // workers hold pointers into the caller's tape, so letting them run past
+  // the unwind would be a use-after-free
+  auto makeThrowing = [](const Variable& in) {
+    return Variable(
+        in.tensor(),
+        {in},
+        [](std::vector<Variable>& /* inputs */,
+           const Variable& /* gradOutput */) {
+          throw std::runtime_error("gradFunc failure");
+        });
+  };
+  auto x = Variable(fl::rand({4}), true);
+  auto y = Variable(fl::rand({4}), true);
+  // two data-independent throwing nodes land in the same level
+  auto z = makeThrowing(x * x) + makeThrowing(y * y);
+  fl::setBackwardParallelism(4);
+  ASSERT_THROW(z.backward(), std::runtime_error);
+  fl::setBackwardParallelism(1);
+}
+
+TEST(AutogradTest, GraphNodeRecycling) {
+  // Graph metadata nodes are recycled through a per-thread pool once
+  // backward() tears the graph down; repeated steps must hand back fresh
+  // nodes with no stale inputs, gradients, or hooks from a previous life
+  auto xt = fl::rand({5});
+  auto yt = fl::rand({5});
+  for (int step = 0; step < 50; ++step) {
+    auto x = Variable(xt, true);
+    auto y = Variable(yt, true);
+    auto z = x * x + x * y + y * y;
+    ASSERT_FALSE(z.isGradAvailable());
+    z.backward();
+    ASSERT_TRUE(allClose(x.grad().tensor(), 2 * xt + yt));
+    ASSERT_TRUE(allClose(y.grad().tensor(), 2 * yt + xt));
+  }
+}
+
+TEST(AutogradTest, ScaledDotProductAttention) {
+  const double scale = 0.5;
+  auto qt = fl::rand({10, 4, 3}, fl::dtype::f32);
+  auto kt = fl::rand({7, 4, 3}, fl::dtype::f32);
+  auto vt = fl::rand({7, 4, 3}, fl::dtype::f32);
+
+  // dense reference computed with ordinary Variable ops
+  auto dense = [scale](
+                   const Variable& q,
+                   const Variable& k,
+                   const Variable& v,
+                   const Variable& mask) {
+    auto scores = matmulNT(q * scale, k);
+    if (!mask.isEmpty()) {
+      scores = scores + tileAs(mask, scores);
+    }
+    return matmul(softmax(scores, 1), v);
+  };
+
+  auto compare = [&](const Tensor& maskTensor, int chunkSize) {
+    auto q1 = Variable(qt, true);
+    auto k1 = Variable(kt, true);
+    auto v1 = Variable(vt, true);
+    auto ref = dense(q1, k1, v1, Variable(maskTensor, false));
+    ref.backward();
+
+    auto q2 = Variable(qt, true);
+    auto k2 = Variable(kt, true);
+    auto v2 = Variable(vt, true);
+    auto chunked = scaledDotProductAttention(
+        q2, k2, v2, scale, Variable(maskTensor, false), chunkSize);
+    chunked.backward();
+
+    ASSERT_TRUE(allClose(ref.tensor(), chunked.tensor(), 1e-5));
+    ASSERT_TRUE(allClose(q1.grad().tensor(), q2.grad().tensor(), 1e-5));
+    ASSERT_TRUE(allClose(k1.grad().tensor(), k2.grad().tensor(), 1e-5));
+    ASSERT_TRUE(allClose(v1.grad().tensor(), v2.grad().tensor(), 1e-5));
+  };
+
+  // unmasked, with a chunk size that doesn't divide the query length
+  compare(Tensor(), 3);
+  // per-query-step additive mask, sliced along with the query blocks
+  auto stepMask =
+      fl::log((fl::rand({10, 7, 1}) > 0.1).astype(fl::dtype::f32));
+  compare(stepMask, 4);
+  // broadcast additive mask, shared across all query blocks
+  auto sharedMask =
+      fl::log((fl::rand({1, 7, 3}) > 0.1).astype(fl::dtype::f32));
+  compare(sharedMask, 10);
+}
+
 TEST(AutogradTest, Concatenate) {
   auto x1 = Variable(fl::rand({2, 3, 1, 2}, fl::dtype::f64), true);
   auto x2 = Variable(fl::rand({2, 3, 3, 2}, fl::dtype::f64), true);
@@ -320,6 +529,12 @@ TEST(AutogradTest, Indexing) {
     return input.flat(fl::range(4, 100));
   };
   ASSERT_TRUE(fl::detail::jacobianTestImpl(funcFlat, x));
+
+  // tensor index with duplicates - the backward must accumulate the
+  // gradients of repeated rows
+  auto idx = Tensor::fromVector<int>({4}, {1, 3, 1, 4});
+  auto funcGather = [&idx](Variable& input) { return input(fl::span, idx); };
+  ASSERT_TRUE(fl::detail::jacobianTestImpl(funcGather, x));
 }
 
 TEST(AutogradTest, Padding) {
@@ -364,6 +579,37 @@ TEST(AutogradTest, Embedding) {
   ASSERT_TRUE(fl::detail::jacobianTestImpl(funcEmbed, weights, 1E-5));
 }
 
+TEST(AutogradTest, EmbeddingSparseGrad) {
+  int nWords = 10;
+  // repeated lookups must fold into one value per unique index
+  auto input = Variable(
+      Tensor::fromVector<float>({3, 7, 3, 1, 7, 3}), false);
+  auto w = Variable(fl::randn({4, nWords}), true);
+  auto wRef = Variable(w.tensor().copy(), true);
+  auto gradOut = fl::rand({4, 6});
+
+  auto out = embedding(input, w, /* sparseGrad = */ true);
+  out.backward(Variable(gradOut, false));
+  ASSERT_TRUE(w.isSparseGradAvailable());
+  ASSERT_EQ(w.sparseGrad().indices.elements(), 3); // unique indices 1, 3, 7
+
+  auto outRef = embedding(input, wRef);
+  outRef.backward(Variable(gradOut, false));
+
+  // accessing the dense gradient materializes the sparse one
+  ASSERT_TRUE(allClose(w.grad().tensor(), wRef.grad().tensor(), 1e-5));
+  ASSERT_FALSE(w.isSparseGradAvailable());
+
+  // a dense gradient joining a sparse one accumulates densely
+  w.zeroGrad();
+  auto sparseOut = embedding(input, w, /* sparseGrad = */ true);
+  sparseOut.backward(Variable(gradOut, false));
+  w.addGrad(Variable(wRef.grad().tensor(), false));
+  ASSERT_FALSE(w.isSparseGradAvailable());
+  ASSERT_TRUE(
+      allClose(w.grad().tensor(), 2 * wRef.grad().tensor(), 1e-5));
+}
+
 TEST(AutogradTest, GetAdvancedIndex) {
   // TODO: remove me
   if (!FL_BACKEND_CUDA) {
@@ -39,6 +39,29 @@ TEST(AutogradUnaryOpsTest, Glu) {
   ASSERT_TRUE(fl::detail::jacobianTestImpl(funcGlu, in, 1E-5));
 }
 
+TEST(AutogradUnaryOpsTest, DropoutRegenerateMask) {
+  const double p = 0.3;
+  const uint64_t seed = 11, counter = 5;
+  auto input = Variable(fl::rand({7, 9}) + 0.5, true);
+
+  auto output = dropout(input, p, seed, counter);
+  // the mask is a pure function of (seed, counter)
+  auto mask =
+      (fl::philoxRand(input.shape(), seed, counter) > p).astype(input.type());
+  ASSERT_TRUE(
+      allClose(output.tensor(), 1.0 / (1.0 - p) * mask * input.tensor()));
+
+  // backward regenerates the same mask instead of loading a stored one
+  output.backward();
+  ASSERT_TRUE(allClose(input.grad().tensor(), 1.0 / (1.0 - p) * mask));
+
+  auto funcDrop = [p, seed, counter](Variable& in) {
+    return dropout(in, p, seed, counter);
+  };
+  auto in64 = Variable(fl::rand({6, 5}, fl::dtype::f64) + 0.5, true);
+  ASSERT_TRUE(fl::detail::jacobianTestImpl(funcDrop, in64, 1E-5));
+}
+
 TEST(AutogradUnaryOpsTest, Sigmoid) {
   auto x = Variable(fl::rand({5}), true);
   auto y = sigmoid(x);
@@ -50,6 +73,32 @@ TEST(AutogradUnaryOpsTest, Sigmoid) {
       dx.tensor(), (fl::sigmoid(x.tensor()) * (1 - fl::sigmoid(x.tensor())))));
 }
 
+TEST(AutogradUnaryOpsTest, SigmoidMul) {
+  auto gate = Variable(fl::rand({5}), true);
+  auto input = Variable(fl::rand({5}), true);
+  auto out = sigmoidMul(gate, input);
+  ASSERT_TRUE(allClose(out.tensor(), fl::sigmoid(gate.tensor()) * input.tensor()));
+
+  auto dout = Variable(fl::full({5}, 1.0), false);
+  out.backward(dout);
+  auto sig = fl::sigmoid(gate.tensor());
+  ASSERT_TRUE(allClose(gate.grad().tensor(), input.tensor() * sig * (1 - sig)));
+  ASSERT_TRUE(allClose(input.grad().tensor(), sig));
+}
+
+TEST(AutogradUnaryOpsTest, TanhMul) {
+  auto gate = Variable(fl::rand({5}), true);
+  auto input = Variable(fl::rand({5}), true);
+  auto out = tanhMul(gate, input);
+  ASSERT_TRUE(allClose(out.tensor(), fl::tanh(gate.tensor()) * input.tensor()));
+
+  auto dout = Variable(fl::full({5}, 1.0), false);
+  out.backward(dout);
+  auto th = fl::tanh(gate.tensor());
+  ASSERT_TRUE(allClose(gate.grad().tensor(), input.tensor() * (1 - th * th)));
+  ASSERT_TRUE(allClose(input.grad().tensor(), th));
+}
+
 TEST(AutogradUnaryOpsTest, Erf) {
   auto x = Variable(fl::rand({5}), true);
   auto y = erf(x);
@@ -125,6 +174,36 @@ TEST(AutogradUnaryOpsTest, Softmax) {
   ASSERT_TRUE(fl::detail::jacobianTestImpl(funcSm, in, 1E-5));
 }
 
+TEST(AutogradUnaryOpsTest, MaskedSoftmax) {
+  auto in = Variable(fl::rand({5, 4, 2}, fl::dtype::f64), true);
+  const double temperature = 2.0;
+  // large negative log-space entries mask out the first row
+  auto mask = fl::concatenate(
+      0,
+      fl::full({1, 4, 2}, -1e9, fl::dtype::f64),
+      fl::full({4, 4, 2}, 0., fl::dtype::f64));
+
+  // matches the unfused mask-add-then-softmax composition
+  auto fused = softmax(in, 0, mask, temperature);
+  auto composed =
+      softmax(Variable(in.tensor() / temperature + mask, false), 0);
+  ASSERT_TRUE(allClose(fused.tensor(), composed.tensor(), 1e-6));
+  // masked positions receive no probability mass
+  ASSERT_EQ(fl::sum(fused.tensor()(0)).scalar<double>(), 0.);
+
+  auto funcSm = [&](Variable& input) {
+    return softmax(input, 0, mask, temperature);
+  };
+  ASSERT_TRUE(fl::detail::jacobianTestImpl(funcSm, in, 1E-5));
+
+  // masks smaller than the input are tiled to its shape
+  auto zeroMask = fl::full({5, 1, 1}, 0., fl::dtype::f64);
+  ASSERT_TRUE(
+      allClose(softmax(in, 0, zeroMask).tensor(), softmax(in, 0).tensor()));
+
+  ASSERT_THROW(softmax(in, 0, mask, 0.), std::invalid_argument);
+}
+
 TEST_F(AutogradTestF16, SoftmaxF16) {
   if (!fl::f16Supported()) {
     GTEST_SKIP() << "Half-precision not supported on this device";
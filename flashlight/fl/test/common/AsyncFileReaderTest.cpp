@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <cstdint>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "flashlight/fl/common/AsyncFileReader.h"
+#include "flashlight/fl/common/Filesystem.h"
+
+using namespace fl;
+
+namespace {
+
+fs::path writeTestFile(int64_t size) {
+  auto path = fs::temp_directory_path() / "async_file_reader_test.bin";
+  std::ofstream fs(path, std::ios_base::out | std::ios_base::binary);
+  for (int64_t i = 0; i < size; ++i) {
+    const char byte = static_cast<char>(i % 251);
+    fs.write(&byte, 1);
+  }
+  return path;
+}
+
+} // namespace
+
+TEST(AsyncFileReaderTest, ScatterRead) {
+  const int64_t fileSize = 1 << 16;
+  auto path = writeTestFile(fileSize);
+  AsyncFileReader reader(path);
+
+  // more requests than the default queue depth, in shuffled, overlapping
+  // ranges
+  std::vector<std::vector<char>> buffers;
+  std::vector<FileReadRequest> requests;
+  for (int64_t i = 0; i < 100; ++i) {
+    const int64_t offset = (i * 577) % (fileSize - 1000);
+    const int64_t size = 100 + (i % 11) * 71;
+    buffers.emplace_back(size);
+    requests.push_back({offset, size, buffers.back().data()});
+  }
+  reader.readahead(0, fileSize);
+  reader.read(requests);
+
+  for (size_t r = 0; r < requests.size(); ++r) {
+    for (int64_t i = 0; i < requests[r].size; ++i) {
+      ASSERT_EQ(
+          buffers[r][i], static_cast<char>((requests[r].offset + i) % 251));
+    }
+  }
+  fs::remove(path);
+}
+
+TEST(AsyncFileReaderTest, Errors) {
+  const int64_t fileSize = 1024;
+  auto path = writeTestFile(fileSize);
+  AsyncFileReader reader(path);
+
+  std::vector<char> buffer(64);
+  ASSERT_THROW(
+      reader.read({{fileSize - 10, 64, buffer.data()}}), std::runtime_error);
+  ASSERT_THROW(reader.read({{-1, 64, buffer.data()}}), std::invalid_argument);
+  ASSERT_THROW(reader.read({{0, 64, nullptr}}), std::invalid_argument);
+  // empty batches and zero-sized requests are no-ops
+  reader.read({});
+  reader.read({{0, 0, nullptr}});
+  // out-of-range hints are advisory and must not throw
+  reader.readahead(fileSize * 2, 1024);
+
+  ASSERT_THROW(AsyncFileReader(path, 0), std::invalid_argument);
+  ASSERT_THROW(
+      AsyncFileReader(fs::temp_directory_path() / "does_not_exist.bin"),
+      std::runtime_error);
+  fs::remove(path);
+}
+
+TEST(AsyncFileReaderTest, ErrorDrainsBatch) {
+  const int64_t fileSize = 1 << 14;
+  auto path = writeTestFile(fileSize);
+  AsyncFileReader reader(path);
+
+  // a failing request must not abandon the rest of the batch: every other
+  // read still runs to completion (into buffers the caller still owns)
+  // before the error is rethrown
+  std::vector<std::vector<char>> buffers;
+  std::vector<FileReadRequest> requests;
+  for (int64_t i = 0; i < 32; ++i) {
+    buffers.emplace_back(256);
+    requests.push_back({i * 256, 256, buffers.back().data()});
+  }
+  std::vector<char> bad(64);
+  requests.push_back({fileSize - 10, 64, bad.data()}); // reads past EOF
+  ASSERT_THROW(reader.read(requests), std::runtime_error);
+  for (int64_t i = 0; i < 32; ++i) {
+    for (int64_t j = 0; j < 256; ++j) {
+      ASSERT_EQ(buffers[i][j], static_cast<char>((i * 256 + j) % 251));
+    }
+  }
+  fs::remove(path);
+}
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
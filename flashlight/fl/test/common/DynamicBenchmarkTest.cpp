@@ -123,6 +123,56 @@ TEST_F(DynamicBenchmark, DynamicBenchmarkDisjointLambdas) {
   ASSERT_EQ(options->currentOption(), 2);
 }
 
+TEST_F(DynamicBenchmark, PersistentCache) {
+  size_t maxCount = 5;
+  std::vector<int> sleepTimes = {4, 2, 6};
+  const fs::path cachePath =
+      fs::temp_directory_path() / "fl_dynamic_benchmark_cache_test.txt";
+  fs::remove(cachePath);
+  fl::DynamicBenchmark::setBenchmarkCachePath(cachePath);
+
+  auto options =
+      std::make_shared<fl::DynamicBenchmarkOptions<int>>(sleepTimes, maxCount);
+  auto dynamicBench = std::make_shared<fl::DynamicBenchmark>(options);
+  dynamicBench->setCacheKey("sleepBench");
+
+  for (size_t i = 0; i < maxCount * sleepTimes.size(); ++i) {
+    std::chrono::milliseconds sleepTime(options->currentOption());
+    dynamicBench->audit(
+        [sleepTime]() { std::this_thread::sleep_for(sleepTime); });
+  }
+  ASSERT_TRUE(options->timingsComplete());
+  ASSERT_EQ(options->currentOption(), 2);
+
+  // A benchmark with the same key skips timing and reuses the decision
+  auto cachedOptions =
+      std::make_shared<fl::DynamicBenchmarkOptions<int>>(sleepTimes, maxCount);
+  auto cachedBench = std::make_shared<fl::DynamicBenchmark>(cachedOptions);
+  cachedBench->setCacheKey("sleepBench");
+  ASSERT_TRUE(cachedOptions->timingsComplete());
+  ASSERT_EQ(cachedOptions->currentOption(), 2);
+
+  // Reloading the cache from disk (as a fresh process would) restores entries
+  fl::DynamicBenchmark::setBenchmarkCachePath("");
+  fl::DynamicBenchmark::setBenchmarkCachePath(cachePath);
+  auto reloadedOptions =
+      std::make_shared<fl::DynamicBenchmarkOptions<int>>(sleepTimes, maxCount);
+  auto reloadedBench = std::make_shared<fl::DynamicBenchmark>(reloadedOptions);
+  reloadedBench->setCacheKey("sleepBench");
+  ASSERT_TRUE(reloadedOptions->timingsComplete());
+  ASSERT_EQ(reloadedOptions->currentOption(), 2);
+
+  // A different key is unaffected by cached decisions
+  auto otherOptions =
+      std::make_shared<fl::DynamicBenchmarkOptions<int>>(sleepTimes, maxCount);
+  auto otherBench = std::make_shared<fl::DynamicBenchmark>(otherOptions);
+  otherBench->setCacheKey("otherBench");
+  ASSERT_FALSE(otherOptions->timingsComplete());
+
+  fl::DynamicBenchmark::setBenchmarkCachePath("");
+  fs::remove(cachePath);
+}
+
 TEST_F(DynamicBenchmark, DynamicBenchmarkMatmul) {
   size_t maxCount = 5;
   // n x n arrays of different sizes
@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <fstream>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "flashlight/fl/common/EventLog.h"
+#include "flashlight/fl/common/Filesystem.h"
+
+using namespace fl;
+
+namespace {
+
+std::vector<EventRecord> readSink(const fs::path& path) {
+  std::ifstream ifs(path, std::ios::binary | std::ios::ate);
+  const size_t bytes = ifs.tellg();
+  EXPECT_EQ(bytes % sizeof(EventRecord), 0);
+  std::vector<EventRecord> records(bytes / sizeof(EventRecord));
+  ifs.seekg(0);
+  ifs.read(reinterpret_cast<char*>(records.data()), bytes);
+  return records;
+}
+
+} // namespace
+
+TEST(EventLogTest, RecordsLevelsAndSampling) {
+  const fs::path path = fs::temp_directory_path() / "fl_eventlog_test.bin";
+  EventLog::setMaxLevel(2);
+  EventLog::openSink(path.string());
+
+  for (int i = 0; i < 10000; ++i) {
+    FL_EVENT(1, 7, i * 1.0);
+    FL_EVENT(3, 8, 0.0); // above the runtime threshold: dropped
+    FL_EVENT_SAMPLED(2, 9, i, 100);
+  }
+  std::thread worker([] {
+    for (int i = 0; i < 5000; ++i) {
+      FL_EVENT(2, 11, i);
+    }
+    EventLog::flush();
+  });
+  worker.join();
+  EventLog::closeSink();
+
+  const auto records = readSink(path);
+  size_t countFull = 0, countSampled = 0, countWorker = 0;
+  for (const auto& record : records) {
+    ASSERT_GT(record.timeUs, 0);
+    switch (record.id) {
+      case 7:
+        countFull++;
+        break;
+      case 9:
+        countSampled++;
+        break;
+      case 11:
+        countWorker++;
+        break;
+      default:
+        FAIL() << "unexpected event id " << record.id;
+    }
+  }
+  ASSERT_EQ(countFull, 10000);
+  ASSERT_EQ(countSampled, 100); // one in a hundred
+  ASSERT_EQ(countWorker, 5000);
+
+  // reopening truncates and records again
+  EventLog::openSink(path.string());
+  FL_EVENT(1, 1, 1.0);
+  EventLog::closeSink();
+  ASSERT_EQ(readSink(path).size(), 1);
+
+  EventLog::setMaxLevel(0);
+  fs::remove(path);
+}
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -129,6 +129,77 @@ TEST(FixedBucketSizeHistogram, ExponentialDistribution) {
   std::cout << hiResHist.prettyString() << std::endl;
 }
 
+// Tests that StreamingHistogram tracks exact count/min/max/mean over a stream
+// much larger than its reservoir and that reservoir quantiles land near the
+// true quantiles of the distribution.
+TEST(StreamingHistogram, UniformDistributionQuantiles) {
+  const size_t nValues = 1e6; // Random large number.
+  std::mt19937 generator(0);
+  std::uniform_real_distribution<double> distribution(0.0, 1.0);
+
+  StreamingHistogram<double> hist;
+  for (size_t i = 0; i < nValues; ++i) {
+    hist.add(distribution(generator));
+  }
+
+  EXPECT_EQ(hist.count(), nValues);
+  EXPECT_GE(hist.min(), 0.0);
+  EXPECT_LE(hist.max(), 1.0);
+  EXPECT_NEAR(hist.mean(), 0.5, 1e-3);
+  EXPECT_NEAR(hist.quantile(0.5), 0.5, 0.03);
+  EXPECT_GT(hist.quantile(0.999), 0.99);
+
+  // Bucketed stats are computed over the reservoir.
+  HistogramStats<double> stats = hist.stats(9);
+  EXPECT_EQ(stats.buckets.size(), 9);
+  EXPECT_GT(stats.numValues, 0);
+}
+
+// Tests that merging histograms over disjoint ranges combines exact stats
+// exactly and represents both sides in the merged reservoir.
+TEST(StreamingHistogram, Merge) {
+  const size_t nValues = 1e5;
+  std::mt19937 generator(1);
+  std::uniform_real_distribution<double> low(0.0, 1.0);
+  std::uniform_real_distribution<double> high(10.0, 11.0);
+
+  StreamingHistogram<double> histLow;
+  StreamingHistogram<double> histHigh;
+  for (size_t i = 0; i < nValues; ++i) {
+    histLow.add(low(generator));
+    histHigh.add(high(generator));
+  }
+
+  histLow.merge(histHigh);
+  EXPECT_EQ(histLow.count(), 2 * nValues);
+  EXPECT_NEAR(histLow.mean(), 5.5, 0.01);
+  EXPECT_LT(histLow.quantile(0.25), 1.0);
+  EXPECT_GT(histLow.quantile(0.75), 10.0);
+
+  // Small histograms whose reservoirs fit in the merged capacity concatenate
+  // without resampling.
+  StreamingHistogram<int> a;
+  StreamingHistogram<int> b;
+  for (int i = 0; i < 30; ++i) {
+    a.add(i);
+    b.add(i + 100);
+  }
+  a.merge(b);
+  EXPECT_EQ(a.count(), 60);
+  EXPECT_EQ(a.min(), 0);
+  EXPECT_EQ(a.max(), 129);
+  EXPECT_EQ(a.stats(5).numValues, 60);
+}
+
+// Tests that stats requiring at least one value throw on an empty histogram.
+TEST(StreamingHistogram, EmptyThrows) {
+  StreamingHistogram<float> hist;
+  EXPECT_EQ(hist.count(), 0);
+  EXPECT_THROW(hist.min(), std::runtime_error);
+  EXPECT_THROW(hist.quantile(0.5), std::runtime_error);
+  EXPECT_THROW(StreamingHistogram<float>(0), std::invalid_argument);
+}
+
 } // namespace
 
 int main(int argc, char** argv) {
@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "flashlight/fl/common/LRUCache.h"
+
+using namespace fl;
+
+TEST(LRUCacheTest, PutGet) {
+  LRUCache<std::string, int> cache(64);
+  ASSERT_EQ(cache.get("a"), nullptr);
+
+  cache.put("a", std::make_shared<int>(1));
+  cache.put("b", std::make_shared<int>(2));
+  ASSERT_EQ(*cache.get("a"), 1);
+  ASSERT_EQ(*cache.get("b"), 2);
+  ASSERT_EQ(cache.size(), 2);
+
+  // replacement
+  cache.put("a", std::make_shared<int>(3));
+  ASSERT_EQ(*cache.get("a"), 3);
+  ASSERT_EQ(cache.size(), 2);
+
+  cache.clear();
+  ASSERT_EQ(cache.size(), 0);
+  ASSERT_EQ(cache.get("a"), nullptr);
+}
+
+TEST(LRUCacheTest, EvictsLeastRecentlyUsed) {
+  // one shard so the eviction order is the exact global LRU order
+  LRUCache<std::string, int> cache(3, /* shardCount = */ 1);
+  cache.put("a", std::make_shared<int>(1));
+  cache.put("b", std::make_shared<int>(2));
+  cache.put("c", std::make_shared<int>(3));
+
+  // touch "a" so "b" is now the coldest entry
+  ASSERT_NE(cache.get("a"), nullptr);
+  cache.put("d", std::make_shared<int>(4));
+  ASSERT_EQ(cache.get("b"), nullptr);
+  ASSERT_NE(cache.get("a"), nullptr);
+  ASSERT_NE(cache.get("c"), nullptr);
+  ASSERT_NE(cache.get("d"), nullptr);
+}
+
+TEST(LRUCacheTest, ByteAccounting) {
+  LRUCache<std::string, int> cache(100, /* shardCount = */ 1);
+  cache.put("a", std::make_shared<int>(1), 40);
+  cache.put("b", std::make_shared<int>(2), 40);
+  ASSERT_EQ(cache.sizeInBytes(), 80);
+
+  // inserting 40 more bytes evicts the coldest entry
+  cache.put("c", std::make_shared<int>(3), 40);
+  ASSERT_EQ(cache.get("a"), nullptr);
+  ASSERT_EQ(cache.sizeInBytes(), 80);
+
+  // an entry larger than the whole cache is still admitted, alone
+  cache.put("d", std::make_shared<int>(4), 1000);
+  ASSERT_EQ(cache.size(), 1);
+  ASSERT_EQ(*cache.get("d"), 4);
+
+  // a held value survives its eviction
+  auto held = cache.get("d");
+  cache.put("e", std::make_shared<int>(5), 100);
+  ASSERT_EQ(cache.get("d"), nullptr);
+  ASSERT_EQ(*held, 4);
+}
+
+TEST(LRUCacheTest, GetOrPut) {
+  LRUCache<std::string, int> cache(10);
+  int builds = 0;
+  auto factory = [&builds]() {
+    ++builds;
+    return std::make_shared<int>(7);
+  };
+  ASSERT_EQ(*cache.getOrPut("a", factory), 7);
+  ASSERT_EQ(*cache.getOrPut("a", factory), 7);
+  ASSERT_EQ(builds, 1);
+}
+
+TEST(LRUCacheTest, ConcurrentReadersAndWriters) {
+  LRUCache<int, int> cache(256);
+  constexpr int nThreads = 8;
+  constexpr int nOps = 1000;
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < nThreads; ++t) {
+    threads.emplace_back([&cache, t]() {
+      for (int i = 0; i < nOps; ++i) {
+        const int key = (t * nOps + i) % 64;
+        auto value =
+            cache.getOrPut(key, [key]() { return std::make_shared<int>(key); });
+        ASSERT_EQ(*value, key);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  ASSERT_LE(cache.size(), 64);
+}
+
+TEST(LRUCacheTest, InvalidShardCount) {
+  ASSERT_THROW(
+      (LRUCache<std::string, int>(10, /* shardCount = */ 0)),
+      std::invalid_argument);
+}
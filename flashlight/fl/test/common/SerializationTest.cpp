@@ -6,6 +6,8 @@
  */
 
 #include <cmath>
+#include <fstream>
+#include <iterator>
 #include <sstream>
 #include <string>
 #include <type_traits>
@@ -63,6 +65,30 @@ TEST(SerializationTest, Basic) {
   checkRoundTrip(Basic{3, 5.5, "asdf", {2, 4, 6}});
 }
 
+TEST(SerializationTest, SaveFast) {
+  const Basic b0{3, 5.5, "asdf", {2, 4, 6}};
+  const fs::path path = fs::temp_directory_path() / "fl_savefast_test.bin";
+
+  // saveFast must produce a file byte-identical to fl::save
+  fl::saveFast(path, b0);
+  std::ifstream ifs(path, std::ios::binary);
+  std::string fast(
+      (std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+  ASSERT_EQ(fast, saveToString(b0));
+
+  Basic b1;
+  fl::load(path, b1);
+  ASSERT_EQ(b0, b1);
+
+  // a second save reuses the arena; round-trip a larger payload
+  const Basic big{1, 2.0, std::string(1 << 22, 'x'), {}};
+  fl::saveFast(path, big);
+  Basic big1;
+  fl::load(path, big1);
+  ASSERT_EQ(big, big1);
+  fs::remove(path);
+}
+
 // ========== versioning compatibility ===========
 
 struct BasicV1 {
@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <atomic>
+#include <future>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "flashlight/fl/common/threadpool/ThreadPool.h"
+
+using namespace fl;
+
+TEST(ThreadPoolTest, EnqueueReturnsResults) {
+  ThreadPool pool(4);
+
+  std::vector<std::future<int>> results;
+  for (int i = 0; i < 100; ++i) {
+    results.push_back(pool.enqueue([](int x) { return x * x; }, i));
+  }
+  for (int i = 0; i < 100; ++i) {
+    ASSERT_EQ(results[i].get(), i * i);
+  }
+}
+
+TEST(ThreadPoolTest, AllTasksRunAcrossThreads) {
+  std::atomic<int> count{0};
+  {
+    ThreadPool pool(8);
+    for (int i = 0; i < 1000; ++i) {
+      pool.enqueue([&count] { count++; });
+    }
+    // destructor drains remaining tasks before joining
+  }
+  ASSERT_EQ(count.load(), 1000);
+}
+
+TEST(ThreadPoolTest, HighPriorityRunsBeforeBulk) {
+  // a single worker so queued order fully determines execution order
+  ThreadPool pool(1);
+
+  std::promise<void> release;
+  std::shared_future<void> released(release.get_future());
+  std::atomic<int> firstDone{-1};
+
+  // occupy the worker so the following tasks queue up
+  auto gate = pool.enqueue([released] { released.wait(); });
+  auto bulk = pool.enqueue([&firstDone] {
+    int expected = -1;
+    firstDone.compare_exchange_strong(expected, 0);
+  });
+  auto high = pool.enqueue(ThreadPool::Priority::kHigh, [&firstDone] {
+    int expected = -1;
+    firstDone.compare_exchange_strong(expected, 1);
+  });
+
+  release.set_value();
+  bulk.wait();
+  high.wait();
+  // the high-priority task was enqueued last but must have run first
+  ASSERT_EQ(firstDone.load(), 1);
+}
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
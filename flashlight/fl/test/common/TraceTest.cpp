@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "flashlight/fl/common/Trace.h"
+
+using namespace fl;
+
+namespace {
+
+std::string readFile(const fs::path& path) {
+  std::ifstream ifs(path);
+  return std::string(
+      (std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+}
+
+} // namespace
+
+TEST(TraceTest, SpansAndChromeExport) {
+  const fs::path path = fs::temp_directory_path() / "fl_trace_test.json";
+  Tracer::clear();
+
+  {
+    FL_TRACE_SCOPE("disabledSpan"); // tracing off: not recorded
+  }
+
+  Tracer::enable();
+  {
+    FL_TRACE_SCOPE("outer");
+    FL_TRACE_SCOPE(std::string("inner"));
+  }
+  std::thread worker([] { FL_TRACE_SCOPE("workerSpan"); });
+  worker.join();
+  Tracer::disable();
+
+  Tracer::writeChromeTrace(path);
+  const auto json = readFile(path);
+  ASSERT_NE(json.find("\"outer\""), std::string::npos);
+  ASSERT_NE(json.find("\"inner\""), std::string::npos);
+  ASSERT_NE(json.find("\"workerSpan\""), std::string::npos);
+  ASSERT_EQ(json.find("disabledSpan"), std::string::npos);
+  ASSERT_NE(json.find("\"ph\":\"X\""), std::string::npos);
+
+  Tracer::clear();
+  Tracer::writeChromeTrace(path);
+  ASSERT_EQ(readFile(path), "{\"traceEvents\":[]}");
+  fs::remove(path);
+}
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -105,6 +105,21 @@ TEST(SystemTest, RetryWithBackoff) {
       retryAsync(ms0, 1.0, 5, alwaysFailsVoid).get(), std::runtime_error);
 }
 
+TEST(UtilsTest, DeterministicMode) {
+  ASSERT_FALSE(DeterministicMode::get().enabled());
+  {
+    DeterministicModeGuard guard;
+    ASSERT_TRUE(DeterministicMode::get().enabled());
+    {
+      // nested guards restore the setting they found
+      DeterministicModeGuard inner(false);
+      ASSERT_FALSE(DeterministicMode::get().enabled());
+    }
+    ASSERT_TRUE(DeterministicMode::get().enabled());
+  }
+  ASSERT_FALSE(DeterministicMode::get().enabled());
+}
+
 int main(int argc, char** argv) {
   ::testing::InitGoogleTest(&argc, argv);
   fl::init();
@@ -259,6 +259,142 @@ void conformerFwd(bool isfp16) {
   ASSERT_EQ(output[0].dim(2), batchsize);
 }
 
+TEST(ContribModuleTest, TransformerDecodeStepFwd) {
+  int timesteps = 10;
+  int c = 4;
+  int nheads = 2;
+  int batchsize = 3;
+
+  // incremental decoding with a key/value cache matches the full causal
+  // forward pass, with and without relative positional embeddings
+  for (int bptt : {timesteps, 0}) {
+    for (bool preLN : {false, true}) {
+      auto tr = Transformer(c, c / nheads, c, nheads, bptt, 0, 0, true, preLN);
+      auto input = Variable(fl::rand({c, timesteps, batchsize}), false);
+      auto output = tr.forward({input, Variable()}).front();
+
+      TransformerKVCache cache;
+      for (int t = 0; t < timesteps; t++) {
+        auto step = tr.decodeStep(input(fl::span, fl::range(t, t + 1)), cache);
+        ASSERT_TRUE(allClose(
+            step.tensor(),
+            output.tensor()(fl::span, fl::range(t, t + 1)),
+            1e-5));
+      }
+      ASSERT_EQ(cache.length, timesteps);
+    }
+  }
+}
+
+TEST(ContribModuleTest, TransformerDecodeStepBlockFwd) {
+  int timesteps = 10;
+  int prefix = 4;
+  int c = 4;
+  int nheads = 2;
+  int batchsize = 3;
+
+  // appending a block of several steps at once (the speculative-decoding
+  // verification forward) matches the full causal forward pass: the new
+  // steps are masked causally against each other
+  for (int bptt : {timesteps, 0}) {
+    for (bool preLN : {false, true}) {
+      auto tr = Transformer(c, c / nheads, c, nheads, bptt, 0, 0, true, preLN);
+      auto input = Variable(fl::rand({c, timesteps, batchsize}), false);
+      auto output = tr.forward({input, Variable()}).front();
+
+      TransformerKVCache cache;
+      for (int t = 0; t < prefix; t++) {
+        tr.decodeStep(input(fl::span, fl::range(t, t + 1)), cache);
+      }
+      auto block =
+          tr.decodeStep(input(fl::span, fl::range(prefix, timesteps)), cache);
+      ASSERT_TRUE(allClose(
+          block.tensor(),
+          output.tensor()(fl::span, fl::range(prefix, timesteps)),
+          1e-5));
+      ASSERT_EQ(cache.length, timesteps);
+    }
+  }
+}
+
+TEST(ContribModuleTest, TransformerRopeFwd) {
+  int timesteps = 10;
+  int c = 8;
+  int nheads = 2;
+  int batchsize = 3;
+
+  auto tr = Transformer(
+      c, c / nheads, c, nheads, 0, 0, 0, true, false, /* useRope = */ true);
+  auto input = Variable(fl::rand({c, timesteps, batchsize}), false);
+  auto output = tr.forward({input, Variable()}).front();
+  ASSERT_EQ(output.dim(0), c);
+  ASSERT_EQ(output.dim(1), timesteps);
+  ASSERT_EQ(output.dim(2), batchsize);
+
+  // the rotations depend only on position, so repeated forwards match
+  // (and reuse the cached tables)
+  auto output2 = tr.forward({input, Variable()}).front();
+  ASSERT_TRUE(allClose(output, output2, 1e-7));
+
+  // rotary positions are absolute: feeding the tail of the sequence alone
+  // must not reproduce the tail of the full causal forward
+  auto tail =
+      tr.forward({input(fl::span, fl::range(5, timesteps)), Variable()})
+          .front();
+  ASSERT_FALSE(allClose(
+      tail.tensor(), output.tensor()(fl::span, fl::range(5, timesteps)), 1e-3));
+
+  // incremental decoding rotates new keys at their absolute offset, so it
+  // matches the full causal forward pass
+  TransformerKVCache cache;
+  for (int t = 0; t < timesteps; t++) {
+    auto step = tr.decodeStep(input(fl::span, fl::range(t, t + 1)), cache);
+    ASSERT_TRUE(allClose(
+        step.tensor(), output.tensor()(fl::span, fl::range(t, t + 1)), 1e-5));
+  }
+
+  // relative positional embeddings and rope are mutually exclusive
+  EXPECT_THROW(
+      Transformer(c, c / nheads, c, nheads, timesteps, 0, 0, true, false, true),
+      std::invalid_argument);
+  // odd head dimensions cannot be rotated pairwise
+  EXPECT_THROW(
+      Transformer(c, 3, c, nheads, 0, 0, 0, true, false, true),
+      std::invalid_argument);
+}
+
+TEST(ContribModuleTest, TransformerDocumentMaskFwd) {
+  int c = 4;
+  int nheads = 2;
+  int batchsize = 1;
+  int len0 = 5;
+  int len1 = 3;
+
+  // with the document mask, positions of a packed sequence attend only
+  // within their own document, so each document's outputs match running it
+  // through the layer on its own
+  auto tr = Transformer(c, c / nheads, c, nheads, 0, 0, 0, true);
+  auto doc0 = Variable(fl::rand({c, len0, batchsize}), false);
+  auto doc1 = Variable(fl::rand({c, len1, batchsize}), false);
+  auto packed = concatenate({doc0, doc1}, 1);
+
+  std::vector<int> ids(len0, 0);
+  ids.insert(ids.end(), len1, 1);
+  auto mask = Transformer::getDocumentMask(
+      Tensor::fromVector({len0 + len1, batchsize}, ids));
+  ASSERT_EQ(mask.shape(), Shape({len0 + len1, len0 + len1, batchsize}));
+
+  auto packedOut = tr.forward({packed, mask}).front();
+  auto out0 = tr.forward({doc0, Variable()}).front();
+  auto out1 = tr.forward({doc1, Variable()}).front();
+  ASSERT_TRUE(allClose(
+      packedOut.tensor()(fl::span, fl::range(0, len0)), out0.tensor(), 1e-5));
+  ASSERT_TRUE(allClose(
+      packedOut.tensor()(fl::span, fl::range(len0, len0 + len1)),
+      out1.tensor(),
+      1e-5));
+}
+
 TEST(ContribModuleTest, ConformerFwd) {
   conformerFwd(false);
 }
@@ -270,6 +406,68 @@ TEST_F(ContribModuleTestF16, ConformerFwdF16) {
   conformerFwd(true);
 }
 
+TEST(ContribModuleTest, ConformerForwardChunkFwd) {
+  int timesteps = 12;
+  int chunkSize = 4;
+  int c = 16;
+  int nheads = 4;
+  int kernel = 5;
+  int batchsize = 2;
+
+  // a single chunk covering the whole utterance matches the full forward,
+  // with and without relative positional embeddings
+  for (int posEmbContextSize : {timesteps, 0}) {
+    auto tr =
+        Conformer(c, c / nheads, c, nheads, posEmbContextSize, kernel, 0., 0.);
+    tr.eval();
+    auto input = Variable(fl::rand({c, timesteps, batchsize}), false);
+    auto output = tr.forward({input, Variable()}).front();
+
+    ConformerStreamingState state;
+    auto chunkOutput = tr.forwardChunk(input, state);
+    ASSERT_TRUE(allClose(chunkOutput.tensor(), output.tensor(), 1e-5));
+
+    // chunked processing is deterministic and per-chunk shapes hold
+    ConformerStreamingState state1, state2;
+    for (int t = 0; t < timesteps; t += chunkSize) {
+      auto chunk = input(fl::span, fl::range(t, t + chunkSize));
+      auto out1 = tr.forwardChunk(chunk, state1);
+      auto out2 = tr.forwardChunk(chunk, state2);
+      ASSERT_EQ(out1.dim(0), c);
+      ASSERT_EQ(out1.dim(1), chunkSize);
+      ASSERT_EQ(out1.dim(2), batchsize);
+      ASSERT_TRUE(allClose(out1.tensor(), out2.tensor()));
+    }
+    // the depthwise conv context carries (kernel - 1) / 2 frames
+    ASSERT_EQ(state1.convContext.dim(1), (kernel - 1) / 2);
+  }
+
+  // the attention context window is trimmed to its bound
+  {
+    auto tr = Conformer(c, c / nheads, c, nheads, 0, kernel, 0., 0.);
+    tr.eval();
+    ConformerStreamingState state;
+    state.attnContextSize = 6;
+    for (int t = 0; t < timesteps; t += chunkSize) {
+      auto chunk = Variable(fl::rand({c, chunkSize, batchsize}), false);
+      tr.forwardChunk(chunk, state);
+      ASSERT_LE(state.attnKeys.dim(0), 6);
+    }
+    ASSERT_EQ(state.attnKeys.dim(0), 6);
+  }
+
+  // chunks longer than the relative positional embedding context are invalid
+  {
+    auto tr = Conformer(c, c / nheads, c, nheads, chunkSize, kernel, 0., 0.);
+    tr.eval();
+    ConformerStreamingState state;
+    ASSERT_THROW(
+        tr.forwardChunk(
+            Variable(fl::rand({c, chunkSize + 1, batchsize}), false), state),
+        std::invalid_argument);
+  }
+}
+
 void positionEmbeddingFwd(bool isfp16) {
   int batchsize = 10;
   int timesteps = 120;
@@ -320,6 +518,16 @@ void sinusoidalPositionEmbeddingFwd(bool isfp16) {
   }
   ASSERT_TRUE((fl::amax(castOutput, {0})).scalar<float>() <= 2);
   ASSERT_TRUE((fl::amin(castOutput, {0})).scalar<float>() >= -2);
+
+  // the cached table is sliced for shorter inputs and regrown for longer
+  // ones; either way the embeddings added per position are identical
+  auto shorter = posemb.forward({input(fl::span, fl::range(0, 10))});
+  ASSERT_TRUE(allClose(
+      shorter[0], output[0](fl::span, fl::range(0, 10)), isfp16 ? 1e-2 : 1e-5));
+  auto longerIn =
+      Variable(fl::rand({csz, 2 * timesteps, batchsize, 1}, dtype), false);
+  auto longer = posemb.forward({longerIn});
+  ASSERT_EQ(longer[0].dim(1), 2 * timesteps);
 }
 
 TEST(ContribModuleTest, SinusoidalPositionEmbeddingFwd) {
@@ -487,6 +695,125 @@ TEST_F(ContribModuleTestF16, RawWavSpecAugmentFwdF16) {
   computeRawWavSpecAug(true, 1e-2);
 }
 
+TEST(ContribModuleTest, QuantizePerChannelInt8RoundTrip) {
+  auto weight = fl::rand({16, 32}) * 2 - 1;
+  auto [quantized, scales] = quantizePerChannelInt8(weight, 0);
+  ASSERT_EQ(quantized.type(), fl::dtype::u8);
+  ASSERT_EQ(quantized.shape(), weight.shape());
+  ASSERT_EQ(scales.shape(), Shape({16, 1}));
+
+  // symmetric int8 reconstruction error is bounded by half a step per channel
+  auto reconstructed = dequantizePerChannelInt8(quantized, scales, 0);
+  auto maxError = fl::amax(fl::abs(reconstructed - weight)).asScalar<double>();
+  auto maxStep = fl::amax(scales).asScalar<double>();
+  ASSERT_LE(maxError, maxStep / 2 + 1e-6);
+}
+
+TEST(ContribModuleTest, ActivationObserver) {
+  ActivationObserver observer;
+  auto input = Variable(fl::rand({8, 4}) * 3 - 1.5, false);
+  auto out = observer.forward(input);
+  ASSERT_TRUE(allClose(out.tensor(), input.tensor()));
+  ASSERT_NEAR(
+      observer.absMax(),
+      fl::amax(fl::abs(input.tensor())).asScalar<double>(),
+      1e-6);
+
+  observer.reset();
+  ASSERT_EQ(observer.absMax(), 0.);
+}
+
+TEST(ContribModuleTest, QuantizedLinearFwd) {
+  auto linear = Linear(32, 16);
+  auto input = Variable(fl::rand({32, 8}) * 2 - 1, false);
+  auto reference = linear.forward(input);
+
+  QuantizedLinear quantized(linear);
+  auto out = quantized.forward(input);
+  ASSERT_EQ(out.shape(), reference.shape());
+  // per-channel int8 weights keep the output close to f32
+  ASSERT_TRUE(allClose(out.tensor(), reference.tensor(), 1e-1));
+
+  // with a calibrated input range, activations are quantized too
+  ActivationObserver observer;
+  observer.forward(input);
+  QuantizedLinear calibrated(linear, observer.absMax());
+  auto calibratedOut = calibrated.forward(input);
+  ASSERT_EQ(calibratedOut.shape(), reference.shape());
+  ASSERT_TRUE(allClose(calibratedOut.tensor(), reference.tensor(), 2e-1));
+}
+
+TEST(ContribModuleTest, QuantizedConv2DFwd) {
+  auto conv = Conv2D(4, 8, 3, 3, 1, 1, 1, 1);
+  auto input = Variable(fl::rand({13, 13, 4, 2}) * 2 - 1, false);
+  auto reference = conv.forward(input);
+
+  QuantizedConv2D quantized(conv);
+  auto out = quantized.forward(input);
+  ASSERT_EQ(out.shape(), reference.shape());
+  ASSERT_TRUE(allClose(out.tensor(), reference.tensor(), 1e-1));
+}
+
+TEST(ContribModuleTest, PruneMaskNM) {
+  auto weight = fl::rand({8, 16}) * 2 - 1;
+  auto mask = pruneMaskNM(weight, 2, 4);
+  ASSERT_EQ(mask.type(), fl::dtype::b8);
+  ASSERT_EQ(mask.shape(), weight.shape());
+
+  // every group of 4 consecutive input weights keeps exactly 2 survivors
+  auto groupCounts =
+      fl::sum(fl::reshape(mask.astype(fl::dtype::s32), {8, 4, 4}), {1});
+  ASSERT_TRUE(fl::all(groupCounts == 2).asScalar<char>());
+  // the survivors are the largest magnitudes: the kept mass dominates
+  auto keptMass = fl::sum(fl::abs(weight) * mask.astype(weight.type()));
+  auto totalMass = fl::sum(fl::abs(weight));
+  ASSERT_GT(keptMass.asScalar<double>(), totalMass.asScalar<double>() / 2);
+
+  ASSERT_THROW(pruneMaskNM(weight, 5, 4), std::invalid_argument);
+  ASSERT_THROW(pruneMaskNM(weight, 2, 5), std::invalid_argument);
+}
+
+TEST(ContribModuleTest, PruneMaskBlock) {
+  auto weight = fl::rand({16, 16}) + 0.1;
+  auto mask = pruneMaskBlock(weight, 4, 4, 0.5);
+  ASSERT_EQ(mask.shape(), weight.shape());
+  // half the 4x4 blocks are zeroed, and blocks are pruned whole
+  auto blockCounts = fl::sum(
+      fl::reshape(mask.astype(fl::dtype::s32), {4, 4, 4, 4}), {0, 2});
+  ASSERT_TRUE(
+      fl::all((blockCounts == 0) || (blockCounts == 16)).asScalar<char>());
+  ASSERT_EQ(fl::sum(blockCounts == 0).asScalar<int>(), 8);
+
+  // sparsity 0 keeps everything
+  auto full = pruneMaskBlock(weight, 4, 4, 0.f);
+  ASSERT_TRUE(fl::all(full).asScalar<char>());
+}
+
+TEST(ContribModuleTest, SparseLinearFwd) {
+  auto linear = Linear(16, 12);
+  auto input = Variable(fl::rand({16, 5}) * 2 - 1, false);
+
+  auto mask = pruneMaskBlock(linear.param(0).tensor(), 4, 4, 0.5);
+  auto reference = Variable(
+      fl::matmul(
+          linear.param(0).tensor() * mask.astype(fl::dtype::f32),
+          input.tensor()) +
+          fl::tile(linear.param(1).tensor(), {1, 5}),
+      false);
+
+  SparseLinear sparse(linear, mask, 4, 4);
+  ASSERT_EQ(sparse.numBlocks(), 12);
+  ASSERT_EQ(sparse.numNonzeroBlocks(), 6);
+  auto out = sparse.forward(input);
+  ASSERT_EQ(out.shape(), reference.shape());
+  ASSERT_TRUE(allClose(out.tensor(), reference.tensor(), 1e-5));
+
+  // the sparsity convenience constructor matches the explicit-mask one
+  SparseLinear fromSparsity(linear, 0.5f, 4, 4);
+  ASSERT_EQ(fromSparsity.numNonzeroBlocks(), 6);
+  ASSERT_TRUE(allClose(fromSparsity.forward(input).tensor(), out.tensor()));
+}
+
 int main(int argc, char** argv) {
   ::testing::InitGoogleTest(&argc, argv);
   fl::init();
@@ -6,6 +6,7 @@
  */
 
 #include <chrono>
+#include <set>
 #include <thread>
 
 #include <gtest/gtest.h>
@@ -32,6 +33,19 @@ TEST(DatasetTest, TensorDataset) {
   ASSERT_EQ(ff1.size(), 2);
   ASSERT_TRUE(allClose(ff1[0], tensormap[0](fl::span, fl::span, 10)));
   ASSERT_TRUE(allClose(ff1[1], tensormap[1](fl::span, 10)));
+
+  // batched range access matches per-sample access
+  auto range = tensords.getRange(5, 15);
+  ASSERT_EQ(range.size(), 10);
+  for (int64_t i = 0; i < range.size(); ++i) {
+    auto sample = tensords.get(5 + i);
+    ASSERT_EQ(range[i].size(), sample.size());
+    for (int64_t j = 0; j < sample.size(); ++j) {
+      ASSERT_TRUE(allClose(range[i][j], sample[j]));
+    }
+  }
+  ASSERT_EQ(tensords.getRange(10, 10).size(), 0);
+  ASSERT_THROW(tensords.getRange(200, 400), std::out_of_range);
 }
 
 TEST(DatasetTest, TranformDataset) {
@@ -50,6 +64,54 @@ TEST(DatasetTest, TranformDataset) {
   ASSERT_EQ(ff1.size(), 1);
   ASSERT_TRUE(
       allClose(ff1[0], fl::sin(tensormap[0](fl::span, fl::span, 10)) + 1.0));
+
+  // range access applies the transforms too
+  auto range = transformds.getRange(8, 12);
+  ASSERT_EQ(range.size(), 4);
+  for (int64_t i = 0; i < range.size(); ++i) {
+    ASSERT_TRUE(allClose(range[i][0], transformds.get(8 + i)[0]));
+  }
+}
+
+TEST(DatasetTest, MemoizedTransformDataset) {
+  std::vector<Tensor> tensormap = {fl::rand({10, 20, 30})};
+  auto tensords = std::make_shared<TensorDataset>(tensormap);
+
+  int numCalls = 0;
+  Dataset::TransformFunction countingTransform = [&numCalls](const Tensor& a) {
+    ++numCalls;
+    return fl::sin(a) + 1.0;
+  };
+
+  // budget large enough to hold the whole transformed set
+  TransformDataset memods(
+      tensords,
+      {countingTransform},
+      /* cacheBytes = */ 100 * 1024 * 1024);
+  TransformDataset plainds(tensords, {countingTransform});
+
+  // repeated epochs recompute each sample only once
+  for (int epoch = 0; epoch < 3; ++epoch) {
+    for (int64_t i = 0; i < memods.size(); ++i) {
+      ASSERT_TRUE(allClose(memods.get(i)[0], plainds.get(i)[0]));
+    }
+  }
+  // plainds contributes one call per sample per epoch; memods one per sample
+  ASSERT_EQ(numCalls, 4 * memods.size());
+
+  // range access is served from the cache too
+  numCalls = 0;
+  auto range = memods.getRange(3, 7);
+  ASSERT_EQ(range.size(), 4);
+  ASSERT_EQ(numCalls, 0);
+
+  // zero budget disables memoization
+  TransformDataset uncachedds(
+      tensords, {countingTransform}, /* cacheBytes = */ 0);
+  numCalls = 0;
+  uncachedds.get(0);
+  uncachedds.get(0);
+  ASSERT_EQ(numCalls, 2);
 }
 
 TEST(DatasetTest, BatchDataset) {
@@ -72,6 +134,65 @@ TEST(DatasetTest, BatchDataset) {
   ASSERT_EQ(ff1.size(), 1);
   ASSERT_TRUE(
       allClose(ff1[0], tensormap[0](fl::span, fl::span, fl::range(70, 77))));
+
+  // parallel collation matches serial collation
+  std::vector<Tensor> multimap = {fl::rand({10, 300}), fl::rand({5, 6, 300})};
+  auto multids = std::make_shared<TensorDataset>(multimap);
+  BatchDataset serialds(multids, 7, BatchDatasetPolicy::INCLUDE_LAST);
+  BatchDataset parallelds(multids, 7, BatchDatasetPolicy::INCLUDE_LAST, {}, 2);
+  for (int64_t i = 0; i < serialds.size(); ++i) {
+    auto serial = serialds.get(i);
+    auto parallel = parallelds.get(i);
+    ASSERT_EQ(serial.size(), parallel.size());
+    for (int64_t j = 0; j < serial.size(); ++j) {
+      ASSERT_TRUE(allClose(serial[j], parallel[j]));
+    }
+  }
+}
+
+TEST(DatasetTest, BucketBatchDataset) {
+  std::vector<Tensor> tensormap = {fl::arange({1, 10}, 1, fl::dtype::f32)};
+  auto tensords = std::make_shared<TensorDataset>(tensormap);
+  auto lengthfn = [](int64_t idx) { return idx + 1; };
+
+  BucketBatchDataset bucketds(tensords, lengthfn, 12);
+
+  // greedy packing of sorted lengths 1..10 under a budget of 12 padded
+  // tokens: {1,2,3}, {4,5}, then singletons
+  ASSERT_EQ(bucketds.size(), 7);
+  std::set<int> seen;
+  int64_t maxPaddedTokens = 0;
+  for (int64_t i = 0; i < bucketds.size(); ++i) {
+    auto batch = bucketds.get(i);
+    ASSERT_EQ(batch.size(), 1);
+    auto batchSize = batch[0].dim(1);
+    int64_t maxLength = 0;
+    for (int64_t j = 0; j < batchSize; ++j) {
+      auto idx = static_cast<int>(batch[0](0, j).scalar<float>());
+      seen.insert(idx);
+      maxLength = std::max(maxLength, lengthfn(idx));
+    }
+    maxPaddedTokens = std::max(maxPaddedTokens, batchSize * maxLength);
+  }
+  // every sample appears exactly once and no batch exceeds the budget
+  ASSERT_EQ(seen.size(), 10);
+  ASSERT_LE(maxPaddedTokens, 12);
+
+  // reshuffling changes batch order but not contents
+  bucketds.resample();
+  ASSERT_EQ(bucketds.size(), 7);
+  std::set<int> seenAfterResample;
+  for (int64_t i = 0; i < bucketds.size(); ++i) {
+    auto batch = bucketds.get(i);
+    for (int64_t j = 0; j < batch[0].dim(1); ++j) {
+      seenAfterResample.insert(static_cast<int>(batch[0](0, j).scalar<float>()));
+    }
+  }
+  ASSERT_EQ(seenAfterResample.size(), 10);
+
+  // a sample longer than the budget is rejected
+  ASSERT_THROW(
+      BucketBatchDataset(tensords, lengthfn, 5), std::invalid_argument);
 }
 
 TEST(DatasetTest, DynamicBatchDataset) {
@@ -121,6 +242,36 @@ TEST(DatasetTest, ShuffleDataset) {
   ASSERT_EQ(ff4.size(), 1);
   ASSERT_TRUE(allClose(ff2[0], ff3[0]));
   ASSERT_FALSE(allClose(ff2[0], ff4[0]));
+
+  // the shuffle is a bijection: every sample appears exactly once
+  {
+    std::vector<Tensor> iotamap = {fl::arange({1, 300}, 1, fl::dtype::f32)};
+    auto iotads = std::make_shared<TensorDataset>(iotamap);
+    ShuffleDataset iotashuffle(iotads, 7);
+    iotashuffle.resample();
+    std::set<int> seen;
+    for (int64_t i = 0; i < iotashuffle.size(); ++i) {
+      seen.insert(static_cast<int>(iotashuffle.get(i)[0].scalar<float>()));
+    }
+    ASSERT_EQ(seen.size(), 300);
+  }
+
+  // permutation state is checkpointable
+  {
+    ShuffleDataset original(tensords, 5);
+    original.resample();
+    original.resample();
+    const auto path = fs::temp_directory_path() / "shuffle_state.bin";
+    fl::save(path.string(), original.getState());
+
+    ShuffleDataset restored(tensords, 0);
+    ShuffleDataset::State state;
+    fl::load(path.string(), state);
+    restored.setState(state);
+    for (int64_t i : {0, 10, 299}) {
+      ASSERT_TRUE(allClose(original.get(i)[0], restored.get(i)[0]));
+    }
+  }
 }
 
 TEST(DatasetTest, ResampleDataset) {
@@ -300,6 +451,26 @@ TEST(DatasetTest, FileBlobDataset) {
     check(blob);
   }
 
+#ifndef _WIN32
+  // memory-mapped read-only mode
+  {
+    FileBlobDataset blob(
+        fs::temp_directory_path() / "data.blob", false, false, true);
+    check(blob);
+    // host transforms also work over the mapping
+    blob.setHostTransform(
+        0, [](void* ptr, fl::Shape size, fl::dtype /* type */) {
+          return Tensor::fromBuffer(size, (float*)ptr, MemoryLocation::Host);
+        });
+    check(blob);
+    // memory-mapped mode is read-only
+    ASSERT_THROW(
+        FileBlobDataset(
+            fs::temp_directory_path() / "data.blob", true, false, true),
+        std::invalid_argument);
+  }
+#endif
+
   // multi-threaded read
   {
     std::vector<std::vector<Tensor>> thdata(data.size());
@@ -381,6 +552,78 @@ TEST(DatasetTest, FileBlobDataset) {
   }
 }
 
+TEST(DatasetTest, BlobDatasetCompression) {
+  // small-range tokens (bitpackable), sparse labels (run-length codable),
+  // and dense floats (incompressible - kept raw)
+  auto tokens = (fl::rand({1000, 4}) * 100).astype(fl::dtype::s32);
+  auto labels = fl::full({500, 8}, 0., fl::dtype::f32);
+  labels(fl::range(0, 3)) = 1.;
+  auto dense = fl::rand({200, 10});
+  std::vector<Tensor> sample = {tokens, labels, dense};
+
+  auto check = [&sample](BlobDataset& blob) {
+    ASSERT_EQ(blob.size(), 1);
+    auto read = blob.get(0);
+    ASSERT_EQ(read.size(), sample.size());
+    for (int64_t j = 0; j < sample.size(); j++) {
+      ASSERT_TRUE(read.at(j).shape() == sample.at(j).shape());
+      ASSERT_EQ(read.at(j).type(), sample.at(j).type());
+      ASSERT_TRUE(allClose(read.at(j), sample.at(j)));
+    }
+  };
+
+  const auto path = fs::temp_directory_path() / "compressed.blob";
+  const auto rawPath = fs::temp_directory_path() / "uncompressed.blob";
+  {
+    FileBlobDataset blob(path, true, true);
+    blob.setCompression(BlobCompression::Auto);
+    blob.add(sample);
+    // entries decompress transparently before the index is written
+    check(blob);
+    blob.writeIndex();
+
+    FileBlobDataset rawBlob(rawPath, true, true);
+    rawBlob.add(sample);
+    rawBlob.writeIndex();
+  }
+  // compressible entries shrink the blob
+  ASSERT_LT(fs::file_size(path), fs::file_size(rawPath));
+
+  // re-opened blobs negotiate the codec from the index
+  {
+    FileBlobDataset blob(path);
+    check(blob);
+    // rawGet returns the decompressed payload bytes
+    auto raw = blob.rawGet(0);
+    ASSERT_EQ(raw.at(0).size(), tokens.bytes());
+    ASSERT_EQ(raw.at(1).size(), labels.bytes());
+  }
+#ifndef _WIN32
+  // compressed entries also read back through the memory mapping
+  {
+    FileBlobDataset blob(path, false, false, true);
+    check(blob);
+  }
+#endif
+
+  // compressed blobs concatenate into compression-enabled blobs
+  {
+    FileBlobDataset blob(path);
+    FileBlobDataset copy(fs::temp_directory_path() / "copy.blob", true, true);
+    copy.add(blob);
+    copy.writeIndex();
+    check(copy);
+  }
+
+  // per-codec roundtrips, including entries that don't compress
+  for (auto codec : {BlobCompression::RunLength, BlobCompression::Bitpack}) {
+    MemoryBlobDataset blob;
+    blob.setCompression(codec);
+    blob.add(sample);
+    check(blob);
+  }
+}
+
 TEST(DatasetTest, MemoryBlobDataset) {
   std::vector<std::vector<Tensor>> data;
 
@@ -534,6 +777,131 @@ TEST(DatasetTest, MemoryBlobDataset) {
   }
 }
 
+#ifndef _WIN32
+TEST(DatasetTest, ShmBlobDataset) {
+  const std::string shmName = "/fl-test-data-blob";
+  ShmBlobDataset::unlink(shmName);
+  std::vector<std::vector<Tensor>> data;
+
+  auto fillup = [&data](ShmBlobDataset& blob) {
+    for (int64_t i = 0; i < 20; i++) {
+      std::vector<Tensor> sample;
+      for (int64_t j = 0; j < i % 4; j++) {
+        Tensor tensor;
+        if (j % 2 == 0) {
+          tensor = fl::rand({100, 3, 100});
+        } else {
+          tensor = fl::rand({100, 200});
+        }
+        sample.push_back(tensor);
+      }
+      data.push_back(sample);
+      blob.add(sample);
+    }
+    blob.flush();
+  };
+
+  auto check = [&data](ShmBlobDataset& blob) {
+    ASSERT_EQ(data.size(), blob.size());
+    for (int64_t i = 0; i < blob.size(); i++) {
+      auto blobSample = blob.get(i);
+      auto datSample = data.at(i);
+      ASSERT_EQ(datSample.size(), blobSample.size());
+      for (int64_t j = 0; j < blobSample.size(); j++) {
+        ASSERT_TRUE(
+            fl::norm(datSample.at(j).flatten() - blobSample.at(j).flatten())
+                .scalar<float>() <= 1e-05);
+      }
+    }
+  };
+
+  // check read-write capabilities
+  {
+    ShmBlobDataset blob(shmName, true, true);
+    fillup(blob);
+    check(blob);
+    fillup(blob);
+    check(blob);
+    blob.writeIndex();
+    check(blob);
+
+    // a second dataset attached to the same segment shares the one copy
+    ShmBlobDataset peer(shmName);
+    check(peer);
+
+    // zero-copy host transforms work over the shared pages
+    peer.setHostTransform(
+        0, [](void* ptr, fl::Shape size, fl::dtype /* type */) {
+          return Tensor::fromBuffer(size, (float*)ptr, MemoryLocation::Host);
+        });
+    check(peer);
+  }
+
+  // check everything is correct after re-attaching
+  {
+    ShmBlobDataset blob(shmName);
+    check(blob);
+  }
+
+  // previous samples are read back when reopening in read-write mode
+  {
+    ShmBlobDataset blob(shmName, true);
+    check(blob);
+    fillup(blob);
+    blob.writeIndex();
+    check(blob);
+  }
+
+  // multi-threaded write
+  {
+    // add an index
+    for (int i = 0; i < data.size(); i++) {
+      data[i].push_back(fl::full({1}, i, fl::dtype::f32));
+    }
+    {
+      auto blob = std::make_shared<ShmBlobDataset>(shmName, true, true);
+      std::vector<std::thread> workers;
+      const int nworker = 10;
+      int nperworker = data.size() / nworker;
+      auto device = fl::getDevice();
+      for (int i = 0; i < nworker; i++) {
+        workers.emplace_back([i, blob, nperworker, device, &data]() {
+          fl::setDevice(device);
+          for (int j = 0; j < nperworker; j++) {
+            blob->add(data[i * nperworker + j]);
+          }
+        });
+      }
+      for (int i = 0; i < nworker; i++) {
+        workers[i].join();
+      }
+      blob->writeIndex();
+    }
+    {
+      auto blob = std::make_shared<ShmBlobDataset>(shmName);
+      ASSERT_EQ(data.size(), blob->size());
+      for (int64_t i = 0; i < data.size(); i++) {
+        auto blobSample = blob->get(i);
+        auto idx = (int)blobSample.back().scalar<float>();
+        ASSERT_TRUE(idx >= 0 && idx < data.size());
+        auto dataSample = data.at(idx);
+        ASSERT_EQ(dataSample.size(), blobSample.size());
+        for (int64_t j = 0; j < blobSample.size(); j++) {
+          ASSERT_TRUE(dataSample.at(j).shape() == blobSample.at(j).shape());
+          ASSERT_TRUE(
+              fl::norm(dataSample.at(j).flatten() - blobSample.at(j).flatten())
+                  .scalar<float>() <= 1e-05);
+        }
+      }
+    }
+  }
+
+  ShmBlobDataset::unlink(shmName);
+  // unlinking a missing segment is not an error
+  ShmBlobDataset::unlink(shmName);
+}
+#endif
+
 TEST(DatasetTest, PrefetchDatasetCorrectness) {
   std::vector<Tensor> tensormap = {fl::rand({100, 200, 300})};
   auto tensords = std::make_shared<TensorDataset>(tensormap);
@@ -554,7 +922,103 @@ TEST(DatasetTest, PrefetchDatasetCorrectness) {
       ASSERT_TRUE(allClose(sample1[j], sample2[j]));
     }
   }
+
+  // out-of-order ring mode with backpressure watermark
+  auto ringDs = std::make_shared<PrefetchDataset>(transformDs, 2, 4, 2);
+  for (int i = 0; i < transformDs->size(); ++i) {
+    auto sample1 = transformDs->get(i);
+    auto sample2 = ringDs->get(i);
+    ASSERT_EQ(sample1.size(), sample2.size());
+    for (int j = 0; j < sample1.size(); ++j) {
+      ASSERT_TRUE(allClose(sample1[j], sample2[j]));
+    }
+  }
+  // non-sequential access resets the ring
+  {
+    auto sample1 = transformDs->get(0);
+    auto sample2 = ringDs->get(0);
+    ASSERT_EQ(sample1.size(), sample2.size());
+    for (int j = 0; j < sample1.size(); ++j) {
+      ASSERT_TRUE(allClose(sample1[j], sample2[j]));
+    }
+  }
+  ASSERT_THROW(
+      PrefetchDataset(transformDs, 2, 2, -1), std::invalid_argument);
+
+  // auto-tuned depth stays within [1, 4x constructed] and samples are intact
+  auto tunedDs =
+      std::make_shared<PrefetchDataset>(transformDs, 2, 2, 0, true);
+  for (int i = 0; i < transformDs->size(); ++i) {
+    ASSERT_TRUE(allClose(transformDs->get(i)[0], tunedDs->get(i)[0]));
+  }
+  ASSERT_GE(tunedDs->prefetchSize(), 1);
+  ASSERT_LE(tunedDs->prefetchSize(), 8);
+  // auto-tuning is in-order queue mode only
+  ASSERT_THROW(
+      PrefetchDataset(transformDs, 2, 4, 2, true), std::invalid_argument);
+  ASSERT_THROW(
+      PrefetchDataset(transformDs, 0, 0, 0, true), std::invalid_argument);
+}
+
+TEST(DatasetTest, DevicePrefetchDatasetCorrectness) {
+  std::vector<Tensor> tensormap = {fl::rand({50, 60, 20})};
+  auto tensords = std::make_shared<TensorDataset>(tensormap);
+
+  // freshly host-constructed samples exercise the pinned staging path on
+  // backends whose tensors report a host location; device-resident ones
+  // pass through untouched
+  Dataset::TransformFunction roundTrip = [](const Tensor& a) {
+    auto vec = a.toHostVector<float>();
+    return Tensor::fromVector(a.shape(), vec);
+  };
+  auto hostDs = std::make_shared<TransformDataset>(
+      tensords, std::vector<Dataset::TransformFunction>{roundTrip});
+
+  for (auto underlying :
+       std::vector<std::shared_ptr<Dataset>>{tensords, hostDs}) {
+    auto deviceDs = std::make_shared<DevicePrefetchDataset>(underlying);
+    ASSERT_EQ(deviceDs->size(), underlying->size());
+    for (int i = 0; i < underlying->size(); ++i) {
+      auto sample1 = underlying->get(i);
+      auto sample2 = deviceDs->get(i);
+      ASSERT_EQ(sample1.size(), sample2.size());
+      for (int j = 0; j < sample1.size(); ++j) {
+        ASSERT_TRUE(allClose(sample1[j], sample2[j]));
+      }
+    }
+    // non-sequential access discards the in-flight sample
+    ASSERT_TRUE(allClose(underlying->get(3)[0], deviceDs->get(3)[0]));
+    ASSERT_TRUE(allClose(underlying->get(4)[0], deviceDs->get(4)[0]));
+  }
+
+  ASSERT_THROW(DevicePrefetchDataset(nullptr), std::invalid_argument);
+}
+
+#ifndef _WIN32
+TEST(DatasetTest, ProcessPrefetchDatasetCorrectness) {
+  std::vector<Tensor> tensormap = {fl::rand({20, 40})};
+  auto tensords = std::make_shared<TensorDataset>(tensormap);
+
+  auto prefetchDs = std::make_shared<ProcessPrefetchDataset>(tensords, 2);
+  for (int i = 0; i < tensords->size(); ++i) {
+    auto sample1 = tensords->get(i);
+    auto sample2 = prefetchDs->get(i);
+    ASSERT_EQ(sample1.size(), sample2.size());
+    for (int j = 0; j < sample1.size(); ++j) {
+      ASSERT_TRUE(allClose(sample1[j], sample2[j]));
+    }
+  }
+  // non-sequential access
+  auto sample1 = tensords->get(3);
+  auto sample2 = prefetchDs->get(3);
+  ASSERT_TRUE(allClose(sample1[0], sample2[0]));
+
+  // samples that do not fit in the arena are reported
+  auto smallArenaDs =
+      std::make_shared<ProcessPrefetchDataset>(tensords, 1, 16);
+  ASSERT_THROW(smallArenaDs->get(0), std::runtime_error);
 }
+#endif
 
 TEST(DatasetTest, DISABLED_PrefetchDatasetPerformance) {
   // Flaky test. Disabled for now.
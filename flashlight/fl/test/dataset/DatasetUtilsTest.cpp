@@ -12,6 +12,7 @@
 
 #include "flashlight/fl/dataset/datasets.h"
 #include "flashlight/fl/tensor/Init.h"
+#include "flashlight/fl/tensor/Random.h"
 
 using namespace fl;
 
@@ -33,6 +34,43 @@ TEST(DatasetTest, RoundRobinPacker) {
   ASSERT_EQ(samples, std::vector<int64_t>({0, 1, 4, 5}));
 }
 
+TEST(DatasetTest, RoundRobinPartitionArithmetic) {
+  // the O(1) size/index functions must agree with the materialized ids
+  for (int64_t numSamples : {0, 1, 7, 8, 9, 10, 11, 23}) {
+    for (int64_t numPartitions : {1, 2, 3}) {
+      for (int64_t partitionId = 0; partitionId < numPartitions;
+           ++partitionId) {
+        for (int64_t batchSz : {1, 2, 4}) {
+          for (bool allowEmpty : {false, true}) {
+            auto samples = partitionByRoundRobin(
+                numSamples, partitionId, numPartitions, batchSz, allowEmpty);
+            ASSERT_EQ(
+                samples.size(),
+                roundRobinPartitionSize(
+                    numSamples,
+                    partitionId,
+                    numPartitions,
+                    batchSz,
+                    allowEmpty));
+            for (size_t i = 0; i < samples.size(); ++i) {
+              ASSERT_EQ(
+                  samples[i],
+                  roundRobinPartitionIndex(
+                      numSamples,
+                      i,
+                      partitionId,
+                      numPartitions,
+                      batchSz,
+                      allowEmpty));
+            }
+          }
+        }
+      }
+    }
+  }
+  ASSERT_THROW(roundRobinPartitionIndex(10, 5, 0, 2), std::out_of_range);
+}
+
 TEST(DatasetTest, DynamicRoundRobinPacker) {
   std::vector<float> length = {2, 4, 1, 2, 3, 7, 4, 3};
   auto samples = dynamicPartitionByRoundRobin(length, 0, 2, 12);
@@ -53,6 +91,51 @@ TEST(DatasetTest, DynamicRoundRobinPacker) {
   ASSERT_EQ(samples.second, std::vector<int64_t>({3, 1}));
 }
 
+TEST(DatasetTest, FlattenDataset) {
+  auto tensor1 = fl::rand({4, 10});
+  auto tensor2 = fl::rand({4, 6});
+  auto ds1 = std::make_shared<TensorDataset>(std::vector<Tensor>{tensor1});
+  auto ds2 = std::make_shared<TensorDataset>(std::vector<Tensor>{tensor2});
+
+  // resample-of-resample over one dataset collapses to a single remapping
+  auto inner = std::make_shared<ResampleDataset>(
+      ds1, std::vector<int64_t>{9, 8, 7, 6, 5, 4});
+  auto outer = std::make_shared<ResampleDataset>(
+      inner, std::vector<int64_t>{5, 3, 1});
+  auto flat = flattenDataset(outer);
+  auto flatResample = std::dynamic_pointer_cast<const ResampleDataset>(flat);
+  ASSERT_NE(flatResample, nullptr);
+  ASSERT_EQ(flatResample->underlyingDataset(), ds1);
+  ASSERT_EQ(flat->size(), outer->size());
+  for (int64_t i = 0; i < flat->size(); ++i) {
+    ASSERT_TRUE(allClose(flat->get(i)[0], outer->get(i)[0]));
+  }
+
+  // a concat mid-chain resolves each sample straight to its leaf dataset
+  auto concat = std::make_shared<ConcatDataset>(
+      std::vector<std::shared_ptr<const Dataset>>{ds1, ds2});
+  std::vector<int64_t> reversed(concat->size());
+  for (int64_t i = 0; i < concat->size(); ++i) {
+    reversed[i] = concat->size() - 1 - i;
+  }
+  auto stacked = std::make_shared<ResampleDataset>(
+      std::make_shared<ResampleDataset>(concat, reversed),
+      std::vector<int64_t>{0, 4, 8, 12});
+  auto flatStack = flattenDataset(stacked);
+  ASSERT_EQ(flatStack->size(), stacked->size());
+  for (int64_t i = 0; i < flatStack->size(); ++i) {
+    ASSERT_TRUE(allClose(flatStack->get(i)[0], stacked->get(i)[0]));
+  }
+
+  // lazily-mapped wrappers are preserved, not frozen
+  auto shuffled = std::make_shared<ShuffleDataset>(ds1);
+  ASSERT_EQ(flattenDataset(shuffled), shuffled);
+
+  // plain datasets pass through untouched
+  ASSERT_EQ(flattenDataset(ds1), ds1);
+  ASSERT_THROW(flattenDataset(nullptr), std::invalid_argument);
+}
+
 int main(int argc, char** argv) {
   ::testing::InitGoogleTest(&argc, argv);
   fl::init();
@@ -15,7 +15,11 @@
 
 #include "flashlight/fl/common/Filesystem.h"
 #include "flashlight/fl/distributed/distributed.h"
+#include "flashlight/fl/nn/DistributedUtils.h"
+#include "flashlight/fl/nn/nn.h"
+#include "flashlight/fl/optim/optim.h"
 #include "flashlight/fl/tensor/Init.h"
+#include "flashlight/fl/tensor/Random.h"
 #include "flashlight/fl/tensor/TensorBase.h"
 
 using namespace fl;
@@ -75,6 +79,24 @@ TEST(Distributed, AllReduceAsync) {
   ASSERT_TRUE(fl::all(var.tensor() == expected_val).scalar<char>());
 }
 
+TEST(Distributed, AllReduceAsyncFuture) {
+  if (!isDistributedInit()) {
+    GTEST_SKIP() << "Distributed initialization failed or not enabled.";
+  }
+
+  auto rank = getWorldRank();
+  auto size = getWorldSize();
+
+  auto arr = fl::full({10}, rank, dtype::f32);
+
+  // waiting on the future fences this reduction only -- no syncDistributed
+  auto done = allReduceAsync(arr);
+  done.wait();
+
+  float expected_val = size * (size - 1.0) / 2.0;
+  ASSERT_TRUE(fl::all(arr == expected_val).scalar<char>());
+}
+
 TEST(Distributed, AllReduceSetAsync) {
   if (!isDistributedInit()) {
     GTEST_SKIP() << "Distributed initialization failed or not enabled.";
@@ -182,6 +204,264 @@ TEST(Distributed, CoalescingReducer) {
   }
 }
 
+TEST(Distributed, PerBucketOptimizerStep) {
+  if (!isDistributedInit()) {
+    GTEST_SKIP() << "Distributed initialization failed or not enabled.";
+  }
+
+  auto rank = getWorldRank();
+  auto size = getWorldSize();
+
+  // identical parameters on every rank; the overlapped optimizer updates
+  // each bucket as its reduction completes and must land on the same result
+  // as a reference optimizer stepping after all reductions
+  unsigned vSize = (1 << 20);
+  std::vector<Variable> params, refParams;
+  for (int i = 0; i < 10; ++i) {
+    auto data = fl::full({vSize}, 1.0 + i, dtype::f32);
+    params.emplace_back(data, true);
+    refParams.emplace_back(data.copy(), true);
+  }
+  auto opt = std::make_shared<AdamOptimizer>(params, 0.01);
+  AdamOptimizer ref(refParams, 0.01);
+
+  auto reducer = std::make_shared<fl::CoalescingReducer>(
+      /* scale = */ 1.0 / size,
+      /*async=*/true && !FL_BACKEND_CPU,
+      /*contiguous=*/true && !FL_BACKEND_CPU);
+  distributeOptimizerStepBucketed(opt, reducer, params);
+
+  for (int iter = 0; iter < 2; ++iter) {
+    for (int i = 0; i < 10; ++i) {
+      // rank r contributes (r + 1); the average over ranks is (size + 1) / 2
+      params[i].addGrad(
+          Variable(fl::full({vSize}, (rank + 1.) * 0.1, dtype::f32), false));
+      refParams[i].addGrad(Variable(
+          fl::full({vSize}, (size + 1.) / 2. * 0.1, dtype::f32), false));
+      reducer->add(params[i].grad());
+    }
+    // finalize() flushes the tail bucket, whose callback issues the last
+    // partial step -- no step() call follows
+    reducer->finalize();
+    opt->zeroGrad();
+    ref.step();
+    ref.zeroGrad();
+  }
+
+  for (int i = 0; i < 10; ++i) {
+    ASSERT_TRUE(allClose(params[i].tensor(), refParams[i].tensor(), 1e-5));
+  }
+}
+
+TEST(Distributed, CompressingReducer) {
+  if (!isDistributedInit()) {
+    GTEST_SKIP() << "Distributed initialization failed or not enabled.";
+  }
+  if (FL_BACKEND_CPU) {
+    GTEST_SKIP() << "f16 allReduce not supported for the CPU backend.";
+  }
+
+  auto rank = getWorldRank();
+  auto size = getWorldSize();
+
+  auto s = std::make_shared<fl::CompressingReducer>(
+      /* scale = */ 1.0 / size,
+      /*async=*/true);
+
+  // small integers are exactly representable in f16, so compressed
+  // synchronization must match the full-precision result
+  std::vector<Variable> vars;
+  for (size_t i = 0; i < 10; ++i) {
+    vars.emplace_back(fl::full({100}, rank + 1, dtype::f32), false);
+  }
+
+  for (auto& var : vars) {
+    s->add(var);
+  }
+  s->finalize();
+
+  float expected_val = size * (size + 1.0);
+  for (const auto& var : vars) {
+    // The reducer scales down by a factor of 1 / size
+    auto arr = var.tensor() * (size * 2);
+    ASSERT_TRUE(fl::all(arr == expected_val).scalar<char>());
+  }
+}
+
+TEST(Distributed, BucketedGradSync) {
+  if (!isDistributedInit()) {
+    GTEST_SKIP() << "Distributed initialization failed or not enabled.";
+  }
+
+  auto rank = getWorldRank();
+  auto size = getWorldSize();
+  // not supported for the CPU backend
+  bool async = true && !FL_BACKEND_CPU;
+
+  // identically-seeded models so every rank starts from the same parameters
+  fl::setSeed(42);
+  auto model = std::make_shared<Sequential>();
+  model->add(Linear(8, 8));
+  model->add(Linear(8, 8));
+  fl::setSeed(42);
+  auto ref = std::make_shared<Sequential>();
+  ref->add(Linear(8, 8));
+  ref->add(Linear(8, 8));
+
+  // small buckets so the model spans several of them
+  distributeModuleGradsBucketed(
+      model, /* bucketSizeBytes = */ 300, 1.0 / size, async);
+
+  auto input = Variable(fl::full({8, 4}, 0.5), false);
+  auto loss = sum(model->forward(input) * (rank + 1.0), {0, 1});
+  loss.backward();
+  syncDistributed();
+
+  auto refLoss = sum(ref->forward(input), {0, 1});
+  refLoss.backward();
+
+  // rank r scales its loss by (r + 1); the averaged gradient is the
+  // reference gradient scaled by the mean of (r + 1) over ranks
+  float expectedScale = (size + 1.0) / 2.0;
+  auto modelParams = model->params();
+  auto refParams = ref->params();
+  for (size_t i = 0; i < modelParams.size(); ++i) {
+    auto expected = refParams[i].grad().tensor() * expectedScale;
+    ASSERT_TRUE(allClose(modelParams[i].grad().tensor(), expected, 1e-4));
+  }
+}
+
+TEST(Distributed, CoalescingReducerHierarchical) {
+  if (!isDistributedInit()) {
+    GTEST_SKIP() << "Distributed initialization failed or not enabled.";
+  }
+
+  auto rank = getWorldRank();
+  auto size = getWorldSize();
+
+  auto s = std::make_shared<fl::CoalescingReducer>(
+      /* scale = */ 1.0 / size,
+      /*async=*/true && !FL_BACKEND_CPU,
+      /*contiguous=*/true && !FL_BACKEND_CPU,
+      /*hierarchical=*/true);
+
+  unsigned vSize = (1 << 20);
+  std::vector<Variable> vars;
+  for (size_t i = 0; i < 100; ++i) {
+    vars.emplace_back(fl::full({vSize}, rank + 1, dtype::f32), false);
+  }
+
+  for (size_t i = 0; i < vars.size(); ++i) {
+    s->add(vars[i]);
+    if ((i + 1) % 10 == 0) {
+      s->finalize();
+    }
+  }
+
+  float expected_val = size * (size + 1.0);
+  for (const auto& var : vars) {
+    // The reducer scales down by a factor of 1 / size
+    auto arr = var.tensor() * (size * 2);
+    ASSERT_TRUE(fl::all(arr == expected_val).scalar<char>());
+  }
+}
+
+TEST(Distributed, AllToAllv) {
+  if (!isDistributedInit()) {
+    GTEST_SKIP() << "Distributed initialization failed or not enabled.";
+  }
+  auto rank = getWorldRank();
+  auto size = getWorldSize();
+  if (FL_BACKEND_CPU && size > 1) {
+    GTEST_SKIP() << "allToAllv not supported for the CPU backend.";
+  }
+
+  // rank r sends j + 1 elements with value r * 100 + j to rank j
+  std::vector<int64_t> sendCounts(size), recvCounts(size);
+  std::vector<float> sendData;
+  for (int j = 0; j < size; ++j) {
+    sendCounts[j] = j + 1;
+    recvCounts[j] = rank + 1;
+    for (int64_t k = 0; k < sendCounts[j]; ++k) {
+      sendData.push_back(rank * 100 + j);
+    }
+  }
+  auto sendBuf = Tensor::fromVector(sendData);
+
+  // the single-group exchange and the pipelined rounds agree
+  for (int numChunks : {1, 3}) {
+    auto recvBuf =
+        allToAllv(sendBuf, sendCounts, recvCounts, false, numChunks);
+    ASSERT_EQ(recvBuf.elements(), size * (rank + 1));
+    auto recvVec = recvBuf.toHostVector<float>();
+    int64_t offset = 0;
+    for (int j = 0; j < size; ++j) {
+      for (int64_t k = 0; k < recvCounts[j]; ++k) {
+        ASSERT_FLOAT_EQ(recvVec[offset++], j * 100 + rank);
+      }
+    }
+  }
+
+  ASSERT_THROW(
+      allToAllv(sendBuf, sendCounts, recvCounts, false, 0),
+      std::invalid_argument);
+  ASSERT_THROW(allToAllv(sendBuf, {}, {}), std::invalid_argument);
+}
+
+TEST(Distributed, Reinit) {
+  if (!isDistributedInit()) {
+    GTEST_SKIP() << "Distributed initialization failed or not enabled.";
+  }
+
+  // This harness rendezvouses through MPI, which fixes the world at launch;
+  // re-rendezvous is only defined for store-based init methods, so the
+  // testable contract here is the rejection. The store-based path is
+  // exercised by elastic launchers that init via FILE_SYSTEM or TCP.
+  ASSERT_THROW(
+      distributedReinit(getWorldRank(), getWorldSize()), std::runtime_error);
+}
+
+TEST(Distributed, ShardedOptimizer) {
+  if (!isDistributedInit()) {
+    GTEST_SKIP() << "Distributed initialization failed or not enabled.";
+  }
+
+  auto size = getWorldSize();
+
+  // identical parameters and gradients on every rank; the sharded optimizer
+  // must land on the same result as a replicated one
+  std::vector<Variable> shardedParams;
+  std::vector<Variable> refParams;
+  for (int i = 0; i < 5; ++i) {
+    auto data = fl::full({10 + i}, 1.0 + i, dtype::f32);
+    shardedParams.emplace_back(data, true);
+    refParams.emplace_back(data.copy(), true);
+  }
+
+  SGDOptimizer sharded(shardedParams, 0.1, 0.9);
+  SGDOptimizer reference(refParams, 0.1, 0.9);
+  sharded.shardStateAcrossRanks(true);
+
+  for (int iter = 0; iter < 3; ++iter) {
+    for (int i = 0; i < 5; ++i) {
+      // the sharded step averages gradients over ranks itself; hand the
+      // reference the same (already identical) gradient
+      auto grad = Variable(fl::full({10 + i}, 0.5 * (i + 1), dtype::f32), false);
+      shardedParams[i].addGrad(grad);
+      refParams[i].addGrad(grad);
+    }
+    sharded.step();
+    sharded.zeroGrad();
+    reference.step();
+    reference.zeroGrad();
+  }
+
+  for (int i = 0; i < 5; ++i) {
+    ASSERT_TRUE(
+        fl::allClose(shardedParams[i].tensor(), refParams[i].tensor(), 1e-5));
+  }
+}
+
 int main(int argc, char** argv) {
   ::testing::InitGoogleTest(&argc, argv);
   fl::init();
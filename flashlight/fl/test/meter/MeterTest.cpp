@@ -5,11 +5,13 @@
  * LICENSE file in the root directory of this source tree.
  */
 
+#include <algorithm>
 #include <cmath>
 #include <vector>
 
 #include <gtest/gtest.h>
 
+#include "flashlight/fl/common/Utils.h"
 #include "flashlight/fl/tensor/Init.h"
 #include "flashlight/fl/meter/meters.h"
 #include "flashlight/fl/tensor/TensorBase.h"
@@ -40,6 +42,38 @@ TEST(MeterTest, EditDistanceMeter) {
   ASSERT_EQ(meter.value()[0], 6);
 }
 
+TEST(MeterTest, EditDistanceMeterBandedAndBatched) {
+  std::vector<int> a = {1, 2, 3, 4, 5};
+  std::vector<int> b = {1, 1, 3, 3, 5, 6};
+
+  // A band covering the true distance gives exact counts
+  EditDistanceMeter banded;
+  banded.setBandLimit(3);
+  banded.add(a, b);
+  ASSERT_EQ(banded.value()[0], 3);
+  ASSERT_EQ(banded.value()[2], 1); // deletion
+  ASSERT_EQ(banded.value()[3], 0); // insertion
+  ASSERT_EQ(banded.value()[4], 2); // substitution
+
+  // Batched adds match serial adds
+  std::vector<std::vector<int>> outputs;
+  std::vector<std::vector<int>> targets;
+  for (int i = 0; i < 50; ++i) {
+    outputs.push_back(a);
+    targets.push_back(b);
+    std::rotate(a.begin(), a.begin() + 1, a.end());
+  }
+  EditDistanceMeter serial;
+  EditDistanceMeter batched;
+  for (size_t i = 0; i < outputs.size(); ++i) {
+    serial.add(outputs[i], targets[i]);
+  }
+  batched.addBatch(outputs, targets, /* numThreads = */ 4);
+  for (int i = 0; i < 5; ++i) {
+    ASSERT_EQ(serial.value()[i], batched.value()[i]);
+  }
+}
+
 TEST(MeterTest, FrameErrorMeter) {
   FrameErrorMeter meter;
   std::vector<int> a = {1, 2, 3, 4, 5};
@@ -72,6 +106,62 @@ TEST(MeterTest, AverageValueMeter) {
   ASSERT_EQ(val[2], 6.0);
 }
 
+TEST(MeterTest, AverageValueMeterDeviceAccumulation) {
+  // Device-side accumulation matches per-batch host accumulation
+  AverageValueMeter meter;
+  AverageValueMeter deviceMeter(/* accumOnDevice = */ true);
+  std::vector<float> a = {2.0, 3.0, 4.0};
+  std::vector<float> b = {1.0, 5.0};
+  meter.add(Tensor::fromVector(a));
+  meter.add(Tensor::fromVector(b));
+  deviceMeter.add(Tensor::fromVector(a));
+  deviceMeter.add(Tensor::fromVector(b));
+  auto val = meter.value();
+  auto deviceVal = deviceMeter.value();
+  ASSERT_NEAR(val[0], deviceVal[0], 1e-10);
+  ASSERT_NEAR(val[1], deviceVal[1], 1e-10);
+  ASSERT_EQ(val[2], deviceVal[2]);
+
+  // Mixing in scalar adds flushes the device sums first
+  deviceMeter.add(3.0);
+  meter.add(3.0);
+  ASSERT_NEAR(meter.value()[0], deviceMeter.value()[0], 1e-10);
+}
+
+TEST(MeterTest, AverageValueMeterHalfPrecisionAccumulation) {
+  if (!fl::f16Supported()) {
+    GTEST_SKIP() << "Half-precision not supported on this device";
+  }
+  // Device-side running sums for half-precision batches are kept in f32, so
+  // a stream whose total exceeds f16's ~65504 range does not saturate
+  AverageValueMeter meter(/* accumOnDevice = */ true);
+  for (int i = 0; i < 100; ++i) {
+    meter.add(fl::full({1000}, 1.0, fl::dtype::f16));
+  }
+  auto val = meter.value();
+  ASSERT_NEAR(val[0], 1.0, 1e-3);
+  ASSERT_EQ(val[2], 100000.0);
+}
+
+TEST(MeterTest, TopKMeterDeviceAccumulation) {
+  // Scores for 4 classes over a batch of 2; predictions are class 2 and 3
+  std::vector<float> scores = {0.1, 0.2, 0.6, 0.1, 0.1, 0.1, 0.3, 0.5};
+  std::vector<int> targets = {2, 0};
+  TopKMeter meter(2);
+  TopKMeter deviceMeter(2, /* accumOnDevice = */ true);
+  for (int i = 0; i < 3; ++i) {
+    meter.add(
+        Tensor::fromVector({4, 2}, scores), Tensor::fromVector(targets));
+    deviceMeter.add(
+        Tensor::fromVector({4, 2}, scores), Tensor::fromVector(targets));
+  }
+  ASSERT_EQ(meter.value(), deviceMeter.value());
+  ASSERT_EQ(meter.getStats(), deviceMeter.getStats());
+
+  deviceMeter.reset();
+  ASSERT_EQ(deviceMeter.getStats(), std::make_pair(0, 0));
+}
+
 TEST(MeterTest, MSEMeter) {
   MSEMeter meter;
   std::vector<int> b = {4, 5, 6, 7, 8};
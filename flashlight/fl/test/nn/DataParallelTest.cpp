@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+
+#include "flashlight/fl/autograd/autograd.h"
+#include "flashlight/fl/nn/nn.h"
+#include "flashlight/fl/runtime/DeviceManager.h"
+#include "flashlight/fl/tensor/Index.h"
+#include "flashlight/fl/tensor/Init.h"
+#include "flashlight/fl/tensor/Random.h"
+
+using namespace fl;
+
+namespace {
+
+// two replicas on the same (x64) device -- portable to single-device machines
+DataParallel makeTwoReplicas(std::shared_ptr<Module> module) {
+  return DataParallel(
+      std::move(module),
+      {fl::kX64DeviceId, fl::kX64DeviceId},
+      fl::DeviceType::x64);
+}
+
+} // namespace
+
+TEST(DataParallelTest, Replication) {
+  auto linear = std::make_shared<Linear>(4, 3);
+  auto dp = makeTwoReplicas(linear);
+
+  ASSERT_EQ(dp.replicaCount(), 2);
+  ASSERT_EQ(dp.deviceIds(), std::vector<int>({kX64DeviceId, kX64DeviceId}));
+  ASSERT_EQ(dp.replica(0), linear); // primary replica is the given module
+  ASSERT_NE(dp.replica(1), linear);
+  ASSERT_EQ(dp.replica(1)->params().size(), linear->params().size());
+  for (unsigned i = 0; i < linear->params().size(); i++) {
+    ASSERT_TRUE(allClose(
+        dp.replica(1)->params()[i].tensor(), linear->params()[i].tensor()));
+  }
+  ASSERT_THROW(dp.replica(2), std::out_of_range);
+  ASSERT_THROW(
+      DataParallel(nullptr, {kX64DeviceId}, DeviceType::x64),
+      std::invalid_argument);
+}
+
+TEST(DataParallelTest, ScatterGather) {
+  auto dp = makeTwoReplicas(std::make_shared<Linear>(4, 3));
+
+  auto batch = fl::rand({4, 7});
+  auto shards = dp.scatter(batch);
+  ASSERT_EQ(shards.size(), 2);
+  // uneven split -- the leading shard gets the extra element
+  ASSERT_EQ(shards[0].shape(), Shape({4, 4}));
+  ASSERT_EQ(shards[1].shape(), Shape({4, 3}));
+  ASSERT_TRUE(allClose(shards[0], batch(fl::span, fl::range(0, 4))));
+  ASSERT_TRUE(allClose(shards[1], batch(fl::span, fl::range(4, 7))));
+
+  ASSERT_TRUE(allClose(dp.gather(shards), batch));
+  ASSERT_THROW(dp.gather({batch}), std::invalid_argument);
+  ASSERT_THROW(dp.scatter(fl::rand({4, 1})), std::invalid_argument);
+}
+
+TEST(DataParallelTest, ForEachAndReduceGradients) {
+  auto linear = std::make_shared<Linear>(4, 3);
+  auto dp = makeTwoReplicas(linear);
+
+  // reference: an independent copy of the module, cloned before any
+  // gradients exist
+  auto reference = linear->clone();
+
+  auto batch = fl::rand({4, 6});
+  auto shards = dp.scatter(batch);
+  std::vector<Tensor> outputs(dp.replicaCount());
+  dp.forEach([&](unsigned replicaIdx, Module& module) {
+    auto out = module.forward({Variable(shards[replicaIdx], false)}).front();
+    out.backward();
+    outputs[replicaIdx] = out.tensor();
+  });
+
+  // run the same shards through the reference, accumulating gradients
+  for (const auto& shard : shards) {
+    reference->forward({Variable(shard, false)}).front().backward();
+  }
+
+  dp.reduceGradients();
+  for (unsigned i = 0; i < linear->params().size(); i++) {
+    ASSERT_TRUE(allClose(
+        linear->params()[i].grad().tensor(),
+        reference->params()[i].grad().tensor() / 2,
+        /* absTolerance = */ 1e-5));
+  }
+
+  ASSERT_TRUE(allClose(
+      dp.gather(outputs),
+      reference->forward({Variable(batch, false)}).front().tensor(),
+      /* absTolerance = */ 1e-5));
+}
+
+TEST(DataParallelTest, BroadcastParameters) {
+  auto linear = std::make_shared<Linear>(4, 3);
+  auto dp = makeTwoReplicas(linear);
+
+  // simulate an optimizer step over the primary replica
+  for (auto& param : linear->params()) {
+    param.tensor() = param.tensor() + 1;
+  }
+  ASSERT_FALSE(allClose(
+      dp.replica(1)->params()[0].tensor(), linear->params()[0].tensor()));
+
+  dp.broadcastParameters();
+  for (unsigned i = 0; i < linear->params().size(); i++) {
+    ASSERT_TRUE(allClose(
+        dp.replica(1)->params()[i].tensor(), linear->params()[i].tensor()));
+  }
+}
+
+TEST(DataParallelTest, TrainEval) {
+  auto dp = makeTwoReplicas(std::make_shared<Sequential>([]() {
+    Sequential seq;
+    seq.add(Linear(4, 3));
+    seq.add(Dropout(0.5));
+    return seq;
+  }()));
+
+  dp.eval();
+  auto input = fl::rand({4, 5});
+  std::vector<Tensor> outputs(dp.replicaCount());
+  dp.forEach([&](unsigned replicaIdx, Module& module) {
+    outputs[replicaIdx] =
+        module.forward({Variable(input, false)}).front().tensor();
+  });
+  // in eval mode, dropout is the identity and all replicas agree
+  ASSERT_TRUE(allClose(outputs[0], outputs[1]));
+}
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  fl::init();
+  return RUN_ALL_TESTS();
+}
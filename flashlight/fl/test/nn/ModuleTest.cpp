@@ -98,6 +98,46 @@ TEST(ModuleTest, EmbeddingFwd) {
   ASSERT_TRUE(allClose(emb.forward(inVar), expectedOutVar, 1E-7));
 }
 
+TEST(ModuleTest, HostEmbeddingFwd) {
+  int embDim = 4, nEmb = 10;
+  auto wtVar = param(fl::rand({embDim, nEmb}));
+  auto inVar =
+      input(Tensor::fromVector<float>({2, 3}, {1, 3, 1, 7, 9, 3}));
+
+  // forwards match the device-resident Embedding on the same weights
+  auto hostEmb = HostEmbedding(wtVar);
+  auto emb = Embedding(wtVar);
+  auto out = hostEmb.forward(inVar);
+  ASSERT_EQ(out.shape(), Shape({embDim, 2, 3}));
+  ASSERT_TRUE(allClose(out, emb.forward(inVar), 1E-6));
+
+  // backward scatters into the host accumulator, one entry per distinct row
+  out.backward();
+  ASSERT_EQ(hostEmb.pendingGradientRows(), 4);
+  hostEmb.applyGradients(0.5);
+  ASSERT_EQ(hostEmb.pendingGradientRows(), 0);
+
+  // with an all-ones output gradient, each row moves by -lr * (times used):
+  // row 7 was looked up once, row 1 twice
+  auto updated = hostEmb.forward(inVar).tensor();
+  ASSERT_TRUE(allClose(
+      fl::reshape(updated(fl::span, 1, 1), {embDim}),
+      fl::reshape(wtVar.tensor()(fl::span, 7), {embDim}) - 0.5,
+      1E-6));
+  ASSERT_TRUE(allClose(
+      fl::reshape(updated(fl::span, 0, 0), {embDim}),
+      fl::reshape(wtVar.tensor()(fl::span, 1), {embDim}) - 1.0,
+      1E-6));
+
+  // eval-mode forwards build no graph
+  hostEmb.eval();
+  ASSERT_FALSE(hostEmb.forward(inVar).isCalcGrad());
+
+  ASSERT_THROW(
+      hostEmb.forward(input(fl::full({2}, nEmb, fl::dtype::f32))),
+      std::invalid_argument);
+}
+
 TEST(ModuleTest, LinearFwd) {
   int n_in = 2, n_out = 3, x = 4, batchsize = 2;
   auto wtVar =
@@ -128,6 +168,56 @@ TEST(ModuleTest, LinearFwd) {
   ASSERT_TRUE(allClose(linBias.forward(inVar), expected_outVar, 1E-7));
 }
 
+TEST(ModuleTest, WeightNormEvalCache) {
+  int nIn = 4, nOut = 6, batchsize = 3;
+  auto wn = WeightNorm(Linear(nIn, nOut), 0);
+  auto in = input(fl::rand({nIn, batchsize}));
+
+  wn.train();
+  auto trainOut = wn.forward({in}).front();
+
+  // eval materializes the normalized weight once, detached from the autograd
+  // graph; outputs match the training-mode computation and carry no graph
+  wn.eval();
+  auto evalOut = wn.forward({in}).front();
+  ASSERT_TRUE(allClose(evalOut.tensor(), trainOut.tensor(), 1e-6));
+  ASSERT_FALSE(evalOut.isCalcGrad());
+
+  // setParams refreshes the cached weight (scaling g scales the weight;
+  // scaling v would be normalized away)
+  auto g = wn.param(1);
+  wn.setParams(Variable(g.tensor() * 2., true), 1);
+  auto refreshedOut = wn.forward({in}).front();
+  ASSERT_FALSE(allClose(refreshedOut.tensor(), evalOut.tensor(), 1e-6));
+
+  // back in training mode the weight is recomputed with a graph
+  wn.train();
+  auto backToTrainOut = wn.forward({in}).front();
+  ASSERT_TRUE(allClose(backToTrainOut.tensor(), refreshedOut.tensor(), 1e-6));
+  ASSERT_TRUE(backToTrainOut.isCalcGrad());
+}
+
+TEST(ModuleTest, ParallelLinearFwd) {
+  // without a distributed environment both variants hold the full weight and
+  // behave exactly like Linear
+  int nIn = 4, nOut = 6, batchsize = 3;
+  auto reference = Linear(nIn, nOut);
+
+  auto column = ColumnParallelLinear(nIn, nOut);
+  ASSERT_EQ(column.worldSize(), 1);
+  auto row = RowParallelLinear(nIn, nOut);
+  ASSERT_EQ(row.worldSize(), 1);
+  for (unsigned i = 0; i < reference.params().size(); i++) {
+    column.setParams(reference.param(i), i);
+    row.setParams(reference.param(i), i);
+  }
+
+  auto in = input(fl::rand({nIn, batchsize}));
+  auto expected = reference.forward(in);
+  ASSERT_TRUE(allClose(column.forward(in), expected, 1E-6));
+  ASSERT_TRUE(allClose(row.forward(in), expected, 1E-6));
+}
+
 TEST_F(ModuleTestF16, LinearFwdF16) {
   if (!fl::f16Supported()) {
     GTEST_SKIP() << "Half-precision not supported on this device";
@@ -899,6 +989,37 @@ TEST(ModuleTest, AdaptiveSoftMaxLossIgnoreIndex) {
       1E-5);
 }
 
+TEST(ModuleTest, AdaptiveSoftMaxLossBatchGrad) {
+  // batched input gradients match those of per-sample evaluation, with
+  // targets spread across every cluster
+  int N = 5;
+  int C = 6;
+  int T = 10;
+  int B = 4;
+
+  auto x = param(fl::rand({N, T, B}, fl::dtype::f32));
+  auto y = Variable(
+      (fl::rand({T, B}, fl::dtype::u32) % C).astype(fl::dtype::s32), false);
+
+  std::vector<int> cutoff{{2, 4, C}};
+  auto activation = std::make_shared<AdaptiveSoftMax>(N, cutoff);
+  auto asml =
+      std::make_shared<AdaptiveSoftMaxLoss>(activation, ReduceMode::SUM);
+  auto batchLoss = asml->forward(x, y);
+  batchLoss.backward();
+
+  for (int i = 0; i < B; ++i) {
+    auto xi =
+        param(x.tensor()(fl::span, fl::span, fl::range(i, i + 1)).copy());
+    auto singleLoss = asml->forward(xi, y(fl::span, fl::range(i, i + 1)));
+    singleLoss.backward();
+    ASSERT_TRUE(allClose(
+        x.grad().tensor()(fl::span, fl::span, fl::range(i, i + 1)),
+        xi.grad().tensor(),
+        1e-5));
+  }
+}
+
 TEST(ModuleTest, IdentityFwd) {
   auto module = Identity();
   std::vector<Variable> in = {
@@ -979,6 +1100,176 @@ TEST(ModuleTest, ContainerCloneCopy) {
   ASSERT_TRUE(allClose(clonedModulePtr->params()[0], modulePtr->params()[0]));
 }
 
+TEST(ModuleTest, SequentialCheckpointing) {
+  Sequential seq;
+  seq.add(Linear(8, 8));
+  seq.add(ReLU());
+  seq.add(Linear(8, 8));
+  seq.add(ReLU());
+  seq.add(Linear(8, 4));
+  seq.train();
+
+  auto inputTensor = fl::rand({8, 10});
+  auto run = [&]() {
+    for (auto& param : seq.params()) {
+      param.zeroGrad();
+    }
+    auto in = Variable(inputTensor, true);
+    auto out = seq.forward(in);
+    out.backward();
+    std::vector<Tensor> results = {out.tensor()};
+    for (auto& param : seq.params()) {
+      results.push_back(param.grad().tensor());
+    }
+    results.push_back(in.grad().tensor());
+    return results;
+  };
+
+  // Checkpointed forward/backward matches the uncheckpointed reference -
+  // output, all parameter gradients, and the input gradient
+  auto reference = run();
+  seq.setCheckpointing(2);
+  auto checkpointed = run();
+  ASSERT_EQ(reference.size(), checkpointed.size());
+  for (size_t i = 0; i < reference.size(); ++i) {
+    ASSERT_TRUE(allClose(reference[i], checkpointed[i], 1e-5));
+  }
+
+  // Copies keep the checkpointing configuration and still match
+  auto seqCopy = seq;
+  auto out = seqCopy.forward(Variable(inputTensor, false));
+  ASSERT_TRUE(allClose(out.tensor(), reference[0], 1e-5));
+}
+
+TEST(ModuleTest, ExportGraph) {
+  Sequential seq;
+  seq.add(Linear(8, 16));
+  seq.add(ReLU());
+  auto inner = std::make_shared<Sequential>();
+  inner->add(Linear(16, 16));
+  inner->add(ReLU());
+  seq.add(inner);
+  seq.add(Linear(16, 4));
+
+  auto graph = seq.exportGraph({{8, 10}});
+
+  // the root describes the whole container
+  ASSERT_EQ(graph.children.size(), 4);
+  ASSERT_EQ(graph.inputShapes, std::vector<Shape>{Shape({8, 10})});
+  ASSERT_EQ(graph.outputShapes, std::vector<Shape>{Shape({4, 10})});
+  int64_t totalParams = 0;
+  for (const auto& param : seq.params()) {
+    totalParams += param.elements();
+  }
+  ASSERT_EQ(graph.numParams, totalParams);
+
+  // per-module shape propagation
+  ASSERT_EQ(graph.children[0].inputShapes, std::vector<Shape>{Shape({8, 10})});
+  ASSERT_EQ(
+      graph.children[0].outputShapes, std::vector<Shape>{Shape({16, 10})});
+  ASSERT_EQ(graph.children[0].numParams, 16 * 8 + 16);
+  ASSERT_EQ(graph.children[0].paramBytes, (16 * 8 + 16) * 4);
+  ASSERT_EQ(graph.children[1].numParams, 0);
+
+  // nested containers recurse
+  ASSERT_EQ(graph.children[2].children.size(), 2);
+  ASSERT_EQ(
+      graph.children[2].children[0].outputShapes,
+      std::vector<Shape>{Shape({16, 10})});
+  ASSERT_EQ(
+      graph.children[3].outputShapes, std::vector<Shape>{Shape({4, 10})});
+
+  // the dummy propagation must not build a gradient graph
+  for (const auto& param : seq.params()) {
+    ASSERT_FALSE(param.isGradAvailable());
+  }
+}
+
+TEST(ModuleTest, ForwardContext) {
+  Sequential seq;
+  seq.add(Linear(8, 8));
+  seq.add(ReLU());
+  seq.add(Linear(8, 4));
+  seq.train();
+
+  auto inputTensor = fl::rand({8, 10});
+  auto refIn = Variable(inputTensor, true);
+  auto reference = seq.forward(refIn);
+  reference.backward();
+
+  ForwardContext ctx;
+  ctx.inputs().emplace_back(inputTensor, true);
+  auto in = ctx.inputs().front();
+  seq.forward(ctx);
+  ASSERT_EQ(ctx.outputs().size(), 1);
+  auto out = ctx.outputs().front();
+  ASSERT_TRUE(allClose(out.tensor(), reference.tensor(), 1e-5));
+
+  // the autograd graph is intact through the context path
+  out.backward();
+  ASSERT_TRUE(allClose(in.grad().tensor(), refIn.grad().tensor(), 1e-5));
+
+  // the context is reusable across steps
+  ctx.reset();
+  ASSERT_TRUE(ctx.inputs().empty());
+  ctx.inputs().emplace_back(inputTensor, false);
+  seq.forward(ctx);
+  ASSERT_TRUE(
+      allClose(ctx.outputs().front().tensor(), reference.tensor(), 1e-5));
+
+  // input-arity errors surface through the context path too
+  ctx.reset();
+  ctx.inputs().emplace_back(inputTensor, false);
+  ctx.inputs().emplace_back(fl::rand({8, 10}), false);
+  Module& firstLayer = *seq.module(0);
+  ASSERT_THROW(firstLayer.forward(ctx), std::invalid_argument);
+}
+
+TEST(ModuleTest, ForwardTensor) {
+  auto inputTensor = fl::rand({8, 10});
+
+  // overridden fast paths match the Variable path
+  Linear linear(8, 4);
+  ASSERT_TRUE(allClose(
+      linear.forwardTensor(inputTensor),
+      linear.forward(Variable(inputTensor, false)).tensor(),
+      1e-5));
+
+  ReLU relu;
+  ASSERT_TRUE(allClose(
+      relu.forwardTensor(inputTensor),
+      relu.forward(Variable(inputTensor, false)).tensor()));
+
+  LayerNorm norm(std::vector<int>{0}, 1e-5, /* affine = */ true, 8);
+  ASSERT_TRUE(allClose(
+      norm.forwardTensor(inputTensor),
+      norm.forward(Variable(inputTensor, false)).tensor(),
+      1e-4));
+
+  // modules without an override go through the Variable fallback
+  LogSoftmax logsoftmax;
+  ASSERT_TRUE(allClose(
+      logsoftmax.forwardTensor(inputTensor),
+      logsoftmax.forward(Variable(inputTensor, false)).tensor(),
+      1e-5));
+
+  // dropout is the identity in eval mode
+  Dropout dropout(0.5);
+  dropout.eval();
+  ASSERT_TRUE(allClose(dropout.forwardTensor(inputTensor), inputTensor));
+
+  // the tensor path threads through an entire Sequential
+  Sequential seq;
+  seq.add(Linear(8, 8));
+  seq.add(ReLU());
+  seq.add(Linear(8, 4));
+  seq.eval();
+  ASSERT_TRUE(allClose(
+      seq.forwardTensor(inputTensor),
+      seq.forward(Variable(inputTensor, false)).tensor(),
+      1e-5));
+}
+
 int main(int argc, char** argv) {
   ::testing::InitGoogleTest(&argc, argv);
   fl::init();
@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+
+#include "flashlight/fl/autograd/autograd.h"
+#include "flashlight/fl/nn/nn.h"
+#include "flashlight/fl/runtime/DeviceManager.h"
+#include "flashlight/fl/tensor/Index.h"
+#include "flashlight/fl/tensor/Init.h"
+#include "flashlight/fl/tensor/Random.h"
+
+using namespace fl;
+
+namespace {
+
+// two stages on the same (x64) device -- portable to single-device machines
+PipelineParallel makeTwoStages(
+    std::shared_ptr<Sequential> module,
+    unsigned numMicrobatches) {
+  return PipelineParallel(
+      std::move(module),
+      {fl::kX64DeviceId, fl::kX64DeviceId},
+      numMicrobatches,
+      fl::DeviceType::x64);
+}
+
+} // namespace
+
+TEST(PipelineParallelTest, Partitioning) {
+  auto seq = std::make_shared<Sequential>();
+  seq->add(Linear(8, 16));
+  seq->add(ReLU());
+  seq->add(Linear(16, 16));
+  seq->add(ReLU());
+  seq->add(Linear(16, 4));
+  auto pipeline = makeTwoStages(seq, 2);
+
+  ASSERT_EQ(pipeline.stageCount(), 2);
+  // stages are contiguous and cover all child modules
+  auto first = pipeline.stageModules(0);
+  auto second = pipeline.stageModules(1);
+  ASSERT_EQ(first.first, 0);
+  ASSERT_EQ(first.second, second.first);
+  ASSERT_EQ(second.second, seq->modules().size());
+  ASSERT_GT(first.second, first.first);
+  ASSERT_GT(second.second, second.first);
+
+  // too few modules for the requested stage count
+  auto tiny = std::make_shared<Sequential>();
+  tiny->add(Linear(4, 4));
+  ASSERT_THROW(makeTwoStages(tiny, 1), std::invalid_argument);
+}
+
+TEST(PipelineParallelTest, ForwardMatchesSequential) {
+  auto seq = std::make_shared<Sequential>();
+  seq->add(Linear(6, 12));
+  seq->add(ReLU());
+  seq->add(Linear(12, 5));
+  auto reference = seq->clone();
+  auto pipeline = makeTwoStages(seq, 3);
+
+  auto batch = fl::rand({6, 10});
+  auto outputs = pipeline.forward(Variable(batch, false));
+  ASSERT_EQ(outputs.size(), 3);
+  // leading microbatches get the remainder
+  ASSERT_EQ(outputs[0].dim(1), 4);
+  ASSERT_EQ(outputs[1].dim(1), 3);
+  ASSERT_EQ(outputs[2].dim(1), 3);
+
+  auto expected = reference->forward({Variable(batch, false)}).front();
+  ASSERT_TRUE(allClose(pipeline.gather(outputs), expected.tensor(), 1e-6));
+}
+
+TEST(PipelineParallelTest, BackwardAccumulatesMicrobatchGradients) {
+  auto seq = std::make_shared<Sequential>();
+  seq->add(Linear(4, 8));
+  seq->add(ReLU());
+  seq->add(Linear(8, 2));
+  auto reference = seq->clone();
+  auto pipeline = makeTwoStages(seq, 2);
+
+  auto batch = fl::rand({4, 6});
+  auto outputs = pipeline.forward(Variable(batch, false));
+  std::vector<Variable> losses;
+  for (auto& output : outputs) {
+    losses.push_back(sum(output, {0, 1}));
+  }
+  pipeline.backward(losses);
+
+  auto referenceOut = reference->forward({Variable(batch, false)}).front();
+  sum(referenceOut, {0, 1}).backward();
+
+  const auto params = seq->params();
+  const auto referenceParams = reference->params();
+  ASSERT_EQ(params.size(), referenceParams.size());
+  for (unsigned i = 0; i < params.size(); i++) {
+    ASSERT_TRUE(params[i].isGradAvailable());
+    ASSERT_TRUE(allClose(
+        params[i].grad().tensor(), referenceParams[i].grad().tensor(), 1e-5));
+  }
+}
+
+TEST(PipelineParallelTest, MicrobatchValidation) {
+  auto seq = std::make_shared<Sequential>();
+  seq->add(Linear(3, 3));
+  seq->add(ReLU());
+  auto pipeline = makeTwoStages(seq, 4);
+
+  // batch smaller than the microbatch count
+  ASSERT_THROW(
+      pipeline.forward(Variable(fl::rand({3, 2}), false)),
+      std::invalid_argument);
+}
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  fl::init();
+  return RUN_ALL_TESTS();
+}
@@ -11,6 +11,7 @@
 
 #include "flashlight/fl/common/common.h"
 #include "flashlight/fl/optim/optim.h"
+#include "flashlight/fl/tensor/Index.h"
 #include "flashlight/fl/tensor/Random.h"
 
 using namespace fl;
@@ -59,6 +60,293 @@ TEST(OptimTest, GradNormF16) {
   ASSERT_TRUE(allClose(fl::full({1}, max_norm), fl::full({1}, clipped), 1e-2));
 }
 
+TEST(OptimTest, GradNormMixedPrecision) {
+  // mixed f32/f64 parameters exercise the widened device-side accumulation;
+  // parameters without a gradient are skipped
+  std::vector<Variable> parameters;
+  for (int i = 0; i < 3; i++) {
+    auto v = Variable(fl::randn({10, 10}), true);
+    v.addGrad(Variable(fl::randn({10, 10}), false));
+    parameters.push_back(v);
+  }
+  auto v64 = Variable(fl::randn({10, 10}, fl::dtype::f64), true);
+  v64.addGrad(Variable(fl::randn({10, 10}, fl::dtype::f64), false));
+  parameters.push_back(v64);
+  parameters.emplace_back(fl::randn({10, 10}), true); // no gradient
+
+  double max_norm = 2.0;
+  auto norm = clipGradNorm(parameters, max_norm);
+  ASSERT_GT(norm, 0.0);
+
+  double clipped = 0.0;
+  for (auto& v : parameters) {
+    if (!v.isGradAvailable()) {
+      continue;
+    }
+    auto& g = v.grad().tensor();
+    clipped += fl::sum(g * g).asScalar<double>();
+  }
+  clipped = std::sqrt(clipped);
+  ASSERT_NEAR(clipped, max_norm, 1e-4);
+
+  // nothing to clip: the norm of an empty set is zero
+  std::vector<Variable> noGrads;
+  noGrads.emplace_back(fl::randn({4}), true);
+  ASSERT_EQ(clipGradNorm(noGrads, max_norm), 0.0);
+}
+
+TEST(OptimTest, GradAccumulation) {
+  auto w1 = Variable(fl::full({5}, 1.0, fl::dtype::f32), true);
+  auto w2 = Variable(w1.tensor().copy(), true);
+  auto g1 = fl::full({5}, 2.0, fl::dtype::f32);
+  auto g2 = fl::full({5}, 4.0, fl::dtype::f32);
+
+  // reference: one step with the averaged gradient
+  SGDOptimizer ref({w2}, 0.1);
+  w2.addGrad(Variable((g1 + g2) / 2, false));
+  ref.step();
+
+  SGDOptimizer opt({w1}, 0.1);
+  opt.accumulateGrads(2);
+  w1.addGrad(Variable(g1, false));
+  opt.step(); // folds only, no update yet
+  opt.zeroGrad(); // no-op mid-accumulation
+  ASSERT_TRUE(w1.isGradAvailable());
+  w1.addGrad(Variable(g2, false));
+  opt.step(); // applies the update with averaged gradients
+  opt.zeroGrad();
+
+  ASSERT_TRUE(allClose(w1.tensor(), w2.tensor()));
+  ASSERT_THROW(opt.accumulateGrads(0), std::invalid_argument);
+}
+
+TEST(OptimTest, FusedStep) {
+  auto makeParams = []() {
+    std::vector<Variable> parameters;
+    parameters.emplace_back(fl::randn({7, 3}), true);
+    parameters.emplace_back(fl::randn({11}), true);
+    parameters.emplace_back(
+        fl::randn({5, 2}, fl::dtype::f64), true); // separate type group
+    return parameters;
+  };
+  auto refParams = makeParams();
+  auto fusedParams = makeParams();
+  for (size_t i = 0; i < refParams.size(); i++) {
+    fusedParams[i].tensor() = refParams[i].tensor().copy();
+  }
+
+  // fused and per-parameter paths must produce identical updates
+  SGDOptimizer ref(refParams, 0.1, 0.9, 0.01, true);
+  SGDOptimizer fused(fusedParams, 0.1, 0.9, 0.01, true);
+  fused.setFusedStep(true);
+  ASSERT_TRUE(fused.fusedStep());
+  for (int iter = 0; iter < 3; iter++) {
+    for (size_t i = 0; i < refParams.size(); i++) {
+      auto grad = fl::randn(refParams[i].shape(), refParams[i].type());
+      refParams[i].addGrad(Variable(grad, false));
+      fusedParams[i].addGrad(Variable(grad.copy(), false));
+    }
+    ref.step();
+    fused.step();
+    ref.zeroGrad();
+    fused.zeroGrad();
+    for (size_t i = 0; i < refParams.size(); i++) {
+      ASSERT_TRUE(allClose(refParams[i].tensor(), fusedParams[i].tensor()));
+    }
+  }
+
+  AdamOptimizer adamRef(refParams, 0.001, 0.9, 0.999, 1e-8, 0.01);
+  AdamOptimizer adamFused(fusedParams, 0.001, 0.9, 0.999, 1e-8, 0.01);
+  adamFused.setFusedStep(true);
+  for (int iter = 0; iter < 3; iter++) {
+    for (size_t i = 0; i < refParams.size(); i++) {
+      auto grad = fl::randn(refParams[i].shape(), refParams[i].type());
+      refParams[i].addGrad(Variable(grad, false));
+      fusedParams[i].addGrad(Variable(grad.copy(), false));
+    }
+    adamRef.step();
+    adamFused.step();
+    adamRef.zeroGrad();
+    adamFused.zeroGrad();
+    for (size_t i = 0; i < refParams.size(); i++) {
+      ASSERT_TRUE(
+          allClose(refParams[i].tensor(), fusedParams[i].tensor(), 1e-5));
+    }
+  }
+}
+
+TEST(OptimTest, ParamGroups) {
+  auto w1 = Variable(fl::randn({6, 4}), true);
+  auto w2 = Variable(fl::randn({9}), true);
+  auto r1 = Variable(w1.tensor().copy(), true);
+  auto r2 = Variable(w2.tensor().copy(), true);
+
+  // one optimizer with groups must match two optimizers with scaled
+  // hyperparameters
+  SGDOptimizer opt({w1, w2}, 0.1, /* momentum = */ 0, /* weightDecay = */ 0.2);
+  opt.setParamGroups(
+      {{/* params = */ {0}, /* lrMultiplier = */ 0.5, /* wdMultiplier = */ 2.0},
+       {/* params = */ {1}}});
+  SGDOptimizer ref1({r1}, 0.05, 0, 0.4);
+  SGDOptimizer ref2({r2}, 0.1, 0, 0.2);
+
+  for (int iter = 0; iter < 2; iter++) {
+    auto g1 = fl::randn(w1.shape());
+    auto g2 = fl::randn(w2.shape());
+    w1.addGrad(Variable(g1, false));
+    w2.addGrad(Variable(g2, false));
+    r1.addGrad(Variable(g1.copy(), false));
+    r2.addGrad(Variable(g2.copy(), false));
+    opt.step();
+    ref1.step();
+    ref2.step();
+    opt.zeroGrad();
+    ref1.zeroGrad();
+    ref2.zeroGrad();
+    ASSERT_TRUE(allClose(w1.tensor(), r1.tensor(), 1e-5));
+    ASSERT_TRUE(allClose(w2.tensor(), r2.tensor(), 1e-5));
+  }
+
+  // the fused path must respect the groups too
+  auto f1 = Variable(r1.tensor().copy(), true);
+  auto f2 = Variable(r2.tensor().copy(), true);
+  SGDOptimizer fused({f1, f2}, 0.1, 0, 0.2);
+  fused.setParamGroups({{{0}, 0.5, 2.0}, {{1}}});
+  fused.setFusedStep(true);
+  auto g1 = fl::randn(w1.shape());
+  auto g2 = fl::randn(w2.shape());
+  w1.addGrad(Variable(g1, false));
+  w2.addGrad(Variable(g2, false));
+  f1.addGrad(Variable(g1.copy(), false));
+  f2.addGrad(Variable(g2.copy(), false));
+  opt.step();
+  fused.step();
+  ASSERT_TRUE(allClose(w1.tensor(), f1.tensor(), 1e-5));
+  ASSERT_TRUE(allClose(w2.tensor(), f2.tensor(), 1e-5));
+
+  ASSERT_THROW(opt.setParamGroups({{{0, 2}}}), std::invalid_argument);
+  ASSERT_THROW(opt.setParamGroups({{{0}}, {{0}}}), std::invalid_argument);
+}
+
+TEST(OptimTest, QuantizedAdamMoments) {
+  // spans multiple quantization blocks plus a partial one
+  auto w = Variable(fl::randn({2500}), true);
+  auto r = Variable(w.tensor().copy(), true);
+
+  AdamOptimizer ref({r}, 0.01);
+  std::shared_ptr<FirstOrderOptimizer> quant = std::make_shared<AdamOptimizer>(
+      std::vector<Variable>{w}, 0.01, 0.9, 0.999, 1e-8,
+      /* weightDecay = */ 0, /* quantizeMoments = */ true);
+
+  // quantized moments must track the full-precision update closely
+  for (int iter = 0; iter < 5; iter++) {
+    auto grad = fl::randn(w.shape());
+    w.addGrad(Variable(grad, false));
+    r.addGrad(Variable(grad.copy(), false));
+    quant->step();
+    ref.step();
+    quant->zeroGrad();
+    ref.zeroGrad();
+    ASSERT_TRUE(allClose(w.tensor(), r.tensor(), 1e-3));
+  }
+
+  // checkpoints of the quantized optimizer round-trip exactly
+  const fs::path path = fs::temp_directory_path() / "quantadam.bin";
+  std::vector<Variable> parameters = {w};
+  save(path, parameters, quant);
+
+  std::vector<Variable> parameters2;
+  std::shared_ptr<FirstOrderOptimizer> quant2;
+  load(path, parameters2, quant2);
+
+  auto grad = fl::randn(w.shape());
+  parameters[0].addGrad(Variable(grad, false));
+  parameters2[0].addGrad(Variable(grad.copy(), false));
+  quant->step();
+  quant2->step();
+  ASSERT_TRUE(allClose(parameters[0].tensor(), parameters2[0].tensor()));
+}
+
+TEST(OptimTest, SparseGradStep) {
+  const int dim = 4;
+  const int numEmb = 10;
+
+  // a dense gradient which is zero outside the indexed columns
+  auto densify = [&](const Tensor& indices, const Tensor& values) {
+    Tensor dense = fl::full({dim, numEmb}, 0., fl::dtype::f32);
+    dense(fl::span, indices) = values;
+    return dense;
+  };
+
+  // Adagrad: the sparse update is exactly the dense update, since untouched
+  // columns see a zero gradient and therefore a zero update
+  auto w = Variable(fl::randn({dim, numEmb}), true);
+  auto wRef = Variable(w.tensor().copy(), true);
+  AdagradOptimizer opt({w}, 0.1);
+  AdagradOptimizer optRef({wRef}, 0.1);
+  std::vector<std::vector<int>> stepIndices = {{1, 4, 7}, {4, 2}};
+  for (const auto& idxs : stepIndices) {
+    Tensor indices = Tensor::fromVector(idxs);
+    Tensor values = fl::randn({dim, static_cast<Dim>(idxs.size())});
+    w.addSparseGrad(indices, Variable(values, false));
+    ASSERT_TRUE(w.isSparseGradAvailable());
+    wRef.addGrad(Variable(densify(indices, values), false));
+    opt.step();
+    optRef.step();
+    opt.zeroGrad();
+    optRef.zeroGrad();
+  }
+  ASSERT_TRUE(allClose(w.tensor(), wRef.tensor(), 1e-5));
+
+  // Adam decays only the moments of touched columns, so it matches the dense
+  // update as long as the same columns are touched every step
+  auto v = Variable(fl::randn({dim, numEmb}), true);
+  auto vRef = Variable(v.tensor().copy(), true);
+  AdamOptimizer adam({v}, 0.01);
+  AdamOptimizer adamRef({vRef}, 0.01);
+  Tensor indices = Tensor::fromVector<int>({0, 5, 9});
+  for (int iter = 0; iter < 3; iter++) {
+    Tensor values = fl::randn({dim, 3});
+    v.addSparseGrad(indices, Variable(values, false));
+    vRef.addGrad(Variable(densify(indices, values), false));
+    adam.step();
+    adamRef.step();
+    adam.zeroGrad();
+    adamRef.zeroGrad();
+  }
+  ASSERT_TRUE(allClose(v.tensor(), vRef.tensor(), 1e-5));
+}
+
+TEST(OptimTest, EMAUpdater) {
+  // mixed types exercise the per-type fused update groups
+  auto w1 = Variable(fl::randn({7, 3}), true);
+  auto w2 = Variable(fl::randn({11}, fl::dtype::f64), true);
+  std::vector<Tensor> ref = {w1.tensor().copy(), w2.tensor().copy()};
+  const double decay = 0.9;
+
+  EMAUpdater ema({w1, w2}, decay);
+  for (int iter = 0; iter < 3; iter++) {
+    // simulate optimizer updates
+    w1.tensor() = w1.tensor() + 0.1;
+    w2.tensor() = w2.tensor() * 1.01;
+    ref[0] = decay * ref[0] + (1 - decay) * w1.tensor();
+    ref[1] = decay * ref[1] + (1 - decay) * w2.tensor();
+    ema.update();
+  }
+
+  auto trained = w1.tensor().copy();
+  ema.swapForEval();
+  ASSERT_TRUE(ema.swapped());
+  ASSERT_TRUE(allClose(w1.tensor(), ref[0], 1e-5));
+  ASSERT_TRUE(allClose(w2.tensor(), ref[1], 1e-10));
+  EXPECT_THROW(ema.update(), std::logic_error);
+
+  // swapping back restores the training weights untouched
+  ema.swapForEval();
+  ASSERT_FALSE(ema.swapped());
+  ASSERT_TRUE(allClose(w1.tensor(), trained, 1e-7));
+}
+
 TEST(SerializationTest, OptimizerSerialize) {
   const fs::path path = fs::temp_directory_path() / "optmizer.bin";
 
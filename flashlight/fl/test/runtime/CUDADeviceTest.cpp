@@ -8,12 +8,15 @@
 #include <gtest/gtest.h>
 
 #include "flashlight/fl/runtime/CUDADevice.h"
+#include "flashlight/fl/runtime/CUDAStream.h"
+#include "flashlight/fl/runtime/CUDAUtils.h"
 #include "flashlight/fl/runtime/DeviceManager.h"
 #include "flashlight/fl/tensor/Init.h"
 
 #include <cuda_runtime.h>
 
 using fl::CUDADevice;
+using fl::CUDAStreamPriority;
 using fl::DeviceManager;
 using fl::DeviceType;
 
@@ -41,6 +44,55 @@ TEST(CUDADeviceTest, nativeId) {
   }
 }
 
+TEST(CUDADeviceTest, eventPool) {
+  auto& manager = DeviceManager::getInstance();
+  auto& cudaDevice =
+      manager.getActiveDevice(DeviceType::CUDA).impl<CUDADevice>();
+  auto& pool = *cudaDevice.eventPool();
+
+  auto event = pool.acquire();
+  ASSERT_NE(event, nullptr);
+  pool.release(event);
+  // the freelist hands back the recycled event instead of creating a new one
+  ASSERT_EQ(pool.acquire(), event);
+  pool.release(event);
+}
+
+TEST(CUDADeviceTest, streamPool) {
+  auto& manager = DeviceManager::getInstance();
+  auto& cudaDevice =
+      manager.getActiveDevice(DeviceType::CUDA).impl<CUDADevice>();
+
+  auto normal = cudaDevice.acquireStream();
+  auto high = cudaDevice.acquireStream(CUDAStreamPriority::High);
+  ASSERT_NE(normal, nullptr);
+  ASSERT_NE(high, nullptr);
+  ASSERT_NE(normal->handle(), high->handle());
+  ASSERT_EQ(&normal->device(), &cudaDevice);
+
+  int normalPriority, highPriority;
+  FL_CUDA_CHECK(cudaStreamGetPriority(normal->handle(), &normalPriority));
+  FL_CUDA_CHECK(cudaStreamGetPriority(high->handle(), &highPriority));
+  // native CUDA priorities are lower-is-higher
+  ASSERT_LE(highPriority, normalPriority);
+
+  // relative sync works against pooled streams
+  ASSERT_NO_THROW(normal->relativeSync(*high));
+
+  // released streams are recycled per priority class
+  cudaDevice.releaseStream(normal);
+  cudaDevice.releaseStream(high);
+  ASSERT_EQ(cudaDevice.acquireStream(), normal);
+  ASSERT_EQ(cudaDevice.acquireStream(CUDAStreamPriority::High), high);
+  cudaDevice.releaseStream(normal);
+  cudaDevice.releaseStream(high);
+
+  // streams not from the pool are rejected
+  ASSERT_THROW(
+      cudaDevice.releaseStream(fl::CUDAStream::createManaged()),
+      std::invalid_argument);
+}
+
 int main(int argc, char** argv) {
   ::testing::InitGoogleTest(&argc, argv);
   fl::init();
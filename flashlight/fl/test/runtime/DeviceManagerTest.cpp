@@ -10,6 +10,7 @@
 #include <unordered_map>
 
 #include "flashlight/fl/runtime/DeviceManager.h"
+#include "flashlight/fl/runtime/NumaUtils.h"
 #include "flashlight/fl/tensor/Init.h"
 
 using fl::DeviceManager;
@@ -77,6 +78,36 @@ TEST(DeviceManagerTest, getActiveDevice) {
   }
 }
 
+// NOTE must run last -- it enables the NUMA policy on the singleton, which
+// registers additional x64 sub-devices.
+TEST(DeviceManagerTest, enableNumaPolicy) {
+  auto& manager = DeviceManager::getInstance();
+  const auto numNodes = fl::numa::getNumaNodes().size();
+  manager.enableNumaPolicy();
+  ASSERT_EQ(manager.getDeviceCount(DeviceType::x64), 1 + numNodes);
+  manager.enableNumaPolicy(); // idempotent
+  ASSERT_EQ(manager.getDeviceCount(DeviceType::x64), 1 + numNodes);
+
+  for (const auto& node : fl::numa::getNumaNodes()) {
+    auto& device =
+        manager.getDevice(DeviceType::x64, fl::kX64NumaDeviceIdOffset + node.id);
+    ASSERT_EQ(device.type(), DeviceType::x64);
+    ASSERT_EQ(device.impl<fl::X64Device>().numaNode()->id, node.id);
+    device.setActive();
+    ASSERT_EQ(
+        manager.getActiveDevice(DeviceType::x64).nativeId(),
+        fl::kX64NumaDeviceIdOffset + node.id);
+  }
+
+  // the machine-wide device remains and restores unpinned execution
+  auto& machineWideDevice =
+      manager.getDevice(DeviceType::x64, fl::kX64DeviceId);
+  ASSERT_FALSE(machineWideDevice.impl<fl::X64Device>().numaNode().has_value());
+  machineWideDevice.setActive();
+  ASSERT_EQ(
+      manager.getActiveDevice(DeviceType::x64).nativeId(), fl::kX64DeviceId);
+}
+
 int main(int argc, char** argv) {
   ::testing::InitGoogleTest(&argc, argv);
   fl::init();
@@ -0,0 +1,47 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <vector>
+
+#include "flashlight/fl/runtime/NumaUtils.h"
+#include "flashlight/fl/tensor/Init.h"
+
+using fl::numa::detail::parseCpuList;
+
+TEST(NumaUtilsTest, parseCpuList) {
+  ASSERT_TRUE(parseCpuList("").empty());
+  ASSERT_EQ(parseCpuList("3"), std::vector<int>({3}));
+  ASSERT_EQ(parseCpuList("0-3"), std::vector<int>({0, 1, 2, 3}));
+  ASSERT_EQ(
+      parseCpuList("0-2,8,10-11"), std::vector<int>({0, 1, 2, 8, 10, 11}));
+  ASSERT_THROW(parseCpuList("zero"), std::invalid_argument);
+}
+
+TEST(NumaUtilsTest, getNumaNodes) {
+  const auto nodes = fl::numa::getNumaNodes();
+  ASSERT_GE(nodes.size(), 1u);
+  for (const auto& node : nodes) {
+    ASSERT_GE(node.id, 0);
+    ASSERT_FALSE(node.cpus.empty());
+  }
+}
+
+TEST(NumaUtilsTest, bindCallingThread) {
+  const auto nodes = fl::numa::getNumaNodes();
+  ASSERT_NO_THROW(fl::numa::bindCallingThread(nodes.front()));
+  ASSERT_NO_THROW(fl::numa::unbindCallingThread());
+  // unbinding an unbound thread is a no-op
+  ASSERT_NO_THROW(fl::numa::unbindCallingThread());
+}
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  fl::init();
+  return RUN_ALL_TESTS();
+}
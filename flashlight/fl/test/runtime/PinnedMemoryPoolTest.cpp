@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <cstring>
+
+#include <gtest/gtest.h>
+
+#include "flashlight/fl/runtime/PinnedMemoryPool.h"
+
+using fl::PinnedMemoryPool;
+
+TEST(PinnedMemoryPoolTest, AcquireAndRelease) {
+  auto& pool = PinnedMemoryPool::getInstance();
+  pool.clearCache();
+  {
+    auto buffer = pool.acquire(1000);
+    ASSERT_NE(buffer.data(), nullptr);
+    ASSERT_EQ(buffer.size(), 1000);
+    // buffer is writable host memory
+    std::memset(buffer.data(), 0xab, buffer.size());
+  }
+  // released buffer went back to the pool
+  ASSERT_GT(pool.cachedBytes(), 0);
+}
+
+TEST(PinnedMemoryPoolTest, ReuseMatchingCapacity) {
+  auto& pool = PinnedMemoryPool::getInstance();
+  pool.clearCache();
+  void* data = nullptr;
+  {
+    auto buffer = pool.acquire(5000);
+    data = buffer.data();
+  }
+  // a request that rounds to the same bucket reuses the cached buffer
+  auto buffer = pool.acquire(6000);
+  ASSERT_EQ(buffer.data(), data);
+  ASSERT_EQ(pool.cachedBytes(), 0);
+}
+
+TEST(PinnedMemoryPoolTest, CachingDisabled) {
+  auto& pool = PinnedMemoryPool::getInstance();
+  pool.clearCache();
+  const auto maxCachedBytes = pool.getMaxCachedBytes();
+  pool.setMaxCachedBytes(0);
+  { auto buffer = pool.acquire(1000); }
+  ASSERT_EQ(pool.cachedBytes(), 0);
+  pool.setMaxCachedBytes(maxCachedBytes);
+}
+
+TEST(PinnedMemoryPoolTest, MoveSemantics) {
+  auto& pool = PinnedMemoryPool::getInstance();
+  pool.clearCache();
+  auto buffer = pool.acquire(100);
+  void* data = buffer.data();
+  auto movedBuffer = std::move(buffer);
+  ASSERT_EQ(movedBuffer.data(), data);
+  ASSERT_EQ(buffer.data(), nullptr);
+  ASSERT_EQ(pool.cachedBytes(), 0); // nothing double-released
+}
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
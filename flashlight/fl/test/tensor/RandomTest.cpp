@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+
+#include "flashlight/fl/tensor/Init.h"
+#include "flashlight/fl/tensor/Random.h"
+#include "flashlight/fl/tensor/TensorBase.h"
+
+using namespace ::testing;
+using namespace fl;
+
+TEST(RandomTest, PhiloxRandStateless) {
+  auto a = fl::philoxRand({17, 9}, /* seed = */ 42, /* counter = */ 7);
+  auto b = fl::philoxRand({17, 9}, /* seed = */ 42, /* counter = */ 7);
+  ASSERT_EQ(a.shape(), Shape({17, 9}));
+  ASSERT_EQ(a.type(), fl::dtype::f32);
+  // same seed and counter reproduce the draw bitwise
+  ASSERT_EQ(fl::amax(fl::abs(a - b)).asScalar<float>(), 0.f);
+
+  // a different counter or seed yields a different stream
+  auto c = fl::philoxRand({17, 9}, /* seed = */ 42, /* counter = */ 8);
+  auto d = fl::philoxRand({17, 9}, /* seed = */ 43, /* counter = */ 7);
+  ASSERT_GT(fl::amax(fl::abs(a - c)).asScalar<float>(), 0.f);
+  ASSERT_GT(fl::amax(fl::abs(a - d)).asScalar<float>(), 0.f);
+
+  // values lie in [0, 1)
+  ASSERT_GE(fl::amin(a).asScalar<float>(), 0.f);
+  ASSERT_LT(fl::amax(a).asScalar<float>(), 1.f);
+
+  auto dbl = fl::philoxRand({4, 4}, 1, 0, fl::dtype::f64);
+  ASSERT_EQ(dbl.type(), fl::dtype::f64);
+}
+
+TEST(RandomTest, PhiloxRandnMoments) {
+  auto t = fl::philoxRand({100000}, /* seed = */ 5, /* counter = */ 0);
+  ASSERT_NEAR(fl::mean(t).asScalar<float>(), 0.5, 5e-3);
+
+  auto n = fl::philoxRandn({100001}, /* seed = */ 5, /* counter = */ 0);
+  ASSERT_EQ(n.elements(), 100001);
+  ASSERT_NEAR(fl::mean(n).asScalar<float>(), 0.0, 2e-2);
+  ASSERT_NEAR(fl::var(n).asScalar<float>(), 1.0, 5e-2);
+
+  // reproducible like the uniform variant
+  auto m = fl::philoxRandn({100001}, /* seed = */ 5, /* counter = */ 0);
+  ASSERT_EQ(fl::amax(fl::abs(n - m)).asScalar<float>(), 0.f);
+}
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  fl::init();
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+
+#include "flashlight/fl/tensor/Init.h"
+#include "flashlight/fl/tensor/ScalarFuture.h"
+
+using namespace ::testing;
+using namespace fl;
+
+TEST(ScalarFutureTest, SingleFuture) {
+  auto future = ScalarFuture<float>(fl::full({3, 3}, 4.));
+  ASSERT_FALSE(future.resolved());
+  ASSERT_FLOAT_EQ(future.get(), 4.);
+  ASSERT_TRUE(future.resolved());
+  ASSERT_FLOAT_EQ(future.get(), 4.);
+
+  // Reads cast to the requested type on the device
+  auto intFuture = ScalarFuture<int>(fl::full({2}, 7.5));
+  ASSERT_EQ(intFuture.get(), 7);
+
+  EXPECT_THROW(ScalarFuture<float>(Tensor()), std::invalid_argument);
+}
+
+TEST(ScalarFutureTest, BatchedFutures) {
+  auto futures = asScalarsAsync<float>(
+      {fl::full({2, 2}, 1.), fl::full({4}, 2.), fl::full({1}, 3.)});
+  ASSERT_EQ(futures.size(), 3);
+  for (const auto& future : futures) {
+    ASSERT_FALSE(future.resolved());
+  }
+
+  // The first read resolves every future in the batch in one transfer
+  ASSERT_FLOAT_EQ(futures[1].get(), 2.);
+  for (const auto& future : futures) {
+    ASSERT_TRUE(future.resolved());
+  }
+  ASSERT_FLOAT_EQ(futures[0].get(), 1.);
+  ASSERT_FLOAT_EQ(futures[2].get(), 3.);
+
+  ASSERT_TRUE(asScalarsAsync<float>({}).empty());
+}
+
+TEST(ScalarFutureTest, asScalars) {
+  auto values =
+      asScalars<double>({fl::full({3}, 1.5), fl::full({2, 2}, -2.5)});
+  ASSERT_EQ(values, (std::vector<double>{1.5, -2.5}));
+
+  // Mixed source types are cast per tensor
+  auto flags = asScalars<char>(
+      {fl::full({2}, 0.), fl::full({2}, 1.), fl::full({2}, 0, fl::dtype::s32)});
+  ASSERT_EQ(flags, (std::vector<char>{0, 1, 0}));
+}
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  fl::init();
+  return RUN_ALL_TESTS();
+}
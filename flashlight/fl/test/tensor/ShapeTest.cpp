@@ -72,6 +72,38 @@ TEST(ShapeTest, Indexing) {
   ASSERT_THROW(a[4], std::invalid_argument);
 }
 
+TEST(ShapeTest, DimStorage) {
+  // Dims within the inline capacity live in the Shape itself
+  auto s = Shape({3, 4, 5});
+  const auto& dims = s.get();
+  ASSERT_EQ(dims.size(), 3);
+  ASSERT_GE(reinterpret_cast<const unsigned char*>(dims.data()),
+            reinterpret_cast<const unsigned char*>(&s));
+  ASSERT_LT(reinterpret_cast<const unsigned char*>(dims.data()),
+            reinterpret_cast<const unsigned char*>(&s) + sizeof(Shape));
+
+  // Mutation through the storage reference
+  s.get().resize(2);
+  ASSERT_EQ(s, Shape({3, 4}));
+  s.get().push_back(9);
+  ASSERT_EQ(s, Shape({3, 4, 9}));
+
+  // Implicit conversion for consumers expecting a std::vector
+  std::vector<Dim> vec = s.get();
+  ASSERT_EQ(vec, (std::vector<Dim>{3, 4, 9}));
+  ASSERT_EQ(Shape(vec), s);
+
+  // Shapes beyond the inline capacity transparently spill to the heap
+  std::vector<Dim> bigDims(kShapeInlineDims + 3, 2);
+  auto big = Shape(bigDims);
+  ASSERT_EQ(big.ndim(), static_cast<int>(kShapeInlineDims) + 3);
+  ASSERT_EQ(big.elements(), 1 << (kShapeInlineDims + 3));
+  ASSERT_EQ(big, Shape(bigDims));
+  auto copy = big; // copies survive growth and destruction of the source
+  big = Shape({1});
+  ASSERT_EQ(copy, Shape(bigDims));
+}
+
 TEST(ShapeTest, string) {
   auto checkShapeStrEqual = [](const Shape& s, const std::string& str) -> void {
     auto sStr = s.toString();
@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+
+#include "flashlight/fl/tensor/Init.h"
+#include "flashlight/fl/tensor/Random.h"
+#include "flashlight/fl/tensor/ShapedTensor.h"
+
+using namespace ::testing;
+using namespace fl;
+
+TEST(ShapedTensorTest, StaticShape) {
+  using T = ShapedTensor<3, 4, 5>;
+  static_assert(T::ndim() == 3);
+  static_assert(T::elements() == 60);
+  static_assert(T::dim<0>() == 3);
+  static_assert(T::dim<2>() == 5);
+  static_assert(T::stride<0>() == 1);
+  static_assert(T::stride<1>() == 3);
+  static_assert(T::stride<2>() == 12);
+
+  auto t = T(fl::rand({3, 4, 5}));
+  ASSERT_EQ(t.tensor().shape(), Shape({3, 4, 5}));
+  EXPECT_THROW(T(fl::rand({3, 4})), std::invalid_argument);
+  EXPECT_THROW(T(fl::rand({3, 4, 6})), std::invalid_argument);
+}
+
+TEST(ShapedTensorTest, Arithmetic) {
+  auto a = ShapedTensor<6, 7>(fl::rand({6, 7}));
+  auto b = ShapedTensor<6, 7>(fl::rand({6, 7}));
+
+  ASSERT_TRUE(allClose((a + b).tensor(), a.tensor() + b.tensor()));
+  ASSERT_TRUE(allClose((a - b).tensor(), a.tensor() - b.tensor()));
+  ASSERT_TRUE(allClose((a * b).tensor(), a.tensor() * b.tensor()));
+  ASSERT_TRUE(allClose((a / b).tensor(), a.tensor() / b.tensor()));
+  ASSERT_TRUE(allClose((a * 2.).tensor(), a.tensor() * 2.));
+  ASSERT_TRUE(allClose((a + 1.).tensor(), a.tensor() + 1.));
+}
+
+TEST(ShapedTensorTest, Matmul) {
+  auto w = ShapedTensor<4, 8>(fl::rand({4, 8}));
+  auto x = ShapedTensor<8, 2>(fl::rand({8, 2}));
+
+  auto y = matmul(w, x);
+  static_assert(decltype(y)::dim<0>() == 4);
+  static_assert(decltype(y)::dim<1>() == 2);
+  ASSERT_TRUE(allClose(y.tensor(), fl::matmul(w.tensor(), x.tensor())));
+}
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  fl::init();
+  return RUN_ALL_TESTS();
+}
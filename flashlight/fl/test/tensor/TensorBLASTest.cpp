@@ -174,6 +174,35 @@ TEST(TensorBLASTest, matmulShapes) {
       Shape({256, 256, 2}));
 }
 
+TEST(TensorBLASTest, batchedMatmul) {
+  // batched results, with and without transposed operands, must match the
+  // per-slice 2D products
+  using T = fl::MatrixProperty;
+  unsigned M = 5;
+  unsigned K = 7;
+  unsigned N = 3;
+  unsigned b2 = 2;
+  unsigned b3 = 3;
+  auto a = fl::rand({M, K, b2, b3});
+  auto b = fl::rand({K, N, b2, b3});
+
+  auto ref = fl::full({M, N, b2, b3}, 0.);
+  for (unsigned i = 0; i < b2; ++i) {
+    for (unsigned j = 0; j < b3; ++j) {
+      ref(fl::span, fl::span, i, j) = fl::matmul(
+          a(fl::span, fl::span, i, j), b(fl::span, fl::span, i, j));
+    }
+  }
+
+  ASSERT_TRUE(allClose(fl::matmul(a, b), ref, 1e-5));
+  auto at = fl::transpose(a, {1, 0, 2, 3});
+  auto bt = fl::transpose(b, {1, 0, 2, 3});
+  ASSERT_TRUE(allClose(fl::matmul(at, b, T::Transpose), ref, 1e-5));
+  ASSERT_TRUE(allClose(fl::matmul(a, bt, T::None, T::Transpose), ref, 1e-5));
+  ASSERT_TRUE(
+      allClose(fl::matmul(at, bt, T::Transpose, T::Transpose), ref, 1e-5));
+}
+
 int main(int argc, char** argv) {
   ::testing::InitGoogleTest(&argc, argv);
   fl::init();
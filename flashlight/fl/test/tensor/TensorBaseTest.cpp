@@ -11,8 +11,12 @@
 
 #include <gtest/gtest.h>
 
+#include "flashlight/fl/runtime/Device.h"
+#include "flashlight/fl/runtime/DeviceManager.h"
+#include "flashlight/fl/runtime/Stream.h"
 #include "flashlight/fl/tensor/Index.h"
 #include "flashlight/fl/tensor/Init.h"
+#include "flashlight/fl/tensor/DefaultTensorType.h"
 #include "flashlight/fl/tensor/Random.h"
 #include "flashlight/fl/tensor/TensorBase.h"
 
@@ -39,6 +43,60 @@ TEST(TensorBaseTest, DefaultConstruction) {
   ASSERT_EQ(v.type(), fl::dtype::u64);
 }
 
+TEST(TensorBaseTest, TypeDispatch) {
+  // the table hands the callable the native element type of the dtype
+  ASSERT_EQ(
+      fl::typeDispatch(fl::dtype::f64, [](auto tag) { return sizeof(tag); }),
+      sizeof(double));
+  auto isFloating = [](auto tag) {
+    return std::is_floating_point<decltype(tag)>::value;
+  };
+  ASSERT_TRUE(fl::typeDispatch(fl::dtype::f32, isFloating));
+  ASSERT_FALSE(fl::typeDispatch(fl::dtype::s32, isFloating));
+  // f16 has no native host type to dispatch on
+  ASSERT_THROW(
+      fl::typeDispatch(fl::dtype::f16, isFloating), std::invalid_argument);
+
+  // getTypeSize agrees with dispatching sizeof for every native dtype
+  for (auto type :
+       {dtype::f32,
+        dtype::f64,
+        dtype::b8,
+        dtype::s16,
+        dtype::s32,
+        dtype::s64,
+        dtype::u8,
+        dtype::u16,
+        dtype::u32,
+        dtype::u64}) {
+    ASSERT_EQ(
+        fl::getTypeSize(type),
+        fl::typeDispatch(type, [](auto tag) { return sizeof(tag); }));
+  }
+}
+
+TEST(TensorBaseTest, CpuParallelismControls) {
+  auto& backend = fl::defaultTensorBackend();
+  const int restoreIntra = backend.getIntraOpNumThreads();
+  const int restoreInter = backend.getInterOpNumThreads();
+
+  backend.setIntraOpNumThreads(2);
+  ASSERT_EQ(backend.getIntraOpNumThreads(), 2);
+  backend.setInterOpNumThreads(3);
+  ASSERT_EQ(backend.getInterOpNumThreads(), 3);
+  ASSERT_THROW(backend.setIntraOpNumThreads(-1), std::invalid_argument);
+  ASSERT_THROW(backend.setInterOpNumThreads(-1), std::invalid_argument);
+
+  // the budget always grants compute at least one core
+  ASSERT_GE(fl::partitionCpuThreads(0), 1);
+  ASSERT_EQ(fl::partitionCpuThreads(1 << 20), 1);
+  ASSERT_EQ(backend.getIntraOpNumThreads(), 1);
+  ASSERT_THROW(fl::partitionCpuThreads(-1), std::invalid_argument);
+
+  backend.setIntraOpNumThreads(restoreIntra);
+  backend.setInterOpNumThreads(restoreInter);
+}
+
 TEST(TensorBaseTest, CopyConstruction) {
   Shape shape{2, 2};
   auto x = fl::full(shape, 0);
@@ -236,6 +294,30 @@ TEST(TensorBaseTest, ConstructFromData) {
   ASSERT_EQ(tArrIs.shape(), Shape({2, 4}));
 }
 
+TEST(TensorBaseTest, fromExternalBuffer) {
+  std::vector<float> vec = {0, 1, 2, 3, 4, 5};
+  fl::Shape s = {3, 2};
+  bool released = false;
+  {
+    auto t = fl::Tensor::fromExternalBuffer(
+        s, fl::dtype::f32, vec.data(), fl::Location::Host, [&released]() {
+          released = true;
+        });
+    ASSERT_EQ(t.shape(), s);
+    ASSERT_EQ(t.type(), fl::dtype::f32);
+    ASSERT_TRUE(allClose(t, fl::Tensor::fromVector(s, vec)));
+  }
+  // holds whether the backend adopted the buffer (released when the last
+  // referencing tensor is destroyed) or fell back to copying (released
+  // before fromExternalBuffer returned)
+  ASSERT_TRUE(released);
+
+  // an empty deleter is allowed
+  auto t = fl::Tensor::fromExternalBuffer(
+      s, fl::dtype::f32, vec.data(), fl::Location::Host, nullptr);
+  ASSERT_TRUE(allClose(t, fl::Tensor::fromVector(s, vec)));
+}
+
 TEST(TensorBaseTest, reshape) {
   auto a = fl::full({4, 4}, 3.);
   auto b = fl::reshape(a, Shape({8, 2}));
@@ -529,6 +611,22 @@ TEST(TensorBaseTest, stream) {
   ASSERT_EQ(&t1.stream(), &t3.stream());
 }
 
+TEST(TensorBaseTest, toDevice) {
+  auto t = fl::rand({5, 6});
+  auto& device =
+      DeviceManager::getInstance().getActiveDevice(t.stream().device().type());
+  ASSERT_FALSE(device.getStreams().empty());
+  auto stream = *device.getStreams().begin();
+
+  // moving to the device a tensor already lives on is a deep copy
+  auto moved = t.toDevice(device, *stream);
+  ASSERT_EQ(&moved.stream().device(), &device);
+  ASSERT_EQ(moved.shape(), t.shape());
+  ASSERT_TRUE(allClose(moved, t));
+  moved += 1;
+  ASSERT_FALSE(allClose(moved, t));
+}
+
 TEST(TensorBaseTest, asContiguousTensor) {
   auto t = fl::rand({5, 6, 7, 8});
   auto indexed =
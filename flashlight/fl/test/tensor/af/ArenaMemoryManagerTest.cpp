@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <memory>
+
+#include <af/device.h>
+#include <arrayfire.h>
+#include <gtest/gtest.h>
+
+#include "flashlight/fl/tensor/Init.h"
+#include "flashlight/fl/tensor/backend/af/mem/ArenaMemoryManager.h"
+#include "flashlight/fl/tensor/backend/af/mem/MemoryManagerInstaller.h"
+
+class ArenaMemoryManagerTest : public ::testing::Test {
+ protected:
+  // small arena so oversized-allocation fallback is easy to exercise
+  static constexpr size_t kArenaBytes = 1 << 20; // 1 MiB
+
+  virtual void SetUp() override {
+    deviceInterface_ = std::make_shared<fl::MemoryManagerDeviceInterface>();
+    adapter_ = std::make_shared<fl::ArenaMemoryManager>(
+        af::getDeviceCount(), deviceInterface_, kArenaBytes);
+    installer_ = std::make_unique<fl::MemoryManagerInstaller>(adapter_);
+    installer_->setAsMemoryManager();
+  }
+
+  virtual void TearDown() override {
+    af_unset_memory_manager();
+  }
+
+  std::shared_ptr<fl::MemoryManagerDeviceInterface> deviceInterface_;
+  std::shared_ptr<fl::ArenaMemoryManager> adapter_;
+  std::unique_ptr<fl::MemoryManagerInstaller> installer_;
+};
+
+TEST_F(ArenaMemoryManagerTest, FallbackOutsideScope) {
+  // With no scope open, everything goes through the caching manager
+  af::array in1 = af::constant(2.0, 8, 8);
+  af::array in2 = af::constant(3.0, 8, 8);
+  ASSERT_TRUE(af::allTrue<bool>(in1 + in2 == 5));
+  ASSERT_EQ(adapter_->arenaBytesUsed(), 0);
+}
+
+TEST_F(ArenaMemoryManagerTest, ScopedAllocAndReset) {
+  adapter_->beginScope();
+  {
+    af::array a = af::constant(2.0, 64, 64);
+    af::array b = af::constant(3.0, 64, 64);
+    af::array c = a * b;
+    ASSERT_TRUE(af::allTrue<bool>(c == 6));
+    ASSERT_GT(adapter_->arenaBytesUsed(), 0);
+  }
+  ASSERT_NO_THROW(adapter_->endScope());
+  ASSERT_EQ(adapter_->arenaBytesUsed(), 0);
+}
+
+TEST_F(ArenaMemoryManagerTest, NestedScopes) {
+  adapter_->beginScope();
+  {
+    af::array outer = af::constant(1.0, 32, 32);
+    outer.eval();
+    const size_t outerUsed = adapter_->arenaBytesUsed();
+
+    adapter_->beginScope();
+    {
+      af::array inner = af::constant(2.0, 32, 32);
+      ASSERT_TRUE(af::allTrue<bool>(outer + inner == 3));
+    }
+    ASSERT_NO_THROW(adapter_->endScope());
+    // the inner scope's allocations are rewound; the outer array survives
+    ASSERT_EQ(adapter_->arenaBytesUsed(), outerUsed);
+    ASSERT_TRUE(af::allTrue<bool>(outer == 1));
+  }
+  ASSERT_NO_THROW(adapter_->endScope());
+  ASSERT_EQ(adapter_->arenaBytesUsed(), 0);
+}
+
+TEST_F(ArenaMemoryManagerTest, OversizedFallsBack) {
+  adapter_->beginScope();
+  {
+    // 4 MiB of f32 doesn't fit a 1 MiB arena; must succeed via the caching
+    // manager regardless
+    af::array big = af::constant(1.0, 1024, 1024);
+    ASSERT_TRUE(af::allTrue<bool>(big == 1));
+    ASSERT_LE(adapter_->arenaBytesUsed(), kArenaBytes);
+  }
+  ASSERT_NO_THROW(adapter_->endScope());
+}
+
+TEST_F(ArenaMemoryManagerTest, EndScopeErrors) {
+  // no scope open
+  EXPECT_THROW(adapter_->endScope(), std::runtime_error);
+
+  adapter_->beginScope();
+  {
+    af::array live = af::constant(1.0, 16, 16);
+    live.eval();
+    // a scoped allocation is still live -- the scope must refuse to rewind
+    EXPECT_THROW(adapter_->endScope(), std::runtime_error);
+  }
+  EXPECT_NO_THROW(adapter_->endScope());
+}
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  fl::init();
+  return RUN_ALL_TESTS();
+}
@@ -132,6 +132,33 @@ TEST(ArrayFireTensorBaseTest, AfRefCountModify) {
   ASSERT_EQ(getRefCount(toArray(z)), 1);
 }
 
+TEST(ArrayFireTensorBaseTest, CopyOnWrite) {
+  // Tensor::copy is lazy - source and copy share the buffer until one of
+  // them is written
+  auto a = fl::full({4, 4}, 1.);
+  auto b = a.copy();
+  ASSERT_EQ(getRefCount(toArray(a)), 2);
+  ASSERT_EQ(getRefCount(toArray(b)), 2);
+
+  // Indexed assignment detaches the written tensor via ArrayFire's own
+  // copy-on-write path; the copy is unaffected
+  a(fl::range(0, 2)) = 5.;
+  ASSERT_TRUE(allClose(b, fl::full({4, 4}, 1.)));
+  ASSERT_EQ(getRefCount(toArray(b)), 1);
+  ASSERT_TRUE(allClose(b(fl::range(0, 2)), fl::full({2, 4}, 1.)));
+  ASSERT_TRUE(allClose(a(fl::range(0, 2)), fl::full({2, 4}, 5.)));
+
+  // Raw device-pointer access detaches explicitly, since writes through the
+  // pointer bypass ArrayFire's copy-on-write handling
+  auto c = b.copy();
+  ASSERT_EQ(getRefCount(toArray(b)), 2);
+  void* ptr = c.device<void>();
+  ASSERT_NE(ptr, nullptr);
+  c.unlock();
+  ASSERT_EQ(getRefCount(toArray(b)), 1);
+  ASSERT_TRUE(allClose(b, c));
+}
+
 TEST(ArrayFireTensorBaseTest, astypeRefcount) {
   auto t = fl::rand({5, 5});
   ASSERT_EQ(getRefCount(toArray(t)), 1);
@@ -424,6 +451,39 @@ TEST(ArrayFireTensorBaseTest, defaultConstructor) {
   ASSERT_TRUE(t.getHandle().isempty());
 }
 
+TEST(ArrayFireTensorBaseTest, contiguousSlabIndex) {
+  auto arr = af::iota(af::dim4(4, 4));
+  auto idx = [](const af::index& s0, const af::index& s1) {
+    return std::vector<af::index>{
+        s0, s1, af::index(af::span), af::index(af::span)};
+  };
+
+  // a partial dim followed by a fully-spanned one selects a strided region
+  // and must not be lowered to a flat copy
+  ASSERT_FALSE(
+      detail::contiguousSlabIndex(arr, idx(af::seq(0, 1), af::span))
+          .has_value());
+
+  // contiguous: full dims below the partial one, single elements above
+  auto slab = detail::contiguousSlabIndex(arr, idx(af::span, af::seq(1, 2)));
+  ASSERT_TRUE(slab.has_value());
+  ASSERT_TRUE(allClose(slab.value(), arr(af::span, af::seq(1, 2))));
+
+  auto col =
+      detail::contiguousSlabIndex(arr, idx(af::seq(1, 3), af::seq(2, 2)));
+  ASSERT_TRUE(col.has_value());
+  ASSERT_TRUE(allClose(col.value(), arr(af::seq(1, 3), af::seq(2, 2))));
+
+  // end-to-end: materializing a lazy partial-dim-then-full-dim index must
+  // fall back to the generic kernel and match per-element values
+  auto t = fl::rand({4, 4});
+  auto view = t(fl::range(0, 2), fl::span);
+  ASSERT_TRUE(allClose(toArray(view), toArray(t)(af::seq(0, 1), af::span)));
+  auto mid = t(fl::range(1, 3), fl::range(1, 3));
+  ASSERT_TRUE(
+      allClose(toArray(mid), toArray(t)(af::seq(1, 2), af::seq(1, 2))));
+}
+
 TEST(ArrayFireTensorBaseTest, emptyRangeIndexing) {
   // TODO the following should all return empty tensor, but AF currently doesn't
   // have a way to represent empty range, and we are just throwing internally.
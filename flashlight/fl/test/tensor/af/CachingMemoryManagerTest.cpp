@@ -5,6 +5,7 @@
  * LICENSE file in the root directory of this source tree.
  */
 
+#include <atomic>
 #include <memory>
 #include <random>
 #include <vector>
@@ -14,7 +15,10 @@
 #include <arrayfire.h>
 #include <gtest/gtest.h>
 
+#include "flashlight/fl/runtime/Stream.h"
+#include "flashlight/fl/tensor/Compute.h"
 #include "flashlight/fl/tensor/Init.h"
+#include "flashlight/fl/tensor/TensorBase.h"
 #include "flashlight/fl/tensor/backend/af/mem/CachingMemoryManager.h"
 #include "flashlight/fl/tensor/backend/af/mem/MemoryManagerAdapter.h"
 #include "flashlight/fl/tensor/backend/af/mem/MemoryManagerInstaller.h"
@@ -191,6 +195,90 @@ TEST_F(CachingMemoryManagerTest, Fragmentation) {
   testFragmentation(deviceInterface_, adapter_, true); // should OOM
 }
 
+TEST_F(CachingMemoryManagerTest, SnapshotAndObservers) {
+  // watermark observer: edge-triggered at an upward utilization crossing
+  std::atomic<int> numFired{0};
+  // tiny watermark, so the first allocation crosses it
+  const auto observerId = adapter_->registerMemoryObserver(
+      1e-6f, [&numFired](int /* device */, float utilization) {
+        EXPECT_GT(utilization, 0.f);
+        ++numFired;
+      });
+  af::array a = af::randu(1024, 1024);
+  af::eval(a);
+  ASSERT_GE(numFired.load(), 1);
+  // edge-triggered: staying above the watermark does not re-fire
+  const int firedAfterFirst = numFired.load();
+  af::array b = af::randu(1024, 1024);
+  af::eval(b);
+  ASSERT_EQ(numFired.load(), firedAfterFirst);
+
+  auto snapshot = adapter_->snapshot();
+  EXPECT_GE(snapshot.deviceId, 0);
+  EXPECT_GT(snapshot.allocatedBytes, 0);
+  ASSERT_FALSE(snapshot.sizeClasses.empty());
+  size_t cachedBytes = 0;
+  size_t lastBlockSize = 0;
+  for (const auto& usage : snapshot.sizeClasses) {
+    EXPECT_GT(usage.blockSize, lastBlockSize); // ascending, distinct
+    lastBlockSize = usage.blockSize;
+    EXPECT_EQ(usage.allocatedBytes, usage.allocatedBlocks * usage.blockSize);
+    EXPECT_EQ(usage.cachedBytes, usage.cachedBlocks * usage.blockSize);
+    cachedBytes += usage.cachedBytes;
+  }
+  EXPECT_EQ(cachedBytes, snapshot.cachedBytes);
+
+  adapter_->unregisterMemoryObserver(observerId);
+  const int firedAtUnregister = numFired.load();
+  af::array c = af::randu(1024, 1024);
+  af::eval(c);
+  ASSERT_EQ(numFired.load(), firedAtUnregister);
+
+  ASSERT_THROW(
+      adapter_->registerMemoryObserver(
+          0.f, [](int /* device */, float /* utilization */) {}),
+      std::invalid_argument);
+  ASSERT_THROW(
+      adapter_->registerMemoryObserver(0.5f, nullptr), std::invalid_argument);
+}
+
+TEST_F(CachingMemoryManagerTest, RecordStreamUsePendingFrees) {
+  // A block freed while marked as in use on another stream must not take the
+  // immediate-reuse path: it parks in the pending-free list until an event
+  // recorded on that stream clears, and only then returns to the pool.
+  if (af::getActiveBackend() != AF_BACKEND_CUDA) {
+    GTEST_SKIP() << "cross-stream free gating requires the CUDA backend";
+  }
+
+  // Stream to record the cross-stream use on; created up front so no
+  // allocation (and thus no processPendingFrees) runs mid-test
+  fl::Tensor streamHolder = fl::full({8}, 1.0f);
+  fl::eval(streamHolder);
+  const fl::Stream& stream = streamHolder.stream();
+
+  af::array arr = af::randu(1 << 20);
+  af::eval(arr);
+  void* ptr = af::getRawPtr(arr);
+  ASSERT_NE(ptr, nullptr);
+  const size_t blockSize = adapter_->allocated(ptr);
+  ASSERT_GT(blockSize, 0);
+
+  adapter_->recordStreamUse(ptr, stream);
+  // unknown pointers are ignored
+  int dummy;
+  adapter_->recordStreamUse(&dummy, stream);
+
+  const auto beforeFree = adapter_->snapshot();
+  arr = af::array(); // free: gated on the recorded stream, not pooled yet
+  const auto pending = adapter_->snapshot();
+  EXPECT_EQ(pending.cachedBytes, beforeFree.cachedBytes);
+
+  stream.sync(); // the recorded event has now cleared
+  adapter_->processPendingFrees();
+  const auto drained = adapter_->snapshot();
+  EXPECT_EQ(drained.cachedBytes, pending.cachedBytes + blockSize);
+}
+
 TEST_F(CachingMemoryManagerTest, RecLimit) {
   constexpr static size_t ONE_GB = 1 << 30;
   // Fine set the manager in order not to recycle big tensors:
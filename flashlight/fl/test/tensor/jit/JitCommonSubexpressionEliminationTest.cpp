@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <functional>
+
+#include <gtest/gtest.h>
+
+#include "flashlight/fl/tensor/DefaultTensorType.h"
+#include "flashlight/fl/tensor/Init.h"
+#include "flashlight/fl/tensor/Shape.h"
+#include "flashlight/fl/tensor/Types.h"
+#include "flashlight/fl/tensor/backend/jit/Utils.h"
+#include "flashlight/fl/tensor/backend/jit/ir/BinaryNode.h"
+#include "flashlight/fl/tensor/backend/jit/ir/ScalarNode.h"
+#include "flashlight/fl/tensor/backend/jit/ir/ValueNode.h"
+#include "flashlight/fl/tensor/backend/jit/opt/passes/CommonSubexpressionElimination.h"
+
+using namespace fl;
+
+class JitCommonSubexpressionEliminationTest : public ::testing::Test {
+ protected:
+  TensorBackend& defaultBackend_ = DefaultTensorBackend_t::getInstance();
+  CommonSubexpressionElimination cse_;
+};
+
+TEST_F(JitCommonSubexpressionEliminationTest, noDuplicates) {
+  // v1  v2
+  //  \  /
+  //   add
+  Shape shape(Shape({2, 2}));
+  auto dtype = dtype::f32;
+  const auto v1 = ValueNode::create(defaultBackend_.full(shape, 1, dtype));
+  const auto v2 = ValueNode::create(defaultBackend_.full(shape, 2, dtype));
+  const auto add = BinaryNode::create(v1, v2, BinaryOp::Add);
+  // nothing changes
+  ASSERT_EQ(add, cse_.apply(add));
+  ASSERT_EQ(add->inputs(), NodeList({v1, v2}));
+  ASSERT_EQ(v1->uses(), UseValList({{add, 0}}));
+  ASSERT_EQ(v2->uses(), UseValList({{add, 1}}));
+}
+
+TEST_F(JitCommonSubexpressionEliminationTest, duplicateScalars) {
+  // c1  c1'
+  //  \  /
+  //   add
+  Shape shape(Shape({2, 2}));
+  auto dtype = dtype::s32;
+  const auto c1 = ScalarNode::create(shape, dtype, 1);
+  const auto c1Dup = ScalarNode::create(shape, dtype, 1);
+  const auto add = BinaryNode::create(c1, c1Dup, BinaryOp::Add);
+  // c1  c1'        c1
+  //  \  /   --->  /  \
+  //   add         \  /
+  //                add
+  ASSERT_EQ(add, cse_.apply(add));
+  ASSERT_EQ(add->inputs(), NodeList({c1, c1}));
+  ASSERT_EQ(c1->uses(), UseValList({{add, 0}, {add, 1}}));
+  ASSERT_EQ(c1Dup->uses(), UseValList({}));
+}
+
+TEST_F(JitCommonSubexpressionEliminationTest, duplicateSubtrees) {
+  // v1  c2  v1  c2'
+  //  \  /    \  /
+  //  add1    add2
+  //     \    /
+  //      mul
+  Shape shape(Shape({2, 2}));
+  auto dtype = dtype::s32;
+  const auto v1 = ValueNode::create(defaultBackend_.full(shape, 1, dtype));
+  const auto c2 = ScalarNode::create(shape, dtype, 2);
+  const auto c2Dup = ScalarNode::create(shape, dtype, 2);
+  const auto add1 = BinaryNode::create(v1, c2, BinaryOp::Add);
+  const auto add2 = BinaryNode::create(v1, c2Dup, BinaryOp::Add);
+  const auto mul = BinaryNode::create(add1, add2, BinaryOp::Mul);
+  // v1  c2
+  //  \  /
+  //  add1
+  //  /  \
+  //  \  /
+  //   mul
+  ASSERT_EQ(mul, cse_.apply(mul));
+  ASSERT_EQ(mul->inputs(), NodeList({add1, add1}));
+  ASSERT_EQ(add1->inputs(), NodeList({v1, c2}));
+  ASSERT_EQ(add1->uses(), UseValList({{mul, 0}, {mul, 1}}));
+  ASSERT_EQ(add2->uses(), UseValList({}));
+}
+
+TEST_F(JitCommonSubexpressionEliminationTest, differentOpsNotMerged) {
+  // v1  c2  v1  c2
+  //  \  /    \  /
+  //  add     sub
+  //    \     /
+  //      mul
+  Shape shape(Shape({2, 2}));
+  auto dtype = dtype::s32;
+  const auto v1 = ValueNode::create(defaultBackend_.full(shape, 1, dtype));
+  const auto c2 = ScalarNode::create(shape, dtype, 2);
+  const auto add = BinaryNode::create(v1, c2, BinaryOp::Add);
+  const auto sub = BinaryNode::create(v1, c2, BinaryOp::Sub);
+  const auto mul = BinaryNode::create(add, sub, BinaryOp::Mul);
+  // nothing changes
+  ASSERT_EQ(mul, cse_.apply(mul));
+  ASSERT_EQ(mul->inputs(), NodeList({add, sub}));
+  ASSERT_EQ(add->uses(), UseValList({{mul, 0}}));
+  ASSERT_EQ(sub->uses(), UseValList({{mul, 1}}));
+}
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  init();
+  return RUN_ALL_TESTS();
+}
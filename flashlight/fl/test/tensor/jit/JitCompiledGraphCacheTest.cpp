@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <functional>
+
+#include <gtest/gtest.h>
+
+#include "flashlight/fl/tensor/DefaultTensorType.h"
+#include "flashlight/fl/tensor/Init.h"
+#include "flashlight/fl/tensor/Random.h"
+#include "flashlight/fl/tensor/Shape.h"
+#include "flashlight/fl/tensor/backend/jit/eval/CompiledGraphCache.h"
+#include "flashlight/fl/tensor/backend/jit/ir/BinaryNode.h"
+#include "flashlight/fl/tensor/backend/jit/ir/CustomNode.h"
+#include "flashlight/fl/tensor/backend/jit/ir/ScalarNode.h"
+#include "flashlight/fl/tensor/backend/jit/ir/ValueNode.h"
+
+using namespace fl;
+
+class JitCompiledGraphCacheTest : public ::testing::Test {
+ protected:
+  JitCompiledGraphCacheTest()
+      : evaluator_(DefaultTensorBackend_t::getInstance()) {}
+  Evaluator evaluator_;
+  CompiledGraphCache cache_;
+
+  // (value + 2) * value'
+  NodePtr
+  buildGraph(const Tensor& t1, const Tensor& t3, const Shape& shape) {
+    const auto v1 = ValueNode::create(t1.copy());
+    const auto c2 = ScalarNode::create(shape, dtype::f32, 2);
+    const auto v3 = ValueNode::create(t3.copy());
+    const auto add = BinaryNode::create(v1, c2, BinaryOp::Add);
+    return BinaryNode::create(add, v3, BinaryOp::Mul);
+  }
+};
+
+TEST_F(JitCompiledGraphCacheTest, missRecordThenReplay) {
+  Shape shape(Shape({2, 2}));
+  const auto t1 = fl::rand(shape, dtype::f32);
+  const auto t3 = fl::rand(shape, dtype::f32);
+  const auto root = buildGraph(t1, t3, shape);
+
+  // nothing recorded yet
+  ASSERT_FALSE(cache_.lookupAndReplay(root, evaluator_).has_value());
+
+  const auto pending = cache_.prepareRecord(root);
+  ASSERT_NE(pending, nullptr);
+  evaluator_.eval(root);
+  cache_.record(pending, root);
+
+  // structurally identical graph with fresh leaf tensors replays the
+  // recorded graph with the new leaves bound in
+  const auto t1New = fl::rand(shape, dtype::f32);
+  const auto t3New = fl::rand(shape, dtype::f32);
+  const auto rootNew = buildGraph(t1New, t3New, shape);
+  auto replayed = cache_.lookupAndReplay(rootNew, evaluator_);
+  ASSERT_TRUE(replayed.has_value());
+  ASSERT_TRUE(allClose(replayed.value(), (t1New + 2) * t3New));
+
+  // replays don't leave stale state behind
+  const auto t1Newer = fl::rand(shape, dtype::f32);
+  const auto t3Newer = fl::rand(shape, dtype::f32);
+  auto replayedAgain =
+      cache_.lookupAndReplay(buildGraph(t1Newer, t3Newer, shape), evaluator_);
+  ASSERT_TRUE(replayedAgain.has_value());
+  ASSERT_TRUE(allClose(replayedAgain.value(), (t1Newer + 2) * t3Newer));
+}
+
+TEST_F(JitCompiledGraphCacheTest, structurallyDifferentGraphMisses) {
+  Shape shape(Shape({2, 2}));
+  const auto t1 = fl::rand(shape, dtype::f32);
+  const auto t3 = fl::rand(shape, dtype::f32);
+  const auto root = buildGraph(t1, t3, shape);
+  const auto pending = cache_.prepareRecord(root);
+  evaluator_.eval(root);
+  cache_.record(pending, root);
+
+  // same leaves, different op
+  const auto v1 = ValueNode::create(t1.copy());
+  const auto c2 = ScalarNode::create(shape, dtype::f32, 2);
+  const auto v3 = ValueNode::create(t3.copy());
+  const auto add = BinaryNode::create(v1, c2, BinaryOp::Add);
+  const auto sub = BinaryNode::create(add, v3, BinaryOp::Sub);
+  ASSERT_FALSE(cache_.lookupAndReplay(sub, evaluator_).has_value());
+}
+
+TEST_F(JitCompiledGraphCacheTest, customNodeGraphNotCacheable) {
+  Shape shape(Shape({2, 2}));
+  const auto c1 = ScalarNode::create(shape, dtype::s32, 1);
+  const auto custom = CustomNode::create(
+      "identity", {c1}, shape, [](const std::vector<const Tensor*>& inputs) {
+        return inputs[0]->copy();
+      });
+  ASSERT_EQ(cache_.prepareRecord(custom), nullptr);
+  ASSERT_FALSE(cache_.lookupAndReplay(custom, evaluator_).has_value());
+}
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  init();
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <functional>
+
+#include <gtest/gtest.h>
+
+#include "flashlight/fl/tensor/DefaultTensorType.h"
+#include "flashlight/fl/tensor/Init.h"
+#include "flashlight/fl/tensor/Shape.h"
+#include "flashlight/fl/tensor/Types.h"
+#include "flashlight/fl/tensor/backend/jit/Utils.h"
+#include "flashlight/fl/tensor/backend/jit/ir/BinaryNode.h"
+#include "flashlight/fl/tensor/backend/jit/ir/CustomNode.h"
+#include "flashlight/fl/tensor/backend/jit/ir/ScalarNode.h"
+#include "flashlight/fl/tensor/backend/jit/ir/ValueNode.h"
+#include "flashlight/fl/tensor/backend/jit/opt/passes/ElementwiseFusion.h"
+
+using namespace fl;
+
+class JitElementwiseFusionTest : public ::testing::Test {
+ protected:
+  TensorBackend& defaultBackend_ = DefaultTensorBackend_t::getInstance();
+  ElementwiseFusion fuser_;
+};
+
+TEST_F(JitElementwiseFusionTest, singleBinaryNode) {
+  // v1  v2
+  //  \  /
+  //   add
+  Shape shape(Shape({2, 2}));
+  auto dtype = dtype::f32;
+  const auto v1 = ValueNode::create(defaultBackend_.full(shape, 1, dtype));
+  const auto v2 = ValueNode::create(defaultBackend_.full(shape, 2, dtype));
+  const auto add = BinaryNode::create(v1, v2, BinaryOp::Add);
+  const auto res = fuser_.apply(add);
+  // nothing changes
+  ASSERT_EQ(res, add);
+  ASSERT_EQ(v1->uses(), UseValList({{add, 0}}));
+  ASSERT_EQ(v2->uses(), UseValList({{add, 1}}));
+  ASSERT_EQ(add->inputs(), NodeList({v1, v2}));
+  ASSERT_EQ(add->uses(), UseValList({}));
+}
+
+TEST_F(JitElementwiseFusionTest, fuseChain) {
+  // v1  v2
+  //  \  /
+  //   mul  v3
+  //    \  /
+  //     add
+  Shape shape(Shape({2, 2}));
+  auto dtype = dtype::f32;
+  const auto v1 = ValueNode::create(defaultBackend_.full(shape, 2, dtype));
+  const auto v2 = ValueNode::create(defaultBackend_.full(shape, 3, dtype));
+  const auto v3 = ValueNode::create(defaultBackend_.full(shape, 4, dtype));
+  const auto mul = BinaryNode::create(v1, v2, BinaryOp::Mul);
+  const auto add = BinaryNode::create(mul, v3, BinaryOp::Add);
+  const auto res = fuser_.apply(add);
+  //  v1 v3 v2
+  //   \ |  /
+  //   custom
+  ASSERT_TRUE(res->isCustom());
+  ASSERT_NE(res, add);
+  // operands get recorded top-down, so v3 (rhs of the root) precedes v2
+  ASSERT_EQ(res->inputs(), NodeList({v1, v3, v2}));
+  ASSERT_EQ(res->shape(), shape);
+  ASSERT_EQ(v1->uses(), UseValList({{mul, 0}, {res, 0}}));
+  // fused evaluation yields the same result as the original chain
+  const auto t1 = v1->getResult().value();
+  const auto t2 = v2->getResult().value();
+  const auto t3 = v3->getResult().value();
+  const auto fusedResult = res->impl<CustomNode>().evalFunc()({&t1, &t3, &t2});
+  ASSERT_TRUE(allClose(fusedResult, t1 * t2 + t3));
+}
+
+TEST_F(JitElementwiseFusionTest, fuseChainWithScalarLiteral) {
+  // v1  c2
+  //  \  /
+  //   mul  v3
+  //    \  /
+  //     sub
+  Shape shape(Shape({2, 2}));
+  auto dtype = dtype::f32;
+  const auto v1 = ValueNode::create(defaultBackend_.full(shape, 2, dtype));
+  const auto c2 = ScalarNode::create(shape, dtype, 3);
+  const auto v3 = ValueNode::create(defaultBackend_.full(shape, 4, dtype));
+  const auto mul = BinaryNode::create(v1, c2, BinaryOp::Mul);
+  const auto sub = BinaryNode::create(mul, v3, BinaryOp::Sub);
+  const auto res = fuser_.apply(sub);
+  // c2 gets embedded as a literal instead of becoming a fused-node input
+  ASSERT_TRUE(res->isCustom());
+  ASSERT_EQ(res->inputs(), NodeList({v1, v3}));
+  const auto t1 = v1->getResult().value();
+  const auto t3 = v3->getResult().value();
+  const auto fusedResult = res->impl<CustomNode>().evalFunc()({&t1, &t3});
+  ASSERT_TRUE(allClose(fusedResult, t1 * 3 - t3));
+}
+
+TEST_F(JitElementwiseFusionTest, sharedIntermediateNotFused) {
+  //   v1  v2
+  //    \  /
+  //     mul
+  //    /  \
+  //    \  /
+  //     add
+  Shape shape(Shape({2, 2}));
+  auto dtype = dtype::f32;
+  const auto v1 = ValueNode::create(defaultBackend_.full(shape, 1, dtype));
+  const auto v2 = ValueNode::create(defaultBackend_.full(shape, 2, dtype));
+  const auto mul = BinaryNode::create(v1, v2, BinaryOp::Mul);
+  const auto add = BinaryNode::create(mul, mul, BinaryOp::Add);
+  const auto res = fuser_.apply(add);
+  // nothing changes -- fusing would force recomputing `mul`
+  ASSERT_EQ(res, add);
+  ASSERT_EQ(add->inputs(), NodeList({mul, mul}));
+  ASSERT_EQ(mul->uses(), UseValList({{add, 0}, {add, 1}}));
+}
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  init();
+  return RUN_ALL_TESTS();
+}
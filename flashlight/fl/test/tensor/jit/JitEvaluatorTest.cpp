@@ -56,6 +56,52 @@ TEST_F(JitEvaluatorTest, evalBinaryNode) {
   ASSERT_TRUE(allClose(add->getResult().value(), full(shape, 3, dtype)));
 }
 
+TEST_F(JitEvaluatorTest, evalBinaryNodeChainInPlace) {
+  // v1  c2
+  //  \  /
+  //   add  c3
+  //    \  /
+  //     mul
+  //
+  // `add` is an intermediate with a single use, so `mul` executes in place on
+  // its dead buffer -- results must be unaffected.
+  Shape shape(Shape({2, 2}));
+  auto dtype = dtype::f32;
+  const auto tensor = fl::rand(shape, dtype);
+  const auto v1 = ValueNode::create(tensor.copy());
+  const auto c2 = ScalarNode::create(shape, dtype, 2);
+  const auto c3 = ScalarNode::create(shape, dtype, 3);
+  const auto add = BinaryNode::create(v1, c2, BinaryOp::Add);
+  const auto mul = BinaryNode::create(add, c3, BinaryOp::Mul);
+  evaluator_.eval(mul);
+  ASSERT_TRUE(allClose(mul->getResult().value(), (tensor + 2) * 3));
+  // input tensor owned outside the graph is never written into
+  ASSERT_TRUE(allClose(v1->getResult().value(), tensor));
+}
+
+TEST_F(JitEvaluatorTest, evalPartitionedIndependentBranches) {
+  // v1  c2  v3  c4
+  //  \  /    \  /
+  //   add    mul    <-- independent branches
+  //     \    /
+  //      sub
+  Shape shape(Shape({2, 2}));
+  auto dtype = dtype::f32;
+  const auto t1 = fl::rand(shape, dtype);
+  const auto t3 = fl::rand(shape, dtype);
+  const auto v1 = ValueNode::create(t1.copy());
+  const auto c2 = ScalarNode::create(shape, dtype, 2);
+  const auto v3 = ValueNode::create(t3.copy());
+  const auto c4 = ScalarNode::create(shape, dtype, 4);
+  const auto add = BinaryNode::create(v1, c2, BinaryOp::Add);
+  const auto mul = BinaryNode::create(v3, c4, BinaryOp::Mul);
+  const auto sub = BinaryNode::create(add, mul, BinaryOp::Sub);
+  evaluator_.setStreamParallelism(true);
+  evaluator_.eval(sub);
+  evaluator_.setStreamParallelism(false);
+  ASSERT_TRUE(allClose(sub->getResult().value(), (t1 + 2) - (t3 * 4)));
+}
+
 TEST_F(JitEvaluatorTest, evalCustomNode) {
   // c1  c2  c3
   //  \  |  /
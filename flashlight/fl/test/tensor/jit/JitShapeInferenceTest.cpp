@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <vector>
+
+#include "flashlight/fl/tensor/Init.h"
+#include "flashlight/fl/tensor/Shape.h"
+#include "flashlight/fl/tensor/backend/jit/ShapeInference.h"
+
+using namespace fl;
+
+TEST(JitShapeInferenceTest, reduction) {
+  const Shape input({3, 4, 5});
+  // inference is memoized -- repeated calls (hits) and interleaved calls with
+  // different keys must keep yielding the right shapes
+  for (int iter = 0; iter < 3; iter++) {
+    ASSERT_EQ(inferReductionOutputShape(input, {1}, false), Shape({3, 5}));
+    ASSERT_EQ(inferReductionOutputShape(input, {1}, true), Shape({3, 1, 5}));
+    ASSERT_EQ(inferReductionOutputShape(input, {}, false), Shape({}));
+    ASSERT_EQ(
+        inferReductionOutputShape(Shape({7, 4, 5}), {1}, false),
+        Shape({7, 5}));
+  }
+  // invalid inputs aren't memoized and keep throwing
+  for (int iter = 0; iter < 2; iter++) {
+    ASSERT_THROW(
+        inferReductionOutputShape(input, {3}, false), std::invalid_argument);
+  }
+}
+
+TEST(JitShapeInferenceTest, transpose) {
+  const Shape input({2, 3, 4});
+  for (int iter = 0; iter < 3; iter++) {
+    ASSERT_EQ(inferTransposeOutputShape(input, {}), Shape({4, 3, 2}));
+    ASSERT_EQ(inferTransposeOutputShape(input, {1, 0, 2}), Shape({3, 2, 4}));
+    ASSERT_THROW(inferTransposeOutputShape(input, {1, 0}), std::runtime_error);
+  }
+}
+
+TEST(JitShapeInferenceTest, tileAndPad) {
+  for (int iter = 0; iter < 3; iter++) {
+    ASSERT_EQ(inferTileOutputShape(Shape({2, 3}), Shape({3})), Shape({6, 3}));
+    ASSERT_EQ(
+        inferTileOutputShape(Shape({2}), Shape({1, 4})), Shape({2, 4}));
+    ASSERT_EQ(
+        inferPadOutputShape(Shape({2, 3}), {{1, 2}, {0, 1}}), Shape({5, 4}));
+    ASSERT_THROW(
+        inferPadOutputShape(Shape({2}), {{1, 1}, {1, 1}}), std::runtime_error);
+  }
+}
+
+TEST(JitShapeInferenceTest, matmul) {
+  for (int iter = 0; iter < 3; iter++) {
+    ASSERT_EQ(
+        inferMatmulOutputShape(
+            Shape({2, 3}),
+            Shape({3, 4}),
+            MatrixProperty::None,
+            MatrixProperty::None),
+        Shape({2, 4}));
+    ASSERT_EQ(
+        inferMatmulOutputShape(
+            Shape({3, 2}),
+            Shape({3, 4}),
+            MatrixProperty::Transpose,
+            MatrixProperty::None),
+        Shape({2, 4}));
+    ASSERT_THROW(
+        inferMatmulOutputShape(
+            Shape({2, 3}),
+            Shape({4, 5}),
+            MatrixProperty::None,
+            MatrixProperty::None),
+        std::invalid_argument);
+  }
+}
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  fl::init();
+  return RUN_ALL_TESTS();
+}
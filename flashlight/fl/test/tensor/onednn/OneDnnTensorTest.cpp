@@ -241,6 +241,42 @@ TEST(OneDnnTensorTest, transpose) {
   assertOneDnnTensorEq(t3, fl::transpose(t1, {2, 0, 1}));
 }
 
+TEST(OneDnnTensorTest, transposeView) {
+  auto t1 = fl::Tensor::fromVector<int>(
+      {2, 3, 2}, {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11});
+
+  // transposition is a zero-copy view over the same underlying memory
+  auto t2 = fl::transpose(t1);
+  ASSERT_FALSE(t2.isContiguous());
+  ASSERT_EQ(t1.device<void>(), t2.device<void>());
+  t1.unlock();
+  t2.unlock();
+
+  // the view materializes correctly at layout boundaries (host read & copy)
+  const std::vector<int> expected = {0, 6, 2, 8, 4, 10, 1, 7, 3, 9, 5, 11};
+  ASSERT_EQ(t2.toHostVector<int>(), expected);
+  assertOneDnnTensorEq(
+      fl::Tensor::fromVector<int>({2, 3, 2}, expected),
+      t2.asContiguousTensor());
+
+  // ops consume the permuted layout directly
+  assertOneDnnTensorEq(
+      fl::Tensor::fromVector<int>(
+          {2, 3, 2}, {0, 12, 4, 16, 8, 20, 2, 14, 6, 18, 10, 22}),
+      fl::transpose(t1) + fl::transpose(t1));
+
+  // transposing an indexed view retains its offsets
+  assertOneDnnTensorEq(
+      fl::Tensor::fromVector<int>({2, 2, 2}, {2, 8, 4, 10, 3, 9, 5, 11}),
+      fl::transpose(t1(fl::span, fl::range(1, 3), fl::span)));
+
+  // transposing a view composes
+  assertOneDnnTensorEq(
+      fl::Tensor::fromVector<int>(
+          {2, 3, 2}, {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11}),
+      fl::transpose(fl::transpose(t1, {2, 0, 1}), {1, 2, 0}));
+}
+
 TEST(OneDnnTensorTest, full) {
   const fl::Shape shape{2, 2, 2};
   assertOneDnnTensorEq(
@@ -663,6 +699,33 @@ TEST(OneDnnTensorTest, tile) {
       fl::Tensor::fromVector<float>({4}, {3, 4, 3, 4}));
 }
 
+TEST(OneDnnTensorTest, primitiveCache) {
+  auto& cache = fl::OneDnnBackend::getInstance().primitiveCache();
+  cache.clear();
+  ASSERT_EQ(cache.size(), 0);
+
+  auto a = fl::Tensor::fromVector<float>({2, 2}, {1, 2, 3, 4});
+  auto b = fl::Tensor::fromVector<float>({2, 2}, {5, 6, 7, 8});
+  assertOneDnnTensorEq(
+      a + b, fl::Tensor::fromVector<float>({2, 2}, {6, 8, 10, 12}));
+
+  // Re-running the same configuration reuses the cached primitive
+  const auto sizeAfterFirstRun = cache.size();
+  ASSERT_GT(sizeAfterFirstRun, 0);
+  assertOneDnnTensorEq(
+      a + b, fl::Tensor::fromVector<float>({2, 2}, {6, 8, 10, 12}));
+  ASSERT_EQ(cache.size(), sizeAfterFirstRun);
+
+  // A different shape is a different configuration
+  auto c = fl::Tensor::fromVector<float>({4}, {1, 2, 3, 4});
+  assertOneDnnTensorEq(
+      c + c, fl::Tensor::fromVector<float>({4}, {2, 4, 6, 8}));
+  ASSERT_GT(cache.size(), sizeAfterFirstRun);
+
+  cache.clear();
+  ASSERT_EQ(cache.size(), 0);
+}
+
 TEST(OneDnnTensorTest, arange) {
   // Range/step overload
   assertOneDnnTensorEq(
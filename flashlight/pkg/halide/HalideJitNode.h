@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#if FL_USE_JIT
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "flashlight/fl/tensor/backend/jit/ir/CustomNode.h"
+#include "flashlight/pkg/halide/HalideInterface.h"
+
+namespace fl {
+namespace pkg {
+namespace halide {
+
+/**
+ * Signature of a Halide AOT-generated pipeline as registered with the JIT
+ * backend: the wrapped device buffers of the node's inputs (in input order)
+ * and the preallocated output buffer. Returns the Halide error code of the
+ * pipeline invocation. Scalar pipeline parameters are bound by capturing them
+ * in the callable, e.g.
+ *
+ * \code
+   HalidePipeline<float> pipeline =
+       [offset](const std::vector<Halide::Runtime::Buffer<float>*>& inputs,
+                Halide::Runtime::Buffer<float>& output) {
+         return myAotPipeline(*inputs[0], offset, output);
+       };
+ * \endcode
+ */
+template <typename T>
+using HalidePipeline = std::function<int(
+    const std::vector<Halide::Runtime::Buffer<T>*>& inputs,
+    Halide::Runtime::Buffer<T>& output)>;
+
+/**
+ * Adapts a Halide pipeline into a `CustomNode` evaluation function. The
+ * resulting function wraps the input tensors' device memory in Halide buffers
+ * via `HalideBufferWrapper` (no copies), allocates the output tensor, and
+ * invokes the pipeline on the default stream; a nonzero pipeline return code
+ * becomes a `std::runtime_error`. `T` is the element type of the pipeline's
+ * buffers -- all inputs and the output must be of the corresponding fl type.
+ */
+template <typename T>
+CustomNode::EvalFunc makeHalideEvalFunc(
+    const Shape& outputShape,
+    HalidePipeline<T> pipeline) {
+  return [outputShape, pipeline = std::move(pipeline)](
+             const std::vector<const Tensor*>& inputs) -> Tensor {
+    std::vector<std::unique_ptr<HalideBufferWrapper<T>>> inputWrappers;
+    std::vector<Halide::Runtime::Buffer<T>*> inputBuffers;
+    for (const Tensor* input : inputs) {
+      // wrapping only aliases the tensor's device memory for the duration of
+      // the call; the pipeline treats input buffers as read-only
+      inputWrappers.push_back(
+          std::make_unique<HalideBufferWrapper<T>>(const_cast<Tensor&>(*input)));
+      inputBuffers.push_back(&inputWrappers.back()->getRuntimeBuffer());
+    }
+    Tensor output(outputShape, dtype_traits<T>::fl_type);
+    HalideBufferWrapper<T> outputWrapper(output);
+    FL_HALIDE_CHECK(pipeline(inputBuffers, outputWrapper.getRuntimeBuffer()));
+    return output;
+  };
+}
+
+/**
+ * Registers a Halide pipeline as the evaluator of a JIT `CustomNode` over the
+ * given input nodes. Fusion passes (and user code) can use this to materialize
+ * an elementwise or stencil subgraph with a single Halide-generated kernel
+ * instead of per-op backend calls; to the rest of the JIT graph the node
+ * behaves like any other `CustomNode`.
+ *
+ * @param name debug name of the node, e.g. the generator name
+ * @param inputs the nodes whose evaluated tensors are fed to the pipeline
+ * @param outputShape shape of the pipeline's output
+ * @param pipeline the adapted AOT pipeline -- see `HalidePipeline`
+ */
+template <typename T>
+CustomNodePtr makeHalideCustomNode(
+    std::string name,
+    std::vector<NodePtr> inputs,
+    const Shape& outputShape,
+    HalidePipeline<T> pipeline) {
+  auto evalFunc = makeHalideEvalFunc<T>(outputShape, std::move(pipeline));
+  return CustomNode::create(
+      std::move(name), std::move(inputs), outputShape, std::move(evalFunc));
+}
+
+} // namespace halide
+} // namespace pkg
+} // namespace fl
+
+#endif // FL_USE_JIT
@@ -15,6 +15,11 @@
 #include "flashlight/fl/tensor/Index.h"
 #include "flashlight/fl/tensor/Random.h"
 #include "flashlight/pkg/halide/HalideInterface.h"
+#include "flashlight/pkg/halide/HalideJitNode.h"
+
+#if FL_USE_JIT
+#include "flashlight/fl/tensor/backend/jit/ir/ValueNode.h"
+#endif
 
 // Generated at build time -- see the accompanying CMakeList
 #include "HalideTestPipeline.h"
@@ -148,6 +153,42 @@ TEST(HalideTest, SimpleAOTCompiledHalidePipeline) {
   EXPECT_TRUE(fl::allClose(expected, output));
 }
 
+#if FL_USE_JIT
+TEST(HalideTest, CustomNodeFromAOTPipeline) {
+  int yDim = 64, xDim = 64;
+  int offset = 5;
+
+  auto input = fl::rand({yDim, xDim}) * 100;
+  auto expected = Tensor(input.shape(), fl::dtype::f32);
+
+  // Reference implementation
+  for (int i = 0; i < input.dim(0); ++i) {
+    for (int j = 0; j < input.dim(1); ++j) {
+      expected(i, j) = input(i, j) + std::sin(i * j) + offset;
+    }
+  }
+
+  // Register the AOT pipeline as the evaluator of a JIT CustomNode; the
+  // scalar pipeline parameter is bound by capture
+  auto node = pkg::halide::makeHalideCustomNode<float>(
+      "testFunc",
+      {ValueNode::create(input.copy())},
+      input.shape(),
+      [offset](
+          const std::vector<Halide::Runtime::Buffer<float>*>& inputs,
+          Halide::Runtime::Buffer<float>& output) {
+        return testFunc(*inputs[0], offset, output);
+      });
+  ASSERT_TRUE(node->isCustom());
+  ASSERT_EQ(node->shape(), input.shape());
+  ASSERT_EQ(node->inputs().size(), 1);
+
+  // Evaluate the node the way the JIT Evaluator would
+  auto output = node->evalFunc()({&input});
+  EXPECT_TRUE(fl::allClose(expected, output));
+}
+#endif // FL_USE_JIT
+
 TEST(HalideTest, SimpleJITHalidePipeline) {
   // Make sure we can call the Halide JIT inline in flashlight
   int yDim = 10, xDim = 10;
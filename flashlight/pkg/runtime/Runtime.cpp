@@ -8,7 +8,9 @@
 #include <gflags/gflags.h>
 
 #include <iomanip>
+#include <numeric>
 #include <sstream>
+#include <stdexcept>
 
 #include "flashlight/pkg/runtime/Runtime.h"
 
@@ -61,6 +63,42 @@ bool backwardWithScaling(
   return true;
 }
 
+void warmupModule(
+    fl::Module& module,
+    const std::vector<Shape>& inputShapes,
+    fl::dtype inputType /* = fl::dtype::f32 */,
+    bool withBackward /* = true */,
+    int numIterations /* = 3 */) {
+  if (inputShapes.empty()) {
+    throw std::invalid_argument("warmupModule - no input shapes given");
+  }
+  if (numIterations <= 0) {
+    throw std::invalid_argument("warmupModule - numIterations must be > 0");
+  }
+
+  std::vector<fl::Variable> inputs;
+  inputs.reserve(inputShapes.size());
+  for (const auto& shape : inputShapes) {
+    inputs.emplace_back(fl::rand(shape).astype(inputType), false);
+  }
+
+  for (int iter = 0; iter < numIterations; ++iter) {
+    auto outputs = module.forward(inputs);
+    if (withBackward) {
+      fl::Variable loss;
+      for (auto& output : outputs) {
+        std::vector<int> axes(output.ndim());
+        std::iota(axes.begin(), axes.end(), 0);
+        auto outputSum = fl::sum(output, axes);
+        loss = loss.isEmpty() ? outputSum : loss + outputSum;
+      }
+      loss.backward();
+      module.zeroGrad();
+    }
+  }
+  fl::sync();
+}
+
 std::string getCurrentDate() {
   time_t now = time(nullptr);
   struct tm tmbuf;
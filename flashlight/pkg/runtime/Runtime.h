@@ -41,6 +41,33 @@ bool backwardWithScaling(
     std::shared_ptr<fl::pkg::runtime::DynamicScaler> dynamicScaler,
     std::shared_ptr<fl::Reducer> reducer);
 
+/**
+ * Run shape-complete forward/backward dry runs of a module on dummy data to
+ * reach steady-state speed before step 1 of real training: lazy backend
+ * libraries get loaded, `DynamicBenchmark` timings converge, and the caching
+ * memory manager retains the dry runs' high-water-mark allocations in its
+ * pool.
+ *
+ * Call once per representative input geometry (e.g., per bucketed sequence
+ * length). The module is left with zeroed (but allocated) gradients; dry runs
+ * in train mode also update normalization running statistics, so warm up
+ * before loading a checkpoint when that matters.
+ *
+ * @param[in] module - the module to warm up, in its intended train/eval mode.
+ * @param[in] inputShapes - one shape per input of `Module::forward`.
+ * @param[in] inputType - the type of the dummy inputs.
+ * @param[in] withBackward - also run the backward pass; requires the module's
+ * outputs to support gradient computation.
+ * @param[in] numIterations - dry-run count; a few iterations let dynamic
+ * benchmarks settle on their fastest option.
+ */
+void warmupModule(
+    fl::Module& module,
+    const std::vector<Shape>& inputShapes,
+    fl::dtype inputType = fl::dtype::f32,
+    bool withBackward = true,
+    int numIterations = 3);
+
 /**
  * Returns the current date as a string
  */
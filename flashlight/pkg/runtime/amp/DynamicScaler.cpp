@@ -27,34 +27,91 @@ fl::Variable DynamicScaler::scale(const fl::Variable& loss) {
 }
 
 bool DynamicScaler::unscale(std::vector<fl::Variable>& params) {
+  std::vector<fl::Tensor> overflowFlags;
+  overflowFlags.reserve(params.size());
   for (auto& p : params) {
     if (!p.isGradAvailable()) {
       // Add a dummy grad for params not used in the backwards pass
       p.addGrad(Variable(fl::full(p.shape(), 0., p.type()), false));
     }
     p.grad() = p.grad() / scaleFactor_;
-    if (fl::isInvalidArray(p.grad().tensor())) {
-      if (scaleFactor_ >= fl::kAmpMinimumScaleFactorValue) {
-        scaleFactor_ = scaleFactor_ / 2.0f;
-        FL_LOG(LogLevel::INFO)
-            << "AMP: Scale factor decreased. New value:\t" << scaleFactor_;
-      } else {
-        FL_LOG(LogLevel::FATAL)
-            << "Minimum loss scale reached: " << fl::kAmpMinimumScaleFactorValue
-            << " with over/underflowing gradients. Lowering the "
-            << "learning rate, using gradient clipping, or "
-            << "increasing the batch size can help resolve "
-            << "loss explosion.";
-      }
-      successCounter_ = 0;
-      return false;
-    }
+    const auto& grad = p.grad().tensor();
+    overflowFlags.push_back(fl::any(fl::isnan(grad) || fl::isinf(grad)));
+  }
+
+  // Read the overflow flags back with a single device sync for all gradients
+  // rather than one per parameter.
+  bool gradsInvalid = false;
+  for (const auto flag : fl::asScalars<char>(overflowFlags)) {
+    gradsInvalid = gradsInvalid || static_cast<bool>(flag);
+  }
+  if (gradsInvalid) {
+    decreaseScaleFactor();
+    return false;
   }
 
   ++successCounter_;
   return true;
 }
 
+bool DynamicScaler::unscaleAsync(std::vector<fl::Variable>& params) {
+  Tensor overflow;
+  for (auto& p : params) {
+    if (!p.isGradAvailable()) {
+      // Add a dummy grad for params not used in the backwards pass
+      p.addGrad(Variable(fl::full(p.shape(), 0., p.type()), false));
+    }
+    const auto& grad = p.grad().tensor();
+    auto flag = fl::any(fl::isnan(grad) || fl::isinf(grad));
+    overflow = overflow.isEmpty() ? flag : overflow || flag;
+  }
+
+  if (!overflow.isEmpty()) {
+    // Gate the gradients on the device: if any of them overflowed, all of
+    // them become zero, so the optimizer step is a null update and the
+    // parameters stay finite without the host reading this step's flag
+    auto keep = !overflow;
+    for (auto& p : params) {
+      auto& grad = p.grad().tensor();
+      grad = grad * keep.astype(grad.type()) / scaleFactor_;
+    }
+  }
+
+  // Act on the previous step's flag. Its computation finished a step ago, so
+  // resolving it now doesn't stall the device on pending work; this is what
+  // keeps the common no-overflow path free of meaningful syncs.
+  bool prevValid = true;
+  if (pendingOverflow_ && pendingOverflow_->get()) {
+    decreaseScaleFactor();
+    prevValid = false;
+  } else if (pendingOverflow_) {
+    ++successCounter_;
+  }
+
+  if (!overflow.isEmpty()) {
+    pendingOverflow_.emplace(overflow);
+  } else {
+    pendingOverflow_.reset();
+  }
+  return prevValid;
+}
+
+void DynamicScaler::decreaseScaleFactor() {
+  if (scaleFactor_ >= fl::kAmpMinimumScaleFactorValue) {
+    scaleFactor_ = scaleFactor_ / 2.0f;
+    FL_LOG(LogLevel::INFO)
+        << "AMP: Scale factor decreased. New value:\t" << scaleFactor_;
+  } else {
+    FL_LOG(LogLevel::FATAL)
+        << "Minimum loss scale reached: " << fl::kAmpMinimumScaleFactorValue
+        << " with over/underflowing gradients. Lowering the "
+        << "learning rate, using gradient clipping, or "
+        << "increasing the batch size can help resolve "
+        << "loss explosion.";
+  }
+  successCounter_ = 0;
+}
+
 void DynamicScaler::update() {
   if (scaleFactor_ >= maxScaleFactor_) {
     return;
@@ -7,8 +7,10 @@
 
 #pragma once
 
+#include <optional>
 #include <vector>
 #include "flashlight/fl/autograd/Variable.h"
+#include "flashlight/fl/tensor/ScalarFuture.h"
 
 namespace fl {
 namespace pkg {
@@ -55,6 +57,23 @@ class DynamicScaler {
    */
   bool unscale(std::vector<fl::Variable>& params);
 
+  /*
+   * Unscale the gradients without synchronizing with the device.
+   *
+   * The per-gradient overflow checks are OR-ed into a single device-side
+   * flag which gates the gradients: when any gradient holds NAN or INF,
+   * every gradient of the step is zeroed on the device, so the following
+   * optimizer step applies a null update and the parameters stay finite
+   * without the host inspecting the gradients. The flag is read back
+   * asynchronously and acted on one step later: the return value reports
+   * whether the *previous* call's gradients were finite, and the scale
+   * factor is halved at that point. Unlike with unscale, the caller may
+   * always proceed to the optimizer step; the return value only serves
+   * skip accounting. Note a null update is not a strict skip under
+   * optimizers with decoupled weight decay or decaying momentum.
+   */
+  bool unscaleAsync(std::vector<fl::Variable>& params);
+
   /*
    * Increase scale factor
    */
@@ -66,6 +85,12 @@ class DynamicScaler {
   double getScaleFactor() const;
 
  private:
+  /*
+   * Halve the scale factor after overflowing gradients; fatal when the
+   * minimum scale is reached.
+   */
+  void decreaseScaleFactor();
+
   double scaleFactor_;
   // The maximum value of scaleFactor_.
   double maxScaleFactor_;
@@ -73,6 +98,9 @@ class DynamicScaler {
   unsigned int successCounter_{0};
   // Double up the scaleFactor_ when successCounter_ equals updateInterval_.
   unsigned int updateInterval_;
+  // Overflow flag staged by the last unscaleAsync call, resolved (one step
+  // late) by the next one. Transient; not serialized.
+  std::optional<fl::ScalarFuture<char>> pendingOverflow_;
 
   FL_SAVE_LOAD(scaleFactor_, maxScaleFactor_, updateInterval_, successCounter_)
   DynamicScaler() = default;
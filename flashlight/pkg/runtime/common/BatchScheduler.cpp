@@ -0,0 +1,158 @@
+/**
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "flashlight/pkg/runtime/common/BatchScheduler.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+namespace fl {
+namespace pkg {
+namespace runtime {
+
+struct BatchScheduler::Slot::Request {
+  std::vector<Tensor> input;
+  std::vector<Tensor> state;
+  std::vector<Tensor> output;
+  std::promise<std::vector<Tensor>> promise;
+  std::chrono::steady_clock::time_point arrival;
+  bool done{false};
+};
+
+const std::vector<Tensor>& BatchScheduler::Slot::input() const {
+  return request_->input;
+}
+
+std::vector<Tensor>& BatchScheduler::Slot::state() {
+  return request_->state;
+}
+
+void BatchScheduler::Slot::finish(std::vector<Tensor> output) {
+  request_->output = std::move(output);
+  request_->done = true;
+}
+
+bool BatchScheduler::Slot::finished() const {
+  return request_->done;
+}
+
+BatchScheduler::BatchScheduler(
+    StepFunction step,
+    Options options /* = Options() */)
+    : step_(std::move(step)), options_(options) {
+  if (!step_) {
+    throw std::invalid_argument(
+        "BatchScheduler::BatchScheduler - step function is null");
+  }
+  if (options_.maxBatchSize == 0) {
+    throw std::invalid_argument(
+        "BatchScheduler::BatchScheduler - maxBatchSize must be nonzero");
+  }
+  worker_ = std::thread(&BatchScheduler::workerLoop, this);
+}
+
+BatchScheduler::~BatchScheduler() {
+  stop();
+}
+
+std::future<std::vector<Tensor>> BatchScheduler::enqueue(
+    std::vector<Tensor> input) {
+  auto request = std::make_unique<Slot::Request>();
+  request->input = std::move(input);
+  request->arrival = std::chrono::steady_clock::now();
+  auto future = request->promise.get_future();
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (stopped_) {
+      throw std::runtime_error(
+          "BatchScheduler::enqueue - scheduler is stopped");
+    }
+    queue_.push_back(std::move(request));
+  }
+  cv_.notify_all();
+  return future;
+}
+
+void BatchScheduler::stop() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopped_ = true;
+  }
+  cv_.notify_all();
+  if (worker_.joinable()) {
+    worker_.join();
+  }
+}
+
+void BatchScheduler::admitQueued() {
+  while (active_.size() < options_.maxBatchSize && !queue_.empty()) {
+    active_.push_back(std::move(queue_.front()));
+    queue_.pop_front();
+  }
+}
+
+void BatchScheduler::workerLoop() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    if (active_.empty()) {
+      cv_.wait(lock, [this] { return stopped_ || !queue_.empty(); });
+      if (queue_.empty()) {
+        return; // stopped and drained
+      }
+      // Coalescing window: hold the batch open for batchmates until the
+      // oldest queued request's latency deadline, or until the batch fills.
+      const auto deadline = queue_.front()->arrival + options_.maxBatchDelay;
+      cv_.wait_until(lock, deadline, [this] {
+        return stopped_ || queue_.size() >= options_.maxBatchSize;
+      });
+    }
+    // With a decode in flight there's no waiting: queued requests join the
+    // active batch here, between steps -- at token boundaries.
+    admitQueued();
+    if (active_.empty()) {
+      continue;
+    }
+
+    std::vector<Slot> batch;
+    batch.reserve(active_.size());
+    for (auto& request : active_) {
+      batch.push_back(Slot(request.get()));
+    }
+    // step outside the lock so enqueue isn't blocked on model execution;
+    // active_ is only touched by this thread
+    lock.unlock();
+    try {
+      step_(batch);
+      for (auto& request : active_) {
+        if (request->done) {
+          request->promise.set_value(std::move(request->output));
+        }
+      }
+      active_.erase(
+          std::remove_if(
+              active_.begin(),
+              active_.end(),
+              [](const std::unique_ptr<Slot::Request>& request) {
+                return request->done;
+              }),
+          active_.end());
+    } catch (...) {
+      // a failed step fails every request in the batch; the scheduler
+      // itself stays up for subsequent batches
+      for (auto& request : active_) {
+        request->promise.set_exception(std::current_exception());
+      }
+      active_.clear();
+    }
+    lock.lock();
+  }
+}
+
+} // namespace runtime
+} // namespace pkg
+} // namespace fl
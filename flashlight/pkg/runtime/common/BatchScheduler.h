@@ -0,0 +1,132 @@
+/**
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "flashlight/fl/flashlight.h"
+
+namespace fl {
+namespace pkg {
+namespace runtime {
+
+/**
+ * A continuous-batching request scheduler for model serving.
+ *
+ * Callers enqueue requests and get futures back; a worker thread coalesces
+ * queued requests into batches and drives a caller-supplied step function
+ * over the active batch. Two knobs trade latency against throughput:
+ * requests wait at most `maxBatchDelay` for batchmates before a batch
+ * launches (the latency deadline), and batches never exceed `maxBatchSize`.
+ *
+ * The step function advances every active request by one step and marks
+ * requests that finished. For one-shot models, the step function finishes
+ * every slot on its first step and the scheduler degenerates to deadline
+ * batching. For autoregressive decode, the step function keeps per-request
+ * state across steps (tokens emitted so far, hidden state) and the scheduler
+ * admits queued requests into the active batch *between* steps - at token
+ * boundaries - so a long decode doesn't block newcomers for its full length
+ * and freed batch slots are refilled instead of draining. A decoder's
+ * step routine (e.g. a criterion's `decodeStep`) wraps directly into a
+ * `StepFunction`.
+ */
+class BatchScheduler {
+ public:
+  struct Options {
+    /// Upper bound on the active batch size
+    size_t maxBatchSize{8};
+    /// How long a queued request may wait for batchmates before launch
+    std::chrono::milliseconds maxBatchDelay{5};
+  };
+
+  /**
+   * One active request as seen by the step function. Valid only for the
+   * duration of the step call.
+   */
+  class Slot {
+   public:
+    /// The request's input, as passed to `enqueue`.
+    const std::vector<Tensor>& input() const;
+    /// Per-request scratch owned by the step function; empty on the
+    /// request's first step, persists across steps until it finishes.
+    std::vector<Tensor>& state();
+    /// Completes the request: its future is fulfilled with `output` after
+    /// the step returns, and its slot is freed for a queued request.
+    void finish(std::vector<Tensor> output);
+    /// Whether `finish` has been called for this request.
+    bool finished() const;
+
+   private:
+    friend class BatchScheduler;
+    struct Request;
+    explicit Slot(Request* request) : request_(request) {}
+    Request* request_;
+  };
+
+  /**
+   * Advances every slot in the active batch by one step, calling
+   * `Slot::finish` on those that completed. Runs on the scheduler's worker
+   * thread.
+   */
+  using StepFunction = std::function<void(std::vector<Slot>& batch)>;
+
+  /**
+   * Creates a scheduler and starts its worker thread.
+   *
+   * @param[in] step the batch step function.
+   * @param[in] options batching knobs.
+   */
+  explicit BatchScheduler(StepFunction step, Options options = Options());
+
+  /**
+   * Stops the scheduler, draining already-enqueued requests first.
+   */
+  ~BatchScheduler();
+
+  /**
+   * Enqueues a request. Returns a future fulfilled with the output the step
+   * function passed to `Slot::finish`, or carrying the step function's
+   * exception if the request's batch step threw. Thread safe; throws
+   * `std::runtime_error` after `stop`.
+   */
+  std::future<std::vector<Tensor>> enqueue(std::vector<Tensor> input);
+
+  /**
+   * Stops accepting requests, drains everything already enqueued, and joins
+   * the worker thread. Called by the destructor; safe to call repeatedly.
+   */
+  void stop();
+
+ private:
+  void workerLoop();
+  // moves queued requests into the active batch up to maxBatchSize; caller
+  // holds mutex_
+  void admitQueued();
+
+  const StepFunction step_;
+  const Options options_;
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::deque<std::unique_ptr<Slot::Request>> queue_;
+  std::vector<std::unique_ptr<Slot::Request>> active_;
+  bool stopped_{false};
+  std::thread worker_;
+};
+
+} // namespace runtime
+} // namespace pkg
+} // namespace fl
@@ -0,0 +1,155 @@
+/**
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "flashlight/pkg/runtime/common/IncrementalCheckpointer.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+
+namespace fl {
+namespace pkg {
+namespace runtime {
+
+namespace {
+
+constexpr const char* kManifestName = "manifest.bin";
+constexpr const char* kChunkDirName = "chunks";
+
+// 64-bit FNV-1a; cheap, dependency-free, and collision-safe enough for
+// dedup within one model's checkpoint lineage
+uint64_t hashChunk(const uint8_t* data, size_t size) {
+  uint64_t hash = 0xcbf29ce484222325ULL;
+  for (size_t i = 0; i < size; ++i) {
+    hash ^= data[i];
+    hash *= 0x100000001b3ULL;
+  }
+  return hash;
+}
+
+void writeFile(const fs::path& path, const uint8_t* data, size_t size) {
+  std::ofstream file(path, std::ios::binary);
+  if (!file) {
+    throw std::runtime_error(
+        "IncrementalCheckpointer - failed to open for writing: " +
+        path.string());
+  }
+  file.write(reinterpret_cast<const char*>(data), size);
+  if (!file) {
+    throw std::runtime_error(
+        "IncrementalCheckpointer - failed to write: " + path.string());
+  }
+}
+
+void readFile(const fs::path& path, uint8_t* data, size_t size) {
+  std::ifstream file(path, std::ios::binary);
+  if (!file) {
+    throw std::runtime_error(
+        "IncrementalCheckpointer - missing chunk: " + path.string());
+  }
+  file.read(reinterpret_cast<char*>(data), size);
+  if (file.gcount() != static_cast<std::streamsize>(size)) {
+    throw std::runtime_error(
+        "IncrementalCheckpointer - truncated chunk: " + path.string());
+  }
+}
+
+} // namespace
+
+IncrementalCheckpointer::IncrementalCheckpointer(
+    fs::path directory,
+    size_t chunkBytes /* = 1 << 20 */)
+    : directory_(std::move(directory)),
+      chunkDirectory_(directory_ / kChunkDirName),
+      manifestPath_(directory_ / kManifestName),
+      chunkBytes_(chunkBytes) {
+  if (chunkBytes_ == 0) {
+    throw std::invalid_argument(
+        "IncrementalCheckpointer - chunkBytes must be positive");
+  }
+  fs::create_directories(chunkDirectory_);
+}
+
+fs::path IncrementalCheckpointer::chunkPath(uint64_t hash) const {
+  std::ostringstream name;
+  name << std::hex << std::setw(16) << std::setfill('0') << hash << ".bin";
+  return chunkDirectory_ / name.str();
+}
+
+void IncrementalCheckpointer::save(const std::vector<fl::Variable>& params) {
+  std::vector<Shape> shapes;
+  std::vector<int> types;
+  std::vector<std::vector<uint64_t>> chunkHashes;
+  shapes.reserve(params.size());
+  types.reserve(params.size());
+  chunkHashes.reserve(params.size());
+
+  std::vector<uint8_t> buffer;
+  for (const auto& param : params) {
+    const auto& tensor = param.tensor();
+    shapes.push_back(tensor.shape());
+    types.push_back(static_cast<int>(tensor.type()));
+
+    buffer.resize(tensor.bytes());
+    tensor.host(buffer.data());
+
+    std::vector<uint64_t> hashes;
+    for (size_t offset = 0; offset < buffer.size(); offset += chunkBytes_) {
+      const size_t size = std::min(chunkBytes_, buffer.size() - offset);
+      const uint64_t hash = hashChunk(buffer.data() + offset, size);
+      if (knownChunks_.insert(hash).second) {
+        const auto path = chunkPath(hash);
+        if (!fs::exists(path)) {
+          writeFile(path, buffer.data() + offset, size);
+        }
+      }
+      hashes.push_back(hash);
+    }
+    chunkHashes.push_back(std::move(hashes));
+  }
+
+  // write-then-rename so a crash mid-checkpoint leaves the previous manifest
+  // (and its chunks, which are never overwritten) intact
+  const auto tmpPath = manifestPath_.string() + ".tmp";
+  fl::save(tmpPath, shapes, types, chunkHashes, chunkBytes_);
+  fs::rename(tmpPath, manifestPath_);
+}
+
+std::vector<fl::Tensor> IncrementalCheckpointer::load() const {
+  std::vector<Shape> shapes;
+  std::vector<int> types;
+  std::vector<std::vector<uint64_t>> chunkHashes;
+  size_t chunkBytes;
+  fl::load(manifestPath_.string(), shapes, types, chunkHashes, chunkBytes);
+
+  std::vector<fl::Tensor> tensors;
+  tensors.reserve(shapes.size());
+  std::vector<uint8_t> buffer;
+  for (size_t i = 0; i < shapes.size(); ++i) {
+    const auto type = static_cast<fl::dtype>(types[i]);
+    const size_t bytes = shapes[i].elements() * fl::getTypeSize(type);
+    buffer.resize(bytes);
+    for (size_t c = 0; c < chunkHashes[i].size(); ++c) {
+      const size_t offset = c * chunkBytes;
+      const size_t size = std::min(chunkBytes, bytes - offset);
+      readFile(chunkPath(chunkHashes[i][c]), buffer.data() + offset, size);
+    }
+    tensors.push_back(
+        Tensor::fromBuffer(shapes[i], type, buffer.data(), Location::Host));
+  }
+  return tensors;
+}
+
+bool IncrementalCheckpointer::hasCheckpoint() const {
+  return fs::exists(manifestPath_);
+}
+
+} // namespace runtime
+} // namespace pkg
+} // namespace fl
@@ -0,0 +1,90 @@
+/**
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "flashlight/fl/common/Filesystem.h"
+#include "flashlight/fl/flashlight.h"
+
+namespace fl {
+namespace pkg {
+namespace runtime {
+
+/**
+ * A content-addressed, chunked checkpoint store for model parameters.
+ *
+ * `fl::save` rewrites the full parameter payload at every checkpoint even
+ * when almost none of it changed. An `IncrementalCheckpointer` instead splits
+ * each parameter into fixed-size chunks, hashes them, and writes only chunks
+ * whose hash has not been stored yet; a small manifest records, per
+ * parameter, its shape, type and chunk hashes. Checkpoint cost is therefore
+ * proportional to the bytes that actually changed, and successive
+ * checkpoints share unchanged chunks on disk.
+ *
+ * \code
+ * IncrementalCheckpointer checkpointer(checkpointDir);
+ * // each save writes only the chunks that changed since the last one
+ * checkpointer.save(model->params());
+ * // ...
+ * auto tensors = checkpointer.load();
+ * for (int i = 0; i < tensors.size(); ++i) {
+ *   model->setParams(Variable(tensors[i], true), i);
+ * }
+ * \endcode
+ *
+ * Chunks from superseded checkpoints are not garbage collected; prune the
+ * chunk directory offline if disk usage matters. Not thread safe.
+ */
+class IncrementalCheckpointer {
+ public:
+  /**
+   * @param[in] directory where the manifest and chunk store live; created if
+   * missing. Reusing the directory of a previous run dedupes against its
+   * chunks.
+   * @param[in] chunkBytes chunk size; smaller chunks dedupe better but cost
+   * more hashing and more files.
+   */
+  explicit IncrementalCheckpointer(
+      fs::path directory,
+      size_t chunkBytes = 1 << 20);
+
+  /**
+   * Checkpoint the given parameters, writing only chunks not already in the
+   * store, then atomically replace the manifest.
+   */
+  void save(const std::vector<fl::Variable>& params);
+
+  /**
+   * Restore the parameter tensors of the last `save` from the manifest and
+   * chunk store.
+   */
+  std::vector<fl::Tensor> load() const;
+
+  /**
+   * Whether the directory holds a complete checkpoint to `load` from.
+   */
+  bool hasCheckpoint() const;
+
+ private:
+  fs::path chunkPath(uint64_t hash) const;
+
+  fs::path directory_;
+  fs::path chunkDirectory_;
+  fs::path manifestPath_;
+  size_t chunkBytes_;
+  // hashes known to be present in the chunk store, to skip filesystem checks
+  std::unordered_set<uint64_t> knownChunks_;
+};
+
+} // namespace runtime
+} // namespace pkg
+} // namespace fl
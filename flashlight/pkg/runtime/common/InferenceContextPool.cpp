@@ -0,0 +1,110 @@
+/**
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "flashlight/pkg/runtime/common/InferenceContextPool.h"
+
+#include <stdexcept>
+
+namespace fl {
+namespace pkg {
+namespace runtime {
+
+InferenceContextPool::InferenceContextPool(std::shared_ptr<fl::Module> model)
+    : model_(std::move(model)) {
+  if (!model_) {
+    throw std::invalid_argument(
+        "InferenceContextPool::InferenceContextPool - model is null");
+  }
+  // also disables gradient calculation on the shared parameters, which all
+  // replicas inherit
+  model_->eval();
+}
+
+std::shared_ptr<fl::Module> InferenceContextPool::get() {
+  const auto id = std::this_thread::get_id();
+  while (true) {
+    std::shared_ptr<fl::Module> source;
+    size_t epoch;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto it = replicas_.find(id);
+      if (it != replicas_.end()) {
+        return it->second;
+      }
+      source = model_;
+      epoch = epoch_;
+    }
+    // built outside the lock: cloning a large model isn't cheap, and other
+    // threads shouldn't wait on it
+    auto replica = makeReplica(source);
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (epoch == epoch_) {
+      return replicas_.emplace(id, std::move(replica)).first->second;
+    }
+    // a swap was published while the replica was being built; rebuild on
+    // the new version rather than serving the stale one
+  }
+}
+
+void InferenceContextPool::setParams(std::vector<fl::Variable> params) {
+  std::shared_ptr<fl::Module> source;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    source = model_;
+  }
+  if (static_cast<int>(params.size()) != source->numParamTensors()) {
+    throw std::invalid_argument(
+        "InferenceContextPool::setParams - expected " +
+        std::to_string(source->numParamTensors()) + " parameters, got " +
+        std::to_string(params.size()));
+  }
+  // Materialize the incoming weights on the device before publishing, so
+  // the upload overlaps ongoing traffic instead of stalling the first
+  // request on the new version
+  for (auto& p : params) {
+    fl::eval(p.tensor());
+  }
+  // The new version lives on a private clone; the model passed at
+  // construction (and replicas still in flight) are untouched
+  auto next = source->clone();
+  for (size_t i = 0; i < params.size(); ++i) {
+    next->setParams(fl::Variable(params[i].tensor(), false), i);
+  }
+  next->eval();
+  std::lock_guard<std::mutex> lock(mutex_);
+  model_ = std::move(next);
+  // threads re-clone lazily on their next get(); outstanding shared_ptrs
+  // keep the old replicas - and the old weights - alive until released
+  replicas_.clear();
+  ++epoch_;
+}
+
+size_t InferenceContextPool::epoch() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return epoch_;
+}
+
+size_t InferenceContextPool::size() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return replicas_.size();
+}
+
+std::shared_ptr<fl::Module> InferenceContextPool::makeReplica(
+    const std::shared_ptr<fl::Module>& source) {
+  std::shared_ptr<fl::Module> replica = source->clone();
+  // rebind the clone's deep parameter copies to the source model's Variables
+  // so the weights stay shared; setParams recurses into container children
+  for (int i = 0; i < source->numParamTensors(); ++i) {
+    replica->setParams(source->param(i), i);
+  }
+  replica->eval();
+  return replica;
+}
+
+} // namespace runtime
+} // namespace pkg
+} // namespace fl
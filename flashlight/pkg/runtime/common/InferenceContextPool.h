@@ -0,0 +1,106 @@
+/**
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+#include "flashlight/fl/flashlight.h"
+
+namespace fl {
+namespace pkg {
+namespace runtime {
+
+/**
+ * Serves one loaded model from many threads without loading it once per
+ * thread.
+ *
+ * Running a single `Module` concurrently is unsafe: the `train_` flag and any
+ * module-held state are shared across callers. The pool instead hands each
+ * thread its own replica of the module - same structure, own flags and
+ * buffers - whose parameters are the *shared* `Variable`s of the source
+ * model, so all replicas read one resident copy of the weights instead of N
+ * copies costing (N-1) x the model size in device memory.
+ *
+ * The source model and every replica are switched to eval mode with gradient
+ * calculation disabled on the shared parameters; replicas are for inference
+ * only, and the shared weights must not be mutated while the pool is in use.
+ * Backend execution state is already per-thread (the cuDNN handle and its
+ * stream are thread-local), so forwards from different threads don't contend
+ * on a handle.
+ *
+ * \code
+ * InferenceContextPool pool(model);
+ * // on each serving thread:
+ * auto output = pool.get()->forward({input});
+ * \endcode
+ */
+class InferenceContextPool {
+ public:
+  /**
+   * Creates a pool serving `model`. Puts the model in eval mode; replicas
+   * are created lazily per thread by `get`.
+   *
+   * @param[in] model the model to serve. Must outlive the pool.
+   */
+  explicit InferenceContextPool(std::shared_ptr<fl::Module> model);
+
+  /**
+   * Returns the calling thread's replica, creating it on first use. Creation
+   * clones the module then rebinds every parameter to the source model's
+   * `Variable`s, so the clone's deep parameter copies are freed immediately -
+   * steady-state weight memory is one resident copy regardless of thread
+   * count. The returned module must only be used from the calling thread.
+   */
+  std::shared_ptr<fl::Module> get();
+
+  /**
+   * Replaces the weights served by the pool without pausing serving.
+   *
+   * The incoming tensors are materialized on the device first, so the upload
+   * overlaps ongoing traffic and the first request on the new version doesn't
+   * pay for it; the swap then publishes a new version. Threads calling `get`
+   * afterwards are handed replicas bound to the new weights, while forwards
+   * already running keep the replica - and through it the weight version -
+   * they started with, until they drop it. No draining is needed; the old
+   * weights are freed when the last in-flight holder releases its replica.
+   * The new version lives on a private clone - the model passed at
+   * construction is not mutated.
+   *
+   * @param[in] params the new parameter tensors, in `Module::param` order.
+   * Must match the served model's parameter count.
+   */
+  void setParams(std::vector<fl::Variable> params);
+
+  /**
+   * Returns the number of weight versions published by `setParams` so far.
+   */
+  size_t epoch() const;
+
+  /**
+   * Returns the number of thread replicas created so far.
+   */
+  size_t size() const;
+
+ private:
+  static std::shared_ptr<fl::Module> makeReplica(
+      const std::shared_ptr<fl::Module>& source);
+
+  std::shared_ptr<fl::Module> model_;
+  mutable std::mutex mutex_;
+  std::unordered_map<std::thread::id, std::shared_ptr<fl::Module>> replicas_;
+  // bumped by setParams; get() discards replicas built against a version
+  // that was swapped out while they were being cloned
+  size_t epoch_{0};
+};
+
+} // namespace runtime
+} // namespace pkg
+} // namespace fl
@@ -0,0 +1,201 @@
+/**
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "flashlight/pkg/runtime/common/MemoryMappedModel.h"
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace fl {
+namespace pkg {
+namespace runtime {
+
+namespace {
+
+constexpr char kMagic[8] = {'F', 'L', 'M', 'M', 'A', 'P', '0', '1'};
+constexpr size_t kPayloadAlignment = 64;
+
+size_t alignUp(size_t value, size_t alignment) {
+  return (value + alignment - 1) / alignment * alignment;
+}
+
+template <typename T>
+void writeScalar(std::ostream& os, T value) {
+  os.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+T readScalar(const uint8_t*& cursor, const uint8_t* end) {
+  if (cursor + sizeof(T) > end) {
+    throw std::runtime_error("MemoryMappedModel - truncated header");
+  }
+  T value;
+  std::memcpy(&value, cursor, sizeof(T));
+  cursor += sizeof(T);
+  return value;
+}
+
+} // namespace
+
+void saveMemoryMapped(
+    const fs::path& filepath,
+    const std::vector<fl::Variable>& params) {
+  std::ofstream file(filepath, std::ios::binary);
+  if (!file) {
+    throw std::runtime_error(
+        "saveMemoryMapped - failed to open for writing: " + filepath.string());
+  }
+
+  // header size: magic + count + per tensor (type, ndim, dims, offset, bytes)
+  size_t headerBytes = sizeof(kMagic) + sizeof(uint64_t);
+  for (const auto& param : params) {
+    headerBytes += 2 * sizeof(int32_t) +
+        param.shape().ndim() * sizeof(int64_t) + 2 * sizeof(uint64_t);
+  }
+
+  file.write(kMagic, sizeof(kMagic));
+  writeScalar<uint64_t>(file, params.size());
+
+  size_t offset = alignUp(headerBytes, kPayloadAlignment);
+  for (const auto& param : params) {
+    const auto& tensor = param.tensor();
+    writeScalar<int32_t>(file, static_cast<int32_t>(tensor.type()));
+    writeScalar<int32_t>(file, tensor.ndim());
+    for (int axis = 0; axis < tensor.ndim(); ++axis) {
+      writeScalar<int64_t>(file, tensor.dim(axis));
+    }
+    writeScalar<uint64_t>(file, offset);
+    writeScalar<uint64_t>(file, tensor.bytes());
+    offset = alignUp(offset + tensor.bytes(), kPayloadAlignment);
+  }
+
+  std::vector<uint8_t> buffer;
+  size_t written = headerBytes;
+  for (const auto& param : params) {
+    const auto& tensor = param.tensor();
+    const std::vector<char> padding(
+        alignUp(written, kPayloadAlignment) - written, 0);
+    file.write(padding.data(), padding.size());
+    buffer.resize(tensor.bytes());
+    tensor.host(buffer.data());
+    file.write(reinterpret_cast<const char*>(buffer.data()), buffer.size());
+    written = alignUp(written, kPayloadAlignment) + tensor.bytes();
+  }
+  if (!file) {
+    throw std::runtime_error(
+        "saveMemoryMapped - failed to write: " + filepath.string());
+  }
+}
+
+MemoryMappedModel::MemoryMappedModel(const fs::path& filepath) {
+#ifdef _WIN32
+  throw std::runtime_error("MemoryMappedModel - not supported on Windows");
+#else
+  fd_ = ::open(filepath.c_str(), O_RDONLY);
+  if (fd_ < 0) {
+    throw std::runtime_error(
+        "MemoryMappedModel - failed to open: " + filepath.string());
+  }
+  struct stat fileStat;
+  if (::fstat(fd_, &fileStat) != 0) {
+    ::close(fd_);
+    fd_ = -1;
+    throw std::runtime_error(
+        "MemoryMappedModel - failed to stat: " + filepath.string());
+  }
+  mappingBytes_ = fileStat.st_size;
+  mapping_ = ::mmap(nullptr, mappingBytes_, PROT_READ, MAP_SHARED, fd_, 0);
+  if (mapping_ == MAP_FAILED) {
+    ::close(fd_);
+    fd_ = -1;
+    mapping_ = nullptr;
+    throw std::runtime_error(
+        "MemoryMappedModel - failed to mmap: " + filepath.string());
+  }
+
+  const auto* base = static_cast<const uint8_t*>(mapping_);
+  const auto* end = base + mappingBytes_;
+  const uint8_t* cursor = base;
+  if (mappingBytes_ < sizeof(kMagic) ||
+      std::memcmp(cursor, kMagic, sizeof(kMagic)) != 0) {
+    throw std::runtime_error(
+        "MemoryMappedModel - not a memory-mapped model file: " +
+        filepath.string());
+  }
+  cursor += sizeof(kMagic);
+
+  const auto count = readScalar<uint64_t>(cursor, end);
+  entries_.reserve(count);
+  for (uint64_t i = 0; i < count; ++i) {
+    Entry entry;
+    entry.type = static_cast<fl::dtype>(readScalar<int32_t>(cursor, end));
+    const auto ndim = readScalar<int32_t>(cursor, end);
+    std::vector<Dim> dims(ndim);
+    for (int32_t axis = 0; axis < ndim; ++axis) {
+      dims[axis] = readScalar<int64_t>(cursor, end);
+    }
+    entry.shape = Shape(dims);
+    entry.offset = readScalar<uint64_t>(cursor, end);
+    entry.bytes = readScalar<uint64_t>(cursor, end);
+    if (entry.offset + entry.bytes > mappingBytes_) {
+      throw std::runtime_error(
+          "MemoryMappedModel - payload out of bounds: " + filepath.string());
+    }
+    entries_.push_back(std::move(entry));
+  }
+#endif
+}
+
+MemoryMappedModel::~MemoryMappedModel() {
+#ifndef _WIN32
+  if (mapping_ != nullptr) {
+    ::munmap(mapping_, mappingBytes_);
+  }
+  if (fd_ >= 0) {
+    ::close(fd_);
+  }
+#endif
+}
+
+size_t MemoryMappedModel::numTensors() const {
+  return entries_.size();
+}
+
+const Shape& MemoryMappedModel::shape(size_t index) const {
+  return entries_.at(index).shape;
+}
+
+fl::dtype MemoryMappedModel::type(size_t index) const {
+  return entries_.at(index).type;
+}
+
+const void* MemoryMappedModel::data(size_t index) const {
+  const auto& entry = entries_.at(index);
+  return static_cast<const uint8_t*>(mapping_) + entry.offset;
+}
+
+fl::Tensor MemoryMappedModel::tensor(size_t index) const {
+  const auto& entry = entries_.at(index);
+  return Tensor::fromBuffer(
+      entry.shape,
+      entry.type,
+      static_cast<const uint8_t*>(data(index)),
+      Location::Host);
+}
+
+} // namespace runtime
+} // namespace pkg
+} // namespace fl
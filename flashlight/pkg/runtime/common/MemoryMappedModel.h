@@ -0,0 +1,99 @@
+/**
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "flashlight/fl/common/Filesystem.h"
+#include "flashlight/fl/flashlight.h"
+
+namespace fl {
+namespace pkg {
+namespace runtime {
+
+/**
+ * Write model parameters in the memory-mappable format: a fixed header
+ * describing each tensor (type, shape, payload offset) followed by raw,
+ * 64-byte-aligned tensor payloads in host byte order. Unlike
+ * `Serializer::save`, the result can be consumed by `MemoryMappedModel`
+ * without parsing an archive or staging the whole payload through fresh
+ * allocations.
+ *
+ * The format is host-endian and carries no module structure — pair it with
+ * the usual serialized module for architecture, or rebuild parameters into a
+ * programmatically-constructed module via `Module::setParams`.
+ */
+void saveMemoryMapped(
+    const fs::path& filepath,
+    const std::vector<fl::Variable>& params);
+
+/**
+ * A model parameter file mapped into memory. The file's pages back all
+ * replicas on a host through one page-cache copy, and are only faulted in as
+ * tensors are actually constructed — so cold starts cost milliseconds of
+ * header parsing rather than a full deserialization pass, and RSS does not
+ * double while loading.
+ *
+ * \code
+ * MemoryMappedModel model(modelPath);
+ * for (size_t i = 0; i < model.numTensors(); ++i) {
+ *   module->setParams(Variable(model.tensor(i), false), i);
+ * }
+ * \endcode
+ */
+class MemoryMappedModel {
+ public:
+  explicit MemoryMappedModel(const fs::path& filepath);
+  ~MemoryMappedModel();
+  MemoryMappedModel(const MemoryMappedModel&) = delete;
+  MemoryMappedModel& operator=(const MemoryMappedModel&) = delete;
+
+  /**
+   * The number of tensors in the file.
+   */
+  size_t numTensors() const;
+
+  /**
+   * The shape of the tensor at the given index.
+   */
+  const Shape& shape(size_t index) const;
+
+  /**
+   * The type of the tensor at the given index.
+   */
+  fl::dtype type(size_t index) const;
+
+  /**
+   * A pointer to the tensor's payload inside the mapped pages, 64-byte
+   * aligned — for zero-copy consumers; valid for the lifetime of this object.
+   */
+  const void* data(size_t index) const;
+
+  /**
+   * Construct a backend tensor for the given index from the mapped pages.
+   */
+  fl::Tensor tensor(size_t index) const;
+
+ private:
+  struct Entry {
+    Shape shape;
+    fl::dtype type;
+    size_t offset;
+    size_t bytes;
+  };
+
+  std::vector<Entry> entries_;
+  void* mapping_{nullptr};
+  size_t mappingBytes_{0};
+  int fd_{-1};
+};
+
+} // namespace runtime
+} // namespace pkg
+} // namespace fl
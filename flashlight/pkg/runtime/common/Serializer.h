@@ -8,6 +8,10 @@
 #pragma once
 
 #include <chrono>
+#include <fstream>
+#include <future>
+#include <memory>
+#include <sstream>
 #include <string>
 #include <unordered_map>
 
@@ -35,6 +39,52 @@ struct Serializer {
         args...); // max wait 31s
   }
 
+  /**
+   * Save a checkpoint without blocking the training loop on the disk write.
+   * The arguments are serialized to host memory synchronously -- so the
+   * caller only pays the device-to-host copy and may keep mutating the
+   * parameters immediately afterwards -- and the file write (with the same
+   * retry policy as `save`) happens on a background thread. At most one
+   * write is in flight: a new `saveAsync` first waits for the previous one,
+   * bounding memory at two checkpoint-sized host buffers. Call
+   * `waitForAsyncSave` before reading the file or exiting; write errors from
+   * the previous checkpoint are rethrown there and from the next `saveAsync`.
+   * Not thread safe.
+   */
+  template <class... Args>
+  static void saveAsync(
+      const fs::path& filepath,
+      const std::string& version,
+      const Args&... args) {
+    waitForAsyncSave();
+    // snapshot to host memory; this is the only part the train loop pays
+    auto data = std::make_shared<std::string>();
+    {
+      std::ostringstream oss(std::ios::binary);
+      fl::save(oss, version, args...);
+      *data = oss.str();
+    }
+    asyncWrite() = std::async(std::launch::async, [filepath, data]() {
+      fl::retryWithBackoff(
+          std::chrono::seconds(1),
+          2.0,
+          6,
+          writeImpl,
+          filepath,
+          data); // max wait 31s
+    });
+  }
+
+  /**
+   * Block until the write from the last `saveAsync` (if any) has finished,
+   * rethrowing any error it hit.
+   */
+  static void waitForAsyncSave() {
+    if (asyncWrite().valid()) {
+      asyncWrite().get();
+    }
+  }
+
   template <typename... Args>
   static void load(const fs::path& filepath, Args&... args) {
     fl::retryWithBackoff(
@@ -47,20 +97,43 @@ struct Serializer {
   }
 
  private:
-  template <typename... Args>
-  static void saveImpl(
+  // the (at most one) in-flight background checkpoint write
+  static std::future<void>& asyncWrite() {
+    static std::future<void> future;
+    return future;
+  }
+
+  static void writeImpl(
       const fs::path& filepath,
-      const std::string& version,
-      const Args&... args) {
+      const std::shared_ptr<std::string>& data) {
     try {
       std::ofstream file(filepath, std::ios::binary);
       if (!file.is_open()) {
         throw std::runtime_error(
             "failed to open file for writing: " + filepath.string());
       }
-      cereal::BinaryOutputArchive ar(file);
-      ar(version);
-      ar(args...);
+      file.write(data->data(), data->size());
+      if (!file) {
+        throw std::runtime_error(
+            "failed to write file: " + filepath.string());
+      }
+    } catch (const std::exception& ex) {
+      FL_LOG(fl::LogLevel::ERROR)
+          << "Error while saving \"" << filepath << "\": " << ex.what() << "\n";
+      throw;
+    }
+  }
+
+  template <typename... Args>
+  static void saveImpl(
+      const fs::path& filepath,
+      const std::string& version,
+      const Args&... args) {
+    try {
+      // stage the archive in a reused memory arena and write the file in one
+      // go; much faster than archiving straight into an ofstream for large
+      // models
+      fl::saveFast(filepath, version, args...);
     } catch (const std::exception& ex) {
       FL_LOG(fl::LogLevel::ERROR)
           << "Error while saving \"" << filepath << "\": " << ex.what() << "\n";
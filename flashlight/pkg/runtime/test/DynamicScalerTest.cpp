@@ -5,6 +5,8 @@
  * LICENSE file in the root directory of this source tree.
  */
 
+#include <limits>
+
 #include <gtest/gtest.h>
 
 #include "flashlight/pkg/runtime/amp/DynamicScaler.h"
@@ -34,6 +36,47 @@ TEST(DynamicScalerTest, Scaling) {
   ASSERT_TRUE(allClose(loss, scaledLoss.grad()));
 }
 
+TEST(DynamicScalerTest, UnscaleAsync) {
+  auto dynamicScaler = fl::pkg::runtime::DynamicScaler(
+      32, // initFactor
+      32, // maxFactor
+      100 // updateInterval
+  );
+
+  // Clean step: gradients come back unscaled; the first call has no prior
+  // flag to act on
+  auto loss = fl::uniform({5, 5});
+  auto scaledLoss = dynamicScaler.scale(loss);
+  scaledLoss.addGrad(scaledLoss);
+  std::vector<fl::Variable> params{scaledLoss};
+  ASSERT_TRUE(dynamicScaler.unscaleAsync(params));
+  ASSERT_TRUE(allClose(loss, scaledLoss.grad()));
+  ASSERT_EQ(dynamicScaler.getScaleFactor(), 32);
+
+  // Overflowing step: every gradient is zeroed on the device, so the
+  // optimizer step is a null update; the call still reports the previous
+  // (clean) step and the scale factor is untouched for now
+  auto bad = fl::Variable(fl::full({3}, 1.0f), true);
+  bad.addGrad(fl::Variable(
+      fl::full({3}, std::numeric_limits<float>::infinity()), false));
+  auto good = fl::Variable(fl::full({3}, 1.0f), true);
+  good.addGrad(fl::Variable(fl::full({3}, 32.0f), false));
+  std::vector<fl::Variable> overflowing{bad, good};
+  ASSERT_TRUE(dynamicScaler.unscaleAsync(overflowing));
+  ASSERT_TRUE(allClose(good.grad().tensor(), fl::full({3}, 0.0f)));
+  ASSERT_EQ(dynamicScaler.getScaleFactor(), 32);
+
+  // One step later the flag resolves: the overflow is reported and the
+  // scale factor halves. This step's own gradients were unscaled with the
+  // factor in effect when its loss was scaled.
+  auto clean = fl::Variable(fl::full({3}, 1.0f), true);
+  clean.addGrad(fl::Variable(fl::full({3}, 16.0f), false));
+  std::vector<fl::Variable> next{clean};
+  ASSERT_FALSE(dynamicScaler.unscaleAsync(next));
+  ASSERT_TRUE(allClose(clean.grad().tensor(), fl::full({3}, 0.5f)));
+  ASSERT_EQ(dynamicScaler.getScaleFactor(), 16);
+}
+
 TEST(DynamicScalerTest, Serialization) {
   auto dynamicScaler = std::make_shared<fl::pkg::runtime::DynamicScaler>(
       32, // initFactor
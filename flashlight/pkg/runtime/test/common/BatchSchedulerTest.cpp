@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "flashlight/fl/flashlight.h"
+#include "flashlight/pkg/runtime/common/BatchScheduler.h"
+
+using fl::pkg::runtime::BatchScheduler;
+
+TEST(BatchSchedulerTest, OneShotRequests) {
+  // one-shot model: every request finishes on its first step
+  // written only on the worker thread; reads are ordered by future::get
+  size_t maxBatch = 0;
+  BatchScheduler::Options options;
+  options.maxBatchSize = 4;
+  BatchScheduler scheduler(
+      [&maxBatch](std::vector<BatchScheduler::Slot>& batch) {
+        maxBatch = std::max(maxBatch, batch.size());
+        for (auto& slot : batch) {
+          slot.finish({slot.input().front() * 2});
+        }
+      },
+      options);
+
+  constexpr int numRequests = 16;
+  std::vector<std::future<std::vector<fl::Tensor>>> futures;
+  for (int i = 0; i < numRequests; ++i) {
+    futures.push_back(scheduler.enqueue({fl::full({1}, (float)i)}));
+  }
+  for (int i = 0; i < numRequests; ++i) {
+    auto output = futures[i].get();
+    ASSERT_EQ(output.size(), 1);
+    ASSERT_FLOAT_EQ(output.front().asScalar<float>(), 2.f * i);
+  }
+  ASSERT_LE(maxBatch, options.maxBatchSize);
+}
+
+TEST(BatchSchedulerTest, AutoregressiveJoinsInFlight) {
+  // each request decodes for as many steps as its input value, accumulating
+  // a running count in per-request state
+  std::atomic<int> stepsRun(0);
+  // written only on the worker thread; reads are ordered by future::get
+  size_t maxBatch = 0;
+  BatchScheduler::Options options;
+  options.maxBatchSize = 4;
+  BatchScheduler scheduler(
+      [&stepsRun, &maxBatch](std::vector<BatchScheduler::Slot>& batch) {
+        ++stepsRun;
+        maxBatch = std::max(maxBatch, batch.size());
+        for (auto& slot : batch) {
+          if (slot.state().empty()) {
+            slot.state().push_back(fl::full({1}, 0.f));
+          }
+          slot.state().front() = slot.state().front() + 1;
+          if (slot.state().front().asScalar<float>() >=
+              slot.input().front().asScalar<float>()) {
+            slot.finish({slot.state().front()});
+          }
+        }
+      },
+      options);
+
+  // a long decode occupies the batch...
+  auto longRequest = scheduler.enqueue({fl::full({1}, 200.f)});
+  while (stepsRun.load() < 5) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  // ...and a newcomer joins it at a step boundary instead of waiting
+  auto shortRequest = scheduler.enqueue({fl::full({1}, 3.f)});
+  ASSERT_FLOAT_EQ(shortRequest.get().front().asScalar<float>(), 3.f);
+  ASSERT_FLOAT_EQ(longRequest.get().front().asScalar<float>(), 200.f);
+  ASSERT_GE(maxBatch, 2);
+}
+
+TEST(BatchSchedulerTest, StepExceptionFailsBatch) {
+  BatchScheduler scheduler([](std::vector<BatchScheduler::Slot>&) {
+    throw std::runtime_error("step failed");
+  });
+  auto future = scheduler.enqueue({fl::full({1}, 1.f)});
+  EXPECT_THROW(future.get(), std::runtime_error);
+}
+
+TEST(BatchSchedulerTest, StopDrainsAndRejects) {
+  BatchScheduler scheduler([](std::vector<BatchScheduler::Slot>& batch) {
+    for (auto& slot : batch) {
+      slot.finish({slot.input().front() + 1});
+    }
+  });
+  auto future = scheduler.enqueue({fl::full({1}, 1.f)});
+  scheduler.stop();
+  // already-enqueued work is drained before the worker exits
+  ASSERT_FLOAT_EQ(future.get().front().asScalar<float>(), 2.f);
+  EXPECT_THROW(scheduler.enqueue({fl::full({1}, 1.f)}), std::runtime_error);
+}
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  fl::init();
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "flashlight/fl/flashlight.h"
+#include "flashlight/pkg/runtime/common/InferenceContextPool.h"
+
+using fl::pkg::runtime::InferenceContextPool;
+
+namespace {
+
+std::shared_ptr<fl::Module> makeModel() {
+  auto model = std::make_shared<fl::Sequential>();
+  model->add(fl::Linear(4, 8));
+  model->add(fl::ReLU());
+  model->add(fl::Linear(8, 2));
+  return model;
+}
+
+} // namespace
+
+TEST(InferenceContextPoolTest, SharesParameters) {
+  auto model = makeModel();
+  InferenceContextPool pool(model);
+
+  auto replica = pool.get();
+  ASSERT_NE(replica.get(), model.get());
+  ASSERT_EQ(replica->numParamTensors(), model->numParamTensors());
+
+  // the replica's parameters are the model's tensors, not copies: an
+  // in-place change to the shared storage is visible through the replica
+  model->param(0).tensor() += 1;
+  ASSERT_TRUE(
+      fl::allClose(replica->param(0).tensor(), model->param(0).tensor()));
+
+  // pool construction put the shared weights in inference mode
+  ASSERT_FALSE(model->param(0).isCalcGrad());
+  ASSERT_FALSE(replica->param(0).isCalcGrad());
+}
+
+TEST(InferenceContextPoolTest, PerThreadReplicas) {
+  auto model = makeModel();
+  InferenceContextPool pool(model);
+
+  auto replica = pool.get();
+  // same thread gets the same replica back
+  ASSERT_EQ(pool.get().get(), replica.get());
+  ASSERT_EQ(pool.size(), 1);
+
+  std::shared_ptr<fl::Module> other;
+  std::thread([&pool, &other]() { other = pool.get(); }).join();
+  ASSERT_NE(other.get(), replica.get());
+  ASSERT_EQ(pool.size(), 2);
+}
+
+TEST(InferenceContextPoolTest, ConcurrentForwardsMatch) {
+  auto model = makeModel();
+  InferenceContextPool pool(model);
+
+  auto input = fl::Variable(fl::rand({4, 16}), false);
+  auto expected = pool.get()->forward({input}).front();
+
+  constexpr int numThreads = 4;
+  std::vector<fl::Variable> outputs(numThreads);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < numThreads; ++i) {
+    threads.emplace_back([&pool, &input, &outputs, i]() {
+      outputs[i] = pool.get()->forward({input}).front();
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  ASSERT_EQ(pool.size(), 1 + numThreads);
+  for (const auto& output : outputs) {
+    ASSERT_TRUE(fl::allClose(output.tensor(), expected.tensor()));
+  }
+}
+
+TEST(InferenceContextPoolTest, HotSwapParams) {
+  auto model = makeModel();
+  InferenceContextPool pool(model);
+
+  auto input = fl::Variable(fl::rand({4, 16}), false);
+  auto before = pool.get();
+  auto oldOut = before->forward({input}).front();
+
+  // publish a new version with doubled weights
+  std::vector<fl::Variable> newParams;
+  for (int i = 0; i < model->numParamTensors(); ++i) {
+    newParams.emplace_back(model->param(i).tensor() * 2, false);
+  }
+  pool.setParams(newParams);
+  ASSERT_EQ(pool.epoch(), 1);
+
+  // an in-flight holder keeps serving the version it started with...
+  ASSERT_TRUE(fl::allClose(
+      before->forward({input}).front().tensor(), oldOut.tensor()));
+  // ...while a fresh get() picks up the new weights
+  auto after = pool.get();
+  ASSERT_NE(after.get(), before.get());
+  ASSERT_TRUE(fl::allClose(
+      after->param(0).tensor(), model->param(0).tensor() * 2));
+  // the construction-time model was not mutated by the swap
+  ASSERT_TRUE(fl::allClose(
+      model->forward({input}).front().tensor(), oldOut.tensor()));
+
+  ASSERT_THROW(pool.setParams({}), std::invalid_argument);
+}
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  fl::init();
+  return RUN_ALL_TESTS();
+}
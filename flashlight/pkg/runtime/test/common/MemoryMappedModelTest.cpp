@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <cstdint>
+#include <fstream>
+
+#include <gtest/gtest.h>
+
+#include "flashlight/pkg/runtime/common/MemoryMappedModel.h"
+
+#include "flashlight/fl/tensor/Init.h"
+#include "flashlight/fl/tensor/Random.h"
+
+using fl::pkg::runtime::MemoryMappedModel;
+using fl::pkg::runtime::saveMemoryMapped;
+
+TEST(MemoryMappedModelTest, SaveLoadRoundTrip) {
+#ifdef _WIN32
+  GTEST_SKIP() << "memory-mapped models are not supported on Windows";
+#endif
+  const fs::path path = fs::temp_directory_path() / "fl_mmap_model_test.bin";
+  std::vector<fl::Variable> params = {
+      fl::Variable(fl::rand({64, 32}), true),
+      fl::Variable(fl::rand({32}), true),
+      fl::Variable(fl::rand({3, 3, 8, 16}), true)};
+
+  saveMemoryMapped(path, params);
+
+  MemoryMappedModel model(path);
+  ASSERT_EQ(model.numTensors(), params.size());
+  for (size_t i = 0; i < params.size(); ++i) {
+    ASSERT_EQ(model.shape(i), params[i].shape());
+    ASSERT_EQ(model.type(i), params[i].type());
+    // payloads are aligned for zero-copy consumers
+    ASSERT_EQ(reinterpret_cast<uintptr_t>(model.data(i)) % 64, 0);
+    ASSERT_TRUE(
+        fl::all(model.tensor(i) == params[i].tensor()).scalar<char>());
+  }
+  fs::remove(path);
+}
+
+TEST(MemoryMappedModelTest, RejectsForeignFiles) {
+#ifdef _WIN32
+  GTEST_SKIP() << "memory-mapped models are not supported on Windows";
+#endif
+  const fs::path path = fs::temp_directory_path() / "fl_mmap_model_bogus.bin";
+  {
+    std::ofstream file(path, std::ios::binary);
+    file << "definitely not a model";
+  }
+  ASSERT_THROW(MemoryMappedModel{path}, std::runtime_error);
+  fs::remove(path);
+}
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  fl::init();
+  return RUN_ALL_TESTS();
+}
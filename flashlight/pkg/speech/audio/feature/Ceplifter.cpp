@@ -33,11 +33,15 @@ void Ceplifter::applyInPlace(std::vector<float>& input) const {
     throw std::invalid_argument(
         "Ceplifter: input size is not divisible by numFilters");
   }
-  size_t n = 0;
-  for (auto& in : input) {
-    in *= coefs_[n++];
-    if (n == numFilters_) {
-      n = 0;
+  // unit-stride multiply of each frame's contiguous coefficients by the
+  // lifter coefficients; free of the rolling-counter branch, so it
+  // vectorizes
+  const size_t numframes = input.size() / numFilters_;
+  const float* coefs = coefs_.data();
+  for (size_t i = 0; i < numframes; ++i) {
+    float* frame = input.data() + i * numFilters_;
+    for (int j = 0; j < numFilters_; ++j) {
+      frame[j] *= coefs[j];
     }
   }
 }
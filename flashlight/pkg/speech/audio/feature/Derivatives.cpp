@@ -69,16 +69,25 @@ std::vector<float> Derivatives::computeDerivative(
     int numfeat) const {
   int numframes = input.size() / numfeat;
   std::vector<float> output(input.size(), 0.0);
-  float denominator = (windowlen * (windowlen + 1) * (2 * windowlen + 1)) / 3.0;
-  for (size_t i = 0; i < numframes; ++i) {
-    for (size_t j = 0; j < numfeat; ++j) {
-      size_t curIdx = i * numfeat + j;
-      for (size_t d = 1; d <= windowlen; ++d) {
-        output[curIdx] += d *
-            (input[curIdx + std::min((numframes - i - 1), d) * numfeat] -
-             input[curIdx - std::min(i, d) * numfeat]);
+  const float invDenominator =
+      3.0 / (windowlen * (windowlen + 1) * (2 * windowlen + 1));
+  // The window offsets are clamped per (frame, distance) pair, not per
+  // coefficient, so the inner loops run unit-stride over a frame's
+  // contiguous coefficients and vectorize.
+  for (int i = 0; i < numframes; ++i) {
+    float* outFrame = output.data() + i * numfeat;
+    for (int d = 1; d <= windowlen; ++d) {
+      // edge frames are replicated, as with the clamped indexing before
+      const float* forw =
+          input.data() + (i + std::min(numframes - 1 - i, d)) * numfeat;
+      const float* back = input.data() + (i - std::min(i, d)) * numfeat;
+      const float scale = d;
+      for (int j = 0; j < numfeat; ++j) {
+        outFrame[j] += scale * (forw[j] - back[j]);
       }
-      output[curIdx] /= denominator;
+    }
+    for (int j = 0; j < numfeat; ++j) {
+      outFrame[j] *= invDenominator;
     }
   }
   return output;
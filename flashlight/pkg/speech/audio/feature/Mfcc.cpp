@@ -26,7 +26,25 @@ std::vector<float> Mfcc::apply(const std::vector<float>& input) {
   if (frames.empty()) {
     return {};
   }
+  return mfccFromFrames(frames);
+}
+
+std::vector<float> Mfcc::applyStream(
+    const std::vector<float>& chunk,
+    AudioStreamState& state) {
+  if (this->featParams_.deltaWindow > 0 || this->featParams_.accWindow > 0) {
+    throw std::invalid_argument(
+        "Mfcc: streaming does not support delta/acceleration derivatives, "
+        "which require full-utterance context");
+  }
+  auto frames = this->frameStream(chunk, state);
+  if (frames.empty()) {
+    return {};
+  }
+  return mfccFromFrames(frames);
+}
 
+std::vector<float> Mfcc::mfccFromFrames(std::vector<float>& frames) {
   int nSamples = this->featParams_.numFrameSizeSamples();
   int nFrames = frames.size() / nSamples;
 
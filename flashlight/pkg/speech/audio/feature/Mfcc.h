@@ -61,9 +61,19 @@ class Mfcc : public Mfsc {
   // Returns - MFCC features (Col Major : FEAT X FRAMESZ)
   std::vector<float> apply(const std::vector<float>& input) override;
 
+  // Streaming variant of apply(); delta/acceleration derivatives are not
+  // supported since they require full-utterance context
+  std::vector<float> applyStream(
+      const std::vector<float>& chunk,
+      AudioStreamState& state) override;
+
   int outputSize(int inputSz) override;
 
  private:
+  // Shared by apply() and applyStream(): computes the features of the given
+  // frames
+  std::vector<float> mfccFromFrames(std::vector<float>& frames);
+
   // The following classes are defined in the order they are applied
   Dct dct_;
   Ceplifter ceplifter_;
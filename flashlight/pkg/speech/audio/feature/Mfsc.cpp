@@ -33,7 +33,25 @@ std::vector<float> Mfsc::apply(const std::vector<float>& input) {
   if (frames.empty()) {
     return {};
   }
+  return mfscFromFrames(frames);
+}
+
+std::vector<float> Mfsc::applyStream(
+    const std::vector<float>& chunk,
+    AudioStreamState& state) {
+  if (this->featParams_.deltaWindow > 0 || this->featParams_.accWindow > 0) {
+    throw std::invalid_argument(
+        "Mfsc: streaming does not support delta/acceleration derivatives, "
+        "which require full-utterance context");
+  }
+  auto frames = this->frameStream(chunk, state);
+  if (frames.empty()) {
+    return {};
+  }
+  return mfscFromFrames(frames);
+}
 
+std::vector<float> Mfsc::mfscFromFrames(std::vector<float>& frames) {
   int nSamples = this->featParams_.numFrameSizeSamples();
   int nFrames = frames.size() / nSamples;
 
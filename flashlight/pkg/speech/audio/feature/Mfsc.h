@@ -29,6 +29,12 @@ class Mfsc : public PowerSpectrum {
   // Returns - MFSC feature (Col Major : FEAT X FRAMESZ)
   std::vector<float> apply(const std::vector<float>& input) override;
 
+  // Streaming variant of apply(); delta/acceleration derivatives are not
+  // supported since they require full-utterance context
+  std::vector<float> applyStream(
+      const std::vector<float>& chunk,
+      AudioStreamState& state) override;
+
   int outputSize(int inputSz) override;
 
  protected:
@@ -38,6 +44,10 @@ class Mfsc : public PowerSpectrum {
   void validateMfscParams() const;
 
  private:
+  // Shared by apply() and applyStream(): computes the features of the given
+  // frames
+  std::vector<float> mfscFromFrames(std::vector<float>& frames);
+
   TriFilterbank triFltBank_;
   Derivatives derivatives_;
 };
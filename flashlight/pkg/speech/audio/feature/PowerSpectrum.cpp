@@ -17,6 +17,11 @@
 
 namespace fl::lib::audio {
 
+namespace {
+// Number of frames transformed per execution of the batched FFT plan
+constexpr int kFftBatchFrames = 32;
+} // namespace
+
 std::mutex PowerSpectrum::fftPlanMutex_;
 
 PowerSpectrum::PowerSpectrum(const FeatureParams& params)
@@ -30,11 +35,30 @@ PowerSpectrum::PowerSpectrum(const FeatureParams& params)
   std::lock_guard<std::mutex> lock(fftPlanMutex_);
 
   validatePowSpecParams();
-  auto nFFt = featParams_.nFft();
-  inFftBuf_.resize(nFFt, 0.0);
-  outFftBuf_.resize(2 * nFFt);
-  fftPlan_ = std::make_unique<fftw_plan>(std::move(fftw_plan_dft_r2c_1d(
-      nFFt, inFftBuf_.data(), (fftw_complex*)outFftBuf_.data(), FFTW_MEASURE)));
+  int nFft = featParams_.nFft();
+  int K = featParams_.filterFreqResponseLen();
+  inFftBuf_.resize(kFftBatchFrames * nFft, 0.0);
+  outFftBuf_.resize(2 * kFftBatchFrames * K);
+  // FFTW_UNALIGNED permits executing the plans on any buffer through the
+  // new-array interface
+  fftPlan_ = std::make_unique<fftw_plan>(fftw_plan_dft_r2c_1d(
+      nFft,
+      inFftBuf_.data(),
+      (fftw_complex*)outFftBuf_.data(),
+      FFTW_MEASURE | FFTW_UNALIGNED));
+  fftBatchPlan_ = std::make_unique<fftw_plan>(fftw_plan_many_dft_r2c(
+      1,
+      &nFft,
+      kFftBatchFrames,
+      inFftBuf_.data(),
+      nullptr,
+      1,
+      nFft,
+      (fftw_complex*)outFftBuf_.data(),
+      nullptr,
+      1,
+      K,
+      FFTW_MEASURE | FFTW_UNALIGNED));
 }
 
 std::vector<float> PowerSpectrum::apply(const std::vector<float>& input) {
@@ -45,6 +69,34 @@ std::vector<float> PowerSpectrum::apply(const std::vector<float>& input) {
   return powSpectrumImpl(frames);
 }
 
+std::vector<float> PowerSpectrum::applyStream(
+    const std::vector<float>& chunk,
+    AudioStreamState& state) {
+  auto frames = frameStream(chunk, state);
+  if (frames.empty()) {
+    return {};
+  }
+  return powSpectrumImpl(frames);
+}
+
+std::vector<float> PowerSpectrum::frameStream(
+    const std::vector<float>& chunk,
+    AudioStreamState& state) const {
+  auto& buffered = state.buffered;
+  buffered.insert(buffered.end(), chunk.begin(), chunk.end());
+  int nFrames = featParams_.numFrames(buffered.size());
+  if (nFrames == 0) {
+    return {};
+  }
+  auto frames = frameSignal(buffered, featParams_);
+  // Drop the samples consumed by the emitted frames; the overlap with the
+  // next frame stays buffered
+  buffered.erase(
+      buffered.begin(),
+      buffered.begin() + nFrames * featParams_.numFrameStrideSamples());
+  return frames;
+}
+
 std::vector<float> PowerSpectrum::powSpectrumImpl(std::vector<float>& frames) {
   int nSamples = featParams_.numFrameSizeSamples();
   int nFrames = frames.size() / nSamples;
@@ -63,29 +115,47 @@ std::vector<float> PowerSpectrum::powSpectrumImpl(std::vector<float>& frames) {
           begin, begin + nSamples, begin, [mean](float x) { return x - mean; });
     }
   }
-  if (featParams_.preemCoef != 0) {
-    preEmphasis_.applyInPlace(frames);
-  }
-  windowing_.applyInPlace(frames);
+  // Pre-emphasis and windowing run fused, so the frame buffer is traversed
+  // once rather than twice (the fused pass falls back to plain windowing
+  // when pre-emphasis is disabled)
+  windowing_.applyWithPreEmphasisInPlace(frames, featParams_.preemCoef);
   std::vector<float> dft(K * nFrames);
-  for (size_t f = 0; f < nFrames; ++f) {
-    auto begin = frames.data() + f * nSamples;
-    {
-      std::lock_guard<std::mutex> lock(fftMutex_);
-      std::copy(begin, begin + nSamples, inFftBuf_.data());
-      std::fill(outFftBuf_.begin(), outFftBuf_.end(), 0.0);
-      fftw_execute(*fftPlan_);
-
-      // Copy stuff to the redundant part
-      for (size_t i = K; i < nFft; ++i) {
-        outFftBuf_[2 * i] = outFftBuf_[2 * nFft - 2 * i];
-        outFftBuf_[2 * i + 1] = -outFftBuf_[2 * nFft - 2 * i + 1];
+  // Frames go through the batched plan kFftBatchFrames at a time, with the
+  // remainder transformed one at a time; the new-array execute functions are
+  // thread safe on a shared plan, so no locking is needed here. The upper
+  // half of the spectrum is conjugate-symmetric and never read, so only the
+  // K non-redundant bins are computed.
+  // Per-thread staging buffers, reused across calls: loader threads execute
+  // concurrently, so the buffers can't live on the (shared) instance, and
+  // allocating them per utterance was the remaining per-call cost
+  static thread_local std::vector<double> inBuf;
+  static thread_local std::vector<double> outBuf;
+  inBuf.assign(kFftBatchFrames * nFft, 0.0);
+  outBuf.resize(2 * kFftBatchFrames * K);
+  for (int f = 0; f < nFrames; f += kFftBatchFrames) {
+    int cur = std::min(kFftBatchFrames, nFrames - f);
+    for (int b = 0; b < cur; ++b) {
+      std::copy(
+          frames.data() + (f + b) * nSamples,
+          frames.data() + (f + b) * nSamples + nSamples,
+          inBuf.data() + b * nFft);
+    }
+    if (cur == kFftBatchFrames) {
+      fftw_execute_dft_r2c(
+          *fftBatchPlan_, inBuf.data(), (fftw_complex*)outBuf.data());
+    } else {
+      for (int b = 0; b < cur; ++b) {
+        fftw_execute_dft_r2c(
+            *fftPlan_,
+            inBuf.data() + b * nFft,
+            (fftw_complex*)(outBuf.data() + 2 * b * K));
       }
-
-      for (size_t i = 0; i < K; ++i) {
-        dft[f * K + i] = std::sqrt(
-            outFftBuf_[2 * i] * outFftBuf_[2 * i] +
-            outFftBuf_[2 * i + 1] * outFftBuf_[2 * i + 1]);
+    }
+    for (int b = 0; b < cur; ++b) {
+      for (int i = 0; i < K; ++i) {
+        dft[(f + b) * K + i] = std::sqrt(
+            outBuf[2 * (b * K + i)] * outBuf[2 * (b * K + i)] +
+            outBuf[2 * (b * K + i) + 1] * outBuf[2 * (b * K + i) + 1]);
       }
     }
   }
@@ -143,5 +213,6 @@ void PowerSpectrum::validatePowSpecParams() const {
 
 PowerSpectrum::~PowerSpectrum() {
   fftw_destroy_plan(*fftPlan_);
+  fftw_destroy_plan(*fftBatchPlan_);
 }
 } // namespace fl
@@ -23,6 +23,13 @@ namespace fl {
 namespace lib {
 namespace audio {
 
+// Carried state for streaming feature extraction: buffers the trailing
+// samples of a chunk that do not yet form a complete frame so they can be
+// consumed by the next call.
+struct AudioStreamState {
+  std::vector<float> buffered;
+};
+
 // Computes Power Spectrum features for a speech signal.
 
 class PowerSpectrum {
@@ -35,6 +42,14 @@ class PowerSpectrum {
   // Returns - Power spectrum (Col Major : FEAT X FRAMESZ)
   virtual std::vector<float> apply(const std::vector<float>& input);
 
+  // Streaming variant of apply(): accepts the signal in chunks and carries
+  // the incomplete trailing frame in `state` across calls, so the
+  // concatenated outputs match apply() on the whole signal (modulo dither,
+  // which is stochastic)
+  virtual std::vector<float> applyStream(
+      const std::vector<float>& chunk,
+      AudioStreamState& state);
+
   // input - input speech signal (Col Major : T X BATCHSZ)
   // Returns - Output features (Col Major : FEAT X FRAMESZ X BATCHSZ)
   std::vector<float> batchApply(const std::vector<float>& input, int batchSz);
@@ -50,6 +65,12 @@ class PowerSpectrum {
   // frames. Main purpose of this function is to reuse it in MFSC, MFCC code
   std::vector<float> powSpectrumImpl(std::vector<float>& frames);
 
+  // Appends `chunk` to the carried state and returns all complete frames,
+  // leaving the overlap buffered in the state for the next call
+  std::vector<float> frameStream(
+      const std::vector<float>& chunk,
+      AudioStreamState& state) const;
+
   void validatePowSpecParams() const;
 
  private:
@@ -58,9 +79,12 @@ class PowerSpectrum {
   PreEmphasis preEmphasis_;
   Windowing windowing_;
 
+  // Single-frame and batched plans; both are created with FFTW_UNALIGNED so
+  // they can be executed on per-call buffers via the new-array interface,
+  // which is thread safe and needs no locking
   std::unique_ptr<fftw_plan> fftPlan_; // fftw_plan is an opque pointer type
+  std::unique_ptr<fftw_plan> fftBatchPlan_;
   std::vector<double> inFftBuf_, outFftBuf_;
-  std::mutex fftMutex_;
   static std::mutex fftPlanMutex_;
 };
 } // namespace audio
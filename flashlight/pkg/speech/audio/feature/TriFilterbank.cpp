@@ -12,8 +12,6 @@
 #include <cstddef>
 #include <stdexcept>
 
-#include "flashlight/pkg/speech/audio/feature/SpeechUtils.h"
-
 namespace fl::lib::audio {
 
 TriFilterbank::TriFilterbank(
@@ -49,17 +47,51 @@ TriFilterbank::TriFilterbank(
       H_[i * numFilters_ + j] = std::max(std::min(hislope, loslope), minH);
     }
   }
+
+  // Build the banded form of H_ used by apply(): each triangular filter is
+  // supported on the bins between its two neighboring cutoffs only
+  bandStart_.resize(numFilters_);
+  bandOffset_.resize(numFilters_ + 1);
+  for (int j = 0; j < numFilters_; ++j) {
+    int start = 0;
+    int end = filterLen_;
+    while (start < filterLen_ && H_[start * numFilters_ + j] == 0.0) {
+      ++start;
+    }
+    while (end > start && H_[(end - 1) * numFilters_ + j] == 0.0) {
+      --end;
+    }
+    bandStart_[j] = start;
+    bandOffset_[j] = bandWeights_.size();
+    for (int i = start; i < end; ++i) {
+      bandWeights_.push_back(H_[i * numFilters_ + j]);
+    }
+  }
+  bandOffset_[numFilters_] = bandWeights_.size();
 }
 
 std::vector<float> TriFilterbank::apply(
     const std::vector<float>& input,
     float melfloor /* = 0.0 */) const {
-  std::vector<float> output = cblasGemm(input, H_, numFilters_, filterLen_);
-  std::transform(
-      output.begin(),
-      output.end(),
-      output.begin(),
-      [melfloor](float n) -> float { return std::max(n, melfloor); });
+  if (input.empty() || input.size() % filterLen_ != 0) {
+    throw std::invalid_argument("TriFilterbank: invalid input size");
+  }
+  int nFrames = input.size() / filterLen_;
+  std::vector<float> output(nFrames * numFilters_);
+  for (int f = 0; f < nFrames; ++f) {
+    const float* in = input.data() + f * filterLen_;
+    float* out = output.data() + f * numFilters_;
+    for (int j = 0; j < numFilters_; ++j) {
+      const float* w = bandWeights_.data() + bandOffset_[j];
+      const float* x = in + bandStart_[j];
+      int bandLen = bandOffset_[j + 1] - bandOffset_[j];
+      float sum = 0.0;
+      for (int i = 0; i < bandLen; ++i) {
+        sum += x[i] * w[i];
+      }
+      out[j] = std::max(sum, melfloor);
+    }
+  }
   return output;
 }
 
@@ -43,6 +43,13 @@ class TriFilterbank {
   std::vector<float>
       H_; // (numFilters_ x filterLen_) triangular filterbank matrix
 
+  // Banded representation of H_: each filter is nonzero only on a short
+  // contiguous range of frequency bins, so `apply` multiplies against the
+  // compact per-filter weights instead of the mostly-zero dense matrix
+  std::vector<int> bandStart_; // first nonzero bin of each filter
+  std::vector<int> bandOffset_; // offset of each filter in bandWeights_
+  std::vector<float> bandWeights_; // nonzero weights of all filters
+
   float hertzToWarpedScale(float hz, FrequencyScale freqscale) const;
   float warpedToHertzScale(float wrp, FrequencyScale freqscale) const;
 };
@@ -55,4 +55,29 @@ void Windowing::applyInPlace(std::vector<float>& input) const {
     }
   }
 }
+
+void Windowing::applyWithPreEmphasisInPlace(
+    std::vector<float>& input,
+    float alpha) const {
+  if (input.size() % windowLength_ != 0) {
+    throw std::invalid_argument(
+        "Windowing: input size is not divisible by windowLength");
+  }
+  if (alpha == 0.0) {
+    applyInPlace(input);
+    return;
+  }
+  const float* coefs = coefs_.data();
+  size_t nFrames = input.size() / windowLength_;
+  for (size_t f = 0; f < nFrames; ++f) {
+    float* frame = input.data() + f * windowLength_;
+    // Walk backwards so frame[i - 1] still holds the raw sample when read;
+    // in-place, a forward walk would need the previous raw sample carried in
+    // a register, which defeats vectorization
+    for (int i = windowLength_ - 1; i > 0; --i) {
+      frame[i] = coefs[i] * (frame[i] - alpha * frame[i - 1]);
+    }
+    frame[0] = coefs[0] * (frame[0] * (1 - alpha));
+  }
+}
 } // namespace fl
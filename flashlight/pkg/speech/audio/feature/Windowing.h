@@ -27,6 +27,15 @@ class Windowing {
 
   void applyInPlace(std::vector<float>& input) const;
 
+  // Applies pre-emphasis (s'(n) = s(n) - alpha * s(n-1), per frame) and the
+  // window in a single pass over the frame buffer:
+  //    s'(n) = w(n) * (s(n) - alpha * s(n-1))
+  // Equivalent to PreEmphasis::applyInPlace followed by applyInPlace, but
+  // touches each sample once; the inner loop carries no true dependence, so
+  // it vectorizes with the multiply-adds contracted to FMAs.
+  void applyWithPreEmphasisInPlace(std::vector<float>& input, float alpha)
+      const;
+
  private:
   int windowLength_;
   WindowType windowType_;
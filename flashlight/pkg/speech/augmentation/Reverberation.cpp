@@ -9,30 +9,49 @@
 
 #include <algorithm>
 #include <cmath>
+#include <mutex>
 #include <sstream>
 
+#include <fftw3.h>
+
 namespace fl::pkg::speech::sfx {
+namespace {
+
+// FFTW planning is not thread safe; executing plans on distinct buffers is.
+// Guards plan creation across all ReverbEcho instances.
+std::mutex fftPlanMutex;
+
+// Smallest FFT size used for overlap-save convolution
+constexpr int kMinConvFftSize = 512;
+
+} // namespace
 
 ReverbEcho::ReverbEcho(
     const ReverbEcho::Config& conf,
     unsigned int seed /* = 0 */)
     : conf_(conf), rng_(seed) {}
 
-void ReverbEcho::applyReverb(
-    std::vector<float>& source,
+ReverbEcho::~ReverbEcho() {
+  for (auto& plans : convPlans_) {
+    fftw_destroy_plan(*plans.second.forward);
+    fftw_destroy_plan(*plans.second.inverse);
+  }
+}
+
+std::vector<float> ReverbEcho::sampleRir(
     float initial,
     float firstDelay,
-    float rt60) {
-  size_t length = source.size();
-  std::vector<float> reverb(length, 0);
+    float rt60,
+    size_t length,
+    size_t& minDelay) {
+  // Mirrors the sampling of the former time-domain echo loops: each repeat
+  // is a train of echoes at the jittered first delay with geometrically
+  // decaying amplitude. The echoes are collapsed into one impulse response
+  // which is applied with a single convolution.
+  std::vector<float> kernel;
+  minDelay = length;
   for (int i = 0; i < conf_.repeat_; ++i) {
     float frac = 1;
-    // echo = initial * source
-    std::vector<float> echo = source;
-    std::transform(
-        echo.begin(), echo.end(), echo.begin(), [initial](float x) -> float {
-          return x * initial;
-        });
     while (frac > 1e-3) {
       // Add jitter noise for the delay
       float jitter = 1 + rng_.uniform(-conf_.jitter_, conf_.jitter_);
@@ -40,9 +59,11 @@ void ReverbEcho::applyReverb(
       if (delay > length - 1) {
         break;
       }
-      for (int j = 0; j < length - delay - 1; ++j) {
-        reverb[delay + j] += echo[j] * frac;
+      if (delay >= kernel.size()) {
+        kernel.resize(delay + 1, 0.0);
       }
+      kernel[delay] += initial * frac;
+      minDelay = std::min(minDelay, delay);
 
       // Add jitter noise for the attenuation
       jitter = 1 + rng_.uniform(-conf_.jitter_, conf_.jitter_);
@@ -51,7 +72,97 @@ void ReverbEcho::applyReverb(
       frac *= attenuation;
     }
   }
-  for (int i = 0; i < length; ++i) {
+  return kernel;
+}
+
+ReverbEcho::ConvPlans& ReverbEcho::getConvPlans(int nFft) {
+  auto it = convPlans_.find(nFft);
+  if (it != convPlans_.end()) {
+    return it->second;
+  }
+  std::lock_guard<std::mutex> lock(fftPlanMutex);
+  std::vector<double> in(nFft);
+  std::vector<double> out(2 * (nFft / 2 + 1));
+  ConvPlans plans;
+  plans.forward = std::make_unique<fftw_plan>(fftw_plan_dft_r2c_1d(
+      nFft,
+      in.data(),
+      (fftw_complex*)out.data(),
+      FFTW_MEASURE | FFTW_UNALIGNED));
+  plans.inverse = std::make_unique<fftw_plan>(fftw_plan_dft_c2r_1d(
+      nFft,
+      (fftw_complex*)out.data(),
+      in.data(),
+      FFTW_MEASURE | FFTW_UNALIGNED));
+  return convPlans_.emplace(nFft, std::move(plans)).first->second;
+}
+
+void ReverbEcho::fftConvolve(
+    const std::vector<float>& source,
+    const std::vector<float>& kernel,
+    std::vector<float>& reverb) {
+  int length = source.size();
+  int kernelLen = kernel.size();
+  int nFft = kMinConvFftSize;
+  while (nFft < 2 * kernelLen) {
+    nFft *= 2;
+  }
+  int blockSize = nFft - kernelLen + 1;
+  int freqLen = nFft / 2 + 1;
+  auto& plans = getConvPlans(nFft);
+
+  // Kernel spectrum is computed once and reused for every block
+  std::vector<double> buf(nFft, 0.0);
+  std::copy(kernel.begin(), kernel.end(), buf.begin());
+  std::vector<double> kernelSpec(2 * freqLen);
+  fftw_execute_dft_r2c(
+      *plans.forward, buf.data(), (fftw_complex*)kernelSpec.data());
+
+  std::vector<double> spec(2 * freqLen);
+  std::vector<double> out(nFft);
+  for (int pos = 0; pos < length; pos += blockSize) {
+    // Each block reads back kernelLen - 1 samples of history (zero padded
+    // at the utterance start) and yields blockSize valid output samples
+    for (int i = 0; i < nFft; ++i) {
+      int srcIdx = pos - kernelLen + 1 + i;
+      buf[i] = (srcIdx >= 0 && srcIdx < length) ? source[srcIdx] : 0.0;
+    }
+    fftw_execute_dft_r2c(*plans.forward, buf.data(), (fftw_complex*)spec.data());
+    for (int i = 0; i < freqLen; ++i) {
+      double re = spec[2 * i] * kernelSpec[2 * i] -
+          spec[2 * i + 1] * kernelSpec[2 * i + 1];
+      double im = spec[2 * i] * kernelSpec[2 * i + 1] +
+          spec[2 * i + 1] * kernelSpec[2 * i];
+      spec[2 * i] = re;
+      spec[2 * i + 1] = im;
+    }
+    fftw_execute_dft_c2r(*plans.inverse, (fftw_complex*)spec.data(), out.data());
+    int nValid = std::min(blockSize, length - pos);
+    for (int i = 0; i < nValid; ++i) {
+      reverb[pos + i] = out[kernelLen - 1 + i] / nFft;
+    }
+  }
+}
+
+void ReverbEcho::applyReverb(
+    std::vector<float>& source,
+    float initial,
+    float firstDelay,
+    float rt60) {
+  size_t length = source.size();
+  if (length == 0) {
+    return;
+  }
+  size_t minDelay;
+  auto kernel = sampleRir(initial, firstDelay, rt60, length, minDelay);
+  if (kernel.empty()) {
+    return;
+  }
+  std::vector<float> reverb(length, 0);
+  fftConvolve(source, kernel, reverb);
+  // The kernel has no tap before minDelay, so adding from there keeps the
+  // dry signal bit-exact up to the first echo
+  for (size_t i = minDelay; i < length; ++i) {
     source[i] += reverb[i];
   }
 }
@@ -68,6 +179,12 @@ void ReverbEcho::apply(std::vector<float>& sound) {
   applyReverb(sound, initial, firstDelay, rt60);
 }
 
+void ReverbEcho::applyBatch(std::vector<std::vector<float>>& sounds) {
+  for (auto& sound : sounds) {
+    apply(sound);
+  }
+}
+
 std::string ReverbEcho::prettyString() const {
   return "ReverbEcho{conf_=" + conf_.prettyString() + "}}";
 }
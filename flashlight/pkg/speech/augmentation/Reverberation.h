@@ -9,12 +9,18 @@
 
 #include "flashlight/pkg/speech/augmentation/SoundEffect.h"
 
+#include <memory>
 #include <random>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "flashlight/pkg/speech/augmentation/SoundEffectUtil.h"
 
+// Fwd decl
+class fftw_plan_s;
+typedef fftw_plan_s* fftw_plan;
+
 namespace fl {
 namespace pkg {
 namespace speech {
@@ -79,8 +85,12 @@ class ReverbEcho : public SoundEffect {
   };
 
   explicit ReverbEcho(const ReverbEcho::Config& config, unsigned int seed = 0);
-  ~ReverbEcho() override = default;
+  ~ReverbEcho() override;
   void apply(std::vector<float>& sound) override;
+  // Applies reverb to every utterance in the batch, sampling the reverb
+  // characteristics independently per utterance. The cached FFT plans are
+  // shared across the whole batch (and across subsequent calls).
+  void applyBatch(std::vector<std::vector<float>>& sounds);
   std::string prettyString() const override;
 
  private:
@@ -90,9 +100,36 @@ class ReverbEcho : public SoundEffect {
       float initial,
       float firstDelay,
       float rt60);
+  // Samples the sparse room impulse response of the echo trains for the
+  // given characteristics; the direct path is left out so the dry signal
+  // stays untouched before the first echo. `minDelay` is set to the index
+  // of the first tap.
+  std::vector<float> sampleRir(
+      float initial,
+      float firstDelay,
+      float rt60,
+      size_t length,
+      size_t& minDelay);
+  // reverb <- conv(source, kernel) truncated to the source length, computed
+  // blockwise with FFT overlap-save; the kernel spectrum is computed once
+  // and reused for every block
+  void fftConvolve(
+      const std::vector<float>& source,
+      const std::vector<float>& kernel,
+      std::vector<float>& reverb);
+
+  // Overlap-save FFT plans, cached by FFT size and reused across
+  // utterances. Plans are created with FFTW_UNALIGNED so they can execute
+  // on any buffer via the new-array interface.
+  struct ConvPlans {
+    std::unique_ptr<fftw_plan> forward;
+    std::unique_ptr<fftw_plan> inverse;
+  };
+  ConvPlans& getConvPlans(int nFft);
 
   const ReverbEcho::Config conf_;
   RandomNumberGenerator rng_;
+  std::unordered_map<int, ConvPlans> convPlans_;
 };
 
 } // namespace sfx
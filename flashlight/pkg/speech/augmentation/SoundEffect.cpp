@@ -9,10 +9,58 @@
 
 #include <algorithm>
 #include <cmath>
+#include <condition_variable>
+#include <deque>
+#include <exception>
 #include <sstream>
+#include <thread>
 
 namespace fl::pkg::speech::sfx {
 
+namespace {
+
+// Single-producer single-consumer queue of utterance indices feeding one
+// pipeline stage in applyBatch() below.
+class StageQueue {
+ public:
+  void push(size_t index) {
+    {
+      std::lock_guard<std::mutex> guard(mutex_);
+      indices_.push_back(index);
+    }
+    cv_.notify_one();
+  }
+
+  // Signal that no more indices will be pushed.
+  void close() {
+    {
+      std::lock_guard<std::mutex> guard(mutex_);
+      closed_ = true;
+    }
+    cv_.notify_one();
+  }
+
+  // Returns false once the queue is closed and drained.
+  bool pop(size_t& index) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.wait(lock, [this]() { return !indices_.empty() || closed_; });
+    if (indices_.empty()) {
+      return false;
+    }
+    index = indices_.front();
+    indices_.pop_front();
+    return true;
+  }
+
+ private:
+  std::deque<size_t> indices_;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  bool closed_{false};
+};
+
+} // namespace
+
 std::string SoundEffectChain::prettyString() const {
   std::stringstream ss;
   ss << '{' << std::endl;
@@ -37,6 +85,56 @@ bool SoundEffectChain::empty() {
   return soundEffects_.empty();
 }
 
+void SoundEffectChain::applyBatch(std::vector<std::vector<float>>& sounds) {
+  const size_t numStages = soundEffects_.size();
+  if (numStages == 0 || sounds.empty()) {
+    return;
+  }
+  if (numStages == 1 || sounds.size() == 1) {
+    for (auto& sound : sounds) {
+      apply(sound);
+    }
+    return;
+  }
+  std::vector<StageQueue> queues(numStages);
+  std::exception_ptr firstError;
+  std::mutex errorMutex;
+  std::vector<std::thread> stages;
+  for (size_t s = 0; s < numStages; ++s) {
+    stages.emplace_back([this, s, numStages, &queues, &sounds, &firstError,
+                         &errorMutex]() {
+      size_t index;
+      while (queues[s].pop(index)) {
+        try {
+          soundEffects_[s]->apply(sounds[index]);
+        } catch (...) {
+          std::lock_guard<std::mutex> guard(errorMutex);
+          if (!firstError) {
+            firstError = std::current_exception();
+          }
+          continue; // keep draining so upstream stages don't block
+        }
+        if (s + 1 < numStages) {
+          queues[s + 1].push(index);
+        }
+      }
+      if (s + 1 < numStages) {
+        queues[s + 1].close();
+      }
+    });
+  }
+  for (size_t index = 0; index < sounds.size(); ++index) {
+    queues[0].push(index);
+  }
+  queues[0].close();
+  for (auto& stage : stages) {
+    stage.join();
+  }
+  if (firstError) {
+    std::rethrow_exception(firstError);
+  }
+}
+
 Normalize::Normalize(bool onlyIfTooHigh) : onlyIfTooHigh_(onlyIfTooHigh) {}
 
 void Normalize::apply(std::vector<float>& sound) {
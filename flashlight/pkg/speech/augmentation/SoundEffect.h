@@ -43,6 +43,17 @@ class SoundEffectChain : public SoundEffect {
   void add(std::shared_ptr<SoundEffect> SoundEffect);
   bool empty();
 
+  /**
+   * Applies the chain to a batch of sounds with one thread per effect,
+   * pipelined: while effect i works on one utterance, effect i + 1 works on
+   * the previous one. Per-utterance results are identical to calling apply()
+   * on each sound in turn -- each utterance still traverses the effects in
+   * order, and each effect only ever runs on its own stage thread, so
+   * effects need not be thread-safe. The first exception thrown by any stage
+   * is rethrown on the calling thread once the pipeline drains.
+   */
+  void applyBatch(std::vector<std::vector<float>>& sounds);
+
  protected:
   std::vector<std::shared_ptr<SoundEffect>> soundEffects_;
 };
@@ -8,35 +8,115 @@
 #include "flashlight/pkg/speech/augmentation/TimeStretch.h"
 
 #include <algorithm>
-#include <fstream>
-#include <memory>
+#include <cmath>
 #include <sstream>
 
-#include <sox.h>
+namespace fl::pkg::speech::sfx {
 
-#include "flashlight/pkg/speech/augmentation/SoxWrapper.h"
+namespace {
 
-namespace fl::pkg::speech::sfx {
+// WSOLA frame geometry, in milliseconds. At 16 kHz: 400-sample windows with
+// 50% overlap and a 120-sample similarity search radius.
+constexpr double kWindowMs = 25.0;
+constexpr double kSeekMs = 7.5;
+
+/**
+ * Stretch `input` to `factor` times its length (pitch-preserving) with
+ * WSOLA. Windows are copied to the output at the synthesis hop while the
+ * analysis position advances at hop / factor; each window's exact source is
+ * picked within +-seek samples by maximizing normalized cross-correlation
+ * against the tail of the output, and the overlap is linearly cross-faded.
+ */
+std::vector<float> wsolaStretch(
+    const std::vector<float>& input,
+    double factor,
+    size_t sampleRate) {
+  const long win =
+      std::max<long>(16, std::lround(kWindowMs / 1000 * sampleRate)) & ~1L;
+  const long overlap = win / 2;
+  const long hop = win - overlap;
+  const long seek = std::max<long>(1, std::lround(kSeekMs / 1000 * sampleRate));
+  const size_t targetLen = std::lround(input.size() * factor);
+  if (input.size() < static_cast<size_t>(2 * win)) {
+    return input; // too short to overlap-add
+  }
+
+  std::vector<float> output;
+  output.reserve(targetLen + win);
+  // seed with the first window; subsequent windows are aligned against it
+  output.insert(output.end(), input.begin(), input.begin() + win);
+
+  const double anaHop = hop / factor;
+  double anaPos = anaHop;
+  while (output.size() < targetLen) {
+    const long target = std::lround(anaPos);
+    const long lo = std::max(0L, target - seek);
+    const long hi =
+        std::min(static_cast<long>(input.size()) - win, target + seek);
+    if (lo > hi) {
+      break; // analysis position ran off the input
+    }
+    // find the candidate window whose head best continues the output tail
+    const float* tail = output.data() + output.size() - overlap;
+    long best = lo;
+    double bestScore = -HUGE_VAL;
+    for (long s = lo; s <= hi; ++s) {
+      const float* cand = input.data() + s;
+      double dot = 0.0;
+      double energy = 1e-9;
+      for (long i = 0; i < overlap; ++i) {
+        dot += tail[i] * cand[i];
+        energy += cand[i] * cand[i];
+      }
+      const double score = dot / std::sqrt(energy);
+      if (score > bestScore) {
+        bestScore = score;
+        best = s;
+      }
+    }
+    // cross-fade the overlap, then append the rest of the window
+    float* outTail = output.data() + output.size() - overlap;
+    for (long i = 0; i < overlap; ++i) {
+      const float w = (i + 0.5f) / overlap;
+      outTail[i] = (1 - w) * outTail[i] + w * input[best + i];
+    }
+    output.insert(
+        output.end(),
+        input.begin() + best + overlap,
+        input.begin() + best + win);
+    anaPos += anaHop;
+  }
+  if (output.size() < targetLen) {
+    // the search window hit the end of the input with up to about one window
+    // of output still owed; pad with the input's own tail
+    const size_t deficit = targetLen - output.size();
+    const size_t start = input.size() > deficit ? input.size() - deficit : 0;
+    output.insert(output.end(), input.begin() + start, input.end());
+  }
+  output.resize(targetLen);
+  return output;
+}
+
+} // namespace
 
 TimeStretch::TimeStretch(
     const TimeStretch::Config& config,
     unsigned int seed /* =0 */)
-    : conf_(config),
-      rng_(seed),
-      sox_(SoxWrapper::instance(config.sampleRate_)) {
-  FL_SOX_CHECK(stretchEffect_ = sox_find_effect("stretch"));
-}
+    : conf_(config), rng_(seed) {}
 
 void TimeStretch::apply(std::vector<float>& signal) {
-  if (rng_.random() >= conf_.proba_) {
+  float factor;
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    if (rng_.random() >= conf_.proba_) {
+      return;
+    }
+    factor = rng_.uniform(conf_.minFactor_, conf_.maxFactor_);
+  }
+  if (std::fabs(factor - 1.0f) < 1e-3f) {
     return;
   }
-  const float factor = rng_.uniform(conf_.minFactor_, conf_.maxFactor_);
-  sox_effect_t* e = sox_create_effect(stretchEffect_);
-  std::string _factor = std::to_string(factor);
-  char* args[] = {_factor.data()};
-  FL_SOX_CHECK(sox_effect_options(e, 1, args));
-  sox_->applyAndFreeEffect(signal, e);
+  signal = wsolaStretch(signal, factor, conf_.sampleRate_);
 }
 
 std::string TimeStretch::Config::prettyString() const {
@@ -9,22 +9,26 @@
 
 #include "flashlight/pkg/speech/augmentation/SoundEffect.h"
 
+#include <mutex>
 #include <random>
 #include <string>
 #include <vector>
 
 #include "flashlight/pkg/speech/augmentation/SoundEffectUtil.h"
-#include "flashlight/pkg/speech/augmentation/SoxWrapper.h"
 
 namespace fl {
 namespace pkg {
 namespace speech {
 namespace sfx {
 
-#ifdef FL_BUILD_APP_ASR_SFX_SOX
-
 /**
- * Stretches signal within specified ratio range using libSOX as backend.
+ * Stretches signal within specified ratio range using WSOLA
+ * (waveform-similarity overlap-add): overlapping windows are recopied at a
+ * scaled hop, with each window's source position refined by a short
+ * cross-correlation search so the overlaps stay phase-aligned. Pitch is
+ * preserved. The implementation is self-contained and thread-safe -- unlike
+ * the libsox-based version it replaced, concurrent loader threads don't
+ * serialize on global effect state.
  */
 class TimeStretch : public SoundEffect {
  public:
@@ -49,37 +53,9 @@ class TimeStretch : public SoundEffect {
  private:
   const TimeStretch::Config conf_;
   RandomNumberGenerator rng_;
-  // The next 2 pointers are kept for optimization and readability.
-  // They point to existing objects that are not constructed or
-  // destroyed by this class
-  SoxWrapper const* sox_;
-  const sox_effect_handler_t* stretchEffect_;
-};
-
-#else /* ifdef FL_BUILD_APP_ASR_SFX_SOX */
-// Definition with null implementation to stub out TimeStretch
-// when building sound effects without libsox.
-class TimeStretch : public SoundEffect {
- public:
-  struct Config {
-    float proba_;
-    double minFactor_;
-    double maxFactor_;
-    size_t sampleRate_;
-    std::string prettyString() const {
-      return "";
-    }
-  };
-  explicit TimeStretch(
-      const TimeStretch::Config& config,
-      unsigned int seed = 0) {}
-  ~TimeStretch() override = default;
-  void apply(std::vector<float>& data) override {}
-  std::string prettyString() const override {
-    return "";
-  }
+  // guards rng_ -- apply() may be called from concurrent loader threads
+  std::mutex mutex_;
 };
-#endif
 
 } // namespace sfx
 } // namespace speech
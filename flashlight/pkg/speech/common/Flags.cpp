@@ -60,18 +60,29 @@ DEFINE_string(
 DEFINE_string(
     batching_strategy,
     "none",
-    "Batching strategy to use, supports {'none', 'dynamic', 'rand', 'randdynamic'}. "
+    "Batching strategy to use, supports {'none', 'dynamic', 'rand', "
+    "'randdynamic', 'bucket'}. "
     "When using 'none' strategy then batches of size 'batchsize' are created. "
     "When using 'dynamic' batching for training, 'batchsize' will be ignored "
     "and 'max_tokens' will be used to compute the effective batch size. "
     "To use unordered input data to pack batches, use either 'rand' "
     "or 'randdynamic' which shuffles data before packing, "
-    " then follows the same packing strategies as 'none' or 'dynamic', respectively.");
+    " then follows the same packing strategies as 'none' or 'dynamic', "
+    "respectively. "
+    "'bucket' groups length-sorted samples into variable-size batches under "
+    "the same token budget and deals whole batches round-robin across ranks.");
 DEFINE_int64(
     batching_max_duration,
     0,
     "Maximum number of tokens/frames in the batch when using 'dynamic' batching strategy. "
     "Measured with the same unit as input sizes are specified in data list files");
+DEFINE_string(
+    feature_cache_dir,
+    "",
+    "Directory for the on-disk input feature cache, populated lazily during "
+    "the first epoch so later epochs skip featurization. Empty disables "
+    "caching. Ignored for the training set when 'sfx_config' is set, as "
+    "augmented features are not cacheable.");
 DEFINE_bool(
     usewordpiece,
     false,
@@ -474,6 +485,11 @@ DEFINE_int32(
     lm_memory,
     5000,
     "[decode] Total memory size for batch forming for 'convlm' LM forward pass");
+DEFINE_int64(
+    lm_cache_bytes,
+    0,
+    "[decode] Byte budget for the per-prefix 'convlm' LM score cache; "
+    "0 disables caching");
 
 DEFINE_int32(
     emission_queue_size,
@@ -77,6 +77,7 @@ DECLARE_int64(channels);
 DECLARE_string(tokens);
 DECLARE_string(batching_strategy);
 DECLARE_int64(batching_max_duration);
+DECLARE_string(feature_cache_dir);
 DECLARE_bool(usewordpiece);
 DECLARE_int64(replabel);
 DECLARE_string(surround);
@@ -211,6 +212,7 @@ DECLARE_int32(beamsizetoken);
 DECLARE_int32(nthread_decoder_am_forward);
 DECLARE_int32(nthread_decoder);
 DECLARE_int32(lm_memory);
+DECLARE_int64(lm_cache_bytes);
 
 DECLARE_int32(emission_queue_size);
 
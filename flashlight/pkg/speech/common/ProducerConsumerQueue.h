@@ -79,6 +79,27 @@ class ProducerConsumerQueue {
     consumerCondition_.notify_one();
   }
 
+  /*
+   * - Adds an element to the queue without blocking.
+   * - Returns false when the queue is full or adding is finished, leaving
+   *   the element dropped.
+   * - Notifies another producer when queue is not full.
+   * - Notifies a consumer.
+   */
+  bool tryAdd(T unit) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (isFull() || isAddingFinished_) {
+      return false;
+    }
+    queue_.push(std::move(unit));
+
+    if (!isFull()) {
+      producerCondition_.notify_one();
+    }
+    consumerCondition_.notify_one();
+    return true;
+  }
+
   /*
    * - Pops an element from the queue.
    * - Returns false when adding is finished and queue is empty.
@@ -10,6 +10,8 @@
 
 #include <flashlight/lib/sequence/criterion/cpu/ConnectionistTemporalClassificationCriterion.h>
 
+#include "flashlight/pkg/speech/criterion/CriterionUtils.h"
+
 using CTC = fl::lib::cpu::ConnectionistTemporalClassificationCriterion<float>;
 
 namespace {
@@ -19,7 +21,7 @@ using namespace fl;
 struct CTCContext {
   std::vector<int> targetVec;
   std::vector<int> targetSizeVec;
-  std::vector<uint8_t> workspaceVec;
+  fl::pkg::speech::WorkspaceLease workspace;
 };
 
 Tensor logSoftmax(const Tensor& input, const int dim) {
@@ -88,7 +90,7 @@ Tensor ConnectionistTemporalClassificationCriterion::viterbiPathWithTarget(
   std::vector<float> inputVec = softmax.toHostVector<float>();
   ctx->targetVec = target.toHostVector<int>();
   ctx->targetSizeVec = targetSize.toHostVector<int>();
-  ctx->workspaceVec.assign(CTC::getWorkspaceSize(B, T, N, L), 0);
+  ctx->workspace = leaseWorkspace(CTC::getWorkspaceSize(B, T, N, L));
   std::vector<int> bestPaths(B * T);
   CTC::viterbi(
       B,
@@ -99,7 +101,7 @@ Tensor ConnectionistTemporalClassificationCriterion::viterbiPathWithTarget(
       ctx->targetVec.data(),
       ctx->targetSizeVec.data(),
       bestPaths.data(),
-      ctx->workspaceVec.data());
+      ctx->workspace.data());
   Tensor result =
       Tensor::fromBuffer({T, B}, bestPaths.data(), MemoryLocation::Host);
   return result;
@@ -9,13 +9,60 @@
 
 #include <algorithm>
 #include <cmath>
+#include <mutex>
 
 #include "flashlight/fl/tensor/Index.h"
 
 using fl::lib::seq::CriterionScaleMode;
 
+namespace {
+
+std::mutex workspacePoolMutex;
+std::vector<std::unique_ptr<std::vector<uint8_t>>>& workspacePool() {
+  static std::vector<std::unique_ptr<std::vector<uint8_t>>> pool;
+  return pool;
+}
+
+} // namespace
+
 namespace fl::pkg::speech {
 
+WorkspaceLease leaseWorkspace(size_t size) {
+  std::unique_ptr<std::vector<uint8_t>> buffer;
+  {
+    std::lock_guard<std::mutex> lock(workspacePoolMutex);
+    auto& pool = workspacePool();
+    // best fit: the smallest free buffer whose capacity covers the request;
+    // if none is big enough, grow the smallest one instead of hoarding it
+    auto best = pool.end();
+    for (auto it = pool.begin(); it != pool.end(); ++it) {
+      if ((*it)->capacity() >= size &&
+          (best == pool.end() || (*it)->capacity() < (*best)->capacity())) {
+        best = it;
+      }
+    }
+    if (best == pool.end()) {
+      best = std::min_element(
+          pool.begin(), pool.end(), [](const auto& a, const auto& b) {
+            return a->capacity() < b->capacity();
+          });
+    }
+    if (best != pool.end()) {
+      buffer = std::move(*best);
+      pool.erase(best);
+    }
+  }
+  if (!buffer) {
+    buffer = std::make_unique<std::vector<uint8_t>>();
+  }
+  buffer->assign(size, 0); // reallocates only when capacity is insufficient
+  return WorkspaceLease(std::shared_ptr<std::vector<uint8_t>>(
+      buffer.release(), [](std::vector<uint8_t>* released) {
+        std::lock_guard<std::mutex> lock(workspacePoolMutex);
+        workspacePool().emplace_back(released);
+      }));
+}
+
 int countRepeats(const int* labels, int len) {
   int r = 0;
   for (int i = 1; i < len; ++i) {
@@ -10,6 +10,8 @@
 #include <float.h>
 #include <stdint.h>
 #include <limits>
+#include <memory>
+#include <vector>
 
 #include "flashlight/fl/flashlight.h"
 
@@ -79,6 +81,41 @@ dLogSumExp(T in1, T in2, T in3, T& d1, T& d2, T& d3, const float scale) {
   d3 += scale * (in3 / Z);
 }
 
+/**
+ * A host workspace buffer leased from a process-wide pool. The buffer is
+ * returned to the pool when the last copy of the lease is destroyed, so the
+ * criterion DP workspaces — leased in forward and held by the backward
+ * closure — are recycled across training steps instead of being
+ * malloc/free'd on every batch.
+ */
+class WorkspaceLease {
+ public:
+  WorkspaceLease() = default;
+
+  uint8_t* data() const {
+    return buffer_ ? buffer_->data() : nullptr;
+  }
+
+  size_t size() const {
+    return buffer_ ? buffer_->size() : 0;
+  }
+
+ private:
+  friend WorkspaceLease leaseWorkspace(size_t size);
+  explicit WorkspaceLease(std::shared_ptr<std::vector<uint8_t>> buffer)
+      : buffer_(std::move(buffer)) {}
+
+  std::shared_ptr<std::vector<uint8_t>> buffer_;
+};
+
+/**
+ * Lease a zero-initialized host workspace of `size` bytes. Free buffers are
+ * matched best-fit by capacity and grown in place when none is large enough,
+ * so steady-state training converges to a fixed set of allocations sized by
+ * the largest batch seen.
+ */
+WorkspaceLease leaseWorkspace(size_t size);
+
 int countRepeats(const int* labels, int len);
 
 int getTargetSize(const int* labels, int len);
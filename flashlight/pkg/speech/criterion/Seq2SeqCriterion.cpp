@@ -8,7 +8,6 @@
 #include "flashlight/pkg/speech/criterion/Seq2SeqCriterion.h"
 
 #include <algorithm>
-#include <numeric>
 #include <queue>
 #include <stdexcept>
 
@@ -308,21 +307,40 @@ std::pair<Tensor, Variable> Seq2SeqCriterion::viterbiPathBase(
   Seq2SeqState state(nAttnRound_);
   Variable y, ox;
   Tensor maxIdx, maxValues;
-  int pred;
-  for (int u = 0; u < maxDecoderOutputLen_; u++) {
+  // The argmax feeds the next step directly on device, and predictions are
+  // only read back once per chunk, so greedy decoding stalls on a host
+  // synchronization kDecodeChunkSize times less often. Steps decoded past an
+  // EOS inside a chunk are discarded on readback.
+  constexpr size_t kDecodeChunkSize = 8;
+  std::vector<Tensor> chunk;
+  bool reachedEos = false;
+  for (int u = 0; u < maxDecoderOutputLen_ && !reachedEos; u++) {
     std::tie(ox, state) = decodeStep(
         Variable(input, false), y, state, inputSizes, Tensor(), input.dim(1));
     fl::max(maxValues, maxIdx, ox.tensor(), 0);
-    pred = maxIdx.asScalar<int>();
+    y = Variable(fl::reshape(maxIdx, {1}).astype(fl::dtype::s32), false);
     if (saveAttn) {
       alphaVec.push_back(state.alpha);
     }
-
-    if (pred == eos_) {
-      break;
+    chunk.push_back(maxIdx);
+
+    if (chunk.size() == kDecodeChunkSize || u == maxDecoderOutputLen_ - 1) {
+      const auto preds = fl::concatenate(chunk, 0)
+                             .astype(fl::dtype::s32)
+                             .toHostVector<int>();
+      chunk.clear();
+      for (size_t k = 0; k < preds.size(); ++k) {
+        if (preds[k] == eos_) {
+          reachedEos = true;
+          if (saveAttn) {
+            // drop attention for the steps decoded past the EOS
+            alphaVec.resize(alphaVec.size() - (preds.size() - (k + 1)));
+          }
+          break;
+        }
+        maxPath.push_back(preds[k]);
+      }
     }
-    y = constant(pred, {1}, fl::dtype::s32, false);
-    maxPath.push_back(pred);
   }
   if (saveAttn) {
     alpha = concatenate(alphaVec, 0);
@@ -405,18 +423,16 @@ std::vector<Seq2SeqCriterion::CandidateHypo> Seq2SeqCriterion::beamSearch(
 
     scoreArr = scoreArr + ox.tensor(); // C x B
     scoreArr = scoreArr.flatten(); // column-first
-    auto scoreVec = scoreArr.toHostVector<float>();
-
-    std::vector<size_t> indices(scoreVec.size());
-    std::iota(indices.begin(), indices.end(), 0);
-    std::partial_sort(
-        indices.begin(),
-        indices.begin() +
-            std::min(2 * beamSize, static_cast<int>(scoreVec.size())),
-        indices.end(),
-        [&scoreVec](size_t i1, size_t i2) {
-          return scoreVec[i1] > scoreVec[i2];
-        });
+
+    // select the candidates on the device and move only the top
+    // 2 * beamSize scores to the host instead of all C x B of them;
+    // 2 * beamSize is enough since at most beamSize of them can be eos
+    int nCandidates =
+        std::min(2 * beamSize, static_cast<int>(scoreArr.elements()));
+    Tensor topValues, topIndices;
+    fl::topk(topValues, topIndices, scoreArr, nCandidates, 0);
+    auto scoreVec = topValues.toHostVector<float>();
+    auto indices = topIndices.toHostVector<int>();
 
     int nClass = ox.dim(0);
     for (int j = 0; j < indices.size(); j++) {
@@ -427,10 +443,10 @@ std::vector<Seq2SeqCriterion::CandidateHypo> Seq2SeqCriterion::beamSearch(
       if (j < beamSize && clsIdx == eos_) {
         path_.pop_back();
         complete.emplace_back(
-            scoreVec[indices[j]], path_, detail::selectState(state, hypIdx));
+            scoreVec[j], path_, detail::selectState(state, hypIdx));
       } else if (clsIdx != eos_) {
         newBeam.emplace_back(
-            scoreVec[indices[j]], path_, detail::selectState(state, hypIdx));
+            scoreVec[j], path_, detail::selectState(state, hypIdx));
       }
       if (newBeam.size() >= beamSize) {
         break;
@@ -205,26 +205,26 @@ std::pair<Variable, TS2SState> TransformerCriterion::decodeStep(
     hy = tile(startEmbedding(), {1, 1, xEncoded.dim(2)});
   } else {
     hy = embedding()->forward(y);
+    if (hy.ndim() == 2) {
+      // tokens come in as a flat vector; the decoder layers expect C x T x B
+      hy = moddims(hy, {hy.dim(0), hy.dim(1), 1});
+    }
   }
 
   // TODO: inputFeeding
 
   TS2SState outState;
   outState.step = inState.step + 1;
-  Tensor padMask; // no mask because we are doing step by step decoding here,
-                  // no look in the future
+  // reuse and extend the caches of the input state: only the key/value
+  // projections of the new step are computed, so the per-step cost is
+  // linear in the prefix length
+  outState.kvCache = inState.kvCache;
+  outState.kvCache.resize(nLayer_);
   for (int i = 0; i < nLayer_; i++) {
-    if (inState.step == 0) {
-      outState.hidden.push_back(hy);
-      hy = layer(i)
-               ->forward(std::vector<Variable>({hy, fl::noGrad(padMask)}))
-               .front();
-    } else {
-      outState.hidden.push_back(concatenate({inState.hidden[i], hy}, 1));
-      hy = layer(i)
-               ->forward({inState.hidden[i], hy, fl::noGrad(padMask)})
-               .front();
+    if (!outState.kvCache[i]) {
+      outState.kvCache[i] = std::make_shared<TransformerKVCache>();
     }
+    hy = layer(i)->decodeStep(hy, *outState.kvCache[i]);
   }
 
   Variable windowWeight, alpha, summary;
@@ -250,6 +250,196 @@ std::pair<Variable, TS2SState> TransformerCriterion::decodeStep(
   return std::make_pair(out, outState);
 }
 
+std::pair<Variable, TS2SState> TransformerCriterion::decodeMultiStep(
+    const Variable& xEncoded,
+    const Variable& ys,
+    const TS2SState& inState,
+    const Tensor& inputSizes) const {
+  if (window_ && (!train_ || trainWithWindow_)) {
+    throw std::runtime_error(
+        "TransformerCriterion::decodeMultiStep - windowed attention is not "
+        "supported for multi-token decoding steps");
+  }
+
+  Variable hy;
+  if (!ys.isEmpty()) {
+    hy = embedding()->forward(ys);
+    if (hy.ndim() == 2) {
+      hy = moddims(hy, {hy.dim(0), hy.dim(1), 1});
+    }
+  }
+  if (inState.step == 0) {
+    auto start = tile(startEmbedding(), {1, 1, xEncoded.dim(2)});
+    hy = hy.isEmpty() ? start : concatenate({start, hy}, 1);
+  }
+  if (hy.isEmpty()) {
+    throw std::invalid_argument(
+        "TransformerCriterion::decodeMultiStep - ys may only be empty for "
+        "the initial state");
+  }
+
+  TS2SState outState;
+  outState.step = inState.step + hy.dim(1);
+  outState.kvCache = inState.kvCache;
+  outState.kvCache.resize(nLayer_);
+  for (int i = 0; i < nLayer_; i++) {
+    if (!outState.kvCache[i]) {
+      outState.kvCache[i] = std::make_shared<TransformerKVCache>();
+    }
+    // appends all fed positions to the cache at once; the layer masks the
+    // new positions causally against each other
+    hy = layer(i)->decodeStep(hy, *outState.kvCache[i]);
+  }
+
+  Variable alpha, summary;
+  std::tie(alpha, summary) = attention()->forward(
+      hy, xEncoded, Variable(), Variable(), fl::noGrad(inputSizes));
+
+  hy = hy + summary;
+
+  auto out = linearOut()->forward(hy);
+  return std::make_pair(out, outState);
+}
+
+void TransformerCriterion::truncateState(TS2SState& state, int step) {
+  if (step < 0 || step > state.step) {
+    throw std::invalid_argument(
+        "TransformerCriterion::truncateState - step must be within the "
+        "state's decoded length");
+  }
+  for (auto& cache : state.kvCache) {
+    if (cache) {
+      cache->length = std::min(cache->length, step);
+    }
+  }
+  state.step = step;
+}
+
+Tensor TransformerCriterion::viterbiPathSpeculative(
+    const Tensor& input,
+    TransformerCriterion& draft,
+    int draftTokens /* = 4 */,
+    const Tensor& inputSizes /* = Tensor() */) {
+  if (draftTokens < 1) {
+    throw std::invalid_argument(
+        "TransformerCriterion::viterbiPathSpeculative - draftTokens must be "
+        "positive");
+  }
+  if (draft.nClass_ != nClass_ || draft.eos_ != eos_) {
+    throw std::invalid_argument(
+        "TransformerCriterion::viterbiPathSpeculative - draft model must "
+        "share the token set of the main model");
+  }
+  if (input.ndim() == 3 && input.dim(2) != 1) {
+    throw std::invalid_argument(
+        "TransformerCriterion::viterbiPathSpeculative - only batch 1 is "
+        "supported");
+  }
+
+  const bool wasTrain = train_;
+  const bool draftWasTrain = draft.train_;
+  eval();
+  draft.eval();
+
+  const Variable x(input, false);
+  std::vector<int> path;
+  TS2SState mainState, draftState;
+  int pendingTok = -1; // last emitted token, not yet consumed by either model
+  bool hasPending = false;
+  bool done = false;
+
+  auto greedyTokens = [](const Variable& out) {
+    Tensor maxValues, maxIdx;
+    fl::max(maxValues, maxIdx, out.tensor(), 0);
+    return maxIdx.astype(fl::dtype::s32).toHostVector<int>();
+  };
+
+  while (!done && static_cast<int>(path.size()) < maxDecoderOutputLen_) {
+    const int stepBefore = mainState.step;
+
+    // 1. the draft proposes up to draftTokens tokens, one sequential step
+    // at a time -- cheap because the draft is small
+    std::vector<int> drafts;
+    Variable dy = hasPending
+        ? constant(pendingTok, {1}, fl::dtype::s32, false)
+        : Variable();
+    Variable dox;
+    while (static_cast<int>(drafts.size()) < draftTokens) {
+      std::tie(dox, draftState) =
+          draft.decodeStep(x, dy, draftState, inputSizes);
+      const int pred = greedyTokens(dox).front();
+      drafts.push_back(pred);
+      if (pred == eos_) {
+        break;
+      }
+      dy = constant(pred, {1}, fl::dtype::s32, false);
+    }
+    if (drafts.back() != eos_) {
+      // consume the last proposal too, so both models sit at the same
+      // position and can be rolled back together
+      std::tie(dox, draftState) =
+          draft.decodeStep(x, dy, draftState, inputSizes);
+    }
+
+    // 2. verify all proposals with one batched forward of the main model:
+    // position i checks drafts[i], and the final position yields the next
+    // token after the accepted prefix (a correction or a bonus token)
+    std::vector<int> feed;
+    if (hasPending) {
+      feed.push_back(pendingTok);
+    }
+    feed.insert(feed.end(), drafts.begin(), drafts.end());
+    Variable ys(Tensor::fromVector(feed), false);
+    Variable vox;
+    TS2SState verifiedState;
+    std::tie(vox, verifiedState) =
+        decodeMultiStep(x, ys, mainState, inputSizes);
+    const auto greedy = greedyTokens(vox);
+
+    // 3. accept the longest matching prefix, then the main model's own
+    // token for the first disagreeing position
+    size_t accepted = 0;
+    while (accepted < drafts.size() && drafts[accepted] == greedy[accepted]) {
+      ++accepted;
+    }
+    for (size_t i = 0; i < accepted && !done; i++) {
+      if (drafts[i] == eos_ ||
+          static_cast<int>(path.size()) >= maxDecoderOutputLen_) {
+        done = true;
+        break;
+      }
+      path.push_back(drafts[i]);
+    }
+    if (!done) {
+      const int next = greedy[accepted];
+      if (next == eos_ ||
+          static_cast<int>(path.size()) >= maxDecoderOutputLen_) {
+        done = true;
+      } else {
+        pendingTok = next;
+        hasPending = true;
+      }
+    }
+
+    // 4. roll both models back to the accepted prefix; rejected cache
+    // entries are just length to be overwritten by the next block
+    if (!done) {
+      mainState = verifiedState;
+      truncateState(mainState, stepBefore + 1 + accepted);
+      truncateState(draftState, stepBefore + 1 + accepted);
+    }
+  }
+
+  if (wasTrain) {
+    train();
+  }
+  if (draftWasTrain) {
+    draft.train();
+  }
+
+  return path.empty() ? Tensor() : Tensor::fromVector(path);
+}
+
 std::pair<std::vector<std::vector<float>>, std::vector<TS2SStatePtr>>
 TransformerCriterion::decodeBatchStep(
     const fl::Variable& xEncoded,
@@ -274,27 +464,34 @@ TransformerCriterion::decodeBatchStep(
   for (int i = 0; i < B; i++) {
     outstates[i] = std::make_shared<TS2SState>();
     outstates[i]->step = inStates[i]->step + 1;
+    outstates[i]->kvCache.resize(nLayer_);
   }
 
-  Variable outStateBatched;
   for (int i = 0; i < nLayer_; i++) {
-    if (inStates[0]->step == 0) {
+    // gather the per-hypothesis key/value caches into one batch, run a
+    // single cached decoding step for all hypotheses, then scatter the
+    // extended caches back
+    TransformerKVCache batchedCache;
+    if (inStates[0]->step > 0) {
+      std::vector<Tensor> keys(B), values(B);
       for (int j = 0; j < B; j++) {
-        outstates[j]->hidden.push_back(yBatched(fl::span, fl::span, j));
+        const auto& cache = *inStates[j]->kvCache[i];
+        keys[j] = cache.keys(fl::range(0, cache.length));
+        values[j] = cache.values(fl::range(0, cache.length));
+        batchedCache.length = cache.length;
       }
-      yBatched = layer(i)->forward(std::vector<Variable>({yBatched})).front();
-    } else {
-      std::vector<Variable> statesVector(B);
-      for (int j = 0; j < B; j++) {
-        statesVector[j] = inStates[j]->hidden[i];
-      }
-      Variable inStateHiddenBatched = concatenate(statesVector, 2);
-      auto tmp = std::vector<Variable>({inStateHiddenBatched, yBatched});
-      auto tmp2 = concatenate(tmp, 1);
-      for (int j = 0; j < B; j++) {
-        outstates[j]->hidden.push_back(tmp2(fl::span, fl::span, j));
-      }
-      yBatched = layer(i)->forward(tmp).front();
+      batchedCache.keys = fl::concatenate(keys, 2);
+      batchedCache.values = fl::concatenate(values, 2);
+    }
+    yBatched = layer(i)->decodeStep(yBatched, batchedCache);
+    for (int j = 0; j < B; j++) {
+      auto cache = std::make_shared<TransformerKVCache>();
+      cache->keys = batchedCache.keys(
+          fl::range(0, batchedCache.length), fl::span, fl::range(j, j + 1));
+      cache->values = batchedCache.values(
+          fl::range(0, batchedCache.length), fl::span, fl::range(j, j + 1));
+      cache->length = batchedCache.length;
+      outstates[j]->kvCache[i] = cache;
     }
   }
 
@@ -395,7 +592,7 @@ EmittingModelUpdateFunc buildSeq2SeqTransformerUpdateFunction(
                 (lastIndexOfStatePtr.find(prevState) ==
                      lastIndexOfStatePtr.end() ||
                  lastIndexOfStatePtr.find(prevState)->second == i)) {
-              prevState->hidden.clear();
+              prevState->kvCache.clear();
             }
           }
           start += step;
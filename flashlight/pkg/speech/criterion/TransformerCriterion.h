@@ -22,7 +22,10 @@ namespace speech {
 
 struct TS2SState {
   fl::Variable alpha;
-  std::vector<fl::Variable> hidden;
+  // per-decoder-layer self-attention key/value cache, extended in place by
+  // each decoding step; states produced by `decodeStep` share their caches
+  // with the input state, so only the most recent state may be extended
+  std::vector<std::shared_ptr<fl::TransformerKVCache>> kvCache;
   fl::Variable summary;
   int step;
 
@@ -71,6 +74,47 @@ class TransformerCriterion : public SequenceCriterion {
       const TS2SState& inState,
       const Tensor& inputSizes) const;
 
+  /**
+   * Runs the decoder over a block of tokens in one forward, as if
+   * `decodeStep` had been called once per token, by appending all of them
+   * to the key/value caches at once (with causal masking among the new
+   * positions). `ys` holds the token ids as a flat vector; when `inState`
+   * is the initial state, the start embedding is prepended to the embedded
+   * tokens. Returns the output logits for every fed position (C x U x B)
+   * and the advanced state — this is the batched verification forward for
+   * speculative decoding. Windowed attention is unsupported on this path.
+   */
+  std::pair<fl::Variable, TS2SState> decodeMultiStep(
+      const fl::Variable& xEncoded,
+      const fl::Variable& ys,
+      const TS2SState& inState,
+      const Tensor& inputSizes) const;
+
+  /**
+   * Rolls `state` back to `step` decoded positions, discarding cached
+   * entries past it. Cheap: the key/value caches are preallocated and
+   * extended in place, so rollback just shortens their valid length. Note
+   * states produced by `decodeStep`/`decodeMultiStep` share caches with
+   * their input state, so truncation affects all sharers.
+   */
+  static void truncateState(TS2SState& state, int step);
+
+  /**
+   * Greedy decoding with draft-model speculation: `draft` (a smaller,
+   * compatible criterion) proposes up to `draftTokens` tokens ahead one at
+   * a time, which are verified with a single batched forward of this model
+   * through `decodeMultiStep`; matching proposals are accepted wholesale
+   * and a mismatch rolls both states back via `truncateState`. Produces
+   * the same path as `viterbiPath` while running this model's sequential
+   * decode once per accepted block instead of once per token. Batch 1
+   * inputs only.
+   */
+  Tensor viterbiPathSpeculative(
+      const Tensor& input,
+      TransformerCriterion& draft,
+      int draftTokens = 4,
+      const Tensor& inputSizes = Tensor());
+
   std::pair<std::vector<std::vector<float>>, std::vector<TS2SStatePtr>>
   decodeBatchStep(
       const fl::Variable& xEncoded,
@@ -10,6 +10,7 @@
 #include <cmath>
 
 #include "flashlight/fl/tensor/Index.h"
+#include "flashlight/pkg/speech/criterion/attention/Defines.h"
 #include "flashlight/pkg/speech/criterion/attention/Utils.h"
 
 namespace fl::pkg::speech {
@@ -32,6 +33,55 @@ std::pair<Variable, Variable> ContentAttention::forwardBase(
   }
   auto keys = keyValue_ ? xEncoded(fl::range(0, dim / 2)) : xEncoded;
   auto values = keyValue_ ? xEncoded(fl::range(dim / 2, dim)) : xEncoded;
+
+  // Decode-time windowed attention: when a hard window mask (e.g. from
+  // MedianWindow/StepWindow) admits only a slice of the input, restrict the
+  // QK matmul to that slice instead of scoring every frame and masking the
+  // scores afterwards. Soft masks keep every frame valid and fall through.
+  const int T = xEncoded.dim(1);
+  const int B = xEncoded.dim(2);
+  if (!logAttnWeight.isEmpty() && state.dim(1) == 1 &&
+      logAttnWeight.shape() == Shape({1, T, B})) {
+    // frames masked out for every batch element never need scoring
+    auto valid =
+        fl::any(logAttnWeight.tensor() > 0.5f * kAttentionMaskValue, {0, 2})
+            .astype(fl::dtype::u8)
+            .toHostVector<uint8_t>();
+    int lo = 0;
+    while (lo < T && !valid[lo]) {
+      ++lo;
+    }
+    int hi = T;
+    while (hi > lo && !valid[hi - 1]) {
+      --hi;
+    }
+    if (lo < hi && hi - lo < T) {
+      auto keysW = keys(fl::span, fl::range(lo, hi));
+      auto innerProdW = matmulTN(state, keysW) / std::sqrt(state.dim(0));
+      // the window mask already accounts for padding, so it is applied alone
+      innerProdW = innerProdW + logAttnWeight(fl::span, fl::range(lo, hi));
+      // [1, windowsize, batchsize]
+      auto attentionW = softmax(innerProdW, 1);
+      // [hiddendim, 1, batchsize]
+      auto summaries =
+          matmulNT(values(fl::span, fl::range(lo, hi)), attentionW);
+      // pad back to [1, seqlen, batchsize] so callers see the full map
+      std::vector<Variable> parts;
+      if (lo > 0) {
+        parts.push_back(
+            Variable(fl::full({1, lo, B}, 0., attentionW.type()), false));
+      }
+      parts.push_back(attentionW);
+      if (hi < T) {
+        parts.push_back(
+            Variable(fl::full({1, T - hi, B}, 0., attentionW.type()), false));
+      }
+      auto attention =
+          parts.size() == 1 ? attentionW : concatenate(parts, 1);
+      return std::make_pair(attention, summaries);
+    }
+  }
+
   // [targetlen, seqlen, batchsize]
   auto innerProd = matmulTN(state, keys) / std::sqrt(state.dim(0));
   if (!logAttnWeight.isEmpty()) {
@@ -43,10 +93,10 @@ std::pair<Variable, Variable> ContentAttention::forwardBase(
   }
   Tensor padMask;
   if (!xEncodedSizes.isEmpty()) {
-    innerProd = maskAttention(innerProd, xEncodedSizes);
+    padMask = attentionPadMask(innerProd.shape(), xEncodedSizes.tensor());
   }
-  // [targetlen, seqlen, batchsize]
-  auto attention = softmax(innerProd, 1);
+  // [targetlen, seqlen, batchsize] - masking fuses into the softmax node
+  auto attention = softmax(innerProd, 1, padMask);
   // [hiddendim, targetlen, batchsize]
   auto summaries = matmulNT(values, attention);
   return std::make_pair(attention, summaries);
@@ -97,11 +147,12 @@ std::pair<Variable, Variable> NeuralContentAttention::forwardBase(
     nnOut = nnOut + logAttnWeight;
   }
 
+  Tensor padMask;
   if (!xEncodedSizes.isEmpty()) {
-    nnOut = maskAttention(nnOut, xEncodedSizes);
+    padMask = attentionPadMask(nnOut.shape(), xEncodedSizes.tensor());
   }
-  // [targetlen, seqlen, batchsize]
-  auto attention = softmax(nnOut, 1);
+  // [targetlen, seqlen, batchsize] - masking fuses into the softmax node
+  auto attention = softmax(nnOut, 1, padMask);
   // [hiddendim, targetlen, batchsize]
   auto summaries = matmulNT(xEncoded, attention);
   return std::make_pair(attention, summaries);
@@ -90,14 +90,17 @@ std::pair<Variable, Variable> MultiHeadContentAttention::forwardBase(
     innerProd = innerProd + tiledLogAttnWeight;
   }
 
+  Tensor padMask;
   if (!xEncodedSizes.isEmpty()) {
-    innerProd = maskAttention(
-        innerProd,
-        moddims(tile(xEncodedSizes, {numHeads_, 1}), {1, B * numHeads_}));
+    padMask = attentionPadMask(
+        innerProd.shape(),
+        fl::reshape(
+            fl::tile(xEncodedSizes.tensor(), {numHeads_, 1}),
+            {1, B * numHeads_}));
   }
 
-  // [U, T, B * numHeads_]
-  auto attention = softmax(innerProd, 1);
+  // [U, T, B * numHeads_] - masking fuses into the softmax node
+  auto attention = softmax(innerProd, 1, padMask);
   // [U, hiddendim, B * numHeads_]
   auto summaries = matmul(attention, value);
   // [hiddendim * numHeads_, U, B];
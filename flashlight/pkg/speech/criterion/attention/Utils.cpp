@@ -35,4 +35,16 @@ Variable maskAttention(const Variable& input, const Variable& sizes) {
   return Variable(output, {input.withoutData()}, gradFunc);
 }
 
+Tensor attentionPadMask(const Shape& shape, const Tensor& sizes) {
+  int B = shape[2];
+  int T = shape[1];
+  // sizes is (1, B) size
+  Tensor inputNotPaddedSize =
+      fl::ceil(sizes / fl::amax(sizes).asScalar<float>() * T);
+  Tensor padMask =
+      fl::iota({T, 1}, {1, B}) >= fl::tile(inputNotPaddedSize, {T, 1});
+  return fl::reshape(padMask, {1, T, B}).astype(fl::dtype::f32) *
+      kAttentionMaskValue;
+}
+
 } // namespace fl
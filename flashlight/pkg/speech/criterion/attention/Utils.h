@@ -16,6 +16,13 @@ namespace speech {
 fl::Variable maskAttention(
     const fl::Variable& input,
     const fl::Variable& sizes);
+
+/**
+ * Builds the additive [1, seqlen, batchsize] padding mask for attention
+ * scores of the given shape: 0 at valid frames, `kAttentionMaskValue` at
+ * padded ones. Meant for the fused `fl::softmax` overload taking a mask.
+ */
+fl::Tensor attentionPadMask(const fl::Shape& shape, const fl::Tensor& sizes);
 } // namespace speech
 } // namespace pkg
 } // namespace fl
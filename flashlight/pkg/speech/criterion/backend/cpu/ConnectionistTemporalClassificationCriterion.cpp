@@ -7,6 +7,10 @@
 
 #include "flashlight/pkg/speech/criterion/ConnectionistTemporalClassificationCriterion.h"
 
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
 #include "flashlight/pkg/speech/criterion/CriterionUtils.h"
 
 #include <flashlight/lib/sequence/criterion/cpu/CriterionUtils.h>
@@ -27,26 +31,34 @@ std::vector<Variable> ConnectionistTemporalClassificationCriterion::forward(
   const auto& input = inputs[0];
   const auto& target = inputs[1];
   validate(input, target);
-  auto logprobs = logSoftmax(input, 0);
 
   std::vector<std::vector<float>> batchAlphas;
+  // per-frame log-softmax normalizers, computed on the fly inside the DP
+  // instead of materializing a full {N, T, B} log-softmax intermediate
+  std::vector<std::vector<float>> batchLogNorms;
   std::vector<float> batchLoss;
   std::vector<float> batchScales;
   std::vector<int> batchTargetSizes;
+  std::vector<int64_t> batchOrder;
   {
-    const int64_t N = logprobs.dim(0);
-    const int64_t T = logprobs.dim(1);
-    const int64_t B = logprobs.dim(2);
+    const int64_t N = input.dim(0);
+    const int64_t T = input.dim(1);
+    const int64_t B = input.dim(2);
     const int64_t batchL = target.dim(0);
 
     batchAlphas.resize(B);
+    batchLogNorms.resize(B);
     batchLoss.resize(B);
     batchScales.resize(B);
     batchTargetSizes.resize(B);
 
-    // get host pointers
-    std::vector<float> batchInputVec(logprobs.elements());
-    logprobs.host(batchInputVec.data());
+    // get host pointers; fp16 inputs are promoted once and the DP runs in f32
+    Tensor inputTensor = input.tensor();
+    if (inputTensor.type() == fl::dtype::f16) {
+      inputTensor = inputTensor.astype(fl::dtype::f32);
+    }
+    std::vector<float> batchInputVec(inputTensor.elements());
+    inputTensor.host(batchInputVec.data());
 
     std::vector<int> batchTargetVec(target.elements());
     target.host(batchTargetVec.data());
@@ -57,8 +69,18 @@ std::vector<Variable> ConnectionistTemporalClassificationCriterion::forward(
     CriterionUtils::computeScale(
         B, T, N, scaleMode_, batchTargetSizes.data(), batchScales.data());
 
-#pragma omp parallel for num_threads(B)
-    for (int64_t b = 0; b < B; ++b) {
+    // dispatch the longest utterances first so the dynamic schedule keeps
+    // threads busy when the batch mixes short and long label sequences
+    batchOrder.resize(B);
+    std::iota(batchOrder.begin(), batchOrder.end(), 0);
+    std::stable_sort(
+        batchOrder.begin(), batchOrder.end(), [&](int64_t a, int64_t c) {
+          return batchTargetSizes[a] > batchTargetSizes[c];
+        });
+
+#pragma omp parallel for schedule(dynamic)
+    for (int64_t i = 0; i < B; ++i) {
+      const int64_t b = batchOrder[i];
       const float* inputVec = batchInputVec.data() + b * N * T;
       const int* targetVec = batchTargetVec.data() + b * batchL;
 
@@ -71,6 +93,23 @@ std::vector<Variable> ConnectionistTemporalClassificationCriterion::forward(
       R = fl::pkg::speech::countRepeats(
           targetVec, L); // Recompute repeats as L has changed
 
+      // fused log-softmax: the DP only reads S of the N scores per frame, so
+      // normalize lazily with one max/log-sum-exp sweep per frame
+      auto& logNorms = batchLogNorms[b];
+      logNorms.resize(T);
+      for (int64_t t = 0; t < T; ++t) {
+        const float* frame = inputVec + t * N;
+        float maxVal = frame[0];
+        for (int64_t n = 1; n < N; ++n) {
+          maxVal = std::max(maxVal, frame[n]);
+        }
+        float sumExp = 0.0;
+        for (int64_t n = 0; n < N; ++n) {
+          sumExp += std::exp(frame[n] - maxVal);
+        }
+        logNorms[t] = maxVal + std::log(sumExp);
+      }
+
       auto& alphas = batchAlphas[b];
       alphas.resize(T * S, NEG_INFINITY_FLT);
 
@@ -78,9 +117,10 @@ std::vector<Variable> ConnectionistTemporalClassificationCriterion::forward(
       int64_t end = (S == 1) ? 1 : 2;
 
       // base case
-      alphas[0] = (start == 0) ? inputVec[N - 1] : NEG_INFINITY_FLT;
+      alphas[0] =
+          (start == 0) ? inputVec[N - 1] - logNorms[0] : NEG_INFINITY_FLT;
       if (S != 1) {
-        alphas[1] = inputVec[targetVec[0]];
+        alphas[1] = inputVec[targetVec[0]] - logNorms[0];
       }
       for (int64_t t = 1; t < T; ++t) {
         // At each time frame t, only few states can be reached depending
@@ -113,7 +153,7 @@ std::vector<Variable> ConnectionistTemporalClassificationCriterion::forward(
             alphas[ts] = fl::pkg::speech::logSumExp(
                 alphas[ts - S], alphas[ts - S - 1], alphas[ts - S - 2]);
           }
-          alphas[ts] += inputVec[curLabel];
+          alphas[ts] += inputVec[curLabel] - logNorms[t];
         }
       }
       batchLoss[b] = -fl::pkg::speech::logSumExp(
@@ -124,7 +164,11 @@ std::vector<Variable> ConnectionistTemporalClassificationCriterion::forward(
   }
   auto result = Tensor::fromVector(batchLoss);
 
-  auto gradFunc = [batchAlphas, batchScales, batchTargetSizes](
+  auto gradFunc = [batchAlphas,
+                   batchLogNorms,
+                   batchScales,
+                   batchTargetSizes,
+                   batchOrder](
                       std::vector<Variable>& moduleInputs,
                       const Variable& gradOutput) {
     const int64_t N = moduleInputs[0].dim(0);
@@ -134,14 +178,23 @@ std::vector<Variable> ConnectionistTemporalClassificationCriterion::forward(
 
     std::vector<float> batchInGrad(moduleInputs[0].elements(), 0.0);
 
+    Tensor inputTensor = moduleInputs[0].tensor();
+    if (inputTensor.type() == fl::dtype::f16) {
+      inputTensor = inputTensor.astype(fl::dtype::f32);
+    }
+    std::vector<float> batchInputVec(inputTensor.elements());
+    inputTensor.host(batchInputVec.data());
+
     std::vector<int> batchTargetVec(moduleInputs[1].elements());
     moduleInputs[1].host(batchTargetVec.data());
 
     std::vector<float> batchOutGrad(gradOutput.elements());
     gradOutput.host(batchOutGrad.data());
 
-#pragma omp parallel for num_threads(B)
-    for (int64_t b = 0; b < B; ++b) {
+#pragma omp parallel for schedule(dynamic)
+    for (int64_t i = 0; i < B; ++i) {
+      const int64_t b = batchOrder[i];
+      const float* inputVec = batchInputVec.data() + b * N * T;
       const int* targetVec = batchTargetVec.data() + b * batchL;
       float* grad = batchInGrad.data() + b * N * T;
 
@@ -153,6 +206,7 @@ std::vector<Variable> ConnectionistTemporalClassificationCriterion::forward(
 
       const int64_t S = 2 * L + 1;
       const auto& alphas = batchAlphas[b];
+      const auto& logNorms = batchLogNorms[b];
 
       int64_t start = (S == 1) ? S : S - 1;
       int64_t end = S;
@@ -219,11 +273,28 @@ std::vector<Variable> ConnectionistTemporalClassificationCriterion::forward(
           }
         }
       }
+
+      // Fold the log-softmax backward in directly: with g the gradient in
+      // log-probability space, dL/dz = g - softmax(z) * sum_n g[n] per frame
+      for (int64_t t = 0; t < T; ++t) {
+        float* gradFrame = grad + t * N;
+        const float* frame = inputVec + t * N;
+        float frameSum = 0.0;
+        for (int64_t n = 0; n < N; ++n) {
+          frameSum += gradFrame[n];
+        }
+        for (int64_t n = 0; n < N; ++n) {
+          gradFrame[n] -= std::exp(frame[n] - logNorms[t]) * frameSum;
+        }
+      }
+    }
+    auto inGrad = Tensor::fromVector({N, T, B}, batchInGrad);
+    if (inGrad.type() != moduleInputs[0].type()) {
+      inGrad = inGrad.astype(moduleInputs[0].type());
     }
-    moduleInputs[0].addGrad(
-        Variable(Tensor::fromVector({N, T, B}, batchInGrad), false));
+    moduleInputs[0].addGrad(Variable(inGrad, false));
   };
-  return {Variable(result, {logprobs, target}, gradFunc)};
+  return {Variable(result, {input, target}, gradFunc)};
 }
 } // namespace speech
 } // namespace pkg
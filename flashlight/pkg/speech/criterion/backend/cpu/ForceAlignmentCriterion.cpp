@@ -18,7 +18,7 @@ namespace {
 struct Context {
   std::vector<int> targetVec;
   std::vector<int> targetSizeVec;
-  std::vector<uint8_t> workspaceVec;
+  fl::pkg::speech::WorkspaceLease workspace;
 };
 } // namespace
 
@@ -52,7 +52,7 @@ static void backward(
       gradVec.data(),
       inputGradVec.data(),
       transGradVec.data(),
-      ctx->workspaceVec.data());
+      ctx->workspace.data());
 
   auto inputGrad = Tensor::fromVector({N, T, B}, inputGradVec);
   auto transGrad = Tensor::fromVector({N, N}, transGradVec);
@@ -88,7 +88,7 @@ Variable ForceAlignmentCriterion::forward(
   ctx->targetSizeVec = targetSize.toHostVector<int>();
   auto transVec = transVar.tensor().toHostVector<float>();
   std::vector<float> lossVec(B);
-  ctx->workspaceVec.assign(FAC::getWorkspaceSize(B, T, N, L), 0);
+  ctx->workspace = leaseWorkspace(FAC::getWorkspaceSize(B, T, N, L));
 
   FAC::forward(
       B,
@@ -101,7 +101,7 @@ Variable ForceAlignmentCriterion::forward(
       ctx->targetSizeVec.data(),
       transVec.data(),
       lossVec.data(),
-      ctx->workspaceVec.data());
+      ctx->workspace.data());
 
   return Variable(
       Tensor::fromVector(lossVec),
@@ -134,7 +134,7 @@ Tensor ForceAlignmentCriterion::viterbiPath(
   ctx->targetSizeVec = targetSize.toHostVector<int>();
   std::vector<float> transVec = trans.toHostVector<float>();
   std::vector<float> lossVec(B);
-  ctx->workspaceVec.assign(FAC::getWorkspaceSize(B, T, N, L), 0);
+  ctx->workspace = leaseWorkspace(FAC::getWorkspaceSize(B, T, N, L));
   std::vector<int> bestPaths(B * T);
   FAC::viterbi(
       B,
@@ -146,7 +146,7 @@ Tensor ForceAlignmentCriterion::viterbiPath(
       ctx->targetSizeVec.data(),
       transVec.data(),
       bestPaths.data(),
-      ctx->workspaceVec.data());
+      ctx->workspace.data());
   return Tensor::fromVector({T, B}, bestPaths);
 }
 } // namespace speech
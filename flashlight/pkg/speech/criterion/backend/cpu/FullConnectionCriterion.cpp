@@ -18,7 +18,7 @@ namespace {
 // By passing shared_ptr<Context> we avoid copies from forward to backward.
 struct Context {
   std::vector<float> transVec;
-  std::vector<uint8_t> workspaceVec;
+  fl::pkg::speech::WorkspaceLease workspace;
 };
 } // namespace
 
@@ -49,7 +49,7 @@ static void backward(
       gradVec.data(),
       inputGradVec.data(),
       transGradVec.data(),
-      ctx->workspaceVec.data());
+      ctx->workspace.data());
 
   Tensor inputGrad = Tensor::fromVector({N, T, B}, inputGradVec);
   Tensor transGrad = Tensor::fromVector({N, N}, transGradVec);
@@ -81,7 +81,7 @@ Variable FullConnectionCriterion::forward(
   auto targetSizeVec = targetSize.toHostVector<int>();
   ctx->transVec = transVar.tensor().toHostVector<float>();
   std::vector<float> lossVec(B);
-  ctx->workspaceVec.assign(FCC::getWorkspaceSize(B, T, N), 0);
+  ctx->workspace = leaseWorkspace(FCC::getWorkspaceSize(B, T, N));
 
   FCC::forward(
       B,
@@ -92,7 +92,7 @@ Variable FullConnectionCriterion::forward(
       targetSizeVec.data(),
       ctx->transVec.data(),
       lossVec.data(),
-      ctx->workspaceVec.data());
+      ctx->workspace.data());
 
   return Variable(
       Tensor::fromVector(lossVec),
@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "flashlight/pkg/speech/data/FeatureCache.h"
+
+#include <stdexcept>
+#include <vector>
+
+namespace fl::pkg::speech {
+
+FeatureCache::FeatureCache(const fs::path& name)
+    : FileBlobDataset(name, /* rw = */ true, /* truncate = */ false) {
+  // Rebuild the key map from the stored samples; each is {key, features}
+  // and only the 8-byte key field is read back.
+  for (int64_t i = 0; i < size(); ++i) {
+    const auto entries = getEntries(i);
+    if (entries.size() != 2 || entries[0].type != fl::dtype::u64) {
+      throw std::runtime_error(
+          "FeatureCache - blob is not a feature cache: " + name.string());
+    }
+    uint64_t key;
+    readData(entries[0].offset, reinterpret_cast<char*>(&key), sizeof(key));
+    keyToIndex_[key] = i;
+  }
+}
+
+FeatureCache::~FeatureCache() {
+  try {
+    writeIndex();
+  } catch (...) {
+    // a cache that fails to persist only costs recomputation
+  }
+}
+
+uint64_t FeatureCache::hashKey(
+    const std::string& handle,
+    const std::string& config) {
+  uint64_t hash = 14695981039346656037ULL;
+  for (char c : config) {
+    hash = (hash ^ static_cast<unsigned char>(c)) * 1099511628211ULL;
+  }
+  for (char c : handle) {
+    hash = (hash ^ static_cast<unsigned char>(c)) * 1099511628211ULL;
+  }
+  return hash;
+}
+
+Tensor FeatureCache::find(uint64_t key) const {
+  int64_t index;
+  {
+    std::lock_guard<std::mutex> lock(cacheMutex_);
+    auto iter = keyToIndex_.find(key);
+    if (iter == keyToIndex_.end()) {
+      return Tensor();
+    }
+    index = iter->second;
+  }
+  return get(index)[1];
+}
+
+void FeatureCache::insert(uint64_t key, const Tensor& features) {
+  std::lock_guard<std::mutex> lock(cacheMutex_);
+  if (keyToIndex_.find(key) != keyToIndex_.end()) {
+    return;
+  }
+  add({Tensor::fromVector(std::vector<uint64_t>{key}), features});
+  keyToIndex_[key] = size() - 1;
+}
+
+} // namespace fl::pkg::speech
@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "flashlight/fl/common/Filesystem.h"
+#include "flashlight/fl/dataset/FileBlobDataset.h"
+
+namespace fl {
+namespace pkg {
+namespace speech {
+
+/**
+ * A FileBlobDataset-backed store of computed input features.
+ *
+ * Entries are keyed by a 64-bit content hash of the audio handle and a
+ * string identifying the featurization, so a cache persists across restarts
+ * and stale entries are ignored when the feature settings change. Each blob
+ * sample holds the key and the feature tensor; the key map is rebuilt by
+ * scanning the blob index at open, and the index is written back when the
+ * cache is destroyed.
+ *
+ * Only deterministic features belong in the cache -- callers must leave
+ * caching disabled when augmentation is active. The store supports a single
+ * writing process; concurrent readers/writers within that process are fine.
+ */
+class FeatureCache : public fl::FileBlobDataset {
+ public:
+  explicit FeatureCache(const fs::path& name);
+
+  ~FeatureCache() override;
+
+  /**
+   * 64-bit FNV-1a hash of the feature configuration and audio handle.
+   */
+  static uint64_t hashKey(const std::string& handle, const std::string& config);
+
+  /**
+   * Returns the cached features stored under the key, or an empty Tensor.
+   */
+  Tensor find(uint64_t key) const;
+
+  /**
+   * Stores features under the key; a key already present is left unchanged.
+   */
+  void insert(uint64_t key, const Tensor& features);
+
+ private:
+  mutable std::mutex cacheMutex_;
+  std::unordered_map<uint64_t, int64_t> keyToIndex_;
+};
+
+} // namespace speech
+} // namespace pkg
+} // namespace fl
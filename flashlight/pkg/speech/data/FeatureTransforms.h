@@ -91,12 +91,23 @@ std::vector<T> transpose2d(
   if (in.size() != inRow * inCol * inBatch) {
     throw std::invalid_argument("Invalid input size");
   }
+  // Tiled transpose: walking both matrices one kBlockSize square at a time
+  // keeps the strided side of the copy within cached lines, instead of
+  // striding through the full matrix once per element. 32x32 float tiles fit
+  // comfortably in L1.
+  constexpr int64_t kBlockSize = 32;
   std::vector<T> out(in.size());
-  for (size_t b = 0; b < inBatch; ++b) {
+  for (int64_t b = 0; b < inBatch; ++b) {
     int64_t start = b * inRow * inCol;
-    for (size_t c = 0; c < inCol; ++c) {
-      for (size_t r = 0; r < inRow; ++r) {
-        out[start + c * inRow + r] = in[start + r * inCol + c];
+    for (int64_t cb = 0; cb < inCol; cb += kBlockSize) {
+      const int64_t cEnd = std::min(cb + kBlockSize, inCol);
+      for (int64_t rb = 0; rb < inRow; rb += kBlockSize) {
+        const int64_t rEnd = std::min(rb + kBlockSize, inRow);
+        for (int64_t c = cb; c < cEnd; ++c) {
+          for (int64_t r = rb; r < rEnd; ++r) {
+            out[start + c * inRow + r] = in[start + r * inCol + c];
+          }
+        }
       }
     }
   }
@@ -118,27 +129,38 @@ std::vector<T> localNormalize(
   int64_t perFrameSz = perBatchSz / frameSz;
   auto out(in);
   for (size_t b = 0; b < batchSz; ++b) {
-    std::vector<T> sum(frameSz, 0.0), sum2(frameSz, 0.0);
+    // per-frame totals in a single contiguous pass
+    std::vector<T> frameSum(frameSz, 0.0), frameSum2(frameSz, 0.0);
     int64_t curFrame = 0;
-    // accumulate sum, sum^2 for computing mean, stddev
     for (auto i = b * perBatchSz; i < (b + 1) * perBatchSz; ++i) {
-      auto start = std::max(curFrame - rightCtxSize, 0L);
-      auto end = std::min(curFrame + leftCtxSize, frameSz - 1);
-      for (int64_t j = start; j <= end; ++j) {
-        sum[j] += in[i];
-        sum2[j] += in[i] * in[i];
-      }
+      frameSum[curFrame] += in[i];
+      frameSum2[curFrame] += in[i] * in[i];
       curFrame = (curFrame + 1) % frameSz;
     }
-    // compute mean, stddev
-    for (auto j = 0; j < frameSz; ++j) {
-      int64_t N = (std::min(j + rightCtxSize, frameSz - 1) -
-                   std::max(j - leftCtxSize, 0L) + 1) *
-          perFrameSz;
-      sum[j] /= N;
-      sum2[j] /= N;
-      sum2[j] -= (sum[j] * sum[j]);
-      sum2[j] = std::sqrt(sum2[j]);
+    // slide the context window over the frame totals, adding the frame that
+    // enters on the right and subtracting the one that leaves on the left -
+    // O(frameSz) in total instead of O(frameSz * window)
+    std::vector<T> sum(frameSz), sum2(frameSz);
+    T runSum = 0.0, runSum2 = 0.0;
+    int64_t lo = 0, hi = -1;
+    for (int64_t j = 0; j < frameSz; ++j) {
+      const int64_t newLo = std::max(j - leftCtxSize, 0L);
+      const int64_t newHi = std::min(j + rightCtxSize, frameSz - 1);
+      while (hi < newHi) {
+        ++hi;
+        runSum += frameSum[hi];
+        runSum2 += frameSum2[hi];
+      }
+      while (lo < newLo) {
+        runSum -= frameSum[lo];
+        runSum2 -= frameSum2[lo];
+        ++lo;
+      }
+      int64_t N = (newHi - newLo + 1) * perFrameSz;
+      sum[j] = runSum / N;
+      // cancellation in the incremental update can leave a tiny negative
+      // variance where it is mathematically zero; clamp before the sqrt
+      sum2[j] = std::sqrt(std::max(runSum2 / N - sum[j] * sum[j], T(0.0)));
     }
     // perform local normalization
     curFrame = 0;
@@ -66,15 +66,7 @@ int64_t ListFileDataset::size() const {
 std::vector<Tensor> ListFileDataset::get(const int64_t idx) const {
   checkIndexBounds(idx);
 
-  auto audio = loadAudio(inputs_[idx]); // channels x time
-  Tensor input;
-  if (inFeatFunc_) {
-    input = inFeatFunc_(
-        static_cast<void*>(audio.first.data()), audio.second, fl::dtype::f32);
-  } else {
-    input = Tensor::fromBuffer(
-        {audio.second}, audio.first.data(), MemoryLocation::Host);
-  }
+  Tensor input = pipelinePool_ ? getPipelinedInput(idx) : loadInput(idx);
 
   Tensor target;
   if (tgtFeatFunc_) {
@@ -123,6 +115,86 @@ std::pair<std::vector<float>, Shape> ListFileDataset::loadAudio(
   return {loadSound<float>(handle.c_str()), {info.channels, info.frames}};
 }
 
+Tensor ListFileDataset::loadInput(const int64_t idx) const {
+  uint64_t cacheKey = 0;
+  if (featureCache_) {
+    cacheKey = FeatureCache::hashKey(inputs_[idx], featureConfig_);
+    auto cached = featureCache_->find(cacheKey);
+    if (!cached.isEmpty()) {
+      return cached;
+    }
+  }
+  auto audio = loadAudio(inputs_[idx]); // channels x time
+  if (!inFeatFunc_) {
+    return Tensor::fromBuffer(
+        {audio.second}, audio.first.data(), MemoryLocation::Host);
+  }
+  auto features = inFeatFunc_(
+      static_cast<void*>(audio.first.data()), audio.second, fl::dtype::f32);
+  if (featureCache_ && !features.isEmpty()) {
+    featureCache_->insert(cacheKey, features);
+  }
+  return features;
+}
+
+Tensor ListFileDataset::getPipelinedInput(const int64_t idx) const {
+  std::future<Tensor> inputFuture;
+  {
+    std::lock_guard<std::mutex> lock(pipelineMutex_);
+    auto cur = pipelineCache_.find(idx);
+    if (cur != pipelineCache_.end()) {
+      inputFuture = std::move(cur->second);
+      pipelineCache_.erase(cur);
+    }
+    // Drop readahead left stale by non-sequential access so the cache stays
+    // within the prefetch window; the orphaned tasks finish and their
+    // results are discarded.
+    for (auto it = pipelineCache_.begin(); it != pipelineCache_.end();) {
+      if (it->first <= idx || it->first > idx + pipelinePrefetchSize_) {
+        it = pipelineCache_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+    // Schedule the input pipeline for the samples expected next
+    for (int64_t fetchIdx = idx + 1;
+         fetchIdx <= idx + pipelinePrefetchSize_ && fetchIdx < numRows_;
+         ++fetchIdx) {
+      if (pipelineCache_.find(fetchIdx) == pipelineCache_.end()) {
+        pipelineCache_.emplace(
+            fetchIdx, pipelinePool_->enqueue([this, fetchIdx]() {
+              return this->loadInput(fetchIdx);
+            }));
+      }
+    }
+  }
+  if (inputFuture.valid()) {
+    return inputFuture.get();
+  }
+  return loadInput(idx);
+}
+
+void ListFileDataset::enableFeatureCaching(
+    const fs::path& cacheFile,
+    const std::string& featureConfig) {
+  featureCache_ = std::make_shared<FeatureCache>(cacheFile);
+  featureConfig_ = featureConfig;
+}
+
+void ListFileDataset::enablePipelinedLoading(
+    int64_t numThreads,
+    int64_t prefetchSize) {
+  if (numThreads <= 0 || prefetchSize <= 0) {
+    throw std::invalid_argument(
+        "ListFileDataset: invalid numThreads or prefetchSize");
+  }
+  auto deviceId = fl::getDevice();
+  pipelinePool_ = std::make_unique<ThreadPool>(
+      numThreads,
+      [deviceId](size_t /* threadId */) { fl::setDevice(deviceId); });
+  pipelinePrefetchSize_ = prefetchSize;
+}
+
 float ListFileDataset::getInputSize(const int64_t idx) const {
   checkIndexBounds(idx);
   return inputSizes_[idx];
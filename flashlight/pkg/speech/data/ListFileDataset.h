@@ -7,12 +7,16 @@
 
 #pragma once
 
+#include <future>
+#include <memory>
+#include <mutex>
 #include <unordered_map>
 #include <vector>
 
 #include "flashlight/fl/flashlight.h"
 
 #include "flashlight/lib/text/dictionary/Dictionary.h"
+#include "flashlight/pkg/speech/data/FeatureCache.h"
 
 namespace fl {
 namespace pkg {
@@ -62,6 +66,35 @@ class ListFileDataset : public fl::Dataset {
   virtual std::pair<std::vector<float>, Shape> loadAudio(
       const std::string& handle) const;
 
+  /**
+   * Enables the pipelined loading mode: the input pipeline (audio decode,
+   * sound-effect augmentation and featurization done by `inFeatFunc`) for
+   * upcoming samples is scheduled ahead on a small thread pool, so a slow
+   * augmentation chain on one sample overlaps with the decode and FFT work
+   * of its neighbors instead of serializing with them on the prefetch
+   * thread. Readahead assumes mostly-sequential access; out-of-order
+   * requests fall back to loading inline.
+   *
+   * @param[in] numThreads Number of threads used by the pipeline pool
+   * @param[in] prefetchSize Number of upcoming samples scheduled ahead
+   */
+  void enablePipelinedLoading(int64_t numThreads, int64_t prefetchSize);
+
+  /**
+   * Enables on-disk caching of computed input features in a blob store at
+   * the given path, populated lazily as samples are first loaded. Entries
+   * are keyed by the audio handle and `featureConfig`, a string identifying
+   * the featurization, so entries computed with different feature settings
+   * are ignored. Cached features bypass `inFeatFunc` entirely -- only enable
+   * caching when the input transform is deterministic (no augmentation).
+   *
+   * @param[in] cacheFile Path of the cache blob; created if missing
+   * @param[in] featureConfig String identifying the feature configuration
+   */
+  void enableFeatureCaching(
+      const fs::path& cacheFile,
+      const std::string& featureConfig);
+
  protected:
   DataTransformFunction inFeatFunc_, tgtFeatFunc_, wrdFeatFunc_;
   int64_t numRows_;
@@ -70,6 +103,20 @@ class ListFileDataset : public fl::Dataset {
   std::vector<std::string> targets_;
   std::vector<float> inputSizes_;
   mutable std::vector<int64_t> targetSizesCache_;
+
+ private:
+  Tensor loadInput(const int64_t idx) const;
+  Tensor getPipelinedInput(const int64_t idx) const;
+
+  // feature caching mode (enableFeatureCaching)
+  std::shared_ptr<FeatureCache> featureCache_;
+  std::string featureConfig_;
+
+  // pipelined loading mode (enablePipelinedLoading)
+  int64_t pipelinePrefetchSize_{0};
+  std::unique_ptr<ThreadPool> pipelinePool_;
+  mutable std::mutex pipelineMutex_;
+  mutable std::unordered_map<int64_t, std::future<Tensor>> pipelineCache_;
 };
 
 } // namespace speech
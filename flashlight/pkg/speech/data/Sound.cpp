@@ -7,12 +7,17 @@
 
 #include "flashlight/pkg/speech/data/Sound.h"
 
+#include <algorithm>
 #include <fstream>
+#include <future>
 #include <string>
+#include <thread>
 #include <unordered_map>
 
 #include <sndfile.h>
 
+#include "flashlight/fl/common/threadpool/ThreadPool.h"
+
 using namespace fl::pkg::speech;
 
 namespace {
@@ -269,6 +274,42 @@ std::vector<T> loadSound(std::istream& f) {
   return in;
 }
 
+template <typename T>
+std::vector<std::vector<T>> loadSounds(
+    const std::vector<std::string>& filenames,
+    int64_t numThreads /* = 0 */) {
+  if (numThreads < 0) {
+    throw std::invalid_argument("loadSounds: numThreads must be >= 0");
+  }
+  if (numThreads == 0) {
+    numThreads = std::max(1u, std::thread::hardware_concurrency());
+  }
+  numThreads = std::min<int64_t>(numThreads, filenames.size());
+
+  std::vector<std::vector<T>> sounds(filenames.size());
+  if (numThreads <= 1) {
+    for (size_t i = 0; i < filenames.size(); ++i) {
+      sounds[i] = loadSound<T>(filenames[i]);
+    }
+    return sounds;
+  }
+
+  // each worker decodes straight into its slot of the result; the futures
+  // carry only completion and errors
+  fl::ThreadPool pool(numThreads);
+  std::vector<std::future<void>> futures;
+  futures.reserve(filenames.size());
+  for (size_t i = 0; i < filenames.size(); ++i) {
+    futures.push_back(pool.enqueue([&sounds, &filenames, i]() {
+      sounds[i] = loadSound<T>(filenames[i]);
+    }));
+  }
+  for (auto& future : futures) {
+    future.get(); // rethrows the first decode failure in input order
+  }
+  return sounds;
+}
+
 template <typename T>
 void saveSound(
     const std::string& filename,
@@ -371,6 +412,19 @@ template std::vector<double> loadSound<double>(std::istream&);
 template std::vector<int> loadSound<int>(std::istream&);
 template std::vector<short> loadSound<short>(std::istream&);
 
+template std::vector<std::vector<float>> loadSounds(
+    const std::vector<std::string>&,
+    int64_t);
+template std::vector<std::vector<double>> loadSounds(
+    const std::vector<std::string>&,
+    int64_t);
+template std::vector<std::vector<int>> loadSounds(
+    const std::vector<std::string>&,
+    int64_t);
+template std::vector<std::vector<short>> loadSounds(
+    const std::vector<std::string>&,
+    int64_t);
+
 template void saveSound(
     const std::string&,
     const std::vector<float>&,
@@ -83,6 +83,19 @@ std::vector<T> loadSound(std::istream& f);
 template <typename T>
 std::vector<T> loadSound(const std::string& filename);
 
+/**
+ * Decodes a batch of sound files in parallel and returns the samples in
+ * input order. Decode dominates loader CPU for compressed corpora (e.g.
+ * FLAC), so spreading a batch over `numThreads` workers keeps a prefetching
+ * loader fed from a single call site. If `numThreads` is 0 the hardware
+ * concurrency is used; batches that fit one worker decode inline. The first
+ * decode failure, in input order, is rethrown.
+ */
+template <typename T>
+std::vector<std::vector<T>> loadSounds(
+    const std::vector<std::string>& filenames,
+    int64_t numThreads = 0);
+
 template <typename T>
 void saveSound(
     std::ostream& f,
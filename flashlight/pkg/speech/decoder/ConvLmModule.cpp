@@ -7,17 +7,83 @@
 
 #include "flashlight/pkg/speech/decoder/ConvLmModule.h"
 
+#include <algorithm>
 #include <stdexcept>
 #include <string>
 
+#include "flashlight/fl/common/LRUCache.h"
 #include "flashlight/fl/tensor/Index.h"
 #include "flashlight/fl/tensor/TensorBase.h"
 
 namespace fl::pkg::speech {
 
+namespace {
+
+// Hash for token prefixes (FNV-1a over the token values)
+struct PrefixHash {
+  size_t operator()(const std::vector<int>& prefix) const {
+    size_t hash = 14695981039346656037ULL;
+    for (int token : prefix) {
+      hash = (hash ^ static_cast<size_t>(token)) * 1099511628211ULL;
+    }
+    return hash;
+  }
+};
+
+using PrefixScoreCache =
+    LRUCache<std::vector<int>, std::vector<float>, PrefixHash>;
+
+// Forward the given token windows through the LM and return the scores over
+// the full vocabulary at each window's last-token position, batch-major.
+std::vector<float> forwardAndGatherScores(
+    const std::shared_ptr<Module>& network,
+    const std::vector<int>& inputs,
+    const std::vector<int>& lastTokenPositions,
+    int sampleSize,
+    int batchSize) {
+  Tensor inputData = Tensor::fromVector({sampleSize, batchSize}, inputs);
+  fl::Variable output = network->forward({fl::input(inputData)})[0];
+
+  if (fl::countNonzero(fl::isnan(output.tensor())).asScalar<int>() != 0) {
+    throw std::runtime_error("[ConvLM] Encountered NaNs in propagation");
+  }
+  int32_t C = output.dim(0), T = output.dim(1), B = output.dim(2);
+  if (B != batchSize) {
+    throw std::logic_error(
+        "[ConvLM]: incorrect predictions: batch should be " +
+        std::to_string(batchSize) + " but it is " + std::to_string(B));
+  }
+  if (batchSize != (int)lastTokenPositions.size()) {
+    throw std::logic_error(
+        "[ConvLM]: incorrect postions for accessing: size should be " +
+        std::to_string(batchSize) + " but it is " +
+        std::to_string(lastTokenPositions.size()));
+  }
+  // output (c, t, b)
+  // set global indices: offset by channel
+  Tensor globalIndices = fl::iota({C, 1}, {1, B}, fl::dtype::s32);
+  // set global indices: offset by batch
+  globalIndices =
+      globalIndices + fl::iota({1, B}, {C, 1}, fl::dtype::s32) * T * C;
+  // set global indices: offset by time which we need to take
+  globalIndices = globalIndices +
+      fl::tile(Tensor::fromVector({1, B}, lastTokenPositions), {C, 1}) * C;
+  Tensor preds =
+      fl::reshape(output.tensor().flatten()(globalIndices.flatten()), {C, B});
+  // vector of B X C predictions
+  return preds.toHostVector<float>();
+}
+
+} // namespace
+
 GetConvLmScoreFunc buildGetConvLmScoreFunction(
-    std::shared_ptr<Module> network) {
-  auto getConvLmScoreFunc = [network](
+    std::shared_ptr<Module> network,
+    size_t cacheBytes /* = 0 */) {
+  std::shared_ptr<PrefixScoreCache> cache;
+  if (cacheBytes > 0) {
+    cache = std::make_shared<PrefixScoreCache>(cacheBytes);
+  }
+  auto getConvLmScoreFunc = [network, cache](
                                 const std::vector<int>& inputs,
                                 const std::vector<int>& lastTokenPositions,
                                 int sampleSize = -1,
@@ -28,17 +94,9 @@ GetConvLmScoreFunc buildGetConvLmScoreFunction(
           "[ConvLM] Incorrect sample size (" + std::to_string(sampleSize) +
           ") or batch size (" + std::to_string(batchSize) + ").");
     }
-    Tensor inputData = Tensor::fromVector({sampleSize, batchSize}, inputs);
-    fl::Variable output = network->forward({fl::input(inputData)})[0];
-
-    if (fl::countNonzero(fl::isnan(output.tensor())).asScalar<int>() != 0) {
-      throw std::runtime_error("[ConvLM] Encountered NaNs in propagation");
-    }
-    int32_t C = output.dim(0), T = output.dim(1), B = output.dim(2);
-    if (B != batchSize) {
-      throw std::logic_error(
-          "[ConvLM]: incorrect predictions: batch should be " +
-          std::to_string(batchSize) + " but it is " + std::to_string(B));
+    if (!cache) {
+      return forwardAndGatherScores(
+          network, inputs, lastTokenPositions, sampleSize, batchSize);
     }
     if (batchSize != (int)lastTokenPositions.size()) {
       throw std::logic_error(
@@ -46,19 +104,56 @@ GetConvLmScoreFunc buildGetConvLmScoreFunction(
           std::to_string(batchSize) + " but it is " +
           std::to_string(lastTokenPositions.size()));
     }
-    // output (c, t, b)
-    // set global indices: offset by channel
-    Tensor globalIndices = fl::iota({C, 1}, {1, B}, fl::dtype::s32);
-    // set global indices: offset by batch
-    globalIndices =
-        globalIndices + fl::iota({1, B}, {C, 1}, fl::dtype::s32) * T * C;
-    // set global indices: offset by time which we need to take
-    globalIndices = globalIndices +
-        fl::tile(Tensor::fromVector({1, B}, lastTokenPositions), {C, 1}) * C;
-    Tensor preds =
-        fl::reshape(output.tensor().flatten()(globalIndices.flatten()), {C, B});
-    // vector of B X C predictions
-    return preds.toHostVector<float>();
+
+    // The LM is causal, so scores at the last-token position depend only on
+    // the tokens up to it: the prefix is the cache key, and beam hypotheses
+    // sharing a prefix hit the same entry. Only the misses are batched
+    // through the network.
+    std::vector<std::vector<int>> keys(batchSize);
+    std::vector<std::shared_ptr<std::vector<float>>> scores(batchSize);
+    std::vector<int> missIndices;
+    for (int b = 0; b < batchSize; ++b) {
+      const auto begin = inputs.begin() + b * sampleSize;
+      const int prefixLength = std::max(
+          0, std::min(lastTokenPositions[b] + 1, sampleSize));
+      keys[b].assign(begin, begin + prefixLength);
+      scores[b] = cache->get(keys[b]);
+      if (!scores[b]) {
+        missIndices.push_back(b);
+      }
+    }
+
+    if (!missIndices.empty()) {
+      std::vector<int> missInputs(missIndices.size() * sampleSize);
+      std::vector<int> missPositions(missIndices.size());
+      for (size_t j = 0; j < missIndices.size(); ++j) {
+        const int b = missIndices[j];
+        std::copy(
+            inputs.begin() + b * sampleSize,
+            inputs.begin() + (b + 1) * sampleSize,
+            missInputs.begin() + j * sampleSize);
+        missPositions[j] = lastTokenPositions[b];
+      }
+      auto missScores = forwardAndGatherScores(
+          network, missInputs, missPositions, sampleSize, missIndices.size());
+      const size_t C = missScores.size() / missIndices.size();
+      for (size_t j = 0; j < missIndices.size(); ++j) {
+        const int b = missIndices[j];
+        auto value = std::make_shared<std::vector<float>>(
+            missScores.begin() + j * C, missScores.begin() + (j + 1) * C);
+        scores[b] = cache->put(
+            keys[b],
+            std::move(value),
+            C * sizeof(float) + keys[b].size() * sizeof(int));
+      }
+    }
+
+    std::vector<float> result;
+    result.reserve(batchSize * (scores.empty() ? 0 : scores[0]->size()));
+    for (int b = 0; b < batchSize; ++b) {
+      result.insert(result.end(), scores[b]->begin(), scores[b]->end());
+    }
+    return result;
   };
 
   return getConvLmScoreFunc;
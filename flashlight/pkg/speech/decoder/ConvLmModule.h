@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <cstddef>
 #include <functional>
 #include <memory>
 #include <vector>
@@ -21,7 +22,17 @@ namespace speech {
 using GetConvLmScoreFunc = std::function<std::vector<
     float>(const std::vector<int>&, const std::vector<int>&, int, int)>;
 
-GetConvLmScoreFunc buildGetConvLmScoreFunction(std::shared_ptr<Module> network);
+/**
+ * Builds the scoring callback used by the 'convlm' beam-search LM.
+ *
+ * With `cacheBytes` > 0, scores are cached per token prefix with LRU
+ * eviction bounded by that byte budget. The LM is causal, so beam
+ * hypotheses sharing a prefix reuse the cached scores and only cache
+ * misses are forwarded through the network.
+ */
+GetConvLmScoreFunc buildGetConvLmScoreFunction(
+    std::shared_ptr<Module> network,
+    size_t cacheBytes = 0);
 
 } // namespace speech
 } // namespace pkg
@@ -7,6 +7,11 @@
 
 #include "flashlight/pkg/speech/decoder/DecodeMaster.h"
 
+#include <array>
+#include <future>
+#include <mutex>
+
+#include "flashlight/fl/common/threadpool/ThreadPool.h"
 #include "flashlight/fl/dataset/MemoryBlobDataset.h"
 #include "flashlight/fl/meter/EditDistanceMeter.h"
 #include "flashlight/fl/tensor/Index.h"
@@ -32,9 +37,62 @@ Tensor removeNegative(const fl::Tensor& arr) {
 Tensor removePad(const Tensor& arr, int32_t padIdx) {
   return arr(arr != padIdx);
 }
-} // namespace
 
-// TODO threading?
+// copies a sample's emission to a host buffer (reused across calls) and
+// returns the sample, so the transfer can be issued ahead of the decode
+std::vector<Tensor> fetchEmission(
+    const std::shared_ptr<fl::Dataset>& emissionDataset,
+    int64_t idx,
+    std::vector<float>& buffer) {
+  auto sample = emissionDataset->get(idx);
+  auto emission = sample[kDMTokenPredIdx];
+  if (emission.ndim() > 2) {
+    throw std::runtime_error("emission should be NxT");
+  }
+  buffer.resize(emission.elements());
+  emission.astype(fl::dtype::f32).host(buffer.data());
+  return sample;
+}
+
+// runs the decoder on a host emission buffer, replacing the emission entry
+// with the token predictions and filling in the word predictions
+std::vector<Tensor> decodeEmission(
+    std::vector<Tensor> sample,
+    const float* emissionData,
+    fl::lib::text::Decoder& decoder) {
+  auto& emission = sample[kDMTokenPredIdx];
+  auto results =
+      decoder.decode(emissionData, emission.dim(1), emission.dim(0));
+
+  std::vector<int> tokensV, wordsV;
+  if (!results.empty()) {
+    tokensV = results[0].tokens;
+    wordsV = results[0].words;
+  }
+  tokensV.erase(
+      std::remove(tokensV.begin(), tokensV.end(), -1), tokensV.end());
+  wordsV.erase(std::remove(wordsV.begin(), wordsV.end(), -1), wordsV.end());
+  sample[kDMTokenPredIdx] =
+      (!tokensV.empty() ? Tensor::fromVector(tokensV) : Tensor());
+  sample[kDMWordPredIdx] =
+      (!wordsV.empty() ? Tensor::fromVector(wordsV) : Tensor());
+  return sample;
+}
+
+// decode the emission of one sample; transfer and decode run back to back
+// on the calling (worker) thread
+std::vector<Tensor> decodeSample(
+    std::vector<Tensor> sample,
+    fl::lib::text::Decoder& decoder) {
+  auto emission = sample[kDMTokenPredIdx];
+  if (emission.ndim() > 2) {
+    throw std::runtime_error("emission should be NxT");
+  }
+  std::vector<float> emissionV(emission.elements());
+  emission.astype(fl::dtype::f32).host(emissionV.data());
+  return decodeEmission(std::move(sample), emissionV.data(), decoder);
+}
+} // namespace
 
 namespace fl::pkg::speech {
 
@@ -188,29 +246,87 @@ std::shared_ptr<fl::Dataset> DecodeMaster::decode(
     const std::shared_ptr<fl::Dataset>& emissionDataset,
     fl::lib::text::Decoder& decoder) {
   auto predDataset = std::make_shared<fl::MemoryBlobDataset>();
-  for (auto& sample : *emissionDataset) {
-    auto emission = sample[kDMTokenPredIdx];
-    if (emission.ndim() > 2) {
-      throw std::runtime_error("emission should be NxT");
+  int64_t numSamples = emissionDataset->size();
+  if (numSamples > 0) {
+    // Double-buffered emission transfer: the host copy of utterance N + 1
+    // is issued on a transfer thread while utterance N decodes on the
+    // caller thread, and the two host buffers are reused across the whole
+    // run instead of allocating a fresh vector per utterance.
+    ThreadPool transferPool(1);
+    std::array<std::vector<float>, 2> emissionBufs;
+    auto fetch = [&emissionDataset, &emissionBufs](int64_t idx) {
+      return fetchEmission(emissionDataset, idx, emissionBufs[idx % 2]);
+    };
+    auto next = transferPool.enqueue(fetch, int64_t(0));
+    for (int64_t idx = 0; idx < numSamples; ++idx) {
+      auto sample = next.get();
+      if (idx + 1 < numSamples) {
+        next = transferPool.enqueue(fetch, idx + 1);
+      }
+      predDataset->add(decodeEmission(
+          std::move(sample), emissionBufs[idx % 2].data(), decoder));
     }
-    std::vector<float> emissionV(emission.elements());
-    emission.astype(fl::dtype::f32).host(emissionV.data());
-    auto results =
-        decoder.decode(emissionV.data(), emission.dim(1), emission.dim(0));
-
-    std::vector<int> tokensV, wordsV;
-    if (!results.empty()) {
-      tokensV = results[0].tokens;
-      wordsV = results[0].words;
+  }
+  predDataset->writeIndex();
+  return predDataset;
+}
+
+std::shared_ptr<fl::Dataset> DecodeMaster::decode(
+    const std::shared_ptr<fl::Dataset>& emissionDataset,
+    const DecoderFactory& decoderFactory,
+    int numThreads) {
+  if (numThreads <= 0) {
+    throw std::invalid_argument("DecodeMaster::decode - invalid numThreads");
+  }
+  if (!decoderFactory) {
+    throw std::invalid_argument(
+        "DecodeMaster::decode - decoder factory is null");
+  }
+  // One decoder per worker, checked out for the duration of an utterance:
+  // decoders are stateful and not thread safe, and reusing an instance
+  // across utterances keeps its internal hypothesis buffers allocated
+  // instead of growing them from scratch every time.
+  std::vector<std::unique_ptr<fl::lib::text::Decoder>> decoders;
+  for (int i = 0; i < numThreads; ++i) {
+    decoders.emplace_back(decoderFactory());
+  }
+  std::mutex decoderMutex;
+
+  int64_t numSamples = emissionDataset->size();
+  std::vector<std::vector<Tensor>> results(numSamples);
+  {
+    ThreadPool threadPool(numThreads);
+    std::vector<std::future<void>> futures;
+    futures.reserve(numSamples);
+    for (int64_t idx = 0; idx < numSamples; ++idx) {
+      futures.push_back(threadPool.enqueue([&, idx]() {
+        // at most numThreads tasks run concurrently, so a decoder is
+        // always available
+        std::unique_ptr<fl::lib::text::Decoder> decoder;
+        {
+          std::lock_guard<std::mutex> lock(decoderMutex);
+          decoder = std::move(decoders.back());
+          decoders.pop_back();
+        }
+        try {
+          results[idx] = decodeSample(emissionDataset->get(idx), *decoder);
+        } catch (...) {
+          std::lock_guard<std::mutex> lock(decoderMutex);
+          decoders.push_back(std::move(decoder));
+          throw;
+        }
+        std::lock_guard<std::mutex> lock(decoderMutex);
+        decoders.push_back(std::move(decoder));
+      }));
+    }
+    for (auto& future : futures) {
+      future.get(); // rethrows any worker exception
     }
-    tokensV.erase(
-        std::remove(tokensV.begin(), tokensV.end(), -1), tokensV.end());
-    wordsV.erase(std::remove(wordsV.begin(), wordsV.end(), -1), wordsV.end());
-    sample[kDMTokenPredIdx] =
-        (!tokensV.empty() ? Tensor::fromVector(tokensV) : Tensor());
-    sample[kDMWordPredIdx] =
-        (!wordsV.empty() ? Tensor::fromVector(wordsV) : Tensor());
-    predDataset->add(sample);
+  }
+
+  auto predDataset = std::make_shared<fl::MemoryBlobDataset>();
+  for (auto& result : results) {
+    predDataset->add(result);
   }
   predDataset->writeIndex();
   return predDataset;
@@ -229,7 +345,8 @@ TokenDecodeMaster::TokenDecodeMaster(
 
 std::shared_ptr<fl::Dataset> TokenDecodeMaster::decode(
     const std::shared_ptr<fl::Dataset>& emissionDataset,
-    DecodeMasterLexiconFreeOptions opt) {
+    DecodeMasterLexiconFreeOptions opt,
+    int numThreads /* = 0 */) {
   fl::lib::text::LexiconFreeDecoderOptions decoderOpt{
       .beamSize = opt.beamSize,
       .beamSizeToken = opt.beamSizeToken,
@@ -240,6 +357,13 @@ std::shared_ptr<fl::Dataset> TokenDecodeMaster::decode(
       .criterionType = fl::lib::text::CriterionType::CTC};
   auto silIdx = tokenDict_.getIndex(opt.silToken);
   auto blankIdx = tokenDict_.getIndex(opt.blankToken);
+  if (numThreads > 0) {
+    auto decoderFactory = [decoderOpt, silIdx, blankIdx, this]() {
+      return std::make_unique<fl::lib::text::LexiconFreeDecoder>(
+          decoderOpt, lm_, silIdx, blankIdx, transition_);
+    };
+    return DecodeMaster::decode(emissionDataset, decoderFactory, numThreads);
+  }
   fl::lib::text::LexiconFreeDecoder decoder(
       decoderOpt, lm_, silIdx, blankIdx, transition_);
   return DecodeMaster::decode(emissionDataset, decoder);
@@ -248,7 +372,8 @@ std::shared_ptr<fl::Dataset> TokenDecodeMaster::decode(
 std::shared_ptr<fl::Dataset> TokenDecodeMaster::decode(
     const std::shared_ptr<fl::Dataset>& emissionDataset,
     const fl::lib::text::LexiconMap& lexicon,
-    DecodeMasterLexiconOptions opt) {
+    DecodeMasterLexiconOptions opt,
+    int numThreads /* = 0 */) {
   auto trie = buildTrie(lexicon, opt.smearMode);
   fl::lib::text::LexiconDecoderOptions decoderOpt{
       .beamSize = opt.beamSize,
@@ -263,6 +388,21 @@ std::shared_ptr<fl::Dataset> TokenDecodeMaster::decode(
   auto silIdx = tokenDict_.getIndex(opt.silToken);
   auto blankIdx = tokenDict_.getIndex(opt.blankToken);
   auto unkWordIdx = wordDict_.getIndex(fl::lib::text::kUnkToken);
+  if (numThreads > 0) {
+    auto decoderFactory =
+        [decoderOpt, trie, silIdx, blankIdx, unkWordIdx, this]() {
+          return std::make_unique<fl::lib::text::LexiconDecoder>(
+              decoderOpt,
+              trie,
+              lm_,
+              silIdx,
+              blankIdx,
+              unkWordIdx,
+              transition_,
+              true);
+        };
+    return DecodeMaster::decode(emissionDataset, decoderFactory, numThreads);
+  }
   fl::lib::text::LexiconDecoder decoder(
       decoderOpt, trie, lm_, silIdx, blankIdx, unkWordIdx, transition_, true);
   return DecodeMaster::decode(emissionDataset, decoder);
@@ -308,7 +448,8 @@ WordDecodeMaster::WordDecodeMaster(
 std::shared_ptr<fl::Dataset> WordDecodeMaster::decode(
     const std::shared_ptr<fl::Dataset>& emissionDataset,
     const fl::lib::text::LexiconMap& lexicon,
-    DecodeMasterLexiconOptions opt) {
+    DecodeMasterLexiconOptions opt,
+    int numThreads /* = 0 */) {
   auto trie = buildTrie(lexicon, opt.smearMode);
   fl::lib::text::LexiconDecoderOptions decoderOpt{
       .beamSize = opt.beamSize,
@@ -323,6 +464,21 @@ std::shared_ptr<fl::Dataset> WordDecodeMaster::decode(
   auto silIdx = tokenDict_.getIndex(opt.silToken);
   auto blankIdx = tokenDict_.getIndex(opt.blankToken);
   auto unkWordIdx = wordDict_.getIndex(opt.unkToken);
+  if (numThreads > 0) {
+    auto decoderFactory =
+        [decoderOpt, trie, silIdx, blankIdx, unkWordIdx, this]() {
+          return std::make_unique<fl::lib::text::LexiconDecoder>(
+              decoderOpt,
+              trie,
+              lm_,
+              silIdx,
+              blankIdx,
+              unkWordIdx,
+              transition_,
+              false);
+        };
+    return DecodeMaster::decode(emissionDataset, decoderFactory, numThreads);
+  }
   fl::lib::text::LexiconDecoder decoder(
       decoderOpt, trie, lm_, silIdx, blankIdx, unkWordIdx, transition_, false);
   return DecodeMaster::decode(emissionDataset, decoder);
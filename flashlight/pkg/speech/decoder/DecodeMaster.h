@@ -7,6 +7,9 @@
 
 #pragma once
 
+#include <functional>
+#include <memory>
+
 #include "flashlight/fl/dataset/datasets.h"
 #include "flashlight/fl/nn/nn.h"
 #include "flashlight/lib/text/decoder/Decoder.h"
@@ -73,6 +76,19 @@ class DecodeMaster {
       const std::shared_ptr<fl::Dataset>& eds,
       fl::lib::text::Decoder& decoder);
 
+  using DecoderFactory =
+      std::function<std::unique_ptr<fl::lib::text::Decoder>()>;
+
+  // decode emissions, sharding utterances across a thread pool. Decoders are
+  // stateful and not thread safe, so each worker checks out its own instance
+  // built by `decoderFactory`; reusing an instance across utterances also
+  // keeps its internal hypothesis buffers allocated. Output order matches
+  // the emission dataset.
+  std::shared_ptr<fl::Dataset> decode(
+      const std::shared_ptr<fl::Dataset>& eds,
+      const DecoderFactory& decoderFactory,
+      int numThreads);
+
   // returns token edit distance and word edit distance stats
   std::pair<std::vector<int64_t>, std::vector<int64_t>> computeMetrics(
       const std::shared_ptr<fl::Dataset>& pds);
@@ -113,16 +129,20 @@ class TokenDecodeMaster : public DecodeMaster {
       const fl::lib::text::Dictionary& wordDict,
       const DecodeMasterTrainOptions& trainOpt);
 
-  // compute predictions from emissions for lexicon free case
+  // compute predictions from emissions for lexicon free case; with
+  // numThreads > 0 utterances are sharded across that many decoder workers
   std::shared_ptr<fl::Dataset> decode(
       const std::shared_ptr<fl::Dataset>& eds,
-      DecodeMasterLexiconFreeOptions opt);
+      DecodeMasterLexiconFreeOptions opt,
+      int numThreads = 0);
 
-  // compute predictions from emissions for lexicon case
+  // compute predictions from emissions for lexicon case; with numThreads > 0
+  // utterances are sharded across that many decoder workers
   std::shared_ptr<fl::Dataset> decode(
       const std::shared_ptr<fl::Dataset>& eds,
       const fl::lib::text::LexiconMap& lexicon,
-      DecodeMasterLexiconOptions opt);
+      DecodeMasterLexiconOptions opt,
+      int numThreads = 0);
 
   // convert tokens indices predictions into tokens string
   virtual std::vector<std::string> computeStringPred(
@@ -148,11 +168,13 @@ class WordDecodeMaster : public DecodeMaster {
       const fl::lib::text::Dictionary& wordDict,
       const DecodeMasterTrainOptions& trainOpt);
 
-  // compute predictions from emissions
+  // compute predictions from emissions; with numThreads > 0 utterances are
+  // sharded across that many decoder workers
   std::shared_ptr<fl::Dataset> decode(
       const std::shared_ptr<fl::Dataset>& eds,
       const fl::lib::text::LexiconMap& lexicon,
-      DecodeMasterLexiconOptions opt);
+      DecodeMasterLexiconOptions opt,
+      int numThreads = 0);
 
   // convert tokens indices predictions into tokens string
   virtual std::vector<std::string> computeStringPred(
@@ -19,6 +19,14 @@
 namespace {
 constexpr const char* kPlDir = "generated_pl/";
 constexpr const char* kPlSubdirPrefix = "epoch_";
+
+// average per-frame max log probability of the emissions; a cheap proxy for
+// the model's confidence in its viterbi path
+float emissionConfidence(const fl::Tensor& emission) {
+  auto logProbs =
+      fl::logSoftmax(fl::Variable(emission, false), 0).tensor();
+  return fl::mean(fl::amax(logProbs, {0})).asScalar<float>();
+}
 } // namespace
 
 using namespace fl::pkg::runtime;
@@ -188,21 +196,56 @@ std::string PlGenerator::regeneratePl(
       "[PlGenerator] " + std::to_string(nSelectedSamples) + "/" +
       std::to_string(fullUnsupDs_->size()) + " samples selected");
 
+  /* 1.5 load previous scores and labels for incremental regeneration */
+  std::unordered_map<std::string, PlRecord> prevPl;
+  if (incrementalPl_) {
+    int prevPlEpoch = findLastPlEpoch(curEpoch - 1);
+    if (prevPlEpoch >= 0) {
+      prevPl = loadPlRecords(
+          plDir_ / (kPlSubdirPrefix + std::to_string(prevPlEpoch)));
+    }
+    logMaster(
+        "[PlGenerator] " + std::to_string(prevPl.size()) +
+        " utterances with confidence scores from previous regeneration");
+  }
+
   /* 2. pseudo label generation */
   ntwrk->eval();
   auto newPlFile = plDir / (std::to_string(worldRank_) + ".lst");
   std::ofstream plStream(newPlFile);
+  std::ofstream scStream;
+  if (incrementalPl_) {
+    scStream.open(plDir / (std::to_string(worldRank_) + ".sc"));
+  }
+  int64_t nReused = 0;
   for (auto& sample : *selectedDs) {
     auto duration = sample[kDurationIdx].scalar<float>();
     if (duration < minInputSize_ || duration > maxInputSize_) {
       continue;
     }
+    auto sampleId = readSampleIds(sample[kSampleIdx]).front();
 
     std::vector<std::string> words;
+    float score = 0;
+    bool scored = false;
     if (useExistingPl_ && seedModelWER_ < currentModelWER_) {
       auto tokenTarget = sample[kTargetIdx].toHostVector<int>();
       words = tokenToWord_(tokenTarget, tokenDict_, false);
     } else {
+      if (incrementalPl_) {
+        // keep the previous label if the model was confident enough about
+        // it recently; only drifted-away utterances are re-decoded
+        auto it = prevPl.find(sampleId);
+        if (it != prevPl.end() && !it->second.line.empty() &&
+            it->second.score >= plScoreThreshold_ &&
+            curEpoch - it->second.epoch <= plMaxAge_) {
+          plStream << it->second.line << std::endl;
+          scStream << sampleId << "\t" << it->second.score << "\t"
+                   << it->second.epoch << std::endl;
+          nReused++;
+          continue;
+        }
+      }
       fl::Variable rawEmission;
       if (usePlugin) {
         rawEmission = ntwrk
@@ -217,18 +260,30 @@ std::string PlGenerator::regeneratePl(
       auto tokenPrediction =
           criterion->viterbiPath(rawEmission.tensor()).toHostVector<int>();
       words = tokenToWord_(tokenPrediction, tokenDict_, true);
+      if (incrementalPl_) {
+        score = emissionConfidence(rawEmission.tensor());
+        scored = true;
+      }
     }
     if (words.size() < minTargetSize_ || words.size() > maxTargetSize_) {
       continue;
     }
 
-    auto sampleId = readSampleIds(sample[kSampleIdx]).front();
     auto inputPath = readSampleIds(sample[kPathIdx]).front();
     plStream << sampleId << "\t" << inputPath << "\t"
              << std::to_string(duration) << "\t" << lib::join(" ", words)
              << std::endl;
+    if (scored) {
+      scStream << sampleId << "\t" << score << "\t" << curEpoch << std::endl;
+    }
   }
   plStream.close();
+  if (incrementalPl_) {
+    scStream.close();
+    logMaster(
+        "[PlGenerator] " + std::to_string(nReused) +
+        " pseudo labels reused without re-decoding");
+  }
 
   fs::path finishPlFile = plDir / (std::to_string(worldRank_) + ".fns");
   std::ofstream fnsStream(finishPlFile);
@@ -273,6 +328,46 @@ void PlGenerator::setModelWER(const float& wer) {
   currentModelWER_ = wer;
 }
 
+void PlGenerator::setIncrementalPl(float scoreThreshold, int maxAge) {
+  if (maxAge < 1) {
+    throw std::invalid_argument(
+        "[PlGenerator] maxAge should be at least 1 for incremental PL.");
+  }
+  incrementalPl_ = true;
+  plScoreThreshold_ = scoreThreshold;
+  plMaxAge_ = maxAge;
+}
+
+std::unordered_map<std::string, PlGenerator::PlRecord>
+PlGenerator::loadPlRecords(const fs::path& plDir) const {
+  std::unordered_map<std::string, PlRecord> records;
+  for (int i = 0; i < worldSize_; i++) {
+    std::ifstream scStream(plDir / (std::to_string(i) + ".sc"));
+    if (!scStream) {
+      // previous regeneration predates incremental mode; everything in this
+      // shard will be re-decoded
+      continue;
+    }
+    std::string line;
+    while (std::getline(scStream, line)) {
+      auto fields = lib::splitOnWhitespace(line, true);
+      if (fields.size() != 3) {
+        continue;
+      }
+      records[fields[0]] =
+          PlRecord{std::stof(fields[1]), std::stoi(fields[2]), ""};
+    }
+    std::ifstream lstStream(plDir / (std::to_string(i) + ".lst"));
+    while (std::getline(lstStream, line)) {
+      auto it = records.find(line.substr(0, line.find('\t')));
+      if (it != records.end()) {
+        it->second.line = line;
+      }
+    }
+  }
+  return records;
+}
+
 int PlGenerator::findLastPlEpoch(int curEpoch) const {
   int lastPlEpoch = -1;
   for (const auto& i : plEpochs_) {
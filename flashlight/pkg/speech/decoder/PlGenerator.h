@@ -111,6 +111,16 @@ class PlGenerator {
   /* To set the WER of current model in PlGenerator */
   void setModelWER(const float& wer);
 
+  /*
+   * Enable incremental PL regeneration. Per-utterance confidence scores
+   * (average per-frame max log probability of the emissions, <= 0) are
+   * persisted next to the generated list files; at the next regeneration,
+   * utterances whose score is at least `scoreThreshold` and whose labels are
+   * at most `maxAge` regenerations old keep their previous pseudo label
+   * instead of being re-decoded.
+   */
+  void setIncrementalPl(float scoreThreshold, int maxAge);
+
  private:
   int worldRank_;
   bool isMaster_;
@@ -139,6 +149,24 @@ class PlGenerator {
   std::vector<int> plEpochs_;
   std::unordered_map<int, float> plUpdateMap_;
 
+  bool incrementalPl_{false};
+  float plScoreThreshold_{0};
+  int plMaxAge_{0};
+
+  // persisted state of one pseudo-labeled utterance from a previous
+  // regeneration
+  struct PlRecord {
+    float score;
+    int epoch;
+    std::string line; // full list-file line for the utterance
+  };
+
+  // loads scores and list lines written by all ranks at a previous
+  // regeneration; the round-robin sharding is reshuffled every epoch, so a
+  // rank cannot rely on having scored an utterance itself
+  std::unordered_map<std::string, PlRecord> loadPlRecords(
+      const fs::path& plDir) const;
+
   int findLastPlEpoch(int curEpoch) const;
   void logMaster(const std::string& message) const;
 };
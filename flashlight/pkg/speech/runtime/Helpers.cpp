@@ -7,8 +7,10 @@
 
 #include "flashlight/pkg/speech/runtime/Helpers.h"
 
+#include <algorithm>
 #include <numeric>
 #include <random>
+#include <thread>
 #include <utility>
 
 #include <glog/logging.h>
@@ -26,6 +28,72 @@ using fl::lib::text::LexiconMap;
 
 namespace fl::pkg::speech {
 
+namespace {
+
+// Sorts samples by decreasing length, ties broken by id. Chunks are sorted on
+// worker threads and pairwise-merged, since the single-threaded startup sort
+// dominates job (re)start time on large sample lists; the id tie-break makes
+// the result identical to the sequential stable sort.
+void sortSamplesByLength(
+    std::vector<float>& sizes,
+    std::vector<int64_t>& sortedIds) {
+  std::vector<std::pair<float, int64_t>> samples(sizes.size());
+  for (size_t i = 0; i < sizes.size(); ++i) {
+    samples[i] = {sizes[i], sortedIds[i]};
+  }
+  auto cmp = [](const std::pair<float, int64_t>& l,
+                const std::pair<float, int64_t>& r) {
+    return l.first > r.first || (l.first == r.first && l.second < r.second);
+  };
+
+  constexpr size_t kMinSamplesPerThread = 1 << 16;
+  const size_t nThreads = std::min<size_t>(
+      std::max<size_t>(std::thread::hardware_concurrency(), 1),
+      (samples.size() + kMinSamplesPerThread - 1) / kMinSamplesPerThread);
+  if (nThreads <= 1) {
+    std::sort(samples.begin(), samples.end(), cmp);
+  } else {
+    std::vector<size_t> bounds(nThreads + 1);
+    for (size_t t = 0; t <= nThreads; ++t) {
+      bounds[t] = samples.size() * t / nThreads;
+    }
+    {
+      std::vector<std::thread> workers;
+      for (size_t t = 0; t < nThreads; ++t) {
+        workers.emplace_back([&samples, &bounds, &cmp, t]() {
+          std::sort(
+              samples.begin() + bounds[t], samples.begin() + bounds[t + 1], cmp);
+        });
+      }
+      for (auto& worker : workers) {
+        worker.join();
+      }
+    }
+    for (size_t width = 1; width < nThreads; width *= 2) {
+      std::vector<std::thread> workers;
+      for (size_t t = 0; t + width < nThreads; t += 2 * width) {
+        workers.emplace_back([&samples, &bounds, &cmp, &nThreads, t, width]() {
+          std::inplace_merge(
+              samples.begin() + bounds[t],
+              samples.begin() + bounds[t + width],
+              samples.begin() + bounds[std::min(t + 2 * width, nThreads)],
+              cmp);
+        });
+      }
+      for (auto& worker : workers) {
+        worker.join();
+      }
+    }
+  }
+
+  for (size_t i = 0; i < samples.size(); ++i) {
+    sizes[i] = samples[i].first;
+    sortedIds[i] = samples[i].second;
+  }
+}
+
+} // namespace
+
 template <class T>
 std::vector<std::string> tensorMatrixToStrings(
     const Tensor& tensor,
@@ -103,7 +171,9 @@ std::shared_ptr<fl::Dataset> createDataset(
     int worldSize /* = 1 */,
     const bool allowEmpty /* = false */,
     const std::string& batchingStrategy /* kBatchStrategyNone */,
-    int maxDurationPerBatch /* = 0 */) {
+    int maxDurationPerBatch /* = 0 */,
+    const fs::path& featureCacheDir /* = "" */,
+    const std::string& featureCacheConfig /* = "" */) {
   std::vector<std::shared_ptr<const fl::Dataset>> allListDs;
   std::vector<float> sizes;
   for (auto& path : paths) {
@@ -125,6 +195,16 @@ std::shared_ptr<fl::Dataset> createDataset(
           rootDir / path, inputTransform, targetTransform, wordTransform);
     }
 
+    if (!featureCacheDir.empty()) {
+      // one cache file per list file and rank - the blob store supports a
+      // single writing process
+      curListDs->enableFeatureCaching(
+          featureCacheDir /
+              (cleanFilepath(path) + "." + std::to_string(worldRank) +
+               ".fcache"),
+          featureCacheConfig);
+    }
+
     allListDs.emplace_back(curListDs);
     sizes.reserve(sizes.size() + curListDs->size());
     for (int64_t i = 0; i < curListDs->size(); ++i) {
@@ -135,9 +215,6 @@ std::shared_ptr<fl::Dataset> createDataset(
   // Order Dataset
   std::vector<int64_t> sortedIds(sizes.size());
   std::iota(sortedIds.begin(), sortedIds.end(), 0);
-  auto cmp = [&sizes](const int64_t& l, const int64_t& r) {
-    return sizes[l] > sizes[r];
-  };
   if (batchingStrategy == kBatchStrategyRand ||
       batchingStrategy == kBatchStrategyRandDynamic) {
     auto rng = std::mt19937(sizes.size());
@@ -147,8 +224,7 @@ std::shared_ptr<fl::Dataset> createDataset(
       std::swap(sizes[i - 1], sizes[index]);
     }
   } else {
-    std::stable_sort(sortedIds.begin(), sortedIds.end(), cmp);
-    std::stable_sort(sizes.begin(), sizes.end(), std::greater<float>());
+    sortSamplesByLength(sizes, sortedIds);
   }
 
   auto concatListDs = std::make_shared<fl::ConcatDataset>(allListDs);
@@ -172,7 +248,25 @@ std::shared_ptr<fl::Dataset> createDataset(
       [](const std::vector<Tensor>& tensor) { return fl::join(tensor, 0, 1); },
       [](const std::vector<Tensor>& tensor) { return fl::join(tensor, 0, 1); },
       [](const std::vector<Tensor>& tensor) { return fl::join(tensor, 0, 1); }};
-  if (batchingStrategy == kBatchStrategyDynamic ||
+  if (batchingStrategy == kBatchStrategyBucket) {
+    // Group the length-sorted samples into variable-size batches under the
+    // token budget, then deal whole batches round-robin across ranks so every
+    // rank sees the same number of batches per epoch. Batch order is
+    // reshuffled per epoch by the caller's shuffle wrapper.
+    const auto sortedSizes = sizes;
+    auto bucketDs = std::make_shared<fl::BucketBatchDataset>(
+        sortedDs,
+        [sortedSizes](int64_t idx) {
+          return static_cast<int64_t>(sortedSizes[idx]);
+        },
+        maxDurationPerBatch,
+        /* seed = */ 0,
+        batchFns);
+    auto partitions = fl::partitionByRoundRobin(
+        bucketDs->size(), worldRank, worldSize, 1, allowEmpty);
+    return std::make_shared<fl::ResampleDataset>(bucketDs, partitions);
+  } else if (
+      batchingStrategy == kBatchStrategyDynamic ||
       batchingStrategy == kBatchStrategyRandDynamic) {
     // Partition the dataset and distribute
     auto result = fl::dynamicPartitionByRoundRobin(
@@ -215,6 +309,32 @@ std::shared_ptr<fl::Dataset> loadPrefetchDataset(
   return dataset;
 }
 
+std::pair<std::shared_ptr<fl::Dataset>, std::vector<int64_t>>
+sortDatasetByLength(
+    std::shared_ptr<const fl::Dataset> dataset,
+    std::vector<float> sizes) {
+  if (!dataset) {
+    throw std::invalid_argument("sortDatasetByLength - dataset is null");
+  }
+  if (sizes.size() != static_cast<size_t>(dataset->size())) {
+    throw std::invalid_argument(
+        "sortDatasetByLength - expected " + std::to_string(dataset->size()) +
+        " sizes, got " + std::to_string(sizes.size()));
+  }
+  std::vector<int64_t> sortedIds(sizes.size());
+  std::iota(sortedIds.begin(), sortedIds.end(), 0);
+  sortSamplesByLength(sizes, sortedIds);
+  // sortedIds maps sorted position -> original index; invert it so callers
+  // can map per-sample outputs back to the original order
+  std::vector<int64_t> unsortIds(sortedIds.size());
+  for (size_t i = 0; i < sortedIds.size(); ++i) {
+    unsortIds[sortedIds[i]] = i;
+  }
+  return {
+      std::make_shared<fl::ResampleDataset>(dataset, sortedIds),
+      std::move(unsortIds)};
+}
+
 std::vector<std::pair<std::string, std::string>> parseValidSets(
     const std::string& valid) {
   auto validSets = fl::lib::split(',', fl::lib::trim(valid), true);
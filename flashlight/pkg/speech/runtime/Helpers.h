@@ -17,6 +17,7 @@
 #include <tuple>
 #include <unordered_map>
 #include <unordered_set>
+#include <utility>
 
 #include "flashlight/fl/flashlight.h"
 
@@ -63,10 +64,15 @@ std::vector<std::string> readSampleIds(const Tensor& arr);
  * @param targetTransform - a function to featurize target
  * @param wordTransform - a function to featurize words
  * @param padVal - a tuple of padding values when batching input, target, word
- * @param batchingStrategy - batching strategy for the data, for now "none" and
- * "dynamic"
- * @param maxDurationPerBatch - is used for batchingStrategy="dynamic", max
- * total duration in a batch
+ * @param batchingStrategy - batching strategy for the data: "none",
+ * "dynamic", "rand", "randdynamic" or "bucket"
+ * @param maxDurationPerBatch - is used for batchingStrategy="dynamic" and
+ * "bucket", max total duration in a batch
+ * @param featureCacheDir - directory for on-disk input feature caches, one
+ * per list file and rank; empty disables caching. Only pass a directory when
+ * inputTransform is deterministic (no augmentation).
+ * @param featureCacheConfig - string identifying the feature configuration,
+ * part of the cache key
  */
 std::shared_ptr<fl::Dataset> createDataset(
     const std::vector<fs::path>& paths,
@@ -81,7 +87,9 @@ std::shared_ptr<fl::Dataset> createDataset(
     int worldSize = 1,
     const bool allowEmpty = false,
     const std::string& batchingStrategy = kBatchStrategyNone,
-    int maxDurationPerBatch = 0);
+    int maxDurationPerBatch = 0,
+    const fs::path& featureCacheDir = "",
+    const std::string& featureCacheConfig = "");
 
 std::shared_ptr<fl::Dataset> loadPrefetchDataset(
     std::shared_ptr<fl::Dataset> dataset,
@@ -89,6 +97,25 @@ std::shared_ptr<fl::Dataset> loadPrefetchDataset(
     bool shuffle,
     int shuffleSeed = 0);
 
+/*
+ * Wraps a per-sample dataset so iteration visits samples in decreasing
+ * length order - batching the result groups samples of similar length and
+ * minimizes padding - together with the record needed to undo the sort.
+ *
+ * Returns the sorted dataset and the inverse permutation: `unsortIds[j]` is
+ * the position of original sample `j` in the sorted iteration order, so an
+ * eval loop that collects per-sample outputs in iteration order restores the
+ * original order for attribution with `original[j] = outputs[unsortIds[j]]`.
+ *
+ * @param dataset - the dataset to wrap, one sample per index
+ * @param sizes - per-sample lengths, in the dataset's index order; ties are
+ * broken by original index
+ */
+std::pair<std::shared_ptr<fl::Dataset>, std::vector<int64_t>>
+sortDatasetByLength(
+    std::shared_ptr<const fl::Dataset> dataset,
+    std::vector<float> sizes);
+
 /*
  * Function to parse valid set string describing multiple datasets into a vector
  * Input Format: d1:d1.lst,d2:d2.lst returns {{d1, d1.lst}, {d2, d2.lst}}
@@ -110,6 +110,48 @@ void appendToLog(std::ofstream& logfile, const std::string& logstr) {
   retryWithBackoff(std::chrono::seconds(1), 1.0, 6, write);
 }
 
+AsyncLogWriter::AsyncLogWriter(std::ofstream& logfile, int maxQueueSize)
+    : logfile_(logfile), queue_(maxQueueSize) {
+  writer_ = std::thread([this]() {
+    std::string logstr;
+    while (queue_.get(logstr)) {
+      appendToLog(logfile_, logstr);
+    }
+  });
+}
+
+AsyncLogWriter::~AsyncLogWriter() {
+  queue_.finishAdding();
+  writer_.join();
+  auto dropped = numDropped_.load();
+  if (dropped > 0) {
+    appendToLog(
+        logfile_,
+        format(
+            "[log writer dropped %lld lines]",
+            static_cast<long long>(dropped)));
+  }
+}
+
+void AsyncLogWriter::append(const std::string& logstr) {
+  // Account for earlier overflow once the queue has room again, so drops
+  // show up in the log next to the lines they preceded.
+  auto dropped = numDropped_.load();
+  if (dropped > 0 &&
+      queue_.tryAdd(format(
+          "[log writer dropped %lld lines]",
+          static_cast<long long>(dropped)))) {
+    numDropped_ -= dropped;
+  }
+  if (!queue_.tryAdd(logstr)) {
+    ++numDropped_;
+  }
+}
+
+int64_t AsyncLogWriter::numDropped() const {
+  return numDropped_.load();
+}
+
 Tensor allreduceGet(SpeechStatMeter& mtr) {
   auto mtrValRaw = mtr.value();
   std::vector<long long> mtrVal(mtrValRaw.begin(), mtrValRaw.end());
@@ -7,9 +7,14 @@
 
 #pragma once
 
+#include <atomic>
+#include <fstream>
 #include <map>
+#include <string>
+#include <thread>
 
 #include "flashlight/fl/flashlight.h"
+#include "flashlight/pkg/speech/common/ProducerConsumerQueue.h"
 #include "flashlight/pkg/speech/runtime/SpeechStatMeter.h"
 
 #define FL_LOG_MASTER(lvl) LOG_IF(lvl, (fl::getWorldRank() == 0))
@@ -62,6 +67,43 @@ std::string getLogString(
 
 void appendToLog(std::ofstream& logfile, const std::string& logstr);
 
+/**
+ * Appends log lines to a file from a background thread, so the ostream
+ * flush (and its retry-with-backoff on transient filesystem errors) never
+ * stalls the training loop. Lines go through a bounded queue; when the
+ * queue is full the line is dropped and counted instead of blocking the
+ * caller, and an accounting line is written once the queue drains. The
+ * destructor flushes all pending lines.
+ *
+ * The log file must outlive the writer, and only the writer should append
+ * to it while the writer is alive.
+ */
+class AsyncLogWriter {
+ public:
+  explicit AsyncLogWriter(std::ofstream& logfile, int maxQueueSize = 100);
+
+  ~AsyncLogWriter();
+
+  AsyncLogWriter(const AsyncLogWriter&) = delete;
+  AsyncLogWriter& operator=(const AsyncLogWriter&) = delete;
+
+  /**
+   * Enqueues a log line without blocking; drops it if the queue is full.
+   */
+  void append(const std::string& logstr);
+
+  /**
+   * Number of lines dropped on overflow and not yet accounted in the log.
+   */
+  int64_t numDropped() const;
+
+ private:
+  std::ofstream& logfile_;
+  fl::lib::ProducerConsumerQueue<std::string> queue_;
+  std::atomic<int64_t> numDropped_{0};
+  std::thread writer_;
+};
+
 Tensor allreduceGet(SpeechStatMeter& mtr);
 void allreduceSet(SpeechStatMeter& mtr, Tensor& val);
 
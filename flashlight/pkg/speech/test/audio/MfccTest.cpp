@@ -129,6 +129,34 @@ TEST(MfccTest, BatchingTest) {
   }
 }
 
+TEST(MfccTest, StreamingTest) {
+  int Tmax = 10000;
+  auto input = randVec<float>(Tmax);
+  FeatureParams featparams;
+  featparams.deltaWindow = 0;
+  featparams.accWindow = 0;
+  featparams.frameSizeMs = 25;
+  Mfcc mfcc(featparams);
+  auto expected = mfcc.apply(input);
+
+  // feeding the signal in chunks (including chunks smaller than one frame)
+  // produces the same features as processing it whole
+  for (int chunkSz : {160, 777, 4000}) {
+    AudioStreamState state;
+    std::vector<float> streamed;
+    for (int start = 0; start < Tmax; start += chunkSz) {
+      int end = std::min(Tmax, start + chunkSz);
+      std::vector<float> chunk(input.begin() + start, input.begin() + end);
+      auto curOutput = mfcc.applyStream(chunk, state);
+      streamed.insert(streamed.end(), curOutput.begin(), curOutput.end());
+    }
+    ASSERT_EQ(streamed.size(), expected.size());
+    for (int j = 0; j < streamed.size(); ++j) {
+      ASSERT_NEAR(streamed[j], expected[j], 1E-4);
+    }
+  }
+}
+
 TEST(MfccTest, BatchingTest2) {
   int Tmax = 10000;
   int batchSz = 100;
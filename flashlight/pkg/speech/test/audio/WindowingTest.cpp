@@ -7,9 +7,11 @@
 
 #include <gtest/gtest.h>
 
+#include "flashlight/pkg/speech/audio/feature/PreEmphasis.h"
 #include "flashlight/pkg/speech/audio/feature/Windowing.h"
 #include "flashlight/pkg/speech/test/audio/TestUtils.h"
 
+using fl::lib::audio::PreEmphasis;
 using fl::lib::audio::Windowing;
 using fl::lib::audio::WindowType;
 
@@ -65,6 +67,28 @@ TEST(WindowingTest, batchingTest) {
   }
 }
 
+TEST(WindowingTest, preEmphasisFusionTest) {
+  int N = 64, B = 20;
+  float alpha = 0.95;
+  auto input = randVec<float>(N * B);
+  auto hammwindow = Windowing(N, WindowType::HAMMING);
+  auto preemphasis = PreEmphasis(alpha, N);
+
+  auto expOutput = input;
+  preemphasis.applyInPlace(expOutput);
+  hammwindow.applyInPlace(expOutput);
+
+  // The fused pass should match the composed passes.
+  auto output = input;
+  hammwindow.applyWithPreEmphasisInPlace(output, alpha);
+  ASSERT_TRUE(compareVec<float>(output, expOutput, 1E-6));
+
+  // alpha = 0 reduces to plain windowing.
+  auto windowOnly = input;
+  hammwindow.applyWithPreEmphasisInPlace(windowOnly, 0.0);
+  ASSERT_TRUE(compareVec<float>(windowOnly, hammwindow.apply(input), 1E-10));
+}
+
 int main(int argc, char** argv) {
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
@@ -115,6 +115,35 @@ TEST(ReverbEcho, SinWaveReverb) {
   EXPECT_THAT(noiseMain, Pointwise(FloatNearPointwise(0.1), noiseSrc));
 }
 
+/**
+ * Test that the batched API produces exactly the same augmentation as
+ * applying the sound effect to each utterance in turn, since both consume
+ * the random number stream in the same order.
+ */
+TEST(ReverbEcho, BatchMatchesSerial) {
+  ReverbEcho::Config conf;
+  conf.proba_ = 1.0f;
+  const unsigned int seed = 123;
+
+  std::vector<std::vector<float>> sounds;
+  for (int i = 0; i < 4; ++i) {
+    sounds.push_back(
+        genTestSinWave(numSamples + i * 50, freq, sampleRate, amplitude));
+  }
+  auto batched = sounds;
+
+  ReverbEcho serialSfx(conf, seed);
+  for (auto& sound : sounds) {
+    serialSfx.apply(sound);
+  }
+  ReverbEcho batchSfx(conf, seed);
+  batchSfx.applyBatch(batched);
+
+  for (int i = 0; i < sounds.size(); ++i) {
+    EXPECT_EQ(sounds[i], batched[i]);
+  }
+}
+
 int main(int argc, char** argv) {
   ::testing::InitGoogleTest(&argc, argv);
   fl::init();
@@ -88,6 +88,32 @@ TEST(ProducerConsumerQueueTest, MultiThreads) {
   ASSERT_EQ(predictSum, targetSum);
 }
 
+TEST(ProducerConsumerQueueTest, TryAdd) {
+  ProducerConsumerQueue<int> queue(3);
+
+  // Producing without blocking; overflow is rejected
+  for (int i = 1; i <= 3; i++) {
+    ASSERT_TRUE(queue.tryAdd(i));
+  }
+  ASSERT_FALSE(queue.tryAdd(4));
+
+  // Consuming makes room again
+  int element;
+  ASSERT_TRUE(queue.get(element));
+  ASSERT_EQ(element, 1);
+  ASSERT_TRUE(queue.tryAdd(4));
+
+  // Rejected after adding is finished
+  queue.finishAdding();
+  ASSERT_FALSE(queue.tryAdd(5));
+
+  std::vector<int> output;
+  while (queue.get(element)) {
+    output.emplace_back(element);
+  }
+  ASSERT_THAT(output, testing::ElementsAre(2, 3, 4));
+}
+
 int main(int argc, char** argv) {
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
@@ -10,6 +10,7 @@
 #include <array>
 
 #include "flashlight/fl/common/Filesystem.h"
+#include "flashlight/fl/common/Utils.h"
 #include "flashlight/fl/tensor/Index.h"
 #include "flashlight/fl/tensor/Init.h"
 #include "flashlight/pkg/speech/criterion/criterion.h"
@@ -68,6 +69,25 @@ void jacobianTest(
 
 } // namespace
 
+TEST(CriterionTest, WorkspacePool) {
+  const size_t size = (1 << 20) + 123; // distinctive size for this test
+  uint8_t* first = nullptr;
+  {
+    auto lease = leaseWorkspace(size);
+    ASSERT_EQ(lease.size(), size);
+    first = lease.data();
+    first[0] = 42;
+  }
+  // a released buffer is recycled, re-zeroed, by the next lease
+  auto reused = leaseWorkspace(size);
+  ASSERT_EQ(reused.data(), first);
+  ASSERT_EQ(reused.data()[0], 0);
+
+  // concurrent leases get distinct buffers
+  auto other = leaseWorkspace(size);
+  ASSERT_NE(other.data(), reused.data());
+}
+
 TEST(CriterionTest, CTCEmptyTarget) {
   // Subtle - related to memory manager initialization. Will be fixed in a
   // future version of ArrayFire after which time this can be removed. The test
@@ -116,6 +136,30 @@ TEST(CriterionTest, CTCCost) {
   ASSERT_NEAR(loss2.scalar<float>(), -log(0.25 * 0.25 * 0.25 * 5), kEpsilon);
 }
 
+TEST(CriterionTest, CTCFp16) {
+  if (!fl::f16Supported()) {
+    GTEST_SKIP() << "Half-precision not supported on this device";
+  }
+  int N = 12, T = 30, L = 8, B = 3;
+  auto in32 = Variable(fl::log(fl::rand({N, T, B})), true);
+  auto in16 = Variable(in32.tensor().astype(fl::dtype::f16), true);
+  auto t = fl::abs(fl::rand({L, B}, fl::dtype::s32)) % (N - 2);
+  auto tgt = Variable(t.astype(fl::dtype::s32), false);
+  auto l = ConnectionistTemporalClassificationCriterion(
+      CriterionScaleMode::TARGET_SZ_SQRT);
+
+  auto loss32 = l.forward({in32, tgt}).front();
+  auto loss16 = l.forward({in16, tgt}).front();
+  checkZero(loss32.tensor() - loss16.tensor(), 1E-2);
+
+  loss32.backward();
+  loss16.backward();
+  ASSERT_EQ(in16.grad().type(), fl::dtype::f16);
+  checkZero(
+      in32.grad().tensor() - in16.grad().tensor().astype(fl::dtype::f32),
+      1E-2);
+}
+
 TEST(CriterionTest, CTCJacobian) {
   int N = 30, T = 80, L = 20;
   auto in = Variable(fl::log(fl::rand({N, T, 1})), true);
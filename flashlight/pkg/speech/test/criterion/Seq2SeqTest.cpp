@@ -116,6 +116,66 @@ TEST(Seq2SeqTest, Seq2SeqViterbi) {
   ASSERT_LE(path.elements(), maxoutputlen);
 }
 
+TEST(Seq2SeqTest, TransformerCriterionViterbiSpeculative) {
+  int nclass = 40;
+  int hiddendim = 64;
+  int inputsteps = 50;
+  int maxoutputlen = 30;
+
+  fl::setSeed(1);
+  TransformerCriterion tds(
+      nclass,
+      hiddendim,
+      nclass - 1 /* eos token index */,
+      nclass - 2 /* pad token index */,
+      maxoutputlen,
+      2 /* nLayer */,
+      std::make_shared<ContentAttention>(),
+      nullptr /* window */,
+      false /* trainWithWindow */,
+      0.0 /* labelSmooth */,
+      100.0 /* pctTeacherForcing */,
+      0.0 /* pDropout */,
+      0.0 /* pLayerDrop */);
+  TransformerCriterion draft(
+      nclass,
+      hiddendim,
+      nclass - 1,
+      nclass - 2,
+      maxoutputlen,
+      1 /* nLayer */,
+      std::make_shared<ContentAttention>(),
+      nullptr,
+      false,
+      0.0,
+      100.0,
+      0.0,
+      0.0);
+
+  tds.eval();
+  draft.eval();
+  auto input = fl::randn({hiddendim, inputsteps, 1}, fl::dtype::f32);
+
+  auto path = tds.viterbiPath(input);
+
+  // greedy verification yields the same path as the sequential greedy
+  // decode, no matter how good the draft's proposals are
+  auto specPath = tds.viterbiPathSpeculative(input, draft, 3);
+  ASSERT_EQ(path.elements(), specPath.elements());
+  if (!path.isEmpty()) {
+    ASSERT_TRUE(allClose(path, specPath));
+  }
+
+  // a perfect draft (the model itself) has every proposal accepted
+  auto selfPath = tds.viterbiPathSpeculative(input, tds, 4);
+  ASSERT_EQ(path.elements(), selfPath.elements());
+  if (!path.isEmpty()) {
+    ASSERT_TRUE(allClose(path, selfPath));
+  }
+
+  ASSERT_THROW(tds.viterbiPathSpeculative(input, draft, 0), std::exception);
+}
+
 TEST(Seq2SeqTest, Seq2SeqBeamSearchViterbi) {
   int nclass = 40;
   int hiddendim = 256;
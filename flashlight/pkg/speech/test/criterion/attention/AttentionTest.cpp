@@ -162,6 +162,42 @@ TEST(AttentionTest, NeuralContentAttention) {
   }
 }
 
+TEST(AttentionTest, ContentAttentionWindowedDecode) {
+  int H = 6, B = 2, T = 24;
+  ContentAttention attention;
+
+  Variable encodedx(fl::randn({H, T, B}), true);
+  Variable encodedy(fl::randn({H, 1, B}), true);
+
+  // hard window admitting frames [8, 16), as MedianWindow would emit
+  auto maskArray = fl::full({1, T, B}, kAttentionMaskValue);
+  maskArray(fl::span, fl::range(8, 16), fl::span) = 0.0;
+  Variable windowMask(maskArray, false);
+
+  Variable alphas, summaries;
+  std::tie(alphas, summaries) =
+      attention.forward(encodedy, encodedx, Variable{}, windowMask);
+  ASSERT_EQ(alphas.shape(), Shape({1, T, B}));
+  ASSERT_EQ(summaries.shape(), Shape({H, 1, B}));
+
+  // the sliced computation matches full-width scoring plus masking
+  auto innerProd =
+      matmulTN(encodedy, encodedx) / std::sqrt(static_cast<float>(H));
+  auto expected = softmax(innerProd + windowMask, 1);
+  ASSERT_TRUE(allClose(alphas.tensor(), expected.tensor(), 1e-5));
+  ASSERT_TRUE(allClose(
+      summaries.tensor(),
+      matmulNT(encodedx, expected).tensor(),
+      1e-5));
+
+  // gradients flow through the narrow matmuls
+  auto func = [&](Variable& in) {
+    return std::get<1>(
+        attention.forward(encodedy, in, Variable{}, windowMask));
+  };
+  ASSERT_TRUE(jacobianTestImpl(func, encodedx, 1e-4));
+}
+
 TEST(AttentionTest, SimpleLocationAttention) {
   int H = 8, K = 5;
   sequentialTest(std::make_shared<SimpleLocationAttention>(K), H);
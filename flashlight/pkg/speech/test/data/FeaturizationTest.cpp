@@ -114,6 +114,13 @@ TEST(FeaturizationTest, Transpose) {
   auto arrT = Tensor::fromVector({17, 13, 19, 23}, arrVecT);
   ASSERT_TRUE(
       fl::all(arrT - fl::transpose(arr, {1, 0, 2, 3}) == 0.0).asScalar<bool>());
+
+  // dimensions spanning several tiles of the blocked kernel, not a multiple
+  // of the tile size
+  auto big = fl::rand({67, 47});
+  auto bigVecT = transpose2d<float>(big.toHostVector<float>(), 47, 67);
+  auto bigT = Tensor::fromVector({47, 67}, bigVecT);
+  ASSERT_TRUE(fl::all(bigT - fl::transpose(big) == 0.0).asScalar<bool>());
 }
 
 TEST(FeaturizationTest, localNormalize) {
@@ -83,6 +83,26 @@ TEST(SoundTest, Mono) {
   }
 }
 
+TEST(SoundTest, BatchedLoad) {
+  auto audiopath = loadPath / "test_mono.wav";
+  auto reference = loadSound<float>(audiopath);
+
+  // batched decode matches per-file decode, in input order
+  std::vector<std::string> filenames(3, audiopath);
+  auto sounds = loadSounds<float>(filenames, 2);
+  ASSERT_EQ(sounds.size(), 3);
+  for (const auto& sound : sounds) {
+    ASSERT_EQ(sound, reference);
+  }
+
+  // inline path (one worker) agrees with the pooled path
+  ASSERT_EQ(loadSounds<float>(filenames, 1), sounds);
+
+  ASSERT_TRUE(loadSounds<float>({}).empty());
+  ASSERT_THROW(loadSounds<float>({"/no/such/file.wav"}), std::runtime_error);
+  ASSERT_THROW(loadSounds<float>(filenames, -1), std::invalid_argument);
+}
+
 TEST(SoundTest, Stereo) {
   auto audiopath = loadPath / "test_stereo.wav"; // 16-bit Signed Integer PCM
   auto datapath = loadPath / "test_stereo.dat";
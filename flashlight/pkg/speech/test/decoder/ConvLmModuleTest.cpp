@@ -11,6 +11,7 @@
 
 #include "flashlight/fl/common/Filesystem.h"
 #include "flashlight/pkg/runtime/common/SequentialBuilder.h"
+#include "flashlight/pkg/speech/decoder/ConvLmModule.h"
 
 using namespace fl;
 using namespace fl::pkg::runtime;
@@ -112,6 +113,42 @@ TEST(ConvLmModuleTest, SerializationGCNN14BAdaptiveSoftmax) {
   ASSERT_TRUE(allClose(outputl_criterion, output_criterion));
 }
 
+TEST(ConvLmModuleTest, PrefixScoreCache) {
+  const int nclass = 17;
+  auto model = std::make_shared<Sequential>();
+  model->add(std::make_shared<Embedding>(8, nclass));
+  model->add(std::make_shared<Linear>(8, nclass));
+  model->eval();
+
+  auto uncached = fl::pkg::speech::buildGetConvLmScoreFunction(model);
+  auto cached =
+      fl::pkg::speech::buildGetConvLmScoreFunction(model, /* cacheBytes = */
+                                                   1 << 20);
+
+  std::vector<int> inputs = {1, 2, 3, 4, 5, 6, 7, 8};
+  std::vector<int> positions = {3, 2};
+  auto ref = uncached(inputs, positions, 4, 2);
+  auto out = cached(inputs, positions, 4, 2);
+  ASSERT_EQ(ref.size(), out.size());
+  for (size_t i = 0; i < ref.size(); ++i) {
+    ASSERT_NEAR(ref[i], out[i], 1e-5);
+  }
+
+  // repeated prefixes are served from the cache with identical scores
+  auto again = cached(inputs, positions, 4, 2);
+  ASSERT_EQ(out, again);
+
+  // batches mixing cached and new prefixes only forward the misses
+  std::vector<int> mixedInputs = {1, 2, 3, 4, 9, 10, 11, 12};
+  std::vector<int> mixedPositions = {3, 3};
+  ref = uncached(mixedInputs, mixedPositions, 4, 2);
+  out = cached(mixedInputs, mixedPositions, 4, 2);
+  ASSERT_EQ(ref.size(), out.size());
+  for (size_t i = 0; i < ref.size(); ++i) {
+    ASSERT_NEAR(ref[i], out[i], 1e-5);
+  }
+}
+
 int main(int argc, char** argv) {
   ::testing::InitGoogleTest(&argc, argv);
   fl::init();
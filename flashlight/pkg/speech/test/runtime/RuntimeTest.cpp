@@ -6,8 +6,11 @@
  */
 
 #include <cstdint>
+#include <fstream>
+#include <string>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
@@ -124,6 +127,79 @@ TEST(RuntimeTest, parseValidSets) {
   ASSERT_EQ(op2[2], (std::pair<std::string, std::string>("d3.lst", "d3.lst")));
 }
 
+TEST(RuntimeTest, SortDatasetByLength) {
+  // six samples whose value is their original index
+  auto base = std::make_shared<fl::TensorDataset>(
+      std::vector<fl::Tensor>{fl::iota({1, 6})});
+  std::vector<float> sizes = {3., 1., 4., 1., 5., 9.};
+
+  auto [sorted, unsortIds] = sortDatasetByLength(base, sizes);
+  ASSERT_EQ(sorted->size(), base->size());
+  // decreasing length; ties broken by original index
+  const std::vector<int64_t> expectedOrder = {5, 4, 2, 0, 1, 3};
+  for (int64_t i = 0; i < sorted->size(); ++i) {
+    ASSERT_EQ(
+        sorted->get(i).front().scalar<float>(),
+        static_cast<float>(expectedOrder[i]));
+  }
+  // the inverse permutation restores the original order for attribution
+  for (int64_t j = 0; j < base->size(); ++j) {
+    ASSERT_EQ(
+        sorted->get(unsortIds[j]).front().scalar<float>(),
+        static_cast<float>(j));
+  }
+
+  ASSERT_THROW(sortDatasetByLength(nullptr, {}), std::invalid_argument);
+  ASSERT_THROW(sortDatasetByLength(base, {1.}), std::invalid_argument);
+}
+
+TEST(RuntimeTest, AsyncLogWriter) {
+  const fs::path logPath = fs::temp_directory_path() / "async_log_test.log";
+  auto readLines = [&]() {
+    std::vector<std::string> lines;
+    std::ifstream in(logPath);
+    for (std::string s; std::getline(in, s);) {
+      lines.emplace_back(s);
+    }
+    return lines;
+  };
+
+  {
+    std::ofstream logFile(logPath);
+    AsyncLogWriter writer(logFile);
+    for (int i = 0; i < 50; ++i) {
+      writer.append("line " + std::to_string(i));
+    }
+    // destructor drains the queue and flushes
+  }
+  auto lines = readLines();
+  ASSERT_EQ(lines.size(), 50);
+  for (int i = 0; i < 50; ++i) {
+    ASSERT_EQ(lines[i], "line " + std::to_string(i));
+  }
+
+  // overflowing a tiny queue drops lines and accounts for them in the log
+  {
+    std::ofstream logFile(logPath);
+    AsyncLogWriter writer(logFile, 1);
+    for (int i = 0; i < 1000; ++i) {
+      writer.append("line " + std::to_string(i));
+    }
+  }
+  lines = readLines();
+  ASSERT_LE(lines.size(), 1001);
+  int accounted = 0;
+  for (const auto& line : lines) {
+    if (line.find("dropped") != std::string::npos) {
+      ++accounted;
+    }
+  }
+  if (lines.size() < 1000) {
+    ASSERT_GE(accounted, 1);
+  }
+  fs::remove(logPath);
+}
+
 int main(int argc, char** argv) {
   ::testing::InitGoogleTest(&argc, argv);
   fl::init();
@@ -0,0 +1,257 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "flashlight/pkg/text/data/ShardedTextDataset.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace fl {
+namespace pkg {
+namespace text {
+
+namespace {
+
+constexpr char kShardMagic[8] = {'F', 'L', 'T', 'X', 'T', 'S', 'H', '1'};
+// magic + uint64 token count; the raw int32 token payload follows
+constexpr size_t kShardHeaderBytes = sizeof(kShardMagic) + sizeof(uint64_t);
+
+} // namespace
+
+void ShardedTextDataset::writeShard(
+    const fs::path& path,
+    const std::vector<int>& tokens) {
+  std::ofstream file(path, std::ios::binary);
+  if (!file) {
+    throw std::runtime_error(
+        "ShardedTextDataset::writeShard - failed to open for writing: " +
+        path.string());
+  }
+  file.write(kShardMagic, sizeof(kShardMagic));
+  const uint64_t count = tokens.size();
+  file.write(reinterpret_cast<const char*>(&count), sizeof(count));
+  file.write(
+      reinterpret_cast<const char*>(tokens.data()),
+      tokens.size() * sizeof(int));
+  if (!file) {
+    throw std::runtime_error(
+        "ShardedTextDataset::writeShard - failed to write: " + path.string());
+  }
+}
+
+ShardedTextDataset::ShardedTextDataset(
+    const std::vector<fs::path>& shardPaths,
+    int padIndex,
+    int64_t tokensPerSample /* = 1024 */,
+    int64_t batchSize /* = 1 */,
+    bool prefetchNextShard /* = true */)
+    : pad_(padIndex),
+      tokensPerSample_(tokensPerSample),
+      batchSize_(batchSize),
+      prefetch_(prefetchNextShard) {
+  if (tokensPerSample <= 0) {
+    throw std::invalid_argument(
+        "[ShardedTextDataset] tokensPerSample needs to be positive.");
+  }
+  if (batchSize <= 0) {
+    throw std::invalid_argument(
+        "[ShardedTextDataset] BatchSize needs to be positive.");
+  }
+  if (shardPaths.empty()) {
+    throw std::invalid_argument(
+        "[ShardedTextDataset] at least one shard is required.");
+  }
+
+  // Only the fixed-size headers are read here -- startup cost is per shard,
+  // not per token
+  int64_t nTokens = 0;
+  for (const auto& path : shardPaths) {
+    std::ifstream file(path, std::ios::binary);
+    char magic[sizeof(kShardMagic)];
+    uint64_t count = 0;
+    file.read(magic, sizeof(magic));
+    file.read(reinterpret_cast<char*>(&count), sizeof(count));
+    if (!file || std::memcmp(magic, kShardMagic, sizeof(magic)) != 0) {
+      throw std::runtime_error(
+          "[ShardedTextDataset] not a token shard file: " + path.string());
+    }
+
+    Shard shard;
+    shard.path = path;
+    shard.numTokens = count;
+    shard.firstBatch = numBatches_;
+    // same arithmetic as TextDataset's "none" mode, per shard
+    const int64_t nSamples =
+        (shard.numTokens + tokensPerSample - 1) / tokensPerSample;
+    shard.numBatches = (nSamples + batchSize - 1) / batchSize;
+    numBatches_ += shard.numBatches;
+    nTokens += shard.numTokens;
+    shards_.push_back(std::move(shard));
+  }
+
+  FL_LOG(LogLevel::INFO) << "[ShardedTextDataset] Indexed " << nTokens
+                         << " tokens over " << shards_.size()
+                         << " shards and " << size() << " batches";
+}
+
+ShardedTextDataset::~ShardedTextDataset() = default;
+
+ShardedTextDataset::Mapping::~Mapping() {
+#ifndef _WIN32
+  if (data != nullptr) {
+    ::munmap(data, bytes);
+  }
+  if (fd >= 0) {
+    ::close(fd);
+  }
+#endif
+}
+
+const int* ShardedTextDataset::Mapping::tokens() const {
+  return reinterpret_cast<const int*>(
+      static_cast<const uint8_t*>(data) + kShardHeaderBytes);
+}
+
+std::shared_ptr<ShardedTextDataset::Mapping> ShardedTextDataset::mapShard(
+    size_t shardIdx) const {
+#ifdef _WIN32
+  throw std::runtime_error("[ShardedTextDataset] not supported on Windows");
+#else
+  const auto& shard = shards_[shardIdx];
+  auto mapping = std::make_shared<Mapping>();
+  mapping->fd = ::open(shard.path.c_str(), O_RDONLY);
+  if (mapping->fd < 0) {
+    throw std::runtime_error(
+        "[ShardedTextDataset] failed to open: " + shard.path.string());
+  }
+  struct stat fileStat;
+  if (::fstat(mapping->fd, &fileStat) != 0) {
+    throw std::runtime_error(
+        "[ShardedTextDataset] failed to stat: " + shard.path.string());
+  }
+  mapping->bytes = fileStat.st_size;
+  if (mapping->bytes < kShardHeaderBytes + shard.numTokens * sizeof(int)) {
+    throw std::runtime_error(
+        "[ShardedTextDataset] truncated shard: " + shard.path.string());
+  }
+  mapping->data =
+      ::mmap(nullptr, mapping->bytes, PROT_READ, MAP_SHARED, mapping->fd, 0);
+  if (mapping->data == MAP_FAILED) {
+    mapping->data = nullptr;
+    throw std::runtime_error(
+        "[ShardedTextDataset] failed to mmap: " + shard.path.string());
+  }
+  // the shard is consumed front to back -- let readahead run ahead of us
+  ::madvise(mapping->data, mapping->bytes, MADV_SEQUENTIAL);
+  return mapping;
+#endif
+}
+
+std::shared_ptr<ShardedTextDataset::Mapping> ShardedTextDataset::getMapping(
+    size_t shardIdx) const {
+  std::unique_lock<std::mutex> lock(mutex_);
+
+  std::shared_ptr<Mapping> mapping;
+  auto mappedIter = mapped_.find(shardIdx);
+  if (mappedIter != mapped_.end()) {
+    mapping = mappedIter->second;
+  } else {
+    auto inflightIter = inflight_.find(shardIdx);
+    if (inflightIter != inflight_.end()) {
+      auto future = std::move(inflightIter->second);
+      inflight_.erase(inflightIter);
+      lock.unlock();
+      mapping = future.get(); // surfaces prefetch-thread exceptions here
+      lock.lock();
+    } else {
+      lock.unlock();
+      mapping = mapShard(shardIdx);
+      lock.lock();
+    }
+    mapped_[shardIdx] = mapping;
+  }
+
+  // keep only the shard being served and its successor mapped, so resident
+  // memory is bounded by the shard size rather than the corpus size
+  const size_t next = shardIdx + 1;
+  for (auto iter = mapped_.begin(); iter != mapped_.end();) {
+    iter = (iter->first == shardIdx || iter->first == next)
+        ? std::next(iter)
+        : mapped_.erase(iter);
+  }
+  for (auto iter = inflight_.begin(); iter != inflight_.end();) {
+    iter = (iter->first == shardIdx || iter->first == next)
+        ? std::next(iter)
+        : inflight_.erase(iter);
+  }
+
+  if (prefetch_ && next < shards_.size() && mapped_.count(next) == 0 &&
+      inflight_.count(next) == 0) {
+    inflight_[next] = std::async(
+        std::launch::async, [this, next]() { return mapShard(next); });
+  }
+
+  return mapping;
+}
+
+int64_t ShardedTextDataset::size() const {
+  return numBatches_;
+}
+
+std::vector<Tensor> ShardedTextDataset::get(const int64_t idx) const {
+  const int64_t batchIdx = idx % size();
+
+  // locate the shard owning this batch
+  auto shardIter = std::upper_bound(
+      shards_.begin(),
+      shards_.end(),
+      batchIdx,
+      [](int64_t b, const Shard& shard) { return b < shard.firstBatch; });
+  const size_t shardIdx = std::distance(shards_.begin(), shardIter) - 1;
+  const auto& shard = shards_[shardIdx];
+  const auto mapping = getMapping(shardIdx);
+
+  const int64_t nSamples =
+      (shard.numTokens + tokensPerSample_ - 1) / tokensPerSample_;
+  const int64_t firstSample = (batchIdx - shard.firstBatch) * batchSize_;
+  const int64_t lastSample = std::min(firstSample + batchSize_, nSamples);
+  const int64_t nRows = lastSample - firstSample;
+
+  int64_t maxLength = 0;
+  for (int64_t s = firstSample; s < lastSample; ++s) {
+    const int64_t length = std::min(
+        tokensPerSample_, shard.numTokens - s * tokensPerSample_);
+    maxLength = std::max(maxLength, length);
+  }
+
+  // materialize only this batch's windows from the mapped pages
+  std::vector<int> buffer(nRows * maxLength, pad_);
+  for (int64_t s = firstSample; s < lastSample; ++s) {
+    const int64_t firstToken = s * tokensPerSample_;
+    const int64_t length =
+        std::min(tokensPerSample_, shard.numTokens - firstToken);
+    std::memcpy(
+        buffer.data() + (s - firstSample) * maxLength,
+        mapping->tokens() + firstToken,
+        sizeof(int) * length);
+  }
+  return {Tensor::fromVector({maxLength, nRows}, buffer)};
+}
+
+} // namespace text
+} // namespace pkg
+} // namespace fl
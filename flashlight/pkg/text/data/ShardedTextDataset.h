@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <future>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "flashlight/fl/common/Filesystem.h"
+#include "flashlight/fl/flashlight.h"
+
+namespace fl {
+namespace pkg {
+namespace text {
+
+/**
+ * ShardedTextDataset serves LM batches from pre-tokenized binary shards
+ * without ever loading the corpus into memory. Each shard file holds raw
+ * int32 token ids behind a small fixed header (see `writeShard`);
+ * construction reads only the headers, so startup cost is independent of
+ * corpus size. Shards are memory-mapped lazily on first access, batch
+ * windows are materialized in `get` straight from the mapped pages, and the
+ * following shard is mapped ahead of time on a background thread so
+ * sequential iteration never stalls on the first page faults of a new
+ * shard. Only the current and next shards are kept mapped, bounding
+ * resident memory by the shard size rather than the corpus size.
+ *
+ * Batching follows `TextDataset` with `sampleBreakMode = "none"`: the token
+ * stream is split into equal windows of `tokensPerSample` tokens and
+ * `batchSize` windows form a batch. Windows do not cross shard boundaries;
+ * each shard's final window is padded with <pad> instead. Batches are served
+ * in corpus order — shuffle across epochs by shuffling the shard list (or
+ * the data at sharding time), which keeps access sequential per shard and
+ * the prefetcher effective.
+ */
+class ShardedTextDataset : public fl::Dataset {
+ public:
+  /**
+   * Writes pre-tokenized data as a shard file: a magic/version header and
+   * the token count, followed by the raw int32 token ids. Tokenization is
+   * done once, offline, e.g. with the same Tokenizer/Dictionary pipeline
+   * `TextDataset` uses at load time.
+   */
+  static void writeShard(const fs::path& path, const std::vector<int>& tokens);
+
+  /**
+   * @param shardPaths the shard files, in corpus order
+   * @param padIndex index of the <pad> token in the dictionary
+   * @param tokensPerSample number of tokens of one sample
+   * @param batchSize the number of samples in a batch
+   * @param prefetchNextShard map the following shard on a background thread
+   * while the current one is being served
+   */
+  explicit ShardedTextDataset(
+      const std::vector<fs::path>& shardPaths,
+      int padIndex,
+      int64_t tokensPerSample = 1024,
+      int64_t batchSize = 1,
+      bool prefetchNextShard = true);
+
+  ~ShardedTextDataset() override;
+  ShardedTextDataset(const ShardedTextDataset&) = delete;
+  ShardedTextDataset& operator=(const ShardedTextDataset&) = delete;
+
+  int64_t size() const override;
+
+  std::vector<Tensor> get(const int64_t idx) const override;
+
+ private:
+  struct Shard {
+    fs::path path;
+    int64_t numTokens{0};
+    int64_t firstBatch{0};
+    int64_t numBatches{0};
+  };
+
+  // A shard's pages mapped read-only; unmapped on destruction
+  struct Mapping {
+    ~Mapping();
+    const int* tokens() const;
+
+    void* data{nullptr};
+    size_t bytes{0};
+    int fd{-1};
+  };
+
+  // Maps a shard's file; safe to call off-thread
+  std::shared_ptr<Mapping> mapShard(size_t shardIdx) const;
+
+  // Returns the mapping of `shardIdx` (reusing a cached or prefetched one),
+  // kicks off prefetch of the following shard, and drops older mappings
+  std::shared_ptr<Mapping> getMapping(size_t shardIdx) const;
+
+  int pad_;
+  int64_t tokensPerSample_;
+  int64_t batchSize_;
+  bool prefetch_;
+  std::vector<Shard> shards_;
+  int64_t numBatches_{0};
+
+  // lazily-populated mapping cache: the shard being served and, when
+  // prefetching, the following one
+  mutable std::mutex mutex_;
+  mutable std::unordered_map<size_t, std::shared_ptr<Mapping>> mapped_;
+  mutable std::unordered_map<size_t, std::future<std::shared_ptr<Mapping>>>
+      inflight_;
+};
+
+} // namespace text
+} // namespace pkg
+} // namespace fl
@@ -9,6 +9,9 @@
 
 #include <algorithm>
 #include <cstring>
+#include <fstream>
+#include <map>
+#include <system_error>
 #include <utility>
 
 #include "flashlight/lib/text/String.h"
@@ -20,6 +23,76 @@ using fl::lib::text::Tokenizer;
 
 namespace fl::pkg::text {
 
+namespace {
+
+constexpr uint64_t kTokenCacheMagic = 0x464c544f4b434831; // FLTOKCH1
+
+void hashCombine(uint64_t& hash, const std::string& value) {
+  // FNV-1a
+  for (char c : value) {
+    hash = (hash ^ static_cast<unsigned char>(c)) * 1099511628211ULL;
+  }
+  hash = (hash ^ 0xff) * 1099511628211ULL; // delimit fields
+}
+
+bool readTokenCache(
+    const fs::path& path,
+    std::vector<int>& data,
+    std::vector<std::pair<int64_t, int64_t>>& sentenceRanges) {
+  std::ifstream stream(path, std::ios::binary);
+  if (!stream) {
+    return false;
+  }
+  uint64_t magic = 0;
+  int64_t nTokens = 0, nRanges = 0;
+  stream.read(reinterpret_cast<char*>(&magic), sizeof(magic));
+  stream.read(reinterpret_cast<char*>(&nTokens), sizeof(nTokens));
+  stream.read(reinterpret_cast<char*>(&nRanges), sizeof(nRanges));
+  if (!stream || magic != kTokenCacheMagic || nTokens <= 0 || nRanges < 0) {
+    return false;
+  }
+  data.resize(nTokens);
+  sentenceRanges.resize(nRanges);
+  stream.read(reinterpret_cast<char*>(data.data()), sizeof(int) * nTokens);
+  stream.read(
+      reinterpret_cast<char*>(sentenceRanges.data()),
+      sizeof(std::pair<int64_t, int64_t>) * nRanges);
+  return bool(stream);
+}
+
+void writeTokenCache(
+    const fs::path& path,
+    const std::vector<int>& data,
+    const std::vector<std::pair<int64_t, int64_t>>& sentenceRanges) {
+  // write to a temporary and rename, so concurrent runs sharing the cache
+  // directory never observe a partial entry
+  const fs::path tmpPath = path.string() + ".tmp";
+  {
+    std::ofstream stream(tmpPath, std::ios::binary | std::ios::trunc);
+    if (!stream) {
+      return;
+    }
+    const int64_t nTokens = data.size(), nRanges = sentenceRanges.size();
+    stream.write(
+        reinterpret_cast<const char*>(&kTokenCacheMagic),
+        sizeof(kTokenCacheMagic));
+    stream.write(reinterpret_cast<const char*>(&nTokens), sizeof(nTokens));
+    stream.write(reinterpret_cast<const char*>(&nRanges), sizeof(nRanges));
+    stream.write(
+        reinterpret_cast<const char*>(data.data()), sizeof(int) * nTokens);
+    stream.write(
+        reinterpret_cast<const char*>(sentenceRanges.data()),
+        sizeof(std::pair<int64_t, int64_t>) * nRanges);
+    if (!stream) {
+      return;
+    }
+  }
+  std::error_code ec;
+  fs::rename(tmpPath, path, ec);
+}
+
+} // namespace
+
 TextDataset::TextDataset(
     const fs::path& dataDirectory,
     const std::string& filenames,
@@ -30,43 +103,82 @@ TextDataset::TextDataset(
     int64_t batchSize /* = 1 */,
     const std::string& sampleBreakMode /* = "none" */,
     const bool useDynamicBatching /* = false */,
-    const size_t reserveSpaceSize /* = kMaxTokenInBuffer */)
+    const size_t reserveSpaceSize /* = kMaxTokenInBuffer */,
+    const fs::path& cacheDir /* = "" */)
     : pad_(dictionary.getIndex(fl::lib::text::kPadToken)) {
   /* 1. Read data */
   // data_ will have the following layout:
   // <eos> sentence <eos> sentence <eos> ... <eos> sentence <eos>
   data_.clear();
-  data_.reserve(reserveSpaceSize);
   const auto eos = dictionary.getIndex(fl::lib::text::kEosToken);
-  data_.push_back(eos);
 
   // Each pair of indices in sentenceRanges indicates the position in data_ of
   // the 2 <eos> tokens around a given sentence.
   std::vector<std::pair<int64_t, int64_t>> sentenceRanges;
   auto files = lib::split(',', filenames);
-  for (const auto& file : files) {
-    const fs::path path = dataDirectory / file;
-    reader.loadFile(path);
 
-    while (reader.hasNextLine()) {
-      const auto currentEosPosition = data_.size() - 1;
-      if (!sentenceRanges.empty()) {
-        sentenceRanges.back().second = currentEosPosition;
-      }
+  fs::path cachePath;
+  if (!cacheDir.empty()) {
+    // Key the cache on everything the token stream depends on: the corpus
+    // files (path, size, modification time), the dictionary contents and the
+    // reader partition. Tokenization itself is configuration-free.
+    uint64_t hash = 14695981039346656037ULL;
+    for (const auto& file : files) {
+      const fs::path path = dataDirectory / file;
+      hashCombine(hash, path.string());
+      std::error_code ec;
+      hashCombine(hash, std::to_string(fs::file_size(path, ec)));
+      hashCombine(
+          hash,
+          std::to_string(
+              fs::last_write_time(path, ec).time_since_epoch().count()));
+    }
+    for (int i = 0; i < dictionary.entrySize(); ++i) {
+      hashCombine(hash, dictionary.getEntry(i));
+    }
+    hashCombine(
+        hash,
+        std::to_string(reader.getRank()) + "/" +
+            std::to_string(reader.getTotalReaders()));
+    cachePath = cacheDir /
+        lib::format(
+            "tokens_%016llx.bin", static_cast<unsigned long long>(hash));
+  }
+
+  if (!cachePath.empty() && readTokenCache(cachePath, data_, sentenceRanges)) {
+    FL_LOG(LogLevel::INFO) << "[TextDataset] (" << reader.getRank() << "/"
+                           << reader.getTotalReaders()
+                           << ") Loaded token cache " << cachePath;
+  } else {
+    data_.reserve(reserveSpaceSize);
+    data_.push_back(eos);
+    for (const auto& file : files) {
+      const fs::path path = dataDirectory / file;
+      reader.loadFile(path);
 
-      const auto tokens = tokenizer.tokenize(reader.getLine());
-      const auto indices = dictionary.mapEntriesToIndices(tokens);
-      if (data_.size() + indices.size() > kMaxTokenInBuffer) {
-        FL_LOG(LogLevel::INFO)
-            << "[TextDataset] stop loading at 10,000,000,000 tokens";
-        break;
+      while (reader.hasNextLine()) {
+        const auto currentEosPosition = data_.size() - 1;
+        if (!sentenceRanges.empty()) {
+          sentenceRanges.back().second = currentEosPosition;
+        }
+
+        const auto tokens = tokenizer.tokenize(reader.getLine());
+        const auto indices = dictionary.mapEntriesToIndices(tokens);
+        if (data_.size() + indices.size() > kMaxTokenInBuffer) {
+          FL_LOG(LogLevel::INFO)
+              << "[TextDataset] stop loading at 10,000,000,000 tokens";
+          break;
+        }
+        sentenceRanges.emplace_back(currentEosPosition, -1);
+        data_.insert(data_.end(), indices.begin(), indices.end());
+        data_.push_back(eos);
+      }
+      if (!sentenceRanges.empty()) {
+        sentenceRanges.back().second = data_.size() - 1;
       }
-      sentenceRanges.emplace_back(currentEosPosition, -1);
-      data_.insert(data_.end(), indices.begin(), indices.end());
-      data_.push_back(eos);
     }
-    if (!sentenceRanges.empty()) {
-      sentenceRanges.back().second = data_.size() - 1;
+    if (!cachePath.empty()) {
+      writeTokenCache(cachePath, data_, sentenceRanges);
     }
   }
   const int64_t nTokens = data_.size();
@@ -131,9 +243,58 @@ TextDataset::TextDataset(
     if (!batch.empty()) {
       batches_.push_back(std::move(batch));
     }
+  } else if (sampleBreakMode == "pack") {
+    // Best-fit-decreasing packing: whole sentences (with their surrounding
+    // <eos>) are concatenated into fixed-length sequences of
+    // `tokensPerSample` tokens, so almost no token is spent on padding.
+    // Sentences with length > `tokensPerSample` are skipped;
+    // Total tokens per batch is `batchSize` * `tokensPerSample`
+
+    tokensPerSample_ = tokensPerSample;
+    std::stable_sort(
+        sentenceRanges.begin(),
+        sentenceRanges.end(),
+        [](const std::pair<int64_t, int64_t>& p1,
+           const std::pair<int64_t, int64_t>& p2) {
+          return p1.second - p1.first > p2.second - p2.first;
+        });
+
+    std::vector<std::vector<SamplePosition>> sequences;
+    // remaining capacity -> sequence index; each sentence goes to the
+    // fullest sequence it still fits in
+    std::multimap<int64_t, size_t> byRemaining;
+    for (const auto& range : sentenceRanges) {
+      const int64_t sampleSize = range.second - range.first + 1;
+      if (sampleSize > tokensPerSample) {
+        continue;
+      }
+      auto iter = byRemaining.lower_bound(sampleSize);
+      if (iter == byRemaining.end()) {
+        sequences.emplace_back();
+        iter = byRemaining.emplace(tokensPerSample, sequences.size() - 1);
+      }
+      const auto [remaining, sequenceIdx] = *iter;
+      byRemaining.erase(iter);
+      byRemaining.emplace(remaining - sampleSize, sequenceIdx);
+      sequences[sequenceIdx].emplace_back(
+          SamplePosition{range.first, range.second});
+    }
+
+    std::vector<std::vector<SamplePosition>> batch;
+    for (auto& sequence : sequences) {
+      batch.push_back(std::move(sequence));
+      if (batch.size() == batchSize) {
+        packedBatches_.push_back(std::move(batch));
+        batch = std::vector<std::vector<SamplePosition>>();
+      }
+    }
+    if (!batch.empty()) {
+      packedBatches_.push_back(std::move(batch));
+    }
   } else {
     throw std::invalid_argument(
-        "Invalid sampleBreakMode: should be none or eos, but it is given " +
+        "Invalid sampleBreakMode: should be none, eos or pack, but it is "
+        "given " +
         sampleBreakMode);
   }
 
@@ -144,10 +305,40 @@ TextDataset::TextDataset(
 }
 
 int64_t TextDataset::size() const {
-  return batches_.size();
+  return packedBatches_.empty() ? batches_.size() : packedBatches_.size();
 }
 
 std::vector<Tensor> TextDataset::get(const int64_t idx) const {
+  if (!packedBatches_.empty()) {
+    // "pack" mode: fixed-length sequences plus the per-position document
+    // index, from which callers build the attention mask
+    // (`fl::Transformer::getDocumentMask`) and reset positions at document
+    // boundaries; padded positions get a document index of -1
+    const auto& batch = packedBatches_[idx % size()];
+    const int64_t bsz = batch.size();
+    std::vector<int> tokens(bsz * tokensPerSample_, pad_);
+    std::vector<int> documents(bsz * tokensPerSample_, -1);
+    for (int64_t i = 0; i < bsz; ++i) {
+      int64_t offset = 0;
+      for (size_t doc = 0; doc < batch[i].size(); ++doc) {
+        const auto& pos = batch[i][doc];
+        const int64_t length = pos.last - pos.first + 1;
+        std::memcpy(
+            tokens.data() + i * tokensPerSample_ + offset,
+            data_.data() + pos.first,
+            sizeof(int) * length);
+        std::fill_n(
+            documents.begin() + i * tokensPerSample_ + offset,
+            length,
+            static_cast<int>(doc));
+        offset += length;
+      }
+    }
+    return {
+        Tensor::fromVector({tokensPerSample_, bsz}, tokens),
+        Tensor::fromVector({tokensPerSample_, bsz}, documents)};
+  }
+
   const auto& batch = batches_[idx % size()];
   int64_t maxLength = 0;
   for (const auto& pos : batch) {
@@ -168,6 +359,12 @@ std::vector<Tensor> TextDataset::get(const int64_t idx) const {
 void TextDataset::shuffle(uint64_t seed) {
   std::mt19937_64 rng(seed);
   // Deterministic method across compilers.
+  if (!packedBatches_.empty()) {
+    for (uint64_t i = size() - 1; i >= 1; --i) {
+      std::swap(packedBatches_[i], packedBatches_[rng() % (i + 1)]);
+    }
+    return;
+  }
   for (uint64_t i = size() - 1; i >= 1; --i) {
     std::swap(batches_[i], batches_[rng() % (i + 1)]);
   }
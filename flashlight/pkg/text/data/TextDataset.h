@@ -51,11 +51,26 @@ constexpr size_t kMaxTokenInBuffer = 10000000000;
  * - "eos": Each sentence is a sample padded with <eos> on both ends.
  *          Sentences with length > `tokensPerSample` are skipped;
  *          Total tokens per batch <= `batchSize` * `tokensPerSample`
+ * - "pack": Whole sentences (padded with <eos> on both ends) are packed
+ *           best-fit into fixed-length sequences of `tokensPerSample` tokens,
+ *           so almost no token is spent on padding. Sentences with length >
+ *           `tokensPerSample` are skipped. `get` returns a second tensor of
+ *           the same shape holding the per-position document index (-1 on
+ *           padding) -- feed it to `fl::Transformer::getDocumentMask` so
+ *           attention does not cross document boundaries, and use it to reset
+ *           positions per document.
  * @param useDynamicBatching Use dynamic batching when `sampleBreakMode`="eos".
  * In this case, `batchsize` is ignored and as many sentences as possible are
  * included in each batch. All samples are padded with token <pad> to the length
  * of the longest one in a certain batch. To better fit more samples in each
  * batch, samples are sorted by length.
+ * @param cacheDir Directory for the on-disk token-index cache; empty disables
+ * caching. The tokenized stream and sentence boundaries are written out after
+ * the first load and reused by later runs, keyed by the corpus files (path,
+ * size, modification time), the dictionary contents and the reader partition,
+ * so a stale or foreign cache entry is never picked up. Each rank reads and
+ * writes only its own partition's entry, and the directory can be shared
+ * across ranks and experiments.
  */
 
 class TextDataset : public fl::Dataset {
@@ -70,7 +85,8 @@ class TextDataset : public fl::Dataset {
       int64_t batchSize = 1,
       const std::string& sampleBreakMode = "none",
       const bool useDynamicBatching = false,
-      const size_t reserveSpaceSize = kMaxTokenInBuffer);
+      const size_t reserveSpaceSize = kMaxTokenInBuffer,
+      const fs::path& cacheDir = "");
 
   int64_t size() const override;
 
@@ -88,6 +104,10 @@ class TextDataset : public fl::Dataset {
 
   std::vector<int> data_; // eos prepended, so all indices shifted by 1
   std::vector<std::vector<SamplePosition>> batches_;
+
+  // "pack" mode only: per batch, per sequence, the documents packed into it
+  int64_t tokensPerSample_{0};
+  std::vector<std::vector<std::vector<SamplePosition>>> packedBatches_;
 };
 
 } // namespace text
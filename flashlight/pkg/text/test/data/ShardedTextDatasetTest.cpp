@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <fstream>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "flashlight/fl/common/Filesystem.h"
+#include "flashlight/fl/tensor/Init.h"
+#include "flashlight/pkg/text/data/ShardedTextDataset.h"
+
+using namespace fl;
+using namespace fl::pkg::text;
+
+namespace {
+
+constexpr int kPad = 999;
+
+std::vector<int> hostTokens(const Tensor& tensor) {
+  return tensor.toHostVector<int>();
+}
+
+} // namespace
+
+TEST(ShardedTextDatasetTest, BatchesFromShards) {
+  // shard 1: tokens 0..9 -> samples (0-3)(4-7)(8-9) -> batches of 2, 1 rows
+  // shard 2: tokens 100..106 -> samples (100-103)(104-106) -> 1 batch
+  std::vector<int> shard1(10);
+  std::iota(shard1.begin(), shard1.end(), 0);
+  std::vector<int> shard2(7);
+  std::iota(shard2.begin(), shard2.end(), 100);
+
+  const auto dir = fs::temp_directory_path();
+  ShardedTextDataset::writeShard(dir / "shard1.bin", shard1);
+  ShardedTextDataset::writeShard(dir / "shard2.bin", shard2);
+
+  ShardedTextDataset dataset(
+      {dir / "shard1.bin", dir / "shard2.bin"},
+      kPad,
+      /* tokensPerSample = */ 4,
+      /* batchSize = */ 2);
+  ASSERT_EQ(dataset.size(), 3);
+
+  auto batch = dataset.get(0);
+  ASSERT_EQ(batch.size(), 1);
+  ASSERT_EQ(batch[0].shape(), Shape({4, 2}));
+  EXPECT_EQ(hostTokens(batch[0]), std::vector<int>({0, 1, 2, 3, 4, 5, 6, 7}));
+
+  // final window of a shard is shorter; windows never cross shards
+  batch = dataset.get(1);
+  ASSERT_EQ(batch[0].shape(), Shape({2, 1}));
+  EXPECT_EQ(hostTokens(batch[0]), std::vector<int>({8, 9}));
+
+  // the second row of the last batch is padded to the window length
+  batch = dataset.get(2);
+  ASSERT_EQ(batch[0].shape(), Shape({4, 2}));
+  EXPECT_EQ(
+      hostTokens(batch[0]),
+      std::vector<int>({100, 101, 102, 103, 104, 105, 106, kPad}));
+
+  // indices wrap like TextDataset
+  EXPECT_EQ(hostTokens(dataset.get(4)[0]), std::vector<int>({8, 9}));
+}
+
+TEST(ShardedTextDatasetTest, SequentialIterationWithPrefetch) {
+  std::vector<int> tokens(64);
+  std::iota(tokens.begin(), tokens.end(), 0);
+
+  const auto dir = fs::temp_directory_path();
+  std::vector<fs::path> paths;
+  for (int i = 0; i < 4; ++i) {
+    const auto path = dir / ("prefetch_shard" + std::to_string(i) + ".bin");
+    ShardedTextDataset::writeShard(
+        path,
+        std::vector<int>(
+            tokens.begin() + i * 16, tokens.begin() + (i + 1) * 16));
+    paths.push_back(path);
+  }
+
+  ShardedTextDataset dataset(
+      paths, kPad, /* tokensPerSample = */ 8, /* batchSize = */ 2);
+  ASSERT_EQ(dataset.size(), 4);
+
+  // each batch holds one shard's 16 tokens; iterating in order exercises the
+  // background mapping of the following shard
+  for (int64_t i = 0; i < dataset.size(); ++i) {
+    const auto batch = dataset.get(i);
+    ASSERT_EQ(batch[0].shape(), Shape({8, 2}));
+    std::vector<int> expected(
+        tokens.begin() + i * 16, tokens.begin() + (i + 1) * 16);
+    EXPECT_EQ(hostTokens(batch[0]), expected);
+  }
+}
+
+TEST(ShardedTextDatasetTest, InvalidInputs) {
+  const auto dir = fs::temp_directory_path();
+  const auto path = dir / "not_a_shard.bin";
+  {
+    std::ofstream file(path, std::ios::binary);
+    file << "plain text, not a token shard";
+  }
+  EXPECT_THROW(
+      ShardedTextDataset({path}, kPad, 4, 2), std::runtime_error);
+
+  ShardedTextDataset::writeShard(dir / "tiny_shard.bin", {1, 2, 3});
+  EXPECT_THROW(
+      ShardedTextDataset({dir / "tiny_shard.bin"}, kPad, 0, 2),
+      std::invalid_argument);
+  EXPECT_THROW(
+      ShardedTextDataset({dir / "tiny_shard.bin"}, kPad, 4, 0),
+      std::invalid_argument);
+  EXPECT_THROW(ShardedTextDataset({}, kPad, 4, 2), std::invalid_argument);
+}
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  fl::init();
+  return RUN_ALL_TESTS();
+}
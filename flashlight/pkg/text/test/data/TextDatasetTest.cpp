@@ -140,6 +140,106 @@ TEST(TextDatasetTest, EosModeWithDynamicBatching) {
   }
 }
 
+TEST(TextDatasetTest, PackMode) {
+  fl::lib::text::Tokenizer tokenizer;
+  fl::lib::text::PartialFileReader partialFileReader(0, 1);
+  Dictionary dictionary = createDictionary(dataDir / "dictionary.txt");
+
+  int tokensPerSample = 12;
+  int batchSize = 2;
+
+  TextDataset dataset(
+      dataDir,
+      "train.txt",
+      partialFileReader,
+      tokenizer,
+      dictionary,
+      tokensPerSample,
+      batchSize,
+      "pack",
+      /* useDynamicBatching = */ false,
+      /* reserveSpaceSize = */ 0);
+
+  // 8 sentences of lengths {7, 6, 5, 4, 5, 5, 6, 7} (including both <eos>)
+  // pack best-fit into 4 sequences of 12 tokens -> 2 batches
+  ASSERT_EQ(dataset.size(), 2);
+
+  auto sample = dataset.get(0);
+  ASSERT_EQ(sample.size(), 2);
+  ASSERT_EQ(sample[0].dim(0), tokensPerSample);
+  ASSERT_EQ(sample[0].dim(1), batchSize);
+  ASSERT_EQ(sample[1].shape(), sample[0].shape());
+
+  // both sequences pack a 7-token and a 5-token sentence with no padding
+  EXPECT_EQ(
+      sample[0].toHostVector<int>(),
+      std::vector<int>({0, 4, 5, 2, 6, 7, 0, 0, 4, 5, 7,  0,
+                        0, 4, 5, 6, 9, 7, 0, 0, 8, 2, 10, 0}));
+  EXPECT_EQ(
+      sample[1].toHostVector<int>(),
+      std::vector<int>({0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1,
+                        0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1}));
+
+  // the last sequence holds 9 tokens; its tail is <pad> with document id -1
+  sample = dataset.get(1);
+  EXPECT_EQ(
+      sample[0].toHostVector<int>(),
+      std::vector<int>({0, 4, 5, 6, 7, 0, 0, 4, 7, 10, 9, 0,
+                        0, 2, 10, 9, 0, 0, 7, 4, 0, 1, 1, 1}));
+  EXPECT_EQ(
+      sample[1].toHostVector<int>(),
+      std::vector<int>({0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1,
+                        0, 0, 0, 0, 0, 1, 1, 1, 1, -1, -1, -1}));
+}
+
+TEST(TextDatasetTest, TokenCache) {
+  fl::lib::text::Tokenizer tokenizer;
+  Dictionary dictionary = createDictionary(dataDir / "dictionary.txt");
+
+  const fs::path cacheDir = fs::temp_directory_path() / "textds_token_cache";
+  fs::remove_all(cacheDir);
+  fs::create_directory(cacheDir);
+
+  int tokensPerSample = 5;
+  int batchSize = 2;
+
+  auto makeDataset = [&](const fs::path& cache) {
+    fl::lib::text::PartialFileReader partialFileReader(0, 1);
+    return TextDataset(
+        dataDir,
+        "train.txt",
+        partialFileReader,
+        tokenizer,
+        dictionary,
+        tokensPerSample,
+        batchSize,
+        "none",
+        /* useDynamicBatching = */ false,
+        /* reserveSpaceSize = */ 0,
+        cache);
+  };
+
+  // first construction tokenizes and writes the cache entry
+  auto reference = makeDataset("");
+  auto cached = makeDataset(cacheDir);
+  ASSERT_EQ(cached.size(), reference.size());
+  ASSERT_FALSE(fs::is_empty(cacheDir));
+
+  // second construction loads from the cache and must match exactly
+  auto reloaded = makeDataset(cacheDir);
+  ASSERT_EQ(reloaded.size(), reference.size());
+  for (int i = 0; i < reference.size(); i++) {
+    auto expected = reference.get(i);
+    auto sample = reloaded.get(i);
+    ASSERT_EQ(sample.size(), expected.size());
+    for (int j = 0; j < expected.size(); j++) {
+      EXPECT_EQ(
+          sample[j].toHostVector<int>(), expected[j].toHostVector<int>());
+    }
+  }
+  fs::remove_all(cacheDir);
+}
+
 int main(int argc, char** argv) {
   ::testing::InitGoogleTest(&argc, argv);
   fl::init();
@@ -6,6 +6,9 @@
  */
 #include "flashlight/pkg/vision/criterion/Hungarian.h"
 
+#include <future>
+#include <stdexcept>
+
 #include "flashlight/fl/autograd/Functions.h"
 #include "flashlight/fl/tensor/Index.h"
 #include "flashlight/pkg/vision/criterion/HungarianImpl.h"
@@ -25,14 +28,10 @@ Tensor softmax(const Tensor& input, const int dim) {
   return result;
 }
 
-std::pair<Tensor, Tensor> hungarian(Tensor& cost) {
-  cost = fl::transpose(cost, {1, 0, 2, 3});
-  const int M = cost.dim(0);
-  const int N = cost.dim(1);
-  std::vector<float> costHost(cost.elements());
+std::pair<Tensor, Tensor>
+solveAssignment(std::vector<float> costHost, const int M, const int N) {
   std::vector<int> rowIdxs(M);
   std::vector<int> colIdxs(M);
-  cost.host(costHost.data());
   fl::lib::set::hungarian(
       costHost.data(), rowIdxs.data(), colIdxs.data(), M, N);
   auto rowIdxsArray = Tensor::fromVector(rowIdxs);
@@ -46,19 +45,23 @@ namespace fl::pkg::vision {
 HungarianMatcher::HungarianMatcher(
     const float costClass,
     const float costBbox,
-    const float costGiou)
-    : costClass_(costClass), costBbox_(costBbox), costGiou_(costGiou){};
+    const float costGiou,
+    const int numThreads /* = 0 */)
+    : costClass_(costClass), costBbox_(costBbox), costGiou_(costGiou) {
+  if (numThreads < 0) {
+    throw std::invalid_argument(
+        "HungarianMatcher - numThreads must be non-negative");
+  }
+  if (numThreads > 0) {
+    solvePool_ = std::make_shared<ThreadPool>(numThreads);
+  }
+};
 
-std::pair<Tensor, Tensor> HungarianMatcher::matchBatch(
+Tensor HungarianMatcher::getCostMatrix(
     const Tensor& predBoxes,
     const Tensor& predLogits,
     const Tensor& targetBoxes,
     const Tensor& targetClasses) const {
-  // Kind of a hack...
-  if (targetClasses.isEmpty()) {
-    return {fl::fromScalar(0), fl::fromScalar(0)};
-  }
-
   // Create an M X N cost matrix where M is the number of targets and N is the
   // number of preds
   // Class cost
@@ -78,7 +81,7 @@ std::pair<Tensor, Tensor> HungarianMatcher::matchBatch(
 
   auto cost =
       costBbox_ * costBbox + costClass_ * costClass + costGiou_ * costGiou;
-  return ::hungarian(cost);
+  return fl::transpose(cost, {1, 0, 2, 3});
 }
 
 std::vector<std::pair<Tensor, Tensor>> HungarianMatcher::compute(
@@ -86,14 +89,46 @@ std::vector<std::pair<Tensor, Tensor>> HungarianMatcher::compute(
     const Tensor& predLogits,
     const std::vector<Tensor>& targetBoxes,
     const std::vector<Tensor>& targetClasses) const {
-  std::vector<std::pair<Tensor, Tensor>> results;
-  for (int b = 0; b < predBoxes.dim(2); b++) {
-    auto result = matchBatch(
+  const int batchSize = predBoxes.dim(2);
+  // assemble all cost matrices up front so the device works ahead of the
+  // host transfers below
+  std::vector<Tensor> costs(batchSize);
+  for (int b = 0; b < batchSize; b++) {
+    // Kind of a hack...
+    if (targetClasses[b].isEmpty()) {
+      continue;
+    }
+    costs[b] = getCostMatrix(
         predBoxes(fl::span, fl::span, fl::range(b, b + 1)),
         predLogits(fl::span, fl::span, fl::range(b, b + 1)),
         targetBoxes[b],
         targetClasses[b]);
-    results.emplace_back(result);
+  }
+
+  // transfer each image's cost matrix to the host in order; with a solve
+  // pool, the transfer of image b overlaps the solves of images before it
+  std::vector<std::pair<Tensor, Tensor>> results(batchSize);
+  std::vector<std::future<std::pair<Tensor, Tensor>>> futures(batchSize);
+  for (int b = 0; b < batchSize; b++) {
+    if (costs[b].isEmpty()) {
+      results[b] = {fl::fromScalar(0), fl::fromScalar(0)};
+      continue;
+    }
+    const int M = costs[b].dim(0);
+    const int N = costs[b].dim(1);
+    std::vector<float> costHost(costs[b].elements());
+    costs[b].host(costHost.data());
+    if (solvePool_) {
+      futures[b] =
+          solvePool_->enqueue(::solveAssignment, std::move(costHost), M, N);
+    } else {
+      results[b] = ::solveAssignment(std::move(costHost), M, N);
+    }
+  }
+  for (int b = 0; b < batchSize; b++) {
+    if (futures[b].valid()) {
+      results[b] = futures[b].get();
+    }
   }
   return results;
 };
@@ -6,6 +6,9 @@
  */
 #pragma once
 
+#include <memory>
+
+#include "flashlight/fl/common/threadpool/ThreadPool.h"
 #include "flashlight/fl/tensor/TensorBase.h"
 
 namespace fl {
@@ -16,10 +19,17 @@ class HungarianMatcher {
  public:
   HungarianMatcher() = default;
 
+  /*
+   * @param numThreads number of threads solving assignments in parallel.
+   * With numThreads > 0 the host transfer of one image's cost matrix
+   * overlaps the solve of the previous ones; 0 solves serially on the
+   * calling thread.
+   */
   HungarianMatcher(
       const float costClass,
       const float costBbox,
-      const float costGiou);
+      const float costGiou,
+      const int numThreads = 0);
 
   std::vector<std::pair<Tensor, Tensor>> compute(
       const Tensor& predBoxes,
@@ -31,15 +41,14 @@ class HungarianMatcher {
   float costClass_;
   float costBbox_;
   float costGiou_;
+  std::shared_ptr<ThreadPool> solvePool_;
 
-  // First is SrcIdx, second is ColIdx
-  std::pair<Tensor, Tensor> matchBatch(
+  // M (targets) X N (preds) cost matrix of one image on the device
+  Tensor getCostMatrix(
       const Tensor& predBoxes,
       const Tensor& predLogits,
       const Tensor& targetBoxes,
       const Tensor& targetClasses) const;
-
-  Tensor getCostMatrix(const Tensor& input, const Tensor& target);
 };
 
 } // namespace vision
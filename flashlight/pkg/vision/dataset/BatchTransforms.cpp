@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "flashlight/pkg/vision/dataset/BatchTransforms.h"
+
+#include <cstdlib>
+#include <stdexcept>
+
+#include "flashlight/fl/tensor/Index.h"
+#include "flashlight/fl/tensor/Random.h"
+
+namespace fl::pkg::vision {
+
+BatchImageTransform normalizeBatchTransform(
+    const std::vector<float>& meanVector,
+    const std::vector<float>& stdVector) {
+  const Tensor mean = Tensor::fromVector({1, 1, 3}, meanVector);
+  const Tensor std = Tensor::fromVector({1, 1, 3}, stdVector);
+  return [mean, std](const Tensor& in) {
+    Tensor out = in.astype(fl::dtype::f32) / 255.f;
+    out = out - mean;
+    out = out / std;
+    return out;
+  };
+};
+
+BatchImageTransform randomHorizontalFlipBatchTransform(const float p) {
+  return [p](const Tensor& in) {
+    // one draw per image; fl::where selects between the flipped and the
+    // original batch without leaving the device
+    Tensor flipMask = fl::rand({1, 1, 1, in.dim(3)}) < p;
+    flipMask = fl::tile(flipMask, {in.dim(0), in.dim(1), in.dim(2), 1});
+    return fl::where(flipMask, fl::flip(in, 0), in);
+  };
+};
+
+BatchImageTransform randomCropBatchTransform(const int tw, const int th) {
+  return [tw, th](const Tensor& in) {
+    const int w = in.dim(0);
+    const int h = in.dim(1);
+    if (tw > w || th > h) {
+      throw std::runtime_error(
+          "Target th and target width are great the image size");
+    }
+    // offsets are scalar metadata - sampling them on the host costs no
+    // device sync; pixels stay on the device throughout
+    std::vector<Tensor> crops(in.dim(3));
+    for (int64_t i = 0; i < in.dim(3); ++i) {
+      const int x = std::rand() % (w - tw + 1);
+      const int y = std::rand() % (h - th + 1);
+      crops[i] = in(
+          fl::range(x, x + tw),
+          fl::range(y, y + th),
+          fl::span,
+          fl::range(i, i + 1));
+    }
+    return fl::concatenate(crops, 3);
+  };
+};
+
+BatchImageTransform randomColorJitterBatchTransform(
+    const float brightness,
+    const float contrast,
+    const float saturation) {
+  return [brightness, contrast, saturation](const Tensor& in) {
+    auto perImageScale = [&in](const float s) {
+      return 1.f + (fl::rand({1, 1, 1, in.dim(3)}) * 2.f - 1.f) * s;
+    };
+    Tensor out = in.astype(fl::dtype::f32);
+    if (brightness > 0) {
+      out = out * perImageScale(brightness);
+    }
+    if (contrast > 0) {
+      Tensor mean = fl::mean(out, {0, 1, 2}, /* keepDims = */ true);
+      out = (out - mean) * perImageScale(contrast) + mean;
+    }
+    if (saturation > 0) {
+      Tensor gray = fl::mean(out, {2}, /* keepDims = */ true);
+      out = (out - gray) * perImageScale(saturation) + gray;
+    }
+    return fl::clip(out, 0., 255.);
+  };
+};
+
+BatchImageTransform composeBatchTransform(
+    std::vector<BatchImageTransform> transformfns) {
+  return [transformfns](const Tensor& in) {
+    Tensor out = in;
+    for (const auto& fn : transformfns) {
+      out = fn(out);
+    }
+    return out;
+  };
+};
+
+} // namespace fl::pkg::vision
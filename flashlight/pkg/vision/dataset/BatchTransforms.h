@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <functional>
+#include <vector>
+
+#include "flashlight/fl/tensor/TensorBase.h"
+
+namespace fl {
+namespace pkg {
+namespace vision {
+
+/*
+ * Batch-level counterpart of ImageTransform. Operates on a W X H X C X N
+ * image batch that has been uploaded to the compute device once, so the
+ * transforms below run as device kernels at the head of the training graph
+ * instead of per image in loader threads.
+ */
+using BatchImageTransform = std::function<Tensor(const Tensor&)>;
+
+/*
+ * Converts the batch to float and normalizes each channel with
+ * @param meanVec and @param stdVec; same semantics as `normalizeImage`
+ */
+BatchImageTransform normalizeBatchTransform(
+    const std::vector<float>& meanVec,
+    const std::vector<float>& stdVec);
+
+/*
+ * Flip each image in the batch horizontally with probability @param p,
+ * decided independently per image on the device
+ */
+BatchImageTransform randomHorizontalFlipBatchTransform(const float p = 0.5);
+
+/*
+ * Crop every image in the batch to a target width @param tw and height
+ * @param th, with offsets sampled independently per image
+ */
+BatchImageTransform randomCropBatchTransform(const int tw, const int th);
+
+/*
+ * Jitter brightness, contrast and saturation of each image, with scales
+ * drawn uniformly from [1 - s, 1 + s] independently per image
+ */
+BatchImageTransform randomColorJitterBatchTransform(
+    const float brightness,
+    const float contrast,
+    const float saturation);
+
+/*
+ * Utility method for composing multiple batch transform functions
+ */
+BatchImageTransform composeBatchTransform(
+    std::vector<BatchImageTransform> transformfns);
+
+} // namespace vision
+} // namespace pkg
+} // namespace fl
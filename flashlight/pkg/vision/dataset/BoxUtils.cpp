@@ -14,6 +14,7 @@
 #include "flashlight/fl/autograd/Functions.h"
 #include "flashlight/fl/tensor/Index.h"
 #include "flashlight/fl/tensor/TensorBase.h"
+#include "flashlight/pkg/vision/tensor/VisionOps.h"
 
 namespace fl::pkg::vision {
 
@@ -212,16 +213,9 @@ Tensor generalizedBoxIou(const Tensor& bboxes1, const Tensor& bboxes2) {
              fl::all(bboxes2(fl::range(2, 4)) >= bboxes2(fl::range(0, 2))))
              .scalar<uint32_t>());
 
-  Tensor iou, uni;
-  std::tie(iou, uni) = boxIou(bboxes1, bboxes2);
-  auto lt = cartesian(
-      bboxes1(fl::range(0, 2)), bboxes2(fl::range(0, 2)), fl::minimum);
-  auto rb = cartesian(
-      bboxes1(fl::range(2, 4)), bboxes2(fl::range(2, 4)), fl::maximum);
-  auto wh = fl::maximum((rb - lt), 0.0);
-  auto area = wh(fl::range(0, 1)) * wh(fl::range(1, 2));
-  area = flatten(area, 0, 1);
-  return iou - (area - uni) / area;
+  // fused pairwise kernel - no gradient is needed on the Tensor path, which
+  // only assembles matching cost matrices
+  return fl::generalizedBoxIouMatrix(bboxes1, bboxes2);
 }
 
 Variable l1Loss(const Variable& input, const Variable& target) {
@@ -19,16 +19,37 @@ DistributedDataset::DistributedDataset(
     int64_t prefetchSize,
     BatchDatasetPolicy batchPolicy) {
   shuffle_ = std::make_shared<ShuffleDataset>(base);
-  auto permfn = [worldSize, worldRank, nRepeated](int64_t idx) {
-    return (idx * worldSize + worldRank) / nRepeated;
-  };
-
-  int partitionSize = shuffle_->size() / worldSize;
-  int leftOver = shuffle_->size() % worldSize;
-  if (worldRank < leftOver) {
-    partitionSize++;
+  if (nRepeated > 1) {
+    // repeated augmentation: each sample is seen nRepeated times per epoch,
+    // spread across ranks
+    auto permfn = [worldSize, worldRank, nRepeated](int64_t idx) {
+      return (idx * worldSize + worldRank) / nRepeated;
+    };
+    int partitionSize = shuffle_->size() / worldSize;
+    int leftOver = shuffle_->size() % worldSize;
+    if (worldRank < leftOver) {
+      partitionSize++;
+    }
+    ds_ = std::make_shared<ResampleDataset>(shuffle_, permfn, partitionSize);
+  } else {
+    // stateless shard: each rank's sample index is computed arithmetically
+    // from its position, so together with the constant-space shuffle an
+    // epoch transition materializes no permutation arrays. INCLUDE_LAST
+    // spreads the leftover samples over the ranks; other policies drop them
+    // so every rank sees the same number of batches.
+    const int64_t numSamples = shuffle_->size();
+    const bool fillLast = batchPolicy == BatchDatasetPolicy::INCLUDE_LAST;
+    auto permfn = [numSamples, worldRank, worldSize, batchSize, fillLast](
+                      int64_t idx) {
+      return roundRobinPartitionIndex(
+          numSamples, idx, worldRank, worldSize, batchSize, fillLast);
+    };
+    ds_ = std::make_shared<ResampleDataset>(
+        shuffle_,
+        permfn,
+        roundRobinPartitionSize(
+            numSamples, worldRank, worldSize, batchSize, fillLast));
   }
-  ds_ = std::make_shared<ResampleDataset>(shuffle_, permfn, partitionSize);
   ds_ = std::make_shared<PrefetchDataset>(ds_, numThreads, prefetchSize);
   ds_ = std::make_shared<BatchDataset>(ds_, batchSize, batchPolicy);
 }
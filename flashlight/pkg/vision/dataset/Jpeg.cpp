@@ -15,13 +15,117 @@
 #define STB_IMAGE_IMPLEMENTATION
 #include "stb_image.h"
 
+#ifdef FL_BUILD_PKG_VISION_TURBOJPEG
+#include <turbojpeg.h>
+
+#include <algorithm>
+#include <fstream>
+#include <vector>
+#endif
+
 namespace fl::pkg::vision {
 
+#ifdef FL_BUILD_PKG_VISION_TURBOJPEG
+namespace {
+
+/*
+ * Decodes a jpeg with libjpeg-turbo. When minEdgeSize > 0, the coarsest of
+ * libjpeg-turbo's M/8 scaling factors whose output still has a shortest edge
+ * of at least minEdgeSize is applied inside the decoder (fewer DCT
+ * coefficients are dequantized and no full-resolution pixels are ever
+ * materialized). Returns an empty tensor on any failure so the caller can
+ * fall back to stb_image, which handles progressive jpegs and other formats.
+ */
+Tensor loadJpegTurbo(const std::string& fp, int channels, int minEdgeSize) {
+  int pixelFormat;
+  if (channels == 3) {
+    pixelFormat = TJPF_RGB;
+  } else if (channels == 1) {
+    pixelFormat = TJPF_GRAY;
+  } else {
+    return Tensor();
+  }
+
+  std::ifstream file(fp, std::ios::binary | std::ios::ate);
+  if (!file) {
+    return Tensor();
+  }
+  std::vector<unsigned char> bytes(file.tellg());
+  file.seekg(0);
+  if (!file.read(reinterpret_cast<char*>(bytes.data()), bytes.size())) {
+    return Tensor();
+  }
+
+  tjhandle handle = tjInitDecompress();
+  if (!handle) {
+    return Tensor();
+  }
+  int w, h, subsamp, colorspace;
+  if (tjDecompressHeader3(
+          handle, bytes.data(), bytes.size(), &w, &h, &subsamp, &colorspace) !=
+      0) {
+    tjDestroy(handle);
+    return Tensor();
+  }
+
+  int outW = w;
+  int outH = h;
+  if (minEdgeSize > 0) {
+    int numFactors;
+    tjscalingfactor* factors = tjGetScalingFactors(&numFactors);
+    for (int i = 0; i < numFactors; ++i) {
+      int sw = TJSCALED(w, factors[i]);
+      int sh = TJSCALED(h, factors[i]);
+      if (std::min(sw, sh) >= minEdgeSize &&
+          static_cast<int64_t>(sw) * sh < static_cast<int64_t>(outW) * outH) {
+        outW = sw;
+        outH = sh;
+      }
+    }
+  }
+
+  // same layout as stb_image: C is the fastest-varying dimension
+  std::vector<unsigned char> pixels(
+      static_cast<size_t>(outW) * outH * channels);
+  if (tjDecompress2(
+          handle,
+          bytes.data(),
+          bytes.size(),
+          pixels.data(),
+          outW,
+          0 /* pitch */,
+          outH,
+          pixelFormat,
+          TJFLAG_FASTDCT) != 0) {
+    tjDestroy(handle);
+    return Tensor();
+  }
+  tjDestroy(handle);
+
+  Tensor result = Tensor::fromBuffer(
+      {channels, outW, outH}, pixels.data(), MemoryLocation::Host);
+  return fl::transpose(result, {1, 2, 0});
+}
+
+} // namespace
+#endif // FL_BUILD_PKG_VISION_TURBOJPEG
+
 /*
  * Loads a jpeg from filepath fp. Note: It will automatically convert from any
  * number of channels to create an array with 3 channels
  */
-Tensor loadJpeg(const std::string& fp, int desiredNumberOfChannels /* = 3 */) {
+Tensor loadJpeg(
+    const std::string& fp,
+    int desiredNumberOfChannels /* = 3 */,
+    int minEdgeSize /* = 0 */) {
+#ifdef FL_BUILD_PKG_VISION_TURBOJPEG
+  Tensor decoded = loadJpegTurbo(fp, desiredNumberOfChannels, minEdgeSize);
+  if (!decoded.isEmpty()) {
+    return decoded;
+  }
+#else
+  (void)minEdgeSize;
+#endif
   int w, h, c;
   // STB image will automatically return desiredNumberOfChannels.
   // NB: c will be the original number of channels
@@ -40,10 +144,12 @@ Tensor loadJpeg(const std::string& fp, int desiredNumberOfChannels /* = 3 */) {
   }
 }
 
-std::shared_ptr<Dataset> jpegLoader(std::vector<std::string> fps) {
+std::shared_ptr<Dataset> jpegLoader(
+    std::vector<std::string> fps,
+    int minEdgeSize /* = 0 */) {
   return std::make_shared<LoaderDataset<std::string>>(
-      fps, [](const std::string& fp) {
-        std::vector<Tensor> result = {loadJpeg(fp)};
+      fps, [minEdgeSize](const std::string& fp) {
+        std::vector<Tensor> result = {loadJpeg(fp, 3, minEdgeSize)};
         return result;
       });
 }
@@ -15,9 +15,23 @@ namespace fl {
 namespace pkg {
 namespace vision {
 
-Tensor loadJpeg(const std::string& fp, int desiredNumberOfChannels = 3);
+/*
+ * Loads a jpeg from filepath fp as a W X H X C tensor. `minEdgeSize` is a
+ * decode-time downscaling hint: when positive and flashlight is built with
+ * libjpeg-turbo (FL_BUILD_PKG_VISION_TURBOJPEG), the image is decoded directly
+ * to the coarsest DCT scaling factor whose shortest edge is still at least
+ * `minEdgeSize` pixels, so a subsequent `resizeSmallest` only has a small
+ * remainder to interpolate. Without libjpeg-turbo the hint is ignored and the
+ * image is decoded at full resolution.
+ */
+Tensor loadJpeg(
+    const std::string& fp,
+    int desiredNumberOfChannels = 3,
+    int minEdgeSize = 0);
 
-std::shared_ptr<Dataset> jpegLoader(std::vector<std::string> fps);
+std::shared_ptr<Dataset> jpegLoader(
+    std::vector<std::string> fps,
+    int minEdgeSize = 0);
 
 } // namespace vision
 } // namespace pkg
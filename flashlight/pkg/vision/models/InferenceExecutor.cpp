@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "flashlight/pkg/vision/models/InferenceExecutor.h"
+
+#include <future>
+#include <map>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "flashlight/fl/tensor/Compute.h"
+
+namespace fl::pkg::vision {
+
+InferenceExecutor::InferenceExecutor(
+    std::shared_ptr<Sequential> model,
+    int numThreads /* = 2 */)
+    : model_(model),
+      pool_(numThreads, [deviceId = fl::getDevice()](size_t /* threadId */) {
+        fl::setDevice(deviceId);
+      }) {
+  if (!model_) {
+    throw std::invalid_argument("InferenceExecutor - model is null");
+  }
+  if (numThreads <= 0) {
+    throw std::invalid_argument(
+        "InferenceExecutor - numThreads must be positive");
+  }
+}
+
+Variable InferenceExecutor::forward(const Variable& input) {
+  Variable output = input;
+  for (const auto& module : model_->modules()) {
+    if (auto residual = std::dynamic_pointer_cast<Residual>(module)) {
+      output = forwardResidual(*residual, output);
+    } else {
+      output = module->forward({output}).front();
+    }
+  }
+  return output;
+}
+
+Variable InferenceExecutor::forwardResidual(
+    Residual& residual,
+    const Variable& input) {
+  const auto shortcuts = residual.getShortcuts();
+  const auto scales = residual.getScales();
+  const auto projections = residual.getProjectionsIndices();
+  const auto modules = residual.modules();
+  const int nLayers = modules.size() - projections.size();
+
+  std::vector<Variable> outputs(nLayers + 1, Variable());
+  outputs[0] = input;
+
+  // source layer -> {destination layer, projection module index}
+  std::unordered_map<int, std::vector<std::pair<int, int>>> branchesFrom;
+  for (const auto& shortcut : shortcuts) {
+    for (const auto& connection : shortcut.second) {
+      branchesFrom[connection.first].emplace_back(
+          shortcut.first, connection.second);
+    }
+  }
+
+  // projection branches keyed by (destination layer, source layer); a
+  // branch is submitted the moment its source activation is computed, so
+  // it proceeds while the main chain runs the layers in between
+  std::map<std::pair<int, int>, std::future<Variable>> branches;
+  auto launchBranchesFrom = [&](int sourceLayer) {
+    auto it = branchesFrom.find(sourceLayer);
+    if (it == branchesFrom.end()) {
+      return;
+    }
+    for (const auto& [destLayer, projectionIndex] : it->second) {
+      if (projectionIndex == -1) {
+        continue; // identity connection, nothing to compute
+      }
+      auto projection = modules[projectionIndex];
+      Variable source = outputs[sourceLayer];
+      branches[{destLayer, sourceLayer}] =
+          pool_.enqueue([projection, source]() {
+            auto out = projection->forward({source}).front();
+            fl::eval(out.tensor()); // force submission on the worker
+            return out;
+          });
+    }
+  };
+
+  auto applyScale = [&scales](const Variable& in, const int layerIndex) {
+    auto it = scales.find(layerIndex);
+    return it == scales.end() ? in : in * it->second;
+  };
+  // merges the connections arriving before `layerIndex` into `output`,
+  // mirroring Residual::forward
+  auto mergeShortcuts = [&](Variable output, const int layerIndex) {
+    auto it = shortcuts.find(layerIndex);
+    if (it == shortcuts.end()) {
+      return output;
+    }
+    for (const auto& connection : it->second) {
+      Variable connectionOut = connection.second == -1
+          ? outputs[connection.first]
+          : branches.at({layerIndex, connection.first}).get();
+      output = output + connectionOut.astype(output.type());
+    }
+    return output;
+  };
+
+  launchBranchesFrom(0);
+  Variable output = input;
+  int moduleIndex = 0;
+  for (int layerIndex = 0; layerIndex < nLayers; ++layerIndex) {
+    while (projections.find(moduleIndex) != projections.end()) {
+      moduleIndex++;
+    }
+    output = mergeShortcuts(output, layerIndex);
+    output =
+        modules[moduleIndex]->forward({applyScale(output, layerIndex)}).front();
+    outputs[layerIndex + 1] = output;
+    launchBranchesFrom(layerIndex + 1);
+    moduleIndex++;
+  }
+  return applyScale(mergeShortcuts(output, nLayers), nLayers);
+}
+
+} // namespace fl::pkg::vision
@@ -31,6 +31,13 @@ class VisionExtension : public TensorExtension<VisionExtension> {
 
   virtual Tensor equalize(const Tensor& input, const Tensor& histogram) = 0;
 
+  virtual Tensor boxIouMatrix(
+      const Tensor& bboxes1,
+      const Tensor& bboxes2) = 0;
+  virtual Tensor generalizedBoxIouMatrix(
+      const Tensor& bboxes1,
+      const Tensor& bboxes2) = 0;
+
   virtual Tensor resize(
       const Tensor& tensor,
       const Shape& shape,
@@ -33,6 +33,17 @@ Tensor equalize(const Tensor& input, const Tensor& histogram) {
       input, histogram);
 }
 
+Tensor boxIouMatrix(const Tensor& bboxes1, const Tensor& bboxes2) {
+  return bboxes1.backend().getExtension<VisionExtension>().boxIouMatrix(
+      bboxes1, bboxes2);
+}
+
+Tensor generalizedBoxIouMatrix(const Tensor& bboxes1, const Tensor& bboxes2) {
+  return bboxes1.backend()
+      .getExtension<VisionExtension>()
+      .generalizedBoxIouMatrix(bboxes1, bboxes2);
+}
+
 Tensor resize(
     const Tensor& tensor,
     const Shape& shape,
@@ -39,6 +39,28 @@ Tensor histogram(const Tensor& tensor, const unsigned numBins);
  */
 Tensor equalize(const Tensor& input, const Tensor& histogram);
 
+/**
+ * Compute the pairwise intersection-over-union matrix of two sets of boxes
+ * in one fused pass, without materializing the broadcasted corner/area
+ * intermediates.
+ *
+ * @param[in] bboxes1 boxes in xyxy format with shape {4, N, B}
+ * @param[in] bboxes2 boxes in xyxy format with shape {4, M, B}
+ * @return a Tensor of shape {N, M, B} holding the pairwise IoU
+ */
+Tensor boxIouMatrix(const Tensor& bboxes1, const Tensor& bboxes2);
+
+/**
+ * Compute the pairwise generalized intersection-over-union matrix
+ * (https://giou.stanford.edu/) of two sets of boxes in one fused pass. Used
+ * to assemble matching cost matrices directly.
+ *
+ * @param[in] bboxes1 boxes in xyxy format with shape {4, N, B}
+ * @param[in] bboxes2 boxes in xyxy format with shape {4, M, B}
+ * @return a Tensor of shape {N, M, B} holding the pairwise GIoU
+ */
+Tensor generalizedBoxIouMatrix(const Tensor& bboxes1, const Tensor& bboxes2);
+
 /**
  * Modes for performing interpolation operations on image transformations.
  *
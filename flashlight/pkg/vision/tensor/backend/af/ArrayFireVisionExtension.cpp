@@ -9,7 +9,9 @@
 
 #include <stdexcept>
 
+#include <af/arith.h>
 #include <af/data.h>
+#include <af/gfor.h>
 #include <af/image.h>
 
 #include "flashlight/fl/tensor/backend/af/ArrayFireBackend.h"
@@ -106,6 +108,96 @@ Tensor ArrayFireVisionExtension::equalize(
       af::histEqual(toArray(input), toArray(histogram)), input.ndim());
 }
 
+namespace {
+
+// free functions so they convert to ArrayFire's batchFunc_t
+af::array afMin(const af::array& lhs, const af::array& rhs) {
+  return af::min(lhs, rhs);
+}
+af::array afMax(const af::array& lhs, const af::array& rhs) {
+  return af::max(lhs, rhs);
+}
+af::array afAdd(const af::array& lhs, const af::array& rhs) {
+  return lhs + rhs;
+}
+
+// slices the i-th xyxy coordinate of a (4, N, B) box array as (N, 1, B) for
+// the lhs and (1, M, B) for the rhs, so that every pairwise term below
+// broadcasts to (N, M, B) inside ArrayFire's JIT without materializing tiled
+// intermediates
+af::array lhsCoord(const af::array& boxes, const int i) {
+  return af::moddims(
+      boxes(i, af::span, af::span),
+      af::dim4(boxes.dims(1), 1, boxes.dims(2)));
+}
+af::array rhsCoord(const af::array& boxes, const int i) {
+  return boxes(i, af::span, af::span);
+}
+
+void validateIouInput(const Tensor& bboxes1, const Tensor& bboxes2) {
+  // rows past the xyxy coordinates (e.g. confidence scores) are ignored
+  if (bboxes1.ndim() != 3 || bboxes2.ndim() != 3 || bboxes1.dim(0) < 4 ||
+      bboxes2.dim(0) < 4 || bboxes1.dim(2) != bboxes2.dim(2)) {
+    throw std::invalid_argument(
+        "ArrayFireVisionExtension::boxIouMatrix - bbox inputs must be "
+        "of shape {4, N, B} and {4, M, B}");
+  }
+}
+
+// pairwise IoU as one elementwise JIT tree; also emits the union areas
+// needed by the generalized IoU
+af::array
+pairwiseIou(const af::array& lhs, const af::array& rhs, af::array& uni) {
+  auto interW = af::max(
+      af::batchFunc(lhsCoord(lhs, 2), rhsCoord(rhs, 2), afMin) -
+          af::batchFunc(lhsCoord(lhs, 0), rhsCoord(rhs, 0), afMax),
+      0.);
+  auto interH = af::max(
+      af::batchFunc(lhsCoord(lhs, 3), rhsCoord(rhs, 3), afMin) -
+          af::batchFunc(lhsCoord(lhs, 1), rhsCoord(rhs, 1), afMax),
+      0.);
+  auto inter = interW * interH;
+  auto area1 = (lhsCoord(lhs, 2) - lhsCoord(lhs, 0)) *
+      (lhsCoord(lhs, 3) - lhsCoord(lhs, 1));
+  auto area2 = (rhsCoord(rhs, 2) - rhsCoord(rhs, 0)) *
+      (rhsCoord(rhs, 3) - rhsCoord(rhs, 1));
+  uni = af::batchFunc(area1, area2, afAdd) - inter;
+  return inter / uni;
+}
+
+} // namespace
+
+Tensor ArrayFireVisionExtension::boxIouMatrix(
+    const Tensor& bboxes1,
+    const Tensor& bboxes2) {
+  validateIouInput(bboxes1, bboxes2);
+  af::array uni;
+  return toTensor<ArrayFireTensor>(
+      pairwiseIou(toArray(bboxes1), toArray(bboxes2), uni), /* numDims = */ 3);
+}
+
+Tensor ArrayFireVisionExtension::generalizedBoxIouMatrix(
+    const Tensor& bboxes1,
+    const Tensor& bboxes2) {
+  validateIouInput(bboxes1, bboxes2);
+  const af::array& lhs = toArray(bboxes1);
+  const af::array& rhs = toArray(bboxes2);
+  af::array uni;
+  auto iou = pairwiseIou(lhs, rhs, uni);
+  // area of the smallest box enclosing each pair
+  auto enclW = af::max(
+      af::batchFunc(lhsCoord(lhs, 2), rhsCoord(rhs, 2), afMax) -
+          af::batchFunc(lhsCoord(lhs, 0), rhsCoord(rhs, 0), afMin),
+      0.);
+  auto enclH = af::max(
+      af::batchFunc(lhsCoord(lhs, 3), rhsCoord(rhs, 3), afMax) -
+          af::batchFunc(lhsCoord(lhs, 1), rhsCoord(rhs, 1), afMin),
+      0.);
+  auto encl = enclW * enclH;
+  return toTensor<ArrayFireTensor>(
+      iou - (encl - uni) / encl, /* numDims = */ 3);
+}
+
 Tensor ArrayFireVisionExtension::resize(
     const Tensor& tensor,
     const Shape& shape,
@@ -34,6 +34,10 @@ class ArrayFireVisionExtension : public VisionExtension {
 
   Tensor equalize(const Tensor& input, const Tensor& histogram) override;
 
+  Tensor boxIouMatrix(const Tensor& bboxes1, const Tensor& bboxes2) override;
+  Tensor generalizedBoxIouMatrix(const Tensor& bboxes1, const Tensor& bboxes2)
+      override;
+
   Tensor resize(
       const Tensor& tensor,
       const Shape& shape,
@@ -0,0 +1,46 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+
+#include "flashlight/fl/tensor/Init.h"
+#include "flashlight/fl/tensor/Random.h"
+#include "flashlight/pkg/vision/models/InferenceExecutor.h"
+
+using namespace fl;
+using namespace fl::pkg::vision;
+
+TEST(InferenceExecutor, MatchesSequentialForward) {
+  auto residual = std::make_shared<Residual>();
+  residual->add(Linear(16, 16));
+  residual->add(ReLU());
+  residual->add(Linear(16, 16));
+  // identity shortcut around the block and a projected one over the tail
+  residual->addShortcut(0, 4);
+  residual->addShortcut(1, 4, Linear(16, 16));
+  residual->addScale(4, 0.5);
+
+  auto model = std::make_shared<Sequential>();
+  model->add(Linear(8, 16));
+  model->add(residual);
+  model->add(Linear(16, 4));
+  model->eval();
+
+  auto input = Variable(fl::rand({8, 3}), false);
+  auto expected = model->forward({input}).front();
+
+  InferenceExecutor executor(model, /* numThreads = */ 2);
+  auto actual = executor.forward(input);
+  ASSERT_EQ(actual.shape(), expected.shape());
+  ASSERT_TRUE(allClose(actual.tensor(), expected.tensor(), 1e-5));
+}
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  fl::init();
+  return RUN_ALL_TESTS();
+}
@@ -9,6 +9,7 @@
 
 #include "flashlight/fl/tensor/Index.h"
 #include "flashlight/fl/tensor/Init.h"
+#include "flashlight/fl/tensor/Random.h"
 #include "flashlight/pkg/vision/criterion/SetCriterion.h"
 
 #include <gtest/gtest.h>
@@ -373,6 +374,37 @@ TEST(SetCriterion, DifferentNumberOfLabelsClass) {
   EXPECT_NEAR(loss["lossCe_0"].scalar<float>(), 1.4713663f, 1e-4);
 }
 
+TEST(HungarianMatcher, ParallelMatchesSerial) {
+  const int numClasses = 10;
+  const int numPreds = 9;
+  const int numBatches = 4;
+  auto predBoxes = fl::rand({4, numPreds, numBatches});
+  auto predLogits = fl::rand({numClasses + 1, numPreds, numBatches});
+  std::vector<Tensor> targetBoxes;
+  std::vector<Tensor> targetClasses;
+  for (int b = 0; b < numBatches; b++) {
+    if (b == numBatches - 1) {
+      // exercise the empty-target path
+      targetBoxes.emplace_back();
+      targetClasses.emplace_back();
+      continue;
+    }
+    const int numTargets = b + 1;
+    targetBoxes.push_back(fl::rand({4, numTargets, 1}));
+    targetClasses.push_back(fl::floor(fl::rand({numTargets, 1}) * numClasses));
+  }
+
+  auto serial = HungarianMatcher(1, 1, 1).compute(
+      predBoxes, predLogits, targetBoxes, targetClasses);
+  auto parallel = HungarianMatcher(1, 1, 1, 3).compute(
+      predBoxes, predLogits, targetBoxes, targetClasses);
+  ASSERT_EQ(serial.size(), parallel.size());
+  for (size_t b = 0; b < serial.size(); b++) {
+    ASSERT_TRUE(allClose(serial[b].first, parallel[b].first));
+    ASSERT_TRUE(allClose(serial[b].second, parallel[b].second));
+  }
+}
+
 int main(int argc, char** argv) {
   ::testing::InitGoogleTest(&argc, argv);
   fl::init();
@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+
+#include "flashlight/fl/tensor/Index.h"
+#include "flashlight/fl/tensor/Init.h"
+#include "flashlight/fl/tensor/Random.h"
+#include "flashlight/pkg/vision/dataset/BatchTransforms.h"
+#include "flashlight/pkg/vision/dataset/Transforms.h"
+
+using namespace fl;
+using namespace fl::pkg::vision;
+
+TEST(BatchTransforms, NormalizeMatchesPerImage) {
+  const std::vector<float> mean = {0.485, 0.456, 0.406};
+  const std::vector<float> std = {0.229, 0.224, 0.225};
+  Tensor batch = (fl::rand({8, 8, 3, 4}) * 255).astype(fl::dtype::u8);
+
+  Tensor batched = normalizeBatchTransform(mean, std)(batch);
+  auto perImage = normalizeImage(mean, std);
+  for (int i = 0; i < batch.dim(3); ++i) {
+    ASSERT_TRUE(allClose(
+        batched(fl::span, fl::span, fl::span, fl::range(i, i + 1)),
+        perImage(batch(fl::span, fl::span, fl::span, fl::range(i, i + 1)))));
+  }
+}
+
+TEST(BatchTransforms, RandomHorizontalFlip) {
+  Tensor batch = (fl::rand({6, 5, 3, 8}) * 255).astype(fl::dtype::u8);
+
+  Tensor never = randomHorizontalFlipBatchTransform(0.)(batch);
+  ASSERT_TRUE(allClose(never, batch));
+  Tensor always = randomHorizontalFlipBatchTransform(1.)(batch);
+  ASSERT_TRUE(allClose(always, fl::flip(batch, 0)));
+}
+
+TEST(BatchTransforms, RandomCropShapes) {
+  Tensor batch = fl::rand({10, 12, 3, 4});
+
+  Tensor cropped = randomCropBatchTransform(7, 5)(batch);
+  ASSERT_EQ(cropped.shape(), Shape({7, 5, 3, 4}));
+  EXPECT_THROW(randomCropBatchTransform(11, 5)(batch), std::runtime_error);
+}
+
+TEST(BatchTransforms, ColorJitterRange) {
+  Tensor batch = (fl::rand({8, 8, 3, 4}) * 255).astype(fl::dtype::u8);
+
+  Tensor identity = randomColorJitterBatchTransform(0., 0., 0.)(batch);
+  ASSERT_TRUE(allClose(identity, batch.astype(fl::dtype::f32)));
+
+  Tensor jittered = randomColorJitterBatchTransform(0.4, 0.4, 0.4)(batch);
+  ASSERT_EQ(jittered.shape(), batch.shape());
+  ASSERT_TRUE(fl::all(jittered >= 0.f && jittered <= 255.f).asScalar<bool>());
+}
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  fl::init();
+  return RUN_ALL_TESTS();
+}
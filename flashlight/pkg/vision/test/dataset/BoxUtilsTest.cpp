@@ -8,6 +8,8 @@
 #include "flashlight/pkg/vision/dataset/BoxUtils.h"
 #include "flashlight/fl/tensor/Index.h"
 #include "flashlight/fl/tensor/Init.h"
+#include "flashlight/fl/tensor/Random.h"
+#include "flashlight/pkg/vision/tensor/VisionOps.h"
 
 #include <gtest/gtest.h>
 
@@ -157,6 +159,26 @@ TEST(BoxUtils, GIOU) {
       result(0, 0).tensor().scalar<float>(), result(1, 0).scalar<float>());
 }
 
+TEST(BoxUtils, IouMatrixMatchesComposed) {
+  // the fused pairwise ops must agree with the composed reference
+  const int n = 7, m = 5, b = 3;
+  auto makeBoxes = [](int count, int batch) {
+    auto lt = fl::rand({2, count, batch});
+    return fl::concatenate(0, lt, lt + fl::rand({2, count, batch}));
+  };
+  fl::Tensor boxes1 = makeBoxes(n, b);
+  fl::Tensor boxes2 = makeBoxes(m, b);
+
+  fl::Tensor iou, uni;
+  std::tie(iou, uni) = boxIou(boxes1, boxes2);
+  ASSERT_TRUE(fl::allClose(fl::boxIouMatrix(boxes1, boxes2), iou, 1e-5));
+
+  fl::Variable giouRef = generalizedBoxIou(
+      fl::Variable(boxes1, false), fl::Variable(boxes2, false));
+  ASSERT_TRUE(fl::allClose(
+      fl::generalizedBoxIouMatrix(boxes1, boxes2), giouRef.tensor(), 1e-5));
+}
+
 int main(int argc, char** argv) {
   ::testing::InitGoogleTest(&argc, argv);
   fl::init();